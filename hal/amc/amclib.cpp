@@ -6,6 +6,7 @@
 
 #include "amclib.h"
 #include "os.h"
+#include "task_executor.h"
 
 /**
  * @brief Constructor for the amclib class
@@ -296,12 +297,66 @@ int amclib::amcGetSensorInfoBySensorId(int cardIndex, uint16_t sensorId, std::ve
 			amcSensorInfo info;
 			info.sensorId = sensor.sensorId;
 			info.sensorReading = sensor.reading;
+			info.baseUnit = sensor.baseUnit;
 			sensorInfo.push_back(info);
 		}
 	}
 	return AMC_SUCCESS;
 }
 
+/**
+ * @brief Read sensors of several AMC cards concurrently
+ *
+ * Every card sits on its own I2C bus, so the cards are read in parallel; within a card
+ * the sensor requests are pipelined by the card's sensor engine. The sensor metadata of
+ * a card is fetched from its PDR repository on the first read only, so calling this
+ * periodically costs one GetSensorReading per sensor and card.
+ *
+ * @param[in]  cards     Zero-based indices of the AMC cards to read
+ * @param[in]  sensorIds Sensor IDs to read on every card; all numeric sensors if empty
+ * @param[out] readings  One entry per card, in @p cards order, holding the sensors read
+ *
+ * @return Status of the sensor read operation
+ * @retval AMC_SUCCESS Every requested sensor was read on every card
+ * @retval AMC_ERROR Invalid card index, or a sensor could not be read on some card;
+ *         the per-card status tells which
+ */
+int amclib::amcReadSensors(std::span<const int> cards, std::span<const uint16_t> sensorIds,
+						   std::vector<amcCardSensors> &readings)
+{
+	TRACING();
+
+	readings.clear();
+	if (!pldmobj) {
+		ERR("PLDM objects not initialized\n");
+		return AMC_ERROR;
+	}
+	for (const int card : cards) {
+		if (card < 0 || card >= numCards || pldmobj[card] == nullptr) {
+			ERR("Invalid card number {} (valid range: 0-{})\n", card, numCards - 1);
+			return AMC_ERROR;
+		}
+		readings.push_back({card, AMC_ERROR, {}});
+	}
+
+	const DeviceResults outcome = parallelForEach(readings, [this, sensorIds](amcCardSensors &card) {
+		std::vector<pldmSensorInfo> sensors;
+		const uint8_t ret = pldmobj[card.cardIndex]->readSensors(sensorIds, sensors);
+		card.sensors.reserve(sensors.size());
+		for (const auto &sensor : sensors) {
+			card.sensors.push_back({sensor.sensorId, sensor.reading, sensor.baseUnit});
+		}
+		card.status = (ret == PLDM_SUCCESS) ? AMC_SUCCESS : AMC_ERROR;
+		if (card.status != AMC_SUCCESS) {
+			ERR("Failed to read sensors on card index {}\n", card.cardIndex);
+			return ZE_RESULT_ERROR_UNKNOWN;
+		}
+		return ZE_RESULT_SUCCESS;
+	});
+
+	return outcome.ok() ? AMC_SUCCESS : AMC_ERROR;
+}
+
 /**
  * @brief Execute OEM VRSync command on all AMC cards
  *
@@ -466,8 +521,8 @@ int amclib::amcGpuReset(uint32_t cardNum)
 /**
  * @brief Read a file from the AMC card using PLDM file transfer
  *
- * This function retrieves the contents of a file identified by its PDR ID from the specified AMC card.
- * It uses the PLDM file transfer protocol to read the file in chunks and assembles the complete file data.
+ * This function retrieves the contents of a file identified by its PDR ID from the specified AMC card
+ * into memory. See amcReadFiles() for files too large for memory or several cards.
  *
  * @param[in] deviceIndex Index of the AMC card to read from (0-based)
  * @param[in] filePdrId PDR ID of the file to read
@@ -476,24 +531,71 @@ int amclib::amcGpuReset(uint32_t cardNum)
  * @return Status of the file read operation
  * @retval AMC_SUCCESS File read successfully and data populated in fileData
  * @retval AMC_ERROR Failed to read file due to invalid parameters, PLDM errors, or other issues
- *
- * @note The function handles multipart transfers for large files and ensures proper assembly of data
- * @note The caller is responsible for providing a valid device index and file PDR ID
  */
 int amclib::amcReadFile(int deviceIndex, uint16_t filePdrId, std::vector<uint8_t> &fileData)
 {
 	TRACING();
 
-	if (deviceIndex < 0 || deviceIndex >= numCards) {
-		ERR("Invalid device index {} (valid range: 0-{})\n", deviceIndex, numCards - 1);
-		return AMC_ERROR;
-	}
+	fileData.clear();
+	VectorFileSink sink(fileData);
+	amcFileRequest request{deviceIndex, &sink, {}};
+	return amcReadFiles(filePdrId, std::span(&request, 1));
+}
+
+/**
+ * @brief Read a file from several AMC cards concurrently using PLDM file transfer
+ *
+ * Every card sits on its own I2C bus, so the cards are read in parallel. The file is
+ * streamed into the sink of each request part by part. A transfer that fails is
+ * retried up to RETRY_COUNT times, resuming after the data that already reached the
+ * sink; one whose data does not match the checksum of the card is not.
+ *
+ * @param[in] filePdrId PDR ID of the file to read on every card
+ * @param[in,out] requests One entry per card; progress says where to resume, e.g. after
+ *        the data of an earlier, interrupted run; status and progress are updated
+ *
+ * @return Status of the file read operation
+ * @retval AMC_SUCCESS The file was read completely from every card
+ * @retval AMC_ERROR Invalid card index, or the file could not be read from some card;
+ *         the per-card status tells which
+ */
+int amclib::amcReadFiles(uint16_t filePdrId, std::span<amcFileRequest> requests)
+{
+	TRACING();
 
-	if (!pldmobj || !pldmobj[deviceIndex]) {
-		ERR("PLDM object not initialized for device index: {}\n", deviceIndex);
+	if (!pldmobj) {
+		ERR("PLDM objects not initialized\n");
 		return AMC_ERROR;
 	}
+	for (auto &request : requests) {
+		request.status = AMC_ERROR;
+		request.checksumMismatch = false;
+		if (request.cardIndex < 0 || request.cardIndex >= numCards || pldmobj[request.cardIndex] == nullptr ||
+			request.sink == nullptr) {
+			ERR("Invalid device index {} (valid range: 0-{})\n", request.cardIndex, numCards - 1);
+			return AMC_ERROR;
+		}
+	}
 
-	int ret = pldmobj[deviceIndex]->getFile(filePdrId, fileData);
-	return (ret == PLDM_SUCCESS) ? AMC_SUCCESS : AMC_ERROR;
+	const DeviceResults outcome = parallelForEach(requests, [this, filePdrId](amcFileRequest &request) {
+		uint8_t ret = PLDM_ERROR;
+		for (int attempt = 0; attempt < RETRY_COUNT; attempt++) {
+			if (attempt > 0) {
+				DBG("Retrying file read on card index {} at offset {}\n", request.cardIndex, request.progress.offset);
+			}
+			ret = pldmobj[request.cardIndex]->getFile(filePdrId, *request.sink, request.progress);
+			if (ret == PLDM_SUCCESS || ret == PLDM_ERROR_INVALID_DATA) {
+				break;
+			}
+		}
+		request.checksumMismatch = (ret == PLDM_ERROR_INVALID_DATA);
+		request.status = (ret == PLDM_SUCCESS) ? AMC_SUCCESS : AMC_ERROR;
+		if (request.status != AMC_SUCCESS) {
+			ERR("Failed to read file {} on card index {}\n", filePdrId, request.cardIndex);
+			return ZE_RESULT_ERROR_UNKNOWN;
+		}
+		return ZE_RESULT_SUCCESS;
+	});
+
+	return outcome.ok() ? AMC_SUCCESS : AMC_ERROR;
 }
@@ -7,6 +7,7 @@
 #ifndef _AMCLIB_H
 #define _AMCLIB_H
 
+#include <span>
 #include <vector>
 #include <string>
 #include "pldm.h"
@@ -27,6 +28,26 @@ struct amcSensorInfo
 {
 	uint16_t sensorId;
 	double sensorReading;
+	uint8_t baseUnit; // sensorUnits
+};
+
+struct amcCardSensors
+{
+	int cardIndex;
+	int status; // AMC_SUCCESS when every requested sensor was read
+	std::vector<amcSensorInfo> sensors;
+};
+
+/**
+ * @brief One card's share of amclib::amcReadFiles()
+ */
+struct amcFileRequest
+{
+	int cardIndex;
+	FileSink *sink;
+	fileTransferProgress progress; // Where to resume; on return how far the transfer got
+	int status = AMC_ERROR;		   // AMC_SUCCESS when the whole file reached the sink
+	bool checksumMismatch = false; // The data does not match the checksum of the card
 };
 
 class LIBXPUM_API amclib
@@ -46,11 +67,14 @@ public:
 	int amcGetIndex(const std::string &gpuBDF);
 	int amcGetCardInfo(std::string gpuBDF, std::string &serialNumStr, std::string &versionStr);
 	int amcGetSensorInfoBySensorId(int deviceIndex, uint16_t sensorId, std::vector<amcSensorInfo> &sensorInfo);
+	int amcReadSensors(std::span<const int> cards, std::span<const uint16_t> sensorIds,
+					   std::vector<amcCardSensors> &readings);
 	int oemVrsync(uint8_t cmd);
 	int amcGetSerialNumber(uint8_t card_num, char *serialNumber, size_t *bufferSize);
 	int amcGetVersion(uint8_t card_num, char *amc_version, size_t *bufferSize);
 	int amcGpuReset(uint32_t cardNum);
 	int amcReadFile(int deviceIndex, uint16_t filePdrId, std::vector<uint8_t> &fileData);
+	int amcReadFiles(uint16_t filePdrId, std::span<amcFileRequest> requests);
 };
 
 #endif
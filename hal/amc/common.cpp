@@ -86,6 +86,33 @@ uint8_t crc8Smbus(const uint8_t *data, size_t len)
 	return crc;
 }
 
+/**
+ * @brief Continue a CRC-32 over more data
+ *
+ * Computes the CRC-32 of ISO 3309 (reflected polynomial 0xEDB88320), the checksum
+ * DSP0240 uses for multipart transfers and zlib's crc32() computes.
+ *
+ * @param crc CRC of the data before @p data; 0 to start
+ * @param data Pointer to the data buffer to add
+ * @param len Length of the data buffer in bytes
+ *
+ * @return uint32_t CRC-32 of the data so far
+ */
+uint32_t crc32Update(uint32_t crc, const uint8_t *data, size_t len)
+{
+	if (data == nullptr) {
+		return crc;
+	}
+	crc = ~crc;
+	for (size_t i = 0; i < len; i++) {
+		crc ^= data[i];
+		for (int bit = 0; bit < 8; bit++) {
+			crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+		}
+	}
+	return ~crc;
+}
+
 /**
  * @brief Print hexadecimal dump of a buffer
  *
@@ -37,6 +37,7 @@ enum
 #define RETRY_COUNT 3
 
 uint8_t crc8Smbus(const uint8_t *data, size_t len);
+uint32_t crc32Update(uint32_t crc, const uint8_t *data, size_t len);
 void hexdump(const uint8_t buff[], unsigned int len);
 unsigned int bytesToInt(uint8_t byte1, uint8_t byte2, uint8_t byte3, uint8_t byte4);
 
@@ -107,5 +107,9 @@ protected:
 	// mctp command construction API
 	uint8_t commandConstruction(mctpSmbusI2cHdr *i2cMctpHdr, uint8_t som, uint8_t eom, uint8_t pktSeq,
 								uint8_t bytecount, uint8_t integrityCheck);
+
+public:
+	static uint8_t smbusHeaderConstruction(mctpSmbusI2cHdr *i2cMctpHdr, uint8_t destEid, uint8_t som, uint8_t eom,
+										   uint8_t pktSeq, uint8_t bytecount, uint8_t integrityCheck);
 };
 #endif // __MCTP_H
@@ -10,11 +10,37 @@
 /**
  * @brief Construct mctp command message header for SMBus/I2C transport
  *
+ * Builds the header for this endpoint's destination EID; see smbusHeaderConstruction().
+ *
+ * @param i2cMctpHdr Pointer to mctp SMBus I2C header structure to populate
+ * @param som Start of Message flag (1 = first packet, 0 = continuation)
+ * @param eom End of Message flag (1 = last packet, 0 = more packets follow)
+ * @param pktSeq Packet sequence number for multi-packet messages (0-3)
+ * @param bytecount Number of bytes in the message payload
+ * @param integrityCheck Integrity check flag for message validation
+ *
+ * @return uint8_t Status of header construction
+ * @retval MCTP_SUCCESS Header constructed successfully
+ * @retval MCTP_FAILURE Invalid parameters or construction failure
+ *
+ * @note Uses destination EID from mDestEid member variable
+ */
+uint8_t mctp::commandConstruction(mctpSmbusI2cHdr *i2cMctpHdr, uint8_t som, uint8_t eom, uint8_t pktSeq,
+								  uint8_t bytecount, uint8_t integrityCheck)
+{
+	TRACING();
+	return smbusHeaderConstruction(i2cMctpHdr, mDestEid, som, eom, pktSeq, bytecount, integrityCheck);
+}
+
+/**
+ * @brief Construct mctp message header for SMBus/I2C transport to a given endpoint
+ *
  * Builds a complete mctp (Management Component Transport Protocol) message header
  * for communication over SMBus/I2C interface. Constructs both the medium-specific
  * header and transport header with proper addressing and packet control fields.
  *
  * @param i2cMctpHdr Pointer to mctp SMBus I2C header structure to populate
+ * @param destEid Destination endpoint ID
  * @param som Start of Message flag (1 = first packet, 0 = continuation)
  * @param eom End of Message flag (1 = last packet, 0 = more packets follow)
  * @param pktSeq Packet sequence number for multi-packet messages (0-3)
@@ -27,13 +53,11 @@
  *
  * @note Sets up SMBus addressing with AMC I2C slave address
  * @note Configures transport header with endpoint IDs and packet control
- * @note Uses destination EID from mDestEid member variable
  * @note Sets message type to MCTP_CONTROL per DSP0239 specification
  */
-uint8_t mctp::commandConstruction(mctpSmbusI2cHdr *i2cMctpHdr, uint8_t som, uint8_t eom, uint8_t pktSeq,
-								  uint8_t bytecount, uint8_t integrityCheck)
+uint8_t mctp::smbusHeaderConstruction(mctpSmbusI2cHdr *i2cMctpHdr, uint8_t destEid, uint8_t som, uint8_t eom,
+									  uint8_t pktSeq, uint8_t bytecount, uint8_t integrityCheck)
 {
-	TRACING();
 	if (i2cMctpHdr == NULL) {
 		return MCTP_FAILURE;
 	}
@@ -50,7 +74,7 @@ uint8_t mctp::commandConstruction(mctpSmbusI2cHdr *i2cMctpHdr, uint8_t som, uint
 	i2cMctpHdr->reserved = MCTP_RESERVED;
 	i2cMctpHdr->hdrVersion = MCTP_HEADER_VERSION;
 
-	i2cMctpHdr->destEpid = mDestEid; // MCTP_DESTINATION_ENDPOINT_ID;
+	i2cMctpHdr->destEpid = destEid; // MCTP_DESTINATION_ENDPOINT_ID;
 	i2cMctpHdr->srcEpid = MCTP_SOURCE_ENDPOINT_ID;
 
 	i2cMctpHdr->som = som & 0x1;
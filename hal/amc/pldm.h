@@ -10,14 +10,18 @@
 #include "mctp.h"
 #include "pldm_constants.h"
 #include "pldm_file_transfer.h"
+#include "pldm_file_transfer_engine.h"
 #include "pldm_fru.h"
 #include "pldm_fwpackage.h"
 #include "pldm_fwupdate.h"
 #include "pldm_platform.h"
 #include "pldm_pdr_manager.h"
+#include "pldm_sensor_engine.h"
 #include "pldm_amc_gpu_reset.h"
 #include <i2c_interface.h>
+#include <memory>
 #include <mutex>
+#include <span>
 
 // Transfer Operation Flags
 enum pldmTransferOpFlag
@@ -173,9 +177,8 @@ private:
 	struct pdrRepositoryInfoResp pfPdrRepoInfo;
 	struct pdrReqPayload pfPdrReq;
 	struct pdrRespPayload pfPdrResp;
-	struct pldmGetSensorReadingReq pfSensorReadingReq;
-	struct pldmGetSensorReadingResp pfSensorReadingResp;
-	sensorReadingValue mSensorReading;
+	SensorTable mSensorTable;
+	std::unique_ptr<SensorEngine> mSensorEngine;
 	std::vector<pldmSensorInfo> mSensorInfoList;
 
 	// PLDM File Transfer datastructures
@@ -187,17 +190,13 @@ private:
 	struct pldm_file_df_heartbeat_resp mDfHeartbeatResp;
 	struct pldm_file_df_read_req mDfReadReq;
 	struct pldm_file_df_read_resp mDfReadResp;
-	struct pldm_base_multipart_receive_req mMultipartReceiveReq;
-	struct pldm_base_multipart_receive_resp mMultipartReceiveResp;
-	std::vector<uint8_t> mMultipartReceiveData;
+	std::unique_ptr<FileTransferEngine> mFileEngine;
 	std::vector<uint8_t> mRxAssembledFrame;
 	std::vector<uint8_t> mRxAssembledPayload;
 
 	// pldm Base APIs
 	int pldminit();
 	void cleanup();
-	uint8_t pldmHdrConstruction(struct pldmHdr *pldmHdr, uint8_t instanceID, uint8_t cmdType, uint8_t cmd,
-								uint8_t async, uint8_t reqresp);
 
 	//============== pldm Discovery ================
 	// pldm Discovery Command
@@ -271,12 +270,8 @@ private:
 	uint8_t pfFillPayload(uint8_t cmd, uint8_t size);
 	uint8_t pfPdrRepoRespPayload();
 	uint8_t pfPdrRespPayload();
-	uint8_t pfSensorReadingRespPayload();
 	uint8_t pfGetTotalPdrs();
-	uint8_t pfGetSensorValuesByUnit(sensorUnits unit);
-	uint8_t pfGetSensorValuesById(uint16_t sensorId);
-	uint8_t pfGetSensorValue(const pldmNumericSensorValuePdr *sensor);
-	void pfBuildPdrSensorCache() { mPdrManager.buildSensorCache(); }
+	uint8_t pfLoadSensorTable();
 
 	// PLDM File Transfer APIs
 	uint8_t pldmFileTransferCmd(uint8_t cmd, uint8_t size);
@@ -288,10 +283,8 @@ private:
 	uint8_t handleDfCloseResp(const uint8_t *respPayload, size_t respPayloadLen);
 	uint8_t handleDfHeartbeatResp(const uint8_t *respPayload, size_t respPayloadLen);
 	uint8_t handleDfReadResp(const uint8_t *respPayload, size_t respPayloadLen, size_t totalFrameSize);
-	uint8_t handleMultipartReceiveResp(const uint8_t *respPayload, size_t respPayloadLen, size_t totalFrameSize);
 	uint8_t pldmDfOpenCommand(uint16_t fileIdentifier, uint16_t &fileDescriptor);
 	uint8_t pldmDfCloseCommand(uint16_t fileDescriptor);
-	uint8_t pldmMultipartReceiveCommand(uint16_t fileDescriptor, std::vector<uint8_t> &fileData);
 	const PdrRecord *getFilePdrById(uint16_t filePdrId);
 
 public:
@@ -308,9 +301,12 @@ public:
 	// pldm Base APIs
 	int initialize();
 	int fwupd(const char *pkgFilePath);
+	static uint8_t pldmHdrConstruction(struct pldmHdr *pldmHdr, uint8_t instanceID, uint8_t cmdType, uint8_t cmd,
+									   uint8_t async, uint8_t reqresp);
 	uint8_t getSensorInfoById(uint16_t sensorId);
 	uint8_t getSensorInfoByUnit(sensorUnits unit);
-	uint8_t getFile(uint16_t filePdrId, std::vector<uint8_t> &fileData);
+	uint8_t readSensors(std::span<const uint16_t> sensorIds, std::vector<pldmSensorInfo> &readings);
+	uint8_t getFile(uint16_t filePdrId, FileSink &sink, fileTransferProgress &progress);
 	std::vector<pldmSensorInfo> &getSensorInfoList() { return mSensorInfoList; }
 	uint8_t oemVrsyncCmd(uint8_t cmd);
 	int fwupdProgress() { return mProgPercent; }
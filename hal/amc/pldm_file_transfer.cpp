@@ -249,27 +249,6 @@ uint8_t pldm::PldmFillFileTxPayload(uint8_t cmd, uint8_t size)
 		payloadPtr[offset] = crc8Smbus(payloadPtr, offset);
 		break;
 
-	case PLDM_MULTIPART_RECEIVE:
-		memcpy(payloadPtr + offset, &mMultipartReceiveReq.pldmType, sizeof(mMultipartReceiveReq.pldmType));
-		offset += sizeof(mMultipartReceiveReq.pldmType);
-		memcpy(payloadPtr + offset, &mMultipartReceiveReq.transferOperation,
-			   sizeof(mMultipartReceiveReq.transferOperation));
-		offset += sizeof(mMultipartReceiveReq.transferOperation);
-		memcpy(payloadPtr + offset, &mMultipartReceiveReq.transferContext,
-			   sizeof(mMultipartReceiveReq.transferContext));
-		offset += sizeof(mMultipartReceiveReq.transferContext);
-		memcpy(payloadPtr + offset, &mMultipartReceiveReq.dataTransferHandle,
-			   sizeof(mMultipartReceiveReq.dataTransferHandle));
-		offset += sizeof(mMultipartReceiveReq.dataTransferHandle);
-		memcpy(payloadPtr + offset, &mMultipartReceiveReq.requestedSectionOffset,
-			   sizeof(mMultipartReceiveReq.requestedSectionOffset));
-		offset += sizeof(mMultipartReceiveReq.requestedSectionOffset);
-		memcpy(payloadPtr + offset, &mMultipartReceiveReq.requestedSectionLengthBytes,
-			   sizeof(mMultipartReceiveReq.requestedSectionLengthBytes));
-		offset += sizeof(mMultipartReceiveReq.requestedSectionLengthBytes);
-		payloadPtr[offset] = crc8Smbus(payloadPtr, offset);
-		break;
-
 	default:
 		ERR("PLDM File Transfer: Unsupported command 0x{:02x}\n", cmd);
 		return PLDM_ERROR;
@@ -315,8 +294,7 @@ uint8_t pldm::pldmFileTransferCmd(uint8_t cmd, uint8_t size)
 		instanceID = 1;
 	}
 
-	auto cmdType = (cmd == PLDM_MULTIPART_RECEIVE) ? PLDM_MESSAGE_DISCOVERY : PLDM_FILE_TRANSFER;
-	ret = pldmHdrConstruction(&mI2cPldmWrite->pldmHdr, instanceID, static_cast<uint8_t>(cmdType), cmd,
+	ret = pldmHdrConstruction(&mI2cPldmWrite->pldmHdr, instanceID, PLDM_FILE_TRANSFER, cmd,
 							  PLDM_ASYNC_REQUEST_NOTIFY, PLDM_REQUEST);
 	if (ret != PLDM_SUCCESS) {
 		ERR("PLDM File Transfer: PLDM header construction failed\n");
@@ -390,8 +368,6 @@ uint8_t pldm::pldmFileTransferResp(uint8_t cmd, uint8_t id)
 		return handleDfHeartbeatResp(respPayload, respPayloadLen);
 	case PLDM_FT_CMDCODE_DF_READ:
 		return handleDfReadResp(respPayload, respPayloadLen, totalFrameSize);
-	case PLDM_MULTIPART_RECEIVE:
-		return handleMultipartReceiveResp(respPayload, respPayloadLen, totalFrameSize);
 	case PLDM_FT_CMDCODE_DF_FIFO_SEND:
 	case PLDM_FT_CMDCODE_DF_PROPERTIES:
 	case PLDM_FT_CMDCODE_DF_GET_FILE_ATTRIBUTE:
@@ -511,54 +487,6 @@ uint8_t pldm::handleDfReadResp(const uint8_t *respPayload, size_t respPayloadLen
 	return PLDM_SUCCESS;
 }
 
-/**
- * @brief Parses the payload of the PLDM file transfer response for MULTIPART_RECEIVE command.
- *
- * @param[in] respPayload Pointer to the response payload data.
- * @param[in] respPayloadLen Length of the response payload data.
- * @param[in] totalFrameSize Total size of the assembled frame including headers and payload.
- * @return uint8_t PLDM_SUCCESS on success, PLDM_ERROR on failure.
- */
-uint8_t pldm::handleMultipartReceiveResp(const uint8_t *respPayload, size_t respPayloadLen, size_t totalFrameSize)
-{
-	const size_t payloadHeaderSize =
-		sizeof(mMultipartReceiveResp.completionCode) + sizeof(mMultipartReceiveResp.transferFlag) +
-		sizeof(mMultipartReceiveResp.nextDataTransferHandle) + sizeof(mMultipartReceiveResp.dataLengthBytes);
-	if (respPayloadLen < payloadHeaderSize ||
-		totalFrameSize < (sizeof(struct mctpSmbusI2cHdr) + sizeof(struct pldmHdr) + payloadHeaderSize)) {
-		ERR("PLDM File Transfer: Multipart Receive response too short\n");
-		return PLDM_ERROR;
-	}
-
-	memcpy(&mMultipartReceiveResp.completionCode, &respPayload[0], sizeof(mMultipartReceiveResp.completionCode));
-	memcpy(&mMultipartReceiveResp.transferFlag, &respPayload[1], sizeof(mMultipartReceiveResp.transferFlag));
-	memcpy(&mMultipartReceiveResp.nextDataTransferHandle, &respPayload[2],
-		   sizeof(mMultipartReceiveResp.nextDataTransferHandle));
-	memcpy(&mMultipartReceiveResp.dataLengthBytes, &respPayload[6], sizeof(mMultipartReceiveResp.dataLengthBytes));
-
-	if (mMultipartReceiveResp.completionCode == PLDM_ERROR_UNSUPPORTED_PLDM_CMD) {
-		mMultipartReceiveResp.dataLengthBytes = 0;
-		mDfReadResp.dataLength = 0;
-		return PLDM_ERROR_UNSUPPORTED_PLDM_CMD;
-	}
-
-	const size_t payloadDataBytes = respPayloadLen - payloadHeaderSize;
-	if (mMultipartReceiveResp.dataLengthBytes > sizeof(mDfReadResp.data) ||
-		mMultipartReceiveResp.dataLengthBytes > payloadDataBytes) {
-		ERR("PLDM File Transfer: Multipart Receive data length mismatch ({}, frame {})\n",
-			mMultipartReceiveResp.dataLengthBytes, static_cast<unsigned int>(payloadDataBytes));
-		return PLDM_ERROR;
-	}
-
-	memcpy(mDfReadResp.data, &respPayload[payloadHeaderSize], mMultipartReceiveResp.dataLengthBytes);
-	mDfReadResp.dataLength = mMultipartReceiveResp.dataLengthBytes;
-
-	DBG("PLDM Multipart Receive response: completion=0x{:02x} flag=0x{:02x} len={} next=0x{:08x}\n",
-		mMultipartReceiveResp.completionCode, mMultipartReceiveResp.transferFlag, mMultipartReceiveResp.dataLengthBytes,
-		mMultipartReceiveResp.nextDataTransferHandle);
-	return PLDM_SUCCESS;
-}
-
 /**
  * @brief Validates the response payload for PLDM file transfer commands
  *
@@ -613,11 +541,7 @@ uint8_t pldm::pldmFileTransferRespPayload(const uint8_t *respPayload, const size
 	}
 
 	if (respPayload[0] != PLDM_SUCCESS) {
-		if (cmd == PLDM_MULTIPART_RECEIVE && respPayload[0] == PLDM_ERROR_UNSUPPORTED_PLDM_CMD) {
-			return PLDM_SUCCESS;
-		}
-
-		if (cmd != PLDM_MULTIPART_RECEIVE && (respPayload[0] >= PLDM_FT_COMPLCODE_INVALID_FILE_DESCRIPTOR) &&
+		if ((respPayload[0] >= PLDM_FT_COMPLCODE_INVALID_FILE_DESCRIPTOR) &&
 			(respPayload[0] <= PLDM_FT_COMPLCODE_UNABLE_TO_OPEN_FILE)) {
 			ERR("PLDM File Transfer: File transfer completion code 0x{:02x}\n", respPayload[0]);
 		} else {
@@ -626,8 +550,7 @@ uint8_t pldm::pldmFileTransferRespPayload(const uint8_t *respPayload, const size
 		return PLDM_ERROR;
 	}
 
-	if (cmd != PLDM_MULTIPART_RECEIVE &&
-		(mI2cPldmRead->mctpSmbusHdr.som != PLDM_SOM_BIT_ON || mI2cPldmRead->mctpSmbusHdr.eom != PLDM_EOM_BIT_ON)) {
+	if (mI2cPldmRead->mctpSmbusHdr.som != PLDM_SOM_BIT_ON || mI2cPldmRead->mctpSmbusHdr.eom != PLDM_EOM_BIT_ON) {
 		ERR("PLDM File Transfer: Multi-part response is not supported\n");
 		return PLDM_ERROR;
 	}
@@ -683,83 +606,6 @@ uint8_t pldm::pldmDfCloseCommand(uint16_t fileDescriptor)
 	return pldmFileTransferCmd(PLDM_FT_CMDCODE_DF_CLOSE, size);
 }
 
-/**
- * @brief Executes the PLDM MULTIPART_RECEIVE command to receive a file in multiple parts.
- *
- * This function constructs and sends the MULTIPART_RECEIVE command, then processes the response to retrieve the file
- * data.
- *
- * @param[in] fileDescriptor The file descriptor to read from
- * @param[out] fileData The vector to store the received file data
- * @return uint8_t PLDM_SUCCESS on success, PLDM_ERROR on failure
- */
-uint8_t pldm::pldmMultipartReceiveCommand(uint16_t fileDescriptor, std::vector<uint8_t> &fileData)
-{
-	TRACING();
-
-	const uint32_t maxReadChunk = static_cast<uint32_t>(sizeof(mDfReadResp.data));
-	uint32_t totalBytesRead = 0;
-	uint32_t currentOffset = 0;
-
-	mMultipartReceiveReq = {};
-	mMultipartReceiveReq.pldmType = PLDM_FILE_TRANSFER;
-	mMultipartReceiveReq.transferOperation = PLDM_XFER_FIRST_PART;
-	mMultipartReceiveReq.transferContext = fileDescriptor;
-	mMultipartReceiveReq.dataTransferHandle = 0;
-
-	mMultipartReceiveResp = {};
-	mMultipartReceiveData.clear();
-	uint8_t size = sizeof(mctpSmbusI2cHdr) + sizeof(struct pldmHdr) + sizeof(struct pldm_base_multipart_receive_req);
-	uint8_t ret = PLDM_SUCCESS;
-
-	while (true) {
-		mMultipartReceiveReq.requestedSectionOffset = currentOffset;
-		mMultipartReceiveReq.requestedSectionLengthBytes = maxReadChunk;
-
-		ret = pldmFileTransferCmd(PLDM_MULTIPART_RECEIVE, size);
-		if (ret != PLDM_SUCCESS) {
-			ERR("PLDM File Transfer: Multipart Receive failed for descriptor 0x{:04x}\n", fileDescriptor);
-			return ret;
-		}
-
-		if (mMultipartReceiveResp.dataLengthBytes > maxReadChunk) {
-			ERR("PLDM File Transfer: Multipart Receive data length {} exceeds request chunk {}\n",
-				mMultipartReceiveResp.dataLengthBytes, maxReadChunk);
-			return PLDM_ERROR;
-		}
-
-		if (mMultipartReceiveResp.dataLengthBytes > 0) {
-			mMultipartReceiveData.insert(mMultipartReceiveData.end(), mDfReadResp.data,
-										 mDfReadResp.data + mMultipartReceiveResp.dataLengthBytes);
-			totalBytesRead += mMultipartReceiveResp.dataLengthBytes;
-			currentOffset += mMultipartReceiveResp.dataLengthBytes;
-
-			INFO("PLDM File Transfer: Read {} bytes this chunk, total read={} bytes\n",
-				 mMultipartReceiveResp.dataLengthBytes, totalBytesRead);
-		}
-
-		if (mMultipartReceiveResp.completionCode == PLDM_ERROR_UNSUPPORTED_PLDM_CMD ||
-			mMultipartReceiveResp.dataLengthBytes == 0 || mMultipartReceiveResp.transferFlag == PLDM_END ||
-			mMultipartReceiveResp.transferFlag == PLDM_START_AND_END ||
-			mMultipartReceiveResp.dataLengthBytes < maxReadChunk) {
-			break;
-		}
-
-		if (mMultipartReceiveResp.transferFlag != PLDM_START && mMultipartReceiveResp.transferFlag != PLDM_MIDDLE) {
-			ERR("PLDM File Transfer: Unexpected multipart transfer flag 0x{:02x}\n",
-				mMultipartReceiveResp.transferFlag);
-			return PLDM_ERROR;
-		}
-
-		mMultipartReceiveReq.transferOperation = PLDM_XFER_NEXT_PART;
-		mMultipartReceiveReq.dataTransferHandle = mMultipartReceiveResp.nextDataTransferHandle;
-	}
-
-	fileData.assign(mMultipartReceiveData.begin(), mMultipartReceiveData.end());
-	DBG("PLDM File Transfer: Multipart transfer completed, total bytes={}\n", totalBytesRead);
-	return PLDM_SUCCESS;
-}
-
 /**
  * @brief Retrieves the PLDM file descriptor PDR for a given file identifier.
  *
@@ -798,18 +644,23 @@ const PdrRecord *pldm::getFilePdrById(uint16_t filePdrId)
 /**
  * @brief Reads a file using PLDM file transfer commands based on a given file PDR identifier.
  *
- * This function initializes the platform monitoring, retrieves the file descriptor PDR, opens the file, and reads its
- * contents using multipart receive if necessary.
+ * This function initializes the platform monitoring, retrieves the file descriptor PDR, opens the file, and streams
+ * its contents into @p sink through the file transfer engine of the card, starting at @p progress.
  *
  * @param[in] filePdrId The identifier of the file PDR to read
- * @param[out] fileData The vector to store the read file data
- * @return uint8_t PLDM_SUCCESS on success, PLDM_ERROR on failure
+ * @param[in] sink Where the file data goes, part by part
+ * @param[in,out] progress Offset and CRC to resume at; on return how far the transfer got
+ * @return uint8_t PLDM_SUCCESS on success, PLDM_ERROR_INVALID_DATA on checksum mismatch, PLDM_ERROR on failure
  */
-uint8_t pldm::getFile(uint16_t filePdrId, std::vector<uint8_t> &fileData)
+uint8_t pldm::getFile(uint16_t filePdrId, FileSink &sink, fileTransferProgress &progress)
 {
 	TRACING();
 
 	DBG("PLDM File Transfer: Initiating file read for file PDR identifier {}\n", filePdrId);
+	if (i2cobj == nullptr) {
+		ERR("I2C interface not initialized\n");
+		return PLDM_ERROR;
+	}
 	uint8_t ret = pfMonCtrlInitialize();
 	if (ret != PLDM_SUCCESS) {
 		ERR("PLDM File Transfer: Failed to initialize platform monitoring\n");
@@ -835,8 +686,10 @@ uint8_t pldm::getFile(uint16_t filePdrId, std::vector<uint8_t> &fileData)
 	DBG("PLDM File Transfer: Opened file identifier 0x{:04x} with descriptor 0x{:04x}\n", fileIdentifier,
 		fileDescriptor);
 
-	fileData.clear();
-	ret = pldmMultipartReceiveCommand(fileDescriptor, fileData);
+	if (mFileEngine == nullptr) {
+		mFileEngine = std::make_unique<FileTransferEngine>(*i2cobj, mDestEid);
+	}
+	ret = mFileEngine->receive(fileDescriptor, sink, progress);
 
 	uint8_t closeRet = pldmDfCloseCommand(fileDescriptor);
 	if (closeRet != PLDM_SUCCESS) {
@@ -848,8 +701,8 @@ uint8_t pldm::getFile(uint16_t filePdrId, std::vector<uint8_t> &fileData)
 	DBG("PLDM File Transfer: Closed file descriptor 0x{:04x}\n", fileDescriptor);
 
 	if (ret == PLDM_SUCCESS) {
-		INFO("PLDM File Transfer: File read completed, total bytes={}\n", fileData.size());
+		INFO("PLDM File Transfer: File read completed, total bytes={}\n", progress.offset);
 	}
 
 	return ret;
-}
\ No newline at end of file
+}
@@ -0,0 +1,336 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "pldm_file_transfer_engine.h"
+#include "pldm.h"
+#include "pldm_constants.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <thread>
+
+namespace {
+
+// Part size of cards that cannot negotiate; what file transfer always asked for
+constexpr uint16_t FT_PART_SIZE_FALLBACK = 512;
+// Largest part size; keeps a part and its headers within FT_MAX_MESSAGE_SIZE
+constexpr uint16_t FT_PART_SIZE_LIMIT = 4096;
+// Largest reassembled PLDM response payload
+constexpr size_t FT_MAX_MESSAGE_SIZE = 8192;
+// CompletionCode, TransferFlag, NextDataTransferHandle and DataLengthBytes
+constexpr size_t FT_PART_HEADER_SIZE = 10;
+// DataIntegrityChecksum following the data of the last part
+constexpr size_t FT_CHECKSUM_SIZE = sizeof(uint32_t);
+
+// Bytes of an MCTP SMBus packet not counted by its byteCount
+constexpr size_t MCTP_PACKET_EXTRA_BYTES = 3;
+// Offset of the data in a packet other than the first, which has no message type
+constexpr size_t MCTP_CONTINUATION_DATA_OFFSET = 8;
+// byteCount of a continuation packet without data
+constexpr size_t MCTP_CONTINUATION_OVERHEAD = 5;
+constexpr uint8_t MCTP_SEQ_MASK = 0x03;
+
+template <typename T> std::array<uint8_t, sizeof(T)> toBytes(const T &value)
+{
+	std::array<uint8_t, sizeof(T)> bytes;
+	memcpy(bytes.data(), &value, sizeof(T));
+	return bytes;
+}
+
+} // namespace
+
+FileTransferEngine::FileTransferEngine(I2CInterface &bus, uint8_t destEid, fileTransferOptions options)
+	: mBus(bus), mDestEid(destEid), mOptions(options)
+{
+	mOptions.maxPartSize = std::clamp<uint16_t>(mOptions.maxPartSize, 1, FT_PART_SIZE_LIMIT);
+	mOptions.minPartSize = std::clamp<uint16_t>(mOptions.minPartSize, 1, mOptions.maxPartSize);
+	mOptions.partAttempts = std::max<uint8_t>(mOptions.partAttempts, 1);
+}
+
+/**
+ * @brief Hands out PLDM instance IDs in the 1..31 cycle the other PLDM commands use
+ */
+uint8_t FileTransferEngine::nextInstanceId()
+{
+	const uint8_t id = mInstanceId;
+	mInstanceId = (mInstanceId + 1 >= PLDM_INSTANCE_ID_MAX) ? 1 : mInstanceId + 1;
+	return id;
+}
+
+/**
+ * @brief Sends one single-packet PLDM request
+ *
+ * @param[in] cmdType    PLDM type of the command
+ * @param[in] cmd        PLDM command code
+ * @param[in] instanceId PLDM instance ID the response will carry
+ * @param[in] payload    Request payload; its CRC is appended
+ * @return bool True if the request was written to the bus
+ */
+bool FileTransferEngine::send(uint8_t cmdType, uint8_t cmd, uint8_t instanceId, std::span<const uint8_t> payload)
+{
+	TRACING();
+	i2cdataPldmInfo frame = {};
+	if (payload.size() >= sizeof(frame.respPayload)) {
+		return false;
+	}
+	const uint8_t size = static_cast<uint8_t>(sizeof(mctpSmbusI2cHdr) + sizeof(pldmHdr) + payload.size());
+
+	// Exclude first 3 bytes of MCTP header while calculating byte count
+	mctp::smbusHeaderConstruction(&frame.mctpSmbusHdr, mDestEid, MCTP_SOM, MCTP_EOM, MCTP_PAK_SEQ, size - 3,
+								  MCTP_INTEGRITY_CHECK);
+	frame.mctpSmbusHdr.msgType = PLDM_OVER_MCTP;
+	if (pldm::pldmHdrConstruction(&frame.pldmHdr, instanceId, cmdType, cmd, PLDM_ASYNC_REQUEST_NOTIFY,
+								  PLDM_REQUEST) != PLDM_SUCCESS) {
+		return false;
+	}
+	memcpy(frame.respPayload, payload.data(), payload.size());
+	frame.respPayload[payload.size()] = crc8Smbus(frame.respPayload, payload.size());
+
+	DBG("PLDM File Transfer TX :: ");
+	hexdump(reinterpret_cast<uint8_t *>(&frame), size + 1);
+
+	uint8_t *wptr = reinterpret_cast<uint8_t *>(&frame);
+	if (!mBus.writeAmc(wptr + 1, size)) {
+		ERR("PLDM File Transfer: I2C write failed for command 0x{:02x}\n", cmd);
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Reassembles the response to one request from its MCTP packets
+ *
+ * Packets are polled for until none has arrived for responseTimeout. A message with
+ * another instance ID or command, such as the late response to a request given up
+ * earlier, is skipped packet by packet.
+ *
+ * @param[in]  cmdType    PLDM type of the request
+ * @param[in]  cmd        PLDM command code of the request
+ * @param[in]  instanceId PLDM instance ID of the request
+ * @param[out] payload    The PLDM payload of the response, starting at the completion code
+ * @return bool True if the complete response was received
+ */
+bool FileTransferEngine::receiveMessage(uint8_t cmdType, uint8_t cmd, uint8_t instanceId,
+										std::vector<uint8_t> &payload)
+{
+	TRACING();
+	constexpr size_t payloadOffset = sizeof(mctpSmbusI2cHdr) + sizeof(pldmHdr);
+
+	payload.clear();
+	bool assembling = false;
+	uint8_t expectedSeq = 0;
+	auto deadline = std::chrono::steady_clock::now() + mOptions.responseTimeout;
+
+	while (std::chrono::steady_clock::now() < deadline) {
+		i2cdataPldmInfo frame = {};
+		uint8_t *rptr = reinterpret_cast<uint8_t *>(&frame);
+		if (!mBus.readAmc(rptr + 1, PLDM_MAX_RESPONSE_SIZE)) {
+			std::this_thread::sleep_for(mOptions.pollInterval);
+			continue;
+		}
+
+		const mctpSmbusI2cHdr &hdr = frame.mctpSmbusHdr;
+		const size_t frameBytes = static_cast<size_t>(hdr.byteCount) + MCTP_PACKET_EXTRA_BYTES;
+		const uint8_t seq = static_cast<uint8_t>(hdr.packSeq & MCTP_SEQ_MASK);
+		if (hdr.cmdCode != MCTP_CMD_CODE || frameBytes > PLDM_MAX_RESPONSE_SIZE + 1) {
+			DBG("PLDM File Transfer: Skipping invalid MCTP packet\n");
+			continue;
+		}
+
+		if (hdr.som == PLDM_SOM_BIT_ON) {
+			// The request bit is not checked: some platforms lay the bitfield out differently
+			if (frameBytes < payloadOffset || hdr.msgType != PLDM_OVER_MCTP || frame.pldmHdr.cmdType != cmdType ||
+				frame.pldmHdr.cmdCode != cmd || frame.pldmHdr.instanceID != instanceId) {
+				DBG("PLDM File Transfer: Skipping stale response (id {} cmd 0x{:02x}, expected id {} cmd 0x{:02x})\n",
+					static_cast<int>(frame.pldmHdr.instanceID), static_cast<int>(frame.pldmHdr.cmdCode), instanceId,
+					cmd);
+				assembling = false;
+				continue;
+			}
+			payload.assign(rptr + payloadOffset, rptr + frameBytes);
+			assembling = true;
+		} else {
+			if (!assembling) {
+				continue;
+			}
+			if (seq != expectedSeq || hdr.byteCount < MCTP_CONTINUATION_OVERHEAD) {
+				ERR("PLDM File Transfer: Unexpected MCTP packet (seq {} expected {}, byteCount {})\n", seq, expectedSeq,
+					static_cast<int>(hdr.byteCount));
+				return false;
+			}
+			const size_t fragmentLen = hdr.byteCount - MCTP_CONTINUATION_OVERHEAD;
+			if (payload.size() + fragmentLen > FT_MAX_MESSAGE_SIZE) {
+				ERR("PLDM File Transfer: Response exceeds {} bytes\n", FT_MAX_MESSAGE_SIZE);
+				return false;
+			}
+			payload.insert(payload.end(), rptr + MCTP_CONTINUATION_DATA_OFFSET,
+						   rptr + MCTP_CONTINUATION_DATA_OFFSET + fragmentLen);
+		}
+
+		if (hdr.eom == PLDM_EOM_BIT_ON) {
+			DBG("PLDM File Transfer RX :: {} payload bytes\n", payload.size());
+			return true;
+		}
+		expectedSeq = static_cast<uint8_t>((seq + 1) & MCTP_SEQ_MASK);
+		deadline = std::chrono::steady_clock::now() + mOptions.responseTimeout;
+	}
+
+	DBG("PLDM File Transfer: Timed out waiting for response to command 0x{:02x}\n", cmd);
+	return false;
+}
+
+/**
+ * @brief Sends a request with a fresh instance ID and receives its response
+ */
+bool FileTransferEngine::request(uint8_t cmdType, uint8_t cmd, std::span<const uint8_t> request,
+								 std::vector<uint8_t> &response)
+{
+	const uint8_t instanceId = nextInstanceId();
+	return send(cmdType, cmd, instanceId, request) && receiveMessage(cmdType, cmd, instanceId, response);
+}
+
+/**
+ * @brief Negotiates the part size of file transfers with the card
+ *
+ * The requester offers fileTransferOptions::maxPartSize for PLDM type file transfer; the
+ * smaller of that and the responder's part size is used.
+ *
+ * @return uint8_t PLDM completion code of the card, or PLDM_ERROR without response
+ */
+uint8_t FileTransferEngine::negotiate()
+{
+	TRACING();
+	pldm_negotiate_transfer_parameters_req req = {};
+	req.partSize = mOptions.maxPartSize;
+	req.protocolSupport[PLDM_FILE_TRANSFER / 8] |= 1 << (PLDM_FILE_TRANSFER % 8);
+
+	uint8_t ret = PLDM_ERROR;
+	uint16_t partSize = std::min(FT_PART_SIZE_FALLBACK, mOptions.maxPartSize);
+	std::vector<uint8_t> response;
+	if (request(PLDM_MESSAGE_DISCOVERY, PLDM_NEGOTIATE_TRANSFER_PARAMETERS, toBytes(req), response) &&
+		!response.empty()) {
+		ret = response[0];
+		pldm_negotiate_transfer_parameters_resp resp = {};
+		if (ret == PLDM_SUCCESS && response.size() >= sizeof(resp)) {
+			memcpy(&resp, response.data(), sizeof(resp));
+			const bool fileTransfer = resp.protocolSupport[PLDM_FILE_TRANSFER / 8] & (1 << (PLDM_FILE_TRANSFER % 8));
+			if (fileTransfer && resp.partSize > 0) {
+				partSize = std::min(resp.partSize, mOptions.maxPartSize);
+			}
+		}
+	}
+	if (ret != PLDM_SUCCESS) {
+		DBG("PLDM File Transfer: Part size negotiation failed (0x{:02x}), using {} bytes\n", ret, partSize);
+	}
+
+	mNegotiatedPartSize = partSize;
+	mPartSize = partSize;
+	DBG("PLDM File Transfer: Part size {} bytes\n", partSize);
+	return ret;
+}
+
+/**
+ * @brief Receives a file part by part into a sink
+ *
+ * A transfer (re)starts with a FirstPart request at progress.offset and continues with
+ * NextPart requests. The card's checksum covers the data since that FirstPart.
+ *
+ * @param[in]     fileDescriptor Descriptor returned by DfOpen
+ * @param[in]     sink           Where the data goes
+ * @param[in,out] progress       Where to start; on return how far the transfer got
+ * @return uint8_t PLDM_SUCCESS, PLDM_ERROR_INVALID_DATA on checksum mismatch, PLDM_ERROR otherwise
+ */
+uint8_t FileTransferEngine::receive(uint16_t fileDescriptor, FileSink &sink, fileTransferProgress &progress)
+{
+	TRACING();
+	if (mNegotiatedPartSize == 0) {
+		negotiate();
+	}
+	const uint16_t minPartSize = std::min(mOptions.minPartSize, mNegotiatedPartSize);
+
+	bool restart = true;
+	uint32_t handle = 0;
+	uint32_t sectionCrc = 0;
+	uint8_t failures = 0;
+	uint8_t goodParts = 0;
+	std::vector<uint8_t> response;
+
+	for (;;) {
+		pldm_base_multipart_receive_req req = {};
+		req.pldmType = PLDM_FILE_TRANSFER;
+		req.transferOperation = restart ? PLDM_XFER_FIRST_PART : PLDM_XFER_NEXT_PART;
+		req.transferContext = fileDescriptor;
+		req.dataTransferHandle = restart ? 0 : handle;
+		req.requestedSectionOffset = progress.offset;
+		req.requestedSectionLengthBytes = mPartSize;
+
+		bool valid = request(PLDM_MESSAGE_DISCOVERY, PLDM_MULTIPART_RECEIVE, toBytes(req), response) &&
+					 response.size() >= FT_PART_HEADER_SIZE;
+		uint8_t transferFlag = 0;
+		uint32_t nextHandle = 0;
+		uint32_t length = 0;
+		if (valid) {
+			if (response[0] == PLDM_ERROR_UNSUPPORTED_PLDM_CMD) {
+				ERR("PLDM File Transfer: Multipart Receive is not supported by the card\n");
+				return PLDM_ERROR;
+			}
+			transferFlag = response[1];
+			memcpy(&nextHandle, &response[2], sizeof(nextHandle));
+			memcpy(&length, &response[6], sizeof(length));
+			const bool last = transferFlag == PLDM_END || transferFlag == PLDM_START_AND_END;
+			// Only the last part may be shorter than asked for; a short part before it would
+			// end the file early without the checksum that comes with the last part
+			valid = response[0] == PLDM_SUCCESS && FT_PART_HEADER_SIZE + length <= response.size() &&
+					(last ? length <= req.requestedSectionLengthBytes : length == req.requestedSectionLengthBytes) &&
+					(last || transferFlag == PLDM_START || transferFlag == PLDM_MIDDLE);
+		}
+
+		if (!valid) {
+			if (++failures >= mOptions.partAttempts) {
+				ERR("PLDM File Transfer: Giving up at offset {} after {} attempts\n", progress.offset, failures);
+				return PLDM_ERROR;
+			}
+			mPartSize = std::max<uint16_t>(minPartSize, mPartSize / 2);
+			goodParts = 0;
+			restart = true;
+			DBG("PLDM File Transfer: Part at offset {} failed, resuming with {}-byte parts\n", progress.offset,
+				mPartSize);
+			continue;
+		}
+		failures = 0;
+
+		const std::span<const uint8_t> data(response.data() + FT_PART_HEADER_SIZE, length);
+		if (!data.empty() && !sink.write(data)) {
+			ERR("PLDM File Transfer: Failed to write {} bytes at offset {}\n", length, progress.offset);
+			return PLDM_ERROR;
+		}
+		progress.offset += length;
+		sectionCrc = crc32Update(restart ? 0 : sectionCrc, data.data(), data.size());
+		restart = false;
+
+		if (transferFlag == PLDM_END || transferFlag == PLDM_START_AND_END) {
+			if (response.size() >= FT_PART_HEADER_SIZE + length + FT_CHECKSUM_SIZE) {
+				uint32_t checksum = 0;
+				memcpy(&checksum, &response[FT_PART_HEADER_SIZE + length], sizeof(checksum));
+				if (checksum != sectionCrc) {
+					ERR("PLDM File Transfer: Checksum mismatch (card 0x{:08x}, received 0x{:08x})\n", checksum,
+						sectionCrc);
+					return PLDM_ERROR_INVALID_DATA;
+				}
+			}
+			DBG("PLDM File Transfer: Transfer completed, total bytes={}\n", progress.offset);
+			return PLDM_SUCCESS;
+		}
+
+		handle = nextHandle;
+		if (++goodParts >= mOptions.growAfter && mPartSize < mNegotiatedPartSize) {
+			mPartSize = static_cast<uint16_t>(std::min<uint32_t>(mNegotiatedPartSize, mPartSize * 2u));
+			goodParts = 0;
+			restart = true;
+			DBG("PLDM File Transfer: Growing parts to {} bytes at offset {}\n", mPartSize, progress.offset);
+		}
+	}
+}
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef __PLDM_FILE_TRANSFER_ENGINE_H
+#define __PLDM_FILE_TRANSFER_ENGINE_H
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <vector>
+
+class I2CInterface;
+
+/**
+ * @brief Destination of the data of a file transfer, written part by part
+ */
+class FileSink
+{
+public:
+	virtual ~FileSink() = default;
+
+	/** @brief Appends @p data; false stops the transfer */
+	virtual bool write(std::span<const uint8_t> data) = 0;
+};
+
+/** @brief Collects the file in memory */
+class VectorFileSink : public FileSink
+{
+public:
+	explicit VectorFileSink(std::vector<uint8_t> &data) : mData(data) {}
+
+	bool write(std::span<const uint8_t> data) override
+	{
+		mData.insert(mData.end(), data.begin(), data.end());
+		return true;
+	}
+
+private:
+	std::vector<uint8_t> &mData;
+};
+
+/** @brief Writes the file to a stream, e.g. a std::ofstream opened for appending */
+class StreamFileSink : public FileSink
+{
+public:
+	explicit StreamFileSink(std::ostream &stream) : mStream(stream) {}
+
+	bool write(std::span<const uint8_t> data) override
+	{
+		mStream.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size()));
+		return static_cast<bool>(mStream);
+	}
+
+private:
+	std::ostream &mStream;
+};
+
+/**
+ * @brief How much of a file has reached the sink; the point a retried transfer resumes at
+ */
+struct fileTransferProgress
+{
+	uint32_t offset = 0; ///< Bytes written to the sink
+};
+
+/**
+ * @brief Tuning of FileTransferEngine; the defaults suit an AMC on a shared SMBus
+ */
+struct fileTransferOptions
+{
+	/** Largest part to ask for; NegotiateTransferParameters may lower it */
+	uint16_t maxPartSize = 1024;
+	/** Smallest part to ask for when failed parts keep halving the part size */
+	uint16_t minPartSize = 128;
+	/** Parts received in a row at one size before the size is doubled again */
+	uint8_t growAfter = 8;
+	/** Attempts per part before the transfer is given up */
+	uint8_t partAttempts = 4;
+	/** Time between attempts to read a packet that is not there yet */
+	std::chrono::milliseconds pollInterval{5};
+	/** Time without a response packet after which a request is given up */
+	std::chrono::milliseconds responseTimeout{1000};
+};
+
+/**
+ * @brief Receives files of one AMC card over PLDM MultipartReceive (DSP0240)
+ *
+ * Every part is written to a FileSink as soon as it arrives, so the size of a file is
+ * not bounded by memory. A part that does not arrive, or arrives malformed, is asked
+ * for again with half the part size, restarting the transfer at the end of the last
+ * good part; after fileTransferOptions::growAfter good parts the size doubles again,
+ * up to the limit agreed with NegotiateTransferParameters. The bus is polled for
+ * response packets rather than waited on for a fixed time.
+ *
+ * DSP0240 carries a CRC-32 of the transferred data in the last part only. The engine
+ * keeps a running CRC of every part it accepts since the last FirstPart request and
+ * checks it against that value, if the card sends one; data that reached the sink
+ * before, e.g. in an earlier run, is not covered.
+ *
+ * Not thread safe; one engine per card, used by one thread at a time.
+ */
+class FileTransferEngine
+{
+public:
+	/**
+	 * @param bus     I2C connection of the card
+	 * @param destEid MCTP endpoint ID the card was assigned during initialization
+	 */
+	FileTransferEngine(I2CInterface &bus, uint8_t destEid, fileTransferOptions options = {});
+
+	/**
+	 * @brief Agrees on the largest part size with the card
+	 *
+	 * A card that does not support NegotiateTransferParameters for file transfer gets
+	 * the 512-byte parts file transfer always used.
+	 *
+	 * @return uint8_t The PLDM completion code of the negotiation; the engine is usable
+	 *         either way
+	 */
+	uint8_t negotiate();
+
+	/**
+	 * @brief Receives the file open as @p fileDescriptor into @p sink
+	 *
+	 * @param[in]     fileDescriptor Descriptor returned by DfOpen
+	 * @param[in]     sink           Where the data goes
+	 * @param[in,out] progress       Where to start; on return how far the transfer got
+	 * @return uint8_t PLDM_SUCCESS, PLDM_ERROR_INVALID_DATA when the checksum of the card
+	 *         does not match the data, PLDM_ERROR otherwise
+	 */
+	uint8_t receive(uint16_t fileDescriptor, FileSink &sink, fileTransferProgress &progress);
+
+	/** @brief Part size agreed by negotiate(); 0 before */
+	[[nodiscard]] uint16_t negotiatedPartSize() const { return mNegotiatedPartSize; }
+
+	/** @brief Part size the next request asks for */
+	[[nodiscard]] uint16_t partSize() const { return mPartSize; }
+
+private:
+	bool send(uint8_t cmdType, uint8_t cmd, uint8_t instanceId, std::span<const uint8_t> payload);
+	bool receiveMessage(uint8_t cmdType, uint8_t cmd, uint8_t instanceId, std::vector<uint8_t> &payload);
+	bool request(uint8_t cmdType, uint8_t cmd, std::span<const uint8_t> request, std::vector<uint8_t> &response);
+	uint8_t nextInstanceId();
+
+	I2CInterface &mBus;
+	uint8_t mDestEid;
+	fileTransferOptions mOptions;
+	uint16_t mNegotiatedPartSize = 0;
+	uint16_t mPartSize = 0;
+	uint8_t mInstanceId = 1;
+};
+
+#endif // __PLDM_FILE_TRANSFER_ENGINE_H
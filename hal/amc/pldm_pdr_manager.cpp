@@ -6,21 +6,15 @@
 
 #include "pldm_pdr_manager.h"
 #include "pldm_constants.h"
-#include <iostream>
 #include <cstring>
-#include <cmath>
 
 /**
- * @brief Clears all PDR records and sensor caches
+ * @brief Clears all PDR records
  */
 void PdrManager::clear()
 {
 	mPdrs.clear();
 	mCurrentPdr.data.clear();
-	mTempSensors.clear();
-	mVoltageSensors.clear();
-	mCurrentSensors.clear();
-	mPowerSensors.clear();
 }
 
 /**
@@ -45,118 +39,3 @@ void PdrManager::finishPdrRecord()
 	}
 	mCurrentPdr.data.clear();
 }
-
-/**
- * @brief Retrieves sensor records matching a specific unit
- *
- * Reference for sensorUnits are taken from the DSP0248 specification.
- *
- * @param[in] unit The sensor unit to filter by
- * @return const std::vector<const PdrRecord*>& Vector of pointers to matching PDR records
- */
-const std::vector<const PdrRecord *> &PdrManager::getSensorRecords(sensorUnits unit) const
-{
-	switch (unit) {
-	case sensorUnits::PLDM_UNIT_DEGREES_C:
-		return mTempSensors;
-	case sensorUnits::PLDM_UNIT_VOLTS:
-		return mVoltageSensors;
-	case sensorUnits::PLDM_UNIT_CURRENT_AMPS:
-		return mCurrentSensors;
-	case sensorUnits::PLDM_UNIT_WATTS:
-		return mPowerSensors;
-	default:
-		static const std::vector<const PdrRecord *> empty;
-		return empty;
-	}
-}
-
-/**
- * @brief Builds internal caches for different sensor types from the PDR list
- *
- * This function categorizes sensors based on their base unit and stores
- * pointers to their PDR records in corresponding vectors for quick access.
- *
- */
-void PdrManager::buildSensorCache()
-{
-	mTempSensors.clear();
-	mVoltageSensors.clear();
-	mCurrentSensors.clear();
-	mPowerSensors.clear();
-
-	for (const auto &pdr : mPdrs) {
-		if (pdr.header.type != PLDM_NUMERIC_SENSOR_PDR)
-			continue;
-		if (pdr.data.size() < sizeof(pldmNumericSensorValuePdr))
-			continue;
-
-		const pldmNumericSensorValuePdr *sensor = reinterpret_cast<const pldmNumericSensorValuePdr *>(pdr.data.data());
-
-		switch (sensor->baseUnit) {
-		case PLDM_UNIT_DEGREES_C:
-			mTempSensors.push_back(&pdr);
-			break;
-		case PLDM_UNIT_VOLTS:
-			mVoltageSensors.push_back(&pdr);
-			break;
-		case PLDM_UNIT_CURRENT_AMPS:
-			mCurrentSensors.push_back(&pdr);
-			break;
-		case PLDM_UNIT_WATTS:
-			mPowerSensors.push_back(&pdr);
-			break;
-		default:
-			break;
-		}
-	}
-}
-
-/**
- * @brief Converts a raw sensor reading to a real-world value
- *
- * The formula for conversion taken from the DSP0248 specification:
- *   Sensor Value = (Raw Reading * Resolution) + Offset
- *   Adjusted by Unit Modifier: Value * (10 ^ Unit Modifier)
- *
- * @param[in] sensor Pointer to the numeric sensor PDR
- * @param[in] sensorValue The raw value read from the sensor
- * @return std::optional<double> The converted value, or nullopt if sensor is null
- */
-std::optional<double> PdrManager::convertReading(const pldmNumericSensorValuePdr *sensor,
-												 sensorReadingValue sensorValue)
-{
-	if (sensor == nullptr) {
-		return std::nullopt;
-	}
-
-	float resolution = sensor->resolution;
-	float offset = sensor->offset;
-	int8_t unitModifier = sensor->unitModifier;
-	double value = 0.0;
-	switch (sensorValue.sensorDataSize) {
-	case PLDM_SENSOR_DATA_SIZE_UINT8:
-		value = (static_cast<double>(sensorValue.data.value_u8) * resolution) + offset;
-		break;
-	case PLDM_SENSOR_DATA_SIZE_SINT8:
-		value = (static_cast<double>(sensorValue.data.value_s8) * resolution) + offset;
-		break;
-	case PLDM_SENSOR_DATA_SIZE_UINT16:
-		value = (static_cast<double>(sensorValue.data.value_u16) * resolution) + offset;
-		break;
-	case PLDM_SENSOR_DATA_SIZE_SINT16:
-		value = (static_cast<double>(sensorValue.data.value_s16) * resolution) + offset;
-		break;
-	case PLDM_SENSOR_DATA_SIZE_UINT32:
-		value = (static_cast<double>(sensorValue.data.value_u32) * resolution) + offset;
-		break;
-	case PLDM_SENSOR_DATA_SIZE_SINT32:
-		value = (static_cast<double>(sensorValue.data.value_s32) * resolution) + offset;
-		break;
-	default:
-		return std::nullopt;
-	}
-	value *= std::pow(10, unitModifier);
-
-	return value;
-}
@@ -46,15 +46,6 @@ uint8_t pldm::pfFillPayload(uint8_t cmd, uint8_t size)
 		offset += sizeof(pfPdrReq.recordChangeNumber);
 		payloadPtr[offset] = crc8Smbus(payloadPtr, offset - 1);
 		break;
-	case PLDM_GET_SENSOR_READING:
-		offset = 0;
-		memcpy(payloadPtr + offset, &pfSensorReadingReq.sensorId, sizeof(pfSensorReadingReq.sensorId));
-		offset += sizeof(pfSensorReadingReq.sensorId);
-		payloadPtr[offset] = pfSensorReadingReq.rearmEventState;
-		offset += sizeof(pfSensorReadingReq.rearmEventState);
-		DBG("PLDM Platform: Get Sensor Reading payload filled\n");
-		payloadPtr[offset] = crc8Smbus(payloadPtr, offset - 1);
-		break;
 	default:
 		ERR("PLDM Platform: Unknown command payload fill\n");
 		return PLDM_ERROR;
@@ -66,8 +57,8 @@ uint8_t pldm::pfFillPayload(uint8_t cmd, uint8_t size)
  * @brief Sends a PLDM Platform Monitoring and Control command
  *
  * Sends a PLDM command related to platform monitoring and control,
- * such as GetPDRRepositoryInfo, GetPDR, GetSensorReading. Handles multi-part responses
- * for commands like GetPDR.
+ * such as GetPDRRepositoryInfo and GetPDR. Handles multi-part responses
+ * for commands like GetPDR. Sensor readings go through SensorEngine instead.
  *
  * @param[in] cmd The PLDM command code
  * @param[in] size The size of the command payload
@@ -201,61 +192,6 @@ uint8_t pldm::pfPdrRespPayload()
 	return PLDM_SUCCESS;
 }
 
-/**
- * @brief Handles the response payload for Get Sensor Reading command
- *
- * Parses the response payload for the Get Sensor Reading command
- * and updates the internal state with the sensor reading.
- *
- * @return uint8_t PLDM_SUCCESS on success, PLDM_ERROR on failure
- */
-uint8_t pldm::pfSensorReadingRespPayload()
-{
-	DBG("Handling Sensor Reading response\n");
-	if (mI2cPldmRead->respPayload[0] != PLDM_SUCCESS) {
-		ERR("PLDM Platform: Get Sensor Reading command failed with code 0x{:02x}\n", mI2cPldmRead->respPayload[0]);
-		return PLDM_ERROR;
-	}
-
-	pldmGetSensorReadingResp *resp = (pldmGetSensorReadingResp *)mI2cPldmRead->respPayload;
-
-	pfSensorReadingResp.completionCode = resp->completionCode;
-	pfSensorReadingResp.sensorDataSize = resp->sensorDataSize;
-	pfSensorReadingResp.sensorOperationalState = resp->sensorOperationalState;
-	pfSensorReadingResp.sensorEventMessageEnable = resp->sensorEventMessageEnable;
-	pfSensorReadingResp.presentState = resp->presentState;
-	pfSensorReadingResp.previousState = resp->previousState;
-	pfSensorReadingResp.eventState = resp->eventState;
-
-	// Extract raw value based on sensorDataSize
-	uint8_t *valPtr = resp->presentReading;
-	mSensorReading.sensorDataSize = resp->sensorDataSize;
-
-	switch (mSensorReading.sensorDataSize) {
-	case PLDM_SENSOR_DATA_SIZE_UINT8:
-		mSensorReading.data.value_u8 = *valPtr;
-		break;
-	case PLDM_SENSOR_DATA_SIZE_SINT8:
-		mSensorReading.data.value_s8 = (int8_t)*valPtr;
-		break;
-	case PLDM_SENSOR_DATA_SIZE_UINT16:
-		mSensorReading.data.value_u16 = *(uint16_t *)valPtr;
-		break;
-	case PLDM_SENSOR_DATA_SIZE_SINT16:
-		mSensorReading.data.value_s16 = *(int16_t *)valPtr;
-		break;
-	case PLDM_SENSOR_DATA_SIZE_UINT32:
-		mSensorReading.data.value_u32 = *(uint32_t *)valPtr;
-		break;
-	case PLDM_SENSOR_DATA_SIZE_SINT32:
-		mSensorReading.data.value_s32 = *(int32_t *)valPtr;
-		break;
-	default:
-		return PLDM_ERROR;
-	}
-	return PLDM_SUCCESS;
-}
-
 /**
  * @brief Processes the response for PLDM Platform commands
  *
@@ -273,8 +209,6 @@ uint8_t pldm::processPlatformResponse(uint8_t cmd, uint8_t id)
 		return pfPdrRepoRespPayload();
 	case PLDM_GET_PDR:
 		return pfPdrRespPayload();
-	case PLDM_GET_SENSOR_READING:
-		return pfSensorReadingRespPayload();
 	default:
 		ERR("PLDM Platform: Unknown command response\n");
 		return PLDM_ERROR;
@@ -335,123 +269,87 @@ uint8_t pldm::pfGetTotalPdrs()
 }
 
 /**
- * @brief Retrieves and processes the sensor value for a given sensor PDR
+ * @brief Initializes the PLDM Platform Monitoring and Control
  *
- * Sends the Get Sensor Reading command for the specified sensor PDR
- * and processes the returned sensor value.
+ * Retrieves PDR repository information and total PDRs
+ * to prepare for sensor monitoring and control operations.
  *
- * @param[in] sensor Pointer to the numeric sensor PDR
  * @return uint8_t PLDM_SUCCESS on success, PLDM_ERROR on failure
  */
-uint8_t pldm::pfGetSensorValue(const pldmNumericSensorValuePdr *sensor)
+uint8_t pldm::pfMonCtrlInitialize()
 {
 	TRACING();
-	uint8_t cmd = PLDM_GET_SENSOR_READING;
-	uint8_t size = sizeof(mctpSmbusI2cHdr) + sizeof(pldmHdr) + sizeof(pldmGetSensorReadingReq);
-
-	pfSensorReadingReq.sensorId = sensor->sensorId;
-	pfSensorReadingReq.rearmEventState = 0;
-
-	if (pfMonCtrlCmd(cmd, size) != 0) {
-		ERR("Failed to send PFMonCtrl command\n");
+	if (pfGetPdrRepositoryInfo() != PLDM_SUCCESS) {
+		ERR("Failed to get PDR Repository Info\n");
 		return PLDM_ERROR;
 	}
 
-	auto optValue = mPdrManager.convertReading(sensor, mSensorReading);
-	if (!optValue.has_value()) {
-		ERR("Failed to convert sensor reading for Sensor ID: {}\n", sensor->sensorId);
+	if (pfGetTotalPdrs() != PLDM_SUCCESS) {
+		ERR("Failed to get total PDRs\n");
 		return PLDM_ERROR;
 	}
-	double value = optValue.value();
-	mSensorInfoList.push_back(
-		{sensor->sensorId, sensor->entityType, sensor->entityInstanceNum, sensor->containerId, value});
+
 	return PLDM_SUCCESS;
 }
 
 /**
- * @brief Retrieves sensor values by sensor ID
+ * @brief Builds the sensor table and sensor engine of the card once
  *
- * Searches for the sensor PDR with the specified sensor ID
- * and retrieves its value.
+ * Fetches the PDR repository on first use only; later calls reuse the table, so
+ * repeated and periodic sensor reads cost one GetSensorReading per sensor.
  *
- * @param[in] sensorId The ID of the sensor to retrieve
  * @return uint8_t PLDM_SUCCESS on success, PLDM_ERROR on failure
  */
-uint8_t pldm::pfGetSensorValuesById(uint16_t sensorId)
+uint8_t pldm::pfLoadSensorTable()
 {
 	TRACING();
-
-	for (const auto &record : mPdrManager.getPdrRecords()) {
-		const pldmNumericSensorValuePdr *sensorPdr =
-			reinterpret_cast<const pldmNumericSensorValuePdr *>(record.data.data());
-		if (sensorPdr->sensorId != sensorId) {
-			continue;
-		}
-		return pfGetSensorValue(sensorPdr);
+	if (mSensorEngine != nullptr) {
+		return PLDM_SUCCESS;
 	}
-
-	return PLDM_ERROR;
-}
-
-/**
- * @brief Retrieves sensor values by sensor unit type
- *
- * Searches for all sensor PDRs with the specified unit type
- * and retrieves their values.
- *
- * @param[in] unit The sensor unit type to filter by
- * @return uint8_t PLDM_SUCCESS on success, PLDM_ERROR on failure
- */
-uint8_t pldm::pfGetSensorValuesByUnit(sensorUnits unit)
-{
-	TRACING();
-	const auto &sensorRecords = mPdrManager.getSensorRecords(unit);
-	if (sensorRecords.empty()) {
-		ERR("No sensors found in PDRs for the specified unit\n");
+	if (i2cobj == nullptr) {
+		ERR("I2C interface not initialized\n");
 		return PLDM_ERROR;
 	}
-	for (const auto *record : sensorRecords) {
-		DBG("Found Sensor Handle: {}\n", record->header.recordHandle);
-		const pldmNumericSensorValuePdr *sensor =
-			reinterpret_cast<const pldmNumericSensorValuePdr *>(record->data.data());
 
-		if (pfGetSensorValue(sensor) != PLDM_SUCCESS) {
-			ERR("Failed to get sensor value for handle: {}\n", record->header.recordHandle);
-			continue;
-		}
+	uint8_t ret = pfMonCtrlInitialize();
+	if (ret != PLDM_SUCCESS) {
+		ERR("Failed to initialize PFMonCtrl\n");
+		return PLDM_ERROR;
 	}
+	mSensorTable = SensorTable::fromPdrs(mPdrManager.getPdrRecords());
+	if (mSensorTable.empty()) {
+		ERR("No numeric sensors found in PDRs\n");
+		return PLDM_ERROR;
+	}
+	mSensorEngine = std::make_unique<SensorEngine>(*i2cobj, mDestEid);
 	return PLDM_SUCCESS;
 }
 
 /**
- * @brief Initializes the PLDM Platform Monitoring and Control
- *
- * Retrieves PDR repository information and total PDRs
- * to prepare for sensor monitoring and control operations.
+ * @brief Reads a set of sensors of the card
  *
- * @return uint8_t PLDM_SUCCESS on success, PLDM_ERROR on failure
+ * @param[in]  sensorIds Sensors to read; all numeric sensors of the card if empty
+ * @param[out] readings  The sensors that were read, in @p sensorIds order
+ * @return uint8_t PLDM_SUCCESS when every sensor was read, PLDM_ERROR otherwise
  */
-uint8_t pldm::pfMonCtrlInitialize()
+uint8_t pldm::readSensors(std::span<const uint16_t> sensorIds, std::vector<pldmSensorInfo> &readings)
 {
 	TRACING();
-	if (pfGetPdrRepositoryInfo() != PLDM_SUCCESS) {
-		ERR("Failed to get PDR Repository Info\n");
+	readings.clear();
+	if (pfLoadSensorTable() != PLDM_SUCCESS) {
 		return PLDM_ERROR;
 	}
-
-	if (pfGetTotalPdrs() != PLDM_SUCCESS) {
-		ERR("Failed to get total PDRs\n");
-		return PLDM_ERROR;
+	if (sensorIds.empty()) {
+		const auto all = mSensorTable.ids();
+		return mSensorEngine->read(mSensorTable, all, readings);
 	}
-
-	return PLDM_SUCCESS;
+	return mSensorEngine->read(mSensorTable, sensorIds, readings);
 }
 
 /**
  * @brief Retrieves sensor information by sensor ID
  *
- * Initializes the platform monitoring and control,
- * then retrieves the sensor value for the specified sensor ID.
+ * Reads the sensor and appends it to the sensor info list.
  *
  * @param[in] sensorId The ID of the sensor to retrieve
  * @return uint8_t PLDM_SUCCESS on success, PLDM_ERROR on failure
@@ -460,24 +358,21 @@ uint8_t pldm::getSensorInfoById(uint16_t sensorId)
 {
 	TRACING();
 
-	uint8_t ret = pfMonCtrlInitialize();
-	if (ret != PLDM_SUCCESS) {
-		ERR("Failed to initialize PFMonCtrl\n");
-		return PLDM_ERROR;
-	}
-	ret = pfGetSensorValuesById(sensorId);
+	std::vector<pldmSensorInfo> readings;
+	uint8_t ret = readSensors(std::span<const uint16_t>(&sensorId, 1), readings);
 	if (ret != PLDM_SUCCESS) {
 		ERR("Failed to get sensor values\n");
 		return PLDM_ERROR;
 	}
+	mSensorInfoList.insert(mSensorInfoList.end(), readings.begin(), readings.end());
 	return PLDM_SUCCESS;
 }
 
 /**
  * @brief Retrieves sensor information by sensor unit type
  *
- * Initializes the platform monitoring and control,
- * then retrieves sensor values for all sensors with the specified unit type.
+ * Reads all sensors with the specified unit type and appends them to the sensor
+ * info list. Sensors that fail to read are left out.
  *
  * @param[in] unit The sensor unit type to filter by
  * @return uint8_t PLDM_SUCCESS on success, PLDM_ERROR on failure
@@ -486,16 +381,16 @@ uint8_t pldm::getSensorInfoByUnit(sensorUnits unit)
 {
 	TRACING();
 
-	uint8_t ret = pfMonCtrlInitialize();
-	if (ret != PLDM_SUCCESS) {
-		ERR("Failed to initialize PFMonCtrl\n");
+	if (pfLoadSensorTable() != PLDM_SUCCESS) {
 		return PLDM_ERROR;
 	}
-	pfBuildPdrSensorCache();
-	ret = pfGetSensorValuesByUnit(unit);
-	if (ret != PLDM_SUCCESS) {
-		ERR("Failed to get sensor values\n");
+	const auto sensorIds = mSensorTable.ids(unit);
+	if (sensorIds.empty()) {
+		ERR("No sensors found in PDRs for the specified unit\n");
 		return PLDM_ERROR;
 	}
+	std::vector<pldmSensorInfo> readings;
+	mSensorEngine->read(mSensorTable, sensorIds, readings);
+	mSensorInfoList.insert(mSensorInfoList.end(), readings.begin(), readings.end());
 	return PLDM_SUCCESS;
-}
\ No newline at end of file
+}
@@ -139,6 +139,7 @@ struct pldmSensorInfo
 	uint16_t entityInstanceNum;
 	uint16_t containerId;
 	double reading;
+	uint8_t baseUnit; // sensorUnits
 };
 
 // ============================================================================
@@ -0,0 +1,351 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "pldm_sensor_engine.h"
+#include "pldm.h"
+#include "pldm_constants.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <thread>
+
+namespace {
+
+// Bytes of a numeric sensor PDR up to and including the conversion fields
+constexpr size_t SENSOR_PDR_MIN_SIZE = offsetof(pldmNumericSensorValuePdr, accuracy);
+// Offset of presentReading in a GetSensorReading response payload
+constexpr size_t SENSOR_READING_OFFSET = offsetof(pldmGetSensorReadingResp, presentReading);
+// Largest window; stays well below the 31 usable instance IDs so in-flight IDs never repeat
+constexpr uint8_t SENSOR_WINDOW_MAX = 16;
+// Attempts per sensor: the retry only happens when the window drops to 1
+constexpr uint8_t SENSOR_READ_ATTEMPTS = 2;
+
+/**
+ * @brief Width of a PLDM sensorDataSize in bytes; 0 for an unknown size
+ */
+size_t dataSizeBytes(uint8_t sensorDataSize)
+{
+	switch (sensorDataSize) {
+	case PLDM_SENSOR_DATA_SIZE_UINT8:
+	case PLDM_SENSOR_DATA_SIZE_SINT8:
+		return 1;
+	case PLDM_SENSOR_DATA_SIZE_UINT16:
+	case PLDM_SENSOR_DATA_SIZE_SINT16:
+		return 2;
+	case PLDM_SENSOR_DATA_SIZE_UINT32:
+	case PLDM_SENSOR_DATA_SIZE_SINT32:
+		return 4;
+	default:
+		return 0;
+	}
+}
+
+} // namespace
+
+/**
+ * @brief Converts a raw reading to a value in the sensor's base unit
+ *
+ * @param[in] raw The raw value read from the sensor
+ * @return std::optional<double> The converted value, or nullopt for an unknown data size
+ */
+std::optional<double> sensorDescriptor::convert(const sensorReadingValue &raw) const
+{
+	double value = 0.0;
+	switch (raw.sensorDataSize) {
+	case PLDM_SENSOR_DATA_SIZE_UINT8:
+		value = static_cast<double>(raw.data.value_u8);
+		break;
+	case PLDM_SENSOR_DATA_SIZE_SINT8:
+		value = static_cast<double>(raw.data.value_s8);
+		break;
+	case PLDM_SENSOR_DATA_SIZE_UINT16:
+		value = static_cast<double>(raw.data.value_u16);
+		break;
+	case PLDM_SENSOR_DATA_SIZE_SINT16:
+		value = static_cast<double>(raw.data.value_s16);
+		break;
+	case PLDM_SENSOR_DATA_SIZE_UINT32:
+		value = static_cast<double>(raw.data.value_u32);
+		break;
+	case PLDM_SENSOR_DATA_SIZE_SINT32:
+		value = static_cast<double>(raw.data.value_s32);
+		break;
+	default:
+		return std::nullopt;
+	}
+	value = (value * resolution) + offset;
+	return value * std::pow(10, unitModifier);
+}
+
+/**
+ * @brief Builds the sensor table of a card from its PDR repository
+ *
+ * Records that are not numeric sensor PDRs, or are too short to hold the conversion
+ * fields, are skipped. Of several PDRs for the same sensor ID, the first is kept.
+ *
+ * @param[in] pdrs All PDRs of the card
+ * @return SensorTable The numeric sensors of the card
+ */
+SensorTable SensorTable::fromPdrs(const std::vector<PdrRecord> &pdrs)
+{
+	SensorTable table;
+	for (const auto &pdr : pdrs) {
+		if (pdr.header.type != PLDM_NUMERIC_SENSOR_PDR || pdr.data.size() < SENSOR_PDR_MIN_SIZE) {
+			continue;
+		}
+		pldmNumericSensorValuePdr sensor = {};
+		memcpy(&sensor, pdr.data.data(), std::min(pdr.data.size(), sizeof(sensor)));
+		table.mSensors.push_back({sensor.sensorId, sensor.entityType, sensor.entityInstanceNum, sensor.containerId,
+								  sensor.baseUnit, sensor.unitModifier, sensor.resolution, sensor.offset});
+	}
+	std::ranges::stable_sort(table.mSensors, {}, &sensorDescriptor::sensorId);
+	const auto dup = std::ranges::unique(table.mSensors, {}, &sensorDescriptor::sensorId);
+	table.mSensors.erase(dup.begin(), dup.end());
+	DBG("Sensor table: {} numeric sensors out of {} PDRs\n", table.mSensors.size(), pdrs.size());
+	return table;
+}
+
+/**
+ * @brief Looks a sensor up by ID
+ *
+ * @param[in] sensorId The ID of the sensor
+ * @return const sensorDescriptor* The sensor, or nullptr if the card has no such sensor
+ */
+const sensorDescriptor *SensorTable::find(uint16_t sensorId) const
+{
+	const auto it = std::ranges::lower_bound(mSensors, sensorId, {}, &sensorDescriptor::sensorId);
+	if (it == mSensors.end() || it->sensorId != sensorId) {
+		return nullptr;
+	}
+	return &*it;
+}
+
+/**
+ * @brief Lists the IDs of the sensors in the table
+ *
+ * Reference for sensorUnits are taken from the DSP0248 specification.
+ *
+ * @param[in] unit Only list sensors measuring this unit; all sensors if nullopt
+ * @return std::vector<uint16_t> Sensor IDs in ascending order
+ */
+std::vector<uint16_t> SensorTable::ids(std::optional<sensorUnits> unit) const
+{
+	std::vector<uint16_t> result;
+	result.reserve(mSensors.size());
+	for (const auto &sensor : mSensors) {
+		if (!unit.has_value() || sensor.baseUnit == *unit) {
+			result.push_back(sensor.sensorId);
+		}
+	}
+	return result;
+}
+
+SensorEngine::SensorEngine(I2CInterface &bus, uint8_t destEid, sensorEngineOptions options)
+	: mBus(bus), mDestEid(destEid), mOptions(options),
+	  mWindow(std::clamp<uint8_t>(options.window, 1, SENSOR_WINDOW_MAX))
+{}
+
+/**
+ * @brief Hands out PLDM instance IDs in the 1..31 cycle the other PLDM commands use
+ */
+uint8_t SensorEngine::nextInstanceId()
+{
+	const uint8_t id = mInstanceId;
+	mInstanceId = (mInstanceId + 1 >= PLDM_INSTANCE_ID_MAX) ? 1 : mInstanceId + 1;
+	return id;
+}
+
+/**
+ * @brief Sends one GetSensorReading request
+ *
+ * The frame is laid out like the other PLDM platform commands: MCTP SMBus header, PLDM
+ * header, payload and its CRC; the destination slave address byte is not written since
+ * the I2C device addresses the AMC already.
+ *
+ * @param[in] sensorId   Sensor to read
+ * @param[in] instanceId PLDM instance ID the response will carry
+ * @return bool True if the request was written to the bus
+ */
+bool SensorEngine::send(uint16_t sensorId, uint8_t instanceId)
+{
+	TRACING();
+	i2cdataPldmInfo frame = {};
+	const uint8_t size = sizeof(mctpSmbusI2cHdr) + sizeof(pldmHdr) + sizeof(pldmGetSensorReadingReq);
+
+	// Exclude first 3 bytes of MCTP header while calculating byte count
+	mctp::smbusHeaderConstruction(&frame.mctpSmbusHdr, mDestEid, MCTP_SOM, MCTP_EOM, MCTP_PAK_SEQ, size - 3,
+								  MCTP_INTEGRITY_CHECK);
+	frame.mctpSmbusHdr.msgType = PLDM_OVER_MCTP;
+	if (pldm::pldmHdrConstruction(&frame.pldmHdr, instanceId, PLDM_PLATFORM_MONITORING, PLDM_GET_SENSOR_READING,
+								  PLDM_ASYNC_REQUEST_NOTIFY, PLDM_REQUEST) != PLDM_SUCCESS) {
+		return false;
+	}
+
+	uint8_t *payload = frame.respPayload;
+	uint8_t offset = 0;
+	memcpy(payload + offset, &sensorId, sizeof(sensorId));
+	offset += sizeof(sensorId);
+	payload[offset] = 0; // rearmEventState
+	offset += sizeof(uint8_t);
+	payload[offset] = crc8Smbus(payload, offset - 1);
+
+	uint8_t *wptr = reinterpret_cast<uint8_t *>(&frame);
+	if (!mBus.writeAmc(wptr + 1, size)) {
+		ERR("Sensor engine : I2C Write failure for sensor {}\n", sensorId);
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Reads one frame from the bus and decodes it as a GetSensorReading response
+ *
+ * @param[out] raw            The reading, valid when @p completionCode is PLDM_SUCCESS
+ * @param[out] completionCode PLDM completion code of the response
+ * @return std::optional<uint8_t> Instance ID of the response, or nullopt when the bus
+ *         held no GetSensorReading response (yet)
+ */
+std::optional<uint8_t> SensorEngine::receive(sensorReadingValue &raw, uint8_t &completionCode)
+{
+	TRACING();
+	i2cdataPldmInfo frame = {};
+	uint8_t *rptr = reinterpret_cast<uint8_t *>(&frame);
+	if (!mBus.readAmc(rptr + 1, PLDM_MAX_RESPONSE_SIZE)) {
+		return std::nullopt;
+	}
+	if (frame.mctpSmbusHdr.msgType != PLDM_OVER_MCTP || frame.pldmHdr.request != PLDM_RESPONSE ||
+		frame.pldmHdr.cmdType != PLDM_PLATFORM_MONITORING || frame.pldmHdr.cmdCode != PLDM_GET_SENSOR_READING) {
+		return std::nullopt;
+	}
+
+	completionCode = frame.respPayload[0];
+	if (completionCode == PLDM_SUCCESS) {
+		raw = {};
+		raw.sensorDataSize = frame.respPayload[offsetof(pldmGetSensorReadingResp, sensorDataSize)];
+		const size_t width = dataSizeBytes(raw.sensorDataSize);
+		if (width == 0) {
+			completionCode = PLDM_ERROR_INVALID_DATA;
+		} else {
+			// Little-endian on the wire, as the rest of the PLDM code assumes of the host
+			memcpy(&raw.data, frame.respPayload + SENSOR_READING_OFFSET, width);
+		}
+	}
+	return static_cast<uint8_t>(frame.pldmHdr.instanceID);
+}
+
+/**
+ * @brief Reads a set of sensors, keeping up to window() requests in flight
+ *
+ * @param[in]  table     Sensor metadata of the card
+ * @param[in]  sensorIds Sensors to read
+ * @param[out] readings  The sensors that were read, in @p sensorIds order
+ * @return uint8_t PLDM_SUCCESS when all sensors were read, PLDM_ERROR otherwise
+ */
+uint8_t SensorEngine::read(const SensorTable &table, std::span<const uint16_t> sensorIds,
+						   std::vector<pldmSensorInfo> &readings)
+{
+	TRACING();
+	readings.clear();
+	std::vector<std::optional<pldmSensorInfo>> results(sensorIds.size());
+	std::vector<uint8_t> attempts(sensorIds.size(), 0);
+	std::deque<size_t> todo;
+	bool failed = false;
+
+	for (size_t i = 0; i < sensorIds.size(); i++) {
+		if (table.find(sensorIds[i]) == nullptr) {
+			ERR("No sensor PDR for Sensor ID: {}\n", sensorIds[i]);
+			failed = true;
+			continue;
+		}
+		todo.push_back(i);
+	}
+
+	std::vector<pending> inFlight;
+	inFlight.reserve(mWindow);
+	while (!todo.empty() || !inFlight.empty()) {
+		bool sent = false;
+		while (inFlight.size() < mWindow && !todo.empty()) {
+			const size_t index = todo.front();
+			todo.pop_front();
+			const uint8_t instanceId = nextInstanceId();
+			attempts[index]++;
+			if (!send(sensorIds[index], instanceId)) {
+				failed = true;
+				continue;
+			}
+			inFlight.push_back({index, instanceId, std::chrono::steady_clock::now() + mOptions.responseTimeout});
+			sent = true;
+		}
+		if (inFlight.empty()) {
+			break;
+		}
+		std::this_thread::sleep_for(sent ? mOptions.firstPoll : mOptions.pollInterval);
+
+		// Take every response that is ready; a late response to a request given up earlier is skipped
+		sensorReadingValue raw = {};
+		uint8_t completionCode = PLDM_ERROR;
+		while (!inFlight.empty()) {
+			const auto instanceId = receive(raw, completionCode);
+			if (!instanceId.has_value()) {
+				break;
+			}
+			const auto it = std::ranges::find(inFlight, *instanceId, &pending::instanceId);
+			if (it == inFlight.end()) {
+				DBG("Sensor engine : Skipping stale response (instance ID {})\n", static_cast<int>(*instanceId));
+				continue;
+			}
+			const size_t index = it->index;
+			inFlight.erase(it);
+
+			const uint16_t sensorId = sensorIds[index];
+			if (completionCode != PLDM_SUCCESS) {
+				ERR("Get Sensor Reading for Sensor ID {} failed with code 0x{:02x}\n", sensorId, completionCode);
+				failed = true;
+				continue;
+			}
+			const sensorDescriptor *sensor = table.find(sensorId);
+			const auto value = sensor->convert(raw);
+			if (!value.has_value()) {
+				ERR("Failed to convert sensor reading for Sensor ID: {}\n", sensorId);
+				failed = true;
+				continue;
+			}
+			results[index] = pldmSensorInfo{sensor->sensorId, sensor->entityType, sensor->entityInstanceNum,
+											sensor->containerId, *value, sensor->baseUnit};
+		}
+
+		// Give up on requests past their deadline
+		const auto now = std::chrono::steady_clock::now();
+		const uint8_t windowBefore = mWindow;
+		for (auto it = inFlight.begin(); it != inFlight.end();) {
+			if (it->deadline > now) {
+				++it;
+				continue;
+			}
+			if (windowBefore > 1 && attempts[it->index] < SENSOR_READ_ATTEMPTS) {
+				if (mWindow > 1) {
+					DBG("Sensor engine : AMC dropped pipelined requests, reading one sensor at a time\n");
+					mWindow = 1;
+				}
+				todo.push_front(it->index);
+			} else {
+				ERR("Timed out reading Sensor ID: {}\n", sensorIds[it->index]);
+				failed = true;
+			}
+			it = inFlight.erase(it);
+		}
+	}
+
+	readings.reserve(results.size());
+	for (auto &result : results) {
+		if (result.has_value()) {
+			readings.push_back(*result);
+		}
+	}
+	return failed ? PLDM_ERROR : PLDM_SUCCESS;
+}
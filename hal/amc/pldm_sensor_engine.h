@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef __PLDM_SENSOR_ENGINE_H
+#define __PLDM_SENSOR_ENGINE_H
+
+#include "pldm_pdr_manager.h"
+#include "pldm_platform.h"
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+class I2CInterface;
+
+/**
+ * @brief Raw GetSensorReading value, tagged with its PLDM sensorDataSize
+ */
+struct sensorReadingValue
+{
+	uint8_t sensorDataSize;
+	union
+	{
+		uint8_t value_u8;
+		int8_t value_s8;
+		uint16_t value_u16;
+		int16_t value_s16;
+		uint32_t value_u32;
+		int32_t value_s32;
+		real32_t value_f32;
+	} data;
+};
+
+/**
+ * @brief What converting a reading of one numeric sensor needs from its PDR
+ *
+ * A few bytes per sensor instead of the full pldmNumericSensorValuePdr.
+ */
+struct sensorDescriptor
+{
+	uint16_t sensorId;
+	uint16_t entityType;
+	uint16_t entityInstanceNum;
+	uint16_t containerId;
+	uint8_t baseUnit; ///< sensorUnits
+	int8_t unitModifier;
+	real32_t resolution;
+	real32_t offset;
+
+	/**
+	 * @brief Converts a raw reading to a value in the sensor's base unit
+	 *
+	 * Per DSP0248: (raw * resolution + offset) * 10^unitModifier.
+	 *
+	 * @return The value, or nullopt for an unknown sensorDataSize
+	 */
+	[[nodiscard]] std::optional<double> convert(const sensorReadingValue &raw) const;
+};
+
+/**
+ * @brief Numeric sensors of one AMC card, sorted by sensor ID
+ *
+ * Built once from the card's PDR repository; the PDRs themselves are not kept.
+ */
+class SensorTable
+{
+public:
+	/** @brief Extracts every numeric sensor PDR of @p pdrs */
+	static SensorTable fromPdrs(const std::vector<PdrRecord> &pdrs);
+
+	[[nodiscard]] const sensorDescriptor *find(uint16_t sensorId) const;
+
+	/** @brief IDs of all sensors, or of those measuring @p unit */
+	[[nodiscard]] std::vector<uint16_t> ids(std::optional<sensorUnits> unit = std::nullopt) const;
+
+	[[nodiscard]] bool empty() const { return mSensors.empty(); }
+	[[nodiscard]] size_t size() const { return mSensors.size(); }
+
+private:
+	std::vector<sensorDescriptor> mSensors;
+};
+
+/**
+ * @brief Tuning of SensorEngine; the defaults suit an AMC on a shared SMBus
+ */
+struct sensorEngineOptions
+{
+	/** GetSensorReading requests in flight at once; falls back to 1 if the AMC drops any */
+	uint8_t window = 4;
+	/** Time from sending a request to the first attempt to read its response */
+	std::chrono::milliseconds firstPoll{10};
+	/** Time between attempts to read a response that is not there yet */
+	std::chrono::milliseconds pollInterval{10};
+	/** Time after which a request without response is given up */
+	std::chrono::milliseconds responseTimeout{500};
+};
+
+/**
+ * @brief Reads many numeric sensors of one AMC card over PLDM GetSensorReading
+ *
+ * Instead of one request, a fixed wait and one response per sensor, up to
+ * sensorEngineOptions::window requests are sent back to back, each with its own PLDM
+ * instance ID, and responses are matched to requests by that ID as they arrive. The
+ * bus is polled for responses rather than waited on for a fixed time. When requests go
+ * unanswered with more than one in flight, the card evidently serves one at a time:
+ * the window drops to 1 and the unanswered sensors are asked for again.
+ *
+ * Not thread safe; one engine per card, used by one thread at a time.
+ */
+class SensorEngine
+{
+public:
+	/**
+	 * @param bus     I2C connection of the card
+	 * @param destEid MCTP endpoint ID the card was assigned during initialization
+	 */
+	SensorEngine(I2CInterface &bus, uint8_t destEid, sensorEngineOptions options = {});
+
+	/**
+	 * @brief Reads the sensors @p sensorIds
+	 *
+	 * @param[in]  table     Sensor metadata of the card
+	 * @param[in]  sensorIds Sensors to read; IDs missing from @p table fail
+	 * @param[out] readings  One entry per sensor read, in @p sensorIds order
+	 * @return PLDM_SUCCESS when every sensor was read, PLDM_ERROR otherwise; @p readings
+	 *         then holds the sensors that were
+	 */
+	uint8_t read(const SensorTable &table, std::span<const uint16_t> sensorIds,
+				 std::vector<pldmSensorInfo> &readings);
+
+	/** @brief Current number of requests in flight */
+	[[nodiscard]] uint8_t window() const { return mWindow; }
+
+private:
+	struct pending
+	{
+		size_t index; ///< Position in the sensorIds of read()
+		uint8_t instanceId;
+		std::chrono::steady_clock::time_point deadline;
+	};
+
+	bool send(uint16_t sensorId, uint8_t instanceId);
+	std::optional<uint8_t> receive(sensorReadingValue &raw, uint8_t &completionCode);
+	uint8_t nextInstanceId();
+
+	I2CInterface &mBus;
+	uint8_t mDestEid;
+	sensorEngineOptions mOptions;
+	uint8_t mWindow;
+	uint8_t mInstanceId = 1;
+};
+
+#endif // __PLDM_SENSOR_ENGINE_H
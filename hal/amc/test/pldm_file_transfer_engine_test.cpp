@@ -0,0 +1,387 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ * Unit tests for pldm_file_transfer_engine.cpp
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#ifdef INFO
+#undef INFO
+#endif
+
+#include "i2c_interface.h"
+#include "pldm.h"
+#include "pldm_constants.h"
+#include "pldm_file_transfer_engine.h"
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+/// An AMC on the other end of the bus, serving one file over MultipartReceive.
+class FakeAmcResponder : public I2CInterface
+{
+public:
+	struct partRequest
+	{
+		uint8_t operation;
+		uint32_t handle;
+		uint32_t offset;
+		uint32_t length;
+	};
+
+	std::vector<uint8_t> file;
+	bool negotiates = true;			 ///< Answer NegotiateTransferParameters
+	uint16_t responderPartSize = 2048;
+	bool sendChecksum = true;		 ///< Append the DataIntegrityChecksum to the last part
+	bool corruptChecksum = false;
+	size_t packetData = 64;			 ///< Message bytes per MCTP packet
+	std::set<size_t> dropped;		 ///< MultipartReceive requests left unanswered, by index
+	size_t dropFrom = SIZE_MAX;		 ///< Leave this and every later request unanswered
+	std::set<size_t> truncated;		 ///< Requests answered with less data than DataLengthBytes says
+	std::set<size_t> shortened;		 ///< Requests answered with half the data asked for, not as the last part
+	std::set<size_t> preceded;		 ///< Requests whose response follows one with another instance ID
+	std::vector<partRequest> parts;	 ///< Every MultipartReceive request received
+
+	bool writeAmc(void *writeBuffer, size_t writeSize) override
+	{
+		i2cdataPldmInfo frame = {};
+		memcpy(reinterpret_cast<uint8_t *>(&frame) + 1, writeBuffer, std::min(writeSize, sizeof(frame) - 1));
+		const uint8_t instanceId = frame.pldmHdr.instanceID;
+		const uint8_t cmdType = frame.pldmHdr.cmdType;
+		const uint8_t cmd = frame.pldmHdr.cmdCode;
+
+		if (cmd == PLDM_NEGOTIATE_TRANSFER_PARAMETERS) {
+			pldm_negotiate_transfer_parameters_req req = {};
+			memcpy(&req, frame.respPayload, sizeof(req));
+			if (!negotiates) {
+				queue(instanceId, cmdType, cmd, {PLDM_ERROR_UNSUPPORTED_PLDM_CMD});
+				return true;
+			}
+			pldm_negotiate_transfer_parameters_resp resp = {};
+			resp.completionCode = PLDM_SUCCESS;
+			resp.partSize = std::min(req.partSize, responderPartSize);
+			resp.protocolSupport[0] = req.protocolSupport[0];
+			queue(instanceId, cmdType, cmd, bytes(resp));
+			return true;
+		}
+
+		pldm_base_multipart_receive_req req = {};
+		memcpy(&req, frame.respPayload, sizeof(req));
+		const size_t index = parts.size();
+		parts.push_back({req.transferOperation, req.dataTransferHandle, req.requestedSectionOffset,
+						 req.requestedSectionLengthBytes});
+		if (dropped.contains(index) || index >= dropFrom) {
+			return true;
+		}
+
+		uint32_t position = req.dataTransferHandle;
+		const bool first = req.transferOperation == PLDM_XFER_FIRST_PART;
+		if (first) {
+			sectionStart = req.requestedSectionOffset;
+			position = sectionStart;
+		}
+		uint32_t length =
+			std::min<uint32_t>(req.requestedSectionLengthBytes, static_cast<uint32_t>(file.size()) - position);
+		if (shortened.contains(index)) {
+			length /= 2;
+		}
+		const bool last = position + length >= file.size();
+		uint8_t flag = first ? PLDM_START : PLDM_MIDDLE;
+		if (last) {
+			flag = first ? PLDM_START_AND_END : PLDM_END;
+		}
+
+		std::vector<uint8_t> payload = {PLDM_SUCCESS, flag};
+		append(payload, position + length);
+		append(payload, length);
+		payload.insert(payload.end(), file.begin() + position, file.begin() + position + length);
+		if (last && sendChecksum) {
+			uint32_t checksum = crc32Update(0, file.data() + sectionStart, position + length - sectionStart);
+			append(payload, corruptChecksum ? checksum ^ 1 : checksum);
+		}
+		if (truncated.contains(index)) {
+			payload.resize(payload.size() - 16);
+		}
+		if (preceded.contains(index)) {
+			queue((instanceId + 7) % PLDM_INSTANCE_ID_MAX, cmdType, cmd, payload);
+		}
+		queue(instanceId, cmdType, cmd, payload);
+		return true;
+	}
+
+	bool readAmc(void *readBuffer, size_t readSize) override
+	{
+		if (packets.empty()) {
+			return false;
+		}
+		const std::vector<uint8_t> packet = std::move(packets.front());
+		packets.pop_front();
+		memset(readBuffer, 0, readSize);
+		memcpy(readBuffer, packet.data() + 1, std::min(readSize, packet.size() - 1));
+		return true;
+	}
+
+private:
+	template <typename T> static std::vector<uint8_t> bytes(const T &value)
+	{
+		std::vector<uint8_t> out(sizeof(T));
+		memcpy(out.data(), &value, sizeof(T));
+		return out;
+	}
+
+	static void append(std::vector<uint8_t> &out, uint32_t value)
+	{
+		const auto raw = bytes(value);
+		out.insert(out.end(), raw.begin(), raw.end());
+	}
+
+	/// Splits a response into MCTP SMBus packets the way the AMC sends them
+	void queue(uint8_t instanceId, uint8_t cmdType, uint8_t cmd, const std::vector<uint8_t> &payload)
+	{
+		constexpr size_t payloadOffset = sizeof(mctpSmbusI2cHdr) + sizeof(pldmHdr);
+		constexpr size_t continuationOffset = 8;
+		size_t sent = 0;
+		uint8_t seq = 0;
+		do {
+			const bool som = sent == 0;
+			const size_t offset = som ? payloadOffset : continuationOffset;
+			const size_t chunk = std::min(packetData, payload.size() - sent);
+			i2cdataPldmInfo frame = {};
+			frame.mctpSmbusHdr.cmdCode = MCTP_CMD_CODE;
+			frame.mctpSmbusHdr.byteCount = static_cast<uint8_t>(offset + chunk - 3);
+			frame.mctpSmbusHdr.som = som;
+			frame.mctpSmbusHdr.eom = sent + chunk == payload.size();
+			frame.mctpSmbusHdr.packSeq = seq++ & 0x03;
+			if (som) {
+				frame.mctpSmbusHdr.msgType = PLDM_OVER_MCTP;
+				pldm::pldmHdrConstruction(&frame.pldmHdr, instanceId, cmdType, cmd, 0, PLDM_RESPONSE);
+			}
+			std::vector<uint8_t> packet(offset + chunk);
+			memcpy(packet.data(), &frame, std::min(sizeof(frame), offset));
+			std::copy_n(payload.begin() + sent, chunk, packet.begin() + offset);
+			packets.push_back(std::move(packet));
+			sent += chunk;
+		} while (sent < payload.size());
+	}
+
+	std::deque<std::vector<uint8_t>> packets;
+	uint32_t sectionStart = 0;
+};
+
+/// Keeps what it is given, refusing writes past a limit
+class LimitedSink : public FileSink
+{
+public:
+	std::vector<uint8_t> data;
+	size_t limit = SIZE_MAX;
+
+	bool write(std::span<const uint8_t> part) override
+	{
+		if (data.size() + part.size() > limit) {
+			return false;
+		}
+		data.insert(data.end(), part.begin(), part.end());
+		return true;
+	}
+};
+
+std::vector<uint8_t> sampleFile(size_t size)
+{
+	std::vector<uint8_t> file(size);
+	uint32_t state = 0x12345678;
+	for (auto &byte : file) {
+		state = state * 1103515245 + 12345;
+		byte = static_cast<uint8_t>(state >> 16);
+	}
+	return file;
+}
+
+constexpr fileTransferOptions fastOptions{.maxPartSize = 1024,
+										  .minPartSize = 128,
+										  .growAfter = 2,
+										  .partAttempts = 3,
+										  .pollInterval = 1ms,
+										  .responseTimeout = 20ms};
+
+constexpr uint16_t FILE_DESCRIPTOR = 0x0042;
+
+} // namespace
+
+TEST_CASE("crc32Update matches the ISO 3309 check value and continues across calls")
+{
+	const std::string digits = "123456789";
+	const auto *data = reinterpret_cast<const uint8_t *>(digits.data());
+	CHECK(crc32Update(0, data, digits.size()) == 0xCBF43926u);
+	CHECK(crc32Update(crc32Update(0, data, 4), data + 4, 5) == 0xCBF43926u);
+}
+
+TEST_CASE("Negotiation settles on the smaller part size and falls back to 512 bytes")
+{
+	FakeAmcResponder amc;
+	amc.responderPartSize = 256;
+	FileTransferEngine engine(amc, 8, fastOptions);
+	CHECK(engine.negotiate() == PLDM_SUCCESS);
+	CHECK(engine.negotiatedPartSize() == 256);
+
+	FakeAmcResponder legacy;
+	legacy.negotiates = false;
+	FileTransferEngine fallback(legacy, 8, fastOptions);
+	CHECK(fallback.negotiate() == PLDM_ERROR_UNSUPPORTED_PLDM_CMD);
+	CHECK(fallback.negotiatedPartSize() == 512);
+}
+
+TEST_CASE("A file spanning many parts and packets is streamed and checksummed")
+{
+	FakeAmcResponder amc;
+	amc.file = sampleFile(5000);
+	FileTransferEngine engine(amc, 8, fastOptions);
+
+	LimitedSink sink;
+	fileTransferProgress progress;
+	REQUIRE(engine.receive(FILE_DESCRIPTOR, sink, progress) == PLDM_SUCCESS);
+	CHECK(sink.data == amc.file);
+	CHECK(progress.offset == amc.file.size());
+
+	REQUIRE(amc.parts.size() == 5);
+	CHECK(amc.parts[0].operation == PLDM_XFER_FIRST_PART);
+	CHECK(amc.parts[0].length == 1024);
+	CHECK(amc.parts[1].operation == PLDM_XFER_NEXT_PART);
+	CHECK(amc.parts[1].handle == 1024);
+}
+
+TEST_CASE("A lost part halves the part size and resumes at the last good offset")
+{
+	FakeAmcResponder amc;
+	amc.file = sampleFile(6000);
+	amc.dropped = {1};
+	FileTransferEngine engine(amc, 8, fastOptions);
+
+	LimitedSink sink;
+	fileTransferProgress progress;
+	REQUIRE(engine.receive(FILE_DESCRIPTOR, sink, progress) == PLDM_SUCCESS);
+	CHECK(sink.data == amc.file);
+
+	REQUIRE(amc.parts.size() > 5);
+	CHECK(amc.parts[2].operation == PLDM_XFER_FIRST_PART);
+	CHECK(amc.parts[2].offset == 1024);
+	CHECK(amc.parts[2].length == 512);
+	// Two good parts later the size is doubled again, starting over at the current offset
+	CHECK(amc.parts[4].operation == PLDM_XFER_FIRST_PART);
+	CHECK(amc.parts[4].offset == 2048);
+	CHECK(amc.parts[4].length == 1024);
+}
+
+TEST_CASE("Stale and truncated responses do not end up in the file")
+{
+	FakeAmcResponder amc;
+	amc.file = sampleFile(4000);
+	amc.preceded = {0, 2};
+	amc.truncated = {1};
+	FileTransferEngine engine(amc, 8, fastOptions);
+
+	LimitedSink sink;
+	fileTransferProgress progress;
+	REQUIRE(engine.receive(FILE_DESCRIPTOR, sink, progress) == PLDM_SUCCESS);
+	CHECK(sink.data == amc.file);
+	CHECK(amc.parts[2].operation == PLDM_XFER_FIRST_PART);
+	CHECK(amc.parts[2].offset == 1024);
+}
+
+TEST_CASE("A short part before the last one is retried rather than taken for the end of the file")
+{
+	FakeAmcResponder amc;
+	amc.file = sampleFile(4000);
+	amc.shortened = {1};
+	FileTransferEngine engine(amc, 8, fastOptions);
+
+	LimitedSink sink;
+	fileTransferProgress progress;
+	REQUIRE(engine.receive(FILE_DESCRIPTOR, sink, progress) == PLDM_SUCCESS);
+	CHECK(sink.data == amc.file);
+	CHECK(amc.parts[2].operation == PLDM_XFER_FIRST_PART);
+	CHECK(amc.parts[2].offset == 1024);
+}
+
+TEST_CASE("A card that keeps sending short parts fails the transfer")
+{
+	FakeAmcResponder amc;
+	amc.file = sampleFile(4000);
+	amc.shortened = {1, 2, 3};
+	FileTransferEngine engine(amc, 8, fastOptions);
+
+	LimitedSink sink;
+	fileTransferProgress progress;
+	CHECK(engine.receive(FILE_DESCRIPTOR, sink, progress) == PLDM_ERROR);
+	CHECK(progress.offset == 1024);
+}
+
+TEST_CASE("A checksum mismatch fails the transfer")
+{
+	FakeAmcResponder amc;
+	amc.file = sampleFile(3000);
+	amc.corruptChecksum = true;
+	FileTransferEngine engine(amc, 8, fastOptions);
+
+	LimitedSink sink;
+	fileTransferProgress progress;
+	CHECK(engine.receive(FILE_DESCRIPTOR, sink, progress) == PLDM_ERROR_INVALID_DATA);
+}
+
+TEST_CASE("A transfer resumes after the data that reached the sink before")
+{
+	FakeAmcResponder amc;
+	amc.file = sampleFile(5000);
+	FileTransferEngine engine(amc, 8, fastOptions);
+
+	LimitedSink sink;
+	fileTransferProgress progress{3000};
+	REQUIRE(engine.receive(FILE_DESCRIPTOR, sink, progress) == PLDM_SUCCESS);
+	CHECK(sink.data == std::vector<uint8_t>(amc.file.begin() + 3000, amc.file.end()));
+	CHECK(progress.offset == 5000);
+	REQUIRE_FALSE(amc.parts.empty());
+	CHECK(amc.parts[0].operation == PLDM_XFER_FIRST_PART);
+	CHECK(amc.parts[0].offset == 3000);
+}
+
+TEST_CASE("A card that stops answering is given up on, keeping the progress made")
+{
+	FakeAmcResponder amc;
+	amc.file = sampleFile(8000);
+	amc.dropFrom = 2;
+	FileTransferEngine engine(amc, 8, fastOptions);
+
+	LimitedSink sink;
+	fileTransferProgress progress;
+	CHECK(engine.receive(FILE_DESCRIPTOR, sink, progress) == PLDM_ERROR);
+	CHECK(progress.offset == 2048);
+	CHECK(sink.data.size() == 2048);
+	CHECK(amc.parts.size() == 2 + fastOptions.partAttempts);
+
+	// A second attempt, as amcReadFiles() makes, picks up where the first one stopped
+	amc.dropFrom = SIZE_MAX;
+	REQUIRE(engine.receive(FILE_DESCRIPTOR, sink, progress) == PLDM_SUCCESS);
+	CHECK(sink.data == amc.file);
+}
+
+TEST_CASE("A sink that refuses data stops the transfer")
+{
+	FakeAmcResponder amc;
+	amc.file = sampleFile(5000);
+	FileTransferEngine engine(amc, 8, fastOptions);
+
+	LimitedSink sink;
+	sink.limit = 1500;
+	fileTransferProgress progress;
+	CHECK(engine.receive(FILE_DESCRIPTOR, sink, progress) == PLDM_ERROR);
+	CHECK(progress.offset == 1024);
+}
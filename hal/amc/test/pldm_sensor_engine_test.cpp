@@ -0,0 +1,224 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ * Unit tests for pldm_sensor_engine.cpp
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#ifdef INFO
+#undef INFO
+#endif
+
+#include "i2c_interface.h"
+#include "pldm.h"
+#include "pldm_constants.h"
+#include "pldm_sensor_engine.h"
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+/// An AMC on the other end of the bus, answering GetSensorReading from a value map.
+class FakeAmcBus : public I2CInterface
+{
+public:
+	struct request
+	{
+		uint16_t sensorId;
+		uint8_t instanceId;
+	};
+
+	std::map<uint16_t, int16_t> values;	  ///< Raw SINT16 reading per sensor ID
+	std::map<uint16_t, uint8_t> failures; ///< Completion code to answer instead, per sensor ID
+	bool reverse = false;				  ///< Answer queued requests newest first
+	bool dropWhenBusy = false;			  ///< Drop a request arriving while another is unanswered
+	std::vector<request> received;
+
+	bool writeAmc(void *writeBuffer, size_t writeSize) override
+	{
+		i2cdataPldmInfo frame = {};
+		memcpy(reinterpret_cast<uint8_t *>(&frame) + 1, writeBuffer, std::min(writeSize, sizeof(frame) - 1));
+		uint16_t sensorId = 0;
+		memcpy(&sensorId, frame.respPayload, sizeof(sensorId));
+		const request req{sensorId, static_cast<uint8_t>(frame.pldmHdr.instanceID)};
+		received.push_back(req);
+		if (dropWhenBusy && !queued.empty()) {
+			return true;
+		}
+		queued.push_back(req);
+		return true;
+	}
+
+	/// Queue a response to a request that is no longer in flight, e.g. one given up earlier
+	void answerStale(uint8_t instanceId) { queued.push_back({0, instanceId}); }
+
+	bool readAmc(void *readBuffer, size_t readSize) override
+	{
+		if (queued.empty()) {
+			return false;
+		}
+		const request req = reverse ? queued.back() : queued.front();
+		if (reverse) {
+			queued.pop_back();
+		} else {
+			queued.pop_front();
+		}
+
+		i2cdataPldmInfo frame = {};
+		frame.mctpSmbusHdr.msgType = PLDM_OVER_MCTP;
+		pldm::pldmHdrConstruction(&frame.pldmHdr, req.instanceId, PLDM_PLATFORM_MONITORING, PLDM_GET_SENSOR_READING,
+								  0, PLDM_RESPONSE);
+		const auto failure = failures.find(req.sensorId);
+		frame.respPayload[offsetof(pldmGetSensorReadingResp, completionCode)] =
+			(failure != failures.end()) ? failure->second : PLDM_SUCCESS;
+		frame.respPayload[offsetof(pldmGetSensorReadingResp, sensorDataSize)] = PLDM_SENSOR_DATA_SIZE_SINT16;
+		const int16_t raw = values[req.sensorId];
+		memcpy(frame.respPayload + offsetof(pldmGetSensorReadingResp, presentReading), &raw, sizeof(raw));
+		memcpy(readBuffer, reinterpret_cast<uint8_t *>(&frame) + 1, std::min(readSize, sizeof(frame) - 1));
+		return true;
+	}
+
+private:
+	std::deque<request> queued;
+};
+
+PdrRecord numericSensorPdr(uint16_t sensorId, sensorUnits unit, real32_t resolution, real32_t offset,
+						   int8_t unitModifier)
+{
+	pldmNumericSensorValuePdr pdr = {};
+	pdr.hdr.type = PLDM_NUMERIC_SENSOR_PDR;
+	pdr.sensorId = sensorId;
+	pdr.entityType = 0x40;
+	pdr.baseUnit = unit;
+	pdr.unitModifier = unitModifier;
+	pdr.sensorDataSize = PLDM_SENSOR_DATA_SIZE_SINT16;
+	pdr.resolution = resolution;
+	pdr.offset = offset;
+
+	PdrRecord record;
+	record.header = pdr.hdr;
+	record.data.resize(sizeof(pdr));
+	memcpy(record.data.data(), &pdr, sizeof(pdr));
+	return record;
+}
+
+SensorTable sampleTable()
+{
+	std::vector<PdrRecord> pdrs;
+	pdrs.push_back(numericSensorPdr(7, PLDM_UNIT_WATTS, 0.5f, 0.0f, 0));
+	pdrs.push_back(numericSensorPdr(1, PLDM_UNIT_DEGREES_C, 1.0f, -40.0f, 0));
+	pdrs.push_back(numericSensorPdr(3, PLDM_UNIT_VOLTS, 1.0f, 0.0f, -3));
+	PdrRecord other;
+	other.header.type = PLDM_NUMERIC_SENSOR_PDR + 1;
+	other.data.resize(sizeof(pldmNumericSensorValuePdr));
+	pdrs.push_back(other);
+	return SensorTable::fromPdrs(pdrs);
+}
+
+constexpr sensorEngineOptions fastOptions{.window = 4, .firstPoll = 1ms, .pollInterval = 1ms, .responseTimeout = 50ms};
+
+} // namespace
+
+TEST_CASE("SensorTable keeps numeric sensors sorted by ID")
+{
+	const SensorTable table = sampleTable();
+	CHECK(table.size() == 3);
+	CHECK(table.ids() == std::vector<uint16_t>{1, 3, 7});
+	CHECK(table.ids(PLDM_UNIT_WATTS) == std::vector<uint16_t>{7});
+	CHECK(table.find(2) == nullptr);
+	REQUIRE(table.find(7) != nullptr);
+	CHECK(table.find(7)->baseUnit == PLDM_UNIT_WATTS);
+}
+
+TEST_CASE("sensorDescriptor applies resolution, offset and unit modifier")
+{
+	const SensorTable table = sampleTable();
+	sensorReadingValue raw = {};
+	raw.sensorDataSize = PLDM_SENSOR_DATA_SIZE_SINT16;
+	raw.data.value_s16 = 1200;
+	CHECK(table.find(3)->convert(raw).value() == doctest::Approx(1.2));
+	CHECK(table.find(1)->convert(raw).value() == doctest::Approx(1160.0));
+
+	raw.sensorDataSize = 0x7f;
+	CHECK_FALSE(table.find(3)->convert(raw).has_value());
+}
+
+TEST_CASE("SensorEngine pipelines requests and matches responses by instance ID")
+{
+	FakeAmcBus bus;
+	bus.values = {{1, 65}, {3, 850}, {7, 300}};
+	bus.reverse = true;
+	SensorEngine engine(bus, 8, fastOptions);
+
+	const std::vector<uint16_t> ids{7, 1, 3};
+	std::vector<pldmSensorInfo> readings;
+	REQUIRE(engine.read(sampleTable(), ids, readings) == PLDM_SUCCESS);
+	REQUIRE(readings.size() == 3);
+	CHECK(readings[0].sensorId == 7);
+	CHECK(readings[0].reading == doctest::Approx(150.0));
+	CHECK(readings[0].baseUnit == PLDM_UNIT_WATTS);
+	CHECK(readings[1].reading == doctest::Approx(25.0));
+	CHECK(readings[2].reading == doctest::Approx(0.85));
+	CHECK(bus.received.size() == 3);
+	CHECK(engine.window() == 4);
+}
+
+TEST_CASE("SensorEngine falls back to one request at a time when the AMC drops requests")
+{
+	FakeAmcBus bus;
+	bus.values = {{1, 65}, {3, 850}, {7, 300}};
+	bus.dropWhenBusy = true;
+	SensorEngine engine(bus, 8, fastOptions);
+
+	const std::vector<uint16_t> ids{1, 3, 7};
+	std::vector<pldmSensorInfo> readings;
+	REQUIRE(engine.read(sampleTable(), ids, readings) == PLDM_SUCCESS);
+	CHECK(readings.size() == 3);
+	CHECK(engine.window() == 1);
+	// 3 pipelined requests, 2 of them dropped and asked for again
+	CHECK(bus.received.size() == 5);
+}
+
+TEST_CASE("SensorEngine reports failed and unknown sensors but returns the rest")
+{
+	FakeAmcBus bus;
+	bus.values = {{1, 65}, {3, 850}, {7, 300}};
+	bus.failures = {{3, PLDM_ERROR_INVALID_DATA}};
+	SensorEngine engine(bus, 8, fastOptions);
+
+	const std::vector<uint16_t> ids{1, 3, 42};
+	std::vector<pldmSensorInfo> readings;
+	CHECK(engine.read(sampleTable(), ids, readings) == PLDM_ERROR);
+	REQUIRE(readings.size() == 1);
+	CHECK(readings[0].sensorId == 1);
+	// No request goes out for a sensor without PDR
+	CHECK(bus.received.size() == 2);
+}
+
+TEST_CASE("SensorEngine skips stale responses without waiting for the next poll")
+{
+	FakeAmcBus bus;
+	bus.values = {{1, 65}, {3, 850}, {7, 300}};
+	for (const uint8_t instanceId : {20, 21, 22}) {
+		bus.answerStale(instanceId);
+	}
+	// A poll round per stale response would run past the response timeout
+	constexpr sensorEngineOptions slowPoll{
+		.window = 4, .firstPoll = 1ms, .pollInterval = 20ms, .responseTimeout = 30ms};
+	SensorEngine engine(bus, 8, slowPoll);
+
+	const std::vector<uint16_t> ids{1, 3, 7};
+	std::vector<pldmSensorInfo> readings;
+	REQUIRE(engine.read(sampleTable(), ids, readings) == PLDM_SUCCESS);
+	CHECK(readings.size() == 3);
+	CHECK(bus.received.size() == 3);
+	CHECK(engine.window() == 4);
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "counter_delta.h"
+#include <algorithm>
+#include <limits>
+
+namespace metrics {
+
+namespace {
+
+/** Host time by which the driver window may exceed twice the host window before it is distrusted */
+constexpr uint64_t HOST_SLACK_US = 1000;
+
+/** Headroom over @c maxRate before a difference is taken for a counter reset */
+constexpr double MAX_RATE_HEADROOM = 2.0;
+
+[[nodiscard]] constexpr uint64_t maskOf(uint32_t bits) noexcept
+{
+	return bits >= 64 ? std::numeric_limits<uint64_t>::max() : (uint64_t{1} << bits) - 1;
+}
+
+/** @brief Largest difference of a @p bits wide value that still counts as moving forward */
+[[nodiscard]] constexpr uint64_t halfRange(uint32_t bits) noexcept
+{
+	return maskOf(bits) >> 1;
+}
+
+} // namespace
+
+std::optional<uint64_t> wrappingDelta(uint64_t before, uint64_t after, uint32_t bits, uint64_t limit)
+{
+	const uint64_t delta = (after - before) & maskOf(bits); // Modulo 2^bits: correct across a wrap
+	if (delta > limit) {
+		return std::nullopt;
+	}
+	return delta;
+}
+
+CounterRate counterRate(const CounterReading &before, const CounterReading &after, const CounterTraits &traits)
+{
+	CounterRate r;
+	if (before.timestampUs == 0 || after.timestampUs == 0) {
+		return r;
+	}
+
+	const auto tsDelta = wrappingDelta(before.timestampUs, after.timestampUs, traits.timestampBits,
+									   halfRange(traits.timestampBits));
+	if (!tsDelta) {
+		r.status = DeltaStatus::TimeReset;
+		return r;
+	}
+	if (*tsDelta == 0) {
+		r.status = DeltaStatus::Stalled;
+		return r;
+	}
+
+	uint64_t windowUs = *tsDelta;
+	if (before.hostNs != 0 && after.hostNs > before.hostNs) {
+		const uint64_t hostUs = (after.hostNs - before.hostNs) / 1000;
+		if (windowUs > 2 * hostUs + HOST_SLACK_US) {
+			windowUs = std::max<uint64_t>(hostUs, 1);
+			r.hostTimed = true;
+		}
+	}
+	r.seconds = static_cast<double>(windowUs) / 1e6;
+
+	uint64_t limit = halfRange(traits.bits);
+	if (traits.maxRate > 0.0) {
+		const double plausible = traits.maxRate * r.seconds * MAX_RATE_HEADROOM + traits.valueResolution;
+		if (plausible < static_cast<double>(limit)) {
+			limit = static_cast<uint64_t>(plausible);
+		}
+	}
+	const auto delta = wrappingDelta(before.value, after.value, traits.bits, limit);
+	if (!delta) {
+		r.status = DeltaStatus::CounterReset;
+		return r;
+	}
+
+	r.status = DeltaStatus::Ok;
+	r.delta = *delta;
+	r.wrapped = (after.value & maskOf(traits.bits)) < (before.value & maskOf(traits.bits));
+	r.rate = static_cast<double>(r.delta) / r.seconds;
+
+	// Each reading may be off by one step of either resolution
+	const double resolutionS = traits.timestampResolutionUs / 1e6;
+	const auto units = static_cast<double>(r.delta);
+	r.rateLow = std::max(0.0, units - traits.valueResolution) / (r.seconds + resolutionS);
+	r.rateHigh = (units + traits.valueResolution) / std::max(r.seconds - resolutionS, resolutionS);
+	return r;
+}
+
+} // namespace metrics
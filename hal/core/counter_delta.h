@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef COUNTER_DELTA_H
+#define COUNTER_DELTA_H
+
+#include "os.h"
+#include <cstdint>
+#include <optional>
+
+namespace metrics {
+
+/**
+ * @brief One reading of a monotonic driver counter
+ *
+ * @c timestampUs is the driver's timestamp of the reading; 0 means the counter was not
+ * read. @c hostNs is MONOTONIC_RAW_NS() taken when the reading was made, 0 when unknown;
+ * it is only used to catch driver timestamps that jump.
+ */
+struct CounterReading
+{
+	uint64_t value = 0;
+	uint64_t timestampUs = 0;
+	uint64_t hostNs = 0;
+};
+
+/** @brief What is known about a counter beyond its readings */
+struct CounterTraits
+{
+	uint32_t bits = 64;				   ///< Width of the counter; it wraps at 2^bits
+	uint32_t timestampBits = 64;	   ///< Width of the driver timestamp
+	double maxRate = 0.0;			   ///< Largest plausible rate in units per second; 0 when unknown
+	double timestampResolutionUs = 1.0; ///< Granularity of the driver timestamp
+	double valueResolution = 1.0;	   ///< Granularity of the counter
+};
+
+/** @brief Outcome of comparing two readings */
+enum class DeltaStatus
+{
+	Ok,
+	Unavailable,  ///< A reading is missing
+	Stalled,	  ///< The timestamp did not advance; there is no rate to report yet
+	TimeReset,	  ///< The timestamp went backwards
+	CounterReset, ///< The counter moved further than it plausibly can: it was reset in between
+};
+
+/**
+ * @brief Rate of a counter between two readings
+ *
+ * @c rate is in counter units per second. The true average rate over the window lies in
+ * [rateLow, rateHigh] given the resolution of the counter and of the timestamps.
+ */
+struct CounterRate
+{
+	DeltaStatus status = DeltaStatus::Unavailable;
+	uint64_t delta = 0;		 ///< Units counted, across a wrap if there was one
+	double seconds = 0.0;	 ///< Length of the window
+	double rate = 0.0;
+	double rateLow = 0.0;
+	double rateHigh = 0.0;
+	bool wrapped = false;	 ///< The counter wrapped within the window
+	bool hostTimed = false; ///< The driver timestamps jumped; the window was taken from the host clock
+
+	[[nodiscard]] bool ok() const noexcept { return status == DeltaStatus::Ok; }
+
+	/** @brief @c rate scaled by @p factor, or nullopt when the readings gave no rate */
+	[[nodiscard]] std::optional<double> scaled(double factor) const
+	{
+		return ok() ? std::optional<double>{rate * factor} : std::nullopt;
+	}
+};
+
+/**
+ * @brief Units counted from @p before to @p after by a counter that wraps at 2^@p bits
+ *
+ * The difference is taken modulo 2^bits, so a counter that wrapped between the readings
+ * yields the units actually counted. A difference above @p limit cannot come from the
+ * counter advancing and means it was reset in between (device reset, driver reload).
+ *
+ * @return Units counted, or nullopt across a reset
+ */
+[[nodiscard]] LIBXPUM_API std::optional<uint64_t> wrappingDelta(uint64_t before, uint64_t after, uint32_t bits,
+																 uint64_t limit);
+
+/**
+ * @brief Rate of a counter between two readings
+ *
+ * Every metric derived from a pair of driver counters (power from energy, utilization
+ * from active time, bandwidth from byte counts) goes through here so wraps, resets and
+ * timestamp jumps are handled the same way everywhere:
+ * - a missing reading is Unavailable, a timestamp that did not advance is Stalled and
+ *   one that went backwards (by more than half its range) is TimeReset;
+ * - the counter difference is taken modulo 2^bits; without a @c maxRate a difference of
+ *   half the range or more is a CounterReset, with one anything beyond twice the
+ *   plausible amount is;
+ * - when both readings carry a host time and the driver window is more than twice the
+ *   host window, the driver timestamps jumped and the host window is used instead.
+ */
+[[nodiscard]] LIBXPUM_API CounterRate counterRate(const CounterReading &before, const CounterReading &after,
+												  const CounterTraits &traits = {});
+
+} // namespace metrics
+
+#endif // COUNTER_DELTA_H
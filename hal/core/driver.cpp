@@ -12,6 +12,43 @@
 #include <string_view>
 #include <vector>
 
+namespace {
+
+/**
+ * @brief Formats the PCI address of a sysman device as "dddd:bb:dd.f"
+ *
+ * @return An empty string when the PCI properties cannot be read
+ */
+std::string zesDeviceBdf(zes_device_handle_t zesDev)
+{
+	zes_pci_properties_t pciProps{};
+	if (zesDevicePciGetProperties(zesDev, &pciProps) != ZE_RESULT_SUCCESS) {
+		return {};
+	}
+	char bdfStr[BDF_STR_LEN];
+	snprintf(bdfStr, sizeof(bdfStr), "%04x:%02x:%02x.%01x", pciProps.address.domain, pciProps.address.bus,
+			 pciProps.address.device, pciProps.address.function);
+	return bdfStr;
+}
+
+/**
+ * @brief Enumerates the sysman devices of @p zesDrv afresh
+ */
+ze_result_t getZesDevices(zes_driver_handle_t zesDrv, std::vector<zes_device_handle_t> &zesDevices)
+{
+	uint32_t count = 0;
+	ze_result_t result = zesDeviceGet(zesDrv, &count, nullptr);
+	if (result != ZE_RESULT_SUCCESS) {
+		return result;
+	}
+	zesDevices.resize(count);
+	result = zesDeviceGet(zesDrv, &count, zesDevices.data());
+	zesDevices.resize(count);
+	return result;
+}
+
+} // namespace
+
 /**
  * @brief Sets the print/debug level for the driver and synchronizes across modules
  *
@@ -264,12 +301,7 @@ ze_result_t driver::init()
 		svZesDevs.survDevCount = survDevCount;
 		uint32_t devIndex = 0;
 		for (uint32_t k = 0; k < totalZesDevicesCount; k++) {
-			zes_pci_properties_t pciProps{};
-			result = zesDevicePciGetProperties(totalZesDevices[k], &pciProps);
-			char bdfStr[BDF_STR_LEN];
-			snprintf(bdfStr, sizeof(bdfStr), "%04x:%02x:%02x.%01x", pciProps.address.domain, pciProps.address.bus,
-					 pciProps.address.device, pciProps.address.function);
-			if (!devBdfs.contains(bdfStr) && (devIndex < survDevCount)) {
+			if (!devBdfs.contains(zesDeviceBdf(totalZesDevices[k])) && (devIndex < survDevCount)) {
 				svZesDevs.survDevices[devIndex].smDevInit(zesDrivers[0], totalZesDevices[k]);
 				svZesDevs.survDevices[devIndex].setSurvivabilityMode(true);
 				devIndex++;
@@ -549,3 +581,116 @@ ze_result_t driver::findDevice(const char *bdf, std::vector<devInfo> *devList)
 
 	return ZE_RESULT_SUCCESS;
 }
+
+/**
+ * @brief Lists the BDFs of the devices the sysman driver enumerates now.
+ *
+ * Unlike findDevice(), which reports the devices captured by init(), this asks the
+ * driver again, so devices that appeared or disappeared since init() are reflected.
+ *
+ * @param bdfs Receives one "dddd:bb:dd.f" string per device, in driver order.
+ * @return ze_result_t indicating success or failure.
+ */
+ze_result_t driver::listDeviceBdfs(std::vector<std::string> *bdfs)
+{
+	TRACING();
+	if (zesDrivers == nullptr) {
+		return ZE_RESULT_ERROR_UNINITIALIZED;
+	}
+	std::vector<zes_device_handle_t> zesDevices;
+	ze_result_t const result = getZesDevices(zesDrivers[0], zesDevices);
+	if (result != ZE_RESULT_SUCCESS) {
+		DBG("Failed to re-enumerate zes devices: 0x{:X} ({})\n", result, l0_error_to_string(result));
+		return result;
+	}
+	bdfs->clear();
+	for (auto *zesDev : zesDevices) {
+		if (auto bdf = zesDeviceBdf(zesDev); !bdf.empty()) {
+			bdfs->push_back(std::move(bdf));
+		}
+	}
+	return ZE_RESULT_SUCCESS;
+}
+
+/**
+ * @brief Re-enumerates a single device by BDF and initializes a fresh device object for it.
+ *
+ * Used after a device was reset, rebound or hot-plugged: the handles captured by init()
+ * are stale, but the other devices must not be disturbed. The device is matched to its
+ * core device by UUID as in init(); a device the core driver does not report is set up
+ * through sysman only and flagged as in survivability mode, as init() does.
+ *
+ * @param bdf BDF of the device, "dddd:bb:dd.f".
+ * @param dev Receives the new device object; owned by the caller.
+ * @return ZE_RESULT_NOT_READY if the driver does not (yet) report the device,
+ *         otherwise ze_result_t indicating success or failure.
+ */
+ze_result_t driver::probeDevice(const char *bdf, std::unique_ptr<device> *dev)
+{
+	TRACING();
+	if (zesDrivers == nullptr) {
+		return ZE_RESULT_ERROR_UNINITIALIZED;
+	}
+	std::vector<zes_device_handle_t> zesDevices;
+	ze_result_t result = getZesDevices(zesDrivers[0], zesDevices);
+	if (result != ZE_RESULT_SUCCESS) {
+		DBG("Failed to re-enumerate zes devices: 0x{:X} ({})\n", result, l0_error_to_string(result));
+		return result;
+	}
+
+	zes_device_handle_t zesDev = nullptr;
+	for (auto *candidate : zesDevices) {
+		if (zesDeviceBdf(candidate) == bdf) {
+			zesDev = candidate;
+			break;
+		}
+	}
+	if (zesDev == nullptr) {
+		DBG("Device {} is not enumerated\n", bdf);
+		return ZE_RESULT_NOT_READY;
+	}
+
+	zes_device_properties_t zesProps{};
+	zesProps.stype = ZES_STRUCTURE_TYPE_DEVICE_PROPERTIES;
+	result = zesDeviceGetProperties(zesDev, &zesProps);
+	if (result != ZE_RESULT_SUCCESS) {
+		return result;
+	}
+
+	auto probed = std::make_unique<device>();
+	for (uint32_t i = 0; i < driverCount; i++) {
+		uint32_t zeCount = 0;
+		if (zeDeviceGet(zeDrivers[i], &zeCount, nullptr) != ZE_RESULT_SUCCESS) {
+			continue;
+		}
+		std::vector<ze_device_handle_t> zeDevices(zeCount);
+		if (zeDeviceGet(zeDrivers[i], &zeCount, zeDevices.data()) != ZE_RESULT_SUCCESS) {
+			continue;
+		}
+		for (auto *zeDev : zeDevices) {
+			ze_device_properties_t zeProps{};
+			zeProps.stype = ZE_STRUCTURE_TYPE_DEVICE_PROPERTIES;
+			if (zeDeviceGetProperties(zeDev, &zeProps) != ZE_RESULT_SUCCESS ||
+				memcmp(zeProps.uuid.id, zesProps.core.uuid.id, ZE_MAX_DEVICE_UUID_SIZE) != 0) {
+				continue;
+			}
+			result = probed->init(zeDrivers[i], zesDrivers[0], zeDev, zesDevices.data(),
+								  static_cast<uint32_t>(zesDevices.size()));
+			if (result != ZE_RESULT_SUCCESS) {
+				ERR("Failed to initialize device {}: 0x{:X} ({})\n", bdf, result, l0_error_to_string(result));
+				return result;
+			}
+			*dev = std::move(probed);
+			return ZE_RESULT_SUCCESS;
+		}
+	}
+
+	result = probed->smDevInit(zesDrivers[0], zesDev);
+	if (result != ZE_RESULT_SUCCESS) {
+		ERR("Failed to initialize device {}: 0x{:X} ({})\n", bdf, result, l0_error_to_string(result));
+		return result;
+	}
+	probed->setSurvivabilityMode(true);
+	*dev = std::move(probed);
+	return ZE_RESULT_SUCCESS;
+}
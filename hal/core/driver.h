@@ -7,6 +7,8 @@
 #ifndef _DRIVER_H
 #define _DRIVER_H
 
+#include <memory>
+#include <string>
 #include <vector>
 #include "device.h"
 
@@ -54,6 +56,8 @@ public:
 	ze_result_t getExtensionProperties(ze_driver_handle_t drvr);
 	void getLoaderVersion(std::string *lzVersion);
 	ze_result_t findDevice(const char *bdf, std::vector<devInfo> *dev);
+	ze_result_t listDeviceBdfs(std::vector<std::string> *bdfs);
+	ze_result_t probeDevice(const char *bdf, std::unique_ptr<device> *dev);
 	ze_result_t getLogs(std::string fileName);
 	ze_result_t run();
 };
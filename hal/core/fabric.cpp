@@ -39,6 +39,7 @@ ze_result_t fabric::enumFabricPorts(zes_device_handle_t device)
 		return result;
 	}
 	DBG("Device has {} fabric ports\n", portCount);
+	portProperties.assign(portCount, std::nullopt);
 
 	if (portCount == 0)
 		return ZE_RESULT_SUCCESS;
@@ -127,17 +128,15 @@ ze_result_t fabric::getFabricPorts(zes_device_handle_t device, std::vector<portI
 		return ZE_RESULT_ERROR_UNSUPPORTED_FEATURE;
 	}
 
-	// Use the cached port handles
+	// Use the cached port handles and properties
+	loadPortProperties();
 	for (uint32_t i = 0; i < portCount; i++) {
 		portInfo info = {};
 
-		// Get properties
-		info.portProps.stype = ZES_STRUCTURE_TYPE_FABRIC_PORT_PROPERTIES;
-		res = zesFabricPortGetProperties(ports[i], &info.portProps);
-		if (res != ZE_RESULT_SUCCESS) {
-			ERR("Failed to get fabric port properties: 0x{:X} ({})\n", res, l0_error_to_string(res));
+		if (!portProperties[i]) {
 			continue;
 		}
+		info.portProps = *portProperties[i];
 
 		// Get state
 		info.portState.stype = ZES_STRUCTURE_TYPE_FABRIC_PORT_STATE;
@@ -168,6 +167,97 @@ ze_result_t fabric::getFabricPorts(zes_device_handle_t device, std::vector<portI
 	return ZE_RESULT_SUCCESS;
 }
 
+/**
+ * @brief Reads the properties of every port that has none cached yet
+ *
+ * Port properties are fixed for the lifetime of the port handles, so a port is only
+ * read again when its previous read failed.
+ */
+void fabric::loadPortProperties()
+{
+	for (uint32_t i = 0; i < portCount && i < portProperties.size(); i++) {
+		if (portProperties[i]) {
+			continue;
+		}
+		zes_fabric_port_properties_t props = {};
+		props.stype = ZES_STRUCTURE_TYPE_FABRIC_PORT_PROPERTIES;
+		const ze_result_t res = zesFabricPortGetProperties(ports[i], &props);
+		if (res != ZE_RESULT_SUCCESS) {
+			ERR("Failed to get fabric port properties: 0x{:X} ({})\n", res, l0_error_to_string(res));
+			continue;
+		}
+		portProperties[i] = props;
+	}
+}
+
+/**
+ * @brief Gets the cached properties of a fabric port
+ *
+ * @param index Zero-based index of the fabric port
+ * @return Properties of the port, or nullopt if the index is invalid or the port's
+ *         properties could not be read
+ */
+const std::optional<zes_fabric_port_properties_t> &fabric::getPortProperties(uint32_t index)
+{
+	static const std::optional<zes_fabric_port_properties_t> none;
+	if (index >= portProperties.size()) {
+		return none;
+	}
+	if (!portProperties[index]) {
+		loadPortProperties();
+	}
+	return portProperties[index];
+}
+
+/**
+ * @brief Reads the throughput counters of all fabric ports of a device
+ *
+ * All ports are read with a single zesFabricPortGetMultiPortThroughput() call, so the
+ * counters of one device share a sampling instant. Drivers without the batched call
+ * are read port by port instead; that is remembered, so the batched call is only
+ * attempted once on them.
+ *
+ * @param [in] device Handle to the Level Zero Sysman device
+ * @param [out] throughputs One entry per port, in getPortHandle() order
+ * @retval ZE_RESULT_SUCCESS Counters of all ports read
+ * @retval ZE_RESULT_ERROR_UNSUPPORTED_FEATURE Device has no fabric ports
+ * @retval ZE_RESULT_ERROR_INVALID_NULL_HANDLE Device handle is nullptr
+ * @retval Other error codes from zesFabricPortGetMultiPortThroughput or zesFabricPortGetThroughput
+ */
+ze_result_t fabric::getPortThroughputs(zes_device_handle_t device, std::vector<zes_fabric_port_throughput_t> &throughputs)
+{
+	if (device == nullptr) {
+		ERR("Device handle is null\n");
+		return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+	}
+	if (portCount == 0 || ports == nullptr) {
+		return ZE_RESULT_ERROR_UNSUPPORTED_FEATURE;
+	}
+
+	throughputs.assign(portCount, zes_fabric_port_throughput_t{});
+	if (multiPortThroughput) {
+		zes_fabric_port_throughput_t *out = throughputs.data();
+		const ze_result_t res = zesFabricPortGetMultiPortThroughput(device, portCount, ports, &out);
+		if (res != ZE_RESULT_ERROR_UNSUPPORTED_FEATURE) {
+			if (res != ZE_RESULT_SUCCESS) {
+				DBG("Failed to get multi-port throughput: 0x{:X} ({})\n", res, l0_error_to_string(res));
+			}
+			return res;
+		}
+		DBG("Multi-port throughput unsupported, reading fabric ports one by one\n");
+		multiPortThroughput = false;
+	}
+
+	for (uint32_t i = 0; i < portCount; i++) {
+		const ze_result_t res = zesFabricPortGetThroughput(ports[i], &throughputs[i]);
+		if (res != ZE_RESULT_SUCCESS) {
+			DBG("Failed to get fabric port {} throughput: 0x{:X} ({})\n", i, res, l0_error_to_string(res));
+			return res;
+		}
+	}
+	return ZE_RESULT_SUCCESS;
+}
+
 /**
  * @brief Sets configuration for a specific fabric port
  *
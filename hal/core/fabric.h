@@ -8,6 +8,7 @@
 #define _FABRIC_H
 
 #include "sysman.h"
+#include <optional>
 #include <vector>
 
 // Add fabric port info structures
@@ -33,6 +34,11 @@ class LIBXPUM_API fabric : public sysman
 private:
 	zes_fabric_port_handle_t *ports;
 	uint32_t portCount;
+	/** Per port; port properties never change, so each is read once. nullopt until a read succeeded */
+	std::vector<std::optional<zes_fabric_port_properties_t>> portProperties;
+	bool multiPortThroughput = true; ///< Cleared once the driver reports the batched read as unsupported
+
+	void loadPortProperties();
 
 public:
 	fabric() : ports(nullptr), portCount(0) {}
@@ -48,6 +54,8 @@ public:
 										   zes_fabric_port_throughput_t *throughputs);
 	ze_result_t getFabricPorts(zes_device_handle_t device, std::vector<portInfo> &portInfoIn);
 	ze_result_t setFabricPorts(zes_device_handle_t device, const portInfoSet &portInfoSetIn);
+	const std::optional<zes_fabric_port_properties_t> &getPortProperties(uint32_t index);
+	ze_result_t getPortThroughputs(zes_device_handle_t device, std::vector<zes_fabric_port_throughput_t> &throughputs);
 	zes_fabric_port_handle_t getPortHandle(uint32_t index) const;
 	uint32_t getPortCount() const { return portCount; }
 
@@ -115,6 +115,13 @@ public:
 		}
 	}
 
+	/// Replace only the sink of PRINT(), e.g. to capture the output of one
+	/// command; diagnostics keep their sink.  nullptr resets it to stdout.
+	void setPrintSink(std::shared_ptr<Sink> s) noexcept
+	{
+		printSink.store(s ? std::move(s) : std::make_shared<OStreamSink>(std::cout));
+	}
+
 	std::shared_ptr<Sink> getSink() noexcept { return sink.load(std::memory_order_acquire); }
 
 	std::shared_ptr<Sink> getPrintSink() noexcept { return printSink.load(std::memory_order_acquire); }
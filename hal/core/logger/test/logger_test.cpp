@@ -219,6 +219,27 @@ TEST_CASE("Logger: getSink round-trips the same object")
 	CHECK(Logger::instance().getSink() == cap);
 }
 
+TEST_CASE("Logger: setPrintSink redirects PRINT but not diagnostics")
+{
+	LoggerGuard const guard;
+	auto diag = std::make_shared<CaptureSink>();
+	auto out = std::make_shared<CaptureSink>();
+	Logger::instance().setSink(diag);
+	Logger::instance().setPrintSink(out);
+	setDbgLvl(LogLevel::ERR);
+
+	PRINT("result\n");
+	ERR("failure\n");
+
+	CHECK(out->str() == "result\n");
+	CHECK(diag->str().find("failure") != std::string::npos);
+	CHECK(diag->str().find("result") == std::string::npos);
+
+	Logger::instance().setPrintSink(nullptr);
+	CHECK(Logger::instance().getPrintSink() != nullptr);
+	CHECK(Logger::instance().getSink() == diag);
+}
+
 // ── Level gating ──────────────────────────────────────────────────────────────
 
 TEST_CASE("Logger: PRINT always emits regardless of dbgLvl")
@@ -6,7 +6,7 @@
 
 #include "pci.h"
 #include <assert.h>
-#include <gscupd.h>
+#include <mei_registry.h>
 #include <string>
 #include <vector>
 
@@ -374,22 +374,11 @@ ze_result_t pci::init(zes_device_handle_t device)
 			 deviceProperties.pciProps.address.bus, deviceProperties.pciProps.address.device,
 			 deviceProperties.pciProps.address.function);
 
-	gscupd gsc;
-	std::vector<pci_addr_mei_device> devicesVec = gsc.getPCIAddrAndMeiDevices();
-
-	for (const auto &dv : devicesVec) {
-		if (dv.pciProps.address.domain == deviceProperties.pciProps.address.domain &&
-			dv.pciProps.address.bus == deviceProperties.pciProps.address.bus &&
-			dv.pciProps.address.device == deviceProperties.pciProps.address.device &&
-			dv.pciProps.address.function == deviceProperties.pciProps.address.function) {
-			DBG("Found matching device: {}\n", dv.meiDevicePath.c_str());
-
-			// Found a matching device so copy the meiDevicePath
-			deviceProperties.meiDevicePath = dv.meiDevicePath;
-			// Also copy the fw status
-			deviceProperties.fwStatus = dv.fwStatus;
-			break;
-		}
+	// The registry enumerates the MEI devices once for all GPUs
+	if (auto mei = MeiRegistry::instance().find(bdfStr)) {
+		DBG("Found matching device: {}\n", mei->meiDevicePath.c_str());
+		deviceProperties.meiDevicePath = mei->meiDevicePath;
+		deviceProperties.fwStatus = mei->fwStatus;
 	}
 
 	return result;
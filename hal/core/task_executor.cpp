@@ -0,0 +1,279 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "task_executor.h"
+#include <algorithm>
+
+namespace {
+
+// Lower bound of the shared pool; see TaskExecutor::shared()
+constexpr size_t MIN_SHARED_WORKERS = 8;
+
+// Executor and queue of the calling worker thread
+thread_local const TaskExecutor *currentExecutor = nullptr;
+thread_local size_t currentQueue = 0;
+
+const char *reasonText(TaskAborted::Reason reason)
+{
+	switch (reason) {
+	case TaskAborted::Reason::CANCELLED:
+		return "Task was cancelled before it started";
+	case TaskAborted::Reason::DEADLINE:
+		return "Task deadline passed before it started";
+	case TaskAborted::Reason::SHUTDOWN:
+		return "Task executor shut down before the task started";
+	}
+	return "Task was aborted";
+}
+
+} // namespace
+
+TaskAborted::TaskAborted(Reason reasonIn) : std::runtime_error(reasonText(reasonIn)), why(reasonIn) {}
+
+ze_result_t TaskAborted::result() const
+{
+	return why == Reason::DEADLINE ? ZE_RESULT_NOT_READY : ZE_RESULT_ERROR_NOT_AVAILABLE;
+}
+
+void TaskExecutor::Task::cancel(TaskAborted::Reason reason)
+{
+	stop.request_stop();
+	if (!claimed.exchange(true)) {
+		abort(reason);
+	}
+}
+
+TaskExecutor::TaskExecutor(size_t workerCount, size_t maxQueuedTasks) : maxQueued(maxQueuedTasks)
+{
+	workerCount = std::max<size_t>(workerCount, 1);
+	queues.reserve(workerCount);
+	for (size_t i = 0; i < workerCount; ++i) {
+		queues.push_back(std::make_unique<WorkerQueue>());
+	}
+	timer = std::jthread([this](const std::stop_token &stop) { timerLoop(stop); });
+	workers.reserve(workerCount);
+	for (size_t i = 0; i < workerCount; ++i) {
+		workers.emplace_back([this, i] { workerLoop(i); });
+	}
+}
+
+TaskExecutor::~TaskExecutor()
+{
+	{
+		const std::lock_guard lock(idleMutex);
+		stopping = true;
+	}
+	for (auto *queue : allQueues()) {
+		const std::lock_guard lock(queue->mutex);
+		for (auto &queued : queue->tasks) {
+			queued.task->cancel(TaskAborted::Reason::SHUTDOWN);
+		}
+		if (queue->running) {
+			queue->running->stop.request_stop();
+		}
+	}
+	workAvailable.notify_all();
+	spaceAvailable.notify_all();
+	for (auto &worker : workers) {
+		worker.join();
+	}
+	// Submitted after the workers saw the executor stopping
+	for (auto *queue : allQueues()) {
+		for (auto &queued : queue->tasks) {
+			queued.task->cancel(TaskAborted::Reason::SHUTDOWN);
+		}
+	}
+}
+
+TaskExecutor &TaskExecutor::shared()
+{
+	static TaskExecutor executor(std::max<size_t>(std::thread::hardware_concurrency(), MIN_SHARED_WORKERS));
+	return executor;
+}
+
+std::vector<TaskExecutor::WorkerQueue *> TaskExecutor::allQueues()
+{
+	std::vector<WorkerQueue *> all{&inbox};
+	for (auto &queue : queues) {
+		all.push_back(queue.get());
+	}
+	return all;
+}
+
+bool TaskExecutor::isWorkerThread() const { return currentExecutor == this; }
+
+void TaskExecutor::enqueue(std::shared_ptr<Task> task, const TaskOptions &options)
+{
+	QueuedTask queued{task, nullptr};
+	if (options.stop.stop_possible()) {
+		queued.link = std::make_shared<std::stop_callback<CancelTask>>(options.stop, CancelTask{task.get()});
+		if (task->claimed) {
+			return; // Cancelled already
+		}
+	}
+	if (stopping) {
+		task->cancel(TaskAborted::Reason::SHUTDOWN);
+		return;
+	}
+	if (options.deadline) {
+		{
+			const std::lock_guard lock(deadlineMutex);
+			deadlines.emplace(*options.deadline, task);
+		}
+		deadlineChanged.notify_one();
+	}
+
+	if (maxQueued > 0 && queuedCount >= maxQueued) {
+		if (isWorkerThread()) {
+			// Waiting for room could deadlock when the peers wait on us; run it here instead
+			execute(std::move(queued));
+			return;
+		}
+		std::unique_lock lock(idleMutex);
+		spaceAvailable.wait(lock, [this] { return stopping || queuedCount < maxQueued; });
+	}
+	push(std::move(queued));
+}
+
+void TaskExecutor::push(QueuedTask queued)
+{
+	WorkerQueue &queue = isWorkerThread() ? *queues[currentQueue] : inbox;
+	{
+		const std::lock_guard lock(queue.mutex);
+		queue.tasks.push_back(std::move(queued));
+		++queuedCount;
+	}
+	// Pairs with the predicate check of an idle worker so that its wakeup is not lost
+	{
+		const std::lock_guard lock(idleMutex);
+	}
+	workAvailable.notify_one();
+}
+
+std::optional<TaskExecutor::QueuedTask> TaskExecutor::take(std::optional<size_t> own)
+{
+	const auto pop = [this](WorkerQueue &queue, bool newest) -> std::optional<QueuedTask> {
+		const std::lock_guard lock(queue.mutex);
+		if (queue.tasks.empty()) {
+			return std::nullopt;
+		}
+		QueuedTask queued;
+		if (newest) {
+			queued = std::move(queue.tasks.back());
+			queue.tasks.pop_back();
+		} else {
+			queued = std::move(queue.tasks.front());
+			queue.tasks.pop_front();
+		}
+		--queuedCount;
+		return queued;
+	};
+
+	// Own work first, then outside submissions, then steal from the peers
+	std::optional<QueuedTask> queued = own ? pop(*queues[*own], true) : std::nullopt;
+	if (!queued) {
+		queued = pop(inbox, false);
+	}
+	const size_t first = own.value_or(0);
+	for (size_t i = 1; i <= queues.size() && !queued; ++i) {
+		queued = pop(*queues[(first + i) % queues.size()], false);
+	}
+	if (queued && maxQueued > 0) {
+		// Same pairing as in push(), for a submitter waiting for room
+		{
+			const std::lock_guard lock(idleMutex);
+		}
+		spaceAvailable.notify_one();
+	}
+	return queued;
+}
+
+void TaskExecutor::execute(QueuedTask queued)
+{
+	Task &task = *queued.task;
+	if (task.claimed.exchange(true)) {
+		return; // Aborted while queued
+	}
+	WorkerQueue *own = isWorkerThread() ? queues[currentQueue].get() : nullptr;
+	if (own != nullptr) {
+		const std::lock_guard lock(own->mutex);
+		own->running = queued.task;
+		if (stopping) {
+			task.stop.request_stop();
+		}
+	}
+	{
+		// Drops a pin the task set; a pinned thread that ran the task inline gets its own pin back
+		const ThreadPinGuard restorePin{};
+		task.run(task.stop.get_token());
+	}
+	if (own != nullptr) {
+		const std::lock_guard lock(own->mutex);
+		own->running.reset();
+	}
+}
+
+bool TaskExecutor::runPendingTask()
+{
+	auto queued = take(isWorkerThread() ? std::optional<size_t>(currentQueue) : std::nullopt);
+	if (!queued) {
+		return false;
+	}
+	execute(std::move(*queued));
+	return true;
+}
+
+void TaskExecutor::workerLoop(size_t index)
+{
+	currentExecutor = this;
+	currentQueue = index;
+	while (true) {
+		if (auto queued = take(index)) {
+			execute(std::move(*queued));
+			continue;
+		}
+		std::unique_lock lock(idleMutex);
+		workAvailable.wait(lock, [this] { return stopping || queuedCount > 0; });
+		if (stopping && queuedCount == 0) {
+			return;
+		}
+	}
+}
+
+void TaskExecutor::timerLoop(const std::stop_token &stop)
+{
+	std::unique_lock lock(deadlineMutex);
+	while (!stop.stop_requested()) {
+		if (deadlines.empty()) {
+			deadlineChanged.wait(lock, stop, [this] { return !deadlines.empty(); });
+			continue;
+		}
+		const auto next = deadlines.begin()->first;
+		if (next > std::chrono::steady_clock::now()) {
+			deadlineChanged.wait_until(lock, stop, next,
+									   [this, next] { return deadlines.empty() || deadlines.begin()->first < next; });
+			continue;
+		}
+		auto task = deadlines.begin()->second.lock();
+		deadlines.erase(deadlines.begin());
+		if (task) {
+			lock.unlock();
+			task->cancel(TaskAborted::Reason::DEADLINE);
+			lock.lock();
+		}
+	}
+}
+
+ze_result_t DeviceResults::first() const
+{
+	const auto it = std::ranges::find_if(results, [](ze_result_t r) { return r != ZE_RESULT_SUCCESS; });
+	return it == results.end() ? ZE_RESULT_SUCCESS : *it;
+}
+
+size_t DeviceResults::failures() const
+{
+	return static_cast<size_t>(std::ranges::count_if(results, [](ze_result_t r) { return r != ZE_RESULT_SUCCESS; }));
+}
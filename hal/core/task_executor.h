@@ -0,0 +1,328 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef TASK_EXECUTOR_H
+#define TASK_EXECUTOR_H
+
+#include "os.h"
+#include "ze_api.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <stdexcept>
+#include <stop_token>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Per-task cancellation and deadline
+ */
+struct TaskOptions
+{
+	/** Cancels the task when stop is requested: it is dropped if queued, told to stop if running */
+	std::stop_token stop{};
+	/** Same as a stop request once reached; a task still queued then does not run at all */
+	std::optional<std::chrono::steady_clock::time_point> deadline{};
+
+	/** @brief Options whose deadline is @p timeout from now */
+	static TaskOptions within(std::chrono::milliseconds timeout, std::stop_token stop = {})
+	{
+		return TaskOptions{std::move(stop), std::chrono::steady_clock::now() + timeout};
+	}
+};
+
+/**
+ * @brief Stored in the future of a task that never ran
+ */
+class TaskAborted : public std::runtime_error
+{
+public:
+	enum class Reason : uint8_t
+	{
+		CANCELLED, ///< TaskOptions::stop was requested
+		DEADLINE,  ///< TaskOptions::deadline passed
+		SHUTDOWN,  ///< The executor was destroyed
+	};
+
+	explicit TaskAborted(Reason why);
+	[[nodiscard]] Reason reason() const { return why; }
+
+	/** @brief ZE_RESULT_NOT_READY for a missed deadline, ZE_RESULT_ERROR_NOT_AVAILABLE otherwise */
+	[[nodiscard]] ze_result_t result() const;
+
+private:
+	Reason why;
+};
+
+/**
+ * @brief Work-stealing thread pool for fanning device operations out
+ *
+ * Every worker owns a queue. Tasks submitted from a worker go to its own queue and are
+ * taken back newest first, so nested fan-outs stay on warm threads; idle workers steal
+ * the oldest task of another queue. Tasks submitted from other threads go to a shared
+ * queue that the workers serve in submission order.
+ *
+ * A task is a callable taking either nothing or a std::stop_token. The token is stopped
+ * when the task's TaskOptions::stop is requested, its deadline passes or the executor is
+ * destroyed; long operations should poll it. A task that has not started by then does
+ * not run and its future throws TaskAborted. Exceptions escaping a task are stored in
+ * its future.
+ *
+ * With maxQueued set, submit() applies backpressure: an outside thread blocks until the
+ * queues have room, a worker runs the task itself instead of waiting on its peers.
+ *
+ * A thread's pin is restored after each task it executes (see ThreadPinGuard), so a task
+ * may pin its thread to the device it works on without affecting the next task, or the
+ * pin of a thread that ran it inline while waiting.
+ */
+class LIBXPUM_API TaskExecutor
+{
+public:
+	/**
+	 * @param workers   Number of worker threads, at least one
+	 * @param maxQueued Queued (not yet running) tasks before submit() pushes back; 0 for no limit
+	 */
+	explicit TaskExecutor(size_t workers, size_t maxQueued = 0);
+	~TaskExecutor();
+
+	TaskExecutor(const TaskExecutor &) = delete;
+	TaskExecutor &operator=(const TaskExecutor &) = delete;
+
+	/**
+	 * @brief Process-wide executor for device fan-out
+	 *
+	 * Device operations mostly wait on firmware, sysfs or the driver, so it has at least
+	 * one worker per GPU of a large system even on hosts with few cores.
+	 */
+	static TaskExecutor &shared();
+
+	/**
+	 * @brief Queues @p fn; its result, or exception, is delivered through the returned future
+	 */
+	template <typename Fn> auto submit(Fn fn, TaskOptions options = {});
+
+	/**
+	 * @brief Runs one queued task on the calling thread
+	 *
+	 * Lets a thread waiting for tasks help instead of blocking a worker.
+	 *
+	 * @return false when no task was queued
+	 */
+	bool runPendingTask();
+
+	/**
+	 * @brief Waits for @p future, running queued tasks meanwhile
+	 *
+	 * Safe on a worker of this executor: waiting there never starves the pool.
+	 */
+	template <typename T> void wait(const std::future<T> &future);
+
+	[[nodiscard]] size_t workerCount() const { return workers.size(); }
+
+	/** @brief True on a worker thread of this executor */
+	[[nodiscard]] bool isWorkerThread() const;
+
+private:
+	struct Task
+	{
+		std::function<void(const std::stop_token &)> run;
+		std::function<void(TaskAborted::Reason)> abort;
+		std::stop_source stop;
+		std::atomic<bool> claimed{false}; ///< Set by whoever runs or aborts the task
+
+		/** @brief Stops the task; aborts it when it has not started yet */
+		void cancel(TaskAborted::Reason reason);
+	};
+
+	struct CancelTask
+	{
+		Task *task;
+		void operator()() const { task->cancel(TaskAborted::Reason::CANCELLED); }
+	};
+
+	struct QueuedTask
+	{
+		std::shared_ptr<Task> task;
+		std::shared_ptr<std::stop_callback<CancelTask>> link; ///< Forwards TaskOptions::stop while queued
+	};
+
+	struct WorkerQueue
+	{
+		std::mutex mutex;
+		std::deque<QueuedTask> tasks;
+		std::shared_ptr<Task> running; ///< Task of the owning worker, stopped on shutdown
+	};
+
+	void enqueue(std::shared_ptr<Task> task, const TaskOptions &options);
+	std::optional<QueuedTask> take(std::optional<size_t> own);
+	void push(QueuedTask queued);
+	std::vector<WorkerQueue *> allQueues();
+	void execute(QueuedTask queued);
+	void workerLoop(size_t index);
+	void timerLoop(const std::stop_token &stop);
+
+	size_t maxQueued;
+	std::vector<std::unique_ptr<WorkerQueue>> queues;
+	WorkerQueue inbox; ///< Tasks submitted from outside the pool
+	std::atomic<size_t> queuedCount{0};
+	std::atomic<bool> stopping{false};
+
+	std::mutex idleMutex;
+	std::condition_variable workAvailable;
+	std::condition_variable spaceAvailable;
+
+	std::mutex deadlineMutex;
+	std::condition_variable_any deadlineChanged;
+	std::multimap<std::chrono::steady_clock::time_point, std::weak_ptr<Task>> deadlines;
+
+	std::vector<std::thread> workers;
+	std::jthread timer;
+};
+
+/**
+ * @brief Outcome of parallelForEach(), one result per item in input order
+ */
+struct DeviceResults
+{
+	std::vector<ze_result_t> results;
+
+	/** @brief First failure in input order, ZE_RESULT_SUCCESS if there is none */
+	[[nodiscard]] ze_result_t first() const;
+	[[nodiscard]] size_t failures() const;
+	[[nodiscard]] bool ok() const { return failures() == 0; }
+};
+
+/**
+ * @brief Runs @p fn for every item of @p items concurrently and waits for all of them
+ *
+ * @p fn takes an item, and optionally the task's std::stop_token, and returns a
+ * ze_result_t. Items that did not run because of @p options report TaskAborted::result();
+ * an exception escaping @p fn reports ZE_RESULT_ERROR_UNKNOWN.
+ */
+template <std::ranges::random_access_range Range, typename Fn>
+DeviceResults parallelForEach(Range &&items, Fn fn, const TaskOptions &options = {},
+							  TaskExecutor &executor = TaskExecutor::shared());
+
+// ---- Implementation ---------------------------------------------------------
+
+namespace task_detail {
+
+template <typename Fn> decltype(auto) invoke(Fn &fn, const std::stop_token &stop)
+{
+	if constexpr (std::is_invocable_v<Fn &, const std::stop_token &>) {
+		return fn(stop);
+	} else {
+		return fn();
+	}
+}
+
+template <typename Fn> struct ResultOf
+{
+	using type = std::invoke_result_t<Fn &>;
+};
+
+template <typename Fn>
+	requires std::is_invocable_v<Fn &, const std::stop_token &>
+struct ResultOf<Fn>
+{
+	using type = std::invoke_result_t<Fn &, const std::stop_token &>;
+};
+
+template <typename Fn> using Result = typename ResultOf<Fn>::type;
+
+} // namespace task_detail
+
+template <typename Fn> auto TaskExecutor::submit(Fn fn, TaskOptions options)
+{
+	using Result = task_detail::Result<Fn>;
+	auto promise = std::make_shared<std::promise<Result>>();
+	auto future = promise->get_future();
+
+	auto task = std::make_shared<Task>();
+	// Held by pointer so that move-only callables fit into std::function
+	task->run = [fnPtr = std::make_shared<Fn>(std::move(fn)), promise](const std::stop_token &stop) {
+		try {
+			if constexpr (std::is_void_v<Result>) {
+				task_detail::invoke(*fnPtr, stop);
+				promise->set_value();
+			} else {
+				promise->set_value(task_detail::invoke(*fnPtr, stop));
+			}
+		} catch (...) {
+			promise->set_exception(std::current_exception());
+		}
+	};
+	task->abort = [promise](TaskAborted::Reason reason) {
+		promise->set_exception(std::make_exception_ptr(TaskAborted(reason)));
+	};
+	enqueue(std::move(task), options);
+	return future;
+}
+
+template <typename T> void TaskExecutor::wait(const std::future<T> &future)
+{
+	constexpr auto POLL = std::chrono::milliseconds(1);
+	while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+		if (runPendingTask()) {
+			continue;
+		}
+		if (!isWorkerThread()) {
+			future.wait(); // The workers keep making progress; nothing left to help with
+			return;
+		}
+		// A worker keeps helping: the task it waits for may itself wait on queued work
+		future.wait_for(POLL);
+	}
+}
+
+template <std::ranges::random_access_range Range, typename Fn>
+DeviceResults parallelForEach(Range &&items, Fn fn, const TaskOptions &options, TaskExecutor &executor)
+{
+	const auto count = static_cast<size_t>(std::ranges::size(items));
+	std::vector<std::future<ze_result_t>> futures;
+	futures.reserve(count);
+	for (size_t i = 0; i < count; ++i) {
+		futures.push_back(executor.submit(
+			[&fn, &items, i](const std::stop_token &stop) -> ze_result_t {
+				auto &&item = std::ranges::begin(items)[static_cast<std::ranges::range_difference_t<Range>>(i)];
+				if constexpr (std::is_invocable_v<Fn &, decltype(item), const std::stop_token &>) {
+					return fn(item, stop);
+				} else {
+					return fn(item);
+				}
+			},
+			options));
+	}
+
+	DeviceResults outcome;
+	outcome.results.reserve(count);
+	for (auto &future : futures) {
+		executor.wait(future);
+		try {
+			outcome.results.push_back(future.get());
+		} catch (const TaskAborted &e) {
+			outcome.results.push_back(e.result());
+		} catch (...) {
+			outcome.results.push_back(ZE_RESULT_ERROR_UNKNOWN);
+		}
+	}
+	return outcome;
+}
+
+#endif // TASK_EXECUTOR_H
@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ * Unit tests for counter_delta.cpp: wrap, reset and timestamp handling of counter rates,
+ * checked over synthetic counter sequences
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#ifdef INFO
+#undef INFO
+#endif
+
+#include "counter_delta.h"
+#include <cmath>
+#include <cstdint>
+#include <random>
+
+using namespace metrics; // NOLINT(google-build-using-namespace)
+
+namespace {
+
+constexpr uint64_t mask(uint32_t bits) { return bits >= 64 ? ~uint64_t{0} : (uint64_t{1} << bits) - 1; }
+
+/**
+ * @brief Counter advancing at a fixed rate, read the way a driver reports it
+ *
+ * Time runs continuously in µs; a reading truncates it to whole µs and the counter to
+ * whole units, and keeps only the low @c bits of the counter.
+ */
+struct SyntheticCounter
+{
+	double unitsPerSecond;
+	uint32_t bits;
+	uint64_t start;
+	double timeUs;
+
+	[[nodiscard]] CounterReading read() const
+	{
+		const auto units = static_cast<uint64_t>(std::floor(unitsPerSecond * timeUs / 1e6));
+		return {(start + units) & mask(bits), static_cast<uint64_t>(timeUs)};
+	}
+};
+
+} // namespace
+
+TEST_CASE("wrappingDelta counts across a wrap of any width and rejects implausible differences")
+{
+	std::mt19937_64 rng(11);
+	for (const uint32_t bits : {16U, 32U, 48U, 64U}) {
+		for (int i = 0; i < 1000; ++i) {
+			const uint64_t before = rng() & mask(bits);
+			const uint64_t step = rng() & (mask(bits) >> 1);
+			const uint64_t after = (before + step) & mask(bits);
+			CHECK(wrappingDelta(before, after, bits, mask(bits)) == step);
+			if (step > 0) {
+				CHECK_FALSE(wrappingDelta(before, after, bits, step - 1).has_value());
+			}
+		}
+	}
+	// Bits above the width of the counter are ignored
+	CHECK(wrappingDelta(0xFFFF'FFF0, 0x1'0000'0010, 32, 100) == 0x20U);
+}
+
+TEST_CASE("counterRate recovers the rate of synthetic counters within its bounds")
+{
+	std::mt19937_64 rng(23);
+	std::uniform_real_distribution<double> rate(1.0, 1e10);
+	std::uniform_real_distribution<double> interval(10.0, 5e6);
+	for (const uint32_t bits : {32U, 64U}) {
+		int wraps = 0;
+		for (int i = 0; i < 2000; ++i) {
+			// Two of three sequences start just below the wrap
+			const uint64_t start = (mask(bits) - uint64_t{1'000'000'000} * (i % 3) + 1) & mask(bits);
+			SyntheticCounter c{rate(rng), bits, start, 1.0 + i};
+			const CounterReading before = c.read();
+			const double windowUs = interval(rng);
+			c.timeUs += windowUs;
+			const CounterReading after = c.read();
+
+			const CounterRate r = counterRate(before, after, {.bits = bits, .maxRate = 1e10});
+			if (c.unitsPerSecond * windowUs / 1e6 >= static_cast<double>(mask(bits) >> 1)) {
+				continue; // More than half the range per window is indistinguishable from a reset
+			}
+			REQUIRE(r.ok());
+			wraps += r.wrapped ? 1 : 0;
+			CHECK(r.rateLow <= c.unitsPerSecond);
+			CHECK(c.unitsPerSecond <= r.rateHigh);
+			CHECK(r.rateLow <= r.rate);
+			CHECK(r.rate <= r.rateHigh);
+		}
+		CHECK(wraps > 0);
+	}
+}
+
+TEST_CASE("counterRate reports missing, stalled and backwards timestamps")
+{
+	CHECK(counterRate({}, {100, 200}).status == DeltaStatus::Unavailable);
+	CHECK(counterRate({100, 200}, {}).status == DeltaStatus::Unavailable);
+	CHECK(counterRate({100, 200}, {150, 200}).status == DeltaStatus::Stalled);
+	CHECK(counterRate({100, 200}, {150, 100}).status == DeltaStatus::TimeReset);
+
+	// A 32-bit timestamp that wraps still moves forward
+	const CounterRate r = counterRate({0, 0xFFFF'FF00}, {1000, 0x100}, {.timestampBits = 32});
+	REQUIRE(r.ok());
+	CHECK(r.seconds == 512e-6);
+}
+
+TEST_CASE("counterRate tells a counter reset from a wrap")
+{
+	// Without a maximum rate only a difference of half the range or more is a reset
+	CHECK(counterRate({500, 100}, {400, 200}).status == DeltaStatus::CounterReset);
+	CHECK(counterRate({0xFFFF'FFF0, 100}, {0x10, 200}, {.bits = 32}).ok());
+	CHECK(counterRate({0x8000'0000, 100}, {0x10, 200}, {.bits = 32}).status == DeltaStatus::CounterReset);
+
+	// With one, a counter restarting from zero is caught even when it did not go backwards far
+	const CounterTraits traits{.bits = 32, .maxRate = 1e6};
+	CHECK(counterRate({4'000'000'000, 1'000'000}, {10, 2'000'000}, traits).status == DeltaStatus::CounterReset);
+	CHECK(counterRate({4'000'000'000, 1'000'000}, {4'003'000'000, 2'000'000}, traits).status ==
+		  DeltaStatus::CounterReset);
+	CHECK(counterRate({4'294'000'000, 1'000'000}, {500'000, 2'000'000}, traits).ok());
+}
+
+TEST_CASE("counterRate falls back to the host clock when driver timestamps jump")
+{
+	const uint64_t second = 1'000'000'000;
+	// The driver claims an hour passed; the host saw one second
+	const CounterRate jumped =
+		counterRate({0, 1'000'000, 5 * second}, {2'000'000, 3'601'000'000, 6 * second});
+	REQUIRE(jumped.ok());
+	CHECK(jumped.hostTimed);
+	CHECK(jumped.rate == 2'000'000.0);
+
+	// Agreeing clocks keep the driver window, which is closer to when the counters were latched
+	const CounterRate agreed = counterRate({0, 1'000'000, 5 * second}, {2'000'000, 3'000'000, 7 * second});
+	REQUIRE(agreed.ok());
+	CHECK_FALSE(agreed.hostTimed);
+	CHECK(agreed.rate == 1'000'000.0);
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Fan-out benchmark for the task executor.
+//
+// Runs a short per-device operation over synthetic devices many times, the way a
+// sampling loop or a multi-device command does, once with parallelForEach() on a pool
+// and once with a std::thread per device per round as the call sites used to. Also
+// times nested fan-out (cards, then tiles) and plain submit()/get() round trips.
+// Run with `meson test --benchmark task_executor_bench`.
+
+#include "task_executor.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr size_t DEVICE_COUNT = 8;
+constexpr size_t TILE_COUNT = 2;
+constexpr int ROUNDS = 2000;
+constexpr int SUBMITS = 50000;
+
+/// Stand-in for a short sysfs read or L0 query
+ze_result_t deviceWork(std::atomic<uint64_t> &sink, size_t device)
+{
+	uint64_t x = device + 1;
+	for (int i = 0; i < 2000; ++i) {
+		x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+	}
+	sink.fetch_add(x, std::memory_order_relaxed);
+	return ZE_RESULT_SUCCESS;
+}
+
+template <typename Fn> double usPerRound(int rounds, Fn fn)
+{
+	const auto start = std::chrono::steady_clock::now();
+	for (int r = 0; r < rounds; ++r) {
+		fn();
+	}
+	const auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start);
+	return elapsed.count() / rounds;
+}
+
+} // namespace
+
+int main()
+{
+	TaskExecutor executor(DEVICE_COUNT);
+	std::vector<size_t> devices(DEVICE_COUNT);
+	for (size_t i = 0; i < DEVICE_COUNT; ++i) {
+		devices[i] = i;
+	}
+	std::vector<size_t> tiles(TILE_COUNT);
+	for (size_t i = 0; i < TILE_COUNT; ++i) {
+		tiles[i] = i;
+	}
+	std::atomic<uint64_t> sink{0};
+	bool ok = true;
+
+	const double pooled = usPerRound(ROUNDS, [&] {
+		ok &= parallelForEach(devices, [&](size_t d) { return deviceWork(sink, d); }, {}, executor).ok();
+	});
+
+	const double threadPerDevice = usPerRound(ROUNDS, [&] {
+		std::vector<ze_result_t> results(devices.size());
+		std::vector<std::thread> workers;
+		for (size_t i = 0; i < devices.size(); ++i) {
+			workers.emplace_back([&, i] { results[i] = deviceWork(sink, devices[i]); });
+		}
+		for (auto &w : workers) {
+			w.join();
+		}
+	});
+
+	const double nested = usPerRound(ROUNDS, [&] {
+		ok &= parallelForEach(
+				  devices,
+				  [&](size_t d) {
+					  return parallelForEach(
+								 tiles, [&](size_t t) { return deviceWork(sink, d * TILE_COUNT + t); }, {}, executor)
+						  .first();
+				  },
+				  {}, executor)
+				  .ok();
+	});
+
+	const auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < SUBMITS; ++i) {
+		executor.submit([i] { return i; }).get();
+	}
+	const double roundTripNs =
+		std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / SUBMITS;
+
+	std::printf("%zu devices x %d rounds on %zu workers\n", DEVICE_COUNT, ROUNDS, executor.workerCount());
+	std::printf("parallelForEach              : %8.1f us/round\n", pooled);
+	std::printf("std::thread per device       : %8.1f us/round\n", threadPerDevice);
+	std::printf("nested fan-out (%zu tiles)     : %8.1f us/round\n", TILE_COUNT, nested);
+	std::printf("submit()+get() round trip    : %8.1f ns\n", roundTripNs);
+
+	return ok && sink.load() != 0 ? 0 : 1;
+}
@@ -0,0 +1,344 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ * Unit tests for task_executor.cpp
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#ifdef INFO
+#undef INFO
+#endif
+
+#include "task_executor.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <latch>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+/// Keeps the workers of an executor busy until released.
+class Gate
+{
+public:
+	Gate(TaskExecutor &executor, size_t workers) : started(static_cast<std::ptrdiff_t>(workers))
+	{
+		for (size_t i = 0; i < workers; ++i) {
+			blockers.push_back(executor.submit([this] {
+				started.count_down();
+				while (!open) {
+					std::this_thread::sleep_for(1ms);
+				}
+			}));
+		}
+		started.wait();
+	}
+
+	~Gate() { release(); }
+
+	void release()
+	{
+		open = true;
+		for (auto &b : blockers) {
+			b.wait();
+		}
+	}
+
+private:
+	std::latch started;
+	std::atomic<bool> open{false};
+	std::vector<std::future<void>> blockers;
+};
+
+/// Why the task of @p future did not run; std::nullopt if it ran
+template <typename T> std::optional<TaskAborted::Reason> abortReason(std::future<T> &future)
+{
+	try {
+		future.get();
+	} catch (const TaskAborted &e) {
+		return e.reason();
+	}
+	return std::nullopt;
+}
+
+} // namespace
+
+TEST_SUITE("TaskExecutor")
+{
+	TEST_CASE("delivers typed results, void completion and exceptions through futures")
+	{
+		TaskExecutor executor(2);
+		auto number = executor.submit([] { return 42; });
+		auto text = executor.submit([](const std::stop_token &) { return std::string("gpu"); });
+		std::atomic<bool> ran{false};
+		auto done = executor.submit([&] { ran = true; });
+		auto failing = executor.submit([]() -> int { throw std::runtime_error("boom"); });
+
+		CHECK(number.get() == 42);
+		CHECK(text.get() == "gpu");
+		done.get();
+		CHECK(ran);
+		CHECK_THROWS_AS(failing.get(), std::runtime_error);
+	}
+
+	TEST_CASE("accepts move-only callables")
+	{
+		TaskExecutor executor(1);
+		auto value = std::make_unique<int>(7);
+		CHECK(executor.submit([v = std::move(value)] { return *v; }).get() == 7);
+	}
+
+	TEST_CASE("a task cancelled while queued never runs")
+	{
+		TaskExecutor executor(1);
+		std::stop_source cancel;
+		std::atomic<bool> ran{false};
+		std::future<void> queued;
+		{
+			Gate gate(executor, 1);
+			queued = executor.submit([&] { ran = true; }, TaskOptions{cancel.get_token()});
+			cancel.request_stop();
+		}
+		CHECK(abortReason(queued) == TaskAborted::Reason::CANCELLED);
+		CHECK(TaskAborted(TaskAborted::Reason::CANCELLED).result() == ZE_RESULT_ERROR_NOT_AVAILABLE);
+		CHECK_FALSE(ran);
+	}
+
+	TEST_CASE("an already cancelled token aborts the task right away")
+	{
+		TaskExecutor executor(1);
+		std::stop_source cancel;
+		cancel.request_stop();
+		auto f = executor.submit([] { return 1; }, TaskOptions{cancel.get_token()});
+		CHECK(f.wait_for(0s) == std::future_status::ready);
+		CHECK_THROWS_AS(f.get(), TaskAborted);
+	}
+
+	TEST_CASE("a running task sees cancellation through its stop_token")
+	{
+		TaskExecutor executor(1);
+		std::stop_source cancel;
+		std::latch started(1);
+		auto f = executor.submit(
+			[&](const std::stop_token &stop) {
+				started.count_down();
+				while (!stop.stop_requested()) {
+					std::this_thread::sleep_for(1ms);
+				}
+				return ZE_RESULT_ERROR_NOT_AVAILABLE;
+			},
+			TaskOptions{cancel.get_token()});
+		started.wait();
+		cancel.request_stop();
+		CHECK(f.get() == ZE_RESULT_ERROR_NOT_AVAILABLE);
+	}
+
+	TEST_CASE("deadlines drop queued tasks and stop running ones")
+	{
+		TaskExecutor executor(1);
+		auto running = executor.submit(
+			[](const std::stop_token &stop) {
+				while (!stop.stop_requested()) {
+					std::this_thread::sleep_for(1ms);
+				}
+				return true;
+			},
+			TaskOptions::within(30ms));
+		std::atomic<bool> ran{false};
+		auto queued = executor.submit([&] { ran = true; }, TaskOptions::within(10ms));
+
+		CHECK(running.get());
+		CHECK(abortReason(queued) == TaskAborted::Reason::DEADLINE);
+		CHECK(TaskAborted(TaskAborted::Reason::DEADLINE).result() == ZE_RESULT_NOT_READY);
+		CHECK_FALSE(ran);
+	}
+
+	TEST_CASE("submit blocks outside threads while the queue is full")
+	{
+		TaskExecutor executor(1, 1);
+		Gate gate(executor, 1);
+		auto first = executor.submit([] { return 1; });
+
+		std::atomic<bool> submitted{false};
+		std::future<int> second;
+		std::thread producer([&] {
+			second = executor.submit([] { return 2; });
+			submitted = true;
+		});
+		std::this_thread::sleep_for(50ms);
+		CHECK_FALSE(submitted);
+
+		gate.release();
+		producer.join();
+		CHECK(submitted);
+		CHECK(first.get() == 1);
+		CHECK(second.get() == 2);
+	}
+
+	TEST_CASE("a worker submitting to a full queue runs the task itself")
+	{
+		TaskExecutor executor(1, 1);
+		auto outer = executor.submit([&executor] {
+			auto a = executor.submit([] { return std::this_thread::get_id(); });
+			auto b = executor.submit([] { return std::this_thread::get_id(); }); // Queue full: runs inline
+			const bool inline_ = b.wait_for(0s) == std::future_status::ready;
+			executor.wait(a);
+			return inline_ && b.get() == std::this_thread::get_id() && a.get() == std::this_thread::get_id();
+		});
+		CHECK(outer.get());
+	}
+
+	TEST_CASE("idle workers steal from a busy worker's queue")
+	{
+		TaskExecutor executor(4);
+		std::atomic<int> active{0};
+		std::atomic<int> maxActive{0};
+		auto outer = executor.submit([&] {
+			std::vector<std::future<void>> inner;
+			for (int i = 0; i < 8; ++i) {
+				inner.push_back(executor.submit([&] {
+					const int now = ++active;
+					int seen = maxActive.load();
+					while (now > seen && !maxActive.compare_exchange_weak(seen, now)) {
+					}
+					std::this_thread::sleep_for(20ms);
+					--active;
+				}));
+			}
+			for (auto &f : inner) {
+				executor.wait(f);
+			}
+		});
+		outer.get();
+		CHECK(maxActive.load() > 1);
+	}
+
+	TEST_CASE("destruction aborts queued tasks and stops running ones")
+	{
+		std::future<bool> running;
+		std::future<void> queued;
+		{
+			TaskExecutor executor(1);
+			std::latch started(1);
+			running = executor.submit([&](const std::stop_token &stop) {
+				started.count_down();
+				while (!stop.stop_requested()) {
+					std::this_thread::sleep_for(1ms);
+				}
+				return true;
+			});
+			started.wait();
+			queued = executor.submit([] {});
+		}
+		CHECK(running.get());
+		CHECK(abortReason(queued) == TaskAborted::Reason::SHUTDOWN);
+	}
+}
+
+TEST_SUITE("parallelForEach")
+{
+	TEST_CASE("aggregates per-item results in input order")
+	{
+		TaskExecutor executor(3);
+		std::vector<int> devices{0, 1, 2, 3, 4, 5};
+		const auto outcome = parallelForEach(
+			devices,
+			[](int &d) {
+				d *= 10;
+				if (d == 30) {
+					return ZE_RESULT_ERROR_DEVICE_LOST;
+				}
+				if (d == 50) {
+					return ZE_RESULT_ERROR_UNSUPPORTED_FEATURE;
+				}
+				return ZE_RESULT_SUCCESS;
+			},
+			{}, executor);
+
+		CHECK(devices == std::vector<int>{0, 10, 20, 30, 40, 50});
+		REQUIRE(outcome.results.size() == 6);
+		CHECK(outcome.results[3] == ZE_RESULT_ERROR_DEVICE_LOST);
+		CHECK(outcome.first() == ZE_RESULT_ERROR_DEVICE_LOST);
+		CHECK(outcome.failures() == 2);
+		CHECK_FALSE(outcome.ok());
+	}
+
+	TEST_CASE("an empty range succeeds")
+	{
+		std::vector<int> none;
+		const auto outcome = parallelForEach(none, [](int) { return ZE_RESULT_ERROR_UNKNOWN; });
+		CHECK(outcome.results.empty());
+		CHECK(outcome.ok());
+		CHECK(outcome.first() == ZE_RESULT_SUCCESS);
+	}
+
+	TEST_CASE("exceptions and cancellation become error codes")
+	{
+		TaskExecutor executor(2);
+		const std::vector<int> devices{0, 1};
+		const auto thrown = parallelForEach(
+			devices,
+			[](int d) -> ze_result_t {
+				if (d == 1) {
+					throw std::runtime_error("lost");
+				}
+				return ZE_RESULT_SUCCESS;
+			},
+			{}, executor);
+		CHECK(thrown.results == std::vector<ze_result_t>{ZE_RESULT_SUCCESS, ZE_RESULT_ERROR_UNKNOWN});
+
+		std::stop_source cancel;
+		cancel.request_stop();
+		const auto cancelled = parallelForEach(
+			devices, [](int, const std::stop_token &) { return ZE_RESULT_SUCCESS; }, TaskOptions{cancel.get_token()},
+			executor);
+		CHECK(cancelled.failures() == 2);
+		CHECK(cancelled.first() == ZE_RESULT_ERROR_NOT_AVAILABLE);
+	}
+
+	TEST_CASE("nested fan-out on a single worker does not deadlock")
+	{
+		TaskExecutor executor(1);
+		const std::vector<int> cards{0, 1, 2};
+		auto outer = executor.submit([&] {
+			return parallelForEach(
+					   cards,
+					   [&](int) {
+						   const std::vector<int> tiles{0, 1};
+						   return parallelForEach(tiles, [](int) { return ZE_RESULT_SUCCESS; }, {}, executor).first();
+					   },
+					   {}, executor)
+				.ok();
+		});
+		REQUIRE(outer.wait_for(5s) == std::future_status::ready);
+		CHECK(outer.get());
+	}
+
+	TEST_CASE("runs devices concurrently on the shared executor")
+	{
+		std::atomic<int> active{0};
+		std::atomic<int> maxActive{0};
+		const std::vector<int> devices(4, 0);
+		const auto outcome = parallelForEach(devices, [&](int) {
+			const int now = ++active;
+			int seen = maxActive.load();
+			while (now > seen && !maxActive.compare_exchange_weak(seen, now)) {
+			}
+			std::this_thread::sleep_for(20ms);
+			--active;
+			return ZE_RESULT_SUCCESS;
+		});
+		CHECK(outcome.ok());
+		CHECK(maxActive.load() > 1);
+	}
+}
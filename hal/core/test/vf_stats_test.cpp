@@ -0,0 +1,275 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ * Unit tests for vfStatsCollector: per-VF statistics computed from fake engine counter
+ * samples. The Level Zero VF entry points are defined here, so they take precedence
+ * over the loader's.
+ */
+
+#ifndef __linux__
+#define DOCTEST_CONFIG_DISABLE
+#endif
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#ifdef INFO
+#undef INFO
+#endif
+
+#include "vf.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <vector>
+
+namespace {
+
+/** @brief One VF as the fake driver reports it */
+struct FakeVF
+{
+	std::optional<zes_vf_exp2_capabilities_t> caps;
+	std::optional<zes_vf_util_mem_exp2_t> mem;
+	// One engine list per read; the last one repeats once they run out
+	std::vector<std::vector<zes_vf_util_engine_exp2_t>> samples;
+	ze_result_t engineResult = ZE_RESULT_SUCCESS;
+	size_t reads = 0;
+};
+
+/** @brief Enabled VFs of every fake device */
+std::map<zes_device_handle_t, std::vector<FakeVF>> fakeDevices;
+
+FakeVF &fakeOf(zes_vf_handle_t handle) { return *reinterpret_cast<FakeVF *>(handle); }
+
+zes_device_handle_t deviceHandle(uintptr_t n) { return reinterpret_cast<zes_device_handle_t>(n); }
+
+zes_vf_util_engine_exp2_t engine(zes_engine_group_t type, uint64_t active, uint64_t sampling)
+{
+	zes_vf_util_engine_exp2_t e = {};
+	e.vfEngineType = type;
+	e.activeCounterValue = active;
+	e.samplingCounterValue = sampling;
+	return e;
+}
+
+FakeVF vfWithCaps(uint32_t id, uint32_t bus)
+{
+	FakeVF v;
+	zes_vf_exp2_capabilities_t caps = {};
+	caps.vfID = id;
+	caps.address.domain = 0;
+	caps.address.bus = bus;
+	caps.address.device = 0;
+	caps.address.function = id;
+	caps.vfDeviceMemSize = 4ULL << 30;
+	v.caps = caps;
+	zes_vf_util_mem_exp2_t mem = {};
+	mem.vfMemLocation = ZES_MEM_LOC_DEVICE;
+	mem.vfMemUtilized = 1ULL << 20;
+	v.mem = mem;
+	return v;
+}
+
+/** @brief Samples every device once through a collector; window 0 keeps the test fast */
+std::vector<std::vector<VFStatsInfo>> collectOnce(std::vector<vf> &vfs, ze_result_t expected = ZE_RESULT_SUCCESS)
+{
+	vfStatsCollector collector;
+	for (auto &v : vfs) {
+		collector.addDevice(&v, DeviceSriovInfo{});
+	}
+	std::vector<std::vector<VFStatsInfo>> lists;
+	CHECK(collector.collect(std::chrono::milliseconds(0), lists) == expected);
+	return lists;
+}
+
+} // namespace
+
+extern "C" {
+
+ze_result_t zesDeviceEnumEnabledVFExp(zes_device_handle_t hDevice, uint32_t *pCount, zes_vf_handle_t *phVFhandle)
+{
+	auto &vfs = fakeDevices[hDevice];
+	if (phVFhandle != nullptr) {
+		for (uint32_t i = 0; i < *pCount && i < vfs.size(); ++i) {
+			phVFhandle[i] = reinterpret_cast<zes_vf_handle_t>(&vfs[i]);
+		}
+	}
+	*pCount = static_cast<uint32_t>(vfs.size());
+	return ZE_RESULT_SUCCESS;
+}
+
+ze_result_t zesVFManagementGetVFCapabilitiesExp2(zes_vf_handle_t hVFhandle, zes_vf_exp2_capabilities_t *pCapability)
+{
+	const FakeVF &v = fakeOf(hVFhandle);
+	if (!v.caps) {
+		return ZE_RESULT_ERROR_UNSUPPORTED_FEATURE;
+	}
+	*pCapability = *v.caps;
+	return ZE_RESULT_SUCCESS;
+}
+
+ze_result_t zesVFManagementGetVFMemoryUtilizationExp2(zes_vf_handle_t hVFhandle, uint32_t *pCount,
+													 zes_vf_util_mem_exp2_t *pMemUtil)
+{
+	const FakeVF &v = fakeOf(hVFhandle);
+	if (!v.mem) {
+		return ZE_RESULT_ERROR_UNSUPPORTED_FEATURE;
+	}
+	*pCount = 1;
+	if (pMemUtil != nullptr) {
+		*pMemUtil = *v.mem;
+	}
+	return ZE_RESULT_SUCCESS;
+}
+
+ze_result_t zesVFManagementGetVFEngineUtilizationExp2(zes_vf_handle_t hVFhandle, uint32_t *pCount,
+													 zes_vf_util_engine_exp2_t *pEngineUtil)
+{
+	FakeVF &v = fakeOf(hVFhandle);
+	if (v.engineResult != ZE_RESULT_SUCCESS) {
+		return v.engineResult;
+	}
+	const auto &sample = v.samples[std::min(v.reads, v.samples.size() - 1)];
+	if (pEngineUtil == nullptr) {
+		*pCount = static_cast<uint32_t>(sample.size());
+		return ZE_RESULT_SUCCESS;
+	}
+	const uint32_t n = std::min(*pCount, static_cast<uint32_t>(sample.size()));
+	std::copy_n(sample.begin(), n, pEngineUtil);
+	*pCount = n;
+	++v.reads;
+	return ZE_RESULT_SUCCESS;
+}
+
+} // extern "C"
+
+TEST_CASE("vfStatsCollector reports per-VF utilization from the engine counter deltas")
+{
+	fakeDevices.clear();
+	FakeVF first = vfWithCaps(1, 0x4d);
+	first.samples = {
+		{engine(ZES_ENGINE_GROUP_COMPUTE_SINGLE, 1000, 0), engine(ZES_ENGINE_GROUP_COPY_SINGLE, 0, 0),
+		 engine(ZES_ENGINE_GROUP_MEDIA_DECODE_SINGLE, 0, 0), engine(ZES_ENGINE_GROUP_MEDIA_ENCODE_SINGLE, 0, 0)},
+		{engine(ZES_ENGINE_GROUP_COMPUTE_SINGLE, 1500, 1000), engine(ZES_ENGINE_GROUP_COPY_SINGLE, 250, 1000),
+		 engine(ZES_ENGINE_GROUP_MEDIA_DECODE_SINGLE, 100, 1000),
+		 engine(ZES_ENGINE_GROUP_MEDIA_ENCODE_SINGLE, 300, 1000)},
+	};
+	FakeVF second = vfWithCaps(2, 0x4d);
+	second.samples = {
+		{engine(ZES_ENGINE_GROUP_RENDER_SINGLE, 0, 5000)},
+		{engine(ZES_ENGINE_GROUP_RENDER_SINGLE, 2000, 7000)},
+	};
+	fakeDevices[deviceHandle(1)] = {first, second};
+
+	std::vector<vf> vfs(1);
+	REQUIRE(vfs[0].init(deviceHandle(1)) == ZE_RESULT_SUCCESS);
+	const auto lists = collectOnce(vfs);
+	REQUIRE(lists.size() == 1);
+	REQUIRE(lists[0].size() == 2);
+
+	const VFStatsInfo &a = lists[0][0];
+	CHECK(a.vfId == 1);
+	CHECK(a.bus == 0x4d);
+	CHECK(a.function == 1);
+	CHECK(a.vfDeviceMemSize == 4ULL << 30);
+	CHECK(a.memLocation == ZES_MEM_LOC_DEVICE);
+	CHECK(a.memoryUtilized == 1ULL << 20);
+	CHECK(a.computeUtilization == doctest::Approx(50.0));
+	CHECK(a.copyUtilization == doctest::Approx(25.0));
+	CHECK(a.mediaUtilization == doctest::Approx(30.0)); // Max of decode and encode
+	CHECK(a.renderUtilization == doctest::Approx(-1.0));
+	CHECK(a.gpuUtilization == doctest::Approx(50.0));
+
+	const VFStatsInfo &b = lists[0][1];
+	CHECK(b.vfId == 2);
+	CHECK(b.renderUtilization == doctest::Approx(100.0));
+	CHECK(b.computeUtilization == doctest::Approx(-1.0));
+	CHECK(b.gpuUtilization == doctest::Approx(100.0));
+}
+
+TEST_CASE("vfStatsCollector counts across a counter wrap and drops a reset")
+{
+	fakeDevices.clear();
+	FakeVF v = vfWithCaps(1, 0x4d);
+	v.samples = {
+		{engine(ZES_ENGINE_GROUP_COMPUTE_SINGLE, UINT64_MAX - 99, UINT64_MAX - 999),
+		 engine(ZES_ENGINE_GROUP_COPY_SINGLE, 5000, 5000)},
+		{engine(ZES_ENGINE_GROUP_COMPUTE_SINGLE, 100, 1000), engine(ZES_ENGINE_GROUP_COPY_SINGLE, 10, 6000)},
+	};
+	fakeDevices[deviceHandle(1)] = {v};
+
+	std::vector<vf> vfs(1);
+	REQUIRE(vfs[0].init(deviceHandle(1)) == ZE_RESULT_SUCCESS);
+	const auto lists = collectOnce(vfs);
+	REQUIRE(lists.at(0).size() == 1);
+	CHECK(lists[0][0].computeUtilization == doctest::Approx(10.0)); // 200 of 2000 across the wrap
+	CHECK(lists[0][0].copyUtilization == doctest::Approx(-1.0));	// Active counter went back
+}
+
+TEST_CASE("vfStatsCollector continues from the previous sample on repeated calls")
+{
+	fakeDevices.clear();
+	FakeVF v = vfWithCaps(1, 0x4d);
+	v.samples = {
+		{engine(ZES_ENGINE_GROUP_COMPUTE_SINGLE, 0, 0)},
+		{engine(ZES_ENGINE_GROUP_COMPUTE_SINGLE, 200, 1000)},
+		{engine(ZES_ENGINE_GROUP_COMPUTE_SINGLE, 1000, 2000)},
+	};
+	fakeDevices[deviceHandle(1)] = {v};
+
+	vf pf;
+	REQUIRE(pf.init(deviceHandle(1)) == ZE_RESULT_SUCCESS);
+	vfStatsCollector collector;
+	collector.addDevice(&pf, DeviceSriovInfo{});
+	std::vector<std::vector<VFStatsInfo>> lists;
+	REQUIRE(collector.collect(std::chrono::milliseconds(0), lists) == ZE_RESULT_SUCCESS);
+	CHECK(lists.at(0).at(0).computeUtilization == doctest::Approx(20.0));
+	REQUIRE(collector.collect(std::chrono::milliseconds(0), lists) == ZE_RESULT_SUCCESS);
+	CHECK(lists.at(0).at(0).computeUtilization == doctest::Approx(80.0));
+}
+
+TEST_CASE("vfStatsCollector reports no utilization when the engine query is unsupported")
+{
+	fakeDevices.clear();
+	FakeVF v = vfWithCaps(3, 0x4d);
+	v.engineResult = ZE_RESULT_ERROR_UNSUPPORTED_FEATURE;
+	v.mem.reset();
+	fakeDevices[deviceHandle(1)] = {v};
+
+	std::vector<vf> vfs(1);
+	REQUIRE(vfs[0].init(deviceHandle(1)) == ZE_RESULT_SUCCESS);
+	const auto lists = collectOnce(vfs);
+	REQUIRE(lists.at(0).size() == 1);
+	const VFStatsInfo &s = lists[0][0];
+	CHECK(s.vfId == 3);
+	CHECK(s.memLocation == ZES_MEM_LOC_FORCE_UINT32);
+	CHECK(s.memoryUtilized == 0);
+	CHECK(s.gpuUtilization == doctest::Approx(-1.0));
+	CHECK(s.computeUtilization == doctest::Approx(-1.0));
+}
+
+TEST_CASE("vfStatsCollector handles devices without VFs and VFs without capabilities")
+{
+	fakeDevices.clear();
+	FakeVF noCaps = vfWithCaps(0, 0);
+	noCaps.caps.reset();
+	noCaps.samples = {{engine(ZES_ENGINE_GROUP_COMPUTE_SINGLE, 0, 0)},
+					  {engine(ZES_ENGINE_GROUP_COMPUTE_SINGLE, 100, 1000)}};
+	fakeDevices[deviceHandle(1)] = {};
+	fakeDevices[deviceHandle(2)] = {noCaps, noCaps};
+
+	std::vector<vf> vfs(2);
+	REQUIRE(vfs[0].init(deviceHandle(1)) == ZE_RESULT_SUCCESS);
+	REQUIRE(vfs[1].init(deviceHandle(2)) == ZE_RESULT_SUCCESS);
+	const auto lists = collectOnce(vfs);
+	REQUIRE(lists.size() == 2);
+	CHECK(lists[0].empty());
+	REQUIRE(lists[1].size() == 2);
+	// Without capabilities the VFs are numbered in enumeration order
+	CHECK(lists[1][0].vfId == 1);
+	CHECK(lists[1][1].vfId == 2);
+	CHECK(lists[1][0].computeUtilization == doctest::Approx(10.0));
+}
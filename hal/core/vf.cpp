@@ -5,41 +5,19 @@
  */
 
 #include "vf.h"
+#include "counter_delta.h"
 #include <osvf.h>
 #include <chrono>
 #include <thread>
 #include <algorithm>
+#include <limits>
 #include <sstream>
 
 // Interval in milliseconds between engine utilization snapshots
 static constexpr int VF_METRICS_INTERVAL_MS = 100;
 
-/**
- * @brief Internal structure for VF engine snapshot data
- */
-struct VFEngineSnapshot
-{
-	zes_engine_group_t engineType;
-	uint64_t activeCounterValue;
-	uint64_t samplingCounterValue;
-};
-
-/**
- * @brief Internal structure for VF snapshot during two-snapshot measurement
- */
-struct VFSnapshot
-{
-	zes_vf_handle_t vfHandle;
-	uint32_t vfId;
-	uint32_t domain;
-	uint8_t bus;
-	uint8_t device;
-	uint8_t function;
-	uint64_t vfDeviceMemSize;
-	zes_mem_loc_t memLocation;
-	uint64_t memoryUtilized;
-	std::vector<VFEngineSnapshot> engineSnapshots;
-};
+// Largest step of a VF engine counter between snapshots; more means the counter was reset
+static constexpr uint64_t VF_COUNTER_STEP_LIMIT = std::numeric_limits<uint64_t>::max() / 2;
 
 /**
  * @brief Destructor for the Virtual Function (VF) class
@@ -251,45 +229,143 @@ ze_result_t vf::getVFEngineUtilization(zes_vf_handle_t vfHandle, zes_vf_util_eng
 }
 
 /**
- * @brief Gets all engine utilization counters for a Virtual Function
+ * @brief Takes an engine counter snapshot for a Virtual Function
  *
- * This function retrieves all engine utilization data for a specific VF,
- * returning a vector of engine snapshots with counters for each engine type.
+ * The engine count and query buffer are cached in @p state, so steady-state
+ * samples issue a single zesVFManagementGetVFEngineUtilizationExp2() call.
+ * The count is re-queried only on the first call or when the driver reports
+ * a different number of engines.
  *
  * @param vfHandle Handle to the specific Virtual Function
+ * @param state Cached per-VF sample state holding the reusable query buffer
  * @param snapshots Vector to populate with engine snapshot data
  * @return ze_result_t ZE_RESULT_SUCCESS on success, error code otherwise
  */
-static ze_result_t getAllVFEngineUtilization(zes_vf_handle_t vfHandle, std::vector<VFEngineSnapshot> &snapshots)
+ze_result_t vf::snapshotVFEngines(zes_vf_handle_t vfHandle, VFSampleState &state,
+								  std::vector<VFEngineSnapshot> &snapshots)
 {
-	uint32_t engineUtilCount = 0;
-	ze_result_t result = zesVFManagementGetVFEngineUtilizationExp2(vfHandle, &engineUtilCount, nullptr);
-	if (result != ZE_RESULT_SUCCESS) {
-		ERR("Failed to get VF engine count. 0x{:X} ({})\n", result, l0_error_to_string(result));
-		return result;
-	}
+	uint32_t engineUtilCount = static_cast<uint32_t>(state.engineBuffer.size());
+	ze_result_t result = ZE_RESULT_SUCCESS;
 
-	if (engineUtilCount == 0) {
-		DBG("No engine utilization data available.\n");
-		return ZE_RESULT_SUCCESS;
+	if (engineUtilCount != 0) {
+		result = zesVFManagementGetVFEngineUtilizationExp2(vfHandle, &engineUtilCount, state.engineBuffer.data());
 	}
 
-	std::vector<zes_vf_util_engine_exp2_t> engineUtils(engineUtilCount);
-	result = zesVFManagementGetVFEngineUtilizationExp2(vfHandle, &engineUtilCount, engineUtils.data());
-	if (result != ZE_RESULT_SUCCESS) {
-		ERR("Failed to get VF engine utilization. 0x{:X} ({})\n", result, l0_error_to_string(result));
-		return result;
+	if (state.engineBuffer.empty() || result != ZE_RESULT_SUCCESS || engineUtilCount != state.engineBuffer.size()) {
+		engineUtilCount = 0;
+		result = zesVFManagementGetVFEngineUtilizationExp2(vfHandle, &engineUtilCount, nullptr);
+		if (result != ZE_RESULT_SUCCESS) {
+			ERR("Failed to get VF engine count. 0x{:X} ({})\n", result, l0_error_to_string(result));
+			return result;
+		}
+
+		if (engineUtilCount == 0) {
+			DBG("No engine utilization data available.\n");
+			state.engineBuffer.clear();
+			snapshots.clear();
+			return ZE_RESULT_SUCCESS;
+		}
+
+		state.engineBuffer.assign(engineUtilCount, zes_vf_util_engine_exp2_t{});
+		result = zesVFManagementGetVFEngineUtilizationExp2(vfHandle, &engineUtilCount, state.engineBuffer.data());
+		if (result != ZE_RESULT_SUCCESS) {
+			ERR("Failed to get VF engine utilization. 0x{:X} ({})\n", result, l0_error_to_string(result));
+			state.engineBuffer.clear();
+			return result;
+		}
+		state.engineBuffer.resize(engineUtilCount);
 	}
 
 	snapshots.clear();
 	snapshots.reserve(engineUtilCount);
-	for (const auto &engine : engineUtils) {
+	for (const auto &engine : state.engineBuffer) {
 		snapshots.push_back({engine.vfEngineType, engine.activeCounterValue, engine.samplingCounterValue});
 	}
 
 	return ZE_RESULT_SUCCESS;
 }
 
+/**
+ * @brief Computes engine utilization percentages from two engine snapshots
+ *
+ * Engine utilization is aggregated by type (max of each category) and an
+ * overall GPU utilization is calculated as the max of all engine types.
+ *
+ * @param first Engine snapshot taken at the start of the sample window
+ * @param second Engine snapshot taken at the end of the sample window
+ * @param stats VF statistics to update with utilization percentages
+ */
+static void computeVFUtilization(const std::vector<VFEngineSnapshot> &first,
+								 const std::vector<VFEngineSnapshot> &second, VFStatsInfo &stats)
+{
+	if (second.size() != first.size()) {
+		DBG("Engine count mismatch for VF {}.\n", stats.vfId);
+		return;
+	}
+
+	double maxMedia = -1.0, maxCompute = -1.0, maxRender = -1.0, maxCopy = -1.0;
+
+	for (size_t j = 0; j < first.size(); j++) {
+		const auto &begin = first[j];
+		const auto &end = second[j];
+
+		if (begin.engineType != end.engineType) {
+			DBG("Engine type mismatch at index {} for VF {}.\n", j, stats.vfId);
+			continue;
+		}
+
+		// The sampling counter is the time base of the active counter; either may wrap
+		const auto activeDelta =
+			metrics::wrappingDelta(begin.activeCounterValue, end.activeCounterValue, 64, VF_COUNTER_STEP_LIMIT);
+		const auto samplingDelta =
+			metrics::wrappingDelta(begin.samplingCounterValue, end.samplingCounterValue, 64, VF_COUNTER_STEP_LIMIT);
+		if (!activeDelta || !samplingDelta || *samplingDelta == 0) {
+			DBG("No utilization for engine {} on VF {}: counters reset or did not advance.\n", begin.engineType,
+				stats.vfId);
+			continue;
+		}
+
+		const double utilPercent =
+			std::min(static_cast<double>(*activeDelta) / static_cast<double>(*samplingDelta) * 100.0, 100.0);
+
+		switch (begin.engineType) {
+		case ZES_ENGINE_GROUP_MEDIA_DECODE_SINGLE:
+		case ZES_ENGINE_GROUP_MEDIA_ENCODE_SINGLE:
+		case ZES_ENGINE_GROUP_MEDIA_ENHANCEMENT_SINGLE:
+			maxMedia = std::max(maxMedia, utilPercent);
+			break;
+		case ZES_ENGINE_GROUP_COMPUTE_SINGLE:
+			maxCompute = std::max(maxCompute, utilPercent);
+			break;
+		case ZES_ENGINE_GROUP_RENDER_SINGLE:
+			maxRender = std::max(maxRender, utilPercent);
+			break;
+		case ZES_ENGINE_GROUP_COPY_SINGLE:
+			maxCopy = std::max(maxCopy, utilPercent);
+			break;
+		default:
+			DBG("Unknown engine type {} for VF {}.\n", begin.engineType, stats.vfId);
+			break;
+		}
+	}
+
+	stats.mediaUtilization = maxMedia;
+	stats.computeUtilization = maxCompute;
+	stats.renderUtilization = maxRender;
+	stats.copyUtilization = maxCopy;
+
+	double maxOverall = -1.0;
+	if (maxMedia >= 0.0)
+		maxOverall = std::max(maxOverall, maxMedia);
+	if (maxCompute >= 0.0)
+		maxOverall = std::max(maxOverall, maxCompute);
+	if (maxRender >= 0.0)
+		maxOverall = std::max(maxOverall, maxRender);
+	if (maxCopy >= 0.0)
+		maxOverall = std::max(maxOverall, maxCopy);
+	stats.gpuUtilization = maxOverall;
+}
+
 /*
  * @brief Creates Virtual Functions (VFs) for a device
  *
@@ -303,6 +379,8 @@ ze_result_t vf::createVFs(DeviceSriovInfo *deviceInfo)
 {
 	TRACING();
 
+	invalidateVFStatsCache();
+
 	/* Call OAL Macro for creating VFs */
 	if (CREATEVFS(deviceInfo)) {
 		ERR("Failed to create VFs.\n");
@@ -324,6 +402,8 @@ ze_result_t vf::removeVFs(DeviceSriovInfo *deviceInfo)
 {
 	TRACING();
 
+	invalidateVFStatsCache();
+
 	/* Call OAL Macro for removing VFs */
 	if (REMOVEVFS(deviceInfo)) {
 		ERR("Failed to remove VFs.\n");
@@ -355,23 +435,98 @@ ze_result_t vf::listVFs(DeviceSriovInfo *deviceInfo, std::vector<DeviceSriovInfo
 }
 
 /**
- * @brief Gets comprehensive statistics for all enabled Virtual Functions
- *
- * This function collects detailed statistics for all enabled VFs on the device,
- * using a two-snapshot method to calculate accurate engine utilization percentages.
- * Engine utilization is aggregated by type (max of each category) and an overall
- * GPU utilization is calculated as the max of all engine types.
+ * @brief Resolves and caches the identity of every enabled Virtual Function
  *
- * Note: VFs must be enumerated via init() before calling this function.
+ * VF ID, BDF and memory quota do not change while the VFs stay enabled, so
+ * they are read once and reused by every subsequent statistics sample.
  *
  * If VF capabilities API is not supported on the device, BDF information
- * is obtained via LISTVFS OAL call as a fallback.
+ * is obtained via a single LISTVFS OAL call as a fallback.
  *
  * @param[in] deviceInfo Pointer to device info (used for LISTVFS fallback)
- * @param[out] statsList Reference to a vector to populate with VFStatsInfo structures
- * @return ze_result_t ZE_RESULT_SUCCESS on successful statistics retrieval, error code otherwise
  */
-ze_result_t vf::getVFStatsList(DeviceSriovInfo *deviceInfo, std::vector<VFStatsInfo> &statsList)
+void vf::cacheVFIdentities(DeviceSriovInfo *deviceInfo)
+{
+	if (vfIdentityCached && vfSampleStates.size() == vfEnabledCount) {
+		return;
+	}
+
+	vfSampleStates.assign(vfEnabledCount, VFSampleState{});
+
+	// LISTVFS is only needed when the capabilities API is unavailable; run it lazily at most once
+	std::vector<DeviceSriovInfo> vfListInfo;
+	bool vfListLoaded = false;
+
+	for (uint32_t i = 0; i < vfEnabledCount; i++) {
+		VFStatsInfo &id = vfSampleStates[i].identity;
+		id.vfId = i + 1; // Default VF ID if capabilities not available
+
+		zes_vf_exp2_capabilities_t caps = {};
+		if (getVFCapabilities(vfEnabledHandles[i], &caps) == ZE_RESULT_SUCCESS) {
+			id.vfId = caps.vfID;
+			id.domain = caps.address.domain;
+			id.bus = static_cast<uint8_t>(caps.address.bus);
+			id.device = static_cast<uint8_t>(caps.address.device);
+			id.function = static_cast<uint8_t>(caps.address.function);
+			id.vfDeviceMemSize = caps.vfDeviceMemSize;
+			continue;
+		}
+
+		// Fallback: get BDF from vfListInfo (index i+1 since index 0 is PF)
+		DBG("VF capabilities API not supported, using LISTVFS fallback for VF {}.\n", i);
+		if (!vfListLoaded && deviceInfo != nullptr) {
+			vfListLoaded = true;
+			if (LISTVFS(deviceInfo, vfListInfo) != 0) {
+				DBG("Failed to get VF list info via LISTVFS.\n");
+			}
+		}
+
+		uint32_t vfListIndex = i + 1;
+		if (vfListIndex < vfListInfo.size()) {
+			const auto &vfInfo = vfListInfo[vfListIndex];
+			// Parse BDF address string (format: "DDDD:BB:DD.F")
+			unsigned int domain = 0, bus = 0, device = 0, function = 0;
+			char colon1 = 0, colon2 = 0, dot = 0;
+			std::istringstream iss(vfInfo.bdfAddress);
+			iss >> std::hex >> domain >> colon1 >> bus >> colon2 >> device >> dot >> function;
+			if (iss && colon1 == ':' && colon2 == ':' && dot == '.') {
+				id.domain = domain;
+				id.bus = static_cast<uint8_t>(bus);
+				id.device = static_cast<uint8_t>(device);
+				id.function = static_cast<uint8_t>(function);
+			} else {
+				DBG("Failed to parse BDF address '{}' for VF {}.\n", vfInfo.bdfAddress.c_str(), i);
+			}
+		}
+	}
+
+	vfIdentityCached = true;
+}
+
+/**
+ * @brief Drops cached VF identities and counter snapshots
+ *
+ * Must be called whenever the set of VFs changes (create/remove), so the
+ * next statistics sample re-resolves VF identities.
+ */
+void vf::invalidateVFStatsCache()
+{
+	vfSampleStates.clear();
+	vfIdentityCached = false;
+}
+
+/**
+ * @brief Takes the starting engine counter snapshot for all enabled VFs
+ *
+ * Resolves VF identities on first use, then records the engine counters that
+ * the next endVFStats() call computes deltas against.
+ *
+ * Note: VFs must be enumerated via init() before calling this function.
+ *
+ * @param[in] deviceInfo Pointer to device info (used for LISTVFS fallback)
+ * @return ze_result_t ZE_RESULT_SUCCESS on success, error code otherwise
+ */
+ze_result_t vf::beginVFStats(DeviceSriovInfo *deviceInfo)
 {
 	TRACING();
 
@@ -380,177 +535,156 @@ ze_result_t vf::getVFStatsList(DeviceSriovInfo *deviceInfo, std::vector<VFStatsI
 		return ZE_RESULT_SUCCESS;
 	}
 
-	// Get VF list info via LISTVFS OAL call (used as fallback if capabilities API fails)
-	std::vector<DeviceSriovInfo> vfListInfo;
-	if (deviceInfo != nullptr) {
-		if (LISTVFS(deviceInfo, vfListInfo) != 0) {
-			DBG("Failed to get VF list info via LISTVFS.\n");
+	cacheVFIdentities(deviceInfo);
+
+	for (uint32_t i = 0; i < vfEnabledCount; i++) {
+		VFSampleState &state = vfSampleStates[i];
+		state.snapshotValid = snapshotVFEngines(vfEnabledHandles[i], state, state.engineSnapshots) == ZE_RESULT_SUCCESS;
+		if (!state.snapshotValid) {
+			DBG("Failed to get engine utilization for VF {}.\n", i);
 		}
 	}
 
-	std::vector<VFSnapshot> snapshots;
-	snapshots.reserve(vfEnabledCount);
+	return ZE_RESULT_SUCCESS;
+}
+
+/**
+ * @brief Takes the ending snapshot for all enabled VFs and computes statistics
+ *
+ * Engine utilization is computed against the snapshot from beginVFStats() or
+ * from the previous endVFStats() call. The ending snapshot then becomes the
+ * starting point of the next sample, so repeated calls stream statistics
+ * without taking a separate starting snapshot.
+ *
+ * @param[out] statsList Reference to a vector to populate with VFStatsInfo structures
+ * @return ze_result_t ZE_RESULT_SUCCESS on successful statistics retrieval, error code otherwise
+ */
+ze_result_t vf::endVFStats(std::vector<VFStatsInfo> &statsList)
+{
+	TRACING();
+
+	statsList.clear();
+	if (vfEnabledCount == 0 || vfEnabledHandles == nullptr || vfSampleStates.size() != vfEnabledCount) {
+		return ZE_RESULT_SUCCESS;
+	}
+
+	statsList.reserve(vfEnabledCount);
+	std::vector<VFEngineSnapshot> endSnapshot;
 
 	for (uint32_t i = 0; i < vfEnabledCount; i++) {
 		zes_vf_handle_t vfHandle = vfEnabledHandles[i];
-		VFSnapshot snap = {};
-		snap.vfHandle = vfHandle;
-		snap.vfId = i + 1; // Default VF ID if capabilities not available
-
-		// Try to get VF capabilities via Sysman API
-		zes_vf_exp2_capabilities_t caps = {};
-		if (getVFCapabilities(vfHandle, &caps) == ZE_RESULT_SUCCESS) {
-			snap.vfId = caps.vfID;
-			snap.domain = caps.address.domain;
-			snap.bus = static_cast<uint8_t>(caps.address.bus);
-			snap.device = static_cast<uint8_t>(caps.address.device);
-			snap.function = static_cast<uint8_t>(caps.address.function);
-			snap.vfDeviceMemSize = caps.vfDeviceMemSize;
-		} else {
-			// Fallback: get BDF from vfListInfo (index i+1 since index 0 is PF)
-			DBG("VF capabilities API not supported, using LISTVFS fallback for VF {}.\n", i);
-			uint32_t vfListIndex = i + 1;
-			if (vfListIndex < vfListInfo.size()) {
-				const auto &vfInfo = vfListInfo[vfListIndex];
-				// Parse BDF address string (format: "DDDD:BB:DD.F")
-				unsigned int domain = 0, bus = 0, device = 0, function = 0;
-				char colon1 = 0, colon2 = 0, dot = 0;
-				std::istringstream iss(vfInfo.bdfAddress);
-				iss >> std::hex >> domain >> colon1 >> bus >> colon2 >> device >> dot >> function;
-				if (iss && colon1 == ':' && colon2 == ':' && dot == '.') {
-					snap.domain = domain;
-					snap.bus = static_cast<uint8_t>(bus);
-					snap.device = static_cast<uint8_t>(device);
-					snap.function = static_cast<uint8_t>(function);
-				} else {
-					DBG("Failed to parse BDF address '{}' for VF {}.\n", vfInfo.bdfAddress.c_str(), i);
-				}
-			}
-		}
+		VFSampleState &state = vfSampleStates[i];
+		VFStatsInfo stats = state.identity;
 
-		// Try to get VF memory utilization
 		zes_vf_util_mem_exp2_t mem = {};
 		if (getVFMemoryUtilization(vfHandle, &mem) == ZE_RESULT_SUCCESS) {
-			snap.memLocation = mem.vfMemLocation;
-			snap.memoryUtilized = mem.vfMemUtilized;
+			stats.memLocation = mem.vfMemLocation;
+			stats.memoryUtilized = mem.vfMemUtilized;
 		} else {
-			snap.memLocation = ZES_MEM_LOC_FORCE_UINT32;
-			snap.memoryUtilized = 0;
-		}
-
-		if (getAllVFEngineUtilization(vfHandle, snap.engineSnapshots) != ZE_RESULT_SUCCESS) {
-			DBG("Failed to get engine utilization for VF {}.\n", i);
+			stats.memLocation = ZES_MEM_LOC_FORCE_UINT32;
+			stats.memoryUtilized = 0;
 		}
 
-		snapshots.push_back(snap);
-	}
-
-	// Wait for metrics interval between snapshots
-	std::this_thread::sleep_for(std::chrono::milliseconds(VF_METRICS_INTERVAL_MS));
-
-	statsList.clear();
-	statsList.reserve(snapshots.size());
-
-	for (auto &snap : snapshots) {
-		VFStatsInfo stats;
-		stats.vfId = snap.vfId;
-		stats.domain = snap.domain;
-		stats.bus = snap.bus;
-		stats.device = snap.device;
-		stats.function = snap.function;
-		stats.vfDeviceMemSize = snap.vfDeviceMemSize;
-		stats.memLocation = snap.memLocation;
-		stats.memoryUtilized = snap.memoryUtilized;
-
-		stats.gpuUtilization = -1.0;
-		stats.computeUtilization = -1.0;
-		stats.renderUtilization = -1.0;
-		stats.mediaUtilization = -1.0;
-		stats.copyUtilization = -1.0;
-
-		// Get second engine utilization snapshot
-		std::vector<VFEngineSnapshot> secondSnapshot;
-		if (getAllVFEngineUtilization(snap.vfHandle, secondSnapshot) != ZE_RESULT_SUCCESS) {
-			DBG("Failed to get second engine snapshot for VF {}.\n", snap.vfId);
+		if (snapshotVFEngines(vfHandle, state, endSnapshot) != ZE_RESULT_SUCCESS) {
+			DBG("Failed to get second engine snapshot for VF {}.\n", stats.vfId);
+			state.snapshotValid = false;
 			statsList.push_back(stats);
 			continue;
 		}
 
-		if (secondSnapshot.size() != snap.engineSnapshots.size()) {
-			DBG("Engine count mismatch for VF {}.\n", snap.vfId);
-			statsList.push_back(stats);
-			continue;
+		if (state.snapshotValid) {
+			computeVFUtilization(state.engineSnapshots, endSnapshot, stats);
 		}
 
-		double maxMedia = -1.0, maxCompute = -1.0, maxRender = -1.0, maxCopy = -1.0;
+		state.engineSnapshots.swap(endSnapshot);
+		state.snapshotValid = true;
+		statsList.push_back(stats);
+	}
 
-		for (size_t j = 0; j < snap.engineSnapshots.size(); j++) {
-			const auto &first = snap.engineSnapshots[j];
-			const auto &second = secondSnapshot[j];
+	DBG("Successfully retrieved stats for {} VFs.\n", statsList.size());
+	return ZE_RESULT_SUCCESS;
+}
 
-			if (first.engineType != second.engineType) {
-				DBG("Engine type mismatch at index {} for VF {}.\n", j, snap.vfId);
-				continue;
-			}
+/**
+ * @brief Gets comprehensive statistics for all enabled Virtual Functions
+ *
+ * This function collects detailed statistics for all enabled VFs on the device,
+ * using a two-snapshot method to calculate accurate engine utilization percentages.
+ * Use vfStatsCollector to sample several devices over one shared window.
+ *
+ * Note: VFs must be enumerated via init() before calling this function.
+ *
+ * @param[in] deviceInfo Pointer to device info (used for LISTVFS fallback)
+ * @param[out] statsList Reference to a vector to populate with VFStatsInfo structures
+ * @return ze_result_t ZE_RESULT_SUCCESS on successful statistics retrieval, error code otherwise
+ */
+ze_result_t vf::getVFStatsList(DeviceSriovInfo *deviceInfo, std::vector<VFStatsInfo> &statsList)
+{
+	TRACING();
 
-			if (second.samplingCounterValue <= first.samplingCounterValue) {
-				DBG("Invalid sampling counter for engine {} on VF {}.\n", first.engineType, snap.vfId);
-				continue;
-			}
+	vfStatsCollector collector;
+	std::vector<std::vector<VFStatsInfo>> statsLists;
+	collector.addDevice(this, deviceInfo != nullptr ? *deviceInfo : DeviceSriovInfo{});
 
-			if (second.activeCounterValue < first.activeCounterValue) {
-				DBG("Active counter wrap detected for engine {} on VF {}.\n", first.engineType, snap.vfId);
-				continue;
-			}
+	ze_result_t result = collector.collect(std::chrono::milliseconds(VF_METRICS_INTERVAL_MS), statsLists);
+	statsList = statsLists.empty() ? std::vector<VFStatsInfo>{} : std::move(statsLists.front());
+	return result;
+}
+
+/**
+ * @brief Registers a physical function whose VFs are sampled by collect()
+ *
+ * @param[in] v VF management object of the physical function
+ * @param[in] deviceInfo Device info of the physical function (used for LISTVFS fallback)
+ */
+void vfStatsCollector::addDevice(vf *v, const DeviceSriovInfo &deviceInfo)
+{
+	targets.emplace_back(v, deviceInfo);
+	primed = false;
+}
 
-			uint64_t activeDelta = second.activeCounterValue - first.activeCounterValue;
-			uint64_t samplingDelta = second.samplingCounterValue - first.samplingCounterValue;
-			double utilPercent = (static_cast<double>(activeDelta) / static_cast<double>(samplingDelta)) * 100.0;
-
-			utilPercent = std::min(utilPercent, 100.0);
-
-			switch (first.engineType) {
-			case ZES_ENGINE_GROUP_MEDIA_DECODE_SINGLE:
-			case ZES_ENGINE_GROUP_MEDIA_ENCODE_SINGLE:
-			case ZES_ENGINE_GROUP_MEDIA_ENHANCEMENT_SINGLE:
-				maxMedia = std::max(maxMedia, utilPercent);
-				break;
-			case ZES_ENGINE_GROUP_COMPUTE_SINGLE:
-				maxCompute = std::max(maxCompute, utilPercent);
-				break;
-			case ZES_ENGINE_GROUP_RENDER_SINGLE:
-				maxRender = std::max(maxRender, utilPercent);
-				break;
-			case ZES_ENGINE_GROUP_COPY_SINGLE:
-				maxCopy = std::max(maxCopy, utilPercent);
-				break;
-			default:
-				DBG("Unknown engine type {} for VF {}.\n", first.engineType, snap.vfId);
-				break;
+/**
+ * @brief Collects statistics for all VFs of all registered physical functions
+ *
+ * On the first call every VF is snapshotted, the collector sleeps once for
+ * @p window and then takes the ending snapshots. Subsequent calls sleep until
+ * @p window after the previous sample and compute deltas from it, giving a
+ * continuous stream with one snapshot per VF per iteration.
+ *
+ * @param[in] window Sample window between the starting and ending snapshots
+ * @param[out] statsLists One VFStatsInfo list per registered device, in registration order
+ * @return ze_result_t ZE_RESULT_SUCCESS if every device was sampled, otherwise the last error
+ */
+ze_result_t vfStatsCollector::collect(std::chrono::milliseconds window, std::vector<std::vector<VFStatsInfo>> &statsLists)
+{
+	TRACING();
+	ze_result_t result = ZE_RESULT_SUCCESS;
+
+	if (!primed) {
+		for (auto &[v, deviceInfo] : targets) {
+			ze_result_t ret = v->beginVFStats(&deviceInfo);
+			if (ret != ZE_RESULT_SUCCESS) {
+				DBG("Failed to take starting VF snapshot for device {}.\n", deviceInfo.bdfAddress.c_str());
+				result = ret;
 			}
 		}
+		lastSample = std::chrono::steady_clock::now();
+		primed = true;
+	}
 
-		stats.mediaUtilization = maxMedia;
-		stats.computeUtilization = maxCompute;
-		stats.renderUtilization = maxRender;
-		stats.copyUtilization = maxCopy;
-
-		double maxOverall = -1.0;
-		if (maxMedia >= 0.0)
-			maxOverall = std::max(maxOverall, maxMedia);
-		if (maxCompute >= 0.0)
-			maxOverall = std::max(maxOverall, maxCompute);
-		if (maxRender >= 0.0)
-			maxOverall = std::max(maxOverall, maxRender);
-		if (maxCopy >= 0.0)
-			maxOverall = std::max(maxOverall, maxCopy);
-		stats.gpuUtilization = maxOverall;
+	std::this_thread::sleep_until(lastSample + window);
+	lastSample = std::chrono::steady_clock::now();
 
-		statsList.push_back(stats);
+	statsLists.resize(targets.size());
+	for (size_t i = 0; i < targets.size(); i++) {
+		ze_result_t ret = targets[i].first->endVFStats(statsLists[i]);
+		if (ret != ZE_RESULT_SUCCESS) {
+			DBG("Failed to get VF statistics for device {}.\n", targets[i].second.bdfAddress.c_str());
+			result = ret;
+		}
 	}
 
-	DBG("Successfully retrieved stats for {} VFs.\n", statsList.size());
-	return ZE_RESULT_SUCCESS;
+	return result;
 }
 
 /**
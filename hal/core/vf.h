@@ -9,15 +9,48 @@
 
 #include "sysman.h"
 #include <osvf.h>
+#include <chrono>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Engine counter snapshot for one engine of a VF
+ */
+struct VFEngineSnapshot
+{
+	zes_engine_group_t engineType;
+	uint64_t activeCounterValue;
+	uint64_t samplingCounterValue;
+};
+
+/**
+ * @brief Per-VF state kept between statistics samples
+ *
+ * Identity (VF ID, BDF, memory quota) is resolved once and reused; the engine
+ * query buffer and the last counter snapshot are reused on every sample.
+ */
+struct VFSampleState
+{
+	VFStatsInfo identity;
+	std::vector<zes_vf_util_engine_exp2_t> engineBuffer;
+	std::vector<VFEngineSnapshot> engineSnapshots;
+	bool snapshotValid = false;
+};
 
 class LIBXPUM_API vf : public sysman
 {
 private:
 	uint32_t vfEnabledCount;
 	zes_vf_handle_t *vfEnabledHandles;
+	std::vector<VFSampleState> vfSampleStates;
+	bool vfIdentityCached;
+
+	void cacheVFIdentities(DeviceSriovInfo *deviceInfo);
+	ze_result_t snapshotVFEngines(zes_vf_handle_t vfHandle, VFSampleState &state,
+								  std::vector<VFEngineSnapshot> &snapshots);
 
 public:
-	vf() : vfEnabledCount(0), vfEnabledHandles(nullptr) {}
+	vf() : vfEnabledCount(0), vfEnabledHandles(nullptr), vfIdentityCached(false) {}
 	~vf();
 	ze_result_t enumEnabledVF(zes_device_handle_t device);
 	ze_result_t getVFCapabilities(zes_vf_handle_t vfHandle, zes_vf_exp2_capabilities_t *outCaps = nullptr);
@@ -27,6 +60,9 @@ public:
 	ze_result_t removeVFs(DeviceSriovInfo *deviceInfo);
 	ze_result_t listVFs(DeviceSriovInfo *deviceInfo, std::vector<DeviceSriovInfo> &vfDeviceInfoList);
 	ze_result_t getVFStatsList(DeviceSriovInfo *deviceInfo, std::vector<VFStatsInfo> &statsList);
+	ze_result_t beginVFStats(DeviceSriovInfo *deviceInfo);
+	ze_result_t endVFStats(std::vector<VFStatsInfo> &statsList);
+	void invalidateVFStatsCache();
 	bool vmxSupport();
 	bool iommuSupport();
 	bool sriovSupport(DeviceSriovInfo *deviceInfo);
@@ -35,4 +71,27 @@ public:
 	ze_result_t zesRun(zes_device_handle_t device) override;
 };
 
+/**
+ * @brief Collects VF statistics for several physical functions in one sample window
+ *
+ * All VFs on all registered PFs are snapshotted, a single sleep covers the
+ * window, and deltas are then computed for every VF. Repeated calls to
+ * collect() continue from the previous end snapshot, so a streaming loop
+ * pays one snapshot per VF per iteration and no extra sleep.
+ */
+class LIBXPUM_API vfStatsCollector
+{
+private:
+	std::vector<std::pair<vf *, DeviceSriovInfo>> targets;
+	std::chrono::steady_clock::time_point lastSample;
+	bool primed;
+
+public:
+	vfStatsCollector() : primed(false) {}
+	void addDevice(vf *v, const DeviceSriovInfo &deviceInfo);
+	size_t deviceCount() const { return targets.size(); }
+	ze_result_t collect(std::chrono::milliseconds window, std::vector<std::vector<VFStatsInfo>> &statsLists);
+	void reset() { primed = false; }
+};
+
 #endif
@@ -159,6 +159,8 @@ int amcupd::amcGetIndex(const std::string &gpuBDF)
  * This function retrieves the serial number and version of the AMC card
  * associated with the specified GPU Bus-Device-Function (BDF) identifier.
  * It ensures that the AMC devices are initialized before querying for information.
+ * The FRU reads are serialized, as the amclib instance is shared by every caller and
+ * is not safe to use from several threads at once.
  *
  * @param gpuBDF The BDF string of the GPU to check (e.g., "0000:00:02.0")
  * @param serialNum Reference to string to receive the serial number
@@ -177,6 +179,7 @@ int amcupd::amcGetCardInfo(std::string gpuBDF, std::string &serialNum, std::stri
 		return -1;
 	}
 
+	std::lock_guard<std::mutex> lock(amcobjMutex);
 	amclib *amc = getAmcObj();
 	ret = amc->amcGetCardInfo(gpuBDF, serialNum, version);
 	return ret;
@@ -6,6 +6,7 @@
 
 #include "gscupd.h"
 #include "fwupd.h"
+#include "mei_registry.h"
 #include <debug.h>
 #include <format>
 #include <fstream>
@@ -98,6 +99,13 @@ ze_result_t gscupd::cmnPreUpdate(firmwareInfo *fwInfo, bool checkType)
 		return ZE_RESULT_ERROR_UNKNOWN;
 	}
 	auto meiPath = p->getMeiDevicePath();
+	if (meiPath.empty()) {
+		// pci::init() ran before the MEI device appeared, e.g. right after a reset
+		MeiRegistry::instance().invalidate();
+		if (auto mei = MeiRegistry::instance().find(p->getBDFStr())) {
+			meiPath = mei->meiDevicePath;
+		}
+	}
 
 	ret = igsc_device_init_by_device(&fwInfo->handle, meiPath.c_str());
 	if (ret) {
@@ -442,41 +450,19 @@ ze_result_t gscupd::updateOpData(firmwareInfo *fwInfo)
 int gscupd::getOpromVersion(const char *bdfStr, igsc_oprom_type type, uint8_t *version, size_t versionSize)
 {
 	TRACING();
-	int ret;
 
-	// Find the MEI device path for this BDF
-	std::vector<pci_addr_mei_device> devices = getPCIAddrAndMeiDevices();
-	std::string meiPath;
-	for (const auto &dev : devices) {
-		// Compare BDF address
-		auto devBdf = std::format("{:04x}:{:02x}:{:02x}.{:01x}", dev.pciProps.address.domain, dev.pciProps.address.bus,
-								  dev.pciProps.address.device, dev.pciProps.address.function);
-		if (devBdf == bdfStr) {
-			meiPath = dev.meiDevicePath;
-			break;
-		}
-	}
-
-	if (meiPath.empty()) {
-		ERR("MEI device not found for BDF {}\n", bdfStr);
-		return -1;
-	}
-
-	// Initialize device handle
-	struct igsc_device_handle handle = {};
-	ret = igsc_device_init_by_device(&handle, meiPath.c_str());
-	if (ret != IGSC_SUCCESS) {
-		ERR("Failed to initialize device for {}: {}\n", bdfStr, ret);
+	// Reuses the handle opened when the MEI devices were enumerated
+	MeiLease lease = MeiRegistry::instance().acquire(bdfStr);
+	if (!lease) {
 		return -1;
 	}
 
 	// Get OPROM version
 	// NOLINTNEXTLINE(readability-identifier-naming) //snake_case required by IGSC
 	struct igsc_oprom_version opromVer = {};
-	ret = igsc_device_oprom_version(&handle, type, &opromVer);
+	int ret = igsc_device_oprom_version(lease.get(), type, &opromVer);
 	if (ret != IGSC_SUCCESS) {
 		ERR("Failed to get OPROM version for {} type {}: {}\n", bdfStr, type, ret);
-		igsc_device_close(&handle);
 		return -1;
 	}
 
@@ -484,7 +470,6 @@ int gscupd::getOpromVersion(const char *bdfStr, igsc_oprom_type type, uint8_t *v
 	size_t copySize = (versionSize < sizeof(opromVer)) ? versionSize : sizeof(opromVer);
 	memcpy(version, &opromVer, copySize);
 
-	igsc_device_close(&handle);
 	return 0;
 }
 
@@ -672,58 +657,6 @@ bool gscupd::isGscRightType(std::vector<char> &buffer, int expectedType)
 	return type == expectedType;
 }
 
-/**
- * @brief Retrieves PCI addresses and MEI device information
- *
- * This function discovers and enumerates all available PCI graphics devices
- * and their corresponding Management Engine Interface (MEI) devices, providing
- * device addressing information required for firmware update operations.
- *
- * @return std::vector<pci_addr_mei_device> Vector containing PCI address and MEI device pairs
- */
-std::vector<pci_addr_mei_device> gscupd::getPCIAddrAndMeiDevices()
-{
-	std::vector<pci_addr_mei_device> devicesVec = {};
-	struct igsc_device_iterator *iter;
-	struct igsc_device_info info;
-	int ret;
-	struct igsc_device_handle handle;
-
-	memset(&handle, 0, sizeof(handle));
-	ret = igsc_device_iterator_create(&iter);
-	if (ret != IGSC_SUCCESS) {
-		ERR("Cannot create device iterator {}\n", ret);
-		return devicesVec;
-	}
-	info.name[0] = '\0';
-	while ((ret = igsc_device_iterator_next(iter, &info)) == IGSC_SUCCESS) {
-		pci_addr_mei_device pciAddrMeiDevice = {};
-
-		ret = igsc_device_init_by_device_info(&handle, &info);
-		if (ret != IGSC_SUCCESS) {
-			/* make sure we have a printable name */
-			info.name[0] = '\0';
-			continue;
-		}
-
-		pciAddrMeiDevice.fwStatus = igsc_translate_firmware_status(igsc_get_last_firmware_status(&handle));
-		// If fwStatus is "Success", change it to "normal"
-		if (pciAddrMeiDevice.fwStatus == "Success") {
-			pciAddrMeiDevice.fwStatus = "normal";
-		}
-		pciAddrMeiDevice.pciProps.address.domain = info.domain;
-		pciAddrMeiDevice.pciProps.address.bus = info.bus;
-		pciAddrMeiDevice.pciProps.address.device = info.dev;
-		pciAddrMeiDevice.pciProps.address.function = info.func;
-		pciAddrMeiDevice.meiDevicePath = info.name;
-		devicesVec.push_back(pciAddrMeiDevice);
-
-		(void)igsc_device_close(&handle);
-	}
-	igsc_device_iterator_destroy(iter);
-	return devicesVec;
-}
-
 /**
  * @brief Retrieves Graphics Firmware status from MEI device
  *
@@ -67,7 +67,6 @@ public:
 	ze_result_t updateOprom(firmwareInfo *fwInfo, igsc_oprom_type type);
 	int getOpromVersion(const char *bdfStr, igsc_oprom_type type, uint8_t *version, size_t versionSize);
 	bool isGscRightType(std::vector<char> &buffer, int expectedType);
-	std::vector<pci_addr_mei_device> getPCIAddrAndMeiDevices();
 	GfxFwStatus getGfxFwStatus(std::string meiPath);
 	int firmware_check_hw_config(struct igsc_device_handle *handle, std::vector<char> &buffer);
 	const char *transGfxFwStatusToString(GfxFwStatus status);
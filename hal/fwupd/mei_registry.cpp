@@ -0,0 +1,261 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "mei_registry.h"
+#include "gscupd.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <debug.h>
+#include <format>
+#include <fstream>
+#include <utility>
+
+/**
+ * @brief igsc handle and identity of one GSC MEI device
+ */
+struct meiSlot
+{
+	pci_addr_mei_device device;
+	std::string bdf;
+	std::mutex mutex; ///< Held by the MeiLease of the handle
+	igsc_device_handle handle = {};
+	bool open = false;
+
+	meiSlot() = default;
+	meiSlot(const meiSlot &) = delete;
+	meiSlot &operator=(const meiSlot &) = delete;
+
+	~meiSlot()
+	{
+		if (open) {
+			(void)igsc_device_close(&handle);
+		}
+	}
+};
+
+std::string meiBdfString(const zes_pci_address_t &address)
+{
+	return std::format("{:04x}:{:02x}:{:02x}.{:01x}", address.domain, address.bus, address.device, address.function);
+}
+
+namespace {
+
+/**
+ * @brief Parses "dddd:bb:dd.f" into @p address
+ */
+bool parseBdf(const std::string &text, zes_pci_address_t &address)
+{
+	unsigned int domain, bus, device, function;
+	char end;
+	if (sscanf(text.c_str(), "%4x:%2x:%2x.%1x%c", &domain, &bus, &device, &function, &end) != 4) {
+		return false;
+	}
+	address.domain = domain;
+	address.bus = bus;
+	address.device = device;
+	address.function = function;
+	return true;
+}
+
+/**
+ * @brief Decodes the first fw_status register the way gscupd::getGfxFwStatus() does
+ */
+std::string sysfsFwStatus(const std::filesystem::path &fwStatusPath)
+{
+	std::ifstream file(fwStatusPath);
+	std::string value;
+	if (!(file >> value)) {
+		return "unknown";
+	}
+
+	unsigned long reg;
+	try {
+		reg = std::stoul(value, nullptr, 16);
+	} catch (const std::exception &) {
+		return "unknown";
+	}
+
+	const auto status = static_cast<GfxFwStatus>(std::min<unsigned long>(reg & 0xf, GfxFwStatus::UNKNOWN));
+	if (status == GfxFwStatus::NORMAL) {
+		return "normal";
+	}
+	std::string name = gscupd().transGfxFwStatusToString(status);
+	std::ranges::transform(name, name.begin(), [](unsigned char c) { return std::tolower(c); });
+	return name;
+}
+
+} // namespace
+
+MeiRegistry &MeiRegistry::instance()
+{
+	static MeiRegistry registry;
+	return registry;
+}
+
+void MeiRegistry::setSource(Source source)
+{
+	std::scoped_lock lock(mMutex);
+	if (source != mSource) {
+		mSource = source;
+		mSlots.clear();
+		mScanned = false;
+	}
+}
+
+std::vector<pci_addr_mei_device> MeiRegistry::scanSysfs(const std::filesystem::path &root)
+{
+	namespace fs = std::filesystem;
+	std::vector<pci_addr_mei_device> devices;
+	std::error_code ec;
+
+	for (const auto &entry : fs::directory_iterator(root / "class" / "mei", ec)) {
+		// The parent of a GSC MEI device is the "<driver>.mei-gscfi.<n>" auxiliary device
+		// of the GPU; that of the chipset CSME is a PCI device of its own.
+		const fs::path parent = fs::canonical(entry.path() / "device", ec);
+		if (ec || parent.filename().string().find("mei-gscfi") == std::string::npos) {
+			ec.clear();
+			continue;
+		}
+
+		pci_addr_mei_device device = {};
+		if (!parseBdf(parent.parent_path().filename().string(), device.pciProps.address)) {
+			DBG("No PCI parent for {}\n", parent.string());
+			continue;
+		}
+		device.meiDevicePath = "/dev/" + entry.path().filename().string();
+		device.fwStatus = sysfsFwStatus(entry.path() / "fw_status");
+		devices.push_back(std::move(device));
+	}
+
+	// directory_iterator order is unspecified; list mei2 before mei10 like igsc does
+	std::ranges::sort(devices, {}, [](const auto &d) { return std::pair(d.meiDevicePath.size(), d.meiDevicePath); });
+	return devices;
+}
+
+/**
+ * @brief Enumerates the devices once; must be called with mMutex held
+ *
+ * With the igsc iterator every device is opened exactly once, to read its firmware
+ * status, and the handle is kept for acquire().
+ */
+void MeiRegistry::scanLocked()
+{
+	TRACING();
+	if (mScanned) {
+		return;
+	}
+	mScanned = true;
+
+	struct igsc_device_iterator *iter = nullptr;
+	int ret = IGSC_ERROR_NOT_SUPPORTED;
+	if (mSource == Source::IGSC) {
+		ret = igsc_device_iterator_create(&iter);
+		if (ret != IGSC_SUCCESS) {
+			ERR("Cannot create device iterator {}, falling back to sysfs\n", ret);
+		}
+	}
+
+	if (ret != IGSC_SUCCESS) {
+		for (auto &device : scanSysfs()) {
+			auto slot = std::make_shared<meiSlot>();
+			slot->bdf = meiBdfString(device.pciProps.address);
+			slot->device = std::move(device);
+			mSlots.push_back(std::move(slot));
+		}
+		return;
+	}
+
+	struct igsc_device_info info;
+	info.name[0] = '\0';
+	while (igsc_device_iterator_next(iter, &info) == IGSC_SUCCESS) {
+		auto slot = std::make_shared<meiSlot>();
+		if (igsc_device_init_by_device_info(&slot->handle, &info) != IGSC_SUCCESS) {
+			/* make sure we have a printable name */
+			info.name[0] = '\0';
+			continue;
+		}
+		slot->open = true;
+
+		pci_addr_mei_device &device = slot->device;
+		device.fwStatus = igsc_translate_firmware_status(igsc_get_last_firmware_status(&slot->handle));
+		// If fwStatus is "Success", change it to "normal"
+		if (device.fwStatus == "Success") {
+			device.fwStatus = "normal";
+		}
+		device.pciProps.address.domain = info.domain;
+		device.pciProps.address.bus = info.bus;
+		device.pciProps.address.device = info.dev;
+		device.pciProps.address.function = info.func;
+		device.meiDevicePath = info.name;
+		slot->bdf = meiBdfString(device.pciProps.address);
+		mSlots.push_back(std::move(slot));
+	}
+	igsc_device_iterator_destroy(iter);
+}
+
+std::shared_ptr<meiSlot> MeiRegistry::findLocked(std::string_view bdf)
+{
+	scanLocked();
+	auto it = std::ranges::find(mSlots, bdf, [](const auto &slot) { return std::string_view(slot->bdf); });
+	return it == mSlots.end() ? nullptr : *it;
+}
+
+std::optional<pci_addr_mei_device> MeiRegistry::find(std::string_view bdf)
+{
+	std::scoped_lock lock(mMutex);
+	auto slot = findLocked(bdf);
+	if (!slot) {
+		return std::nullopt;
+	}
+	return slot->device;
+}
+
+std::vector<pci_addr_mei_device> MeiRegistry::devices()
+{
+	std::scoped_lock lock(mMutex);
+	scanLocked();
+	std::vector<pci_addr_mei_device> result;
+	result.reserve(mSlots.size());
+	for (const auto &slot : mSlots) {
+		result.push_back(slot->device);
+	}
+	return result;
+}
+
+MeiLease MeiRegistry::acquire(std::string_view bdf)
+{
+	std::shared_ptr<meiSlot> slot;
+	{
+		std::scoped_lock lock(mMutex);
+		slot = findLocked(bdf);
+	}
+	if (!slot) {
+		ERR("MEI device not found for BDF {}\n", bdf);
+		return {};
+	}
+
+	MeiLease lease;
+	lease.mLock = std::unique_lock(slot->mutex);
+	if (!slot->open) {
+		int ret = igsc_device_init_by_device(&slot->handle, slot->device.meiDevicePath.c_str());
+		if (ret != IGSC_SUCCESS) {
+			ERR("Failed to initialize device for {}: {}\n", bdf, ret);
+			return {};
+		}
+		slot->open = true;
+	}
+	lease.mHandle = &slot->handle;
+	lease.mSlot = std::move(slot);
+	return lease;
+}
+
+void MeiRegistry::invalidate()
+{
+	std::scoped_lock lock(mMutex);
+	mSlots.clear();
+	mScanned = false;
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef _MEI_REGISTRY_H
+#define _MEI_REGISTRY_H
+
+#include <filesystem>
+#include <igsc_lib.h>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <pci.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct meiSlot;
+
+/**
+ * @brief Exclusive use of the igsc handle of one GSC MEI device
+ *
+ * igsc handles are not thread safe; the device stays locked for as long as the lease
+ * lives. An empty lease (no MEI device for the BDF, or the handle failed to initialize)
+ * converts to false.
+ */
+class MeiLease
+{
+public:
+	MeiLease() = default;
+
+	[[nodiscard]] igsc_device_handle *get() const { return mHandle; }
+	explicit operator bool() const { return mHandle != nullptr; }
+
+private:
+	friend class MeiRegistry;
+	std::shared_ptr<meiSlot> mSlot; ///< Keeps the handle alive across MeiRegistry::invalidate()
+	std::unique_lock<std::mutex> mLock;
+	igsc_device_handle *mHandle = nullptr;
+};
+
+/**
+ * @brief Process-wide map of GPU BDF to its GSC MEI device
+ *
+ * The GSC MEI devices are enumerated once, on first use, and the result is shared by
+ * pci::init(), discovery and firmware update instead of every caller walking the igsc
+ * iterator again. The igsc handle opened for a device during enumeration is kept and
+ * lent out through acquire(), so each device is opened once per process.
+ *
+ * Enumeration uses the igsc device iterator, or only /sys/class/mei when the source is
+ * set to SYSFS; the latter opens no MEI device at all and is also the fallback when the
+ * iterator cannot be created.
+ */
+class MeiRegistry
+{
+public:
+	enum class Source : uint8_t
+	{
+		IGSC,  ///< igsc device iterator; status is the last igsc firmware status
+		SYSFS, ///< /sys/class/mei only; status is decoded from fw_status
+	};
+
+	static MeiRegistry &instance();
+
+	/** @brief Selects how the next enumeration finds devices; drops the current one */
+	void setSource(Source source);
+
+	/** @brief MEI device of the GPU at @p bdf ("dddd:bb:dd.f") */
+	[[nodiscard]] std::optional<pci_addr_mei_device> find(std::string_view bdf);
+
+	/** @brief All GSC MEI devices */
+	[[nodiscard]] std::vector<pci_addr_mei_device> devices();
+
+	/**
+	 * @brief Lends the igsc handle of the MEI device of @p bdf
+	 *
+	 * The handle is initialized on first use and reused afterwards. Callers must not
+	 * close it.
+	 */
+	[[nodiscard]] MeiLease acquire(std::string_view bdf);
+
+	/**
+	 * @brief Forgets all devices so that the next call enumerates again
+	 *
+	 * For after a firmware update or reset, which can change firmware status or MEI
+	 * numbering. Handles still lent out stay valid until their lease ends.
+	 */
+	void invalidate();
+
+	/**
+	 * @brief Enumerates GSC MEI devices from sysfs
+	 *
+	 * @param root Directory standing in for /sys, for tests
+	 */
+	static std::vector<pci_addr_mei_device> scanSysfs(const std::filesystem::path &root = "/sys");
+
+	MeiRegistry(const MeiRegistry &) = delete;
+	MeiRegistry &operator=(const MeiRegistry &) = delete;
+
+private:
+	MeiRegistry() = default;
+	~MeiRegistry() = default;
+
+	void scanLocked();
+	std::shared_ptr<meiSlot> findLocked(std::string_view bdf);
+
+	std::mutex mMutex;
+	Source mSource = Source::IGSC;
+	bool mScanned = false;
+	std::vector<std::shared_ptr<meiSlot>> mSlots;
+};
+
+/** @brief Formats @p address the way pci::getBDFStr() does */
+std::string meiBdfString(const zes_pci_address_t &address);
+
+#endif
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ * Unit tests for mei_registry.cpp
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#ifdef INFO
+#undef INFO
+#endif
+
+#include "fake_sysfs.h"
+#include "mei_registry.h"
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+/// A /sys look-alike with /sys/class/mei entries linking to their parent devices.
+class FakeSysfs : public FakeSysfsRoot
+{
+public:
+	FakeSysfs() : FakeSysfsRoot("mei_registry_test") { fs::create_directories(root / "class" / "mei"); }
+
+	/// Adds /sys/class/mei/<mei> whose device link points to devices/<parent>.
+	void addMei(const std::string &mei, const std::string &parent, const std::string &fwStatus)
+	{
+		const fs::path device = root / "devices" / parent;
+		fs::create_directories(device);
+		const fs::path dir = root / "class" / "mei" / mei;
+		fs::create_directories(dir);
+		fs::create_directory_symlink(fs::relative(device, dir), dir / "device");
+		std::ofstream(dir / "fw_status") << fwStatus << "\n00000000\n";
+	}
+};
+
+} // namespace
+
+TEST_CASE("scanSysfs finds GSC MEI devices and their GPUs")
+{
+	FakeSysfs sysfs;
+	sysfs.addMei("mei0", "pci0000:00/0000:00:16.0", "90000255"); // chipset CSME
+	sysfs.addMei("mei10", "pci0000:00/0000:00:01.0/0000:4d:00.0/xe.mei-gscfi.19712", "80000242");
+	sysfs.addMei("mei2", "pci0000:00/0000:00:01.0/0000:03:00.0/i915.mei-gscfi.768", "80000245");
+
+	const auto devices = MeiRegistry::scanSysfs(sysfs.root);
+
+	REQUIRE(devices.size() == 2);
+	CHECK(devices[0].meiDevicePath == "/dev/mei2");
+	CHECK(meiBdfString(devices[0].pciProps.address) == "0000:03:00.0");
+	CHECK(devices[0].fwStatus == "normal");
+	CHECK(devices[1].meiDevicePath == "/dev/mei10");
+	CHECK(meiBdfString(devices[1].pciProps.address) == "0000:4d:00.0");
+	CHECK(devices[1].fwStatus == "recovery");
+}
+
+TEST_CASE("scanSysfs tolerates missing and malformed entries")
+{
+	FakeSysfs sysfs;
+	CHECK(MeiRegistry::scanSysfs(sysfs.root / "nonexistent").empty());
+
+	sysfs.addMei("mei1", "platform/i915.mei-gscfi.1", "80000245"); // no PCI parent
+	sysfs.addMei("mei3", "pci0000:00/0000:05:00.0/i915.mei-gscfi.1280", "garbage");
+	fs::create_directories(sysfs.root / "class" / "mei" / "mei4"); // no device link
+
+	const auto devices = MeiRegistry::scanSysfs(sysfs.root);
+
+	REQUIRE(devices.size() == 1);
+	CHECK(meiBdfString(devices[0].pciProps.address) == "0000:05:00.0");
+	CHECK(devices[0].fwStatus == "unknown");
+}
+
+TEST_CASE("meiBdfString matches pci::getBDFStr")
+{
+	zes_pci_address_t address = {};
+	address.domain = 1;
+	address.bus = 0x3a;
+	address.device = 2;
+	address.function = 1;
+	CHECK(meiBdfString(address) == "0001:3a:02.1");
+}
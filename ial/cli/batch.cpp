@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "batch.h"
+#include <nlohmann/json.hpp>
+
+std::optional<std::vector<std::string>> splitBatchLine(std::string_view line)
+{
+	std::vector<std::string> words;
+	std::string word;
+	bool inWord = false;
+	char quote = 0;
+
+	for (size_t i = 0; i < line.size(); ++i) {
+		const char c = line[i];
+		if (quote == '\'') {
+			if (c == '\'') {
+				quote = 0;
+			} else {
+				word.push_back(c);
+			}
+		} else if (quote == '"') {
+			if (c == '"') {
+				quote = 0;
+			} else if (c == '\\' && i + 1 < line.size() && (line[i + 1] == '"' || line[i + 1] == '\\')) {
+				word.push_back(line[++i]);
+			} else {
+				word.push_back(c);
+			}
+		} else if (c == ' ' || c == '\t' || c == '\r') {
+			if (inWord) {
+				words.push_back(std::move(word));
+				word.clear();
+				inWord = false;
+			}
+		} else {
+			inWord = true;
+			if (c == '\'' || c == '"') {
+				quote = c;
+			} else if (c == '\\' && i + 1 < line.size()) {
+				word.push_back(line[++i]);
+			} else {
+				word.push_back(c);
+			}
+		}
+	}
+	if (quote != 0) {
+		return std::nullopt;
+	}
+	if (inWord) {
+		words.push_back(std::move(word));
+	}
+	return words;
+}
+
+std::string batchFrame(size_t id, std::string_view command, int exitCode, const std::string &output)
+{
+	nlohmann::ordered_json frame;
+	frame["id"] = id;
+	frame["command"] = command;
+	frame["exit_code"] = exitCode;
+
+	// Only a whole object or array counts as JSON output; text such as "0" would parse too
+	auto parsed = nlohmann::ordered_json::parse(output, nullptr, false);
+	if (!parsed.is_discarded() && (parsed.is_object() || parsed.is_array())) {
+		frame["format"] = "json";
+		frame["output"] = std::move(parsed);
+	} else {
+		frame["format"] = "text";
+		frame["output"] = output;
+	}
+	// Text is passed through as the command printed it; invalid UTF-8 must not end the batch
+	return frame.dump(-1, ' ', false, nlohmann::ordered_json::error_handler_t::replace);
+}
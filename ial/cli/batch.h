@@ -0,0 +1,36 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef _BATCH_H
+#define _BATCH_H
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Splits one line of a --batch script into arguments
+ *
+ * Words are separated by blanks. Single quotes keep everything up to the next single
+ * quote; double quotes keep everything up to the next double quote except that a
+ * backslash escapes '"' and '\'; outside quotes a backslash escapes any character.
+ *
+ * @return std::optional<std::vector<std::string>> The arguments, or nullopt when a quote
+ *         is left open
+ */
+std::optional<std::vector<std::string>> splitBatchLine(std::string_view line);
+
+/**
+ * @brief Builds the single-line JSON frame that reports one command of a batch
+ *
+ * {"id": <n>, "command": <line>, "exit_code": <rc>, "format": "json"|"text", "output": ...}
+ * where output is the JSON document the command printed, or its text when it printed
+ * anything else.
+ */
+std::string batchFrame(size_t id, std::string_view command, int exitCode, const std::string &output);
+
+#endif // _BATCH_H
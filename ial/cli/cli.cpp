@@ -19,10 +19,13 @@
 #include <cmd_updatefw.h>
 #include <cmd_vgpu.h>
 #include <debug.h>
+#include <fstream>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <os.h>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <format>
 #include "logger/filestream_sink.h"
@@ -103,6 +106,125 @@ void setPrintLvl(arg_struct *arg, LogLevel lvl)
 	arg->sm.setPrintLvl(lvl);
 }
 
+/**
+ * @brief Applies --housekeeping-cpus=<list> and removes it from argv
+ *
+ * Handled before the driver is initialized so that its threads, like every other thread of
+ * xpu-smi, start inside the housekeeping set. Threads working on one device are later pinned
+ * to the part of that set local to the device, and return to the set when done. The set
+ * is not undone: it applies to the whole invocation, including every command of --batch,
+ * because the driver's threads started inside it.
+ *
+ * @param argc Number of command-line arguments; reduced when the option is removed
+ * @param argv Command-line arguments; the option and its value are removed
+ * @return false when the option is malformed or the set cannot be applied
+ */
+bool applyHousekeepingCpus(int &argc, char *argv[])
+{
+	constexpr std::string_view flag = "--housekeeping-cpus";
+	std::optional<std::string_view> cpuList;
+	int kept = 1;
+	for (int i = 1; i < argc; ++i) {
+		const std::string_view a{argv[i]};
+		if (a == flag) {
+			if (i + 1 >= argc) {
+				ERR("Error: {} requires a CPU list, e.g. {}=0-3.\n", flag, flag);
+				return false;
+			}
+			cpuList = argv[++i];
+		} else if (a.starts_with(flag) && a[flag.size()] == '=') {
+			cpuList = a.substr(flag.size() + 1);
+		} else {
+			argv[kept++] = argv[i];
+		}
+	}
+	argc = kept;
+	argv[argc] = nullptr;
+
+	if (cpuList && is_windows) {
+		ERR("Error: {} is not supported on this platform.\n", flag);
+		return false;
+	}
+	if (cpuList && !RESTRICT_PROCESS_CPUS(*cpuList)) {
+		ERR("Error: Invalid or unusable CPU list '{}' for {}.\n", *cpuList, flag);
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Tells whether argv asks for batch mode: --batch [<file>|-] or --batch=<file>
+ */
+bool isBatchMode(int argc, char *argv[])
+{
+	if (argc < 2) {
+		return false;
+	}
+	const std::string_view a{argv[1]};
+	return a == "--batch" || a.starts_with("--batch=");
+}
+
+/**
+ * @brief Tells whether argv asks only for recorded metrics: dump --replay or stats --since,
+ *        which are read from the metric store without the driver
+ */
+bool readsMetricStoreOnly(int argc, char *argv[])
+{
+	if (argc < 2) {
+		return false;
+	}
+	const std::string_view cmd{argv[1]};
+	std::string_view flag;
+	if (cmd == "dump" || cmd == "dmon") {
+		flag = "--replay";
+	} else if (cmd == "stats") {
+		flag = "--since";
+	} else {
+		return false;
+	}
+	for (int i = 2; i < argc; ++i) {
+		const std::string_view a{argv[i]};
+		if (a == flag || (a.starts_with(flag) && a[flag.size()] == '=')) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * @brief Runs the commands of a batch file, or of stdin for "-" or no file, against the
+ *        driver and devices main() initialized, reporting each as one JSON line
+ *
+ * @return Exit code: 0 when every command succeeded, 1 when one failed or the file
+ *         cannot be read, 2 for a malformed --batch option
+ */
+int runBatchMode(DefaultParser &parser, arg_struct *arg, OSTYPE currentOS, int argc, char *argv[])
+{
+	constexpr std::string_view flag = "--batch";
+	const std::string_view a{argv[1]};
+	const bool inlineSource = a.starts_with("--batch=");
+	std::string source = "-";
+	if (inlineSource) {
+		source = a.substr(flag.size() + 1);
+	} else if (argc == 3) {
+		source = argv[2];
+	}
+	if (argc > (inlineSource ? 2 : 3) || source.empty()) {
+		ERR("Error: Usage: {} --batch [<file>|-]\n", parser.progName());
+		return 2;
+	}
+
+	if (source == "-") {
+		return runBatch(parser, arg, currentOS, std::cin);
+	}
+	std::ifstream file(source);
+	if (!file) {
+		ERR("Error: Cannot open batch file '{}'.\n", source);
+		return 1;
+	}
+	return runBatch(parser, arg, currentOS, file);
+}
+
 /**
  * @brief Main entry point for the application
  * @param argc Number of command-line arguments
@@ -117,18 +239,25 @@ int main(int argc, char *argv[])
 	bool priv = PRIVILEGECHECK();
 	UNUSED_VAR(priv);
 
+	if (!applyHousekeepingCpus(argc, argv)) {
+		return 1;
+	}
+
 	if (dbglvl < LogLevel::DBG) {
 		setPrintLvl(&arg, LogLevel::NO_PRINT);
 	}
 
-	ze_result_t result = arg.sm.init();
-	switch (result) {
-	case ZE_RESULT_SUCCESS:
-		DBG("Sysman driver initialized successfully.\n");
-		break;
-	default:
-		PRINT("Sysman driver initialization failed.\n");
-		return -1;
+	// Recorded metrics are answered from the metric store, also on nodes whose driver is down
+	if (!readsMetricStoreOnly(argc, argv)) {
+		ze_result_t result = arg.sm.init();
+		switch (result) {
+		case ZE_RESULT_SUCCESS:
+			DBG("Sysman driver initialized successfully.\n");
+			break;
+		default:
+			PRINT("Sysman driver initialization failed.\n");
+			return -1;
+		}
 	}
 
 	setPrintLvl(&arg, dbglvl);
@@ -145,6 +274,11 @@ int main(int argc, char *argv[])
 	arg.argv = argv;
 	DefaultParser parser;
 
+	// Batch mode runs many commands against the driver initialized above
+	if (isBatchMode(argc, argv)) {
+		return runBatchMode(parser, &arg, currentOS, argc, argv);
+	}
+
 	// Configure file logging for DefaultParser if -f/--file option was provided
 	// Note: the logFilePath will be set during handleTopLevel() in runCli(),
 	// but we need a hook to configure the sink after parsing.
@@ -6,12 +6,17 @@
 #ifndef _CLI_PARSER_H
 #define _CLI_PARSER_H
 
+#include "../batch.h"
 #include "../cli.h"
 #include <debug.h>
+#include <os.h>
 #include <algorithm>
+#include <exception>
+#include <iostream>
 #include <memory>
 #include <optional>
 #include <ranges>
+#include <sstream>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -89,16 +94,13 @@ template <CliParser P> void printFullHelp(P &parser, const std::vector<std::uniq
 	printSubCommands(cmdList);
 }
 
-// ---- Shared: full dispatch loop -----------------------------------------
-// All parser variants share this loop. The only runtime variation is in
-// handleTopLevel() and commandTable(), which each parser implements itself.
-template <CliParser P> int runCli(P &parser, arg_struct *args, OSTYPE currentOS)
+// ---- Shared: run one command line --------------------------------------
+// Runs args against an already built dispatch table; used once by runCli and
+// once per line by runBatch.
+template <CliParser P>
+int runCommand(P &parser, arg_struct *args, const std::vector<std::unique_ptr<cmds>> &cmdList,
+			   const std::unordered_map<std::string_view, cmds *> &dispatchMap)
 {
-	// Keep the global in sync so command help text uses the right name.
-	progName = std::string{parser.progName()};
-
-	auto [cmdList, dispatchMap] = buildDispatch(parser, currentOS);
-
 	// Let the parser handle flags, "help" keyword, and no-arg default.
 	if (auto rc = parser.handleTopLevel(args, cmdList); rc.has_value()) {
 		return *rc;
@@ -131,4 +133,102 @@ template <CliParser P> int runCli(P &parser, arg_struct *args, OSTYPE currentOS)
 	return 2;
 }
 
+// ---- Shared: full dispatch loop -----------------------------------------
+// All parser variants share this loop. The only runtime variation is in
+// handleTopLevel() and commandTable(), which each parser implements itself.
+template <CliParser P> int runCli(P &parser, arg_struct *args, OSTYPE currentOS)
+{
+	// Keep the global in sync so command help text uses the right name.
+	progName = std::string{parser.progName()};
+
+	auto [cmdList, dispatchMap] = buildDispatch(parser, currentOS);
+	return runCommand(parser, args, cmdList, dispatchMap);
+}
+
+// ---- Shared: batch mode -------------------------------------------------
+// Runs one command line per line of input against the driver and devices the
+// caller initialized once; see splitBatchLine() for the quoting rules. Blank
+// lines and lines starting with '#' are skipped, and a leading program name is
+// optional. Everything a command prints to stdout, through PRINT() or
+// std::cout, is captured and reported in one batchFrame() line as soon as the
+// command returns; diagnostics still go to stderr. Commands read no input: a
+// confirmation prompt sees end of file, and with batchMode set no command starts
+// a keyboard reader or accepts options that loop until stopped.
+//
+// Every line starts from the same state: it gets fresh command objects, so no
+// option of one line leaks into the next, and the log sinks and level are put
+// back afterwards, undoing e.g. -f. The cached PCI topology is reloaded on first
+// use. What carries over is what the caller set up once: the driver, its device
+// handles and the HAL's caches of them.
+//
+// Returns 0 when every command succeeded, 1 otherwise.
+template <CliParser P> int runBatch(P &parser, arg_struct *args, OSTYPE currentOS, std::istream &input)
+{
+	progName = std::string{parser.progName()};
+
+	const auto stdoutSink = Logger::instance().getPrintSink();
+	const auto diagnosticSink = Logger::instance().getSink();
+	const auto level = getDbgLvl();
+	size_t id = 0;
+	bool failed = false;
+	std::string line;
+	batchMode = true;
+	while (std::getline(input, line)) {
+		auto words = splitBatchLine(line);
+		if (words && (words->empty() || words->front().starts_with('#'))) {
+			continue;
+		}
+		++id;
+		if (!words) {
+			PRINT("{}\n", batchFrame(id, line, 2, "Unterminated quote.\n"));
+			failed = true;
+			continue;
+		}
+		if (words->front() == parser.progName()) {
+			words->erase(words->begin());
+		}
+		if (std::ranges::any_of(*words, [](const std::string &w) { return w.starts_with("--batch"); })) {
+			PRINT("{}\n", batchFrame(id, line, 2, "--batch cannot be used inside a batch.\n"));
+			failed = true;
+			continue;
+		}
+
+		std::vector<std::string> argStorage{progName};
+		argStorage.insert(argStorage.end(), words->begin(), words->end());
+		std::vector<char *> argv;
+		for (auto &arg : argStorage) {
+			argv.push_back(arg.data());
+		}
+		argv.push_back(nullptr);
+		args->argc = static_cast<int>(argStorage.size());
+		args->argv = argv.data();
+
+		// Devices may have been reset, hot-plugged or had VFs changed since the last line
+		INVALIDATE_TOPOLOGY_CACHES();
+		auto [cmdList, dispatchMap] = buildDispatch(parser, currentOS);
+		std::ostringstream output;
+		std::istringstream noInput;
+		Logger::instance().setPrintSink(std::make_shared<OStreamSink>(output));
+		auto *const stdoutBuf = std::cout.rdbuf(output.rdbuf());
+		auto *const stdinBuf = std::cin.rdbuf(noInput.rdbuf());
+		int rc = 1;
+		try {
+			rc = runCommand(parser, args, cmdList, dispatchMap);
+		} catch (const std::exception &e) {
+			ERR("{}\n", e.what());
+		}
+		std::cout.flush();
+		std::cin.rdbuf(stdinBuf);
+		std::cout.rdbuf(stdoutBuf);
+		Logger::instance().setSink(diagnosticSink);
+		Logger::instance().setPrintSink(stdoutSink);
+		setDbgLvl(level);
+
+		PRINT("{}\n", batchFrame(id, line, rc, output.str()));
+		failed = failed || rc != 0;
+	}
+	batchMode = false;
+	return failed ? 1 : 0;
+}
+
 #endif // _CLI_PARSER_H
@@ -256,6 +256,9 @@ void DefaultParser::printExtraOptions()
 	PRINT("  --count=<n>                 Number of loop iterations (default: infinite)\n");
 	PRINT("  --format=csv[,noheader][,nounits]  Output format for --query-gpu\n");
 	PRINT("  -f,--file=<path>            Log output to file instead of stdout\n");
+	PRINT("  --housekeeping-cpus=<list>  Run all xpu-smi threads on these CPUs, e.g. 0-3,8, for the whole\n");
+	PRINT("                              invocation including every --batch command (Linux only)\n");
+	PRINT("  --batch [<file>|-]          Run one command per line of <file> or stdin, reporting each as a JSON line\n");
 }
 
 std::optional<int> DefaultParser::handleTopLevel(arg_struct *args, const std::vector<std::unique_ptr<cmds>> &cmdList)
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ * Unit tests for batch.cpp: splitting --batch lines into arguments and framing results
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include "batch.h"
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+using Words = std::vector<std::string>;
+
+TEST_CASE("splitBatchLine separates words on blanks")
+{
+	CHECK(splitBatchLine("discovery -j") == Words{"discovery", "-j"});
+	CHECK(splitBatchLine("  stats\t-d  0 \r") == Words{"stats", "-d", "0"});
+}
+
+TEST_CASE("splitBatchLine returns no words for empty and blank lines")
+{
+	CHECK(splitBatchLine("") == Words{});
+	CHECK(splitBatchLine("   \t\r") == Words{});
+}
+
+TEST_CASE("splitBatchLine keeps quoted text as one word")
+{
+	CHECK(splitBatchLine("config -d 0 --name 'a b \"c\"'") == Words{"config", "-d", "0", "--name", "a b \"c\""});
+	CHECK(splitBatchLine("echo \"it's here\"") == Words{"echo", "it's here"});
+	CHECK(splitBatchLine("pre'quoted'post") == Words{"prequotedpost"});
+	CHECK(splitBatchLine("'' \"\"") == Words{"", ""});
+}
+
+TEST_CASE("splitBatchLine handles backslash escapes")
+{
+	// Outside quotes a backslash escapes any character
+	CHECK(splitBatchLine(R"(a\ b \'c\' \\)") == Words{"a b", "'c'", "\\"});
+	// Inside double quotes only '"' and '\' are escaped
+	CHECK(splitBatchLine(R"("a\"b\\c\d")") == Words{R"(a"b\c\d)"});
+	// Inside single quotes nothing is escaped
+	CHECK(splitBatchLine(R"('a\b')") == Words{R"(a\b)"});
+	// A trailing backslash is kept as is
+	CHECK(splitBatchLine(R"(end\)") == Words{R"(end\)"});
+}
+
+TEST_CASE("splitBatchLine rejects an unterminated quote")
+{
+	CHECK_FALSE(splitBatchLine("config --name 'open").has_value());
+	CHECK_FALSE(splitBatchLine("config --name \"open").has_value());
+	CHECK_FALSE(splitBatchLine(R"("escaped\")").has_value());
+}
+
+TEST_CASE("batchFrame embeds JSON output as a document")
+{
+	const auto frame = nlohmann::ordered_json::parse(batchFrame(3, "discovery -j", 0, "{\"device_list\": []}\n"));
+	CHECK(frame["id"] == 3);
+	CHECK(frame["command"] == "discovery -j");
+	CHECK(frame["exit_code"] == 0);
+	CHECK(frame["format"] == "json");
+	CHECK(frame["output"]["device_list"].is_array());
+
+	const auto array = nlohmann::ordered_json::parse(batchFrame(1, "x", 0, "[1, 2]"));
+	CHECK(array["format"] == "json");
+	CHECK(array["output"].size() == 2);
+}
+
+TEST_CASE("batchFrame passes other output through as text")
+{
+	const auto scalar = nlohmann::ordered_json::parse(batchFrame(1, "x", 0, "0"));
+	CHECK(scalar["format"] == "text");
+	CHECK(scalar["output"] == "0");
+
+	const auto table = nlohmann::ordered_json::parse(batchFrame(2, "stats -d 0", 1, "+---+\n| a |\n+---+\n"));
+	CHECK(table["exit_code"] == 1);
+	CHECK(table["format"] == "text");
+	CHECK(table["output"] == "+---+\n| a |\n+---+\n");
+
+	const auto empty = nlohmann::ordered_json::parse(batchFrame(4, "", 0, ""));
+	CHECK(empty["format"] == "text");
+	CHECK(empty["output"] == "");
+}
+
+TEST_CASE("batchFrame is a single line")
+{
+	const auto frame = batchFrame(5, "a\nb", 0, "{\n    \"k\": \"line\\none\"\n}\nmore\n");
+	CHECK(frame.find('\n') == std::string::npos);
+	CHECK(frame.find("\"id\":5") == 1);
+}
+
+TEST_CASE("batchFrame replaces invalid UTF-8 instead of failing")
+{
+	std::string frame;
+	CHECK_NOTHROW(frame = batchFrame(6, "x", 0, std::string("bad \xff byte")));
+	const auto parsed = nlohmann::ordered_json::parse(frame);
+	CHECK(parsed["format"] == "text");
+	CHECK(parsed["output"] == "bad \xEF\xBF\xBD byte");
+}
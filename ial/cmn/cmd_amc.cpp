@@ -10,8 +10,7 @@
 #include "table_builder.h"
 #include "amclib.h"
 #include "printer.h"
-#include <atomic>
-#include <thread>
+#include "task_executor.h"
 #include <vector>
 #include <iostream>
 #include <fstream>
@@ -20,6 +19,14 @@
 #include <nlohmann/json.hpp>
 #include <ctime>
 #include <array>
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <stop_token>
+#include <thread>
 
 static std::unordered_map<amcSubCmdType, amcSubCmdStruct> amcCmds = {
 	{AMC_HELP, {}},
@@ -32,8 +39,52 @@ static std::unordered_map<amcSubCmdType, amcSubCmdStruct> amcCmds = {
 	{AMC_DEVICE, {}},
 	{AMC_YES, {}},
 	{AMC_JSON, {}},
+	{AMC_WATCH, {}},
+	{AMC_INTERVAL, {}},
+	{AMC_COUNT, {}},
 };
 
+/**
+ * @brief Short name of a PLDM sensor base unit, as printed next to readings
+ */
+static const char *sensorUnitName(uint8_t baseUnit)
+{
+	switch (baseUnit) {
+	case PLDM_UNIT_DEGREES_C:
+		return "C";
+	case PLDM_UNIT_VOLTS:
+		return "V";
+	case PLDM_UNIT_CURRENT_AMPS:
+		return "A";
+	case PLDM_UNIT_WATTS:
+		return "W";
+	case PLDM_UNIT_JOULES:
+		return "J";
+	case PLDM_UNIT_COULOMBS:
+		return "C";
+	default:
+		return "";
+	}
+}
+
+/**
+ * @brief Converts the sensors read from one card to the JSON output shape
+ */
+static nlohmann::ordered_json cardSensorsToJson(const amcCardSensors &card)
+{
+	nlohmann::ordered_json cardJson;
+	cardJson["device"] = std::to_string(card.cardIndex);
+	cardJson["sensors"] = nlohmann::ordered_json::array();
+	for (const auto &sensor : card.sensors) {
+		nlohmann::ordered_json sensorJson;
+		sensorJson["sensor_id"] = sensor.sensorId;
+		sensorJson["sensor_value"] = sensor.sensorReading;
+		sensorJson["unit"] = sensorUnitName(sensor.baseUnit);
+		cardJson["sensors"].push_back(sensorJson);
+	}
+	return cardJson;
+}
+
 AmcTextPrinter::AmcTextPrinter() : TextPrinter() {}
 
 /**
@@ -41,11 +92,30 @@ AmcTextPrinter::AmcTextPrinter() : TextPrinter() {}
  *
  * This function formats and prints detailed information about the AMC sensor
  * device, including device identifier, sensor ID, and various sensor readings.
+ * A @c device_list object (several sensors or cards) is printed as one table
+ * with a row per sensor.
  *
  * @param[in] jsonObj Pointer to the JSON object containing AMC sensor data
  */
 void AmcTextPrinter::printDeviceInfo(nlohmann::ordered_json *jsonObj)
 {
+	if (jsonObj->contains("device_list")) {
+		TableBuilder table;
+		table.addColumn("Device", 8, Align::Left)
+			.addColumn("Sensor ID", 10, Align::Right)
+			.addColumn("Value", 14, Align::Right)
+			.addColumn("Unit", 6, Align::Left);
+		for (const auto &card : (*jsonObj)["device_list"]) {
+			for (const auto &sensor : card["sensors"]) {
+				table.addRow(card["device"].get<std::string>(), std::to_string(sensor["sensor_id"].get<int>()),
+							 std::format("{:.3f}", sensor["sensor_value"].get<double>()),
+							 sensor["unit"].get<std::string>());
+			}
+		}
+		PRINT("{}", table.toString().c_str());
+		return;
+	}
+
 	TableBuilder table;
 	table.addColumn("Property", 20, Align::Left).addColumn("Value", 40, Align::Left);
 
@@ -104,22 +174,33 @@ void cmdAmc::help(HELP helpType)
 	helpList.push_back(helpCmd(HEADING, "%s amc --gpuReset -d [deviceId] -y", progName.c_str()));
 	helpList.push_back(helpCmd(HEADING, "%s amc --sensor -d [deviceId] -s [sensorId]", progName.c_str()));
 	helpList.push_back(helpCmd(HEADING, "%s amc --sensor -d [deviceId] -s [sensorId] -j", progName.c_str()));
+	helpList.push_back(helpCmd(HEADING, "%s amc --sensor [-d deviceId] [-s sensorId,...]", progName.c_str()));
+	helpList.push_back(
+		helpCmd(HEADING, "%s amc --sensor --watch [-d deviceId] [-s sensorId,...] [-i seconds] [-n count] [-j]",
+				progName.c_str()));
 	helpList.push_back(helpCmd(HEADING, "%s amc --file -d [deviceId] --fileType [fileType] --fileName [outputFile]",
 							   progName.c_str()));
+	helpList.push_back(helpCmd(HEADING, "%s amc --file -d [deviceId,...] --fileType [fileType]", progName.c_str()));
 	helpList.push_back(helpCmd(BLANK));
 	helpList.push_back(helpCmd(TITLE, "Options:"));
 	helpList.push_back(helpCmd(HEADING, "-h,--help                   Print this help message and exit"));
 	helpList.push_back(helpCmd(HEADING, "--device,--id               Specify the device ID or PCI BDF address"));
 	helpList.push_back(helpCmd(HEADING, "--gpuReset                  Reset GPU(s) via AMC"));
 	helpList.push_back(helpCmd(HEADING, "--sensor                    Read AMC real-time sensor readings"));
+	helpList.push_back(helpCmd(
+		HEADING, "-s,--sensorId               Specify sensor ID(s), comma separated (Sensor IDs are listed below)"));
+	helpList.push_back(helpCmd(HEADING, "                            All sensors when omitted; all cards when -d is omitted"));
+	helpList.push_back(helpCmd(HEADING, "--watch                     Read the sensors repeatedly, one line per card and tick"));
+	helpList.push_back(helpCmd(HEADING, "-i,--interval               Seconds between two --watch ticks (default 1)"));
 	helpList.push_back(
-		helpCmd(HEADING, "-s,--sensorId               Specify the sensor ID (Sensor IDs are listed below)"));
+		helpCmd(HEADING, "-n,--number                 Number of --watch ticks; 0 runs until 'q' or Ctrl+C (default 0)"));
 	helpList.push_back(helpCmd(HEADING, "--file                      Read a file from GPU via AMC"));
 	helpList.push_back(helpCmd(
 		HEADING, "--fileType                  Specify the type of file to read (Filetype ids are listed below)"));
 	helpList.push_back(helpCmd(
 		HEADING,
 		"--fileName                  Specify the output file name. Default is <filepdrname_YrMthDt_HrMinSec>.bin"));
+	helpList.push_back(helpCmd(HEADING, "                            With several devices, each file name gets _amc<index>"));
 	helpList.push_back(helpCmd(HEADING, "-y,--yes                    Skip confirmation prompt"));
 	helpList.push_back(helpCmd(HEADING, "-j,--json                   Print result in JSON format"));
 	helpList.push_back(helpCmd(BLANK));
@@ -188,6 +269,11 @@ int cmdAmc::run(arg_struct *args)
 	sub.add_option("-d,--device,--id", amcCmds[AMC_DEVICE].val, "Device ID or PCI BDF address")
 		->each([&](const std::string &) { amcCmds[AMC_DEVICE].enabled = true; });
 	sub.add_flag("-y,--yes", amcCmds[AMC_YES].enabled, "Assume yes to all questions");
+	sub.add_flag("--watch", amcCmds[AMC_WATCH].enabled, "Read sensors repeatedly");
+	sub.add_option("-i,--interval", amcCmds[AMC_INTERVAL].val, "Seconds between watch ticks")
+		->each([&](const std::string &) { amcCmds[AMC_INTERVAL].enabled = true; });
+	sub.add_option("-n,--number", amcCmds[AMC_COUNT].val, "Number of watch ticks")
+		->each([&](const std::string &) { amcCmds[AMC_COUNT].enabled = true; });
 
 	try {
 		sub.parse(args->argc - 1, args->argv + 1);
@@ -349,46 +435,32 @@ ze_result_t cmdAmc::gpuReset(amclib *amc, int numCards)
 		return ZE_RESULT_ERROR_INVALID_ARGUMENT;
 	}
 
-	std::vector<std::thread> workers;
-	std::atomic<int> failureCount{0};
-	std::atomic<int> successCount{0};
-
+	std::vector<int> cards;
 	if (deviceId < 0) {
 		DBG("Executing GPU reset via AMC for all {} devices...\n", numCards);
 		for (int i = 0; i < numCards; i++) {
-			workers.emplace_back([amc, i, &failureCount, &successCount]() {
-				DBG("Resetting GPU device {} via AMC...\n", i);
-				if (amc->amcGpuReset(i) != AMC_SUCCESS) {
-					ERR("Failed to reset GPU device {} via AMC\n", i);
-					failureCount.fetch_add(1, std::memory_order_relaxed);
-				} else {
-					DBG("Successfully reset GPU device {} via AMC\n", i);
-					successCount.fetch_add(1, std::memory_order_relaxed);
-				}
-			});
+			cards.push_back(i);
 		}
 	} else {
 		DBG("Executing GPU reset via AMC for device {}...\n", deviceId);
-		workers.emplace_back([amc, deviceId, &failureCount, &successCount]() {
-			if (amc->amcGpuReset(deviceId) != AMC_SUCCESS) {
-				ERR("Failed to reset GPU device {} via AMC\n", deviceId);
-				failureCount.fetch_add(1, std::memory_order_relaxed);
-			} else {
-				successCount.fetch_add(1, std::memory_order_relaxed);
-			}
-		});
+		cards.push_back(deviceId);
 	}
 
-	for (auto &worker : workers) {
-		if (worker.joinable()) {
-			worker.join();
+	const DeviceResults outcome = parallelForEach(cards, [amc](int card) {
+		DBG("Resetting GPU device {} via AMC...\n", card);
+		if (amc->amcGpuReset(card) != AMC_SUCCESS) {
+			ERR("Failed to reset GPU device {} via AMC\n", card);
+			return ZE_RESULT_ERROR_UNKNOWN;
 		}
-	}
+		DBG("Successfully reset GPU device {} via AMC\n", card);
+		return ZE_RESULT_SUCCESS;
+	});
 
-	if (failureCount.load() > 0) {
-		ERR("Failed to reset {} GPU device(s) via AMC\n", failureCount.load());
-		if (successCount.load() > 0) {
-			PRINT("Successfully reset {} GPU device(s) via AMC\n", successCount.load());
+	if (!outcome.ok()) {
+		const size_t failureCount = outcome.failures();
+		ERR("Failed to reset {} GPU device(s) via AMC\n", failureCount);
+		if (failureCount < cards.size()) {
+			PRINT("Successfully reset {} GPU device(s) via AMC\n", cards.size() - failureCount);
 		}
 		return ZE_RESULT_ERROR_UNKNOWN;
 	}
@@ -402,6 +474,42 @@ ze_result_t cmdAmc::gpuReset(amclib *amc, int numCards)
 	return ZE_RESULT_SUCCESS;
 }
 
+/**
+ * @brief Parses a comma separated list of sensor IDs
+ *
+ * @param[in]  val       Value of the --sensorid option
+ * @param[out] sensorIds Parsed IDs, in the given order
+ * @return ze_result_t ZE_RESULT_SUCCESS on success, ZE_RESULT_ERROR_INVALID_ARGUMENT otherwise
+ */
+ze_result_t cmdAmc::parseSensorIds(const std::string &val, std::vector<uint16_t> &sensorIds)
+{
+	sensorIds.clear();
+	std::stringstream ss(val);
+	std::string item;
+	while (std::getline(ss, item, ',')) {
+		if (item.empty() || !std::all_of(item.begin(), item.end(), ::isdigit)) {
+			ERR("Invalid sensor ID: {}. Sensor ID must be a numeric value.\n", item.c_str());
+			return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+		}
+		int sensorId;
+		try {
+			sensorId = std::stoi(item);
+			if (sensorId > UINT16_MAX) {
+				throw std::out_of_range("Sensor ID exceeds 16-bit limit");
+			}
+		} catch (const std::exception &) {
+			ERR("Sensor ID '{}' is out of range (0-65535).\n", item.c_str());
+			return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+		}
+		sensorIds.push_back(static_cast<uint16_t>(sensorId));
+	}
+	if (sensorIds.empty()) {
+		ERR("Sensor ID must be specified with --sensorid option.\n");
+		return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+	}
+	return ZE_RESULT_SUCCESS;
+}
+
 /**
  * @brief Executes the AMC sensor monitoring command
  *
@@ -410,6 +518,10 @@ ze_result_t cmdAmc::gpuReset(amclib *amc, int numCards)
  * the Advanced Management Controller. It supports both standard and JSON output
  * formats for sensor data presentation.
  *
+ * Without -d every card is read, without -s every numeric sensor of a card. The
+ * cards are read in parallel. A single sensor of a single card keeps the original
+ * one-sensor output; --watch hands over to watchSensors().
+ *
  * @param[in] amc Pointer to initialized AMC library instance
  * @param[in] numCards Number of available AMC devices
  * @return ze_result_t ZE_RESULT_SUCCESS on success, error code on failure
@@ -417,43 +529,45 @@ ze_result_t cmdAmc::gpuReset(amclib *amc, int numCards)
 ze_result_t cmdAmc::readSensor(amclib *amc, int numCards)
 {
 	TRACING();
-	if (!amcCmds[AMC_DEVICE].enabled || amcCmds[AMC_DEVICE].val.empty()) {
+	if (amcCmds[AMC_DEVICE].enabled && amcCmds[AMC_DEVICE].val.empty()) {
 		ERR("Device ID must be specified with --device option.\n");
 		return ZE_RESULT_ERROR_INVALID_ARGUMENT;
 	}
 
-	if (!amcCmds[AMC_SENSORID].enabled || amcCmds[AMC_SENSORID].val.empty()) {
-		ERR("Sensor ID must be specified with --sensorid option.\n");
+	std::vector<int> cards;
+	if (amcCmds[AMC_DEVICE].enabled) {
+		int deviceIndex = -1;
+		if (getDeviceIndex(amc, amcCmds[AMC_DEVICE].val, numCards, deviceIndex) != ZE_RESULT_SUCCESS) {
+			return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+		}
+		cards.push_back(deviceIndex);
+	} else {
+		for (int i = 0; i < numCards; i++) {
+			cards.push_back(i);
+		}
+	}
+
+	std::vector<uint16_t> sensorIds;
+	if (amcCmds[AMC_SENSORID].enabled &&
+		parseSensorIds(amcCmds[AMC_SENSORID].val, sensorIds) != ZE_RESULT_SUCCESS) {
 		return ZE_RESULT_ERROR_INVALID_ARGUMENT;
 	}
 
-	int deviceIndex = -1;
-	if (getDeviceIndex(amc, amcCmds[AMC_DEVICE].val, numCards, deviceIndex) != ZE_RESULT_SUCCESS) {
+	if (amcCmds[AMC_WATCH].enabled) {
+		return watchSensors(amc, cards, sensorIds);
+	}
+	if (amcCmds[AMC_INTERVAL].enabled || amcCmds[AMC_COUNT].enabled) {
+		ERR("--interval and --number can only be used with --watch.\n");
 		return ZE_RESULT_ERROR_INVALID_ARGUMENT;
 	}
 
+	ze_result_t result = ZE_RESULT_SUCCESS;
 	nlohmann::ordered_json outputJson;
-	if (amcCmds[AMC_SENSORID].enabled) {
-		if (!std::all_of(amcCmds[AMC_SENSORID].val.begin(), amcCmds[AMC_SENSORID].val.end(), ::isdigit)) {
-			ERR("Invalid sensor ID: {}. Sensor ID must be a numeric value.\n", amcCmds[AMC_SENSORID].val.c_str());
-			return ZE_RESULT_ERROR_INVALID_ARGUMENT;
-		}
-
-		int sensorId;
-		try {
-			sensorId = std::stoi(amcCmds[AMC_SENSORID].val);
-			if (sensorId > UINT16_MAX) {
-				throw std::out_of_range("Sensor ID exceeds 16-bit limit");
-			}
-		} catch (const std::exception &) {
-			ERR("Sensor ID '{}' is out of range (0-65535).\n", amcCmds[AMC_SENSORID].val.c_str());
-			return ZE_RESULT_ERROR_INVALID_ARGUMENT;
-		}
-
+	if (amcCmds[AMC_DEVICE].enabled && sensorIds.size() == 1) {
 		std::vector<amcSensorInfo> sensorInfo;
-		int ret = amc->amcGetSensorInfoBySensorId(deviceIndex, static_cast<uint16_t>(sensorId), sensorInfo);
+		int ret = amc->amcGetSensorInfoBySensorId(cards[0], sensorIds[0], sensorInfo);
 		if (ret != AMC_SUCCESS) {
-			ERR("Failed to get AMC sensor info for sensor ID {} on device {}.\n", sensorId,
+			ERR("Failed to get AMC sensor info for sensor ID {} on device {}.\n", sensorIds[0],
 				amcCmds[AMC_DEVICE].val.c_str());
 			return ZE_RESULT_ERROR_UNINITIALIZED;
 		}
@@ -461,6 +575,17 @@ ze_result_t cmdAmc::readSensor(amclib *amc, int numCards)
 		outputJson["device"] = amcCmds[AMC_DEVICE].val;
 		outputJson["sensor_id"] = sensorInfo[0].sensorId;
 		outputJson["sensor_value"] = sensorInfo[0].sensorReading;
+	} else {
+		// Whatever was read is still printed when some card or sensor failed
+		std::vector<amcCardSensors> readings;
+		if (amc->amcReadSensors(cards, sensorIds, readings) != AMC_SUCCESS) {
+			ERR("Failed to read some AMC sensors.\n");
+			result = ZE_RESULT_ERROR_UNKNOWN;
+		}
+		outputJson["device_list"] = nlohmann::ordered_json::array();
+		for (const auto &card : readings) {
+			outputJson["device_list"].push_back(cardSensorsToJson(card));
+		}
 	}
 
 	std::unique_ptr<Printer> printer;
@@ -473,6 +598,126 @@ ze_result_t cmdAmc::readSensor(amclib *amc, int numCards)
 		printer->print(&outputJson);
 	}
 
+	return result;
+}
+
+/**
+ * @brief Reads AMC sensors at a fixed interval until told to stop
+ *
+ * Every tick reads the sensors of all @p cards once through amcReadSensors(), which
+ * keeps the bus load at one GetSensorReading per sensor, card and interval. Ticks
+ * are scheduled against a deadline so reading time does not stretch the interval;
+ * a tick that overruns its slot is not made up for, the next one simply starts a
+ * full interval later. A card that fails a tick is reported and read again on the
+ * next one.
+ *
+ * Text output is one line per card and tick:
+ * @c "HH:MM:SS.mmm, <device>, <sensorId>=<value> <unit>, ..."; JSON output is one
+ * object per tick and line.
+ *
+ * @param[in] amc       Pointer to initialized AMC library instance
+ * @param[in] cards     Cards to read
+ * @param[in] sensorIds Sensors to read on every card; all sensors if empty
+ * @return ze_result_t ZE_RESULT_SUCCESS on success, error code on invalid options
+ */
+ze_result_t cmdAmc::watchSensors(amclib *amc, const std::vector<int> &cards, const std::vector<uint16_t> &sensorIds)
+{
+	TRACING();
+
+	int intervalSec = 1;
+	int count = 0;
+	try {
+		if (amcCmds[AMC_INTERVAL].enabled) {
+			intervalSec = std::stoi(amcCmds[AMC_INTERVAL].val);
+		}
+		if (amcCmds[AMC_COUNT].enabled) {
+			count = std::stoi(amcCmds[AMC_COUNT].val);
+		}
+	} catch (const std::exception &) {
+		ERR("--interval and --number must be numeric values.\n");
+		return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+	}
+	if (intervalSec < 1) {
+		ERR("Invalid interval: {}. Interval must be at least 1 second.\n", intervalSec);
+		return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+	}
+	if (count < 0) {
+		ERR("Invalid number of ticks: {}. Use 0 to run until stopped.\n", count);
+		return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+	}
+	if (count == 0 && batchMode) {
+		ERR("--watch runs until stopped; give --number inside --batch.\n");
+		return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+	}
+
+	std::stop_source quitSource;
+	auto quitToken = quitSource.get_token();
+	std::jthread inputThread;
+	if (count == 0 && !batchMode && STDIN_ISATTY()) {
+		inputThread = std::jthread([quitSource, quitToken](const std::stop_token &ownStop) mutable {
+			char ch = 0;
+			while (!ownStop.stop_requested() && !quitToken.stop_requested()) {
+				ch = GETCH();
+				if (ch == 'q' || ch == 'Q' || ch == 27 || ch == 3) {
+					quitSource.request_stop();
+					return;
+				}
+			}
+		});
+	}
+
+	const bool json = amcCmds[AMC_JSON].enabled;
+	const std::chrono::seconds interval(intervalSec);
+	auto deadline = std::chrono::steady_clock::now();
+	std::vector<amcCardSensors> readings;
+	int remaining = count;
+
+	while (!quitToken.stop_requested()) {
+		const auto nowMs = std::chrono::floor<std::chrono::milliseconds>(std::chrono::system_clock::now());
+		amc->amcReadSensors(cards, sensorIds, readings);
+
+		std::string out;
+		if (json) {
+			nlohmann::ordered_json tick;
+			tick["timestamp"] = std::format("{:%H:%M:%S}", nowMs);
+			tick["device_list"] = nlohmann::ordered_json::array();
+			for (const auto &card : readings) {
+				tick["device_list"].push_back(cardSensorsToJson(card));
+			}
+			out = tick.dump() + "\n";
+		} else {
+			for (const auto &card : readings) {
+				std::format_to(std::back_inserter(out), "{:%H:%M:%S}, {}", nowMs, card.cardIndex);
+				for (const auto &sensor : card.sensors) {
+					std::format_to(std::back_inserter(out), ", {}={:.3f} {}", sensor.sensorId, sensor.sensorReading,
+								   sensorUnitName(sensor.baseUnit));
+				}
+				if (card.status != AMC_SUCCESS) {
+					out += ", read failed";
+				}
+				out += "\n";
+			}
+		}
+		PRINT("{}", out.c_str());
+
+		if (remaining > 0 && --remaining == 0) {
+			break;
+		}
+
+		deadline += interval;
+		const auto now = std::chrono::steady_clock::now();
+		if (deadline < now) {
+			deadline = now + interval;
+		}
+		// Wake up in small steps so 'q' ends the loop without waiting out a long interval
+		while (!quitToken.stop_requested() && std::chrono::steady_clock::now() < deadline) {
+			std::this_thread::sleep_until(
+				std::min(deadline, std::chrono::steady_clock::now() + std::chrono::milliseconds(100)));
+		}
+	}
+
+	// std::jthread automatically joins on destruction - no need to manually join/detach
+	RESTORE_TERMINAL();
 	return ZE_RESULT_SUCCESS;
 }
 
@@ -481,8 +726,13 @@ ze_result_t cmdAmc::readSensor(amclib *amc, int numCards)
  *
  * This function implements the main execution logic for the AMC file command,
  * parsing command line arguments and retrieving specified files from the GPU via
- * the Advanced Management Controller. It validates input parameters, handles file
- * retrieval, and supports saving output to a specified file with error handling.
+ * the Advanced Management Controller. --device takes a comma separated list; the
+ * cards are read concurrently, each into a file of its own named after the card.
+ *
+ * A file is streamed into "<filename>.part" and renamed once complete; a transfer
+ * that breaks off is retried within the run. Nothing ties a .part file of an earlier
+ * run to the card or to the file now on it, so it is overwritten rather than resumed,
+ * and one left incomplete is deleted.
  *
  * @param[in] amc Pointer to initialized AMC library instance
  * @param[in] numCards Number of available AMC devices
@@ -522,6 +772,25 @@ ze_result_t cmdAmc::readFile(amclib *amc, int numCards)
 		return ZE_RESULT_ERROR_INVALID_ARGUMENT;
 	}
 
+	std::vector<std::string> devices;
+	std::vector<int> cards;
+	std::stringstream deviceList(amcCmds[AMC_DEVICE].val);
+	std::string device;
+	while (std::getline(deviceList, device, ',')) {
+		int deviceIndex = -1;
+		if (device.empty()) {
+			ERR("Invalid device list: {}\n", amcCmds[AMC_DEVICE].val.c_str());
+			return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+		}
+		if (getDeviceIndex(amc, device, numCards, deviceIndex) != ZE_RESULT_SUCCESS) {
+			return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+		}
+		if (std::find(cards.begin(), cards.end(), deviceIndex) == cards.end()) {
+			devices.push_back(device);
+			cards.push_back(deviceIndex);
+		}
+	}
+
 	std::string opFilename{};
 	if (amcCmds[AMC_OP_FILENAME].enabled && !amcCmds[AMC_OP_FILENAME].val.empty()) {
 		opFilename = amcCmds[AMC_OP_FILENAME].val;
@@ -532,35 +801,74 @@ ze_result_t cmdAmc::readFile(amclib *amc, int numCards)
 		opFilename = filePdrNames[filePdrId] + std::string(timeStr) + ".bin";
 	}
 
-	int deviceIndex = -1;
-	if (getDeviceIndex(amc, amcCmds[AMC_DEVICE].val, numCards, deviceIndex) != ZE_RESULT_SUCCESS) {
-		return ZE_RESULT_ERROR_INVALID_ARGUMENT;
-	}
-
-	std::vector<uint8_t> fileData;
-	int ret = amc->amcReadFile(deviceIndex, filePdrId, fileData);
-	if (ret != AMC_SUCCESS) {
-		ERR("Failed to read AMC file of type {} on device {}.\n", filePdrId, amcCmds[AMC_DEVICE].val.c_str());
-		return ZE_RESULT_ERROR_UNINITIALIZED;
-	}
+	struct cardFile
+	{
+		std::filesystem::path path;
+		std::filesystem::path partPath;
+		std::ofstream stream;
+		std::unique_ptr<StreamFileSink> sink;
+	};
+	std::vector<cardFile> files(cards.size());
+	std::vector<amcFileRequest> requests;
+	for (size_t i = 0; i < cards.size(); i++) {
+		// With several cards each gets <stem>_amc<index><extension>
+		std::filesystem::path path(opFilename);
+		if (cards.size() > 1) {
+			path.replace_filename(path.stem().string() + "_amc" + std::to_string(cards[i]) +
+								  path.extension().string());
+		}
+		files[i].path = path;
+		files[i].partPath = path.string() + ".part";
 
-	if (!fileData.empty()) {
-		std::ofstream outFile(opFilename, std::ios::binary);
-		if (!outFile) {
-			ERR("Failed to open output file: {}\n", opFilename.c_str());
+		files[i].stream.open(files[i].partPath, std::ios::binary | std::ios::trunc);
+		if (!files[i].stream) {
+			ERR("Failed to open output file: {}\n", files[i].partPath.string().c_str());
 			return ZE_RESULT_ERROR_UNKNOWN;
 		}
-		outFile.write(reinterpret_cast<const char *>(fileData.data()), fileData.size());
-		if (!outFile) {
-			ERR("Failed to write data to output file: {}\n", opFilename.c_str());
-			return ZE_RESULT_ERROR_UNKNOWN;
+		files[i].sink = std::make_unique<StreamFileSink>(files[i].stream);
+		requests.push_back({cards[i], files[i].sink.get(), {}});
+	}
+
+	// The outcome is reported per card below
+	amc->amcReadFiles(filePdrId, requests);
+
+	ze_result_t result = ZE_RESULT_SUCCESS;
+	for (size_t i = 0; i < requests.size(); i++) {
+		const amcFileRequest &request = requests[i];
+		cardFile &file = files[i];
+		file.stream.close();
+		std::error_code ec;
+		if (request.status != AMC_SUCCESS) {
+			std::filesystem::remove(file.partPath, ec);
+			if (request.checksumMismatch) {
+				ERR("AMC file of type {} on device {} failed its checksum and was discarded.\n", filePdrId,
+					devices[i].c_str());
+			} else {
+				ERR("Failed to read AMC file of type {} on device {} after {} bytes.\n", filePdrId,
+					devices[i].c_str(), request.progress.offset);
+			}
+			result = ZE_RESULT_ERROR_UNINITIALIZED;
+			continue;
 		}
-		outFile.close();
-		PRINT("Successfully read AMC file of type {} on device {} and saved to {}\n", filePdrId,
-			  amcCmds[AMC_DEVICE].val.c_str(), opFilename.c_str());
-	} else {
-		ERR("AMC file of type {} on device {} is empty.\n", filePdrId, amcCmds[AMC_DEVICE].val.c_str());
-		return ZE_RESULT_ERROR_UNKNOWN;
+		if (request.progress.offset == 0) {
+			std::filesystem::remove(file.partPath, ec);
+			ERR("AMC file of type {} on device {} is empty.\n", filePdrId, devices[i].c_str());
+			result = ZE_RESULT_ERROR_UNKNOWN;
+			continue;
+		}
+		if (!file.stream) {
+			ERR("Failed to write data to output file: {}\n", file.partPath.string().c_str());
+			result = ZE_RESULT_ERROR_UNKNOWN;
+			continue;
+		}
+		std::filesystem::rename(file.partPath, file.path, ec);
+		if (ec) {
+			ERR("Failed to rename {} to {}\n", file.partPath.string().c_str(), file.path.string().c_str());
+			result = ZE_RESULT_ERROR_UNKNOWN;
+			continue;
+		}
+		PRINT("Successfully read AMC file of type {} on device {} and saved to {} ({} bytes)\n", filePdrId,
+			  devices[i].c_str(), file.path.string().c_str(), request.progress.offset);
 	}
-	return ZE_RESULT_SUCCESS;
+	return result;
 }
\ No newline at end of file
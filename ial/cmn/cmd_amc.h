@@ -11,6 +11,7 @@
 #include "printer.h"
 #include <os.h>
 #include <string>
+#include <vector>
 
 class amclib;
 
@@ -36,6 +37,8 @@ public:
 
 private:
 	ze_result_t getDeviceIndex(amclib *amc, const std::string &val, int numCards, int &deviceIndex);
+	ze_result_t parseSensorIds(const std::string &val, std::vector<uint16_t> &sensorIds);
+	ze_result_t watchSensors(amclib *amc, const std::vector<int> &cards, const std::vector<uint16_t> &sensorIds);
 };
 
 enum amcSubCmdType
@@ -50,6 +53,9 @@ enum amcSubCmdType
 	AMC_DEVICE,
 	AMC_YES,
 	AMC_JSON,
+	AMC_WATCH,
+	AMC_INTERVAL,
+	AMC_COUNT,
 	AMC_TOTAL_SUBCMD,
 };
 
@@ -5,6 +5,7 @@
  */
 
 #include "cmd_config.h"
+#include "config_profile.h"
 #include "debug.h"
 #include <CLI/CLI.hpp>
 #include "table_builder.h"
@@ -22,13 +23,16 @@
 #include <powerexp.h>
 #include <scheduler.h>
 #include <standby.h>
+#include <task_executor.h>
 #include <stdexcept>
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
 #include <cinttypes>
 #include <cmath>
+#include <csignal>
 #include <cstdlib>
+#include <fstream>
 #include <limits>
 
 // Conversion helpers between watts and milliwatts
@@ -62,12 +66,30 @@ static std::unordered_map<configCmdType, configCmdStruct> configCmds = {
 	{configCmdType::FANCURVE, {.func = &cmdConfig::setFanCurve}},
 	{configCmdType::FANCURVERPM, {.func = &cmdConfig::setFanCurveRpm}},
 	{configCmdType::FANID, {}},
-	{configCmdType::COLDRESET, {.func = &cmdConfig::coldResetDevice}},
+	{configCmdType::COLDRESET, {}},
 	{configCmdType::IGNORE_GPU_USER_PROCESSES, {}},
 	{configCmdType::FORCE_RESET_GPUS, {}},
 	{configCmdType::POWERTYPE, {}},
+	{configCmdType::PROFILE, {}},
+	{configCmdType::DRYRUN, {}},
 };
 
+/**
+ * @brief Records the first failed query of a configuration read.
+ *
+ * Features the device does not support are not failures; they are reported as empty values.
+ *
+ * @param[in,out] status Where to record the failure; may be nullptr when the caller does not track it.
+ * @param[in] result Result of the query.
+ */
+static void noteReadFailure(ze_result_t *status, ze_result_t result)
+{
+	if (status != nullptr && *status == ZE_RESULT_SUCCESS && result != ZE_RESULT_SUCCESS &&
+		result != ZE_RESULT_ERROR_UNSUPPORTED_FEATURE) {
+		*status = result;
+	}
+}
+
 /**
  * @brief Joins a vector of integers into a comma-separated string.
  *
@@ -121,9 +143,10 @@ static std::string joinRoundedClocks(const std::vector<double> &values)
  * @param[out] options Comma-separated frequency list.
  * @param[out] minFreq Minimum frequency in MHz.
  * @param[out] maxFreq Maximum frequency in MHz.
+ * @param[in,out] status Optional first-failure status, see noteReadFailure().
  */
 static void getGpuFrequencyOptions(devInfo *d, uint32_t tileId, std::string &options, uint32_t &minFreq,
-								   uint32_t &maxFreq)
+								   uint32_t &maxFreq, ze_result_t *status = nullptr)
 {
 	options.clear();
 	minFreq = 0;
@@ -136,6 +159,7 @@ static void getGpuFrequencyOptions(devInfo *d, uint32_t tileId, std::string &opt
 
 	std::vector<double> clocks;
 	ze_result_t result = fq->getFreqAvailableClocks(tileId, clocks);
+	noteReadFailure(status, result);
 	if (result != ZE_RESULT_SUCCESS || clocks.empty()) {
 		return;
 	}
@@ -149,6 +173,7 @@ static void getGpuFrequencyOptions(devInfo *d, uint32_t tileId, std::string &opt
 	double configuredMin = 0;
 	double configuredMax = 0;
 	result = fq->getFreqRangeForTile(tileId, configuredMin, configuredMax);
+	noteReadFailure(status, result);
 	if (result == ZE_RESULT_SUCCESS) {
 		minFreq =
 			static_cast<uint32_t>(std::llround((std::fpclassify(configuredMin) != FP_ZERO) ? configuredMin : minVal));
@@ -197,8 +222,10 @@ static uint32_t mapTileToSubdevice(devInfo *d, uint32_t tileId)
  * @param[out] mode Scheduler mode string.
  * @param[out] interval Timeslice/timeout interval in microseconds.
  * @param[out] yieldTimeout Timeslice yield timeout in microseconds.
+ * @param[in,out] status Optional first-failure status, see noteReadFailure().
  */
-static void getSchedulerInfo(devInfo *d, uint32_t tileId, std::string &mode, uint64_t &interval, uint64_t &yieldTimeout)
+static void getSchedulerInfo(devInfo *d, uint32_t tileId, std::string &mode, uint64_t &interval, uint64_t &yieldTimeout,
+							 ze_result_t *status = nullptr)
 {
 	mode.clear();
 	interval = 0;
@@ -239,20 +266,26 @@ static void getSchedulerInfo(devInfo *d, uint32_t tileId, std::string &mode, uin
 	}
 
 	zes_sched_mode_t schedMode = {};
-	if (sched->getCurrentMode(selected, &schedMode) != ZE_RESULT_SUCCESS) {
+	ze_result_t result = sched->getCurrentMode(selected, &schedMode);
+	noteReadFailure(status, result);
+	if (result != ZE_RESULT_SUCCESS) {
 		return;
 	}
 
 	if (schedMode == ZES_SCHED_MODE_TIMEOUT) {
 		mode = "timeout";
 		zes_sched_timeout_properties_t timeoutProps = {};
-		if (sched->getTimeoutModeProperties(selected, false, &timeoutProps) == ZE_RESULT_SUCCESS) {
+		result = sched->getTimeoutModeProperties(selected, false, &timeoutProps);
+		noteReadFailure(status, result);
+		if (result == ZE_RESULT_SUCCESS) {
 			interval = timeoutProps.watchdogTimeout;
 		}
 	} else if (schedMode == ZES_SCHED_MODE_TIMESLICE) {
 		mode = "timeslice";
 		zes_sched_timeslice_properties_t timesliceProps = {};
-		if (sched->getTimesliceProperties(selected, false, &timesliceProps) == ZE_RESULT_SUCCESS) {
+		result = sched->getTimesliceProperties(selected, false, &timesliceProps);
+		noteReadFailure(status, result);
+		if (result == ZE_RESULT_SUCCESS) {
 			interval = timesliceProps.interval;
 			yieldTimeout = timesliceProps.yieldTimeout;
 		}
@@ -288,8 +321,9 @@ static std::string eccStateToString(zes_device_ecc_state_t state)
  * @param[in] d Device information.
  * @param[out] current Current ECC state string.
  * @param[out] pending Pending ECC state string.
+ * @param[in,out] status Optional first-failure status, see noteReadFailure().
  */
-static void getMemoryEccStates(devInfo *d, std::string &current, std::string &pending)
+static void getMemoryEccStates(devInfo *d, std::string &current, std::string &pending, ze_result_t *status = nullptr)
 {
 	current = "N/A";
 	pending = "N/A";
@@ -297,7 +331,9 @@ static void getMemoryEccStates(devInfo *d, std::string &current, std::string &pe
 	ecc *eccInst = d->dev->getECC();
 	if (eccInst != nullptr) {
 		zes_device_ecc_properties_t state = {};
-		if (eccInst->getState(d->zesDeviceHdl, &state) == ZE_RESULT_SUCCESS) {
+		ze_result_t result = eccInst->getState(d->zesDeviceHdl, &state);
+		noteReadFailure(status, result);
+		if (result == ZE_RESULT_SUCCESS) {
 			current = eccStateToString(state.currentState);
 			pending = eccStateToString(state.pendingState);
 			return;
@@ -317,9 +353,10 @@ static void getMemoryEccStates(devInfo *d, std::string &current, std::string &pe
  *
  * @param[in] d Device information.
  * @param[in] tileId Tile identifier.
+ * @param[in,out] status Optional first-failure status, see noteReadFailure().
  * @return std::string Standby mode string.
  */
-static std::string getStandbyMode(devInfo *d, uint32_t tileId)
+static std::string getStandbyMode(devInfo *d, uint32_t tileId, ze_result_t *status = nullptr)
 {
 	standby *sb = d->dev->getStandby();
 	if (sb == nullptr) {
@@ -356,7 +393,9 @@ static std::string getStandbyMode(devInfo *d, uint32_t tileId)
 	}
 
 	zes_standby_promo_mode_t mode = {};
-	if (sb->getMode(selected, &mode) != ZE_RESULT_SUCCESS) {
+	ze_result_t result = sb->getMode(selected, &mode);
+	noteReadFailure(status, result);
+	if (result != ZE_RESULT_SUCCESS) {
 		return "";
 	}
 
@@ -370,17 +409,24 @@ static std::string getStandbyMode(devInfo *d, uint32_t tileId)
 }
 
 /**
- * @brief Builds JSON string for device configuration output.
+ * @brief Builds the JSON object describing the device configuration.
+ *
+ * Used for @c config @c -j output and as the current state when applying a profile.
  *
  * @param[in] d Device information.
- * @param[in] indent Base indentation size.
- * @return std::string JSON-formatted configuration.
+ * @param[out] status Optional; set to the first failed query, or ZE_RESULT_SUCCESS. Values that
+ *             could not be read are still reported as empty or zero in the returned object.
+ * @return nlohmann::ordered_json Device configuration.
  */
-static std::string buildDeviceConfigJson(devInfo *d, size_t indent)
+static nlohmann::ordered_json buildDeviceConfig(devInfo *d, ze_result_t *status = nullptr)
 {
+	if (status != nullptr) {
+		*status = ZE_RESULT_SUCCESS;
+	}
+
 	std::string eccCurrent;
 	std::string eccPending;
-	getMemoryEccStates(d, eccCurrent, eccPending);
+	getMemoryEccStates(d, eccCurrent, eccPending, status);
 
 	int plPackageSustain = 0;
 	int plPackageBurst = 0;
@@ -393,7 +439,7 @@ static std::string buildDeviceConfigJson(devInfo *d, size_t indent)
 	powerExp *pwrExp = d->dev->getPowerExp();
 	if (!pwrExp->isPowerExpEnabled() && pwr != nullptr) {
 		std::map<zes_power_domain_t, std::map<zes_power_level_t, int32_t>> domainLimits;
-		pwr->getDomainLimits(domainLimits);
+		noteReadFailure(status, pwr->getDomainLimits(domainLimits));
 
 		auto getLimitW = [&](zes_power_domain_t domain, zes_power_level_t level) -> int {
 			auto domainIt = domainLimits.find(domain);
@@ -417,7 +463,9 @@ static std::string buildDeviceConfigJson(devInfo *d, size_t indent)
 		pwr->getMaxPowerLimit(powerValidRange);
 	} else if (pwrExp->isPowerExpEnabled()) {
 		std::vector<power_limits_exp_t> powerLimits;
-		if (pwrExp->getPowerLimits(powerLimits) == ZE_RESULT_SUCCESS) {
+		const ze_result_t result = pwrExp->getPowerLimits(powerLimits);
+		noteReadFailure(status, result);
+		if (result == ZE_RESULT_SUCCESS) {
 			for (const auto &limits : powerLimits) {
 				if (limits.domain == ZES_POWER_DOMAIN_CARD) {
 					plCardSustain = mwToW(limits.limit);
@@ -496,14 +544,14 @@ static std::string buildDeviceConfigJson(devInfo *d, size_t indent)
 		std::string freqOptions;
 		uint32_t minFreq = 0;
 		uint32_t maxFreq = 0;
-		getGpuFrequencyOptions(d, tileId, freqOptions, minFreq, maxFreq);
+		getGpuFrequencyOptions(d, tileId, freqOptions, minFreq, maxFreq, status);
 
 		std::string schedulerMode;
 		uint64_t schedInterval = 0;
 		uint64_t schedYieldTimeout = 0;
-		getSchedulerInfo(d, tileId, schedulerMode, schedInterval, schedYieldTimeout);
+		getSchedulerInfo(d, tileId, schedulerMode, schedInterval, schedYieldTimeout, status);
 
-		std::string standbyMode = getStandbyMode(d, tileId);
+		std::string standbyMode = getStandbyMode(d, tileId, status);
 
 		nlohmann::ordered_json tileJson;
 		tileJson["compute_engine"] = "compute";
@@ -516,6 +564,7 @@ static std::string buildDeviceConfigJson(devInfo *d, size_t indent)
 		uint64_t outYieldTimeout = (schedulerMode == "timeslice") ? schedYieldTimeout : 0;
 		tileJson["scheduler_timeslice_interval"] = outInterval;
 		tileJson["scheduler_timeslice_yield_timeout"] = outYieldTimeout;
+		tileJson["scheduler_timeout"] = (schedulerMode == "timeout") ? schedInterval : 0;
 		tileJson["standby_mode"] = standbyMode;
 		tileJson["standby_mode_valid_options"] = "default, never";
 		tileJson["tile_id"] = tileIdStr;
@@ -524,8 +573,19 @@ static std::string buildDeviceConfigJson(devInfo *d, size_t indent)
 	}
 
 	deviceJson["tile_config_data"] = tileConfigArray;
+	return deviceJson;
+}
 
-	std::string jsonOut = deviceJson.dump(4);
+/**
+ * @brief Builds JSON string for device configuration output.
+ *
+ * @param[in] d Device information.
+ * @param[in] indent Base indentation size.
+ * @return std::string JSON-formatted configuration.
+ */
+static std::string buildDeviceConfigJson(devInfo *d, size_t indent)
+{
+	std::string jsonOut = buildDeviceConfig(d).dump(4);
 	if (indent == 0) {
 		return jsonOut;
 	}
@@ -650,8 +710,10 @@ void cmdConfig::help(HELP helpType)
 	helpList.push_back(helpCmd(HEADING, "--fanid                     Fan target: -1 (all fans, default) or 0..N-1"));
 
 	helpList.push_back(helpCmd(HEADING, "%s config --device [deviceId] --reset", progName.c_str()));
-	helpList.push_back(helpCmd(HEADING, "%s config --device [pciBdfAddress] --coldreset", progName.c_str()));
+	helpList.push_back(helpCmd(HEADING, "%s config --device [pciBdfAddress[,...]] --coldreset", progName.c_str()));
 	helpList.push_back(helpCmd(HEADING, "%s config --device [deviceId] --clear-ras-errors", progName.c_str()));
+	helpList.push_back(helpCmd(HEADING, "%s config [--device deviceId] --profile [file.json] [--dry-run]",
+							   progName.c_str()));
 	helpList.push_back(helpCmd(BLANK));
 	helpList.push_back(helpCmd(TITLE, "Options:"));
 	helpList.push_back(helpCmd(HEADING, "-h,--help                   Print this help message and exit"));
@@ -679,6 +741,7 @@ void cmdConfig::help(HELP helpType)
 	helpList.push_back(helpCmd(SUB_HEADING, "Device must be addressed by PCI BDF (e.g. 0000:4d:00.0), not by device "
 											"ID. Aborts if processes are using the GPU or if other devices share "
 											"the PCIe slot. Override with the flags below."));
+	helpList.push_back(helpCmd(SUB_HEADING, "Several comma-separated BDFs in different slots are reset concurrently."));
 	helpList.push_back(
 		helpCmd(HEADING, "--ignore-gpu-user-processes Proceed with --coldreset even if processes have the GPU"));
 	helpList.push_back(helpCmd(SUB_HEADING, "open."));
@@ -704,6 +767,11 @@ void cmdConfig::help(HELP helpType)
 	helpList.push_back(helpCmd(HEADING, "--fancurve-rpm              Set fan curve in RPM: temp:rpm,temp:rpm,..."));
 	helpList.push_back(
 		helpCmd(SUB_HEADING, "Examples: --fancurve-rpm 40:1200,70:2800   --fancurve-rpm 40:1200rpm,70:2800rpm"));
+	helpList.push_back(helpCmd(HEADING, "--profile                   Apply a JSON configuration profile to all matching "
+										"devices concurrently"));
+	helpList.push_back(helpCmd(SUB_HEADING, "Only changed settings are written; each is read back, and all devices "
+											"are restored to their previous values if any device fails."));
+	helpList.push_back(helpCmd(HEADING, "--dry-run                   With --profile, print the changes only"));
 
 	printHelp(helpList, helpType);
 	helpList.clear();
@@ -1837,29 +1905,20 @@ ze_result_t cmdConfig::setFanCurveRpm(devInfo *d)
 }
 
 /**
- * @brief Cold resets the device via PCIe slot power cycle.
+ * @brief Checks that a device may be cold reset.
  *
- * Aborts if processes are using the GPU (override with --ignore-gpu-user-processes)
- * or if other PCI devices share the slot (override with --force-reset-gpus).
+ * Fails if processes are using the GPU (override with --ignore-gpu-user-processes)
+ * or if other PCI devices share the slot (override with --force-reset-gpus). Two
+ * requested GPUs in the same slot are always rejected: concurrent power cycles
+ * of one slot would race.
  *
- * On success the process exits via std::_Exit(0) because the GPU has
- * disappeared and re-enumerated; outstanding Level Zero handles are no
- * longer valid and clean teardown is unsafe.
+ * @param d Device to check.
+ * @param deviceList All devices requested for cold reset.
  *
- * @param d Device information structure.
- *
- * @return ze_result_t Result of the operation. The function does not return
- *         on success (process exits).
+ * @return ze_result_t ZE_RESULT_SUCCESS if the reset may proceed.
  */
-ze_result_t cmdConfig::coldResetDevice(devInfo *d)
+ze_result_t cmdConfig::checkColdReset(devInfo *d, const std::vector<devInfo> &deviceList)
 {
-	TRACING();
-
-	if (!PRIVILEGECHECK()) {
-		ERR("Cold reset requires elevated privileges (root or 'xpum' group on Linux).\n");
-		return ZE_RESULT_ERROR_INSUFFICIENT_PERMISSIONS;
-	}
-
 	const std::string bdfStr = d->dev->getBDFStr();
 
 	if (!configCmds[configCmdType::IGNORE_GPU_USER_PROCESSES].enabled) {
@@ -1876,32 +1935,309 @@ ze_result_t cmdConfig::coldResetDevice(devInfo *d)
 		}
 	}
 
-	if (!configCmds[configCmdType::FORCE_RESET_GPUS].enabled) {
-		std::vector<std::string> peers = getDevicesSharingSlotWith(bdfStr);
-		if (!peers.empty()) {
-			ERR("Cold reset aborted: {} other PCI device(s) share the PCIe slot with GPU {} ({})\n"
-				"and would be reset by this operation:\n",
-				peers.size(), d->index, bdfStr);
-			for (const auto &peerBdf : peers) {
-				ERR("  {}\n", peerBdf);
+	std::vector<std::string> peers = getDevicesSharingSlotWith(bdfStr);
+	for (const auto &peerBdf : peers) {
+		const auto requested = std::ranges::find_if(
+			deviceList, [&peerBdf](const devInfo &other) { return other.dev->getBDFStr() == peerBdf; });
+		if (requested != deviceList.end()) {
+			ERR("Cold reset aborted: GPU {} ({}) and GPU {} ({}) share a PCIe slot; request only one of them.\n",
+				d->index, bdfStr, requested->index, peerBdf);
+			return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+		}
+	}
+	if (!peers.empty() && !configCmds[configCmdType::FORCE_RESET_GPUS].enabled) {
+		ERR("Cold reset aborted: {} other PCI device(s) share the PCIe slot with GPU {} ({})\n"
+			"and would be reset by this operation:\n",
+			peers.size(), d->index, bdfStr);
+		for (const auto &peerBdf : peers) {
+			ERR("  {}\n", peerBdf);
+		}
+		ERR("Pass --force-reset-gpus to proceed and reset all listed devices.\n");
+		return ZE_RESULT_ERROR_NOT_AVAILABLE;
+	}
+	return ZE_RESULT_SUCCESS;
+}
+
+/**
+ * @brief Cold resets devices via PCIe slot power cycle.
+ *
+ * Every device is checked with checkColdReset() first; nothing is reset if any
+ * check fails. The slots are then power-cycled concurrently, each reset waiting
+ * for its own device to re-enumerate and rebind.
+ *
+ * Once any device has been reset the process exits via std::_Exit() because
+ * the GPU has disappeared and re-enumerated; outstanding Level Zero handles
+ * are no longer valid and clean teardown is unsafe. The exit status is 0 only
+ * if every reset succeeded.
+ *
+ * @param deviceList Devices to reset, each addressed by PCI BDF.
+ *
+ * @return ze_result_t Result of the checks. The function does not return once
+ *         a reset has been attempted successfully on any device.
+ */
+ze_result_t cmdConfig::coldResetDevices(std::vector<devInfo> &deviceList)
+{
+	TRACING();
+
+	if (!PRIVILEGECHECK()) {
+		ERR("Cold reset requires elevated privileges (root or 'xpum' group on Linux).\n");
+		return ZE_RESULT_ERROR_INSUFFICIENT_PERMISSIONS;
+	}
+
+	for (auto &d : deviceList) {
+		const ze_result_t result = checkColdReset(&d, deviceList);
+		if (result != ZE_RESULT_SUCCESS) {
+			return result;
+		}
+	}
+
+	for (const auto &d : deviceList) {
+		PRINT("Performing cold reset on GPU {} ({}). Please wait ...\n", d.index, d.dev->getBDFStr());
+	}
+
+	const DeviceResults outcome = parallelForEach(deviceList, [](devInfo &d) {
+		PIN_THREAD_TO_DEVICES({d.dev->getBDFStr()});
+		return d.dev->coldResetDevice();
+	});
+	const std::vector<ze_result_t> &results = outcome.results;
+
+	ze_result_t firstError = ZE_RESULT_SUCCESS;
+	bool anyReset = false;
+	for (size_t i = 0; i < deviceList.size(); ++i) {
+		if (results[i] == ZE_RESULT_SUCCESS) {
+			PRINT("Cold reset succeeded for GPU {}\n", deviceList[i].index);
+			anyReset = true;
+		} else {
+			ERR("Failed to cold reset GPU {}: 0x{:X} ({})\n", deviceList[i].index, results[i],
+				l0_error_to_string(results[i]));
+			if (firstError == ZE_RESULT_SUCCESS) {
+				firstError = results[i];
 			}
-			ERR("Pass --force-reset-gpus to proceed and reset all listed devices.\n");
-			return ZE_RESULT_ERROR_NOT_AVAILABLE;
 		}
 	}
 
-	PRINT("Performing cold reset on GPU {} ({}). Please wait ...\n", d->index, bdfStr);
+	if (anyReset) {
+		std::fflush(stdout);
+		std::_Exit(firstError == ZE_RESULT_SUCCESS ? 0 : 1);
+	}
+	return firstError;
+}
+
+/**
+ * @brief Level Zero backed implementation of the profile engine's device operations.
+ *
+ * Reads state through buildDeviceConfig() and writes through the same HAL calls as the
+ * individual --powerlimit / --memoryecc / --standby / --frequencyrange / --scheduler
+ * options, without their console output.
+ */
+class HalDeviceConfigurator : public config_profile::DeviceConfigurator
+{
+public:
+	explicit HalDeviceConfigurator(devInfo *device) : d(device) {}
+
+	ze_result_t readState(config_profile::DeviceState &state) override
+	{
+		ze_result_t status = ZE_RESULT_SUCCESS;
+		state = config_profile::stateFromConfig(buildDeviceConfig(d, &status));
+		return status;
+	}
+
+	ze_result_t applySetting(std::string_view key, const nlohmann::json &value) override
+	{
+		if (key.starts_with("power_limit.")) {
+			return setPowerLimit(key.substr(std::string_view{"power_limit."}.size()), value.get<double>());
+		}
+		if (key == "memory_ecc") {
+			ecc *e = d->dev->getECC();
+			if (e == nullptr) {
+				return ZE_RESULT_ERROR_UNSUPPORTED_FEATURE;
+			}
+			ecc_state_t state = {};
+			return e->setState(d->zesDeviceHdl, value == "enabled" ? 1 : 0, &state);
+		}
+		if (key == "standby_mode") {
+			standby *stby = d->dev->getStandby();
+			if (stby == nullptr) {
+				return ZE_RESULT_ERROR_UNSUPPORTED_FEATURE;
+			}
+			return stby->setMode(value == "never" ? ZES_STANDBY_PROMO_MODE_NEVER : ZES_STANDBY_PROMO_MODE_DEFAULT);
+		}
 
-	ze_result_t result = d->dev->coldResetDevice();
+		int32_t tileId = -1;
+		char setting[32] = {};
+		if (std::sscanf(std::string{key}.c_str(), "tile.%d.%31s", &tileId, setting) != 2 || tileId < 0) {
+			return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+		}
+		frequency *fq = d->dev->getFrequency();
+		if (fq == nullptr) {
+			return ZE_RESULT_ERROR_UNSUPPORTED_FEATURE;
+		}
+		const std::string_view name{setting};
+		const auto tile = static_cast<uint32_t>(tileId);
+		if (name == "frequency_range") {
+			return fq->setFrequencyRange(value[0].get<double>(), value[1].get<double>(), tileId);
+		}
+		if (name == "scheduler") {
+			const auto mode = value["mode"].get<std::string>();
+			if (mode == "timeout") {
+				return fq->setSchedulerTimeoutMode(tile, value["timeout"].get<uint64_t>());
+			}
+			if (mode == "timeslice") {
+				return fq->setSchedulerTimesliceMode(tile, value["interval"].get<uint64_t>(),
+													 value["yield_timeout"].get<uint64_t>());
+			}
+			return fq->setSchedulerExclusiveMode(tile);
+		}
+		return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+	}
+
+private:
+	ze_result_t setPowerLimit(std::string_view level, double watts)
+	{
+		const uint32_t limitMw = wToMw(watts);
+		powerExp *pwrExp = d->dev->getPowerExp();
+		if (pwrExp != nullptr && pwrExp->isPowerExpEnabled()) {
+			return level == "sustain" ? pwrExp->setPowerLimit(limitMw) : ZE_RESULT_ERROR_UNSUPPORTED_FEATURE;
+		}
+		power *pwr = d->dev->getPower();
+		if (pwr == nullptr) {
+			return ZE_RESULT_ERROR_UNSUPPORTED_FEATURE;
+		}
+		const zes_power_level_t zesLevel = (level == "burst")  ? ZES_POWER_LEVEL_BURST
+										   : (level == "peak") ? ZES_POWER_LEVEL_PEAK
+															   : ZES_POWER_LEVEL_SUSTAINED;
+		return pwr->setLimitsExt(-1, zesLevel, limitMw);
+	}
+
+	devInfo *d;
+};
+
+// Set from SIGINT/SIGTERM while a profile is being applied
+static std::atomic<bool> profileAbortRequested{false};
+
+static void onProfileSignal(int /*signal*/) { profileAbortRequested.store(true); }
+
+/**
+ * @brief Applies the declarative configuration profile given with --profile.
+ *
+ * Reads and validates the profile, plans the changes for every matched device against its
+ * current configuration and applies them to all devices concurrently. Every value is read
+ * back to verify it; if any device fails, or the user interrupts with Ctrl-C, all devices
+ * are restored to their previous values. With --dry-run only the plan is printed.
+ *
+ * @param[in] deviceList Devices selected with --device (all devices when omitted).
+ * @return ze_result_t ZE_RESULT_SUCCESS when the profile was applied and verified.
+ */
+ze_result_t cmdConfig::applyProfile(std::vector<devInfo> &deviceList)
+{
+	TRACING();
+	const std::string &path = configCmds[configCmdType::PROFILE].val;
+	std::ifstream file(path);
+	if (!file) {
+		ERR("Error: Cannot open profile '{}'.\n", path.c_str());
+		return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+	}
+	nlohmann::json doc = nlohmann::json::parse(file, nullptr, false);
+	if (doc.is_discarded()) {
+		ERR("Error: Profile '{}' is not valid JSON.\n", path.c_str());
+		return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+	}
+
+	std::vector<config_profile::ProfileEntry> entries;
+	std::string error;
+	if (!config_profile::parseProfile(doc, entries, error)) {
+		ERR("Error: Invalid profile '{}': {}\n", path.c_str(), error.c_str());
+		return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+	}
+
+	// Match profile entries to devices; later entries refine earlier ones
+	std::vector<HalDeviceConfigurator> configurators;
+	configurators.reserve(deviceList.size());
+	std::vector<config_profile::DeviceJob> jobs;
+	for (auto &device : deviceList) {
+		nlohmann::json settings = nlohmann::json::object();
+		for (const auto &entry : entries) {
+			if (entry.device == "all" || entry.device == std::to_string(device.index) ||
+				device.dev->isBDF(entry.device.c_str())) {
+				config_profile::mergeSettings(settings, entry.settings);
+			}
+		}
+		if (settings.empty()) {
+			continue;
+		}
+		configurators.emplace_back(&device);
+		jobs.push_back({.index = device.index,
+						.device = &configurators.back(),
+						.settings = std::move(settings),
+						.placeWorker = [bdf = device.dev->getBDFStr()] { PIN_THREAD_TO_DEVICES({bdf}); }});
+	}
+	if (jobs.empty()) {
+		ERR("Error: Profile '{}' does not match any selected device.\n", path.c_str());
+		return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+	}
+
+	ze_result_t result = config_profile::planProfile(jobs);
 	if (result != ZE_RESULT_SUCCESS) {
-		ERR("Failed to cold reset device: 0x{:X} ({})\n", result, l0_error_to_string(result));
+		for (const auto &job : jobs) {
+			if (job.result != ZE_RESULT_SUCCESS) {
+				ERR("GPU {}: {}\n", job.index, job.failure.c_str());
+			}
+		}
+		ERR("No changes were made.\n");
 		return result;
 	}
 
-	PRINT("Cold reset succeeded for GPU {}\n", d->index);
-	std::fflush(stdout);
-	std::_Exit(0);
-	return ZE_RESULT_SUCCESS;
+	size_t totalChanges = 0;
+	for (const auto &job : jobs) {
+		if (job.plan.empty()) {
+			PRINT("GPU {}: configuration already matches the profile\n", job.index);
+		}
+		for (const auto &change : job.plan) {
+			PRINT("GPU {}: {} {} -> {}\n", job.index, change.key.c_str(), change.from.dump().c_str(),
+				  change.to.dump().c_str());
+		}
+		totalChanges += job.plan.size();
+	}
+	if (configCmds[configCmdType::DRYRUN].enabled || totalChanges == 0) {
+		return ZE_RESULT_SUCCESS;
+	}
+
+	profileAbortRequested = false;
+	auto previousInt = std::signal(SIGINT, onProfileSignal);
+	auto previousTerm = std::signal(SIGTERM, onProfileSignal);
+	result = config_profile::applyProfile(jobs, profileAbortRequested);
+	std::signal(SIGINT, previousInt);
+	std::signal(SIGTERM, previousTerm);
+
+	if (result == ZE_RESULT_SUCCESS) {
+		PRINT("Succeeded in applying the configuration profile to {} GPU(s) ({} change(s)).\n", jobs.size(),
+			  totalChanges);
+		return result;
+	}
+
+	for (const auto &job : jobs) {
+		if (job.result != ZE_RESULT_SUCCESS) {
+			if (job.failedKey.empty()) {
+				ERR("GPU {}: {}\n", job.index, job.failure.c_str());
+			} else {
+				ERR("GPU {}: {} {}: {}\n", job.index, job.failedKey.c_str(), job.failure.c_str(),
+					l0_error_to_string(job.result));
+			}
+		}
+	}
+	for (const auto &job : jobs) {
+		if (!job.rolledBack) {
+			continue;
+		}
+		if (job.rollbackResult == ZE_RESULT_SUCCESS) {
+			PRINT("GPU {}: previous configuration restored.\n", job.index);
+		} else {
+			ERR("GPU {}: failed to restore the previous configuration; check it with 'config -d {}'.\n", job.index,
+				job.index);
+		}
+	}
+	ERR("Failed to apply the configuration profile.\n");
+	return result;
 }
 
 /**
@@ -1987,11 +2323,20 @@ int cmdConfig::run(arg_struct *args)
 				   "Target fan ID (-1 = all fans, 0..N-1 = specific fan)")
 		->each([&](const std::string &) { configCmds[configCmdType::FANID].enabled = true; });
 	sub.add_flag("--coldreset", configCmds[configCmdType::COLDRESET].enabled,
-				 "Cold-reset the device (requires PCI BDF address for --device, not a device index)");
+				 "Cold-reset the device (requires PCI BDF addresses for --device, comma-separated, not device "
+				 "indices)");
 	sub.add_flag("--ignore-gpu-user-processes", configCmds[configCmdType::IGNORE_GPU_USER_PROCESSES].enabled,
 				 "Skip check for running GPU user processes before reset");
 	sub.add_flag("--force-reset-gpus", configCmds[configCmdType::FORCE_RESET_GPUS].enabled,
 				 "Force GPU reset even if user processes are present");
+	sub.add_option("--profile", configCmds[configCmdType::PROFILE].val,
+				   "Apply a JSON configuration profile to all matching devices")
+		->each([&](const std::string &) {
+			configCmds[configCmdType::PROFILE].enabled = true;
+			isQueryMode = false;
+		});
+	sub.add_flag("--dry-run", configCmds[configCmdType::DRYRUN].enabled,
+				 "With --profile, print the changes without applying them");
 
 	try {
 		sub.parse(args->argc - 1, args->argv + 1);
@@ -2010,6 +2355,41 @@ int cmdConfig::run(arg_struct *args)
 		isQueryMode = false;
 	}
 
+	if (configCmds[configCmdType::PROFILE].enabled) {
+		// A profile is applied on its own; it selects devices and tiles itself
+		if (configCmds[configCmdType::TILE].enabled) {
+			ERR("--profile does not support tile ID; list tiles in the profile instead.\n");
+			return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+		}
+		for (const auto &[type, cmd] : configCmds) {
+			if (!cmd.enabled || type == configCmdType::PROFILE || type == configCmdType::CONFIGDEVICE ||
+				type == configCmdType::DRYRUN) {
+				continue;
+			}
+			// Includes the flags without a setter, such as --reset, --coldreset and --json
+			ERR("--profile cannot be combined with other configuration options.\n");
+			return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+		}
+		// Without --device the profile is matched against all devices
+		result = args->sm.findDevice(configCmds[configCmdType::CONFIGDEVICE].val.c_str(), &deviceList);
+		if (result != ZE_RESULT_SUCCESS) {
+			ERR("Error: Device handle not found for device ID '{}'.\n",
+				configCmds[configCmdType::CONFIGDEVICE].val.c_str());
+			return result;
+		}
+		const DeviceLocks locks = lockDevices(
+			deviceList, configCmds[configCmdType::DRYRUN].enabled ? DeviceLockMode::SHARED : DeviceLockMode::EXCLUSIVE);
+		if (!locks.locked()) {
+			return ZE_RESULT_ERROR_NOT_AVAILABLE;
+		}
+		return applyProfile(deviceList);
+	}
+
+	if (configCmds[configCmdType::DRYRUN].enabled) {
+		ERR("--dry-run requires --profile.\n");
+		return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+	}
+
 	// Check if the device ID is provided
 	if (configCmds[configCmdType::CONFIGDEVICE].val.empty()) {
 		ERR("Device ID is required.\n");
@@ -2017,19 +2397,33 @@ int cmdConfig::run(arg_struct *args)
 	}
 
 	if (configCmds[configCmdType::COLDRESET].enabled) {
-		const std::string &devArg = configCmds[configCmdType::CONFIGDEVICE].val;
-		if (!isValidBdf(devArg)) {
-			ERR("Cold reset requires a PCI BDF address in DDDD:BB:DD.F format "
-				"(e.g. 0000:4d:00.0), not a device ID.\n");
-			return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+		// Cold reset accepts a comma-separated list of BDFs; the slots are power-cycled concurrently
+		std::string_view devArg = configCmds[configCmdType::CONFIGDEVICE].val;
+		while (!devArg.empty()) {
+			const auto comma = devArg.find(',');
+			const std::string bdf{devArg.substr(0, comma)};
+			devArg.remove_prefix(comma == std::string_view::npos ? devArg.size() : comma + 1);
+			if (!isValidBdf(bdf)) {
+				ERR("Cold reset requires PCI BDF addresses in DDDD:BB:DD.F format "
+					"(e.g. 0000:4d:00.0), not device IDs.\n");
+				return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+			}
+			if (std::ranges::any_of(deviceList, [&bdf](const devInfo &d) { return d.dev->getBDFStr() == bdf; })) {
+				continue;
+			}
+			result = args->sm.findDevice(bdf.c_str(), &deviceList);
+			if (result != ZE_RESULT_SUCCESS) {
+				ERR("Error: Device handle not found for device ID '{}'.\n", bdf.c_str());
+				return result;
+			}
+		}
+	} else {
+		result = args->sm.findDevice(configCmds[configCmdType::CONFIGDEVICE].val.c_str(), &deviceList);
+		if (result != ZE_RESULT_SUCCESS) {
+			ERR("Error: Device handle not found for device ID '{}'.\n",
+				configCmds[configCmdType::CONFIGDEVICE].val.c_str());
+			return result;
 		}
-	}
-
-	result = args->sm.findDevice(configCmds[configCmdType::CONFIGDEVICE].val.c_str(), &deviceList);
-	if (result != ZE_RESULT_SUCCESS) {
-		ERR("Error: Device handle not found for device ID '{}'.\n",
-			configCmds[configCmdType::CONFIGDEVICE].val.c_str());
-		return result;
 	}
 
 	if (configCmds[configCmdType::RESET].enabled) {
@@ -2048,12 +2442,18 @@ int cmdConfig::run(arg_struct *args)
 			ERR("Cold reset does not support tile ID.\n");
 			return ZE_RESULT_ERROR_INVALID_ARGUMENT;
 		}
-		if (deviceList.size() != 1) {
-			ERR("Cold reset requires a single PCI BDF.\n");
+		if (deviceList.empty()) {
+			ERR("Cold reset requires at least one PCI BDF.\n");
 			return ZE_RESULT_ERROR_INVALID_ARGUMENT;
 		}
 	}
 
+	// Setting, resetting and cold resetting must not overlap an update or reset by another process
+	const DeviceLocks locks = lockDevices(deviceList, isQueryMode ? DeviceLockMode::SHARED : DeviceLockMode::EXCLUSIVE);
+	if (!locks.locked()) {
+		return ZE_RESULT_ERROR_NOT_AVAILABLE;
+	}
+
 	// If this is query mode, display configuration
 	if (isQueryMode) {
 		if (configCmds[configCmdType::CONFIGJSON].enabled) {
@@ -2102,6 +2502,14 @@ int cmdConfig::run(arg_struct *args)
 		}
 	}
 
+	if (configCmds[configCmdType::COLDRESET].enabled) {
+		result = coldResetDevices(deviceList);
+		if (result != ZE_RESULT_SUCCESS && !hadError) {
+			firstError = result;
+			hadError = true;
+		}
+	}
+
 	// Return the first error encountered, or success if all succeeded
 	return hadError ? firstError : ZE_RESULT_SUCCESS;
 }
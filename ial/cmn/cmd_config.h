@@ -10,6 +10,7 @@
 #include "cmds.h"
 #include <os.h>
 #include <string>
+#include <vector>
 
 enum configCmdType
 {
@@ -33,6 +34,8 @@ enum configCmdType
 	FANCURVE,
 	FANCURVERPM,
 	FANID,
+	PROFILE,
+	DRYRUN,
 	TOTAL_CONFIG,
 };
 
@@ -58,7 +61,9 @@ public:
 	ze_result_t setFanCurve(devInfo *d);
 	ze_result_t setFanCurveRpm(devInfo *d);
 	ze_result_t getSelectedFanId(int32_t &fanId);
-	ze_result_t coldResetDevice(devInfo *d);
+	ze_result_t checkColdReset(devInfo *d, const std::vector<devInfo> &deviceList);
+	ze_result_t coldResetDevices(std::vector<devInfo> &deviceList);
+	ze_result_t applyProfile(std::vector<devInfo> &deviceList);
 	int run(arg_struct *args);
 };
 
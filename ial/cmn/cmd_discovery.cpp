@@ -10,6 +10,8 @@
 #include "printer.h"
 #include "table_builder.h"
 #include "amclib.h"
+#include <amcupd.h>
+#include <algorithm>
 #include <array>
 #include <assert.h>
 #include <charconv>
@@ -17,13 +19,17 @@
 #include <firmware.h>
 #include <format>
 #include <fstream>
+#include <functional>
 #include <gscupd.h>
 #include <iomanip>
+#include <iterator>
 #include <memory.h>
+#include <optional>
 #include <pci.h>
 #include <ranges>
 #include <span>
 #include <sstream>
+#include <task_executor.h>
 
 /**
  * @brief This structure serves two purposes:
@@ -547,6 +553,41 @@ ze_result_t cmdDiscovery::dump(devInfo *d, nlohmann::ordered_json *jsonObj)
 	return result;
 }
 
+/**
+ * @brief Tells whether the dumpAll command runs, which is when no option other than the
+ *        device and JSON ones is specified
+ */
+static bool dumpAllSelected()
+{
+	for (const auto &cmd : discCmds) {
+		if (cmd.second.enabled && (cmd.first != discCmdType::DISC_DEVICE && cmd.first != discCmdType::DISC_JSON)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Returns the value of a property the schema documents as a JSON number
+ *
+ * The property map stores every value as text, but several documented fields are
+ * JSON numbers in the schema.
+ *
+ * @return std::optional<long long> The number, or nullopt when the property is text
+ */
+static std::optional<long long> numericProperty(const std::string &key, const std::string &value)
+{
+	if (key != "number_of_tiles" && key != "number_of_eus" && key != "memory_physical_size_byte") {
+		return std::nullopt;
+	}
+	long long number = 0;
+	const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), number);
+	if (ec != std::errc{} || ptr != value.data() + value.size()) {
+		return std::nullopt;
+	}
+	return number;
+}
+
 /**
  * @brief Executes the dumpAll command. This command dumps all the device properties
  *
@@ -562,11 +603,9 @@ ze_result_t cmdDiscovery::dumpAll(devInfo *d, nlohmann::ordered_json *jsonObj)
 	ze_result_t result = ZE_RESULT_SUCCESS;
 
 	// We should dump all properties for a device only when no other command line options are specified.
-	for (const auto &cmd : discCmds) {
-		if (cmd.second.enabled && (cmd.first != discCmdType::DISC_DEVICE && cmd.first != discCmdType::DISC_JSON)) {
-			// Silently return if any other command line options are specified
-			return result;
-		}
+	if (!dumpAllSelected()) {
+		// Silently return if any other command line options are specified
+		return result;
 	}
 
 	DeviceProperties props;
@@ -577,136 +616,329 @@ ze_result_t cmdDiscovery::dumpAll(devInfo *d, nlohmann::ordered_json *jsonObj)
 
 	*jsonObj = props;
 
-	// The property map stores every value as text, but several documented
-	// fields are JSON numbers in the schema. Promote the known-numeric keys
-	// from their string form to integers so the emitted JSON matches the
-	// documented shape (and ordered_json keeps their original position).
+	// Promote the known-numeric keys from their string form so the emitted JSON matches
+	// the documented shape (and ordered_json keeps their original position).
 	(*jsonObj)["device_id"] = d->index;
-	auto promoteToInteger = [&](const char *key) {
-		auto it = props.find(key);
-		if (it == props.end()) {
-			return;
-		}
-		const std::string &s = it->second;
-		long long value = 0;
-		const auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), value);
-		if (ec == std::errc{} && ptr == s.data() + s.size()) {
-			(*jsonObj)[key] = value;
+	for (const auto &[key, value] : props) {
+		if (const auto number = numericProperty(key, value)) {
+			(*jsonObj)[key] = *number;
 		}
-	};
-	promoteToInteger("number_of_tiles");
-	promoteToInteger("number_of_eus");
-	promoteToInteger("memory_physical_size_byte");
+	}
 
 	return result;
 }
 
 /**
- * @brief Gathers all device properties into a map (decoupled from JSON)
- *
- * @param[in] d Pointer to device info structure
- * @param[out] props Output map to populate with key-value pairs (string keys and values)
+ * @brief Streaming counterpart of dumpAll: writes the properties of a device as one
+ *        object, in the order and with the types dumpAll gives them
  *
- * @retval ZE_RESULT_SUCCESS Successfully gathered all device properties
- * @retval ZE_RESULT_ERROR_* Error occurred during property retrieval
+ * @param[in] d Pointer to the device info structure
+ * @param[in] props Properties gatherDeviceProperties() collected for the device
+ * @param[in] writer Writer of the JSON printer
  */
-ze_result_t cmdDiscovery::gatherDeviceProperties(devInfo *d, DeviceProperties &props)
+void cmdDiscovery::writeDeviceProperties(devInfo *d, const DeviceProperties &props, JsonStreamWriter &writer)
 {
 	TRACING();
-	std::string outputLine;
-	ze_result_t result = ZE_RESULT_SUCCESS;
-
-	firmware *fw = d->dev->getFirmware();
-	bool hasAmc = (fw && fw->hasAmcFirmware());
-
-	if (hasAmc) {
-		amcFirmwareName(d, &outputLine);
-		props["amc_firmware_name"] = outputLine;
-
-		amcFirmwareVersion(d, &outputLine);
-		props["amc_firmware_version"] = outputLine;
+	writer.beginObject();
+	for (const auto &[key, value] : props) {
+		writer.key(key);
+		if (key == "device_id") {
+			writer.value(d->index);
+		} else if (const auto number = numericProperty(key, value)) {
+			writer.value(*number);
+		} else {
+			writer.value(value);
+		}
 	}
+	writer.endObject();
+}
 
-	deviceID(d, &outputLine);
-	props["device_id"] = outputLine;
-
-	deviceName(d, &outputLine);
-	props["device_name"] = outputLine;
-
-	props["device_state"] = d->dev->isInSurvMode() ? DEVICE_STATE_SURV_MODE : DEVICE_STATE_NORMAL;
-	vendorName(d, &outputLine);
-	props["vendor_name"] = outputLine;
-
-	socUuid(d, &outputLine);
-	props["uuid"] = outputLine;
-
-	serialNumber(d, &outputLine);
-	props["serial_number"] = outputLine;
-
-	stepping(d, &outputLine);
-	props["device_stepping"] = outputLine;
-
-	driverVersion(d, &outputLine);
-	props["driver_version"] = outputLine;
-
-	gfxFirmwareVersion(d, &outputLine);
-	props["gfx_firmware_version"] = outputLine;
-
-	gfxDataFirmwareVersion(d, &outputLine);
-	props["gfx_data_firmware_version"] = outputLine;
-
-	pciBDFAddress(d, &outputLine);
-	props["pci_bdf_address"] = outputLine;
-
-	pciSlot(d, &outputLine);
-	props["pci_slot"] = outputLine;
-
-	pcieGeneration(d, &outputLine);
-	props["pcie_generation"] = outputLine;
+/**
+ * @brief Formats a device UUID the way --dump 4 prints it, most significant byte first
+ */
+static std::string formatUuid(const ze_device_uuid_t &uuid)
+{
+	char output[256] = {0};
+	snprintf(output, sizeof(output), "%02x%02x%02x%02x-%02x%02x-%02x%02x-%02x%02x-%02x%02x%02x%02x%02x%02x",
+			 uuid.id[15], uuid.id[14], uuid.id[13], uuid.id[12], uuid.id[11], uuid.id[10], uuid.id[9], uuid.id[8],
+			 uuid.id[7], uuid.id[6], uuid.id[5], uuid.id[4], uuid.id[3], uuid.id[2], uuid.id[1], uuid.id[0]);
+	return output;
+}
 
-	pcieMaxLinkWidth(d, &outputLine);
-	props["pcie_max_link_width"] = outputLine;
+/**
+ * @brief Extracts the stepping from a Sysman model name (e.g., "BMG A0" -> "A0")
+ *
+ * @return The stepping, or "A0" when the model name does not end in one
+ */
+static std::string steppingOf(const std::string &modelName)
+{
+	// The modelName typically contains platform code and stepping
+	size_t lastSpace = modelName.find_last_of(' ');
+	if (lastSpace != std::string::npos && lastSpace + 1 < modelName.length()) {
+		std::string stepping = modelName.substr(lastSpace + 1);
+		// Verify it looks like a stepping (e.g., "A0", "B1")
+		if (stepping.length() >= 2 && isalpha(stepping[0]) && isdigit(stepping[1])) {
+			return stepping;
+		}
+	}
+	return "A0"; // Default fallback
+}
 
-	memoryChannels(d, &outputLine);
-	props["number_of_memory_channels"] = outputLine;
+/**
+ * @brief Name of a Level Zero device type ("GPU", etc.)
+ */
+static std::string deviceTypeName(ze_device_type_t type)
+{
+	switch (type) {
+	case ZE_DEVICE_TYPE_GPU:
+		return "GPU";
+	case ZE_DEVICE_TYPE_CPU:
+		return "CPU";
+	case ZE_DEVICE_TYPE_FPGA:
+		return "FPGA";
+	case ZE_DEVICE_TYPE_MCA:
+		return "MCA";
+	default:
+		return "Unknown";
+	}
+}
 
-	memoryBusWidth(d, &outputLine);
-	props["memory_bus_width"] = outputLine;
+/**
+ * @brief Name of a Sysman ECC state ("enabled", "disabled" or "unavailable")
+ */
+static std::string eccStateName(zes_device_ecc_state_t state)
+{
+	switch (state) {
+	case ZES_DEVICE_ECC_STATE_ENABLED:
+		return "enabled";
+	case ZES_DEVICE_ECC_STATE_DISABLED:
+		return "disabled";
+	default:
+		return "unavailable";
+	}
+}
 
-	eus(d, &outputLine);
-	props["number_of_eus"] = outputLine;
+/**
+ * @brief Bandwidth of the fastest link the PCI properties allow (format: "X.XX GB/s"), "N/A" when unknown
+ */
+static std::string pcieBandwidthOf(const zes_pci_properties_t &pciProps)
+{
+	// If the PCI information is unavailable display N/A
+	if (pciProps.maxSpeed.width == -1) {
+		return "N/A";
+	}
+	// Calculate bandwidth based on PCIe generation and width
+	// Formula: (width * gen_rate) where gen_rate depends on PCIe generation
+	// Gen 1: ~250 MB/s per lane, Gen 2: ~500 MB/s, Gen 3: ~985 MB/s (1 GB/s), Gen 4: ~1969 MB/s (2 GB/s), Gen 5: ~3938
+	// MB/s (4 GB/s)
+	double laneRate = 0.985; // Gen 3 default GB/s per lane
+	if (pciProps.maxSpeed.gen == 1)
+		laneRate = 0.25;
+	else if (pciProps.maxSpeed.gen == 2)
+		laneRate = 0.5;
+	else if (pciProps.maxSpeed.gen == 3)
+		laneRate = 0.985;
+	else if (pciProps.maxSpeed.gen == 4)
+		laneRate = 1.969;
+	else if (pciProps.maxSpeed.gen == 5)
+		laneRate = 3.938;
+	else if (pciProps.maxSpeed.gen >= 6)
+		laneRate = 7.877;
 
-	mediaEngines(d, &outputLine);
-	props["number_of_media_engines"] = outputLine;
+	double bandwidth = pciProps.maxSpeed.width * laneRate; // GB/s
+	return std::format("{:.2f} GB/s", bandwidth);
+}
 
-	mediaEnhancementEngines(d, &outputLine);
-	props["number_of_media_enh_engines"] = outputLine;
+/**
+ * @brief Stores what @p getter reports for a device under @p key, or an empty value when it fails
+ */
+static void putProperty(cmdDiscovery &cmd, devInfo *d, DeviceProperties &props, const char *key,
+						discoverySubCmdFunc getter)
+{
+	std::string value;
+	if ((cmd.*getter)(d, &value) != ZE_RESULT_SUCCESS) {
+		value.clear();
+	}
+	props[key] = std::move(value);
+}
 
-	props["gfx_firmware_name"] = "GFX";
-	props["gfx_data_firmware_name"] = "GFX_DATA";
+/**
+ * @brief Gathers all device properties into a map (decoupled from JSON)
+ *
+ * @param[in] d Pointer to device info structure
+ * @param[out] props Output map to populate with key-value pairs (string keys and values)
+ *
+ * @retval ZE_RESULT_SUCCESS Successfully gathered all device properties
+ * @retval ZE_RESULT_ERROR_* Error occurred during property retrieval
+ */
+ze_result_t cmdDiscovery::gatherDeviceProperties(devInfo *d, DeviceProperties &props)
+{
+	TRACING();
+	std::vector<DeviceProperties> all;
+	const DeviceResults outcome = gatherDeviceProperties(std::span{d, 1}, all);
+	props = std::move(all.front());
+	return outcome.first();
+}
 
-	gfxFirmwareStatus(d, &outputLine);
-	props["gfx_firmware_status"] = outputLine;
+/**
+ * @brief Gathers the properties of several devices, one map per device
+ *
+ * The properties come from backends with very different latencies, so they are gathered
+ * in groups, one per backend, that run concurrently: Level Zero, the IGSC/MEI firmware
+ * interface, the AMC over I2C and sysfs. A group shares its backend calls among all its
+ * fields. The Sysman properties are read first since they decide whether the serial
+ * number has to come from the AMC. The groups are merged in a fixed order, and the map
+ * orders the keys, so the result does not depend on which group finishes first.
+ *
+ * Both steps are one flat fan-out over all devices, and every task pins itself to its
+ * device: a device task waiting on a nested fan-out would run some of it on its own
+ * thread, outside the pin of the task that asked for it.
+ *
+ * @param[in] devices Devices to gather the properties of
+ * @param[out] props One map per device, in the order of @p devices
+ *
+ * @return One result per device: ZE_RESULT_SUCCESS, or the first error of its groups
+ */
+DeviceResults cmdDiscovery::gatherDeviceProperties(std::span<devInfo> devices, std::vector<DeviceProperties> &props)
+{
+	TRACING();
+	props.assign(devices.size(), {});
+
+	struct PropertyGroup
+	{
+		size_t device;
+		std::string bdf;
+		std::function<void(DeviceProperties &)> gather;
+		DeviceProperties props;
+	};
+	std::vector<std::vector<PropertyGroup>> groupsOf(devices.size());
+
+	DeviceResults outcome = parallelForEach(std::views::iota(size_t{0}, devices.size()), [&](size_t i) {
+		devInfo *d = &devices[i];
+		const std::string bdf = d->dev->getBDFStr();
+		PIN_THREAD_TO_DEVICES({bdf});
+
+		firmware *fw = d->dev->getFirmware();
+		const bool hasAmc = (fw && fw->hasAmcFirmware());
+
+		DeviceProperties &base = props[i];
+		base["device_id"] = std::to_string(d->index);
+		base["oam_socket_id"] = "N/A";
+
+		// One zesDeviceGetProperties serves every field taken from the Sysman properties
+		zes_device_properties_t zesDevProp = {};
+		const bool haveSysmanProps = d->dev->zesGetDevProps(d->zesDeviceHdl, &zesDevProp) == ZE_RESULT_SUCCESS;
+		base["vendor_name"] = haveSysmanProps ? zesDevProp.vendorName : "";
+		base["serial_number"] = haveSysmanProps ? zesDevProp.serialNumber : "";
+		base["device_stepping"] = haveSysmanProps ? steppingOf(zesDevProp.modelName) : "";
+		base["sku_type"] = haveSysmanProps ? "Production ES" : "";
+		const bool serialFromAmc = haveSysmanProps && strcmp(zesDevProp.serialNumber, "unknown") == 0;
+
+		auto &groups = groupsOf[i];
+		groups.push_back({i, bdf, [this, d](DeviceProperties &out) { gatherLevelZeroProperties(d, out); }, {}});
+		groups.push_back(
+			{i, bdf, [this, d, hasAmc](DeviceProperties &out) { gatherFirmwareProperties(d, hasAmc, out); }, {}});
+		groups.push_back({i, bdf, [this, d](DeviceProperties &out) { gatherSysfsProperties(d, out); }, {}});
+		if (hasAmc || serialFromAmc) {
+			groups.push_back({i, bdf,
+							  [this, d, hasAmc, serialFromAmc](DeviceProperties &out) {
+								  gatherAmcProperties(d, hasAmc, serialFromAmc, out);
+							  },
+							  {}});
+		}
+		return ZE_RESULT_SUCCESS;
+	});
 
-	// OPROM and GFX_PSCBIN are also only on devices with AMC
-	if (hasAmc) {
-		gfxPscBinFirmwareName(d, &outputLine);
-		props["gfx_pscbin_firmware_name"] = outputLine;
+	std::vector<PropertyGroup> groups;
+	for (auto &deviceGroups : groupsOf) {
+		std::ranges::move(deviceGroups, std::back_inserter(groups));
+	}
+	const DeviceResults gathered = parallelForEach(groups, [](PropertyGroup &group) {
+		PIN_THREAD_TO_DEVICES({group.bdf});
+		group.gather(group.props);
+		return ZE_RESULT_SUCCESS;
+	});
 
-		gfxPscBinFirmwareVersion(d, &outputLine);
-		props["gfx_pscbin_firmware_version"] = outputLine;
+	// A later group wins a key reported twice: the AMC serial number replaces an unknown one
+	for (size_t k = 0; k < groups.size(); ++k) {
+		const size_t i = groups[k].device;
+		for (auto &[key, value] : groups[k].props) {
+			props[i][key] = std::move(value);
+		}
+		if (outcome.results[i] == ZE_RESULT_SUCCESS) {
+			outcome.results[i] = gathered.results[k];
+		}
+	}
+	return outcome;
+}
 
-		opromCodeFirmwareName(d, &outputLine);
-		props["oprom_code_firmware_name"] = outputLine;
+/**
+ * @brief Level Zero group of gatherDeviceProperties(): device, PCI, memory and engine properties
+ *
+ * One zeDeviceGetProperties, with the EU count chained to it, and one PCI properties query
+ * serve all fields taken from them.
+ *
+ * @param[in] d Pointer to device info structure
+ * @param[out] props Map to add the properties of the group to
+ */
+void cmdDiscovery::gatherLevelZeroProperties(devInfo *d, DeviceProperties &props)
+{
+	TRACING();
 
-		opromCodeFirmwareVersion(d, &outputLine);
-		props["oprom_code_firmware_version"] = outputLine;
+	ze_eu_count_ext_t euCount = {};
+	euCount.stype = ZE_STRUCTURE_TYPE_EU_COUNT_EXT;
+	ze_device_properties_t zeDevProp = {};
+	zeDevProp.stype = ZE_STRUCTURE_TYPE_DEVICE_PROPERTIES;
+	zeDevProp.pNext = &euCount;
+	const bool haveDevProps = d->dev->getDevProps(d->deviceHdl, &zeDevProp) == ZE_RESULT_SUCCESS;
+	if (haveDevProps) {
+		props["device_name"] = zeDevProp.name;
+		props["uuid"] = formatUuid(zeDevProp.uuid);
+		props["core_clock_rate"] = std::format("{} MHz", zeDevProp.coreClockRate);
+		props["number_of_eus"] = std::to_string(euCount.numTotalEUs);
+		props["pci_vendor_id"] = std::format("0x{:x}", zeDevProp.vendorId);
+		props["pci_device_id"] = std::format("0x{:x}", zeDevProp.deviceId);
+		props["number_of_tiles"] = std::to_string(zeDevProp.numSlices > 0 ? 1 : 0);
+		props["number_of_slices"] = std::to_string(zeDevProp.numSlices);
+		props["number_of_sub_slices_per_slice"] = std::to_string(zeDevProp.numSubslicesPerSlice);
+		props["number_of_eus_per_sub_slice"] = std::to_string(zeDevProp.numEUsPerSubslice);
+		props["number_of_threads_per_eu"] = std::to_string(zeDevProp.numThreadsPerEU);
+		props["physical_eu_simd_width"] = std::to_string(zeDevProp.physicalEUSimdWidth);
+		props["max_hardware_contexts"] = std::to_string(zeDevProp.maxHardwareContexts);
+		props["max_mem_alloc_size_byte"] = std::to_string(zeDevProp.maxMemAllocSize);
+		props["device_type"] = deviceTypeName(zeDevProp.type);
+	} else {
+		for (const char *key :
+			 {"device_name", "uuid", "core_clock_rate", "number_of_eus", "pci_vendor_id", "pci_device_id",
+			  "number_of_tiles", "number_of_slices", "number_of_sub_slices_per_slice", "number_of_eus_per_sub_slice",
+			  "number_of_threads_per_eu", "physical_eu_simd_width", "max_hardware_contexts", "max_mem_alloc_size_byte",
+			  "device_type"}) {
+			props[key] = "";
+		}
+	}
 
-		opromDataFirmwareName(d, &outputLine);
-		props["oprom_data_firmware_name"] = outputLine;
+	// The runtime state from Sysman, else the ECC flag of the device properties
+	zes_device_ecc_properties_t eccState = {};
+	if (zesDeviceGetEccState(d->zesDeviceHdl, &eccState) == ZE_RESULT_SUCCESS) {
+		props["memory_ecc_state"] = eccStateName(eccState.currentState);
+	} else if (haveDevProps) {
+		props["memory_ecc_state"] = (zeDevProp.flags & ZE_DEVICE_PROPERTY_FLAG_ECC) ? "enabled" : "disabled";
+	} else {
+		props["memory_ecc_state"] = "";
+	}
 
-		opromDataFirmwareVersion(d, &outputLine);
-		props["oprom_data_firmware_version"] = outputLine;
+	zes_pci_properties_t pciProps = {};
+	auto *const p = d->dev->getPCI();
+	if (const auto result = p->getProperties(d->zesDeviceHdl, &pciProps); result == ZE_RESULT_SUCCESS) {
+		props["pcie_generation"] = (pciProps.maxSpeed.gen == -1) ? "N/A" : std::to_string(pciProps.maxSpeed.gen);
+		props["pcie_max_link_width"] =
+			(pciProps.maxSpeed.width == -1) ? "N/A" : std::to_string(pciProps.maxSpeed.width);
+		props["pcie_max_bandwidth"] = pcieBandwidthOf(pciProps);
+	} else {
+		ERR("Failed to get PCI properties: 0x{:X} ({})\n", result, l0_error_to_string(result));
+		props["pcie_generation"] = "";
+		props["pcie_max_link_width"] = "";
+		props["pcie_max_bandwidth"] = "";
 	}
 
 	uint64_t physicalSize = 0;
@@ -716,68 +948,96 @@ ze_result_t cmdDiscovery::gatherDeviceProperties(devInfo *d, DeviceProperties &p
 	props["memory_physical_size"] = std::format("{:.2f} MiB", physicalSizeMiB);
 	props["memory_physical_size_byte"] = std::to_string(physicalSize);
 
-	pciVendorID(d, &outputLine);
-	props["pci_vendor_id"] = outputLine;
-
-	pciDeviceID(d, &outputLine);
-	props["pci_device_id"] = outputLine;
-
-	numberOfTiles(d, &outputLine);
-	props["number_of_tiles"] = outputLine;
-
-	numberOfSlices(d, &outputLine);
-	props["number_of_slices"] = outputLine;
-
-	numberOfSubslicesPerSlice(d, &outputLine);
-	props["number_of_sub_slices_per_slice"] = outputLine;
-
-	numberOfEUsPerSubslice(d, &outputLine);
-	props["number_of_eus_per_sub_slice"] = outputLine;
-
-	numberOfThreadsPerEU(d, &outputLine);
-	props["number_of_threads_per_eu"] = outputLine;
-
-	physicalEUSimdWidth(d, &outputLine);
-	props["physical_eu_simd_width"] = outputLine;
-
-	maxCommandQueuePriority(d, &outputLine);
-	props["max_command_queue_priority"] = outputLine;
-
-	maxHardwareContexts(d, &outputLine);
-	props["max_hardware_contexts"] = outputLine;
-
-	maxMemAllocSize(d, &outputLine);
-	props["max_mem_alloc_size_byte"] = outputLine;
-
-	memoryFreeSize(d, &outputLine);
-	props["memory_free_size_byte"] = outputLine;
+	putProperty(*this, d, props, "number_of_memory_channels", &cmdDiscovery::memoryChannels);
+	putProperty(*this, d, props, "memory_bus_width", &cmdDiscovery::memoryBusWidth);
+	putProperty(*this, d, props, "memory_free_size_byte", &cmdDiscovery::memoryFreeSize);
+	putProperty(*this, d, props, "number_of_media_engines", &cmdDiscovery::mediaEngines);
+	putProperty(*this, d, props, "number_of_media_enh_engines", &cmdDiscovery::mediaEnhancementEngines);
+	putProperty(*this, d, props, "max_command_queue_priority", &cmdDiscovery::maxCommandQueuePriority);
+	putProperty(*this, d, props, "driver_version", &cmdDiscovery::driverVersion);
+}
 
-	memoryEccState(d, &outputLine);
-	props["memory_ecc_state"] = outputLine;
+/**
+ * @brief IGSC/MEI group of gatherDeviceProperties(): GSC firmware and OPROM versions
+ *
+ * The OPROM versions are read through the igsc handle MeiRegistry keeps for the device,
+ * so both come from one open.
+ *
+ * @param[in] d Pointer to device info structure
+ * @param[in] hasAmc Whether the device has AMC firmware; only then does it have OPROM and GFX_PSCBIN
+ * @param[out] props Map to add the properties of the group to
+ */
+void cmdDiscovery::gatherFirmwareProperties(devInfo *d, bool hasAmc, DeviceProperties &props)
+{
+	TRACING();
 
-	kernelVersion(d, &outputLine);
-	props["kernel_version"] = outputLine;
+	props["gfx_firmware_name"] = "GFX";
+	putProperty(*this, d, props, "gfx_firmware_version", &cmdDiscovery::gfxFirmwareVersion);
+	props["gfx_data_firmware_name"] = "GFX_DATA";
+	putProperty(*this, d, props, "gfx_data_firmware_version", &cmdDiscovery::gfxDataFirmwareVersion);
 
-	drmDevice(d, &outputLine);
-	props["drm_device"] = outputLine;
+	if (!hasAmc) {
+		return;
+	}
+	putProperty(*this, d, props, "gfx_pscbin_firmware_name", &cmdDiscovery::gfxPscBinFirmwareName);
+	putProperty(*this, d, props, "gfx_pscbin_firmware_version", &cmdDiscovery::gfxPscBinFirmwareVersion);
+	putProperty(*this, d, props, "oprom_code_firmware_name", &cmdDiscovery::opromCodeFirmwareName);
+	putProperty(*this, d, props, "oprom_code_firmware_version", &cmdDiscovery::opromCodeFirmwareVersion);
+	putProperty(*this, d, props, "oprom_data_firmware_name", &cmdDiscovery::opromDataFirmwareName);
+	putProperty(*this, d, props, "oprom_data_firmware_version", &cmdDiscovery::opromDataFirmwareVersion);
+}
 
-	deviceType(d, &outputLine);
-	props["device_type"] = outputLine;
+/**
+ * @brief sysfs group of gatherDeviceProperties(): PCI address and slot, firmware status,
+ *        kernel, DRM node and device state
+ *
+ * @param[in] d Pointer to device info structure
+ * @param[out] props Map to add the properties of the group to
+ */
+void cmdDiscovery::gatherSysfsProperties(devInfo *d, DeviceProperties &props)
+{
+	TRACING();
 
-	skuType(d, &outputLine);
-	props["sku_type"] = outputLine;
+	props["device_state"] = d->dev->isInSurvMode() ? DEVICE_STATE_SURV_MODE : DEVICE_STATE_NORMAL;
+	putProperty(*this, d, props, "pci_bdf_address", &cmdDiscovery::pciBDFAddress);
+	putProperty(*this, d, props, "pci_slot", &cmdDiscovery::pciSlot);
+	putProperty(*this, d, props, "gfx_firmware_status", &cmdDiscovery::gfxFirmwareStatus);
+	putProperty(*this, d, props, "kernel_version", &cmdDiscovery::kernelVersion);
+	putProperty(*this, d, props, "drm_device", &cmdDiscovery::drmDevice);
+}
 
-	pcieMaxBandwidth(d, &outputLine);
-	props["pcie_max_bandwidth"] = outputLine;
+/**
+ * @brief AMC group of gatherDeviceProperties(): AMC firmware version and FRU serial number
+ *
+ * One FRU read over I2C yields both.
+ *
+ * @param[in] d Pointer to device info structure
+ * @param[in] hasAmc Whether the device has AMC firmware, whose version is then reported
+ * @param[in] serialFromAmc Whether Sysman does not know the serial number, which is then taken from the FRU
+ * @param[out] props Map to add the properties of the group to
+ */
+void cmdDiscovery::gatherAmcProperties(devInfo *d, bool hasAmc, bool serialFromAmc, DeviceProperties &props)
+{
+	TRACING();
 
-	props["oam_socket_id"] = "N/A";
+	std::string serial;
+	std::string version;
+	const bool haveFru = queryAmcCardInfo(d, &serial, &version) == ZE_RESULT_SUCCESS;
 
-	// Get device properties for core clock rate
-	auto zeDevProp = ze_device_properties_t{};
-	d->dev->getDevProps(d->deviceHdl, &zeDevProp);
-	props["core_clock_rate"] = std::format("{} MHz", zeDevProp.coreClockRate);
+	if (hasAmc) {
+		putProperty(*this, d, props, "amc_firmware_name", &cmdDiscovery::amcFirmwareName);
+		if (haveFru) {
+			props["amc_firmware_version"] = version;
+		} else {
+			// Falls back to the version the firmware enumeration recorded
+			putProperty(*this, d, props, "amc_firmware_version", &cmdDiscovery::amcFirmwareVersion);
+		}
+	}
 
-	return result;
+	if (serialFromAmc && haveFru && !serial.empty()) {
+		DBG("Successfully retrieved serial number from AMC: {}\n", serial);
+		props["serial_number"] = serial;
+	}
 }
 
 /**
@@ -860,7 +1120,6 @@ ze_result_t cmdDiscovery::socUuid(devInfo *d, std::string *outputLine)
 	TRACING();
 
 	auto devProp = ze_device_properties_t{};
-	char output[256] = {0};
 
 	const auto result = d->dev->getDevProps(d->deviceHdl, &devProp);
 	if (result != ZE_RESULT_SUCCESS) {
@@ -868,13 +1127,7 @@ ze_result_t cmdDiscovery::socUuid(devInfo *d, std::string *outputLine)
 		return result;
 	}
 
-	snprintf(output, sizeof(output), "%02x%02x%02x%02x-%02x%02x-%02x%02x-%02x%02x-%02x%02x%02x%02x%02x%02x",
-			 devProp.uuid.id[15], devProp.uuid.id[14], devProp.uuid.id[13], devProp.uuid.id[12], devProp.uuid.id[11],
-			 devProp.uuid.id[10], devProp.uuid.id[9], devProp.uuid.id[8], devProp.uuid.id[7], devProp.uuid.id[6],
-			 devProp.uuid.id[5], devProp.uuid.id[4], devProp.uuid.id[3], devProp.uuid.id[2], devProp.uuid.id[1],
-			 devProp.uuid.id[0]);
-
-	*outputLine = output;
+	*outputLine = formatUuid(devProp.uuid);
 
 	return ZE_RESULT_SUCCESS;
 }
@@ -965,21 +1218,7 @@ ze_result_t cmdDiscovery::stepping(devInfo *d, std::string *outputLine)
 		return result;
 	}
 
-	// Extract stepping from modelName (e.g., "BMG A0" -> "A0")
-	// The modelName typically contains platform code and stepping
-	std::string modelName = zesDevProp.modelName;
-	size_t lastSpace = modelName.find_last_of(' ');
-	if (lastSpace != std::string::npos && lastSpace + 1 < modelName.length()) {
-		std::string stepping = modelName.substr(lastSpace + 1);
-		// Verify it looks like a stepping (e.g., "A0", "B1")
-		if (stepping.length() >= 2 && isalpha(stepping[0]) && isdigit(stepping[1])) {
-			*outputLine = stepping;
-		} else {
-			*outputLine = "A0";
-		}
-	} else {
-		*outputLine = "A0"; // Default fallback
-	}
+	*outputLine = steppingOf(zesDevProp.modelName);
 
 	return ZE_RESULT_SUCCESS;
 }
@@ -1684,17 +1923,7 @@ ze_result_t cmdDiscovery::memoryEccState(devInfo *d, std::string *outputLine)
 	zes_device_ecc_properties_t eccState = {};
 	ze_result_t result = zesDeviceGetEccState(d->zesDeviceHdl, &eccState);
 	if (result == ZE_RESULT_SUCCESS) {
-		switch (eccState.currentState) {
-		case ZES_DEVICE_ECC_STATE_ENABLED:
-			*outputLine = "enabled";
-			break;
-		case ZES_DEVICE_ECC_STATE_DISABLED:
-			*outputLine = "disabled";
-			break;
-		default:
-			*outputLine = "unavailable";
-			break;
-		}
+		*outputLine = eccStateName(eccState.currentState);
 		return ZE_RESULT_SUCCESS;
 	}
 
@@ -1761,23 +1990,7 @@ ze_result_t cmdDiscovery::deviceType(devInfo *d, std::string *outputLine)
 		ERR("Failed to get device properties: 0x{:X} ({})\n", result, l0_error_to_string(result));
 		return result;
 	}
-	switch (zeDevProp.type) {
-	case ZE_DEVICE_TYPE_GPU:
-		*outputLine = "GPU";
-		break;
-	case ZE_DEVICE_TYPE_CPU:
-		*outputLine = "CPU";
-		break;
-	case ZE_DEVICE_TYPE_FPGA:
-		*outputLine = "FPGA";
-		break;
-	case ZE_DEVICE_TYPE_MCA:
-		*outputLine = "MCA";
-		break;
-	default:
-		*outputLine = "Unknown";
-		break;
-	}
+	*outputLine = deviceTypeName(zeDevProp.type);
 	return ZE_RESULT_SUCCESS;
 }
 
@@ -1823,31 +2036,7 @@ ze_result_t cmdDiscovery::pcieMaxBandwidth(devInfo *d, std::string *outputLine)
 		ERR("Failed to get PCI properties: 0x{:X} ({})\n", result, l0_error_to_string(result));
 		return result;
 	}
-	// If the PCI information is unavailable display N/A
-	if (pciProps.maxSpeed.width == -1) {
-		*outputLine = "N/A";
-		return ZE_RESULT_SUCCESS;
-	}
-	// Calculate bandwidth based on PCIe generation and width
-	// Formula: (width * gen_rate) where gen_rate depends on PCIe generation
-	// Gen 1: ~250 MB/s per lane, Gen 2: ~500 MB/s, Gen 3: ~985 MB/s (1 GB/s), Gen 4: ~1969 MB/s (2 GB/s), Gen 5: ~3938
-	// MB/s (4 GB/s)
-	double laneRate = 0.985; // Gen 3 default GB/s per lane
-	if (pciProps.maxSpeed.gen == 1)
-		laneRate = 0.25;
-	else if (pciProps.maxSpeed.gen == 2)
-		laneRate = 0.5;
-	else if (pciProps.maxSpeed.gen == 3)
-		laneRate = 0.985;
-	else if (pciProps.maxSpeed.gen == 4)
-		laneRate = 1.969;
-	else if (pciProps.maxSpeed.gen == 5)
-		laneRate = 3.938;
-	else if (pciProps.maxSpeed.gen >= 6)
-		laneRate = 7.877;
-
-	double bandwidth = pciProps.maxSpeed.width * laneRate; // GB/s
-	*outputLine = std::format("{:.2f} GB/s", bandwidth);
+	*outputLine = pcieBandwidthOf(pciProps);
 	return ZE_RESULT_SUCCESS;
 }
 
@@ -2095,6 +2284,37 @@ ze_result_t cmdDiscovery::querySerialNumberFromAMC(devInfo *d, std::string *seri
 	return ZE_RESULT_SUCCESS;
 }
 
+/**
+ * @brief Reads the serial number and firmware version of the AMC of a device from its FRU data
+ *
+ * Goes through the AMC session the process shares, so the cards are enumerated and
+ * initialized once however many devices ask; amcupd serializes the FRU reads of
+ * concurrent callers.
+ *
+ * @param[in] d Pointer to the device info structure
+ * @param[out] serialNumberString Serial number of the AMC
+ * @param[out] versionString Firmware version of the AMC
+ *
+ * @retval ZE_RESULT_SUCCESS Both were read
+ * @retval ZE_RESULT_ERROR_UNINITIALIZED No AMC was found for the device or the FRU read failed
+ */
+ze_result_t cmdDiscovery::queryAmcCardInfo(devInfo *d, std::string *serialNumberString, std::string *versionString)
+{
+	TRACING();
+	if (amcupd::getNumOfCards() <= 0) {
+		DBG("No AMC devices found or enumeration failed. Skipping AMC FRU read.\n");
+		return ZE_RESULT_ERROR_UNINITIALIZED;
+	}
+
+	const std::string bdfStr = d->dev->getPCI()->getBDFStr();
+	amcupd amc;
+	if (amc.amcGetCardInfo(bdfStr, *serialNumberString, *versionString) < 0) {
+		DBG("No AMC FRU data for BDF {}\n", bdfStr);
+		return ZE_RESULT_ERROR_UNINITIALIZED;
+	}
+	return ZE_RESULT_SUCCESS;
+}
+
 /**
  * @brief Prints device information.
  *
@@ -2110,6 +2330,33 @@ ze_result_t cmdDiscovery::printDeviceInfo(std::vector<devInfo> deviceList, std::
 	bool found = false;
 	devFuncType foundType;
 
+	// JSON output is written one device at a time as the devices are visited
+	if (JsonStreamWriter *writer = printer->stream()) {
+		static const JsonKey deviceListKey("device_list");
+		writer->beginObject();
+		writer->key(deviceListKey);
+		for (auto &device : deviceList) {
+			foundType = device.dev->getPCI()->getFuncType();
+			if (type != DEVICE_FUNCTION_TYPE_ALL && foundType != type) {
+				continue;
+			}
+			if (!found) {
+				writer->beginArray();
+				found = true;
+			}
+			writer->value(*printDeviceDetail(&device, foundType));
+			writer->flush();
+		}
+		if (found) {
+			writer->endArray();
+		} else {
+			writer->value(nullptr);
+		}
+		writer->endObject();
+		writer->end();
+		return ZE_RESULT_SUCCESS;
+	}
+
 	auto deviceListJson = std::make_unique<nlohmann::ordered_json>();
 
 	for (auto &device : deviceList) {
@@ -2210,6 +2457,18 @@ int cmdDiscovery::run(arg_struct *args)
 		printDeviceInfo(deviceList, printer, DEVICE_FUNCTION_TYPE_PHYSICAL);
 	} else if (discCmds[discCmdType::DISC_VF].enabled || discCmds[discCmdType::DISC_VIRTUALFUNCTION].enabled) {
 		printDeviceInfo(deviceList, printer, DEVICE_FUNCTION_TYPE_VIRTUAL);
+	} else if (JsonStreamWriter *writer = printer->stream(); writer != nullptr && dumpAllSelected()) {
+		// Only dumpAll runs; its properties go straight to the output instead of through a tree.
+		// The devices are gathered concurrently and written in device order.
+		std::vector<DeviceProperties> props;
+		const DeviceResults outcome = gatherDeviceProperties(deviceList, props);
+		for (auto i : std::views::iota(size_t{0}, deviceList.size())) {
+			if (outcome.results[i] != ZE_RESULT_SUCCESS) {
+				return outcome.results[i];
+			}
+			writeDeviceProperties(&deviceList[i], props[i], *writer);
+			writer->end();
+		}
 	} else {
 		// Iterate through the device list and execute the command
 		auto jsonObj = std::make_unique<nlohmann::ordered_json>();
@@ -11,7 +11,10 @@
 #include "printer.h"
 #include <os.h>
 #include <map>
+#include <span>
 #include <string_view>
+#include <task_executor.h>
+#include <vector>
 
 inline constexpr char DEVICE_STATE_SURV_MODE[] =
 	"survivability mode (firmware update and cold reset are recommended for device recovery)";
@@ -110,9 +113,17 @@ public:
 	ze_result_t dumpHeading(nlohmann::ordered_json *jsonObj);
 	ze_result_t dump(devInfo *d, nlohmann::ordered_json *jsonObj);
 	ze_result_t dumpAll(devInfo *d, nlohmann::ordered_json *jsonObj);
+	void writeDeviceProperties(devInfo *d, const DeviceProperties &props, JsonStreamWriter &writer);
 
 	// Core data gathering functions (JSON-independent)
 	ze_result_t gatherDeviceProperties(devInfo *d, DeviceProperties &props);
+	DeviceResults gatherDeviceProperties(std::span<devInfo> devices, std::vector<DeviceProperties> &props);
+
+	// Property groups of gatherDeviceProperties(), one per backend; they run concurrently
+	void gatherLevelZeroProperties(devInfo *d, DeviceProperties &props);
+	void gatherFirmwareProperties(devInfo *d, bool hasAmc, DeviceProperties &props);
+	void gatherSysfsProperties(devInfo *d, DeviceProperties &props);
+	void gatherAmcProperties(devInfo *d, bool hasAmc, bool serialFromAmc, DeviceProperties &props);
 
 	ze_result_t physicalFunction(devInfo *d, nlohmann::ordered_json *jsonObj);
 	ze_result_t virtualFunction(devInfo *d, nlohmann::ordered_json *jsonObj);
@@ -168,6 +179,7 @@ public:
 	ze_result_t opromDataFirmwareVersion(devInfo *d, std::string *outputLine);
 	ze_result_t printDeviceInfo(std::vector<devInfo> deviceList, std::unique_ptr<Printer> &printer, devFuncType type);
 	ze_result_t querySerialNumberFromAMC(devInfo *d, std::string *serialNumberString);
+	ze_result_t queryAmcCardInfo(devInfo *d, std::string *serialNumberString, std::string *versionString);
 
 	std::unique_ptr<nlohmann::ordered_json> printDeviceDetail(devInfo *device, devFuncType funcType);
 
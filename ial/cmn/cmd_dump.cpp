@@ -8,21 +8,28 @@
 #include "cmds.h"
 #include "logger/logger.h"
 #include "device.h"
+#include "device_registry.h"
+#include "metric_store.h"
+#include "metric_window.h"
 #include "metrics_registry.h"
 #include "table_builder.h"
 #include "ze_api.h"
 #include <CLI/CLI.hpp>
-#include <nlohmann/json.hpp>
 #include <algorithm>
+#include <array>
 #include <cctype>
 #include <charconv>
 #include <chrono>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <filesystem>
 #include <fstream>
 #include <format>
 #include <functional>
 #include <ios>
+#include <iterator>
+#include <memory>
 #include <optional>
 #include <ranges>
 #include <span>
@@ -282,6 +289,11 @@ struct DumpOpts
 	std::optional<std::string> time;
 	std::optional<std::string> interval;
 	std::optional<std::string> number;
+	std::optional<std::string> aggregate; /**< --aggregate: window in seconds of the aggregated rows */
+	bool record = false;				  /**< --record: also append every sample to the metric store */
+	bool replay = false;				  /**< --replay: print rows of the metric store instead of sampling */
+	std::optional<std::string> store;	  /**< --store: metric store directory */
+	std::optional<std::string> since;	  /**< --since: how far back --replay reaches, e.g. "15m" */
 };
 
 /**
@@ -293,7 +305,9 @@ struct SamplingTiming
 {
 	std::chrono::milliseconds interval{DEFAULT_INTERVAL};
 	int64_t totalTimeSeconds = -1; // -1 = unlimited
-	int iterations = -1;		   // -1 = unlimited
+	int iterations = -1;		   // -1 = unlimited; counts windows with --aggregate
+	/** --aggregate window; 0 = every sample is written */
+	std::chrono::milliseconds window{0};
 };
 
 /**
@@ -342,6 +356,8 @@ std::vector<const metrics::QueryMetric *> resolveMetricsArg(const std::string &m
  *  - @c --interval: positive integer, at most MAX_INTERVAL seconds.
  *  - @c --loop-ms (@p loopMs): positive integer in ms; overrides @c --interval when present.
  *  - @c --time: total wall-clock duration in seconds; may not be combined with @c --number.
+ *  - @c --aggregate: window in seconds, at most MAX_AGGREGATE_WINDOW and no shorter than
+ *    the sampling interval.
  *
  * @param[in] opts    Fully-parsed DumpOpts from parseDumpCLI().
  * @param[in] loopMs  Optional value of the @c --loop-ms flag, pre-extracted
@@ -394,6 +410,20 @@ std::optional<SamplingTiming> parseSamplingTiming(const DumpOpts &opts, const st
 		}
 	}
 
+	if (opts.aggregate.has_value()) {
+		if (const auto sec = parseInteger<int64_t>(*opts.aggregate);
+			sec && *sec > 0 && std::chrono::seconds{*sec} <= MAX_AGGREGATE_WINDOW) {
+			t.window = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::seconds{*sec});
+		} else {
+			ERR("Invalid value for --aggregate: '{}'", opts.aggregate->c_str());
+			return std::nullopt;
+		}
+		if (t.window < t.interval) {
+			ERR("--aggregate window must not be shorter than the sampling interval.\n");
+			return std::nullopt;
+		}
+	}
+
 	return t;
 }
 
@@ -444,6 +474,11 @@ std::variant<ParsedArgs, int> parseDumpCLI(std::string_view cmdName, const std::
 	sub.add_flag("--date", parsed.opts.date, "Include date in timestamp");
 	sub.add_option("--interval,--delay,--loop", parsed.opts.interval, "Sampling interval in seconds (default: 1)");
 	sub.add_option("--number,--count", parsed.opts.number, "Number of samples");
+	sub.add_option("--aggregate", parsed.opts.aggregate, "Write min/max/avg/p95/last per window of N seconds");
+	sub.add_flag("--record", parsed.opts.record, "Also append every sample to the metric store");
+	sub.add_flag("--replay", parsed.opts.replay, "Print recorded rows of the metric store instead of sampling");
+	sub.add_option("--store", parsed.opts.store, "Metric store directory");
+	sub.add_option("--since", parsed.opts.since, "How far back --replay reaches, e.g. 15m, 2h, 7d");
 	std::string formatStr;
 	sub.add_option("--format", formatStr, "Output format: [csv][,noheader][,nounits]");
 
@@ -501,18 +536,92 @@ std::variant<ParsedArgs, int> parseDumpCLI(std::string_view cmdName, const std::
 }
 
 /**
- * @brief Format the current wall-clock time as a CSV-ready timestamp string.
+ * @brief Append a wall-clock time, the current one by default, as a CSV-ready timestamp.
  *
  * The time point is floored to millisecond precision before formatting.
  *
- * @param[in] showDate  When @c true, prefix the time component with @c "YYYY/MM/DD ".
- * @return  Formatted string: @c "HH:MM:SS.mmm" or @c "YYYY/MM/DD HH:MM:SS.mmm".
+ * @param[in,out] buf       Destination; the timestamp is appended in place.
+ * @param[in]     showDate  When @c true, prefix the time component with @c "YYYY/MM/DD ".
+ * @param[in]     time      Time to format.
+ */
+void appendTimestamp(std::string &buf, bool showDate,
+					 std::chrono::system_clock::time_point time = std::chrono::system_clock::now())
+{
+	auto nowMs = std::chrono::floor<std::chrono::milliseconds>(time);
+	if (showDate) {
+		std::format_to(std::back_inserter(buf), "{:%Y/%m/%d %H:%M:%S}", nowMs);
+	} else {
+		std::format_to(std::back_inserter(buf), "{:%H:%M:%S}", nowMs);
+	}
+}
+
+/**
+ * @brief Append @p s as a quoted, escaped JSON string.
+ *
+ * @param[in,out] buf  Destination buffer.
+ * @param[in]     s    Raw text.
  */
-std::string getTimestamp(bool showDate)
+void appendJsonString(std::string &buf, std::string_view s)
 {
-	auto now = std::chrono::system_clock::now();
-	auto nowMs = std::chrono::floor<std::chrono::milliseconds>(now);
-	return showDate ? std::format("{:%Y/%m/%d %H:%M:%S}", nowMs) : std::format("{:%H:%M:%S}", nowMs);
+	buf += '"';
+	for (const char ch : s) {
+		switch (ch) {
+		case '"':
+			buf += "\\\"";
+			break;
+		case '\\':
+			buf += "\\\\";
+			break;
+		case '\n':
+			buf += "\\n";
+			break;
+		case '\r':
+			buf += "\\r";
+			break;
+		case '\t':
+			buf += "\\t";
+			break;
+		default:
+			if (static_cast<unsigned char>(ch) < 0x20) {
+				std::format_to(std::back_inserter(buf), "\\u{:04x}", static_cast<unsigned>(ch));
+			} else {
+				buf += ch;
+			}
+		}
+	}
+	buf += '"';
+}
+
+/**
+ * @brief Append a metric value as a JSON token.
+ *
+ * Integers and finite reals are written as JSON numbers, text as a JSON string.
+ * Unavailable and non-finite values are written as the string @c "N/A".
+ *
+ * @param[in,out] buf  Destination buffer.
+ * @param[in]     val  Value to render.
+ */
+void appendJsonValue(std::string &buf, const metrics::MetricValue &val)
+{
+	using Kind = metrics::MetricValue::Kind;
+	switch (val.kind()) {
+	case Kind::Signed:
+	case Kind::Unsigned:
+		val.appendTo(buf);
+		return;
+	case Kind::Real:
+		if (std::isfinite(val.asReal())) {
+			val.appendTo(buf);
+			return;
+		}
+		break;
+	case Kind::Text:
+		appendJsonString(buf, val.text());
+		return;
+	case Kind::NotAvailable:
+		break;
+	}
+	buf += "\"N/A\"";
 }
 
 /**
@@ -524,6 +633,11 @@ std::string getTimestamp(bool showDate)
  * Each row is flushed to disk immediately after @c onEndDevice() to support live file
  * tailing. When @c useFile is @c false, output is sent to stdout via @c PRINT.
  *
+ * Metric values are rendered straight into buffers owned by the sink and reused across
+ * ticks: CSV/aligned cells keep their capacity and are laid out into a single line buffer
+ * by the width-locked formatter, and JSON Lines are written into the same buffer with
+ * numeric fields as JSON numbers.
+ *
  * @note  Set @c prependTimestamp = @c false and @c prependDeviceId = @c false when
  *        those columns are provided as explicit metric fields (e.g. @c --query-gpu).
  */
@@ -538,6 +652,8 @@ struct DumpOutput
 	bool aligned{false};		 // true when stdout is a TTY: use space-padded columns instead of CSV
 	bool noheader{false};		 // suppress header row entirely
 	bool nounits{false};		 // strip unit suffixes from column headers
+	/** Time of the next rows instead of the current time; set by --replay to the recorded time */
+	std::optional<std::chrono::system_clock::time_point> rowTime;
 
 	DumpOutput(bool date, bool toFile, std::ofstream *file) : showDate{date}, useFile{toFile}, dumpFile{file} {}
 
@@ -573,69 +689,181 @@ struct DumpOutput
 
 	void onBeginDevice(devInfo &dev)
 	{
-		currentDev = &dev;
-		row.clear();
-	}
-
-	void onMetric([[maybe_unused]] const metrics::QueryMetric &f, const std::string &val) { row.push_back(val); }
+		metricCount = 0;
 
-	void onEndDevice([[maybe_unused]] devInfo & /*unused*/)
-	{
 		if (json) {
-			nlohmann::ordered_json obj;
+			line.clear();
+			line += '{';
 			if (prependTimestamp) {
-				obj["timestamp"] = getTimestamp(showDate);
+				line += "\"timestamp\":\"";
+				appendTimestamp(line, showDate, rowTime.value_or(std::chrono::system_clock::now()));
+				line += "\",";
 			}
 			if (prependDeviceId) {
-				obj["device"] = currentDev->index;
-			}
-
-			const bool hasEnvelope = prependTimestamp || prependDeviceId;
-			nlohmann::ordered_json metricsHolder;
-			nlohmann::ordered_json &metricsTarget = hasEnvelope ? metricsHolder : obj;
-
-			for (auto i : std::views::iota(std::size_t{0}, std::min(row.size(), fieldDefs.size()))) {
-				metricsTarget[std::string{fieldDefs[i]->name}] = row[i];
+				std::format_to(std::back_inserter(line), "\"device\":{},", dev.index);
 			}
-			if (hasEnvelope) {
-				obj["metrics"] = std::move(metricsHolder);
+			if (prependTimestamp || prependDeviceId) {
+				line += "\"metrics\":{";
 			}
-			emit(obj.dump());
 			return;
 		}
 
-		std::vector<std::string> rowValues;
+		cellCount = 0;
 		if (prependTimestamp) {
-			rowValues.push_back(getTimestamp(showDate));
+			appendTimestamp(nextCell(), showDate, rowTime.value_or(std::chrono::system_clock::now()));
 		}
 		if (prependDeviceId) {
-			rowValues.push_back(std::to_string(currentDev->index));
+			std::format_to(std::back_inserter(nextCell()), "{}", dev.index);
 		}
-		for (const auto &v : row) {
-			rowValues.push_back(v);
+	}
+
+	void onMetric(const metrics::QueryMetric &f, const metrics::MetricValue &val)
+	{
+		if (json) {
+			if (metricCount++ > 0) {
+				line += ',';
+			}
+			appendJsonString(line, f.name);
+			line += ':';
+			appendJsonValue(line, val);
+			return;
 		}
-		emit(aligned ? alignedFormatter->rowLine(rowValues)
-					 : alignedFormatter->rowLine(rowValues, TableBuilder::LineStyle::Csv));
+		val.appendTo(nextCell());
+	}
+
+	void onEndDevice([[maybe_unused]] devInfo & /*unused*/)
+	{
+		if (json) {
+			line += (prependTimestamp || prependDeviceId) ? "}}" : "}";
+			emit(line);
+			return;
+		}
+
+		line.clear();
+		alignedFormatter->appendRowLine(line, std::span<const std::string>{cells}.first(cellCount),
+										aligned ? TableBuilder::LineStyle::Aligned : TableBuilder::LineStyle::Csv);
+		emit(line);
 	}
 
 	void onEnd() {}
 
 private:
-	void emit(const std::string &line) const
+	void emit(const std::string &text) const
 	{
 		if (useFile && (dumpFile != nullptr)) {
-			*dumpFile << line << "\n";
+			*dumpFile << text << "\n";
 			dumpFile->flush();
 		} else {
-			PRINT("{}", line);
+			PRINT("{}", text);
+		}
+	}
+
+	/** Next reusable row cell, cleared but keeping its capacity. */
+	std::string &nextCell()
+	{
+		if (cellCount == cells.size()) {
+			cells.emplace_back();
 		}
+		std::string &cell = cells[cellCount++];
+		cell.clear();
+		return cell;
 	}
 
-	std::vector<std::string> row;
+	std::vector<std::string> cells; // CSV/aligned row cells, reused across ticks
+	std::size_t cellCount{0};
+	std::string line; // Output line buffer (JSON or formatted row), reused across ticks
+	std::size_t metricCount{0};
 	std::vector<const metrics::QueryMetric *> fieldDefs;
 	std::optional<TableBuilder> alignedFormatter;
 	bool headerEmitted{false};
-	devInfo *currentDev{nullptr};
+};
+
+/**
+ * @brief Keeps the sampling thread, and the input thread it starts, on the CPUs local to
+ *        the sampled devices
+ *
+ * Callers hold a ThreadPinGuard so the thread gets its placement back when sampling ends.
+ */
+void pinSamplingThread(std::span<const devInfo> devices)
+{
+	std::vector<std::string> bdfs;
+	bdfs.reserve(devices.size());
+	for (const auto &d : devices) {
+		bdfs.push_back(d.dev->getBDFStr());
+	}
+	PIN_THREAD_TO_DEVICES(bdfs);
+}
+
+/**
+ * @brief Devices sampled by a loop and their metric caches, kept in step with a DeviceRegistry.
+ *
+ * adopt() takes the registry's latest device set between ticks. Devices whose handles are
+ * unchanged keep their cache, and with it their delta baseline, so they are sampled without
+ * a gap. Removed devices are dropped. New and re-enumerated devices take a fresh
+ * before-sample that the next sample() completes, so they are emitted from the next tick on.
+ */
+class LoopDevices
+{
+public:
+	LoopDevices(std::vector<devInfo> initial, std::vector<metrics::MetricCache> initialCaches, DeviceRegistry *source,
+				bool sampleProcesses, bool sampleFabric)
+		: deviceList(std::move(initial)), cacheList(std::move(initialCaches)), registry(source),
+		  set(source != nullptr ? source->current() : nullptr), withProcesses(sampleProcesses),
+		  withFabric(sampleFabric)
+	{}
+
+	/** @brief Switches to the registry's latest device set if it changed */
+	void adopt()
+	{
+		if (registry == nullptr) {
+			return;
+		}
+		auto latest = registry->current();
+		if (latest->generation == set->generation) {
+			return;
+		}
+		std::vector<devInfo> nextDevices;
+		std::vector<metrics::MetricCache> nextCaches;
+		nextDevices.reserve(latest->devices.size());
+		nextCaches.reserve(latest->devices.size());
+		for (const auto &entry : latest->devices) {
+			const auto it = std::ranges::find_if(deviceList, [&](const devInfo &d) {
+				return d.dev == entry.info.dev && d.zesDeviceHdl == entry.info.zesDeviceHdl;
+			});
+			nextDevices.push_back(entry.info);
+			if (it != deviceList.end()) {
+				nextCaches.push_back(std::move(cacheList[static_cast<std::size_t>(it - deviceList.begin())]));
+			} else {
+				nextCaches.push_back(metrics::populateMetricCacheBegin(nextDevices.back(), withProcesses, withFabric));
+			}
+		}
+		deviceList = std::move(nextDevices);
+		cacheList = std::move(nextCaches);
+		set = std::move(latest); // Keeps re-enumerated devices alive while they are sampled
+	}
+
+	/** @brief Takes the next sample of every device */
+	void sample()
+	{
+		for (std::size_t i = 0; i < deviceList.size(); ++i) {
+			if (cacheList[i].populated) {
+				cacheList[i] = metrics::populateMetricCacheContinuous(deviceList[i], cacheList[i]);
+			} else {
+				metrics::populateMetricCacheEnd(deviceList[i], cacheList[i]);
+			}
+		}
+	}
+
+	[[nodiscard]] std::span<devInfo> devices() { return deviceList; }
+	[[nodiscard]] std::span<const metrics::MetricCache> caches() const { return cacheList; }
+
+private:
+	std::vector<devInfo> deviceList;
+	std::vector<metrics::MetricCache> cacheList;
+	DeviceRegistry *registry;
+	std::shared_ptr<const DeviceSet> set;
+	bool withProcesses;
+	bool withFabric;
 };
 
 /**
@@ -652,8 +880,9 @@ private:
  *
  * @param[in]     out           Metric output sink (taken by value; owned by this function).
  * @param[in]     fields        Span of resolved QueryMetric descriptors to sample.
- * @param[in,out] deviceList    Device handles; mutated by populateMetricCacheContinuous().
+ * @param[in]     deviceList    Device handles of the first sample (moved in).
  * @param[in]     caches        Initial metric caches from the first sample (moved in).
+ * @param[in]     registry      Source of device-set updates after resets and hotplug; may be null.
  * @param[in]     loopInterval  Delay between consecutive sample collections.
  * @param[in]     count         Total number of samples to emit (0 = unlimited).
  * @retval ZE_RESULT_SUCCESS  Always; per-metric errors are logged by the metric layer.
@@ -663,8 +892,8 @@ private:
  *        does not depend on keyboard input.
  */
 ze_result_t runQueryLoopMode(DumpOutput out, std::span<const metrics::QueryMetric *> fields,
-							 std::vector<devInfo> &deviceList, std::vector<metrics::MetricCache> caches,
-							 std::chrono::milliseconds loopInterval, int count)
+							 std::vector<devInfo> deviceList, std::vector<metrics::MetricCache> caches,
+							 DeviceRegistry *registry, std::chrono::milliseconds loopInterval, int count)
 {
 	int remaining = count; // 0 = infinite
 	if (remaining == 1) {
@@ -674,9 +903,11 @@ ze_result_t runQueryLoopMode(DumpOutput out, std::span<const metrics::QueryMetri
 		--remaining; // first sample was already emitted
 	}
 
+	const ThreadPinGuard restorePin{};
+	pinSamplingThread(deviceList);
 	std::stop_source quitSource;
 	auto quitToken = quitSource.get_token();
-	const bool shouldStartInputThread = (count == 0) && STDIN_ISATTY();
+	const bool shouldStartInputThread = (count == 0) && !batchMode && STDIN_ISATTY();
 
 	std::jthread inputThread;
 	if (shouldStartInputThread) {
@@ -692,17 +923,15 @@ ze_result_t runQueryLoopMode(DumpOutput out, std::span<const metrics::QueryMetri
 		});
 	}
 
-	const std::size_t numDevices = deviceList.size();
+	LoopDevices devices(std::move(deviceList), std::move(caches), registry, metrics::needsProcessSampling(fields),
+						metrics::needsFabricSampling(fields));
 
 	while (!quitToken.stop_requested()) {
+		devices.adopt();
 		std::this_thread::sleep_for(loopInterval);
 
-		for (std::size_t i = 0; i < numDevices; ++i) {
-			caches[i] = metrics::populateMetricCacheContinuous(deviceList[i], caches[i]);
-		}
-
-		metrics::runMetricsWithCaches(out, fields, std::span<devInfo>(deviceList),
-									  std::span<const metrics::MetricCache>(caches));
+		devices.sample();
+		metrics::runMetricsWithCaches(out, fields, devices.devices(), devices.caches());
 
 		if (remaining > 0 && --remaining == 0) {
 			break;
@@ -726,13 +955,21 @@ ze_result_t runQueryLoopMode(DumpOutput out, std::span<const metrics::QueryMetri
  * A keyboard-input thread is spawned only when appropriate: stdin is a TTY, no fixed
  * sample count was requested, and no fixed total duration was set.
  *
+ * With @p aggregator every sample is folded into it instead, and @p out receives one
+ * aggregated row per device each @p timing.window; @p timing.iterations then counts
+ * those rows. A window cut short by q or @p timing.totalTimeSeconds is written as well.
+ * With @p recorder every sample is also appended to the metric store of its device.
+ *
  * @pre   @p fields must be non-empty.
  * @pre   If @p useFile is @c true, @p dumpFile must already be open for writing.
  *
  * @param[in]     out        Metric output sink (taken by value; owned by this function).
  * @param[in]     fields     Span of resolved QueryMetric descriptors to sample.
- * @param[in,out] deviceList Device handles; mutated each iteration by the metric layer.
- * @param[in]     timing     Resolved sampling-timing parameters (interval, count, duration).
+ * @param[in]     deviceList Device handles to start with (moved in).
+ * @param[in]     registry   Source of device-set updates after resets and hotplug; may be null.
+ * @param[in]     timing     Resolved sampling-timing parameters (interval, count, duration, window).
+ * @param[in,out] aggregator Window aggregates of @p fields; null to write every sample.
+ * @param[in,out] recorder   Metric store writer of @c --record; may be null.
  * @param[in]     useFile    @c true when output is directed to @p dumpFile instead of stdout.
  * @param[in,out] dumpFile   Output file stream; closed on function exit when @p useFile is @c true.
  * @retval ZE_RESULT_SUCCESS  Always; per-metric errors are logged by the metric layer.
@@ -743,17 +980,22 @@ ze_result_t runQueryLoopMode(DumpOutput out, std::span<const metrics::QueryMetri
  *        @c std::stop_token so the main loop and input thread share a single quit signal.
  */
 ze_result_t runOutputLoop(DumpOutput out, std::span<const metrics::QueryMetric *> fields,
-						  std::vector<devInfo> &deviceList, const SamplingTiming &timing, bool useFile,
+						  std::vector<devInfo> deviceList, DeviceRegistry *registry, const SamplingTiming &timing,
+						  metrics::WindowAggregator *aggregator, metrics::StoreRecorder *recorder, bool useFile,
 						  std::ofstream &dumpFile)
 {
+	// Before the caches are allocated, so they land on the devices' NUMA node
+	const ThreadPinGuard restorePin{};
+	pinSamplingThread(deviceList);
+
 	// Shared quit signal: either the user presses q/ESC/Ctrl-C or the main loop
 	// exhausts its iteration/time budget. Both sides write to the same stop_source.
 	std::stop_source quitSource;
 	auto quitToken = quitSource.get_token();
 
 	int iter = timing.iterations;
-	const bool shouldStartInputThread =
-		STDIN_ISATTY() && ((iter < 0 && !useFile) || (useFile && timing.totalTimeSeconds < 0));
+	const bool shouldStartInputThread = !batchMode && STDIN_ISATTY() &&
+										((iter < 0 && !useFile) || (useFile && timing.totalTimeSeconds < 0));
 
 	std::jthread inputThread;
 	if (shouldStartInputThread) {
@@ -773,21 +1015,52 @@ ze_result_t runOutputLoop(DumpOutput out, std::span<const metrics::QueryMetric *
 	const std::size_t numDevices = deviceList.size();
 	std::vector<metrics::MetricCache> caches(numDevices);
 
+	// Writes a sample, or folds it into the window and writes the window once the sample
+	// closest to its end is in. Returns true when rows were written.
+	auto windowEnd = startTime + timing.window;
+	bool storeErrorShown = false;
+	const auto record = [&](std::span<devInfo> devs, std::span<const metrics::MetricCache> sampleCaches) {
+		if (recorder != nullptr) {
+			metrics::runMetricsWithCaches(*recorder, fields, devs, sampleCaches);
+			if (!storeErrorShown && !recorder->error().empty()) {
+				ERR("Not recording to metric store {}\n", recorder->error());
+				storeErrorShown = true;
+			}
+		}
+		if (aggregator == nullptr) {
+			metrics::runMetricsWithCaches(out, fields, devs, sampleCaches);
+			return true;
+		}
+		metrics::runMetricsWithCaches(*aggregator, fields, devs, sampleCaches);
+		const auto now = std::chrono::steady_clock::now();
+		if (now + timing.interval / 2 < windowEnd) {
+			return false;
+		}
+		aggregator->flush(out);
+		while (windowEnd <= now + timing.interval / 2) {
+			windowEnd += timing.window;
+		}
+		return true;
+	};
+
 	const auto firstSampleDeadline = startTime + timing.interval;
+	const bool withProcesses = metrics::needsProcessSampling(fields);
+	const bool withFabric = metrics::needsFabricSampling(fields);
 	for (std::size_t i = 0; i < numDevices; ++i) {
-		caches[i] = metrics::populateMetricCacheBegin(deviceList[i]);
+		caches[i] = metrics::populateMetricCacheBegin(deviceList[i], withProcesses, withFabric);
 	}
 	std::this_thread::sleep_until(firstSampleDeadline);
 	for (std::size_t i = 0; i < numDevices; ++i) {
 		metrics::populateMetricCacheEnd(deviceList[i], caches[i]);
 	}
 
-	metrics::runMetricsWithCaches(out, std::span<const metrics::QueryMetric *>{fields}, std::span<devInfo>(deviceList),
-								  std::span<const metrics::MetricCache>{caches});
-	if (iter > 0 && --iter == 0) {
+	if (record(std::span<devInfo>(deviceList), std::span<const metrics::MetricCache>{caches}) && iter > 0 &&
+		--iter == 0) {
 		quitSource.request_stop();
 	}
 
+	LoopDevices devices(std::move(deviceList), std::move(caches), registry, withProcesses, withFabric);
+	devices.adopt();
 	if (!quitToken.stop_requested() && iter != 0) {
 		std::this_thread::sleep_for(timing.interval);
 	}
@@ -795,11 +1068,9 @@ ze_result_t runOutputLoop(DumpOutput out, std::span<const metrics::QueryMetric *
 	while (!quitToken.stop_requested()) {
 		const auto cycleStartTime = std::chrono::steady_clock::now();
 
-		for (std::size_t i = 0; i < numDevices; ++i) {
-			caches[i] = metrics::populateMetricCacheContinuous(deviceList[i], caches[i]);
-		}
-		metrics::runMetricsWithCaches(out, std::span<const metrics::QueryMetric *>{fields},
-									  std::span<devInfo>(deviceList), std::span<const metrics::MetricCache>{caches});
+		devices.sample();
+		const bool wrote = record(devices.devices(), devices.caches());
+		devices.adopt();
 
 		const auto collectionTimeMs =
 			std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - cycleStartTime);
@@ -808,7 +1079,7 @@ ze_result_t runOutputLoop(DumpOutput out, std::span<const metrics::QueryMetric *
 			std::this_thread::sleep_for(remainingSleep);
 		}
 
-		if (iter > 0 && --iter == 0) {
+		if (wrote && iter > 0 && --iter == 0) {
 			quitSource.request_stop();
 			break;
 		}
@@ -824,6 +1095,13 @@ ze_result_t runOutputLoop(DumpOutput out, std::span<const metrics::QueryMetric *
 		}
 	}
 
+	if (aggregator != nullptr && aggregator->pending()) {
+		aggregator->flush(out);
+	}
+	if (recorder != nullptr) {
+		recorder->flush();
+	}
+
 	if (useFile) {
 		dumpFile.close();
 		PRINT("\nDumping is stopped.\n");
@@ -836,12 +1114,187 @@ ze_result_t runOutputLoop(DumpOutput out, std::span<const metrics::QueryMetric *
 	return ZE_RESULT_SUCCESS;
 }
 
+/**
+ * @brief Directory of the metric stores: @c --store, or the platform default.
+ */
+std::filesystem::path storeDirectory(const DumpOpts &opts)
+{
+	return opts.store.has_value() ? std::filesystem::path{*opts.store} : metrics::MetricStore::defaultDirectory();
+}
+
+/**
+ * @brief Name of the first sampling option given along with @c --replay, which reads
+ *        recorded rows and samples nothing.
+ */
+std::optional<std::string_view> replayConflict(const DumpOpts &opts, const std::optional<std::string> &loopMs)
+{
+	const std::array<std::pair<bool, std::string_view>, 7> sampling{{
+		{opts.file.has_value(), "--file"},
+		{opts.time.has_value(), "--time"},
+		{opts.number.has_value(), "--number"},
+		{opts.interval.has_value(), "--interval"},
+		{loopMs.has_value(), "--loop-ms"},
+		{opts.aggregate.has_value(), "--aggregate"},
+		{opts.record, "--record"},
+	}};
+	for (const auto &[given, name] : sampling) {
+		if (given) {
+			return name;
+		}
+	}
+	return std::nullopt;
+}
+
+/**
+ * @brief Metric value of a number read back from a metric store.
+ *
+ * Whole numbers print as integers and others with two decimals; NaN, stored for a value
+ * that was not available, prints as N/A.
+ */
+metrics::MetricValue storedValue(double v)
+{
+	if (std::isnan(v)) {
+		return {};
+	}
+	constexpr double exactIntegers = 9007199254740992.0; // 2^53
+	if (std::trunc(v) == v && std::abs(v) < exactIntegers) {
+		return metrics::MetricValue::integer(static_cast<int64_t>(v));
+	}
+	return metrics::MetricValue::real(v, 2);
+}
+
+/**
+ * @brief Prints rows of the metric stores written by @c --record, without sampling.
+ *
+ * Reads the store of every device in the store directory, or of the device index given
+ * with @c --device, over the last @c --since (default: the retention of the finest tier).
+ * Each store answers from its finest tier reaching back that far. Rows of all devices are
+ * printed in time order, each with the time it was recorded.
+ *
+ * @param[in] out        Metric output sink (taken by value; owned by this function).
+ * @param[in] opts       Parsed options.
+ * @param[in] requested  Fields to print that were recorded; empty for every recorded field.
+ * @retval ZE_RESULT_SUCCESS                 Rows were printed, possibly none.
+ * @retval ZE_RESULT_ERROR_INVALID_ARGUMENT  Invalid @c --since or @c --device, or none of @p requested recorded.
+ * @retval ZE_RESULT_ERROR_NOT_AVAILABLE     No store to read.
+ */
+ze_result_t runReplay(DumpOutput out, const DumpOpts &opts, std::span<const metrics::QueryMetric *const> requested)
+{
+	std::optional<std::chrono::seconds> since;
+	if (opts.since.has_value()) {
+		since = metrics::parseStoreDuration(*opts.since);
+		if (!since) {
+			ERR("Invalid value for --since: '{}'\n", *opts.since);
+			return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+		}
+	}
+	std::optional<uint32_t> device;
+	if (!opts.device.empty()) {
+		device = parseInteger<uint32_t>(opts.device);
+		if (!device) {
+			ERR("--replay selects a device by its index, not '{}'\n", opts.device);
+			return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+		}
+	}
+
+	const std::filesystem::path dir = storeDirectory(opts);
+	std::vector<std::unique_ptr<metrics::MetricStore>> stores;
+	for (const uint32_t index : metrics::MetricStore::devicesIn(dir)) {
+		if (device && *device != index) {
+			continue;
+		}
+		std::string error;
+		auto store = metrics::MetricStore::open(metrics::MetricStore::fileOf(dir, index), error);
+		if (!store) {
+			ERR("Cannot read the metric store of device {}: {}\n", index, error);
+			continue;
+		}
+		stores.push_back(std::move(store));
+	}
+	if (stores.empty()) {
+		ERR("No metric store in {}. Record one with '{} dump --record'.\n", dir.string(), progName);
+		return ZE_RESULT_ERROR_NOT_AVAILABLE;
+	}
+
+	// Stored columns are named after the fields; print them in registry order
+	const auto recorded = [&](std::string_view name) {
+		return std::ranges::any_of(stores, [&](const auto &store) {
+			return std::ranges::find(store->columns(), name) != store->columns().end();
+		});
+	};
+	std::vector<const metrics::QueryMetric *> fields;
+	if (requested.empty()) {
+		for (const metrics::QueryMetric &f : metrics::getQueryMetrics()) {
+			if (recorded(f.name)) {
+				fields.push_back(&f);
+			}
+		}
+	} else {
+		std::ranges::copy_if(requested, std::back_inserter(fields),
+							 [&](const metrics::QueryMetric *f) { return recorded(f->name); });
+	}
+	if (fields.empty()) {
+		ERR("None of the selected metrics was recorded.\n");
+		return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+	}
+
+	// Column of every field in every store; npos when that store did not record it
+	constexpr auto notRecorded = std::string::npos;
+	const auto now = std::chrono::system_clock::now();
+	std::vector<metrics::StoreSeries> series;
+	std::vector<std::vector<std::size_t>> columnOf;
+	for (const auto &store : stores) {
+		series.push_back(store->query(now - since.value_or(store->tiers().front().retention), now));
+		auto &columns = columnOf.emplace_back();
+		for (const metrics::QueryMetric *f : fields) {
+			const auto it = std::ranges::find(store->columns(), f->name);
+			columns.push_back(it == store->columns().end() ? notRecorded
+														   : static_cast<std::size_t>(it - store->columns().begin()));
+		}
+	}
+
+	struct ReplayRow
+	{
+		int64_t timeMs;
+		std::size_t store;
+		std::size_t row;
+	};
+	std::vector<ReplayRow> rows;
+	for (std::size_t s = 0; s < series.size(); ++s) {
+		for (std::size_t r = 0; r < series[s].rows(); ++r) {
+			rows.push_back({series[s].times[r], s, r});
+		}
+	}
+	std::ranges::stable_sort(rows, {}, &ReplayRow::timeMs);
+
+	out.onBegin(fields);
+	for (const ReplayRow &row : rows) {
+		devInfo dev{};
+		dev.index = stores[row.store]->device();
+		out.rowTime = std::chrono::system_clock::time_point{std::chrono::milliseconds{row.timeMs}};
+		out.onBeginDevice(dev);
+		for (std::size_t k = 0; k < fields.size(); ++k) {
+			const std::size_t column = columnOf[row.store][k];
+			out.onMetric(*fields[k], column == notRecorded ? metrics::MetricValue{}
+														   : storedValue(series[row.store].value(row.row, column)));
+		}
+		out.onEndDevice(dev);
+	}
+	out.onEnd();
+	return ZE_RESULT_SUCCESS;
+}
+
 } // namespace
 
 // -- runQuery ---------------------------------------------------------
 
 int cmdDump::runQuery(const std::string &metrics, const std::string &deviceSpec, arg_struct *args, QueryFormat fmt)
 {
+	if (batchMode && fmt.loopMs > 0 && fmt.count <= 0) {
+		ERR("--loop runs until stopped; give --count inside --batch.\n");
+		return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+	}
+
 	// --query-gpu accepts dot-notation field names and group aliases, not legacy numeric IDs.
 	for (auto &&rng : std::string_view{metrics} | std::views::split(',')) {
 		std::string_view sv{rng.begin(), rng.end()};
@@ -880,8 +1333,10 @@ int cmdDump::runQuery(const std::string &metrics, const std::string &deviceSpec,
 	const std::size_t numDevices = deviceList.size();
 	std::vector<metrics::MetricCache> caches(numDevices);
 	const auto sampleDeadline = std::chrono::steady_clock::now() + metrics::detail::SAMPLE_WINDOW;
+	const bool withProcesses = metrics::needsProcessSampling(fields);
+	const bool withFabric = metrics::needsFabricSampling(fields);
 	for (std::size_t i = 0; i < numDevices; ++i) {
-		caches[i] = metrics::populateMetricCacheBegin(deviceList[i]);
+		caches[i] = metrics::populateMetricCacheBegin(deviceList[i], withProcesses, withFabric);
 	}
 	std::this_thread::sleep_until(sampleDeadline);
 	for (std::size_t i = 0; i < numDevices; ++i) {
@@ -891,8 +1346,14 @@ int cmdDump::runQuery(const std::string &metrics, const std::string &deviceSpec,
 								  std::span<const metrics::MetricCache>(caches));
 
 	if (fmt.loopMs > 0) {
-		return runQueryLoopMode(std::move(out), fields, deviceList, std::move(caches),
-								std::chrono::milliseconds{fmt.loopMs}, fmt.count);
+		std::optional<DeviceRegistry> registry;
+		if (fmt.count != 1) {
+			DeviceRegistry::Options registryOptions;
+			registryOptions.acceptNew = deviceSpec.empty();
+			registry.emplace(registeredDevices(deviceList), driverBackend(args->sm), registryOptions);
+		}
+		return runQueryLoopMode(std::move(out), fields, std::move(deviceList), std::move(caches),
+								registry ? &*registry : nullptr, std::chrono::milliseconds{fmt.loopMs}, fmt.count);
 	}
 
 	return ZE_RESULT_SUCCESS;
@@ -957,9 +1418,9 @@ int cmdDump::listGpus(arg_struct *args)
 	const auto uuidMetric = metrics::findMetric("uuid");
 	const auto indexMetric = metrics::findMetric("index");
 	for (auto &dev : deviceList) {
-		std::string gpuName = "N/A";
-		std::string gpuUuid = "N/A";
-		std::string gpuIdx = "N/A";
+		metrics::MetricValue gpuName;
+		metrics::MetricValue gpuUuid;
+		metrics::MetricValue gpuIdx;
 		if (nameMetric) {
 			nameMetric->getter(dev, gpuName, dummy);
 		}
@@ -969,7 +1430,8 @@ int cmdDump::listGpus(arg_struct *args)
 		if (indexMetric) {
 			indexMetric->getter(dev, gpuIdx, dummy);
 		}
-		PRINT("GPU {}: {} (UUID: GPU-{})\n", gpuIdx.c_str(), gpuName.c_str(), gpuUuid.c_str());
+		PRINT("GPU {}: {} (UUID: GPU-{})\n", gpuIdx.toString().c_str(), gpuName.toString().c_str(),
+			  gpuUuid.toString().c_str());
 	}
 	return ZE_RESULT_SUCCESS;
 }
@@ -990,6 +1452,7 @@ void cmdDump::help(HELP helpType)
 	helpList.emplace_back(HEADING,
 						  "%s dump --device [id] --metrics [metrics] -f [filename] --loop-ms [ms] --time [secs]",
 						  progName.c_str());
+	helpList.emplace_back(HEADING, "%s dump --replay --device [id] --since [duration]", progName.c_str());
 	helpList.emplace_back(BLANK);
 	helpList.emplace_back(TITLE, "Options:");
 	helpList.emplace_back(HEADING, "-h,--help                   Print this help message and exit");
@@ -1029,12 +1492,24 @@ void cmdDump::help(HELP helpType)
 	helpList.emplace_back(HEADING, "--number,--count            Number of samples (default: unlimited)");
 	helpList.emplace_back(HEADING,
 						  "--loop-ms                   Sampling interval in milliseconds (overrides --interval)");
+	helpList.emplace_back(HEADING, "--aggregate                 Window in seconds: write one row per device per window");
+	helpList.emplace_back(SUB_HEADING, "with min/max/avg/p95/last of every field instead of every sample;");
+	helpList.emplace_back(SUB_HEADING, "--number then counts windows");
 	helpList.emplace_back(BLANK);
 	helpList.emplace_back(HEADING, "-f,--file,--filename        Write output to a file instead of stdout");
 	helpList.emplace_back(HEADING, "--time                      Total dump duration in seconds");
 	helpList.emplace_back(HEADING, "--date                      Prefix timestamps with date");
 	helpList.emplace_back(HEADING, "--format=csv[,noheader][,nounits]  Force CSV output; suppress header or units");
 	helpList.emplace_back(BLANK);
+	helpList.emplace_back(HEADING, "--record                    Also append every sample to the metric store");
+	helpList.emplace_back(SUB_HEADING, "of its device: 1 s rows for 1 hour, 1 min for 1 day, 1 h for 30 days");
+	helpList.emplace_back(HEADING, "--replay                    Print recorded rows instead of sampling;");
+	helpList.emplace_back(SUB_HEADING, "--metrics is optional and --device takes a device index");
+	helpList.emplace_back(HEADING, "--since                     With --replay: how far back, e.g. 90s, 15m, 2h, 7d");
+	helpList.emplace_back(SUB_HEADING, "(default: 1 hour)");
+	helpList.emplace_back(HEADING, "--store                     Metric store directory");
+	helpList.emplace_back(SUB_HEADING, "(default: %s)", metrics::MetricStore::defaultDirectory().string().c_str());
+	helpList.emplace_back(BLANK);
 
 	printHelp(helpList, helpType);
 }
@@ -1057,6 +1532,36 @@ int cmdDump::run(arg_struct *args)
 	}
 	auto &[opts, loopMs] = std::get<ParsedArgs>(parseResult);
 
+	if (opts.since.has_value() && !opts.replay) {
+		ERR("--since requires --replay\n");
+		return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+	}
+	if (opts.store.has_value() && !opts.replay && !opts.record) {
+		ERR("--store requires --record or --replay\n");
+		return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+	}
+
+	// Replay answers from the recorded stores and never samples the devices
+	if (opts.replay) {
+		if (const auto conflict = replayConflict(opts, loopMs)) {
+			ERR("--replay cannot be used with {}\n", *conflict);
+			return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+		}
+		std::vector<const metrics::QueryMetric *> requested;
+		if (opts.metrics.has_value()) {
+			requested = resolveMetricsArg(*opts.metrics);
+			if (requested.empty()) {
+				return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+			}
+		}
+		DumpOutput out{opts.date, false, nullptr};
+		out.json = opts.json;
+		out.noheader = opts.noheader;
+		out.nounits = opts.nounits;
+		out.aligned = !opts.json && !opts.csvFormat && STDIN_ISATTY();
+		return runReplay(std::move(out), opts, requested);
+	}
+
 	if (opts.file.has_value() && !opts.metrics.has_value()) {
 		ERR("--file requires --metrics\n");
 		return ZE_RESULT_ERROR_INVALID_ARGUMENT;
@@ -1081,6 +1586,10 @@ int cmdDump::run(arg_struct *args)
 	if (!timing) {
 		return ZE_RESULT_ERROR_INVALID_ARGUMENT;
 	}
+	if (batchMode && timing->iterations < 0 && timing->totalTimeSeconds < 0) {
+		ERR("dump runs until stopped; give --number or --time inside --batch.\n");
+		return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+	}
 
 	if (hasPowerMetrics && timing->interval.count() < 50) {
 		PRINT("Warning: Power metrics are unreliable with sample windows < 50ms.\n");
@@ -1094,6 +1603,16 @@ int cmdDump::run(arg_struct *args)
 		return result;
 	}
 
+	std::optional<metrics::WindowAggregator> aggregator;
+	if (timing->window.count() > 0) {
+		aggregator.emplace(fields);
+	}
+
+	std::optional<metrics::StoreRecorder> recorder;
+	if (opts.record) {
+		recorder.emplace(storeDirectory(opts), fields);
+	}
+
 	std::ofstream dumpFile;
 	const bool useFile = opts.file.has_value();
 	if (useFile) {
@@ -1104,13 +1623,13 @@ int cmdDump::run(arg_struct *args)
 		}
 		if (!opts.json && !opts.noheader) {
 			std::string header = "Timestamp, DeviceId";
-			for (const metrics::QueryMetric *const f : fields) {
+			for (const metrics::QueryMetric *const f : aggregator ? aggregator->fields() : std::span{fields}) {
 				header += (!opts.nounits && !f->unit.empty()) ? std::format(", {} ({})", f->name, f->unit)
 															  : std::format(", {}", f->name);
 			}
 			dumpFile << header << "\n";
 		}
-		if (!opts.time.has_value() && STDIN_ISATTY()) {
+		if (!opts.time.has_value() && !batchMode && STDIN_ISATTY()) {
 			PRINT("Dump data to file {}. Press q or ESC to stop.\n", opts.file->c_str());
 		} else {
 			PRINT("Dump data to file {}.\n", opts.file->c_str());
@@ -1124,5 +1643,12 @@ int cmdDump::run(arg_struct *args)
 	out.noheader = opts.noheader;
 	out.nounits = opts.nounits;
 	out.aligned = !useFile && !opts.json && !opts.csvFormat && STDIN_ISATTY();
-	return runOutputLoop(out, fields, deviceList, *timing, useFile, dumpFile);
+	std::optional<DeviceRegistry> registry;
+	if (timing->iterations != 1) {
+		DeviceRegistry::Options registryOptions;
+		registryOptions.acceptNew = opts.device.empty();
+		registry.emplace(registeredDevices(deviceList), driverBackend(args->sm), registryOptions);
+	}
+	return runOutputLoop(out, fields, std::move(deviceList), registry ? &*registry : nullptr, *timing,
+						 aggregator ? &*aggregator : nullptr, recorder ? &*recorder : nullptr, useFile, dumpFile);
 }
@@ -17,6 +17,8 @@ constexpr auto MAX_INTERVAL = std::chrono::seconds{20};
 // Maximum duration for time-based dump operations (100 million seconds, approximately 3.17 years)
 // This limit prevents extremely long-running dump tasks that could consume excessive resources
 constexpr int64_t MAX_DUMP_TIME_SECONDS = 100000000;
+// Longest window of --aggregate; one aggregated row per device is written per window
+constexpr auto MAX_AGGREGATE_WINDOW = std::chrono::hours{24};
 
 /** Output format flags for cmdDump::runQuery. */
 struct QueryFormat
@@ -5,6 +5,9 @@
  */
 
 #include "cmd_health.h"
+#include "counter_delta.h"
+#include "health_watch.h"
+#include "metrics_registry.h"
 #include "printer.h"
 #include "debug.h"
 #include "table_builder.h"
@@ -12,6 +15,10 @@
 #include <CLI/CLI.hpp>
 #include <temperature.h>
 #include <memory.h>
+#include <atomic>
+#include <charconv>
+#include <csignal>
+#include <fstream>
 #include <sstream>
 #include <iomanip>
 #include <thread>
@@ -23,6 +30,11 @@ static std::unordered_map<healthCmdType, healthCmdStruct> healthCmds = {
 	{healthCmdType::HEALTH_LIST, {}},
 	{healthCmdType::HEALTH_DEVICE, {.func = &cmdHealth::allComponents}},
 	{healthCmdType::HEALTH_COMPONENT, {.func = &cmdHealth::component}},
+	{healthCmdType::HEALTH_WATCH, {}},
+	{healthCmdType::HEALTH_RULES, {}},
+	{healthCmdType::HEALTH_INTERVAL, {}},
+	{healthCmdType::HEALTH_LOG, {}},
+	{healthCmdType::HEALTH_HOOK, {}},
 };
 
 healthSubCmdStruct componentCmds[] = {
@@ -55,6 +67,9 @@ void cmdHealth::help(HELP helpType)
 	helpList.push_back(helpCmd(HEADING, "%s health -d [pciBdfAddress] -j", progName.c_str()));
 	helpList.push_back(helpCmd(HEADING, "%s health -d [deviceId] -c [componentTypeId]", progName.c_str()));
 	helpList.push_back(helpCmd(HEADING, "%s health -d [pciBdfAddress] -c [componentTypeId] -j", progName.c_str()));
+	helpList.push_back(helpCmd(HEADING, "%s health --watch [--rules file] [--interval secs] [--log file] [--hook command]",
+							   progName.c_str()));
+	helpList.push_back(helpCmd(HEADING, "%s health -d [deviceId] --watch", progName.c_str()));
 	helpList.push_back(helpCmd(BLANK));
 	helpList.push_back(helpCmd(TITLE, "Options:"));
 	helpList.push_back(helpCmd(HEADING, "-h,--help                   Print this help message and exit"));
@@ -69,6 +84,12 @@ void cmdHealth::help(HELP helpType)
 	helpList.push_back(helpCmd(SUB_HEADING2, "4. GPU Memory"));
 	helpList.push_back(helpCmd(SUB_HEADING2, "5. Reserved"));
 	helpList.push_back(helpCmd(SUB_HEADING2, "6. GPU Frequency"));
+	helpList.push_back(helpCmd(BLANK));
+	helpList.push_back(helpCmd(HEADING, "--watch                     Report alerts as JSON lines until interrupted"));
+	helpList.push_back(helpCmd(HEADING, "--rules                     Rule file (JSON) for --watch"));
+	helpList.push_back(helpCmd(HEADING, "-i,--interval               Sampling interval in seconds (default: 1)"));
+	helpList.push_back(helpCmd(HEADING, "--log                       Append alerts to this file instead of stdout"));
+	helpList.push_back(helpCmd(HEADING, "--hook                      Run this command per alert, alert JSON on stdin"));
 
 	printHelp(helpList, helpType);
 	helpList.clear();
@@ -399,8 +420,12 @@ ze_result_t cmdHealth::gpuPower(devInfo *d, nlohmann::ordered_json *jsonObj)
 			if (res == ZE_RESULT_SUCCESS) {
 				std::this_thread::sleep_for(std::chrono::milliseconds(POWER_MONITOR_INTERNAL_PERIOD));
 				res = pwr->getEnergyCounter(powerHandles[i], &snap2);
-				if (res == ZE_RESULT_SUCCESS && snap2.timestamp != snap1.timestamp) {
-					uint64_t value = (snap2.energy - snap1.energy) / (snap2.timestamp - snap1.timestamp);
+				if (res != ZE_RESULT_SUCCESS) {
+					continue;
+				}
+				const auto rate = metrics::counterRate({snap1.energy, snap1.timestamp}, {snap2.energy, snap2.timestamp});
+				if (rate.ok()) {
+					const auto value = static_cast<uint64_t>(rate.rate / 1'000'000.0); // µJ/s to W
 					if (props.onSubdevice) {
 						currentSubDeviceValueSum += value;
 					} else if (value > currentDeviceMaxDomainValue) {
@@ -705,6 +730,196 @@ ze_result_t cmdHealth::frequency(UNUSED devInfo *d, nlohmann::ordered_json *json
 	return ZE_RESULT_SUCCESS;
 }
 
+// Set from SIGINT/SIGTERM while health --watch runs
+static std::atomic<bool> watchStopRequested{false};
+
+static void onWatchSignal(int /*signal*/) { watchStopRequested.store(true); }
+
+// Longest sleep between checks for a stop request while waiting for the next tick
+static constexpr auto WATCH_STOP_POLL = std::chrono::milliseconds(100);
+
+static constexpr auto MAX_WATCH_INTERVAL = std::chrono::seconds(3600);
+
+// Longest an alert hook may run before it is killed; later alerts queue meanwhile
+static constexpr auto HOOK_TIMEOUT = std::chrono::milliseconds(10000);
+
+/**
+ * @brief Resolves a device_thresholds.json key of a watchdog rule for one device.
+ *
+ * Uses the same HAL lookups as the one-shot checks, so a device without an entry of its
+ * own gets the default thresholds.
+ *
+ * @param d Device the rule is evaluated on
+ * @param key One of health_watch::THRESHOLD_KEYS
+ * @return The threshold, or nullopt when the device reports none
+ */
+static std::optional<double> watchThreshold(devInfo &d, std::string_view key)
+{
+	if (key == "power_tdp") {
+		power *pwr = d.dev->getPower();
+		ze_device_properties_t zeDevProp = {};
+		if (pwr == nullptr || d.dev->getDevProps(d.deviceHdl, &zeDevProp) != ZE_RESULT_SUCCESS) {
+			return std::nullopt;
+		}
+		const uint64_t tdp = pwr->getThrottlePower(zeDevProp.deviceId);
+		return tdp > 0 ? std::optional<double>(static_cast<double>(tdp)) : std::nullopt;
+	}
+
+	temperature *t = (temperature *)d.dev->getTemperature();
+	if (t == nullptr) {
+		return std::nullopt;
+	}
+	uint32_t throttleThreshold = 0;
+	uint32_t shutdownThreshold = 0;
+	const ze_result_t result = key == "memory_shutdown"
+								   ? t->getMemoryThreshold(d.zesDeviceHdl, &throttleThreshold, &shutdownThreshold)
+								   : t->getCoreThreshold(d.zesDeviceHdl, &throttleThreshold, &shutdownThreshold);
+	if (result != ZE_RESULT_SUCCESS) {
+		return std::nullopt;
+	}
+	const uint32_t threshold = key == "core_throttle" ? throttleThreshold : shutdownThreshold;
+	return threshold > 0 ? std::optional<double>(threshold) : std::nullopt;
+}
+
+/**
+ * @brief Watches the devices continuously and reports health alerts (--watch).
+ *
+ * Loads the rules given with --rules, or the default rules, and samples the metrics they
+ * use on every device once per interval; each sample is evaluated against every rule, so
+ * the sampling cost does not depend on the number of rules. Every alert raised or cleared
+ * is written as one JSON line to stdout, or to the --log file and/or the --hook command
+ * when given. Hooks run on a worker thread, so a slow one does not delay the sampling.
+ * Runs until interrupted with Ctrl-C or SIGTERM.
+ *
+ * @param[in] deviceList Devices selected with --device (all devices when omitted).
+ * @return ze_result_t ZE_RESULT_SUCCESS when stopped by a signal.
+ */
+ze_result_t cmdHealth::watch(std::vector<devInfo> &deviceList)
+{
+	TRACING();
+	std::vector<health_watch::Rule> rules = health_watch::defaultRules();
+	if (healthCmds[healthCmdType::HEALTH_RULES].enabled) {
+		const std::string &path = healthCmds[healthCmdType::HEALTH_RULES].val;
+		std::ifstream file(path);
+		if (!file) {
+			ERR("Error: Cannot open rule file '{}'.\n", path.c_str());
+			return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+		}
+		nlohmann::json doc = nlohmann::json::parse(file, nullptr, false);
+		if (doc.is_discarded()) {
+			ERR("Error: Rule file '{}' is not valid JSON.\n", path.c_str());
+			return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+		}
+		std::string error;
+		if (!health_watch::parseRules(doc, rules, error)) {
+			ERR("Error: Invalid rule file '{}': {}\n", path.c_str(), error.c_str());
+			return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+		}
+	}
+
+	std::chrono::milliseconds interval{std::chrono::seconds(1)};
+	if (healthCmds[healthCmdType::HEALTH_INTERVAL].enabled) {
+		const std::string &value = healthCmds[healthCmdType::HEALTH_INTERVAL].val;
+		int64_t seconds = 0;
+		const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), seconds);
+		if (ec != std::errc{} || ptr != value.data() + value.size() || seconds <= 0 ||
+			std::chrono::seconds(seconds) > MAX_WATCH_INTERVAL) {
+			ERR("Error: Invalid value for --interval: '{}'.\n", value.c_str());
+			return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+		}
+		interval = std::chrono::seconds(seconds);
+	}
+
+	std::ofstream logFile;
+	if (healthCmds[healthCmdType::HEALTH_LOG].enabled) {
+		logFile.open(healthCmds[healthCmdType::HEALTH_LOG].val, std::ios::app);
+		if (!logFile) {
+			ERR("Error: Cannot open log file '{}'.\n", healthCmds[healthCmdType::HEALTH_LOG].val.c_str());
+			return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+		}
+	}
+	const std::string &hook = healthCmds[healthCmdType::HEALTH_HOOK].val;
+	const bool toStdout = !logFile.is_open() && hook.empty();
+
+	// Declared before the watchdog so queued hooks still run once the watch stops
+	std::optional<health_watch::HookQueue> hooks;
+	if (!hook.empty()) {
+		hooks.emplace([&hook](const std::string &line) {
+			const int status = RUN_HOOK(hook, line + "\n", HOOK_TIMEOUT);
+			if (status != 0) {
+				ERR("Error: Alert hook '{}' exited with status {}.\n", hook.c_str(), status);
+			}
+		});
+	}
+
+	health_watch::Watchdog watchdog(std::move(rules), watchThreshold, [&](const health_watch::Alert &alert) {
+		const std::string line = health_watch::toJson(alert).dump();
+		if (toStdout) {
+			PRINT("{}\n", line);
+		}
+		if (logFile.is_open()) {
+			logFile << line << '\n';
+			logFile.flush();
+		}
+		if (hooks && !hooks->push(line)) {
+			ERR("Error: Alert hook '{}' is falling behind; an older alert was dropped.\n", hook.c_str());
+		}
+	});
+
+	const auto fields = watchdog.fields();
+	const bool withProcesses = metrics::needsProcessSampling(fields);
+	const bool withFabric = metrics::needsFabricSampling(fields);
+	std::vector<metrics::MetricCache> caches(deviceList.size());
+	for (std::size_t i = 0; i < deviceList.size(); ++i) {
+		caches[i] = metrics::populateMetricCacheBegin(deviceList[i], withProcesses, withFabric);
+	}
+
+	// Sleeps until the deadline; false when a stop was requested meanwhile
+	const auto waitUntil = [](std::chrono::steady_clock::time_point deadline) {
+		while (!watchStopRequested.load()) {
+			const auto now = std::chrono::steady_clock::now();
+			if (now >= deadline) {
+				return true;
+			}
+			std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(deadline - now, WATCH_STOP_POLL));
+		}
+		return false;
+	};
+
+	watchStopRequested = false;
+	auto previousInt = std::signal(SIGINT, onWatchSignal);
+	auto previousTerm = std::signal(SIGTERM, onWatchSignal);
+	DBG("health: watching {} device(s) with {} rule(s) over {} metric(s)\n", deviceList.size(),
+		watchdog.rules().size(), fields.size());
+
+	auto next = std::chrono::steady_clock::now() + interval;
+	bool first = true;
+	while (waitUntil(next)) {
+		for (std::size_t i = 0; i < deviceList.size(); ++i) {
+			if (first) {
+				metrics::populateMetricCacheEnd(deviceList[i], caches[i]);
+			} else {
+				caches[i] = metrics::populateMetricCacheContinuous(deviceList[i], caches[i]);
+			}
+		}
+		first = false;
+		metrics::runMetricsWithCaches(watchdog, fields, std::span<devInfo>(deviceList),
+									  std::span<const metrics::MetricCache>(caches));
+
+		// A tick that overran is not made up for; the next one keeps the interval
+		next += interval;
+		const auto now = std::chrono::steady_clock::now();
+		if (next <= now) {
+			next = now + interval;
+		}
+	}
+
+	std::signal(SIGINT, previousInt);
+	std::signal(SIGTERM, previousTerm);
+	DBG("health: watch stopped with {} alert(s) active\n", watchdog.activeAlerts());
+	return ZE_RESULT_SUCCESS;
+}
+
 /**
  * @brief Executes the health run.
  *
@@ -731,6 +946,15 @@ int cmdHealth::run(arg_struct *args)
 		->each([&](const std::string &) { healthCmds[healthCmdType::HEALTH_DEVICE].enabled = true; });
 	sub.add_option("-c,--component", healthCmds[healthCmdType::HEALTH_COMPONENT].val, "Component type ID")
 		->each([&](const std::string &) { healthCmds[healthCmdType::HEALTH_COMPONENT].enabled = true; });
+	sub.add_flag("--watch", healthCmds[healthCmdType::HEALTH_WATCH].enabled, "Watch continuously and report alerts");
+	sub.add_option("--rules", healthCmds[healthCmdType::HEALTH_RULES].val, "Rule file for --watch")
+		->each([&](const std::string &) { healthCmds[healthCmdType::HEALTH_RULES].enabled = true; });
+	sub.add_option("-i,--interval", healthCmds[healthCmdType::HEALTH_INTERVAL].val, "Sampling interval in seconds")
+		->each([&](const std::string &) { healthCmds[healthCmdType::HEALTH_INTERVAL].enabled = true; });
+	sub.add_option("--log", healthCmds[healthCmdType::HEALTH_LOG].val, "Append alerts to this file")
+		->each([&](const std::string &) { healthCmds[healthCmdType::HEALTH_LOG].enabled = true; });
+	sub.add_option("--hook", healthCmds[healthCmdType::HEALTH_HOOK].val, "Run this command for every alert")
+		->each([&](const std::string &) { healthCmds[healthCmdType::HEALTH_HOOK].enabled = true; });
 
 	try {
 		sub.parse(args->argc - 1, args->argv + 1);
@@ -755,6 +979,30 @@ int cmdHealth::run(arg_struct *args)
 		printer = std::make_unique<HealthTextPrinter>();
 	}
 	auto jsonObj = std::make_unique<nlohmann::ordered_json>();
+
+	const bool watchOptions =
+		healthCmds[healthCmdType::HEALTH_RULES].enabled || healthCmds[healthCmdType::HEALTH_INTERVAL].enabled ||
+		healthCmds[healthCmdType::HEALTH_LOG].enabled || healthCmds[healthCmdType::HEALTH_HOOK].enabled;
+	if (healthCmds[healthCmdType::HEALTH_WATCH].enabled) {
+		if (healthCmds[healthCmdType::HEALTH_COMPONENT].enabled || healthCmds[healthCmdType::HEALTH_LIST].enabled) {
+			ERR("Error: --component and --list cannot be used with --watch.\n");
+			return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+		}
+		if (batchMode) {
+			ERR("Error: --watch runs until stopped and cannot be used inside --batch.\n");
+			return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+		}
+		result = args->sm.findDevice(healthCmds[healthCmdType::HEALTH_DEVICE].val.c_str(), &deviceList);
+		if (result != ZE_RESULT_SUCCESS || deviceList.empty()) {
+			ERR("Error: Device not found.\n");
+			return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+		}
+		return this->watch(deviceList);
+	} else if (watchOptions) {
+		ERR("Error: --rules, --interval, --log and --hook require --watch.\n");
+		return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+	}
+
 	// user must specify a device ID or PCI BDF address
 	if (!healthCmds[healthCmdType::HEALTH_LIST].enabled && !healthCmds[healthCmdType::HEALTH_DEVICE].enabled) {
 		result = ZE_RESULT_ERROR_INVALID_ARGUMENT;
@@ -30,6 +30,11 @@ enum healthCmdType
 	HEALTH_LIST,
 	HEALTH_DEVICE,
 	HEALTH_COMPONENT,
+	HEALTH_WATCH,
+	HEALTH_RULES,
+	HEALTH_INTERVAL,
+	HEALTH_LOG,
+	HEALTH_HOOK,
 	TOTAL_HEALTH,
 };
 
@@ -81,6 +86,7 @@ public:
 	xpumHealthStatus getHealthStatus(zes_mem_health_t health);
 	std::string getFreqThrottleString(zes_freq_throttle_reason_flags_t flags);
 	bool getFrequencyState(const zes_device_handle_t &device, std::string &freqThrottleMessage);
+	ze_result_t watch(std::vector<devInfo> &deviceList);
 	int run(arg_struct *args);
 };
 
@@ -8,8 +8,12 @@
 #include "debug.h"
 #include <CLI/CLI.hpp>
 #include "table_builder.h"
+#include <algorithm>
 #include <assert.h>
+#include <cmath>
+#include <optional>
 #include <sysprocess.h>
+#include <thread>
 
 static std::unordered_map<psCmdType, psCmdStruct> psCmds = {
 	{psCmdType::PS_HELP, {}},
@@ -41,6 +45,9 @@ void cmdPs::help(HELP helpType)
 									  "necessarily be resident on the device at the time of reading) (kB)"));
 	helpList.push_back(helpCmd(TITLE, "MEM:      Device memory size in bytes allocated by this process (may not "
 									  "necessarily be resident on the device at the time of reading) (kB)"));
+	helpList.push_back(helpCmd(TITLE, "RES:      Device and system memory resident for this process's DRM clients (kB)"));
+	helpList.push_back(helpCmd(TITLE, "Compute, Render, Media, Copy: Busy time of the engine group used by this "
+									  "process over a 200 ms window (%)"));
 	helpList.push_back(helpCmd(BLANK));
 	helpList.push_back(helpCmd(TITLE, "Options:"));
 	helpList.push_back(helpCmd(HEADING, "-h,--help                   Print this help message and exit"));
@@ -58,7 +65,7 @@ PsTextPrinter::PsTextPrinter() : TextPrinter() {}
  * @brief Prints device process information in a formatted text layout
  *
  * This function formats and prints a single device's process information from a JSON object.
- * It displays PID   Command   DeviceId   SHR    MEM columns
+ * It displays PID   Command   DeviceId   SHR    MEM    RES   Compute   Render   Media   Copy columns
  *
  * @param jsonObj Pointer to the JSON object containing a single device's process information
  */
@@ -70,12 +77,26 @@ void PsTextPrinter::printDeviceInfo(nlohmann::ordered_json *jsonObj)
 			.addColumn("Command", 19)
 			.addColumn("DeviceID", 14)
 			.addColumn("SHR", 14)
-			.addColumn("MEM", 14);
+			.addColumn("MEM", 14)
+			.addColumn("RES", 14)
+			.addColumn("Compute", 9)
+			.addColumn("Render", 9)
+			.addColumn("Media", 9)
+			.addColumn("Copy", 9);
 
+		auto groupUtil = [](const nlohmann::ordered_json &util, const char *group) -> std::string {
+			if (!util.contains(group)) {
+				return "-";
+			}
+			return std::format("{:.1f}", util[group].get<double>());
+		};
 		for (auto &item : (*jsonObj)["device_util_by_proc_list"]) {
+			const auto &util = item["engine_util"];
 			table.addRow(item["process_id"].get<uint32_t>(), item["process_name"].get<std::string>(),
 						 item["device_id"].get<uint32_t>(), item["shared_mem_size"].get<uint64_t>(),
-						 item["mem_size"].get<uint64_t>());
+						 item["mem_size"].get<uint64_t>(), item["resident_mem_size"].get<uint64_t>(),
+						 groupUtil(util, "compute"), groupUtil(util, "render"), groupUtil(util, "media"),
+						 groupUtil(util, "copy"));
 		}
 
 		PRINT("{}", table.toString().c_str());
@@ -98,6 +119,36 @@ void PsTextPrinter::print(nlohmann::ordered_json *jsonObj)
 	}
 }
 
+/**
+ * @brief Rounds a busy percentage to two decimals for output
+ */
+static double roundPercent(double percent) { return std::round(percent * 100.0) / 100.0; }
+
+/**
+ * @brief Converts per-process engine utilization into the "engine_util" (engine groups, as in
+ *        the utilization.* metrics) and "engine_class_util" (DRM engine classes) objects
+ */
+static void engineUtilToJson(nlohmann::ordered_json &jsonObj, const ProcessEngineUtilization &util)
+{
+	auto groups = nlohmann::ordered_json::object();
+	auto addGroup = [&groups](const char *name, std::optional<double> percent) {
+		if (percent.has_value()) {
+			groups[name] = roundPercent(*percent);
+		}
+	};
+	addGroup("compute", util.groupPercent({"compute"}));
+	addGroup("render", util.groupPercent({"render"}));
+	addGroup("media", util.groupPercent({"video", "video-enhance"}));
+	addGroup("copy", util.groupPercent({"copy"}));
+
+	auto classes = nlohmann::ordered_json::object();
+	for (const auto &[cls, busy] : util.engines) {
+		classes[cls] = roundPercent(busy.percent);
+	}
+	jsonObj["engine_util"] = std::move(groups);
+	jsonObj["engine_class_util"] = std::move(classes);
+}
+
 /**
  * @brief Converts a psInfo structure into a JSON object
  *
@@ -122,19 +173,25 @@ void to_json(nlohmann::ordered_json &jsonObj, const psInfo &procInfo)
 									 {"device_id", procInfo.devId},
 									 {"engines", static_cast<uint64_t>(procInfo.engines)},
 									 {"shared_mem_size", procInfo.sharedSize},
-									 {"mem_size", procInfo.memSize}};
+									 {"mem_size", procInfo.memSize},
+									 {"resident_mem_size", procInfo.residentSize}};
+	engineUtilToJson(jsonObj, procInfo.engineUtil);
 }
 
 /**
  * @brief Gets the process information status for the given device
  *
  * This function retrieves the process information and populates the psInfoList vector.
+ * Per-process engine utilization sampled from DRM fdinfo is attached to the matching
+ * processes; processes that only appear as DRM clients are listed as well.
  *
  * @param devInfo pointer
  * @param Reference value for psInfo structure
+ * @param engineUtil Engine utilization of this device's processes (see sampleEngineUtilization)
  * @return ze_result_t ZE_RESULT_SUCCESS if it retrieves process information
  */
-ze_result_t cmdPs::getProcessList(const devInfo *dev, std::vector<psInfo> &psInfoList)
+ze_result_t cmdPs::getProcessList(const devInfo *dev, std::vector<psInfo> &psInfoList,
+								  std::span<const ProcessEngineUtilization> engineUtil)
 {
 	TRACING();
 	ze_result_t result = ZE_RESULT_SUCCESS;
@@ -146,13 +203,60 @@ ze_result_t cmdPs::getProcessList(const devInfo *dev, std::vector<psInfo> &psInf
 		return ZE_RESULT_ERROR_UNKNOWN;
 	}
 	result = ps->getState(dev->zesDeviceHdl, &processList);
+	const size_t first = psInfoList.size();
 	for (auto &p : processList) {
 		psInfoList.push_back(
 			{p.processId, GETPROCESSNAME(p.processId), dev->index, p.engines, p.sharedSize / 1024, p.memSize / 1024});
 	}
+	for (const auto &util : engineUtil) {
+		auto it = std::find_if(psInfoList.begin() + static_cast<std::ptrdiff_t>(first), psInfoList.end(),
+							   [&util](const psInfo &info) { return info.processId == util.pid; });
+		if (it == psInfoList.end()) {
+			psInfoList.push_back({util.pid, GETPROCESSNAME(util.pid), dev->index, 0, 0, 0});
+			it = std::prev(psInfoList.end());
+		}
+		it->residentSize = util.residentBytes / 1024;
+		it->engineUtil = util;
+	}
 	return result;
 }
 
+/**
+ * @brief Returns the PCI BDF address of each device, in device list order
+ */
+std::vector<std::string> cmdPs::getDeviceBdfs(const std::vector<devInfo> &deviceList)
+{
+	std::vector<std::string> bdfs;
+	bdfs.reserve(deviceList.size());
+	for (const auto &dev : deviceList) {
+		bdfs.push_back(dev.dev->getBDFStr());
+	}
+	return bdfs;
+}
+
+/**
+ * @brief Samples per-process engine utilization of every device over one shared window
+ *
+ * Takes one DRM fdinfo snapshot of all devices, waits @p window and takes another, so the
+ * cost of the measurement does not grow with the number of devices.
+ *
+ * @return Per-process utilization for each device, in device list order
+ */
+std::vector<std::vector<ProcessEngineUtilization>> cmdPs::sampleEngineUtilization(
+	const std::vector<devInfo> &deviceList, std::chrono::milliseconds window)
+{
+	const auto bdfs = getDeviceBdfs(deviceList);
+	const auto before = snapshotDrmClients(bdfs);
+	std::this_thread::sleep_for(window);
+	const auto after = snapshotDrmClients(bdfs);
+
+	std::vector<std::vector<ProcessEngineUtilization>> util(deviceList.size());
+	for (size_t i = 0; i < deviceList.size(); ++i) {
+		util[i] = computeProcessUtilization(before[i], after[i]);
+	}
+	return util;
+}
+
 /**
  * @brief Executes the ps run.
  *
@@ -195,29 +299,44 @@ int cmdPs::run(arg_struct *args)
 		return result;
 	}
 
+	if (psCmds[psCmdType::PS_JSON].enabled == true) {
+		printer = std::make_unique<JsonPrinter>();
+	} else {
+		printer = std::make_unique<PsTextPrinter>();
+	}
+
 	std::vector<psInfo> psInfoList;
 	auto jsonObj = std::make_unique<nlohmann::ordered_json>();
 
 	if (!deviceList.empty()) {
-		for (const auto &dev : deviceList) {
-			result = getProcessList(&dev, psInfoList);
+		const auto engineUtil = sampleEngineUtilization(deviceList, PS_SAMPLE_WINDOW);
+		for (size_t i = 0; i < deviceList.size(); ++i) {
+			result = getProcessList(&deviceList[i], psInfoList, engineUtil[i]);
 		}
 		if (result != ZE_RESULT_SUCCESS) {
 			DBG("Failed to get process information. Returned with error: {}\n", result);
 			return result;
 		}
+		// JSON output is written process by process rather than through a tree of the list
+		if (JsonStreamWriter *writer = printer->stream()) {
+			static const JsonKey procListKey("device_util_by_proc_list");
+			writer->beginObject();
+			writer->key(procListKey);
+			writer->beginArray();
+			for (const auto &procInfo : psInfoList) {
+				writer->value(nlohmann::ordered_json(procInfo));
+			}
+			writer->endArray();
+			writer->endObject();
+			writer->end();
+			return result;
+		}
 		(*jsonObj)["device_util_by_proc_list"] = psInfoList;
 	} else {
 		(*jsonObj)["error"] = "device not found";
 		(*jsonObj)["errno"] = ZE_RESULT_ERROR_UNINITIALIZED;
 	}
 
-	if (psCmds[psCmdType::PS_JSON].enabled == true) {
-		printer = std::make_unique<JsonPrinter>();
-	} else {
-		printer = std::make_unique<PsTextPrinter>();
-	}
-
 	printer->print(jsonObj.get());
 
 	return result;
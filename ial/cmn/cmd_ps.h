@@ -9,7 +9,10 @@
 
 #include "cmds.h"
 #include "printer.h"
+#include <chrono>
+#include <drm_fdinfo.h>
 #include <os.h>
+#include <span>
 
 class PsTextPrinter : public TextPrinter
 {
@@ -36,9 +39,16 @@ public:
 	~cmdPs(){};
 	void help(HELP helpType = FULL_HELP);
 	int run(arg_struct *args);
-	ze_result_t getProcessList(const devInfo *dev, std::vector<psInfo> &psInfoList);
+	ze_result_t getProcessList(const devInfo *dev, std::vector<psInfo> &psInfoList,
+							   std::span<const ProcessEngineUtilization> engineUtil = {});
+	static std::vector<std::string> getDeviceBdfs(const std::vector<devInfo> &deviceList);
+	static std::vector<std::vector<ProcessEngineUtilization>> sampleEngineUtilization(
+		const std::vector<devInfo> &deviceList, std::chrono::milliseconds window);
 };
 
+/// Measurement window used to derive per-process engine utilization from DRM fdinfo.
+constexpr auto PS_SAMPLE_WINDOW = std::chrono::milliseconds{200};
+
 using psSubCmdFunc = ze_result_t (cmdPs::*)(devInfo *d, nlohmann::ordered_json *jsonObj);
 
 struct psCmdStruct
@@ -62,6 +72,8 @@ struct psInfo
 	uint64_t engines;
 	uint64_t sharedSize;
 	uint64_t memSize;
+	uint64_t residentSize{0};				  // kB resident on the device, from DRM fdinfo
+	ProcessEngineUtilization engineUtil{}; // Per engine class busy %, from DRM fdinfo
 };
 
 #endif
@@ -6,6 +6,7 @@
 
 #include "cmd_smi.h"
 #include "cmd_ps.h"
+#include "counter_delta.h"
 #include "debug.h"
 #include "fan.h"
 #include "memory.h"
@@ -284,13 +285,9 @@ void cmdSmi::computeFromBaseline(SmiDeviceStats &stats, const SmiBaseline &basel
 				if (it == baseline.tileEnergy.end()) {
 					continue;
 				}
-				uint64_t prevEnergy = it->second.first;
-				uint64_t prevTs = it->second.second;
-				uint64_t curEnergy = cur.first;
-				uint64_t curTs = cur.second;
-				if (curTs > prevTs && curEnergy >= prevEnergy) {
-					double w = static_cast<double>(curEnergy - prevEnergy) / static_cast<double>(curTs - prevTs);
-					totalPowerW += w;
+				const auto r = metrics::counterRate({it->second.first, it->second.second}, {cur.first, cur.second});
+				if (r.ok()) {
+					totalPowerW += r.rate / 1'000'000.0; // µJ/s to W
 					++tileCount;
 				}
 			}
@@ -313,15 +310,9 @@ void cmdSmi::computeFromBaseline(SmiDeviceStats &stats, const SmiBaseline &basel
 				if (it == baseline.tileEngineActivity.end()) {
 					continue;
 				}
-				uint64_t prevActive = it->second.first;
-				uint64_t prevTs = it->second.second;
-				uint64_t curActive = cur.first;
-				uint64_t curTs = cur.second;
-				if (curTs > prevTs && curActive >= prevActive) {
-					double util =
-						static_cast<double>(curActive - prevActive) / static_cast<double>(curTs - prevTs) * 100.0;
-					util = std::clamp(util, 0.0, 100.0);
-					totalUtil += util;
+				const auto r = metrics::counterRate({it->second.first, it->second.second}, {cur.first, cur.second});
+				if (r.ok()) {
+					totalUtil += std::clamp(r.rate * 1e-4, 0.0, 100.0); // µs active per second to %
 					++tileCount;
 				}
 			}
@@ -424,14 +415,19 @@ TableBuilder cmdSmi::buildGpuTable(const std::vector<SmiDeviceStats> &devStats,
 
 /**
  * @brief Build and return the process listing table.
+ *
+ * @param engineUtil Per-process engine utilization of each device (from DRM fdinfo), in
+ *                   device list order; shown as the busiest engine class of each process.
  */
-TableBuilder cmdSmi::buildProcessTable(const std::vector<devInfo> &deviceList)
+TableBuilder cmdSmi::buildProcessTable(const std::vector<devInfo> &deviceList,
+									   const std::vector<std::vector<ProcessEngineUtilization>> &engineUtil)
 {
 	TableBuilder procTable = TableBuilder::bordered();
 	procTable.addColumn("GPU", Align::Right)
 		.addColumn("PID", Align::Right)
 		.addColumn("Type", Align::Center)
 		.addColumn("Process Name", Align::Left)
+		.addColumn("GPU Util", Align::Right)
 		.addColumn("GPU Memory Usage", Align::Right);
 
 	// "Processes:" banner: left-aligned, no separator before column headers.
@@ -441,9 +437,10 @@ TableBuilder cmdSmi::buildProcessTable(const std::vector<devInfo> &deviceList)
 
 	cmdPs ps;
 	bool anyProcess = false;
-	for (const auto &di : deviceList) {
+	for (auto i : std::views::iota(size_t{0}, deviceList.size())) {
+		const auto &di = deviceList[i];
 		std::vector<psInfo> procs;
-		if (ps.getProcessList(&di, procs) != ZE_RESULT_SUCCESS) {
+		if (ps.getProcessList(&di, procs, engineUtil[i]) != ZE_RESULT_SUCCESS) {
 			continue;
 		}
 		for (const auto &p : procs) {
@@ -457,7 +454,9 @@ TableBuilder cmdSmi::buildProcessTable(const std::vector<devInfo> &deviceList)
 			double memMiB = static_cast<double>(p.memSize) / 1024.0;
 			std::string memStr = std::format("{:.0f} MiB", memMiB);
 			std::string procType = processTypeFromEngines(p.engines, p.memSize, p.sharedSize);
-			procTable.addRow(di.index, p.processId, procType, procName, memStr);
+			const auto busiest = p.engineUtil.maxPercent();
+			std::string utilStr = busiest.has_value() ? std::format("{:.0f}%", *busiest) : "N/A";
+			procTable.addRow(di.index, p.processId, procType, procName, utilStr, memStr);
 			anyProcess = true;
 		}
 	}
@@ -509,6 +508,8 @@ int cmdSmi::run(arg_struct *args)
 		collectPowerTdp(devStats[i], &deviceList[i]);
 		captureBaseline(baselines[i], &deviceList[i]);
 	}
+	const auto bdfs = cmdPs::getDeviceBdfs(deviceList);
+	const auto clientsBefore = snapshotDrmClients(bdfs);
 
 	// ── 3. Wait for delta window (200 ms) ──────────────────────────────
 	std::this_thread::sleep_for(std::chrono::milliseconds(200));
@@ -517,6 +518,11 @@ int cmdSmi::run(arg_struct *args)
 	for (auto i : std::views::iota(size_t{0}, deviceList.size())) {
 		computeFromBaseline(devStats[i], baselines[i], &deviceList[i]);
 	}
+	const auto clientsAfter = snapshotDrmClients(bdfs);
+	std::vector<std::vector<ProcessEngineUtilization>> engineUtil(deviceList.size());
+	for (auto i : std::views::iota(size_t{0}, deviceList.size())) {
+		engineUtil[i] = computeProcessUtilization(clientsBefore[i], clientsAfter[i]);
+	}
 
 	// ── 5. Get Level Zero version ───────────────────────────────────────
 	std::string lzVersion;
@@ -526,7 +532,7 @@ int cmdSmi::run(arg_struct *args)
 	TableBuilder gpuTable = buildGpuTable(devStats, lzVersion);
 	PRINT("{}\n", gpuTable.toString().c_str());
 
-	TableBuilder procTable = buildProcessTable(deviceList);
+	TableBuilder procTable = buildProcessTable(deviceList, engineUtil);
 	int const tableWidth = gpuTable.getTotalWidth();
 	procTable.padToWidth(tableWidth);
 	PRINT("{}\n", procTable.toString().c_str());
@@ -9,6 +9,7 @@
 
 #include "cmds.h"
 #include "table_builder.h"
+#include <drm_fdinfo.h>
 #include <string>
 #include <vector>
 #include <map>
@@ -89,7 +90,8 @@ private:
 
 	[[nodiscard]] static TableBuilder buildGpuTable(const std::vector<SmiDeviceStats> &devStats,
 													const std::string &lzVersion);
-	[[nodiscard]] static TableBuilder buildProcessTable(const std::vector<devInfo> &deviceList);
+	[[nodiscard]] static TableBuilder buildProcessTable(
+		const std::vector<devInfo> &deviceList, const std::vector<std::vector<ProcessEngineUtilization>> &engineUtil);
 };
 
 #endif
@@ -5,17 +5,22 @@
  */
 
 #include "cmd_stats.h"
+#include "counter_delta.h"
 #include "debug.h"
 #include <CLI/CLI.hpp>
 #include "memory.h"
 #include "fan.h"
 #include "metric.h"
+#include "metric_store.h"
+#include "metrics_registry.h"
 #include "pci.h"
 #include "printer.h"
 #include <assert.h>
 #include <algorithm>
+#include <charconv>
 #include <cinttypes>
 #include <cmath>
+#include <filesystem>
 #include <numeric>
 #include <format>
 #include <thread>
@@ -55,14 +60,6 @@ static const std::vector<RasCategoryInfo> RAS_CATEGORIES = {
  */
 static constexpr double MICROJOULES_TO_JOULES = 1000000.0;
 
-/**
- * @brief Conversion factor from microseconds to seconds
- *
- * Timestamp values from the HAL APIs are returned in microseconds (µs).
- * This constant converts microseconds to seconds for rate calculations.
- */
-static constexpr double MICROSECONDS_PER_SECOND = 1000000.0;
-
 /**
  * @brief Safely get a nested JSON object by path
  *
@@ -116,34 +113,14 @@ std::string cmdStats::formatIso8601Timestamp(const std::chrono::system_clock::ti
 	return std::format("{:%Y-%m-%dT%H:%M:%S}Z", std::chrono::floor<std::chrono::milliseconds>(timePoint));
 }
 
-/**
- * @brief Compute delta between two monotonic 64-bit counters, handling wrap-around
- *
- * Level Zero sysman counters (bandwidth, energy, engine activity, timestamps) are
- * monotonically increasing uint64_t values that may wrap. This helper computes the
- * correct delta regardless of whether the counter has wrapped.
- *
- * @param [in] current Current counter value
- * @param [in] baseline Previous counter value
- * @return Delta accounting for possible wrap-around
- */
-static uint64_t deltaWithWrap(uint64_t current, uint64_t baseline)
-{
-	if (current >= baseline) {
-		return current - baseline;
-	}
-	// Counter wrapped around
-	return (UINT64_MAX - baseline) + current + 1;
-}
-
 /**
  * @brief Compute engine utilization percentage from two snapshots
  *
  * This function calculates the utilization percentage by comparing the active time
  * and total elapsed time between two engine activity snapshots. It computes the
  * ratio of (delta active time) / (delta timestamp) * 100, clamping the result
- * to the range [0.0, 100.0]. Returns NaN if snapshots are invalid or deltaTime is zero.
- * Handles counter/timestamp wrap-around per Level Zero spec.
+ * to the range [0.0, 100.0]. Returns NaN if snapshots are invalid, the timestamp did not
+ * advance or a counter was reset in between; wraps are handled by metrics::counterRate().
  *
  * @param [in] start The starting engine snapshot
  * @param [in] end The ending engine snapshot
@@ -156,15 +133,13 @@ double cmdStats::computeUtilPercent(const EngineSnapshot &start, const EngineSna
 		return std::numeric_limits<double>::quiet_NaN();
 	}
 
-	uint64_t deltaActive = deltaWithWrap(end.activeTime, start.activeTime);
-	uint64_t deltaTime = deltaWithWrap(end.timestamp, start.timestamp);
-
-	if (deltaTime == 0) {
+	const auto r = metrics::counterRate({start.activeTime, start.timestamp}, {end.activeTime, end.timestamp});
+	if (!r.ok()) {
 		return std::numeric_limits<double>::quiet_NaN();
 	}
 
-	double util = (static_cast<double>(deltaActive) / static_cast<double>(deltaTime)) * 100.0;
-	return std::clamp(util, 0.0, 100.0);
+	// Active time and timestamp are both in µs: µs active per second * 1e-4 is the %
+	return std::clamp(r.rate * 1e-4, 0.0, 100.0);
 }
 
 /**
@@ -309,15 +284,13 @@ ze_result_t cmdStats::collectPowerMetricsPerTile(power *powerHandler, TilePowerS
 			uint64_t baseEnergy = baseline.energy[tileId];
 			uint64_t baseTimestamp = baseline.timestamp[tileId];
 
-			uint64_t deltaEnergy = deltaWithWrap(energy, baseEnergy);
-			uint64_t deltaTime = deltaWithWrap(timestamp, baseTimestamp);
-
-			if (deltaTime > 0) {
-				double powerWatts = static_cast<double>(deltaEnergy) / static_cast<double>(deltaTime);
+			const auto r = metrics::counterRate({baseEnergy, baseTimestamp}, {energy, timestamp});
+			if (r.ok()) {
+				double powerWatts = r.rate / MICROJOULES_TO_JOULES; // µJ/s to W
 				powerSamplesPerTile[tileId].push_back(powerWatts);
 
-				DBG("Tile {} power sample: {:.2f} W (deltaEnergy={} µJ, deltaTime={} µs)\n", tileId, powerWatts,
-					deltaEnergy, deltaTime);
+				DBG("Tile {} power sample: {:.2f} W (deltaEnergy={} µJ, window={:.6f} s)\n", tileId, powerWatts,
+					r.delta, r.seconds);
 			}
 		}
 
@@ -468,25 +441,6 @@ ze_result_t cmdStats::collectFanMetrics(fan *fanHandler,
 	return ZE_RESULT_SUCCESS;
 }
 
-/**
- * @brief Calculate throughput in kB/s from byte counter delta and time delta
- *
- * Helper function to compute throughput rate from counter deltas. Handles division
- * by zero by returning 0.0.
- *
- * @param [in] deltaBytes Number of bytes transferred
- * @param [in] deltaTimeMicros Time elapsed in microseconds
- * @return Throughput in kB/s, or 0.0 if deltaTimeMicros is zero
- */
-static double calculateThroughputKBps(uint64_t deltaBytes, uint64_t deltaTimeMicros)
-{
-	if (deltaTimeMicros == 0) {
-		return 0.0;
-	}
-	return static_cast<double>(deltaBytes) * MICROSECONDS_PER_SECOND /
-		   (static_cast<double>(deltaTimeMicros) * BYTES_PER_KB);
-}
-
 /**
  * @brief Generate tile key string for JSON output
  *
@@ -533,22 +487,21 @@ cmdStats::collectMemoryMetricsPerTile(memory *memoryHandler, TileMemoryBandwidth
 	if (result == ZE_RESULT_SUCCESS && !tileBandwidth.empty()) {
 		for (const auto &[tileId, data] : tileBandwidth) {
 			if (baseline.valid && baseline.timestamp.find(tileId) != baseline.timestamp.end()) {
-				uint64_t deltaTime = deltaWithWrap(data.timestamp, baseline.timestamp[tileId]);
-
-				if (deltaTime > 0) {
-					uint64_t deltaRead = deltaWithWrap(data.readCounter, baseline.readCounter[tileId]);
-					uint64_t deltaWrite = deltaWithWrap(data.writeCounter, baseline.writeCounter[tileId]);
+				const auto readRate = metrics::counterRate({baseline.readCounter[tileId], baseline.timestamp[tileId]},
+														   {data.readCounter, data.timestamp});
+				const auto writeRate = metrics::counterRate({baseline.writeCounter[tileId], baseline.timestamp[tileId]},
+															{data.writeCounter, data.timestamp});
 
-					double readKBps = calculateThroughputKBps(deltaRead, deltaTime);
-					double writeKBps = calculateThroughputKBps(deltaWrite, deltaTime);
+				if (readRate.ok() && writeRate.ok()) {
+					double readKBps = readRate.rate / BYTES_PER_KB;
+					double writeKBps = writeRate.rate / BYTES_PER_KB;
 
 					memoryReadKBpsPerTile[tileId].push_back(readKBps);
 					memoryWriteKBpsPerTile[tileId].push_back(writeKBps);
 					DBG("Tile {} memory read: {:.2f} kB/s, write: {:.2f} kB/s\n", tileId, readKBps, writeKBps);
 
 					if (data.maxBandwidth > 0) {
-						double bytesPerSec = (static_cast<double>(deltaRead) + static_cast<double>(deltaWrite)) *
-											 MICROSECONDS_PER_SECOND / static_cast<double>(deltaTime);
+						double bytesPerSec = readRate.rate + writeRate.rate;
 						double bandwidthPercent = (bytesPerSec / static_cast<double>(data.maxBandwidth)) * 100.0;
 
 						if (bandwidthPercent > 100.0) {
@@ -618,25 +571,19 @@ ze_result_t cmdStats::collectPcieMetrics(pci *pciHandler, zes_device_handle_t de
 	}
 
 	if (baseline.valid) {
-		uint64_t deltaTime = deltaWithWrap(pciStats.timestamp, baseline.timestamp);
-		if (deltaTime == 0) {
-			baseline.rxCounter = pciStats.rxCounter;
-			baseline.txCounter = pciStats.txCounter;
-			baseline.timestamp = pciStats.timestamp;
-			return ZE_RESULT_SUCCESS;
-		}
-
-		uint64_t deltaRx = deltaWithWrap(pciStats.rxCounter, baseline.rxCounter);
-		uint64_t deltaTx = deltaWithWrap(pciStats.txCounter, baseline.txCounter);
+		const auto rx = metrics::counterRate({baseline.rxCounter, baseline.timestamp},
+											 {pciStats.rxCounter, pciStats.timestamp});
+		const auto tx = metrics::counterRate({baseline.txCounter, baseline.timestamp},
+											 {pciStats.txCounter, pciStats.timestamp});
 
-		double readKBps =
-			static_cast<double>(deltaRx) * MICROSECONDS_PER_SECOND / (static_cast<double>(deltaTime) * BYTES_PER_KB);
-		double writeKBps =
-			static_cast<double>(deltaTx) * MICROSECONDS_PER_SECOND / (static_cast<double>(deltaTime) * BYTES_PER_KB);
+		if (rx.ok() && tx.ok()) {
+			double readKBps = rx.rate / BYTES_PER_KB;
+			double writeKBps = tx.rate / BYTES_PER_KB;
 
-		pcieReadKBpsSamples.push_back(readKBps);
-		pcieWriteKBpsSamples.push_back(writeKBps);
-		DBG("PCIe read: {:.2f} kB/s, write: {:.2f} kB/s\n", readKBps, writeKBps);
+			pcieReadKBpsSamples.push_back(readKBps);
+			pcieWriteKBpsSamples.push_back(writeKBps);
+			DBG("PCIe read: {:.2f} kB/s, write: {:.2f} kB/s\n", readKBps, writeKBps);
+		}
 	}
 
 	baseline.rxCounter = pciStats.rxCounter;
@@ -686,12 +633,9 @@ ze_result_t cmdStats::collectEngineUtilPerTile(enginegroup *engineGroup, zes_eng
 			uint64_t baseActiveTime = baseline.activeTime[tileId];
 			uint64_t baseTimestamp = baseline.timestamp[tileId];
 
-			uint64_t deltaActive = deltaWithWrap(activeTime, baseActiveTime);
-			uint64_t deltaTime = deltaWithWrap(timestamp, baseTimestamp);
-
-			if (deltaTime > 0) {
-				double util = (static_cast<double>(deltaActive) / static_cast<double>(deltaTime)) * 100.0;
-				util = std::clamp(util, 0.0, 100.0);
+			const auto r = metrics::counterRate({baseActiveTime, baseTimestamp}, {activeTime, timestamp});
+			if (r.ok()) {
+				double util = std::clamp(r.rate * 1e-4, 0.0, 100.0);
 				utilPerTile[tileId].push_back(util);
 				DBG("Engine type {} tile {} util: {:.2f}%\n", engineType, tileId, util);
 			}
@@ -1895,6 +1839,8 @@ static std::unordered_map<statsCmdType, statsCmdStruct> statsCmds = {
 	{statsCmdType::STATS_SAMPLES, {}},
 	{statsCmdType::STATS_INTERVAL, {}},
 	{statsCmdType::STATS_LIST_OFFLINE_PAGES, {}},
+	{statsCmdType::STATS_SINCE, {}},
+	{statsCmdType::STATS_STORE, {}},
 };
 
 /**
@@ -1923,6 +1869,7 @@ void cmdStats::help(HELP helpType)
 	helpList.push_back(helpCmd(HEADING, "%s stats -d [pciBdfAddress] -r", progName.c_str()));
 	helpList.push_back(helpCmd(HEADING, "%s stats -d [deviceId] -r -j", progName.c_str()));
 	helpList.push_back(helpCmd(HEADING, "%s stats -d [pciBdfAddress] -r -j", progName.c_str()));
+	helpList.push_back(helpCmd(HEADING, "%s stats -d [deviceId] --since 15m", progName.c_str()));
 	helpList.push_back(helpCmd(BLANK));
 	helpList.push_back(helpCmd(TITLE, "Options:"));
 	helpList.push_back(helpCmd(HEADING, "-h,--help                   Print this help message and exit"));
@@ -1938,6 +1885,12 @@ void cmdStats::help(HELP helpType)
 		helpCmd(HEADING, "--samples                   Number of samples to collect (minimum 1, default: 2)"));
 	helpList.push_back(
 		helpCmd(HEADING, "--interval                  Sampling interval in milliseconds (default: 100)"));
+	helpList.push_back(helpCmd(BLANK));
+	helpList.push_back(
+		helpCmd(HEADING, "--since                     Summarize metrics recorded by 'dump --record' over the last"));
+	helpList.push_back(helpCmd(SUB_HEADING, "duration, e.g. 90s, 15m, 2h or 7d, without sampling the devices"));
+	helpList.push_back(helpCmd(HEADING, "--store                     Metric store directory (default: %s)",
+							   metrics::MetricStore::defaultDirectory().string().c_str()));
 
 	printHelp(helpList, helpType);
 	helpList.clear();
@@ -2078,6 +2031,212 @@ void OfflinePagesTextPrinter::print(nlohmann::ordered_json *jsonObj)
 	}
 }
 
+/**
+ * @brief Summarizes the rows a metric store holds for the last @p since
+ *
+ * Each recorded metric gets its minimum, average, maximum and last value over the rows
+ * of the finest tier reaching back that far; rows where the metric was not available
+ * are left out, and a metric without any row has null statistics.
+ *
+ * @param [in] store Metric store of one device
+ * @param [in] since How far back to summarize
+ * @param [out] deviceJson JSON object to populate with the summary
+ */
+void cmdStats::summarizeStore(const metrics::MetricStore &store, std::chrono::seconds since,
+							  nlohmann::ordered_json &deviceJson)
+{
+	TRACING();
+	const auto end = std::chrono::system_clock::now();
+	const auto start = end - since;
+	const metrics::StoreSeries series = store.query(start, end);
+
+	deviceJson["device_index"] = store.device();
+	deviceJson["timestamps"] = {
+		{"start", formatIso8601Timestamp(start)},
+		{"end", formatIso8601Timestamp(end)},
+		{"elapsed_seconds", since.count()},
+	};
+	deviceJson["resolution_seconds"] = series.resolution.count();
+	deviceJson["rows"] = series.rows();
+
+	auto &metricsJson = deviceJson["metrics"];
+	metricsJson = nlohmann::ordered_json::array();
+	for (std::size_t c = 0; c < series.columns; ++c) {
+		double minValue = std::numeric_limits<double>::infinity();
+		double maxValue = -std::numeric_limits<double>::infinity();
+		double sum = 0.0;
+		double last = 0.0;
+		std::size_t count = 0;
+		for (std::size_t r = 0; r < series.rows(); ++r) {
+			const double v = series.value(r, c);
+			if (std::isnan(v)) {
+				continue;
+			}
+			minValue = std::min(minValue, v);
+			maxValue = std::max(maxValue, v);
+			sum += v;
+			last = v;
+			++count;
+		}
+
+		const std::string &name = store.columns()[c];
+		const auto field = metrics::findMetric(name);
+		nlohmann::ordered_json metricJson;
+		metricJson["name"] = name;
+		metricJson["unit"] = field ? std::string{field->unit} : std::string{};
+		metricJson["rows"] = count;
+		if (count > 0) {
+			metricJson["min"] = minValue;
+			metricJson["avg"] = sum / static_cast<double>(count);
+			metricJson["max"] = maxValue;
+			metricJson["last"] = last;
+		} else {
+			metricJson["min"] = nullptr;
+			metricJson["avg"] = nullptr;
+			metricJson["max"] = nullptr;
+			metricJson["last"] = nullptr;
+		}
+		metricsJson.push_back(std::move(metricJson));
+	}
+}
+
+/**
+ * @brief Print the summary of recorded metrics of a single device
+ *
+ * Prints a line naming the device, the summarized period and the resolution of the
+ * rows it was summarized from, then one table row per metric with its minimum,
+ * average, maximum and last value.
+ *
+ * @param [in] deviceJson JSON object built by cmdStats::summarizeStore()
+ */
+void StatsHistoryTextPrinter::printDeviceTable(const nlohmann::ordered_json &deviceJson)
+{
+	const auto &timestamps = deviceJson["timestamps"];
+	PRINT("Device {} - Recorded Metrics from {} to {} ({} s rows: {})\n\n", deviceJson.value("device_index", 0u),
+		  timestamps.value("start", "N/A"), timestamps.value("end", "N/A"), deviceJson.value("resolution_seconds", 0),
+		  deviceJson.value("rows", 0u));
+
+	const auto cell = [](const nlohmann::ordered_json &v) {
+		return v.is_number() ? std::format("{:.2f}", v.get<double>()) : std::string{"N/A"};
+	};
+	TableBuilder table;
+	table.addColumn("Metric", 40, Align::Left)
+		.addColumn("Min", 12, Align::Right)
+		.addColumn("Avg", 12, Align::Right)
+		.addColumn("Max", 12, Align::Right)
+		.addColumn("Last", 12, Align::Right)
+		.addColumn("Rows", 8, Align::Right);
+	for (const auto &metric : deviceJson["metrics"]) {
+		const std::string unit = metric.value("unit", "");
+		const std::string name = metric.value("name", "");
+		table.addRow(unit.empty() ? name : std::format("{} ({})", name, unit), cell(metric["min"]), cell(metric["avg"]),
+					 cell(metric["max"]), cell(metric["last"]), std::to_string(metric.value("rows", 0u)));
+	}
+	PRINT("{}", table.toString());
+}
+
+/**
+ * @brief Print recorded metric summaries in text format, one table per device
+ *
+ * @param [in] jsonObj JSON object, or array of them for several devices
+ */
+void StatsHistoryTextPrinter::print(nlohmann::ordered_json *jsonObj)
+{
+	TRACING();
+	if (jsonObj == nullptr)
+		return;
+
+	if (jsonObj->is_array()) {
+		for (auto &deviceJson : *jsonObj) {
+			printDeviceTable(deviceJson);
+			PRINT("\n");
+		}
+	} else {
+		printDeviceTable(*jsonObj);
+	}
+}
+
+/**
+ * @brief Executes stats --since: summarizes the metric stores written by dump --record
+ *
+ * Reads the store of every device, or of the device index given with --device, and
+ * never samples the devices or calls the driver.
+ *
+ * @return int ZE_RESULT_SUCCESS, or an error when the options are invalid or there is
+ *         no store to read.
+ */
+int cmdStats::runSince()
+{
+	TRACING();
+	const auto since = metrics::parseStoreDuration(statsCmds[STATS_SINCE].val);
+	if (!since) {
+		ERR("Invalid --since value: '{}'. Use a duration such as 90s, 15m, 2h or 7d.\n", statsCmds[STATS_SINCE].val);
+		return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+	}
+	const std::filesystem::path dir = statsCmds[STATS_STORE].enabled
+										  ? std::filesystem::path{statsCmds[STATS_STORE].val}
+										  : metrics::MetricStore::defaultDirectory();
+
+	std::vector<uint32_t> devices = metrics::MetricStore::devicesIn(dir);
+	if (statsCmds[STATS_DEVICE].enabled) {
+		const std::string &spec = statsCmds[STATS_DEVICE].val;
+		uint32_t index = 0;
+		const auto [ptr, ec] = std::from_chars(spec.data(), spec.data() + spec.size(), index);
+		if (ec != std::errc{} || ptr != spec.data() + spec.size()) {
+			ERR("--since selects a device by its index, not '{}'.\n", spec);
+			return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+		}
+		if (std::ranges::find(devices, index) == devices.end()) {
+			ERR("No metric store of device {} in {}.\n", index, dir.string());
+			return ZE_RESULT_ERROR_NOT_AVAILABLE;
+		}
+		devices = {index};
+	}
+	if (devices.empty()) {
+		ERR("No metric store in {}. Record one with '{} dump --record'.\n", dir.string(), progName);
+		return ZE_RESULT_ERROR_NOT_AVAILABLE;
+	}
+
+	std::unique_ptr<Printer> printer;
+	if (statsCmds[STATS_JSON].enabled) {
+		printer = std::make_unique<JsonPrinter>();
+	} else {
+		printer = std::make_unique<StatsHistoryTextPrinter>();
+	}
+	JsonStreamWriter *writer = printer->stream();
+	const bool multiple = devices.size() > 1;
+	bool written = false;
+	if (writer != nullptr && multiple) {
+		writer->beginArray();
+	}
+	for (const uint32_t index : devices) {
+		std::string error;
+		const auto store = metrics::MetricStore::open(metrics::MetricStore::fileOf(dir, index), error);
+		if (!store) {
+			ERR("Cannot read the metric store of device {}: {}\n", index, error);
+			continue;
+		}
+		nlohmann::ordered_json deviceJson;
+		summarizeStore(*store, *since, deviceJson);
+		if (writer != nullptr) {
+			writer->value(deviceJson);
+			writer->flush();
+			written = true;
+		} else {
+			printer->print(&deviceJson);
+		}
+	}
+	if (writer != nullptr) {
+		if (multiple) {
+			writer->endArray();
+		} else if (!written) {
+			writer->value(nullptr);
+		}
+		writer->end();
+	}
+	return ZE_RESULT_SUCCESS;
+}
+
 /**
  * @brief Executes the stats run.
  *
@@ -2108,6 +2267,10 @@ int cmdStats::run(arg_struct *args)
 		->each([&](const std::string &) { statsCmds[STATS_INTERVAL].enabled = true; });
 	sub.add_flag("--list-offline-pages", statsCmds[STATS_LIST_OFFLINE_PAGES].enabled,
 				 "List offline memory pages (exclusive; cannot be combined with other stats options)");
+	sub.add_option("--since", statsCmds[STATS_SINCE].val, "Summarize recorded metrics over the last duration")
+		->each([&](const std::string &) { statsCmds[STATS_SINCE].enabled = true; });
+	sub.add_option("--store", statsCmds[STATS_STORE].val, "Metric store directory")
+		->each([&](const std::string &) { statsCmds[STATS_STORE].enabled = true; });
 
 	try {
 		sub.parse(args->argc - 1, args->argv + 1);
@@ -2135,6 +2298,28 @@ int cmdStats::run(arg_struct *args)
 		}
 	}
 
+	if (statsCmds[STATS_STORE].enabled && !statsCmds[STATS_SINCE].enabled) {
+		ERR("--store requires --since.\n");
+		return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+	}
+	if (statsCmds[STATS_SINCE].enabled) {
+		static const std::pair<statsCmdType, const char *> samplingOpts[] = {
+			{STATS_SAMPLES, "--samples"},
+			{STATS_INTERVAL, "--interval"},
+			{STATS_EU, "--eu"},
+			{STATS_RAS, "--ras"},
+			{STATS_LIST_OFFLINE_PAGES, "--list-offline-pages"},
+		};
+		for (const auto &[cmdType, optName] : samplingOpts) {
+			if (statsCmds[cmdType].enabled) {
+				ERR("{} cannot be used with --since.\n", optName);
+				return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+			}
+		}
+		// Answered from the recorded metrics alone; the devices are not sampled
+		return runSince();
+	}
+
 	result = args->sm.findDevice(statsCmds[STATS_DEVICE].val.c_str(), &deviceList);
 	if (result != ZE_RESULT_SUCCESS) {
 		ERR("Error: Device handle not found for device ID '{}'.\n", statsCmds[STATS_DEVICE].val.c_str());
@@ -2183,6 +2368,12 @@ int cmdStats::run(arg_struct *args)
 		}
 	}
 
+	// Sampling waits out a firmware update or reset of these devices by another process
+	const DeviceLocks locks = lockDevices(deviceList, DeviceLockMode::SHARED);
+	if (!locks.locked()) {
+		return ZE_RESULT_ERROR_NOT_AVAILABLE;
+	}
+
 	std::unique_ptr<Printer> printer;
 	if (statsCmds[STATS_JSON].enabled) {
 		printer = std::make_unique<JsonPrinter>();
@@ -2192,12 +2383,35 @@ int cmdStats::run(arg_struct *args)
 		printer = std::make_unique<StatsTextPrinter>();
 	}
 
-	nlohmann::ordered_json outputJson;
+	// JSON output is written one device at a time, as soon as the device is collected: an
+	// array of device objects for several devices, the object itself (or null) for one
+	JsonStreamWriter *writer = statsCmds[STATS_JSON].enabled ? printer->stream() : nullptr;
 	bool collectMultiple = (deviceList.size() > 1);
+	bool written = false;
 
-	if (collectMultiple && statsCmds[STATS_JSON].enabled) {
-		outputJson = nlohmann::ordered_json::array();
+	if (writer != nullptr && collectMultiple) {
+		writer->beginArray();
 	}
+	auto printDevice = [&](nlohmann::ordered_json &deviceJson) {
+		if (writer != nullptr) {
+			writer->value(deviceJson);
+			writer->flush();
+			written = true;
+		} else {
+			printer->print(&deviceJson);
+		}
+	};
+	auto endOutput = [&]() {
+		if (writer == nullptr) {
+			return;
+		}
+		if (collectMultiple) {
+			writer->endArray();
+		} else if (!written) {
+			writer->value(nullptr);
+		}
+		writer->end();
+	};
 
 	if (statsCmds[STATS_LIST_OFFLINE_PAGES].enabled) {
 		for (auto &device : deviceList) {
@@ -2207,19 +2421,9 @@ int cmdStats::run(arg_struct *args)
 				ERR("Failed to list offline pages for device %u.\n", device.index);
 				continue;
 			}
-			if (statsCmds[STATS_JSON].enabled) {
-				if (collectMultiple) {
-					outputJson.push_back(deviceJson);
-				} else {
-					outputJson = deviceJson;
-				}
-			} else {
-				printer->print(&deviceJson);
-			}
-		}
-		if (statsCmds[STATS_JSON].enabled) {
-			printer->print(&outputJson);
+			printDevice(deviceJson);
 		}
+		endOutput();
 		return ZE_RESULT_SUCCESS;
 	}
 
@@ -2233,21 +2437,9 @@ int cmdStats::run(arg_struct *args)
 			ERR("Failed to collect stats for device {}.\n", device.index);
 			continue;
 		}
-
-		if (statsCmds[STATS_JSON].enabled) {
-			if (collectMultiple) {
-				outputJson.push_back(deviceJson);
-			} else {
-				outputJson = deviceJson;
-			}
-		} else {
-			printer->print(&deviceJson);
-		}
-	}
-
-	if (statsCmds[STATS_JSON].enabled) {
-		printer->print(&outputJson);
+		printDevice(deviceJson);
 	}
+	endOutput();
 
 	return ZE_RESULT_SUCCESS;
 }
@@ -32,11 +32,17 @@ enum statsCmdType
 	STATS_SAMPLES,
 	STATS_INTERVAL,
 	STATS_LIST_OFFLINE_PAGES,
+	STATS_SINCE,
+	STATS_STORE,
 	TOTAL_STATS,
 };
 
 struct statsCmdStruct;
 
+namespace metrics {
+class MetricStore;
+}
+
 constexpr size_t DEFAULT_SAMPLE_COUNT = 2;
 constexpr std::chrono::milliseconds DEFAULT_SAMPLE_INTERVAL{100};
 
@@ -267,6 +273,19 @@ private:
 	static void printOfflinePagesTable(const nlohmann::ordered_json &deviceJson);
 };
 
+/**
+ * @brief Printer for the summary of recorded metrics of stats --since
+ */
+class StatsHistoryTextPrinter : public Printer
+{
+public:
+	StatsHistoryTextPrinter() : Printer() {}
+	void print(nlohmann::ordered_json *jsonObj) override;
+
+private:
+	static void printDeviceTable(const nlohmann::ordered_json &deviceJson);
+};
+
 class cmdStats : public cmds
 {
 
@@ -321,6 +340,9 @@ private:
 										  DeviceMetrics &metrics, nlohmann::ordered_json &deviceJson, bool collectRas,
 										  bool collectEuMetrics);
 	static ze_result_t listOfflinePages(devInfo *device, nlohmann::ordered_json &deviceJson);
+	static void summarizeStore(const metrics::MetricStore &store, std::chrono::seconds since,
+							   nlohmann::ordered_json &deviceJson);
+	static int runSince();
 };
 
 using statsSubCmdFunc = ze_result_t (cmdStats::*)(devInfo *d);
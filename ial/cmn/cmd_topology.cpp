@@ -20,6 +20,7 @@
 #include <ranges>
 #include <optional>
 #include <string>
+#include <thread>
 #include <vector>
 #include <unordered_map>
 #include <variant>
@@ -28,6 +29,79 @@ namespace {
 constexpr int MATRIX_TILE_COL_WIDTH = 9;
 constexpr int MATRIX_CONNECTION_COL_WIDTH = 7;
 constexpr int MATRIX_AFFINITY_COL_WIDTH = 15;
+constexpr int LINK_UTIL_COL_WIDTH = 9;
+constexpr int LINK_UTIL_MAX_INTERVAL_S = 60;
+constexpr double BYTES_PER_MB = 1e6;
+
+/** JSON number, or null for an unknown value */
+nlohmann::ordered_json numberOrNull(const std::optional<double> &value)
+{
+	return value ? nlohmann::ordered_json(*value) : nlohmann::ordered_json(nullptr);
+}
+
+/** Text cell of a JSON number: formatted with @p suffix, or "N/A" for null */
+std::string numberCell(const nlohmann::ordered_json &value, std::string_view suffix)
+{
+	return value.is_number() ? std::format("{:.1f}{}", value.get<double>(), suffix) : std::string{"N/A"};
+}
+
+/**
+ * @brief Prints the "link_utilization" object built by cmdTopology::linkUtilizationToJson()
+ *
+ * A device x device table of transmit utilization (row to column), then one row per
+ * fabric port with its rates.
+ */
+void printLinkUtilization(const nlohmann::ordered_json &link)
+{
+	PRINT("Fabric link utilization, transmit from row to column, {} ms window:\n",
+		  link.value("interval_ms", int64_t{0}));
+
+	TableBuilder matrix;
+	matrix.addColumn("", MATRIX_TILE_COL_WIDTH);
+	for (const auto &id : link["devices"]) {
+		matrix.addColumn(std::format("GPU {}", id.get<uint32_t>()), LINK_UTIL_COL_WIDTH);
+	}
+	for (const auto &row : link["matrix"]) {
+		const auto rowId = row["device_id"].get<uint32_t>();
+		std::vector<std::string> cells{std::format("GPU {}", rowId)};
+		size_t col = 0;
+		for (const auto &id : link["devices"]) {
+			const bool linked = row["linked"][col].get<bool>();
+			if (!linked) {
+				cells.emplace_back(id.get<uint32_t>() == rowId ? "S" : "-");
+			} else if (row["utilization"][col].is_number()) {
+				cells.push_back(numberCell(row["utilization"][col], "%"));
+			} else {
+				cells.push_back(numberCell(row["throughput"][col], " MB/s"));
+			}
+			++col;
+		}
+		matrix.addRowFromContainer(cells);
+	}
+	PRINT("{}", matrix.toString().c_str());
+
+	if (link["ports"].empty()) {
+		PRINT("No fabric ports found\n");
+		return;
+	}
+	TableBuilder ports;
+	ports.addColumn("GPU", 5);
+	ports.addColumn("Tile", 5);
+	ports.addColumn("Port", 9);
+	ports.addColumn("Remote Port", 11);
+	ports.addColumn("Rx (MB/s)", 10);
+	ports.addColumn("Tx (MB/s)", 10);
+	ports.addColumn("Rx (%)", 7);
+	ports.addColumn("Tx (%)", 7);
+	for (const auto &port : link["ports"]) {
+		ports.addRow(std::to_string(port["device_id"].get<uint32_t>()),
+					 std::to_string(port["subdevice_id"].get<uint32_t>()), port["port"].get<std::string>(),
+					 port["remote_port"].is_string() ? port["remote_port"].get<std::string>() : std::string{"-"},
+					 numberCell(port["rx_throughput"], ""), numberCell(port["tx_throughput"], ""),
+					 numberCell(port["rx_utilization"], ""), numberCell(port["tx_utilization"], ""));
+	}
+	PRINT("{}", ports.toString().c_str());
+}
 
 /**
  * @brief CPU information structure for parsed /proc/cpuinfo data
@@ -137,6 +211,11 @@ void TopologyTextPrinter::print(nlohmann::ordered_json *jsonObj)
 		return;
 	}
 
+	if (jsonObj->contains("link_utilization")) {
+		printLinkUtilization((*jsonObj)["link_utilization"]);
+		return;
+	}
+
 	if (jsonObj->contains("matrix") && jsonObj->contains("headers")) {
 		const auto &headers = (*jsonObj)["headers"];
 		const auto &matrix = (*jsonObj)["matrix"];
@@ -222,7 +301,7 @@ void TopologyTextPrinter::print(const TopologyInfo &info)
 static std::unordered_map<topologyCmdType, TopologyCmdStruct> topologyCmds = {
 	{topologyCmdType::TOPOLOGY_HELP, {}},	{topologyCmdType::TOPOLOGY_JSON, {}},
 	{topologyCmdType::TOPOLOGY_DEVICE, {}}, {topologyCmdType::TOPOLOGY_FILE, {}},
-	{topologyCmdType::TOPOLOGY_MATRIX, {}},
+	{topologyCmdType::TOPOLOGY_MATRIX, {}}, {topologyCmdType::TOPOLOGY_LINK_UTIL, {}},
 };
 
 /**
@@ -253,6 +332,7 @@ void cmdTopology::help(HELP helpType)
 	helpList.emplace_back(HEADING, "%s topology --device [deviceId] -j", progName.c_str());
 	helpList.emplace_back(HEADING, "%s topology -f [filename]", progName.c_str());
 	helpList.emplace_back(HEADING, "%s topology -m", progName.c_str());
+	helpList.emplace_back(HEADING, "%s topology -u [-i seconds] [-n count]", progName.c_str());
 	helpList.emplace_back(BLANK);
 	helpList.emplace_back(TITLE, "Options:");
 	helpList.emplace_back(HEADING, "-h,--help                   Print this help message and exit");
@@ -269,6 +349,11 @@ void cmdTopology::help(HELP helpType)
 	helpList.emplace_back(SUB_HEADING, "PHB:  Connected via PCIe host bridge");
 	helpList.emplace_back(SUB_HEADING, "NODE: Connected with PCIe within a NUMA node");
 	helpList.emplace_back(SUB_HEADING, "SYS: Connected with PCIe between NUMA nodes");
+	helpList.emplace_back(HEADING, "-u,--link-util              Print the fabric link utilization between GPUs");
+	helpList.emplace_back(SUB_HEADING, "Transmit bandwidth from row to column GPU, in percent of the link speed");
+	helpList.emplace_back(HEADING, "-i,--interval               Sample window of --link-util in seconds (default: 1)");
+	helpList.emplace_back(HEADING, "-n,--number                 Number of --link-util samples, 0 = until Ctrl-C "
+								   "(default: 1)");
 
 	printHelp(helpList, helpType);
 	helpList.clear();
@@ -407,9 +492,10 @@ ze_result_t cmdTopology::generateFile(const std::string &filename, bool useJson)
  * @ingroup topology_matrix
  *
  * Constructs a comprehensive topology matrix showing connectivity between all GPU tiles
- * and NICs. Uses two data sources:
+ * and NICs. Uses two data sources, both gathered once through GET_TOPOLOGY_MODEL:
  *   1. sysfs @c numa_node file — for NODE / SYS classification
  *   2. sysfs canonical path walk — for PIX / PXB / PHB classification (when available)
+ * Pairwise PCIe classification uses a PcieTree lowest-common-ancestor query.
  *
  * @param[in]  args    Pointer to argument structure containing system manager.
  * @param[out] jsonObj Populated with:
@@ -484,10 +570,20 @@ ze_result_t cmdTopology::buildTopologyMatrix(arg_struct *args, nlohmann::ordered
 		}
 	}
 
+	// Resolve NICs, NUMA nodes and PCIe bridge paths once through the topology
+	// model. The model is persisted with a PCI tree fingerprint, so repeat
+	// invocations on an unchanged system skip the sysfs walks entirely.
+	std::vector<std::string> gpuBdfs;
+	gpuBdfs.reserve(allNodes.size());
+	for (const auto &node : allNodes) {
+		gpuBdfs.push_back(node.bdfAddress);
+	}
+	const auto model = GET_TOPOLOGY_MODEL(gpuBdfs);
+
 	// Append NIC nodes
-	if (const auto nicsOpt = GET_SYSTEM_NICS()) {
-		for (auto nicIdx = size_t{0}; nicIdx < nicsOpt->size(); ++nicIdx) {
-			const auto &nic = (*nicsOpt)[nicIdx];
+	if (model.nics) {
+		for (auto nicIdx = size_t{0}; nicIdx < model.nics->size(); ++nicIdx) {
+			const auto &nic = (*model.nics)[nicIdx];
 			allNodes.push_back(TopoNode{.label = std::format("NIC{}", nicIdx),
 										.cpuAffinity = nic.cpuAffinity,
 										.bdfAddress = nic.bdfAddress,
@@ -495,29 +591,17 @@ ze_result_t cmdTopology::buildTopologyMatrix(arg_struct *args, nlohmann::ordered
 		}
 	}
 
-	// Resolve NUMA and PCIe bridge paths — de-duplicate BDFs first to avoid
-	// redundant sysfs reads for multi-tile GPUs that share a BDF.
-	{
-		std::vector<std::string> bdfs;
-		bdfs.reserve(allNodes.size());
-		for (const auto &node : allNodes) {
-			bdfs.push_back(node.bdfAddress);
-		}
-		std::sort(bdfs.begin(), bdfs.end());
-		bdfs.erase(std::unique(bdfs.begin(), bdfs.end()), bdfs.end());
-
-		const auto numaMap = GET_NUMA_NODES(bdfs);
-		for (auto &node : allNodes) {
-			if (const auto it = numaMap.find(node.bdfAddress); it != numaMap.end()) {
-				node.numaNode = it->second;
-			}
+	// Attach NUMA and PCIe data and place every resolved path in the PCIe tree
+	PcieTree pcieTree;
+	std::vector<std::optional<size_t>> treeNodes(allNodes.size());
+	for (size_t i = 0; i < allNodes.size(); ++i) {
+		auto &node = allNodes[i];
+		if (const auto it = model.numaNodes.find(node.bdfAddress); it != model.numaNodes.end()) {
+			node.numaNode = it->second;
 		}
-
-		const auto pcieMap = GET_PCIE_PATHS(bdfs);
-		for (auto &node : allNodes) {
-			if (const auto it = pcieMap.find(node.bdfAddress); it != pcieMap.end()) {
-				node.pciePath = it->second;
-			}
+		if (const auto it = model.pciePaths.find(node.bdfAddress); it != model.pciePaths.end()) {
+			node.pciePath = it->second;
+			treeNodes[i] = pcieTree.insert(it->second);
 		}
 	}
 
@@ -540,7 +624,11 @@ ze_result_t cmdTopology::buildTopologyMatrix(arg_struct *args, nlohmann::ordered
 
 		std::vector<std::string> connections;
 		for (const auto col : std::views::iota(size_t{0}, nodeCount)) {
-			const std::string linkType = determineLinkType(allNodes[row], allNodes[col]);
+			std::optional<size_t> pcieCommonDepth;
+			if (treeNodes[row] && treeNodes[col]) {
+				pcieCommonDepth = pcieTree.commonDepth(*treeNodes[row], *treeNodes[col]);
+			}
+			const std::string linkType = determineLinkType(allNodes[row], allNodes[col], pcieCommonDepth);
 			connections.push_back(linkType);
 
 			nlohmann::ordered_json topoEntry;
@@ -604,6 +692,36 @@ std::string cmdTopology::determineLinkType(const TopoNode &node1, const TopoNode
 {
 	TRACING();
 
+	// Path is root-first, so the number of leading equal hops is the common depth
+	std::optional<size_t> pcieCommonDepth;
+	if (node1.pciePath.has_value() && node2.pciePath.has_value()) {
+		const auto &p1 = *node1.pciePath;
+		const auto &p2 = *node2.pciePath;
+		size_t commonLen = 0;
+		while (commonLen < std::min(p1.size(), p2.size()) && p1[commonLen].bdf == p2[commonLen].bdf) {
+			++commonLen;
+		}
+		pcieCommonDepth = commonLen;
+	}
+
+	return determineLinkType(node1, node2, pcieCommonDepth);
+}
+
+/**
+ * @brief Determines the connection type from a precomputed PCIe common depth
+ * @ingroup topology_matrix
+ *
+ * Same decision chain as determineLinkType(const TopoNode &, const TopoNode &);
+ * the PCIe step uses @p pcieCommonDepth instead of comparing the paths.
+ *
+ * @param[in] node1           First topology node
+ * @param[in] node2           Second topology node
+ * @param[in] pcieCommonDepth Shared bridge count, or nullopt if either path is unknown
+ * @return One of: "S", "MDF", "PIX", "PXB", "PHB", "NODE", "SYS"
+ */
+std::string cmdTopology::determineLinkType(const TopoNode &node1, const TopoNode &node2,
+										   std::optional<size_t> pcieCommonDepth)
+{
 	// Self — compare stable node identity rather than display label
 	if (const auto *g1 = std::get_if<GpuData>(&node1.data)) {
 		if (const auto *g2 = std::get_if<GpuData>(&node2.data)) {
@@ -628,22 +746,13 @@ std::string cmdTopology::determineLinkType(const TopoNode &node1, const TopoNode
 		}
 	}
 
-	// PCIe path comparison: find the deepest common bridge ancestor.
+	// PCIe path comparison by deepest common bridge ancestor.
 	// Path is root-first (index 0 = root complex, index 1 = root port, ...).
 	//   commonLen == 1  → PHB (share only the root complex)
 	//   commonLen == 2  → PXB (share root complex + root port)
 	//   commonLen >= 3  → PIX (share a PCIe switch)
-	if (node1.pciePath.has_value() && node2.pciePath.has_value()) {
-		const auto &p1 = *node1.pciePath;
-		const auto &p2 = *node2.pciePath;
-		size_t commonLen = 0;
-		for (size_t i = 0; i < std::min(p1.size(), p2.size()); ++i) {
-			if (p1[i].bdf == p2[i].bdf) {
-				commonLen = i + 1;
-			} else {
-				break;
-			}
-		}
+	if (pcieCommonDepth.has_value()) {
+		const size_t commonLen = *pcieCommonDepth;
 		if (commonLen >= 3) {
 			return "PIX";
 		}
@@ -659,15 +768,64 @@ std::string cmdTopology::determineLinkType(const TopoNode &node1, const TopoNode
 
 	// Fall back to NUMA comparison only when PCIe path data is absent for at
 	// least one node. Two nullopt nodes must not be treated as co-located.
-	if (!node1.pciePath.has_value() || !node2.pciePath.has_value()) {
-		if (node1.numaNode.has_value() && node1.numaNode == node2.numaNode) {
-			return "NODE";
-		}
+	if (node1.numaNode.has_value() && node1.numaNode == node2.numaNode) {
+		return "NODE";
 	}
 
 	return "SYS";
 }
 
+/**
+ * @brief Inserts a bridge chain into the PCIe tree
+ * @ingroup topology_matrix
+ *
+ * @param[in] path Root-first bridge chain
+ * @return Index of the node for the last hop
+ */
+size_t PcieTree::insert(const PciePath &path)
+{
+	size_t current = 0;
+	for (const auto &hop : path) {
+		const auto it = nodes[current].children.find(hop.bdf);
+		if (it != nodes[current].children.end()) {
+			current = it->second;
+			continue;
+		}
+		const size_t child = nodes.size();
+		const size_t depth = nodes[current].depth + 1;
+		nodes[current].children.emplace(hop.bdf, child);
+		nodes.push_back(Node{.parent = current, .depth = depth, .children = {}});
+		current = child;
+	}
+	return current;
+}
+
+/**
+ * @brief Depth of the lowest common ancestor of two tree nodes
+ * @ingroup topology_matrix
+ *
+ * Lifts the deeper node to the other's depth, then walks both up together.
+ * PCIe chains are a handful of hops deep, so the walk is bounded by that depth.
+ *
+ * @param[in] a Node index returned by insert()
+ * @param[in] b Node index returned by insert()
+ * @return Number of shared bridges
+ */
+size_t PcieTree::commonDepth(size_t a, size_t b) const
+{
+	while (nodes[a].depth > nodes[b].depth) {
+		a = nodes[a].parent;
+	}
+	while (nodes[b].depth > nodes[a].depth) {
+		b = nodes[b].parent;
+	}
+	while (a != b) {
+		a = nodes[a].parent;
+		b = nodes[b].parent;
+	}
+	return nodes[a].depth;
+}
+
 /**
  * @brief Displays the topology connectivity matrix for all GPU devices and NICs
  * @ingroup topology_matrix
@@ -716,6 +874,140 @@ ze_result_t cmdTopology::showMatrix(bool useJson)
 	return ZE_RESULT_SUCCESS;
 }
 
+/**
+ * @brief Serializes the fabric rates of one sample window
+ * @ingroup topology_matrix
+ *
+ * @param[in]  matrix   Link matrix built from @p rates
+ * @param[in]  rates    Per-port rates of every device
+ * @param[in]  interval Length of the window
+ * @param[out] jsonObj  Receives @c "link_utilization" with:
+ *                      - @c "devices": device IDs in row/column order
+ *                      - @c "matrix": per row device, @c "linked", @c "utilization" (%) and
+ *                        @c "throughput" (MB/s) towards every column device
+ *                      - @c "ports": per fabric port, its IDs and rx/tx rates (MB/s, %)
+ *                      Unknown values are null.
+ */
+void cmdTopology::linkUtilizationToJson(const fabric_telemetry::LinkMatrix &matrix,
+										std::span<const fabric_telemetry::DeviceRates> rates,
+										std::chrono::milliseconds interval, nlohmann::ordered_json *jsonObj)
+{
+	const auto toMb = [](const std::optional<double> &bytesPerSec) -> std::optional<double> {
+		return bytesPerSec ? std::optional<double>(*bytesPerSec / BYTES_PER_MB) : std::nullopt;
+	};
+
+	nlohmann::ordered_json rows = nlohmann::ordered_json::array();
+	for (size_t row = 0; row < matrix.devices.size(); ++row) {
+		nlohmann::ordered_json linked = nlohmann::ordered_json::array();
+		nlohmann::ordered_json utilization = nlohmann::ordered_json::array();
+		nlohmann::ordered_json throughput = nlohmann::ordered_json::array();
+		for (const auto &cell : matrix.cells[row]) {
+			linked.push_back(cell.linked);
+			utilization.push_back(numberOrNull(cell.utilization));
+			throughput.push_back(numberOrNull(toMb(cell.bytesPerSec)));
+		}
+		rows.push_back({{"device_id", matrix.devices[row]},
+						{"linked", linked},
+						{"utilization", utilization},
+						{"throughput", throughput}});
+	}
+
+	nlohmann::ordered_json ports = nlohmann::ordered_json::array();
+	for (const auto &device : rates) {
+		for (const auto &port : device.ports) {
+			ports.push_back({{"device_id", device.deviceIndex},
+							 {"subdevice_id", port.subdeviceId},
+							 {"port", fabric_telemetry::portLabel(port.portId)},
+							 {"remote_port", port.peer ? nlohmann::ordered_json(fabric_telemetry::portLabel(*port.peer))
+													   : nlohmann::ordered_json(nullptr)},
+							 {"rx_throughput", numberOrNull(toMb(port.rxBytesPerSec))},
+							 {"tx_throughput", numberOrNull(toMb(port.txBytesPerSec))},
+							 {"rx_utilization", numberOrNull(port.rxUtilization())},
+							 {"tx_utilization", numberOrNull(port.txUtilization())}});
+		}
+	}
+
+	(*jsonObj)["link_utilization"] = {{"interval_ms", interval.count()},
+									  {"devices", matrix.devices},
+									  {"matrix", rows},
+									  {"ports", ports}};
+}
+
+/**
+ * @brief Displays the fabric link utilization between all devices
+ * @ingroup topology_matrix
+ *
+ * Every device's port counters are read with one batched call per sample, together
+ * with the port states that tell which device is at the other end of each link. The
+ * after-sample of one window is the before-sample of the next, so consecutive windows
+ * leave no gap.
+ *
+ * @param[in] useJson  If true, output JSON format; if false, output text tables
+ * @param[in] interval Sample window
+ * @param[in] count    Number of windows to print; 0 for no limit
+ *
+ * @retval ZE_RESULT_SUCCESS             Utilization displayed
+ * @retval ZE_RESULT_ERROR_DEVICE_LOST   No devices found in system
+ * @retval ZE_RESULT_ERROR_UNINITIALIZED currentArgs not set
+ */
+ze_result_t cmdTopology::showLinkUtilization(bool useJson, std::chrono::milliseconds interval, int count)
+{
+	TRACING();
+
+	if (currentArgs == nullptr) {
+		ERR("Internal error: currentArgs not initialized\n");
+		return ZE_RESULT_ERROR_UNINITIALIZED;
+	}
+
+	std::vector<devInfo> deviceList;
+	const auto result = currentArgs->sm.findDevice("", &deviceList);
+	if (result != ZE_RESULT_SUCCESS || deviceList.empty()) {
+		nlohmann::ordered_json jsonObj = {{"error", "No devices found or error getting device list"}};
+		if (useJson) {
+			JsonPrinter().print(&jsonObj);
+		} else {
+			TopologyTextPrinter().print(&jsonObj);
+		}
+		return result != ZE_RESULT_SUCCESS ? result : ZE_RESULT_ERROR_DEVICE_LOST;
+	}
+
+	const auto sampleAll = [&deviceList](std::vector<fabric_telemetry::DeviceSample> &samples) {
+		samples.resize(deviceList.size());
+		for (size_t i = 0; i < deviceList.size(); ++i) {
+			// Devices without fabric ports stay in the matrix with no links
+			fabric_telemetry::sampleDevice(deviceList[i], samples[i], true);
+		}
+	};
+
+	std::vector<fabric_telemetry::DeviceSample> before;
+	std::vector<fabric_telemetry::DeviceSample> after;
+	sampleAll(before);
+	auto deadline = std::chrono::steady_clock::now();
+	for (int window = 0; count == 0 || window < count; ++window) {
+		deadline += interval;
+		std::this_thread::sleep_until(deadline);
+		sampleAll(after);
+
+		std::vector<fabric_telemetry::DeviceRates> rates(deviceList.size());
+		for (size_t i = 0; i < deviceList.size(); ++i) {
+			rates[i] = fabric_telemetry::DeviceRates{.deviceIndex = deviceList[i].index,
+													 .ports = fabric_telemetry::computeRates(before[i], after[i])};
+		}
+		const auto matrix = fabric_telemetry::buildLinkMatrix(rates);
+
+		nlohmann::ordered_json jsonObj;
+		linkUtilizationToJson(matrix, rates, interval, &jsonObj);
+		if (useJson) {
+			JsonPrinter().print(&jsonObj);
+		} else {
+			TopologyTextPrinter().print(&jsonObj);
+		}
+		std::swap(before, after);
+	}
+
+	return ZE_RESULT_SUCCESS;
+}
+
 /**
  * @brief Executes the topology command with parsed command line arguments
  * @ingroup topology_commands
@@ -774,6 +1066,12 @@ int cmdTopology::run(arg_struct *args)
 			xmlFilename = val;
 		});
 	sub.add_flag("-m,--matrix", topologyCmds[topologyCmdType::TOPOLOGY_MATRIX].enabled, "Show topology matrix");
+	sub.add_flag("-u,--link-util", topologyCmds[topologyCmdType::TOPOLOGY_LINK_UTIL].enabled,
+				 "Show fabric link utilization");
+	linkInterval = 1;
+	linkCount = 1;
+	sub.add_option("-i,--interval", linkInterval, "Link utilization sample window in seconds");
+	sub.add_option("-n,--number", linkCount, "Number of link utilization samples, 0 = until interrupted");
 
 	try {
 		sub.parse(args->argc - 1, args->argv + 1);
@@ -789,9 +1087,32 @@ int cmdTopology::run(arg_struct *args)
 	const bool useJson = topologyCmds[topologyCmdType::TOPOLOGY_JSON].enabled;
 	auto textPrinter = std::make_unique<TopologyTextPrinter>();
 
-	// Handle matrix command
+	const bool linkUtil = topologyCmds[topologyCmdType::TOPOLOGY_LINK_UTIL].enabled;
+	if (linkInterval < 1 || linkInterval > LINK_UTIL_MAX_INTERVAL_S) {
+		ERR("--interval must be between 1 and {} seconds\n", LINK_UTIL_MAX_INTERVAL_S);
+		return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+	}
+	if (linkCount < 0) {
+		ERR("--number must not be negative\n");
+		return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+	}
+	if (linkUtil && linkCount == 0 && batchMode) {
+		ERR("--number 0 runs until interrupted; give a positive count inside --batch\n");
+		return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+	}
+	const auto linkWindow = std::chrono::milliseconds(std::chrono::seconds(linkInterval));
+
+	// Handle matrix command, followed by the link utilization when both are asked for
 	if (topologyCmds[topologyCmdType::TOPOLOGY_MATRIX].enabled) {
-		return showMatrix(useJson);
+		result = showMatrix(useJson);
+		if (result != ZE_RESULT_SUCCESS || !linkUtil) {
+			return result;
+		}
+		return showLinkUtilization(useJson, linkWindow, linkCount);
+	}
+
+	if (linkUtil) {
+		return showLinkUtilization(useJson, linkWindow, linkCount);
 	}
 
 	// Handle file generation command
@@ -8,10 +8,14 @@
 #define _CMD_TOPOLOGY_H
 
 #include "cmds.h"
+#include "fabric_telemetry.h"
 #include "printer.h"
+#include <chrono>
+#include <map>
 #include <optional>
 #include <variant>
 #include <os.h>
+#include <span>
 #include <string>
 #include <format>
 
@@ -57,6 +61,44 @@ struct TopoNode
 	std::variant<GpuData, NicData> data; ///< Kind-specific payload; holds_alternative<GpuData> ↔ GPU
 };
 
+/**
+ * @brief Prefix tree of PCIe bridge chains with lowest-common-ancestor queries
+ *
+ * Every distinct chain prefix maps to one node, so devices behind the same switch
+ * end on the same node. The depth of the lowest common ancestor of two nodes is
+ * the number of bridges their paths share, which is what link classification needs.
+ */
+class PcieTree
+{
+public:
+	/**
+	 * @brief Inserts a bridge chain, reusing existing prefixes
+	 * @param path Root-first chain as returned by getPciePaths()
+	 * @return Index of the node for the last hop (0 = virtual root for an empty path)
+	 */
+	size_t insert(const PciePath &path);
+
+	/**
+	 * @brief Depth of the lowest common ancestor of two nodes
+	 * @param a Node index returned by insert()
+	 * @param b Node index returned by insert()
+	 * @return Number of shared bridges; 0 when the chains share no root complex
+	 */
+	[[nodiscard]] size_t commonDepth(size_t a, size_t b) const;
+
+	[[nodiscard]] size_t size() const { return nodes.size(); }
+
+private:
+	struct Node
+	{
+		size_t parent;
+		size_t depth;
+		std::map<std::string, size_t, std::less<>> children;
+	};
+
+	std::vector<Node> nodes{Node{.parent = 0, .depth = 0, .children = {}}}; ///< Node 0 is the virtual root
+};
+
 /**
  * @brief Device topology information structure
  *
@@ -135,6 +177,7 @@ enum class topologyCmdType
 	TOPOLOGY_DEVICE,
 	TOPOLOGY_FILE,
 	TOPOLOGY_MATRIX,
+	TOPOLOGY_LINK_UTIL,
 	TOTAL_TOPOLOGY,
 };
 
@@ -152,6 +195,18 @@ public:
 	// Public for unit testing
 	static std::string determineLinkType(const TopoNode &node1, const TopoNode &node2);
 
+	/**
+	 * @brief Classifies a node pair using a precomputed PCIe common-ancestor depth
+	 *
+	 * @param node1             First topology node
+	 * @param node2             Second topology node
+	 * @param pcieCommonDepth   PcieTree::commonDepth() of the two nodes, or nullopt when
+	 *                          either PCIe path is unknown
+	 * @return One of: "S", "MDF", "PIX", "PXB", "PHB", "NODE", "SYS"
+	 */
+	static std::string determineLinkType(const TopoNode &node1, const TopoNode &node2,
+										 std::optional<size_t> pcieCommonDepth);
+
 	/**
 	 * @brief Generates an XML topology file with system topology information
 	 *
@@ -175,6 +230,34 @@ public:
 	 */
 	[[nodiscard]] ze_result_t showMatrix(bool useJson);
 
+	/**
+	 * @brief Samples the fabric throughput of all devices and displays their link utilization
+	 *
+	 * Reads the fabric port counters of every device once per @p interval and prints the
+	 * device x device utilization matrix for each window, @p count times (0 = until
+	 * interrupted). Prints results directly.
+	 *
+	 * @param[in] useJson  If true, output as JSON; otherwise as text
+	 * @param[in] interval Sample window
+	 * @param[in] count    Number of windows to print; 0 for no limit
+	 * @return ZE_RESULT_SUCCESS on success, error code on failure
+	 */
+	[[nodiscard]] ze_result_t showLinkUtilization(bool useJson, std::chrono::milliseconds interval, int count);
+
+	/**
+	 * @brief Serializes fabric rates of one sample window for output
+	 *
+	 * Public for unit testing.
+	 *
+	 * @param[in]  matrix   Link matrix built from @p rates
+	 * @param[in]  rates    Per-port rates of every device
+	 * @param[in]  interval Length of the window
+	 * @param[out] jsonObj  Receives @c "link_utilization": devices, per-pair matrix and per-port rates
+	 */
+	static void linkUtilizationToJson(const fabric_telemetry::LinkMatrix &matrix,
+									  std::span<const fabric_telemetry::DeviceRates> rates,
+									  std::chrono::milliseconds interval, nlohmann::ordered_json *jsonObj);
+
 	/**
 	 * @brief Executes the topology command with parsed command line arguments
 	 *
@@ -185,6 +268,8 @@ public:
 
 private:
 	arg_struct *currentArgs = nullptr; ///< Cached pointer to command arguments
+	int linkInterval = 1;			   ///< --interval of the link utilization view, in seconds
+	int linkCount = 1;				   ///< --number of the link utilization view; 0 = until interrupted
 
 	/**
 	 * @brief Displays topology information for a specified device
@@ -5,11 +5,11 @@
  */
 
 #include "cmd_updatefw.h"
-#include <fs_lock.h>
 #include <debug.h>
+#include <mei_registry.h>
+#include <task_executor.h>
 #include <assert.h>
 #include <CLI/CLI.hpp>
-#include <thread>
 #include <atomic>
 #include <cerrno>
 #include <cstring>
@@ -109,17 +109,7 @@ int cmdUpdateFW::run(arg_struct *args)
 	std::vector<devInfo> deviceList;
 	ze_result_t result;
 
-	// Acquire global firmware update lock (cross-process)
-	FSLock fsLock;
-	if (!fsLock.locked()) {
-		ERR("Another firmware update operation is already in progress or lock could not be acquired.\n");
-		return ZE_RESULT_ERROR_UNKNOWN;
-	}
-
-	uint32_t totalThreads = 0;
 	std::atomic<uint32_t> curThread{0};
-	std::atomic<ze_result_t> firstError{ZE_RESULT_SUCCESS};
-	std::vector<std::thread> workers;
 
 	CLI::App sub{"Update GPU firmware", "updatefw"};
 	sub.set_help_flag("-h,--help", "Print this help message and exit");
@@ -179,56 +169,56 @@ int cmdUpdateFW::run(arg_struct *args)
 		return result;
 	}
 
-	// Print a newline for every thread that we will be creating. Also count the total number of threads
-	// as this will come in handy later.
+	const bool isAmc = STRCASECMP(fwInfo.firmwareType.c_str(), "amc") == 0;
+	std::vector<devInfo *> targets;
+	std::vector<devInfo> lockTargets;
 	for (auto &device : deviceList) {
-		if ((STRCASECMP(fwInfo.firmwareType.c_str(), "amc") == 0 && device.dev->getAmcIndex() != -1) ||
-			STRCASECMP(fwInfo.firmwareType.c_str(), "amc") != 0) {
-			PRINT("\n");
-			totalThreads++;
+		if (!isAmc || device.dev->getAmcIndex() != -1) {
+			targets.push_back(&device);
+			lockTargets.push_back(device);
 		}
 	}
 
-	// Parallelize per-device firmware updates
-	workers.reserve(totalThreads);
+	// Only the devices being updated are locked; other processes may update the rest
+	const DeviceLocks locks = lockDevices(lockTargets, DeviceLockMode::EXCLUSIVE, isAmc);
+	if (!locks.locked()) {
+		return ZE_RESULT_ERROR_NOT_AVAILABLE;
+	}
 
-	for (auto &device : deviceList) {
-		if ((STRCASECMP(fwInfo.firmwareType.c_str(), "amc") == 0 && device.dev->getAmcIndex() != -1) ||
-			STRCASECMP(fwInfo.firmwareType.c_str(), "amc") != 0) {
-			workers.emplace_back([&, fwInfo, totalThreads, devPtr = &device]() {
-				// Make a thread‑local copy of firmwareInfo to avoid data races
-				firmwareInfo localInfo = fwInfo;
-				localInfo.dev = devPtr->dev;
-				localInfo.deviceIndex = devPtr->index;
-				localInfo.amcIndex = devPtr->dev->getAmcIndex();
-				localInfo.totalThreads = totalThreads;
-				localInfo.curThread = curThread.fetch_add(1, std::memory_order_relaxed);
-
-				firmware *fw = devPtr->dev->getFirmware();
-				if (fw == nullptr) {
-					ERR("Error: Firmware pointer not found (device {}).\n", devPtr->index);
-					ze_result_t expected = ZE_RESULT_SUCCESS;
-					firstError.compare_exchange_strong(expected, ZE_RESULT_ERROR_UNKNOWN);
-					return;
-				}
-				if (fw->updateFW(&localInfo) != ZE_RESULT_SUCCESS) {
-					ERR("Error: Failed to update firmware for device {}.\n", devPtr->index);
-					ze_result_t expected = ZE_RESULT_SUCCESS;
-					firstError.compare_exchange_strong(expected, ZE_RESULT_ERROR_UNKNOWN);
-					return;
-				}
-			});
-		}
+	// Print a newline for every device that we will be updating, as each gets its own progress line.
+	for (size_t i = 0; i < targets.size(); ++i) {
+		PRINT("\n");
 	}
+	const auto totalThreads = static_cast<uint32_t>(targets.size());
 
-	for (auto &t : workers) {
-		if (t.joinable()) {
-			t.join();
+	// Parallelize per-device firmware updates
+	const DeviceResults outcome = parallelForEach(targets, [&](devInfo *devPtr) {
+		PIN_THREAD_TO_DEVICES({devPtr->dev->getBDFStr()});
+		// Make a thread‑local copy of firmwareInfo to avoid data races
+		firmwareInfo localInfo = fwInfo;
+		localInfo.dev = devPtr->dev;
+		localInfo.deviceIndex = devPtr->index;
+		localInfo.amcIndex = devPtr->dev->getAmcIndex();
+		localInfo.totalThreads = totalThreads;
+		localInfo.curThread = curThread.fetch_add(1, std::memory_order_relaxed);
+
+		firmware *fw = devPtr->dev->getFirmware();
+		if (fw == nullptr) {
+			ERR("Error: Firmware pointer not found (device {}).\n", devPtr->index);
+			return ZE_RESULT_ERROR_UNKNOWN;
 		}
-	}
+		if (fw->updateFW(&localInfo) != ZE_RESULT_SUCCESS) {
+			ERR("Error: Failed to update firmware for device {}.\n", devPtr->index);
+			return ZE_RESULT_ERROR_UNKNOWN;
+		}
+		return ZE_RESULT_SUCCESS;
+	});
+
+	// Updated firmware can report a new status; later MEI lookups enumerate again
+	MeiRegistry::instance().invalidate();
 
-	if (firstError != ZE_RESULT_SUCCESS) {
-		return firstError.load();
+	if (!outcome.ok()) {
+		return outcome.first();
 	} else {
 		if (totalThreads > 0) {
 			PRINT("\n"); // Move the cursor to the next line after the last progress bar
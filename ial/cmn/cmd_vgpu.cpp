@@ -12,7 +12,11 @@
 #include <osvf.h>
 #include <algorithm>
 #include <assert.h>
+#include <charconv>
 #include <cinttypes>
+#include <optional>
+#include <stop_token>
+#include <thread>
 
 static std::unordered_map<vgpuCmdType, vgpuCmdStruct> vgpuCmds = {
 	{VGPU_HELP, {}},
@@ -25,8 +29,79 @@ static std::unordered_map<vgpuCmdType, vgpuCmdStruct> vgpuCmds = {
 	{VGPU_LIST, {.func = &cmdVgpu::listGpus}},
 	{VGPU_STATS, {.func = &cmdVgpu::stats}},
 	{VGPU_LMEM, {}},
+	{VGPU_INTERVAL, {}},
+	{VGPU_LOOP, {}},
+	{VGPU_COUNT, {}},
 };
 
+/**
+ * @brief Parses a strictly positive integer option value.
+ *
+ * @param str Option value as given on the command line
+ * @return The parsed value, or std::nullopt if it is not a positive integer
+ */
+static std::optional<int> parsePositiveInt(const std::string &str)
+{
+	int value = 0;
+	const auto res = std::from_chars(str.data(), str.data() + str.size(), value);
+	if (res.ec != std::errc{} || res.ptr != str.data() + str.size() || value <= 0) {
+		return std::nullopt;
+	}
+	return value;
+}
+
+/**
+ * @brief Prints the statistics tables for all VFs of one physical GPU.
+ *
+ * @param pfBdf PCI BDF address of the physical GPU
+ * @param vfStatsList Statistics of the VFs on that GPU
+ */
+static void printVFStats(const std::string &pfBdf, const std::vector<VFStatsInfo> &vfStatsList)
+{
+	if (vfStatsList.empty()) {
+		PRINT("No virtual GPUs found on device {}.\n", pfBdf.c_str());
+		return;
+	}
+
+	for (const auto &vfStats : vfStatsList) {
+		static constexpr size_t bdfStringSize = 16; // "DDDD:BB:DD.F" max length
+		char vfBdf[bdfStringSize];
+		snprintf(vfBdf, sizeof(vfBdf), "%04x:%02x:%02x.%x", vfStats.domain, vfStats.bus, vfStats.device,
+				 vfStats.function);
+
+		double memPercent = -1.0;
+		if (vfStats.vfDeviceMemSize > 0) {
+			memPercent =
+				(static_cast<double>(vfStats.memoryUtilized) / static_cast<double>(vfStats.vfDeviceMemSize)) * 100.0;
+			memPercent = std::min(memPercent, 100.0);
+		}
+
+		TableBuilder table;
+		table.addColumn("Metric", 26, Align::Left).addColumn("Value", 67, Align::Left);
+
+		table.addSeparator();
+		table.addSpanRow("Device Information");
+		table.addSeparator();
+
+		table.addRow("PCI BDF Address", vfBdf);
+		table.addRow("GPU Utilization (%)",
+					 vfStats.gpuUtilization >= 0.0 ? std::format("{:.0f}", vfStats.gpuUtilization) : "N/A");
+		table.addRow("Compute Engine Util(%)",
+					 vfStats.computeUtilization >= 0.0 ? std::format("{:.0f}", vfStats.computeUtilization) : "N/A");
+		table.addRow("Render Engine Util (%)",
+					 vfStats.renderUtilization >= 0.0 ? std::format("{:.0f}", vfStats.renderUtilization) : "N/A");
+		table.addRow("Media Engine Util (%)",
+					 vfStats.mediaUtilization >= 0.0 ? std::format("{:.0f}", vfStats.mediaUtilization) : "N/A");
+		table.addRow("Copy Engine Util (%)",
+					 vfStats.copyUtilization >= 0.0 ? std::format("{:.0f}", vfStats.copyUtilization) : "N/A");
+		table.addRow("GPU Memory Util (%)", memPercent >= 0.0 ? std::format("{:.0f}", memPercent) : "N/A");
+
+		table.addSeparator();
+
+		PRINT("{}", table.toString().c_str());
+	}
+}
+
 /**
  * @brief Adds help commands to the provided help list.
  *
@@ -52,6 +127,7 @@ void cmdVgpu::help(HELP helpType)
 	helpList.emplace_back(HEADING, "%s vgpu --device [deviceId] -l", progName.c_str());
 	helpList.emplace_back(HEADING, "%s vgpu --device [pciBdfAddress] -l", progName.c_str());
 	helpList.emplace_back(HEADING, "%s vgpu --device [deviceId] -s", progName.c_str());
+	helpList.emplace_back(HEADING, "%s vgpu -s --loop --interval [ms] --count [count]", progName.c_str());
 	helpList.emplace_back(BLANK);
 	helpList.emplace_back(TITLE, "Options:");
 	helpList.emplace_back(HEADING, "-h,--help                   Print this help message and exit");
@@ -69,6 +145,9 @@ void cmdVgpu::help(HELP helpType)
 	helpList.emplace_back(HEADING, "-l,--list,--supported       List all virtual "
 								   "GPUs on the specified physical GPU");
 	helpList.emplace_back(HEADING, "-s,--stats,--utilization    Show statistics data of all virtual GPUs");
+	helpList.emplace_back(HEADING, "--interval                  Statistics sample window in milliseconds (default: 100)");
+	helpList.emplace_back(HEADING, "--loop                      Continuously print statistics every sample window");
+	helpList.emplace_back(HEADING, "--count                     Number of samples to print in loop mode (default: unlimited)");
 
 	printHelp(helpList, helpType);
 	helpList.clear();
@@ -276,64 +355,86 @@ ze_result_t cmdVgpu::listGpus(devInfo *d)
 ze_result_t cmdVgpu::stats(devInfo *d)
 {
 	TRACING();
-	std::vector<VFStatsInfo> vfStatsList;
-	vf *vfHandle = d->dev->getVF();
-	pci *pciHandle = d->dev->getPCI();
+	std::vector<devInfo> deviceList{*d};
+	return statsAll(deviceList);
+}
 
-	DeviceSriovInfo deviceInfo = {};
-	deviceInfo.bdfAddress = pciHandle->getBDFStr();
-	deviceInfo.drmPath = d->dev->getDrmDevPath();
+/**
+ * @brief Retrieves statistics for the virtual GPUs of several physical GPUs
+ *
+ * All VFs on all listed devices are sampled over one shared window through
+ * vfStatsCollector, instead of one window per device. With --loop the
+ * collector keeps streaming: every iteration reuses the previous ending
+ * snapshot, so each sample costs one engine query per VF and no extra sleep.
+ *
+ * @param deviceList Physical GPUs whose virtual GPUs are reported
+ * @return ze_result_t ZE_RESULT_SUCCESS on successful statistics retrieval
+ */
+ze_result_t cmdVgpu::statsAll(std::vector<devInfo> &deviceList)
+{
+	TRACING();
+	auto interval = VGPU_STATS_DEFAULT_INTERVAL;
+	int count = 1;
 
-	ze_result_t result = vfHandle->getVFStatsList(&deviceInfo, vfStatsList);
-	if (result != ZE_RESULT_SUCCESS) {
-		ERR("Failed to get VF statistics.\n");
-		return result;
+	if (vgpuCmds[vgpuCmdType::VGPU_INTERVAL].enabled) {
+		interval = std::chrono::milliseconds{*parsePositiveInt(vgpuCmds[vgpuCmdType::VGPU_INTERVAL].val)};
+	}
+	if (vgpuCmds[vgpuCmdType::VGPU_LOOP].enabled) {
+		count = vgpuCmds[vgpuCmdType::VGPU_COUNT].enabled ? *parsePositiveInt(vgpuCmds[vgpuCmdType::VGPU_COUNT].val)
+														   : 0;
 	}
 
-	if (vfStatsList.empty()) {
-		PRINT("No virtual GPUs found on device {}.\n", pciHandle->getBDFStr().c_str());
-		return ZE_RESULT_SUCCESS;
+	vfStatsCollector collector;
+	std::vector<std::string> pfBdfs;
+	for (auto &dev : deviceList) {
+		DeviceSriovInfo deviceInfo = {};
+		deviceInfo.bdfAddress = dev.dev->getPCI()->getBDFStr();
+		deviceInfo.drmPath = dev.dev->getDrmDevPath();
+		pfBdfs.push_back(deviceInfo.bdfAddress);
+		collector.addDevice(dev.dev->getVF(), deviceInfo);
 	}
 
-	for (const auto &vfStats : vfStatsList) {
-		static constexpr size_t bdfStringSize = 16; // "DDDD:BB:DD.F" max length
-		char vfBdf[bdfStringSize];
-		snprintf(vfBdf, sizeof(vfBdf), "%04x:%02x:%02x.%x", vfStats.domain, vfStats.bus, vfStats.device,
-				 vfStats.function);
+	std::stop_source quitSource;
+	auto quitToken = quitSource.get_token();
+	std::jthread inputThread;
+	if (count == 0 && !batchMode && STDIN_ISATTY()) {
+		inputThread = std::jthread([quitSource, quitToken](const std::stop_token &ownStop) mutable {
+			char ch = 0;
+			while (!ownStop.stop_requested() && !quitToken.stop_requested()) {
+				ch = GETCH();
+				if (ch == 'q' || ch == 'Q' || ch == 27 || ch == 3) {
+					quitSource.request_stop();
+					return;
+				}
+			}
+		});
+	}
 
-		double memPercent = -1.0;
-		if (vfStats.vfDeviceMemSize > 0) {
-			memPercent =
-				(static_cast<double>(vfStats.memoryUtilized) / static_cast<double>(vfStats.vfDeviceMemSize)) * 100.0;
-			memPercent = std::min(memPercent, 100.0);
+	ze_result_t result = ZE_RESULT_SUCCESS;
+	std::vector<std::vector<VFStatsInfo>> statsLists;
+	while (!quitToken.stop_requested()) {
+		result = collector.collect(interval, statsLists);
+		if (result != ZE_RESULT_SUCCESS) {
+			ERR("Failed to get VF statistics.\n");
+			break;
 		}
 
-		TableBuilder table;
-		table.addColumn("Metric", 26, Align::Left).addColumn("Value", 67, Align::Left);
-
-		table.addSeparator();
-		table.addSpanRow("Device Information");
-		table.addSeparator();
-
-		table.addRow("PCI BDF Address", vfBdf);
-		table.addRow("GPU Utilization (%)",
-					 vfStats.gpuUtilization >= 0.0 ? std::format("{:.0f}", vfStats.gpuUtilization) : "N/A");
-		table.addRow("Compute Engine Util(%)",
-					 vfStats.computeUtilization >= 0.0 ? std::format("{:.0f}", vfStats.computeUtilization) : "N/A");
-		table.addRow("Render Engine Util (%)",
-					 vfStats.renderUtilization >= 0.0 ? std::format("{:.0f}", vfStats.renderUtilization) : "N/A");
-		table.addRow("Media Engine Util (%)",
-					 vfStats.mediaUtilization >= 0.0 ? std::format("{:.0f}", vfStats.mediaUtilization) : "N/A");
-		table.addRow("Copy Engine Util (%)",
-					 vfStats.copyUtilization >= 0.0 ? std::format("{:.0f}", vfStats.copyUtilization) : "N/A");
-		table.addRow("GPU Memory Util (%)", memPercent >= 0.0 ? std::format("{:.0f}", memPercent) : "N/A");
-
-		table.addSeparator();
+		for (size_t i = 0; i < statsLists.size(); i++) {
+			printVFStats(pfBdfs[i], statsLists[i]);
+		}
 
-		PRINT("{}", table.toString().c_str());
+		if (count > 0 && --count == 0) {
+			break;
+		}
 	}
 
-	return ZE_RESULT_SUCCESS;
+	if (inputThread.joinable()) {
+		inputThread.detach();
+	}
+	if (vgpuCmds[vgpuCmdType::VGPU_LOOP].enabled) {
+		RESTORE_TERMINAL();
+	}
+	return result;
 }
 
 /**
@@ -367,6 +468,11 @@ int cmdVgpu::run(arg_struct *args)
 	sub.add_flag("-s,--stats,--utilization", vgpuCmds[VGPU_STATS].enabled, "Show vGPU stats");
 	sub.add_option("--lmem", vgpuCmds[VGPU_LMEM].val, "Local memory size per vGPU (MB)")
 		->each([&](const std::string &) { vgpuCmds[VGPU_LMEM].enabled = true; });
+	sub.add_option("--interval", vgpuCmds[VGPU_INTERVAL].val, "Stats sample window in milliseconds")
+		->each([&](const std::string &) { vgpuCmds[VGPU_INTERVAL].enabled = true; });
+	sub.add_flag("--loop", vgpuCmds[VGPU_LOOP].enabled, "Continuously print vGPU stats");
+	sub.add_option("--count", vgpuCmds[VGPU_COUNT].val, "Number of stats samples in loop mode")
+		->each([&](const std::string &) { vgpuCmds[VGPU_COUNT].enabled = true; });
 
 	try {
 		sub.parse(args->argc - 1, args->argv + 1);
@@ -387,12 +493,53 @@ int cmdVgpu::run(arg_struct *args)
 		return ZE_RESULT_ERROR_INVALID_ARGUMENT;
 	}
 
+	if ((vgpuCmds[vgpuCmdType::VGPU_INTERVAL].enabled || vgpuCmds[vgpuCmdType::VGPU_LOOP].enabled ||
+		 vgpuCmds[vgpuCmdType::VGPU_COUNT].enabled) &&
+		!vgpuCmds[vgpuCmdType::VGPU_STATS].enabled) {
+		ERR("Error: --interval, --loop and --count can only be used with --stats.\n");
+		return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+	}
+
+	if (vgpuCmds[vgpuCmdType::VGPU_INTERVAL].enabled &&
+		!parsePositiveInt(vgpuCmds[vgpuCmdType::VGPU_INTERVAL].val).has_value()) {
+		ERR("Error: Invalid value for --interval: '{}'.\n", vgpuCmds[vgpuCmdType::VGPU_INTERVAL].val.c_str());
+		return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+	}
+
+	if (vgpuCmds[vgpuCmdType::VGPU_COUNT].enabled) {
+		if (!vgpuCmds[vgpuCmdType::VGPU_LOOP].enabled) {
+			ERR("Error: --count requires --loop.\n");
+			return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+		}
+		if (!parsePositiveInt(vgpuCmds[vgpuCmdType::VGPU_COUNT].val).has_value()) {
+			ERR("Error: Invalid value for --count: '{}'.\n", vgpuCmds[vgpuCmdType::VGPU_COUNT].val.c_str());
+			return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+		}
+	}
+	if (vgpuCmds[vgpuCmdType::VGPU_LOOP].enabled && !vgpuCmds[vgpuCmdType::VGPU_COUNT].enabled && batchMode) {
+		ERR("Error: --loop runs until stopped; give --count inside --batch.\n");
+		return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+	}
+
 	result = args->sm.findDevice(vgpuCmds[vgpuCmdType::VGPU_DEVICE].val.c_str(), &deviceList);
 	if (result != ZE_RESULT_SUCCESS) {
 		ERR("Error: Device handle not found for device ID '{}'.\n", vgpuCmds[vgpuCmdType::VGPU_DEVICE].val.c_str());
 		return result;
 	}
 
+	// Stats of all selected devices share one sample window
+	if (vgpuCmds[vgpuCmdType::VGPU_STATS].enabled) {
+		DBG("Running command: {}\n", vgpuCmdName(vgpuCmdType::VGPU_STATS));
+		return statsAll(deviceList);
+	}
+
+	// Creating and removing VFs rebinds the device; no other process may use it meanwhile
+	const bool mutating = vgpuCmds[vgpuCmdType::VGPU_CREATE].enabled || vgpuCmds[vgpuCmdType::VGPU_REMOVE].enabled;
+	const DeviceLocks locks = lockDevices(deviceList, mutating ? DeviceLockMode::EXCLUSIVE : DeviceLockMode::SHARED);
+	if (!locks.locked()) {
+		return ZE_RESULT_ERROR_NOT_AVAILABLE;
+	}
+
 	// Iterate through the device list and execute the command
 	for (auto &device : deviceList) {
 		// Call the appropriate command function based on the command type
@@ -9,7 +9,12 @@
 
 #include "cmds.h"
 #include <os.h>
+#include <chrono>
 #include <string_view>
+#include <vector>
+
+// Default sample window for VF engine utilization, in milliseconds
+constexpr auto VGPU_STATS_DEFAULT_INTERVAL = std::chrono::milliseconds{100};
 
 enum vgpuCmdType
 {
@@ -23,6 +28,9 @@ enum vgpuCmdType
 	VGPU_NUMBER,
 	VGPU_STATS,
 	VGPU_LMEM,
+	VGPU_INTERVAL,
+	VGPU_LOOP,
+	VGPU_COUNT,
 	TOTAL_VGPU,
 };
 
@@ -40,6 +48,7 @@ public:
 	ze_result_t remove(devInfo *d);
 	ze_result_t listGpus(devInfo *d);
 	ze_result_t stats(devInfo *d);
+	ze_result_t statsAll(std::vector<devInfo> &deviceList);
 	int run(arg_struct *args);
 };
 
@@ -5,6 +5,13 @@
  */
 
 #include "cmds.h"
+#include "debug.h"
+#include <format>
+
+// Monitoring gives up soon on a device that is being updated or reset; changing one
+// waits for the firmware update or reset of another process to finish.
+static constexpr std::chrono::seconds SHARED_LOCK_TIMEOUT{5};
+static constexpr std::chrono::seconds EXCLUSIVE_LOCK_TIMEOUT{60};
 
 /**
  * @brief Prints formatted help information for command line interfaces
@@ -28,4 +35,39 @@ void cmds::printHelp(std::vector<helpCmd> helpList, HELP helpType)
 			PRINT("{0:<{1}}{2}\n", "", it2.char_gap, it2.line);
 		}
 	}
-}
\ No newline at end of file
+}
+
+DeviceLocks lockDevices(const std::vector<devInfo> &devices, DeviceLockMode mode, bool withAmc)
+{
+	TRACING();
+	std::vector<DeviceLockRequest> requests;
+	for (const auto &device : devices) {
+		requests.push_back({DeviceLockManager::gpu(device.dev->getBDFStr()), mode});
+		if (withAmc && device.dev->getAmcIndex() != -1) {
+			requests.push_back({DeviceLockManager::amc(device.dev->getAmcIndex()), mode});
+		}
+	}
+
+	const auto timeout = mode == DeviceLockMode::EXCLUSIVE ? EXCLUSIVE_LOCK_TIMEOUT : SHARED_LOCK_TIMEOUT;
+	DeviceLocks locks = DeviceLockManager().acquire(std::move(requests), timeout);
+	if (locks.noLockDirectory()) {
+		ERR("Error: cannot lock {}: neither /var/lock/xpum nor a private per-user lock directory is usable; "
+			"set XPUM_LOCK_DIR to a directory only you can write to.\n",
+			locks.busyResource());
+	} else if (!locks.locked()) {
+		std::string holders;
+		for (int pid : locks.holders()) {
+			holders += std::format("{}{}", holders.empty() ? " (PID " : ", ", pid);
+		}
+		if (!holders.empty()) {
+			holders += ")";
+		}
+		ERR("Error: {} is in use by another process{}; try again later.\n", locks.busyResource(), holders);
+	}
+	for (const auto &resource : locks.unlockedResources()) {
+		ERR("Warning: cannot open the lock file of {}; continuing without a lock, so an operation by another "
+			"process may interfere.\n",
+			resource);
+	}
+	return locks;
+}
@@ -7,7 +7,9 @@
 #ifndef _CMDS_H
 #define _CMDS_H
 
+#include <chrono>
 #include <cstdarg>
+#include <device_lock.h>
 #include <driver.h>
 #include <list>
 #include <string>
@@ -16,6 +18,10 @@
 
 extern std::string progName;
 
+// Set while --batch runs a command. Its standard input is the rest of the script, so a
+// command must neither read the keyboard nor loop until the user stops it.
+inline bool batchMode = false;
+
 enum GAP
 {
 	TITLE = 0,
@@ -77,6 +83,16 @@ public:
 	virtual int run(arg_struct *args) = 0;
 };
 
+/**
+ * @brief Locks the GPUs of @p devices against other xpu-smi processes, and with
+ *        @p withAmc also their AMC cards
+ *
+ * Read-only commands take SHARED locks, commands that change a device EXCLUSIVE ones.
+ * When a device stays busy past the timeout of the mode, the error names it and the
+ * processes holding it, and the returned locks are not locked().
+ */
+DeviceLocks lockDevices(const std::vector<devInfo> &devices, DeviceLockMode mode, bool withAmc = false);
+
 typedef void (cmds::*helpFunc)(HELP helpType);
 typedef int (cmds::*runFunc)();
 
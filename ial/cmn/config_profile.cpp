@@ -0,0 +1,498 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "config_profile.h"
+#include "debug.h"
+#include "task_executor.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <format>
+#include <utility>
+
+namespace config_profile {
+
+namespace {
+
+// Scheduler time limits in microseconds (same bounds as the --scheduler option)
+constexpr uint64_t SCHEDULER_TIME_MIN = 5000;
+constexpr uint64_t SCHEDULER_TIME_MAX = 100000000;
+
+// Read-back tolerances: limits are reported in whole watts, frequencies snap to the
+// nearest supported clock
+constexpr double POWER_TOLERANCE_W = 1.0;
+constexpr double FREQUENCY_TOLERANCE_MHZ = 50.0;
+
+constexpr std::string_view ABORTED = "aborted";
+
+constexpr std::string_view POWER_PREFIX = "power_limit.";
+constexpr std::array<std::string_view, 3> POWER_LEVELS = {"sustain", "burst", "peak"};
+
+std::string tileKey(size_t tile, std::string_view setting) { return std::format("tile.{}.{}", tile, setting); }
+
+bool isNonNegativeNumber(const nlohmann::json &v) { return v.is_number() && v.get<double>() >= 0.0; }
+
+bool isSchedulerTime(const nlohmann::json &v)
+{
+	if (!v.is_number_unsigned()) {
+		return false;
+	}
+	const auto t = v.get<uint64_t>();
+	return t >= SCHEDULER_TIME_MIN && t <= SCHEDULER_TIME_MAX;
+}
+
+/**
+ * @brief Validate a "frequency_range" value: [min, max] MHz with 0 <= min < max.
+ */
+bool validateFrequencyRange(const nlohmann::json &v, std::string &error)
+{
+	if (!v.is_array() || v.size() != 2 || !isNonNegativeNumber(v[0]) || !isNonNegativeNumber(v[1]) ||
+		v[0].get<double>() >= v[1].get<double>()) {
+		error = "frequency_range must be [min, max] in MHz with 0 <= min < max";
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Validate a "scheduler" value and normalize it to the fields its mode uses.
+ */
+bool validateScheduler(const nlohmann::json &v, nlohmann::json &normalized, std::string &error)
+{
+	if (!v.is_object() || !v.contains("mode") || !v["mode"].is_string()) {
+		error = "scheduler must be an object with a \"mode\"";
+		return false;
+	}
+	const auto mode = v["mode"].get<std::string>();
+	normalized = nlohmann::json{{"mode", mode}};
+	if (mode == "timeout") {
+		if (!v.contains("timeout") || !isSchedulerTime(v["timeout"])) {
+			error = std::format("scheduler timeout must be between {} and {} us", SCHEDULER_TIME_MIN,
+								SCHEDULER_TIME_MAX);
+			return false;
+		}
+		normalized["timeout"] = v["timeout"];
+	} else if (mode == "timeslice") {
+		if (!v.contains("interval") || !v.contains("yield_timeout") || !isSchedulerTime(v["interval"]) ||
+			!isSchedulerTime(v["yield_timeout"])) {
+			error = std::format("scheduler interval and yield_timeout must be between {} and {} us",
+								SCHEDULER_TIME_MIN, SCHEDULER_TIME_MAX);
+			return false;
+		}
+		normalized["interval"] = v["interval"];
+		normalized["yield_timeout"] = v["yield_timeout"];
+	} else if (mode != "exclusive") {
+		error = "scheduler mode must be one of timeout, timeslice, exclusive";
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Validate the settings of one profile entry (device or tile level).
+ */
+bool validateSettings(const nlohmann::json &in, nlohmann::json &out, bool tileLevel, std::string &error)
+{
+	out = nlohmann::json::object();
+	for (const auto &[key, value] : in.items()) {
+		if (key == "device" || (tileLevel && key == "tile_id")) {
+			continue;
+		}
+		if (key == "frequency_range") {
+			if (!validateFrequencyRange(value, error)) {
+				return false;
+			}
+			out[key] = value;
+		} else if (key == "scheduler") {
+			nlohmann::json normalized;
+			if (!validateScheduler(value, normalized, error)) {
+				return false;
+			}
+			out[key] = normalized;
+		} else if (tileLevel) {
+			error = std::format("unsupported tile setting \"{}\"", key);
+			return false;
+		} else if (key == "power_limit") {
+			if (!value.is_object() || value.empty()) {
+				error = "power_limit must be an object with sustain, burst and/or peak (W)";
+				return false;
+			}
+			for (const auto &[level, watts] : value.items()) {
+				if (std::find(POWER_LEVELS.begin(), POWER_LEVELS.end(), level) == POWER_LEVELS.end() ||
+					!isNonNegativeNumber(watts)) {
+					error = std::format("invalid power_limit entry \"{}\"", level);
+					return false;
+				}
+			}
+			out[key] = value;
+		} else if (key == "memory_ecc") {
+			if (value != "enabled" && value != "disabled") {
+				error = "memory_ecc must be \"enabled\" or \"disabled\"";
+				return false;
+			}
+			out[key] = value;
+		} else if (key == "standby_mode") {
+			if (value != "default" && value != "never") {
+				error = "standby_mode must be \"default\" or \"never\"";
+				return false;
+			}
+			out[key] = value;
+		} else if (key == "tiles") {
+			if (!value.is_array()) {
+				error = "tiles must be an array";
+				return false;
+			}
+			nlohmann::json tiles = nlohmann::json::object();
+			for (const auto &tile : value) {
+				if (!tile.is_object() || !tile.contains("tile_id") || !tile["tile_id"].is_number_unsigned()) {
+					error = "each tiles entry needs a numeric tile_id";
+					return false;
+				}
+				nlohmann::json tileSettings;
+				if (!validateSettings(tile, tileSettings, true, error)) {
+					return false;
+				}
+				tiles[std::to_string(tile["tile_id"].get<uint32_t>())].update(tileSettings);
+			}
+			out[key] = tiles;
+		} else {
+			error = std::format("unsupported setting \"{}\"", key);
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Run @p fn for every job concurrently, placed by the job's placeWorker, and wait for all of them.
+ */
+template <typename Fn> void forEachDevice(std::span<DeviceJob> jobs, Fn fn)
+{
+	// Outcomes are recorded in the jobs themselves
+	static_cast<void>(parallelForEach(jobs, [&fn](DeviceJob &job) {
+		if (job.placeWorker) {
+			job.placeWorker();
+		}
+		fn(job);
+		return ZE_RESULT_SUCCESS;
+	}));
+}
+
+void fail(DeviceJob &job, ze_result_t result, std::string key, std::string reason)
+{
+	job.result = result;
+	job.failedKey = std::move(key);
+	job.failure = std::move(reason);
+}
+
+/**
+ * @brief Restore the previous values of the changes a device applied, newest first.
+ */
+void rollBack(DeviceJob &job)
+{
+	for (size_t i = job.applied; i-- > 0;) {
+		const auto &change = job.plan[i];
+		ze_result_t res = job.device->applySetting(change.key, change.from);
+		if (res != ZE_RESULT_SUCCESS) {
+			ERR("Failed to restore {} on GPU {}: 0x{:X}\n", change.key, job.index, res);
+			if (job.rollbackResult == ZE_RESULT_SUCCESS) {
+				job.rollbackResult = res;
+			}
+		}
+	}
+
+	DeviceState restored;
+	ze_result_t res = job.device->readState(restored);
+	if (res == ZE_RESULT_SUCCESS) {
+		for (size_t i = 0; i < job.applied; ++i) {
+			const auto &change = job.plan[i];
+			auto it = restored.find(change.key);
+			if (it == restored.end() || !valuesMatch(change.key, change.from, it->second)) {
+				ERR("GPU {}: {} did not return to its previous value\n", job.index, change.key);
+				res = ZE_RESULT_ERROR_UNKNOWN;
+			}
+		}
+	}
+	if (job.rollbackResult == ZE_RESULT_SUCCESS) {
+		job.rollbackResult = res;
+	}
+	job.rolledBack = true;
+}
+
+} // namespace
+
+bool parseProfile(const nlohmann::json &doc, std::vector<ProfileEntry> &out, std::string &error)
+{
+	out.clear();
+	if (!doc.is_object() || !doc.contains("devices") || !doc["devices"].is_array() || doc["devices"].empty()) {
+		error = "profile must be an object with a non-empty \"devices\" array";
+		return false;
+	}
+	for (size_t i = 0; i < doc["devices"].size(); ++i) {
+		const auto &entry = doc["devices"][i];
+		if (!entry.is_object() || !entry.contains("device")) {
+			error = std::format("devices[{}]: missing \"device\"", i);
+			return false;
+		}
+		ProfileEntry parsed;
+		const auto &device = entry["device"];
+		if (device.is_number_unsigned()) {
+			parsed.device = std::to_string(device.get<uint32_t>());
+		} else if (device.is_string() && !device.get<std::string>().empty()) {
+			parsed.device = device.get<std::string>();
+		} else {
+			error = std::format("devices[{}]: \"device\" must be \"all\", an index or a PCI BDF", i);
+			return false;
+		}
+		std::string reason;
+		if (!validateSettings(entry, parsed.settings, false, reason)) {
+			error = std::format("devices[{}]: {}", i, reason);
+			return false;
+		}
+		out.push_back(std::move(parsed));
+	}
+	return true;
+}
+
+void mergeSettings(nlohmann::json &into, const nlohmann::json &settings)
+{
+	if (!into.is_object()) {
+		into = nlohmann::json::object();
+	}
+	for (const auto &[key, value] : settings.items()) {
+		if (key == "power_limit" || key == "tiles") {
+			// Merge per level / per tile so entries can refine each other
+			auto &target = into[key];
+			for (const auto &[sub, subValue] : value.items()) {
+				if (key == "tiles") {
+					target[sub].update(subValue);
+				} else {
+					target[sub] = subValue;
+				}
+			}
+		} else {
+			into[key] = value;
+		}
+	}
+}
+
+DeviceState stateFromConfig(const nlohmann::json &config)
+{
+	DeviceState state;
+
+	for (auto level : POWER_LEVELS) {
+		// Device-level limits are reported per domain; prefer package, fall back to card
+		const int package = config.value(std::format("pl_package_{}", level), 0);
+		const int card = config.value(std::format("pl_card_{}", level), 0);
+		const int watts = package > 0 ? package : card;
+		if (watts > 0) {
+			state[std::string{POWER_PREFIX} + std::string{level}] = watts;
+		}
+	}
+
+	const auto ecc = config.value("memory_ecc_pending_state", std::string{});
+	if (ecc == "enabled" || ecc == "disabled") {
+		state["memory_ecc"] = ecc;
+	}
+
+	if (!config.contains("tile_config_data") || !config["tile_config_data"].is_array()) {
+		return state;
+	}
+	const auto &tiles = config["tile_config_data"];
+	for (size_t tile = 0; tile < tiles.size(); ++tile) {
+		const auto &t = tiles[tile];
+		if (tile == 0) {
+			const auto standby = t.value("standby_mode", std::string{});
+			if (!standby.empty()) {
+				state["standby_mode"] = standby;
+			}
+		}
+
+		const auto maxFreq = t.value("max_frequency", 0U);
+		if (maxFreq > 0) {
+			state[tileKey(tile, "frequency_range")] = nlohmann::json::array({t.value("min_frequency", 0U), maxFreq});
+		}
+
+		const auto mode = t.value("scheduler_mode", std::string{});
+		if (mode == "timeslice") {
+			state[tileKey(tile, "scheduler")] = {{"mode", mode},
+												 {"interval", t.value("scheduler_timeslice_interval", uint64_t{0})},
+												 {"yield_timeout",
+												  t.value("scheduler_timeslice_yield_timeout", uint64_t{0})}};
+		} else if (mode == "timeout") {
+			state[tileKey(tile, "scheduler")] = {{"mode", mode},
+												 {"timeout", t.value("scheduler_timeout", uint64_t{0})}};
+		} else if (mode == "exclusive") {
+			state[tileKey(tile, "scheduler")] = {{"mode", mode}};
+		}
+	}
+	return state;
+}
+
+DeviceState desiredState(const nlohmann::json &settings, const DeviceState &current)
+{
+	DeviceState desired;
+
+	// Tiles present on this device, from the frequency/scheduler keys in its state
+	std::vector<size_t> tiles;
+	for (const auto &[key, value] : current) {
+		size_t tile = 0;
+		if (std::sscanf(key.c_str(), "tile.%zu.", &tile) == 1 &&
+			std::find(tiles.begin(), tiles.end(), tile) == tiles.end()) {
+			tiles.push_back(tile);
+		}
+	}
+
+	for (const auto &[key, value] : settings.items()) {
+		if (key == "power_limit") {
+			for (const auto &[level, watts] : value.items()) {
+				desired[std::string{POWER_PREFIX} + level] = watts;
+			}
+		} else if (key == "frequency_range" || key == "scheduler") {
+			for (size_t tile : tiles) {
+				desired[tileKey(tile, key)] = value;
+			}
+		} else if (key != "tiles") {
+			desired[key] = value;
+		}
+	}
+
+	// Tile entries override device-level settings
+	if (settings.contains("tiles")) {
+		for (const auto &[tile, tileSettings] : settings["tiles"].items()) {
+			for (const auto &[key, value] : tileSettings.items()) {
+				desired[std::format("tile.{}.{}", tile, key)] = value;
+			}
+		}
+	}
+	return desired;
+}
+
+bool valuesMatch(std::string_view key, const nlohmann::json &expected, const nlohmann::json &actual)
+{
+	if (key.starts_with(POWER_PREFIX)) {
+		return expected.is_number() && actual.is_number() &&
+			   std::abs(expected.get<double>() - actual.get<double>()) <= POWER_TOLERANCE_W;
+	}
+	if (key.ends_with(".frequency_range")) {
+		if (!expected.is_array() || !actual.is_array() || expected.size() != 2 || actual.size() != 2) {
+			return false;
+		}
+		for (size_t i = 0; i < 2; ++i) {
+			if (std::abs(expected[i].get<double>() - actual[i].get<double>()) > FREQUENCY_TOLERANCE_MHZ) {
+				return false;
+			}
+		}
+		return true;
+	}
+	return expected == actual;
+}
+
+std::vector<Change> computeDiff(const DeviceState &current, const DeviceState &desired, std::string &error)
+{
+	std::vector<Change> changes;
+	for (const auto &[key, value] : desired) {
+		auto it = current.find(key);
+		if (it == current.end()) {
+			error = std::format("{} is not available on this device", key);
+			return {};
+		}
+		if (!valuesMatch(key, value, it->second)) {
+			changes.push_back(Change{.key = key, .from = it->second, .to = value});
+		}
+	}
+	return changes;
+}
+
+ze_result_t planProfile(std::span<DeviceJob> jobs)
+{
+	forEachDevice(jobs, [](DeviceJob &job) {
+		DeviceState current;
+		ze_result_t res = job.device->readState(current);
+		if (res != ZE_RESULT_SUCCESS) {
+			fail(job, res, {}, "failed to read current configuration");
+			return;
+		}
+		std::string error;
+		job.plan = computeDiff(current, desiredState(job.settings, current), error);
+		if (!error.empty()) {
+			fail(job, ZE_RESULT_ERROR_UNSUPPORTED_FEATURE, {}, error);
+		}
+	});
+
+	for (const auto &job : jobs) {
+		if (job.result != ZE_RESULT_SUCCESS) {
+			return job.result;
+		}
+	}
+	return ZE_RESULT_SUCCESS;
+}
+
+ze_result_t applyProfile(std::span<DeviceJob> jobs, const std::atomic<bool> &abortRequested)
+{
+	std::atomic<bool> anyFailed{false};
+
+	forEachDevice(jobs, [&](DeviceJob &job) {
+		for (const auto &change : job.plan) {
+			// Stop early once another device failed or the user aborted; everything is rolled back
+			if (abortRequested.load() || anyFailed.load()) {
+				fail(job, ZE_RESULT_ERROR_NOT_AVAILABLE, change.key, std::string{ABORTED});
+				anyFailed = true;
+				return;
+			}
+			ze_result_t res = job.device->applySetting(change.key, change.to);
+			if (res != ZE_RESULT_SUCCESS) {
+				fail(job, res, change.key, "failed to apply");
+				anyFailed = true;
+				return;
+			}
+			++job.applied;
+		}
+		if (job.plan.empty()) {
+			return;
+		}
+
+		// Read everything back once and verify each applied value
+		DeviceState actual;
+		ze_result_t res = job.device->readState(actual);
+		if (res != ZE_RESULT_SUCCESS) {
+			fail(job, res, {}, "failed to read back configuration");
+			anyFailed = true;
+			return;
+		}
+		for (const auto &change : job.plan) {
+			auto it = actual.find(change.key);
+			if (it == actual.end() || !valuesMatch(change.key, change.to, it->second)) {
+				fail(job, ZE_RESULT_ERROR_UNKNOWN, change.key,
+					 std::format("read back {}", it == actual.end() ? "nothing" : it->second.dump()));
+				anyFailed = true;
+				return;
+			}
+		}
+	});
+
+	if (!anyFailed && !abortRequested) {
+		return ZE_RESULT_SUCCESS;
+	}
+
+	// Transaction failed: restore every device that was modified, concurrently
+	forEachDevice(jobs, [](DeviceJob &job) {
+		if (job.applied > 0) {
+			rollBack(job);
+		}
+	});
+
+	// Report the device that actually failed rather than one that merely stopped early
+	for (const auto &job : jobs) {
+		if (job.result != ZE_RESULT_SUCCESS && job.failure != ABORTED) {
+			return job.result;
+		}
+	}
+	return ZE_RESULT_ERROR_NOT_AVAILABLE; // Aborted by the user
+}
+
+} // namespace config_profile
@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef CONFIG_PROFILE_H
+#define CONFIG_PROFILE_H
+
+#include "ze_api.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <nlohmann/json.hpp>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Declarative configuration profiles applied transactionally across devices.
+ *
+ * A profile is a JSON document listing the desired settings per device (and optionally
+ * per tile). For every targeted device the engine reads the current state, computes the
+ * difference, applies only the settings that change, reads everything back to verify it
+ * and, if any device fails or the run is aborted, restores the previous values on every
+ * device that was already modified. All devices are processed concurrently, so rolling a
+ * profile out to a node takes roughly the time of the slowest device, not the sum.
+ *
+ * Profile format:
+ * @code
+ * {
+ *   "devices": [
+ *     { "device": "all", "power_limit": { "sustain": 300 }, "standby_mode": "never" },
+ *     { "device": 0, "frequency_range": [300, 1550],
+ *       "tiles": [ { "tile_id": 1, "scheduler": { "mode": "timeslice", "interval": 5000,
+ *                                                 "yield_timeout": 640000 } } ] },
+ *     { "device": "0000:4d:00.0", "memory_ecc": "enabled" }
+ *   ]
+ * }
+ * @endcode
+ *
+ * Device-level @c frequency_range and @c scheduler apply to every tile; entries in
+ * @c tiles override them for one tile. Later entries override earlier ones for the same
+ * device.
+ */
+namespace config_profile {
+
+/**
+ * @brief Flat view of the settable configuration of one device.
+ *
+ * Keys are @c power_limit.sustain / @c .burst / @c .peak (W), @c memory_ecc,
+ * @c standby_mode, @c tile.<n>.frequency_range ([min, max] MHz) and
+ * @c tile.<n>.scheduler (object with @c mode and its parameters). A key is absent when
+ * the device does not report that setting.
+ */
+using DeviceState = std::map<std::string, nlohmann::json, std::less<>>;
+
+/**
+ * @brief One setting that differs between the current and the desired state.
+ */
+struct Change
+{
+	std::string key;
+	nlohmann::json from; ///< Value before the profile was applied (used for rollback)
+	nlohmann::json to;	 ///< Value requested by the profile
+};
+
+/**
+ * @brief Settings requested for the devices matched by one profile entry.
+ */
+struct ProfileEntry
+{
+	std::string device;		 ///< "all", a device index, or a PCI BDF address
+	nlohmann::json settings; ///< Validated settings object
+};
+
+/**
+ * @brief Per-device operations used by the engine.
+ *
+ * Implemented on top of the HAL by the config command; tests provide fakes.
+ * Implementations are called concurrently for different devices, from pooled worker threads.
+ */
+class DeviceConfigurator
+{
+public:
+	virtual ~DeviceConfigurator() = default;
+
+	/** @brief Read the current settable state of the device. */
+	virtual ze_result_t readState(DeviceState &state) = 0;
+
+	/** @brief Apply one setting (a DeviceState key and value) to the device. */
+	virtual ze_result_t applySetting(std::string_view key, const nlohmann::json &value) = 0;
+};
+
+/**
+ * @brief Work item and outcome for one device.
+ */
+struct DeviceJob
+{
+	uint32_t index{0};					   ///< Device index, for reporting
+	DeviceConfigurator *device{nullptr};   ///< Device operations (not owned)
+	nlohmann::json settings{};			   ///< Merged profile settings for this device
+	std::vector<Change> plan{};			   ///< Filled by planProfile()
+	size_t applied{0};					   ///< Number of plan entries written to the device
+	ze_result_t result{ZE_RESULT_SUCCESS}; ///< First failure for this device
+	std::string failedKey{};			   ///< Setting that failed, if any
+	std::string failure{};				   ///< Human readable failure reason
+	bool rolledBack{false};				   ///< Previous values were restored
+	ze_result_t rollbackResult{ZE_RESULT_SUCCESS};
+	std::function<void()> placeWorker{};   ///< Optional; run first in every task of this job, on its thread
+};
+
+/**
+ * @brief Parse and validate a profile document.
+ *
+ * @param[in]  doc    Parsed profile JSON.
+ * @param[out] out    Validated profile entries, in document order.
+ * @param[out] error  Description of the first problem found.
+ * @return true when the profile is valid.
+ */
+bool parseProfile(const nlohmann::json &doc, std::vector<ProfileEntry> &out, std::string &error);
+
+/**
+ * @brief Merge the settings of a later profile entry over an earlier one.
+ */
+void mergeSettings(nlohmann::json &into, const nlohmann::json &settings);
+
+/**
+ * @brief Extract the settable state from a device configuration object as produced by
+ *        the @c config command in JSON mode.
+ */
+DeviceState stateFromConfig(const nlohmann::json &config);
+
+/**
+ * @brief Expand profile settings into DeviceState keys for a device with the given state.
+ *
+ * Device-level frequency and scheduler settings are expanded to every tile present in
+ * @p current.
+ */
+DeviceState desiredState(const nlohmann::json &settings, const DeviceState &current);
+
+/**
+ * @brief Whether a read-back value satisfies the requested value.
+ *
+ * Power limits are compared within 1 W and frequencies within 50 MHz, since the hardware
+ * rounds to its own granularity; everything else must match exactly.
+ */
+bool valuesMatch(std::string_view key, const nlohmann::json &expected, const nlohmann::json &actual);
+
+/**
+ * @brief Settings in @p desired that differ from @p current, in apply order.
+ *
+ * @param[out] error  Set when @p desired contains a setting the device does not report.
+ * @return The changes, or an empty vector with @p error set.
+ */
+std::vector<Change> computeDiff(const DeviceState &current, const DeviceState &desired, std::string &error);
+
+/**
+ * @brief Read every device's state and compute its plan, concurrently.
+ *
+ * @return ZE_RESULT_SUCCESS when every job has a valid plan; otherwise the first failure
+ *         (details in the failing job).
+ */
+ze_result_t planProfile(std::span<DeviceJob> jobs);
+
+/**
+ * @brief Apply the plans computed by planProfile() to all devices concurrently.
+ *
+ * Each device applies its changes and then reads its state back to verify them. If any
+ * device fails, or @p abortRequested becomes true, every device that was modified is
+ * restored to its previous values.
+ *
+ * @return ZE_RESULT_SUCCESS when all devices applied and verified their plans; otherwise
+ *         the first failure.
+ */
+ze_result_t applyProfile(std::span<DeviceJob> jobs, const std::atomic<bool> &abortRequested);
+
+} // namespace config_profile
+
+#endif // CONFIG_PROFILE_H
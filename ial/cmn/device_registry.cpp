@@ -0,0 +1,282 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "device_registry.h"
+#include "debug.h"
+#include "driver.h"
+#include <os.h>
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+// How long the listener blocks in the event source before re-checking for shutdown
+constexpr std::chrono::milliseconds LISTEN_SLICE{200};
+
+// Upper bound of one worker wait when nothing is scheduled
+constexpr std::chrono::minutes MAX_IDLE{1};
+
+bool isGpuDriver(std::string_view drv) { return drv == "xe" || drv == "i915"; }
+
+} // namespace
+
+std::vector<devInfo> DeviceSet::infos() const
+{
+	std::vector<devInfo> result;
+	result.reserve(devices.size());
+	for (const auto &d : devices) {
+		result.push_back(d.info);
+	}
+	return result;
+}
+
+const RegisteredDevice *DeviceSet::find(std::string_view bdf) const
+{
+	const auto it = std::ranges::find(devices, bdf, &RegisteredDevice::bdf);
+	return it == devices.end() ? nullptr : &*it;
+}
+
+DeviceRegistry::DeviceRegistry(std::vector<RegisteredDevice> initial, Backend backendIn, Options optionsIn)
+	: backend(std::move(backendIn)), options(optionsIn)
+{
+	for (const auto &d : initial) {
+		indices.emplace(d.bdf, d.info.index);
+		nextIndex = std::max(nextIndex, d.info.index + 1);
+	}
+	std::ranges::sort(initial, {}, [](const RegisteredDevice &d) { return d.info.index; });
+	set = std::make_shared<const DeviceSet>(DeviceSet{0, std::move(initial)});
+	nextRescan = std::chrono::steady_clock::now() + options.rescanInterval;
+
+	if (options.listenForEvents) {
+		events = std::make_unique<DeviceEventSource>();
+		if (events->isOpen()) {
+			listener = std::jthread([this](const std::stop_token &stop) { listen(stop); });
+		} else {
+			DBG("Hotplug events unavailable; relying on rescans every {} ms\n", options.rescanInterval.count());
+		}
+	}
+	worker = std::jthread([this](const std::stop_token &stop) { run(stop); });
+}
+
+DeviceRegistry::~DeviceRegistry()
+{
+	worker.request_stop();
+	listener.request_stop();
+}
+
+std::shared_ptr<const DeviceSet> DeviceRegistry::current() const
+{
+	const std::lock_guard lock(setMutex);
+	return set;
+}
+
+void DeviceRegistry::post(DeviceEvent event)
+{
+	{
+		const std::lock_guard lock(queueMutex);
+		queue.push_back(std::move(event));
+	}
+	queueReady.notify_one();
+}
+
+void DeviceRegistry::listen(const std::stop_token &stop)
+{
+	while (!stop.stop_requested()) {
+		if (auto event = events->next(LISTEN_SLICE)) {
+			post(std::move(*event));
+		}
+	}
+}
+
+void DeviceRegistry::run(const std::stop_token &stop)
+{
+	while (!stop.stop_requested()) {
+		std::deque<DeviceEvent> pending;
+		{
+			std::unique_lock lock(queueMutex);
+			queueReady.wait_until(lock, stop, std::min(nextWake(), std::chrono::steady_clock::now() + MAX_IDLE),
+								  [this] { return !queue.empty(); });
+			pending.swap(queue);
+		}
+		if (stop.stop_requested()) {
+			return;
+		}
+		for (const auto &event : pending) {
+			handle(event);
+		}
+
+		const auto now = std::chrono::steady_clock::now();
+		std::vector<std::string> due;
+		for (const auto &[bdf, retry] : retries) {
+			if (retry.next <= now) {
+				due.push_back(bdf);
+			}
+		}
+		for (const auto &bdf : due) {
+			probe(bdf, false);
+		}
+		if (backend.list && now >= nextRescan) {
+			rescan();
+			nextRescan = std::chrono::steady_clock::now() + options.rescanInterval;
+		}
+	}
+}
+
+std::chrono::steady_clock::time_point DeviceRegistry::nextWake() const
+{
+	auto wake = backend.list ? nextRescan : std::chrono::steady_clock::time_point::max();
+	for (const auto &[bdf, retry] : retries) {
+		wake = std::min(wake, retry.next);
+	}
+	return wake;
+}
+
+void DeviceRegistry::handle(const DeviceEvent &event)
+{
+	const bool known = indices.contains(event.bdf);
+	switch (event.kind) {
+	case DeviceEvent::Kind::REMOVED:
+		if (known) {
+			// Drivers may keep reporting a removed device; only a later event brings it back
+			vanished.insert(event.bdf);
+		}
+		// Cached topology still routes through the removed function's switch
+		if (backend.invalidate) {
+			backend.invalidate(event.bdf);
+		}
+		drop(event.bdf);
+		break;
+	case DeviceEvent::Kind::ADDED:
+		// Other PCI functions bind drivers too; only probe GPUs and devices tracked before
+		if (known || (options.acceptNew && (event.driver.empty() || isGpuDriver(event.driver)))) {
+			vanished.erase(event.bdf);
+			probe(event.bdf, true);
+		}
+		break;
+	case DeviceEvent::Kind::CHANGED:
+		if (known) {
+			vanished.erase(event.bdf);
+			probe(event.bdf, true);
+		}
+		break;
+	}
+}
+
+void DeviceRegistry::drop(const std::string &bdf)
+{
+	retries.erase(bdf);
+	const auto current = this->current();
+	if (current->find(bdf) != nullptr) {
+		INFO("Device {} was removed\n", bdf);
+		auto devices = current->devices;
+		std::erase_if(devices, [&](const RegisteredDevice &d) { return d.bdf == bdf; });
+		publish(std::move(devices));
+	}
+}
+
+void DeviceRegistry::probe(const std::string &bdf, bool removeIfStale)
+{
+	// A reset or rebind may have moved the device to other DRM nodes or sysfs paths
+	if (backend.invalidate) {
+		backend.invalidate(bdf);
+	}
+	auto probed = backend.probe(bdf);
+	const auto now = std::chrono::steady_clock::now();
+	auto devices = current()->devices;
+	const auto existing = std::ranges::find(devices, bdf, &RegisteredDevice::bdf);
+
+	if (!probed) {
+		auto [retry, inserted] = retries.try_emplace(bdf, Retry{now, now + options.retryFor});
+		if (!inserted && now >= retry->second.giveUp) {
+			INFO("Device {} did not come back within {} ms\n", bdf, options.retryFor.count());
+			retries.erase(retry);
+		} else {
+			retry->second.next = now + options.retryInterval;
+		}
+		if (removeIfStale && existing != devices.end()) {
+			// Its handles are stale; stop sampling it until it can be re-enumerated
+			devices.erase(existing);
+			publish(std::move(devices));
+		}
+		return;
+	}
+
+	retries.erase(bdf);
+	auto [index, inserted] = indices.try_emplace(bdf, nextIndex);
+	if (inserted) {
+		++nextIndex;
+	}
+	probed->bdf = bdf;
+	probed->info.index = index->second;
+	INFO("Device {} (index {}) was re-enumerated\n", bdf, index->second);
+	if (existing != devices.end()) {
+		*existing = std::move(*probed);
+	} else {
+		devices.push_back(std::move(*probed));
+		std::ranges::sort(devices, {}, [](const RegisteredDevice &d) { return d.info.index; });
+	}
+	publish(std::move(devices));
+}
+
+void DeviceRegistry::rescan()
+{
+	const auto reported = backend.list();
+	if (!reported) {
+		return;
+	}
+	const std::set<std::string, std::less<>> present(reported->begin(), reported->end());
+	const auto current = this->current();
+	for (const auto &d : current->devices) {
+		if (!present.contains(d.bdf)) {
+			drop(d.bdf);
+		}
+	}
+	for (const auto &bdf : present) {
+		const bool adoptable = options.acceptNew || indices.contains(bdf);
+		if (adoptable && current->find(bdf) == nullptr && !retries.contains(bdf) && !vanished.contains(bdf)) {
+			probe(bdf, false);
+		}
+	}
+}
+
+void DeviceRegistry::publish(std::vector<RegisteredDevice> devices)
+{
+	const std::lock_guard lock(setMutex);
+	set = std::make_shared<const DeviceSet>(DeviceSet{set->generation + 1, std::move(devices)});
+}
+
+std::vector<RegisteredDevice> registeredDevices(const std::vector<devInfo> &devices)
+{
+	std::vector<RegisteredDevice> result;
+	result.reserve(devices.size());
+	for (const auto &info : devices) {
+		result.push_back(RegisteredDevice{info.dev->getBDFStr(), info, nullptr});
+	}
+	return result;
+}
+
+DeviceRegistry::Backend driverBackend(driver &drv)
+{
+	DeviceRegistry::Backend backend;
+	backend.probe = [&drv](const std::string &bdf) -> std::optional<RegisteredDevice> {
+		std::unique_ptr<device> dev;
+		if (drv.probeDevice(bdf.c_str(), &dev) != ZE_RESULT_SUCCESS) {
+			return std::nullopt;
+		}
+		std::vector<devInfo> info;
+		dev->addInfo(&info, 0);
+		return RegisteredDevice{bdf, info.front(), std::shared_ptr<device>(std::move(dev))};
+	};
+	backend.list = [&drv]() -> std::optional<std::vector<std::string>> {
+		std::vector<std::string> bdfs;
+		if (drv.listDeviceBdfs(&bdfs) != ZE_RESULT_SUCCESS) {
+			return std::nullopt;
+		}
+		return bdfs;
+	};
+	backend.invalidate = [](const std::string &bdf) { INVALIDATE_PCI_CACHES(bdf); };
+	return backend;
+}
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef DEVICE_REGISTRY_H
+#define DEVICE_REGISTRY_H
+
+#include "device.h"
+#include <device_events.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+class driver;
+
+/**
+ * @brief Device list of long-running sampling loops that survives resets and hotplug.
+ *
+ * driver::init() enumerates the devices once. When one of them is reset, rebound or
+ * surprise-removed, its handles go stale while the others stay valid. The registry
+ * keeps an immutable DeviceSet and, in the background, follows PCI/DRM hotplug events
+ * (and a periodic rescan of the driver, for platforms and test stubs without events):
+ *  - a removed device is dropped from the set,
+ *  - a re-bound, reset or newly plugged device is re-enumerated on its own, retrying
+ *    while its driver is still initializing, and swapped into the set.
+ * Every change publishes a new set with a higher generation. Loops fetch current()
+ * once per tick; devices untouched by the change keep the same devInfo, so their
+ * sampling carries on without a gap. Devices re-enumerated by the registry are owned by
+ * the set that holds them and stay alive while any loop still uses that set.
+ */
+
+/**
+ * @brief One usable device of a DeviceSet
+ */
+struct RegisteredDevice
+{
+	std::string bdf;			   ///< "dddd:bb:dd.f"
+	devInfo info{};				   ///< index keeps its value across re-enumeration
+	std::shared_ptr<device> owner; ///< Set for devices the registry re-enumerated; null for driver-owned ones
+};
+
+/**
+ * @brief Immutable snapshot of the usable devices, ordered by index
+ */
+struct DeviceSet
+{
+	uint64_t generation{0};
+	std::vector<RegisteredDevice> devices;
+
+	/** @brief The devInfo of every device, in index order */
+	[[nodiscard]] std::vector<devInfo> infos() const;
+
+	[[nodiscard]] const RegisteredDevice *find(std::string_view bdf) const;
+};
+
+class DeviceRegistry
+{
+public:
+	/**
+	 * @brief Access to the driver, separated for testability
+	 */
+	struct Backend
+	{
+		/** Re-enumerates one device; std::nullopt while it is not (yet) usable */
+		std::function<std::optional<RegisteredDevice>(const std::string &bdf)> probe;
+		/** BDFs the driver reports now; std::nullopt when it cannot tell. Optional */
+		std::function<std::optional<std::vector<std::string>>()> list;
+		/** Drops what is cached about a device's sysfs paths before it is probed again. Optional */
+		std::function<void(const std::string &bdf)> invalidate;
+	};
+
+	struct Options
+	{
+		bool acceptNew{true};		 ///< Adopt devices that were not in the initial set
+		bool listenForEvents{true};	 ///< Subscribe to OS hotplug events
+		std::chrono::milliseconds rescanInterval{2000};
+		std::chrono::milliseconds retryInterval{500}; ///< Between probes of a device that is not ready
+		std::chrono::milliseconds retryFor{10000};	  ///< Give up re-enumerating a device after this long
+	};
+
+	/**
+	 * @brief Starts tracking @p initial; the background threads run until destruction
+	 */
+	DeviceRegistry(std::vector<RegisteredDevice> initial, Backend backend, Options options);
+	~DeviceRegistry();
+
+	DeviceRegistry(const DeviceRegistry &) = delete;
+	DeviceRegistry &operator=(const DeviceRegistry &) = delete;
+
+	/** @brief The latest device set; never null */
+	[[nodiscard]] std::shared_ptr<const DeviceSet> current() const;
+
+	/** @brief Queues an event as if the OS had reported it */
+	void post(DeviceEvent event);
+
+private:
+	void run(const std::stop_token &stop);
+	void listen(const std::stop_token &stop);
+	void handle(const DeviceEvent &event);
+	void drop(const std::string &bdf);
+	void probe(const std::string &bdf, bool removeIfStale);
+	void rescan();
+	void publish(std::vector<RegisteredDevice> devices);
+	[[nodiscard]] std::chrono::steady_clock::time_point nextWake() const;
+
+	Backend backend;
+	Options options;
+
+	mutable std::mutex setMutex;
+	std::shared_ptr<const DeviceSet> set;
+
+	std::mutex queueMutex;
+	std::condition_variable_any queueReady;
+	std::deque<DeviceEvent> queue;
+
+	// Owned by the worker thread
+	std::map<std::string, uint32_t, std::less<>> indices; ///< Every BDF ever tracked and its index
+	uint32_t nextIndex{0};
+	struct Retry
+	{
+		std::chrono::steady_clock::time_point next;
+		std::chrono::steady_clock::time_point giveUp;
+	};
+	std::map<std::string, Retry, std::less<>> retries;
+	std::set<std::string, std::less<>> vanished; ///< Removed by an event; ignored by rescans until re-added
+	std::chrono::steady_clock::time_point nextRescan;
+
+	std::unique_ptr<DeviceEventSource> events;
+	std::jthread listener;
+	std::jthread worker;
+};
+
+/**
+ * @brief Wraps devInfos returned by driver::findDevice() for a DeviceRegistry
+ */
+std::vector<RegisteredDevice> registeredDevices(const std::vector<devInfo> &devices);
+
+/**
+ * @brief Backend that re-enumerates devices through @p drv, which must outlive the registry
+ */
+DeviceRegistry::Backend driverBackend(driver &drv);
+
+#endif // DEVICE_REGISTRY_H
@@ -0,0 +1,225 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "fabric_telemetry.h"
+#include "counter_delta.h"
+#include "fabric.h"
+#include <algorithm>
+#include <format>
+#include <limits>
+#include <map>
+#include <utility>
+
+namespace fabric_telemetry {
+
+namespace {
+
+// A port never moves more than its maximum speed; twice that absorbs timestamp jitter
+constexpr double CAPACITY_HEADROOM = 2.0;
+// Without a known speed, only a difference in the upper half of the counter range is a reset
+constexpr uint64_t UNKNOWN_CAPACITY_LIMIT = uint64_t{1} << 63;
+
+/** Bytes/s of a link speed; 0 when bit rate or width is unknown */
+uint64_t capacityOf(const zes_fabric_port_speed_t &speed)
+{
+	if (speed.bitRate <= 0 || speed.width <= 0) {
+		return 0;
+	}
+	return static_cast<uint64_t>(speed.bitRate) * static_cast<uint64_t>(speed.width) / 8;
+}
+
+bool samePort(const zes_fabric_port_id_t &a, const zes_fabric_port_id_t &b)
+{
+	return a.fabricId == b.fabricId && a.attachId == b.attachId && a.portNumber == b.portNumber;
+}
+
+/** Largest plausible counter difference for @p capacity bytes/s over @p windowUs */
+uint64_t plausibleBytes(uint64_t capacity, uint64_t windowUs)
+{
+	if (capacity == 0) {
+		return UNKNOWN_CAPACITY_LIMIT;
+	}
+	const double bytes = static_cast<double>(capacity) * static_cast<double>(windowUs) / 1e6 * CAPACITY_HEADROOM;
+	return bytes >= static_cast<double>(UNKNOWN_CAPACITY_LIMIT) ? UNKNOWN_CAPACITY_LIMIT : static_cast<uint64_t>(bytes);
+}
+
+std::optional<double> rate(uint64_t before, uint64_t after, uint64_t capacity, uint64_t windowUs)
+{
+	const auto delta = counterDelta(before, after, plausibleBytes(capacity, windowUs));
+	if (!delta) {
+		return std::nullopt;
+	}
+	return static_cast<double>(*delta) * 1e6 / static_cast<double>(windowUs);
+}
+
+std::optional<double> percentOf(const std::optional<double> &bytesPerSec, uint64_t capacity)
+{
+	if (!bytesPerSec || capacity == 0) {
+		return std::nullopt;
+	}
+	return *bytesPerSec * 100.0 / static_cast<double>(capacity);
+}
+
+} // namespace
+
+std::optional<double> PortRate::rxUtilization() const { return percentOf(rxBytesPerSec, rxCapacity); }
+
+std::optional<double> PortRate::txUtilization() const { return percentOf(txBytesPerSec, txCapacity); }
+
+std::string portLabel(const zes_fabric_port_id_t &id)
+{
+	return std::format("{}.{}.{}", id.fabricId, id.attachId, id.portNumber);
+}
+
+std::optional<uint64_t> counterDelta(uint64_t before, uint64_t after, uint64_t limit)
+{
+	return metrics::wrappingDelta(before, after, 64, limit);
+}
+
+ze_result_t sampleDevice(devInfo &dev, DeviceSample &sample, bool withPeers)
+{
+	sample = DeviceSample{};
+	fabric *f = dev.dev != nullptr ? dev.dev->getFabric() : nullptr;
+	if (f == nullptr || dev.zesDeviceHdl == nullptr) {
+		return ZE_RESULT_ERROR_UNSUPPORTED_FEATURE;
+	}
+
+	std::vector<zes_fabric_port_throughput_t> throughputs;
+	const ze_result_t res = f->getPortThroughputs(dev.zesDeviceHdl, throughputs);
+	if (res != ZE_RESULT_SUCCESS) {
+		return res;
+	}
+
+	sample.ports.reserve(throughputs.size());
+	for (uint32_t i = 0; i < throughputs.size(); i++) {
+		const auto &props = f->getPortProperties(i);
+		if (!props) {
+			continue;
+		}
+		PortSample port;
+		port.portId = props->portId;
+		port.subdeviceId = props->onSubdevice != 0 ? props->subdeviceId : 0;
+		port.rxCapacity = capacityOf(props->maxRxSpeed);
+		port.txCapacity = capacityOf(props->maxTxSpeed);
+		port.rxCounter = throughputs[i].rxCounter;
+		port.txCounter = throughputs[i].txCounter;
+		port.timestampUs = throughputs[i].timestamp;
+		if (withPeers) {
+			zes_fabric_port_state_t state = {};
+			state.stype = ZES_STRUCTURE_TYPE_FABRIC_PORT_STATE;
+			if (f->portGetState(f->getPortHandle(i), &state) == ZE_RESULT_SUCCESS &&
+				(state.status == ZES_FABRIC_PORT_STATUS_HEALTHY || state.status == ZES_FABRIC_PORT_STATUS_DEGRADED)) {
+				port.peer = state.remotePortId;
+			}
+		}
+		sample.ports.push_back(port);
+	}
+	sample.available = true;
+	return ZE_RESULT_SUCCESS;
+}
+
+std::vector<PortRate> computeRates(const DeviceSample &before, const DeviceSample &after)
+{
+	std::vector<PortRate> rates;
+	if (!before.available || !after.available) {
+		return rates;
+	}
+	rates.reserve(after.ports.size());
+	for (size_t i = 0; i < after.ports.size(); ++i) {
+		const auto &now = after.ports[i];
+		PortRate r;
+		r.portId = now.portId;
+		r.subdeviceId = now.subdeviceId;
+		r.rxCapacity = now.rxCapacity;
+		r.txCapacity = now.txCapacity;
+		r.peer = now.peer;
+
+		// Port order is stable between samples; search only when it was not
+		const PortSample *then = nullptr;
+		if (i < before.ports.size() && samePort(before.ports[i].portId, now.portId)) {
+			then = &before.ports[i];
+		} else {
+			const auto it = std::ranges::find_if(before.ports,
+												 [&](const PortSample &p) { return samePort(p.portId, now.portId); });
+			then = it != before.ports.end() ? &*it : nullptr;
+		}
+		if (then != nullptr) {
+			if (then->peer) {
+				r.peer = then->peer;
+			}
+			if (now.timestampUs > then->timestampUs) {
+				const uint64_t windowUs = now.timestampUs - then->timestampUs;
+				r.rxBytesPerSec = rate(then->rxCounter, now.rxCounter, now.rxCapacity, windowUs);
+				r.txBytesPerSec = rate(then->txCounter, now.txCounter, now.txCapacity, windowUs);
+			}
+		}
+		rates.push_back(std::move(r));
+	}
+	return rates;
+}
+
+LinkMatrix buildLinkMatrix(std::span<const DeviceRates> devices)
+{
+	LinkMatrix matrix;
+	const size_t count = devices.size();
+	matrix.devices.reserve(count);
+	matrix.cells.assign(count, std::vector<LinkMatrix::Cell>(count));
+
+	// A device owns the fabric IDs of its own ports, one per tile
+	std::map<uint32_t, size_t> deviceOfFabric;
+	for (size_t row = 0; row < count; ++row) {
+		matrix.devices.push_back(devices[row].deviceIndex);
+		for (const auto &port : devices[row].ports) {
+			deviceOfFabric.emplace(port.portId.fabricId, row);
+		}
+	}
+
+	struct Sum
+	{
+		double bytesPerSec = 0;
+		uint64_t capacity = 0;
+		bool rated = false;
+		bool capacityKnown = true;
+	};
+	std::vector<std::vector<Sum>> sums(count, std::vector<Sum>(count));
+	for (size_t row = 0; row < count; ++row) {
+		for (const auto &port : devices[row].ports) {
+			if (!port.peer) {
+				continue;
+			}
+			const auto it = deviceOfFabric.find(port.peer->fabricId);
+			if (it == deviceOfFabric.end()) {
+				continue;
+			}
+			auto &cell = matrix.cells[row][it->second];
+			auto &sum = sums[row][it->second];
+			cell.linked = true;
+			if (port.txBytesPerSec) {
+				sum.bytesPerSec += *port.txBytesPerSec;
+				sum.rated = true;
+			}
+			sum.capacity += port.txCapacity;
+			sum.capacityKnown = sum.capacityKnown && port.txCapacity != 0;
+		}
+	}
+
+	for (size_t row = 0; row < count; ++row) {
+		for (size_t col = 0; col < count; ++col) {
+			auto &cell = matrix.cells[row][col];
+			const auto &sum = sums[row][col];
+			if (!cell.linked || !sum.rated) {
+				continue;
+			}
+			cell.bytesPerSec = sum.bytesPerSec;
+			if (sum.capacityKnown && sum.capacity != 0) {
+				cell.utilization = sum.bytesPerSec * 100.0 / static_cast<double>(sum.capacity);
+			}
+		}
+	}
+	return matrix;
+}
+
+} // namespace fabric_telemetry
@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef FABRIC_TELEMETRY_H
+#define FABRIC_TELEMETRY_H
+
+#include "device.h"
+#include "ze_api.h"
+#include "zes_api.h"
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Fabric (Xe Link) port bandwidth from two throughput samples
+ *
+ * A sample holds the rx/tx byte counters of every fabric port of one device, read with
+ * one batched driver call, together with what turns two samples into rates: the port's
+ * identity, its maximum speed and, when asked for, the port at the other end of its link.
+ * Rates are computed per port over the window between two samples of the same device;
+ * buildLinkMatrix() sums them up per pair of devices.
+ */
+namespace fabric_telemetry {
+
+/**
+ * @brief One fabric port of a device at a single point in time
+ */
+struct PortSample
+{
+	zes_fabric_port_id_t portId{};			  ///< fabricId identifies the tile the port is on
+	uint32_t subdeviceId = 0;				  ///< Tile of the port; 0 when not on a subdevice
+	std::optional<zes_fabric_port_id_t> peer; ///< Remote port of a healthy or degraded link
+	uint64_t rxCapacity = 0;				  ///< Bytes/s at maximum receive speed; 0 when unknown
+	uint64_t txCapacity = 0;				  ///< Bytes/s at maximum transmit speed; 0 when unknown
+	uint64_t rxCounter = 0;					  ///< Bytes received, monotonic modulo 2^64
+	uint64_t txCounter = 0;					  ///< Bytes transmitted, monotonic modulo 2^64
+	uint64_t timestampUs = 0;				  ///< Time of the counter reading in microseconds
+};
+
+/**
+ * @brief All fabric ports of one device at a single point in time
+ */
+struct DeviceSample
+{
+	std::vector<PortSample> ports;
+	bool available = false; ///< Counters were read; false for devices without fabric ports
+};
+
+/**
+ * @brief Bandwidth of one port over the window between two samples
+ */
+struct PortRate
+{
+	zes_fabric_port_id_t portId{};
+	uint32_t subdeviceId = 0;
+	std::optional<zes_fabric_port_id_t> peer;
+	std::optional<double> rxBytesPerSec; ///< nullopt when the window carries no rate, e.g. across a counter reset
+	std::optional<double> txBytesPerSec;
+	uint64_t rxCapacity = 0;
+	uint64_t txCapacity = 0;
+
+	/** @brief Receive bandwidth in percent of the port's maximum speed */
+	[[nodiscard]] std::optional<double> rxUtilization() const;
+	/** @brief Transmit bandwidth in percent of the port's maximum speed */
+	[[nodiscard]] std::optional<double> txUtilization() const;
+};
+
+/**
+ * @brief Link utilization between every pair of devices
+ *
+ * Row r, column c describes the links from device r to device c: the bytes device r
+ * transmitted on them per second, and that as a percentage of their combined maximum
+ * transmit speed.
+ */
+struct LinkMatrix
+{
+	struct Cell
+	{
+		bool linked = false;				///< At least one port of the row device is connected to the column device
+		std::optional<double> bytesPerSec;	///< nullopt when no linked port had a rate for the window
+		std::optional<double> utilization;	///< Percent; nullopt when the rate or the link speed is unknown
+	};
+
+	std::vector<uint32_t> devices;		 ///< Device indices, in row and column order
+	std::vector<std::vector<Cell>> cells; ///< cells[row][col]
+};
+
+/**
+ * @brief Port rates of one device, as input to buildLinkMatrix()
+ */
+struct DeviceRates
+{
+	uint32_t deviceIndex = 0;
+	std::vector<PortRate> ports;
+};
+
+/**
+ * @brief Label of a port: "<fabricId>.<attachId>.<portNumber>", the form fabric port commands take
+ */
+[[nodiscard]] std::string portLabel(const zes_fabric_port_id_t &id);
+
+/**
+ * @brief Bytes counted between two readings of a counter that wraps at 2^64
+ *
+ * The difference is taken modulo 2^64, so a counter that wrapped between the readings
+ * yields the bytes actually counted. A difference above @p limit cannot come from
+ * traffic and means the counter was reset in between (device reset, driver reload).
+ *
+ * @param before Earlier reading
+ * @param after  Later reading
+ * @param limit  Largest plausible difference for the window
+ * @return Bytes counted, or nullopt across a reset
+ */
+[[nodiscard]] std::optional<uint64_t> counterDelta(uint64_t before, uint64_t after, uint64_t limit);
+
+/**
+ * @brief Reads the throughput counters of all fabric ports of a device
+ *
+ * The counters come from one batched call (fabric::getPortThroughputs()); port
+ * properties are cached by the fabric HAL and not read again.
+ *
+ * @param[in]  dev       Device to sample
+ * @param[out] sample    The ports of the device; @c available is false on failure
+ * @param[in]  withPeers Also read the state of every port to learn the remote end of its
+ *                       link. Costs one call per port; only the link matrix needs it.
+ * @retval ZE_RESULT_SUCCESS Counters read
+ * @retval ZE_RESULT_ERROR_UNSUPPORTED_FEATURE Device has no fabric ports
+ * @retval Other error codes from the fabric HAL
+ */
+ze_result_t sampleDevice(devInfo &dev, DeviceSample &sample, bool withPeers = false);
+
+/**
+ * @brief Per-port bandwidth over the window between two samples of the same device
+ *
+ * Ports are matched by port ID. The peer is taken from @p before, or from @p after when
+ * @p before has none. A port gets no rate for the window when its timestamp did not
+ * advance or a counter was reset; see counterDelta().
+ *
+ * @return One entry per port of @p after, in its order; empty when either sample is unavailable
+ */
+[[nodiscard]] std::vector<PortRate> computeRates(const DeviceSample &before, const DeviceSample &after);
+
+/**
+ * @brief Sums port rates up per pair of linked devices
+ *
+ * Remote ports are mapped to devices through the fabric IDs of the devices' own ports,
+ * so links to devices missing from @p devices are left out.
+ */
+[[nodiscard]] LinkMatrix buildLinkMatrix(std::span<const DeviceRates> devices);
+
+} // namespace fabric_telemetry
+
+#endif // FABRIC_TELEMETRY_H
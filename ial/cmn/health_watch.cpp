@@ -0,0 +1,503 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "health_watch.h"
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <limits>
+#include <utility>
+
+namespace health_watch {
+
+namespace {
+
+struct ComparisonKey
+{
+	std::string_view key;
+	Comparison comparison;
+	bool rate;
+};
+
+constexpr std::array<ComparisonKey, 8> COMPARISON_KEYS{{
+	{"above", Comparison::Above, false},
+	{"at_least", Comparison::AtLeast, false},
+	{"below", Comparison::Below, false},
+	{"at_most", Comparison::AtMost, false},
+	{"equal", Comparison::Equal, false},
+	{"not_equal", Comparison::NotEqual, false},
+	{"rate_above", Comparison::Above, true},
+	{"rate_below", Comparison::Below, true},
+}};
+
+/** Field index of a rule whose metric is not in the registry */
+constexpr std::size_t NO_FIELD = std::numeric_limits<std::size_t>::max();
+
+/** Decimals of the values reported in alerts */
+constexpr int ALERT_PRECISION = 2;
+
+[[nodiscard]] double toDouble(const metrics::MetricValue &value)
+{
+	switch (value.kind()) {
+	case metrics::MetricValue::Kind::Signed:
+		return static_cast<double>(value.asSigned());
+	case metrics::MetricValue::Kind::Unsigned:
+		return static_cast<double>(value.asUnsigned());
+	case metrics::MetricValue::Kind::Real:
+		return value.asReal();
+	default:
+		return std::numeric_limits<double>::quiet_NaN();
+	}
+}
+
+[[nodiscard]] bool compare(Comparison comparison, double value, double threshold)
+{
+	switch (comparison) {
+	case Comparison::Above:
+		return value > threshold;
+	case Comparison::AtLeast:
+		return value >= threshold;
+	case Comparison::Below:
+		return value < threshold;
+	case Comparison::AtMost:
+		return value <= threshold;
+	case Comparison::Equal:
+		return value == threshold;
+	case Comparison::NotEqual:
+		return value != threshold;
+	}
+	return false;
+}
+
+/** @brief Threshold past which an active alert clears: @p margin back towards the healthy side */
+[[nodiscard]] double clearThreshold(Comparison comparison, double threshold, double margin)
+{
+	switch (comparison) {
+	case Comparison::Above:
+	case Comparison::AtLeast:
+		return threshold - margin;
+	case Comparison::Below:
+	case Comparison::AtMost:
+		return threshold + margin;
+	default:
+		return threshold;
+	}
+}
+
+[[nodiscard]] std::string_view comparisonName(const Rule &rule)
+{
+	const auto it = std::ranges::find_if(COMPARISON_KEYS, [&](const ComparisonKey &k) {
+		return k.comparison == rule.comparison && k.rate == rule.rate;
+	});
+	return it != COMPARISON_KEYS.end() ? it->key : std::string_view{};
+}
+
+[[nodiscard]] nlohmann::ordered_json toJsonValue(const metrics::MetricValue &value)
+{
+	switch (value.kind()) {
+	case metrics::MetricValue::Kind::Signed:
+		return value.asSigned();
+	case metrics::MetricValue::Kind::Unsigned:
+		return value.asUnsigned();
+	case metrics::MetricValue::Kind::Real:
+		if (value.precision() >= 0) {
+			const double scale = std::pow(10.0, value.precision());
+			return std::round(value.asReal() * scale) / scale;
+		}
+		return value.asReal();
+	case metrics::MetricValue::Kind::Text:
+		return std::string(value.text());
+	case metrics::MetricValue::Kind::NotAvailable:
+		break;
+	}
+	return nullptr;
+}
+
+/** @brief Validates one rule; @p reason describes the first problem found */
+bool parseRule(const nlohmann::json &entry, Rule &rule, std::string &reason)
+{
+	if (!entry.is_object()) {
+		reason = "must be an object";
+		return false;
+	}
+	const ComparisonKey *comparison = nullptr;
+	for (const auto &[key, value] : entry.items()) {
+		const auto it = std::ranges::find(COMPARISON_KEYS, key, &ComparisonKey::key);
+		if (it != COMPARISON_KEYS.end()) {
+			if (comparison != nullptr) {
+				reason = std::format("\"{}\" and \"{}\" both given; a rule has one comparison", comparison->key, key);
+				return false;
+			}
+			comparison = &*it;
+		} else if (key != "name" && key != "metric" && key != "for" && key != "clear" && key != "severity") {
+			reason = std::format("unsupported key \"{}\"", key);
+			return false;
+		}
+	}
+
+	if (!entry.contains("metric") || !entry["metric"].is_string()) {
+		reason = "missing \"metric\"";
+		return false;
+	}
+	rule.metric = entry["metric"].get<std::string>();
+	if (!metrics::findMetric(rule.metric)) {
+		reason = std::format("unknown metric \"{}\"", rule.metric);
+		return false;
+	}
+
+	if (comparison == nullptr) {
+		reason = "missing comparison (above, at_least, below, at_most, equal, not_equal, rate_above, rate_below)";
+		return false;
+	}
+	rule.comparison = comparison->comparison;
+	rule.rate = comparison->rate;
+	const nlohmann::json &threshold = entry[std::string(comparison->key)];
+	const bool textComparison = rule.comparison == Comparison::Equal || rule.comparison == Comparison::NotEqual;
+	if (threshold.is_number()) {
+		rule.value = threshold.get<double>();
+	} else if (threshold.is_string() && textComparison) {
+		rule.text = threshold.get<std::string>();
+	} else if (threshold.is_string() && !rule.rate &&
+			   std::ranges::find(THRESHOLD_KEYS, threshold.get<std::string>()) != THRESHOLD_KEYS.end()) {
+		rule.thresholdKey = threshold.get<std::string>();
+	} else {
+		reason = std::format("\"{}\" must be a number{}", comparison->key,
+							 rule.rate ? "" : " or one of core_throttle, core_shutdown, memory_shutdown, power_tdp");
+		return false;
+	}
+
+	if (entry.contains("for")) {
+		if (!entry["for"].is_number() || entry["for"].get<double>() < 0) {
+			reason = "\"for\" must be a number of seconds >= 0";
+			return false;
+		}
+		rule.duration = std::chrono::milliseconds(std::llround(entry["for"].get<double>() * 1000.0));
+	}
+	if (entry.contains("clear")) {
+		if (!entry["clear"].is_number() || entry["clear"].get<double>() < 0) {
+			reason = "\"clear\" must be a number >= 0";
+			return false;
+		}
+		rule.clearMargin = entry["clear"].get<double>();
+	}
+	if (entry.contains("severity")) {
+		const auto &severity = entry["severity"];
+		if (severity == "warning") {
+			rule.severity = Severity::Warning;
+		} else if (severity == "critical") {
+			rule.severity = Severity::Critical;
+		} else {
+			reason = "\"severity\" must be \"warning\" or \"critical\"";
+			return false;
+		}
+	}
+
+	if (entry.contains("name")) {
+		if (!entry["name"].is_string() || entry["name"].get<std::string>().empty()) {
+			reason = "\"name\" must be a non-empty string";
+			return false;
+		}
+		rule.name = entry["name"].get<std::string>();
+	} else {
+		rule.name = std::format("{} {}", rule.metric, comparison->key);
+	}
+	return true;
+}
+
+Rule makeRule(std::string name, std::string metric, Comparison comparison, std::string thresholdKey,
+			  std::chrono::milliseconds duration, double clearMargin, Severity severity)
+{
+	Rule rule;
+	rule.name = std::move(name);
+	rule.metric = std::move(metric);
+	rule.comparison = comparison;
+	rule.thresholdKey = std::move(thresholdKey);
+	rule.duration = duration;
+	rule.clearMargin = clearMargin;
+	rule.severity = severity;
+	return rule;
+}
+
+} // namespace
+
+bool parseRules(const nlohmann::json &doc, std::vector<Rule> &out, std::string &error)
+{
+	out.clear();
+	if (!doc.is_object() || !doc.contains("rules") || !doc["rules"].is_array() || doc["rules"].empty()) {
+		error = "rules must be an object with a non-empty \"rules\" array";
+		return false;
+	}
+	for (const auto &[key, value] : doc.items()) {
+		if (key != "rules") {
+			error = std::format("unsupported key \"{}\"", key);
+			return false;
+		}
+	}
+
+	const auto &rules = doc["rules"];
+	for (std::size_t i = 0; i < rules.size(); ++i) {
+		Rule rule;
+		std::string reason;
+		if (!parseRule(rules[i], rule, reason)) {
+			error = std::format("rules[{}]: {}", i, reason);
+			return false;
+		}
+		if (std::ranges::any_of(out, [&](const Rule &r) { return r.name == rule.name; })) {
+			error = std::format("rules[{}]: duplicate name \"{}\"", i, rule.name);
+			return false;
+		}
+		out.push_back(std::move(rule));
+	}
+	return true;
+}
+
+std::vector<Rule> defaultRules()
+{
+	using std::chrono::milliseconds;
+	std::vector<Rule> rules;
+	rules.push_back(makeRule("core-temperature-throttle", "temperature.gpu", Comparison::AtLeast, "core_throttle",
+							 milliseconds(0), 3.0, Severity::Warning));
+	rules.push_back(makeRule("core-temperature-shutdown", "temperature.gpu", Comparison::AtLeast, "core_shutdown",
+							 milliseconds(0), 3.0, Severity::Critical));
+	rules.push_back(makeRule("memory-temperature-shutdown", "temperature.memory", Comparison::AtLeast,
+							 "memory_shutdown", milliseconds(0), 3.0, Severity::Critical));
+	rules.push_back(makeRule("power-above-tdp", "power.draw", Comparison::Above, "power_tdp", milliseconds(5000), 10.0,
+							 Severity::Warning));
+	Rule throttled = makeRule("frequency-throttled", "clocks.throttle.reason", Comparison::NotEqual, {},
+							  milliseconds(2000), 0.0, Severity::Warning);
+	throttled.text = "None";
+	rules.push_back(std::move(throttled));
+	return rules;
+}
+
+nlohmann::ordered_json toJson(const Alert &alert)
+{
+	nlohmann::ordered_json line;
+	line["time"] = std::format("{:%Y-%m-%dT%H:%M:%S}Z", std::chrono::floor<std::chrono::milliseconds>(alert.time));
+	line["event"] = alert.raised ? "raised" : "cleared";
+	line["severity"] = alert.rule->severity == Severity::Critical ? "critical" : "warning";
+	line["rule"] = alert.rule->name;
+	line["device_id"] = alert.device;
+	line["metric"] = alert.rule->metric;
+	line["comparison"] = comparisonName(*alert.rule);
+	line["value"] = toJsonValue(alert.value);
+	line["threshold"] = toJsonValue(alert.threshold);
+	return line;
+}
+
+Watchdog::Watchdog(std::vector<Rule> rules, ThresholdResolver resolver, AlertHandler onAlert, TimeSource now)
+	: mRules(std::move(rules)), mResolver(std::move(resolver)), mOnAlert(std::move(onAlert)), mNow(std::move(now))
+{
+	if (!mNow) {
+		mNow = [] { return TickTime{std::chrono::steady_clock::now(), std::chrono::system_clock::now()}; };
+	}
+	mRuleField.reserve(mRules.size());
+	for (const Rule &rule : mRules) {
+		const auto resolved = metrics::resolveQuery(rule.metric);
+		if (resolved.empty()) {
+			mRuleField.push_back(NO_FIELD); // Never sees a value and stays quiet
+			continue;
+		}
+		auto it = std::ranges::find(mFields, resolved.front());
+		if (it == mFields.end()) {
+			it = mFields.insert(mFields.end(), resolved.front());
+		}
+		mRuleField.push_back(static_cast<std::size_t>(it - mFields.begin()));
+	}
+}
+
+std::size_t Watchdog::activeAlerts() const noexcept
+{
+	std::size_t count = 0;
+	for (const DeviceState &device : mDevices) {
+		count += static_cast<std::size_t>(
+			std::ranges::count_if(device.rules, [](const RuleState &state) { return state.active; }));
+	}
+	return count;
+}
+
+void Watchdog::onBegin([[maybe_unused]] std::span<const metrics::QueryMetric *> fields)
+{
+	mTick = mNow();
+}
+
+void Watchdog::onBeginDevice(devInfo &dev)
+{
+	auto it = std::ranges::find_if(mDevices, [&](const DeviceState &d) { return d.info.index == dev.index; });
+	if (it == mDevices.end()) {
+		it = mDevices.emplace(mDevices.end());
+		it->values.resize(mFields.size());
+		it->rules.resize(mRules.size());
+	}
+	it->info = dev; // Handles change when the device is re-enumerated
+	if (!it->resolved) {
+		resolveThresholds(*it);
+	}
+	mCurrent = &*it;
+	mField = 0;
+}
+
+void Watchdog::onMetric([[maybe_unused]] const metrics::QueryMetric &f, const metrics::MetricValue &val)
+{
+	if (mCurrent != nullptr && mField < mCurrent->values.size()) {
+		mCurrent->values[mField++] = val;
+	}
+}
+
+void Watchdog::onEndDevice([[maybe_unused]] devInfo &dev)
+{
+	if (mCurrent == nullptr) {
+		return;
+	}
+	for (std::size_t i = 0; i < mRules.size(); ++i) {
+		evaluate(*mCurrent, i);
+	}
+	mCurrent = nullptr;
+}
+
+void Watchdog::resolveThresholds(DeviceState &device)
+{
+	device.thresholds.assign(mRules.size(), std::nullopt);
+	for (std::size_t i = 0; i < mRules.size(); ++i) {
+		if (!mRules[i].thresholdKey.empty() && mResolver) {
+			device.thresholds[i] = mResolver(device.info, mRules[i].thresholdKey);
+		}
+	}
+	device.resolved = true;
+}
+
+/**
+ * @brief Advances rule @p index on @p device by this tick's value.
+ *
+ * The alert is raised once the comparison has held for the rule's duration and cleared
+ * as soon as the value is past the threshold moved back by the margin; in between the
+ * state does not change, which keeps a value hovering at the threshold from flapping.
+ */
+void Watchdog::evaluate(DeviceState &device, std::size_t index)
+{
+	const Rule &rule = mRules[index];
+	RuleState &state = device.rules[index];
+	if (mRuleField[index] >= device.values.size()) {
+		return;
+	}
+	const metrics::MetricValue &value = device.values[mRuleField[index]];
+
+	double threshold = rule.value;
+	if (!rule.thresholdKey.empty()) {
+		if (!device.thresholds[index]) {
+			return;
+		}
+		threshold = *device.thresholds[index];
+	}
+
+	bool breached = false;
+	bool cleared = false;
+	metrics::MetricValue observed;
+	if (!rule.text.empty()) {
+		if (!value.available()) {
+			state.pendingSince.reset();
+			return;
+		}
+		const bool equal = value == rule.text;
+		breached = rule.comparison == Comparison::Equal ? equal : !equal;
+		cleared = !breached;
+		observed = value;
+	} else {
+		double x = toDouble(value);
+		if (rule.rate) {
+			const std::optional<double> previous =
+				std::exchange(state.previous, std::isnan(x) ? std::nullopt : std::optional<double>{x});
+			const auto previousTime = std::exchange(state.previousTime, mTick.steady);
+			const double seconds = std::chrono::duration<double>(mTick.steady - previousTime).count();
+			x = previous && seconds > 0.0 ? (x - *previous) / seconds : std::numeric_limits<double>::quiet_NaN();
+		}
+		if (std::isnan(x)) {
+			state.pendingSince.reset();
+			return;
+		}
+		breached = compare(rule.comparison, x, threshold);
+		cleared = !compare(rule.comparison, x, clearThreshold(rule.comparison, threshold, rule.clearMargin));
+		observed = metrics::MetricValue::real(x, ALERT_PRECISION);
+	}
+
+	if (!state.active) {
+		if (!breached) {
+			state.pendingSince.reset();
+			return;
+		}
+		if (!state.pendingSince) {
+			state.pendingSince = mTick.steady;
+		}
+		if (mTick.steady - *state.pendingSince < rule.duration) {
+			return;
+		}
+		state.active = true;
+		state.pendingSince.reset();
+	} else if (cleared) {
+		state.active = false;
+	} else {
+		return;
+	}
+
+	if (mOnAlert) {
+		Alert alert;
+		alert.rule = &rule;
+		alert.device = device.info.index;
+		alert.raised = state.active;
+		alert.value = observed;
+		alert.threshold = rule.text.empty() ? metrics::MetricValue::real(threshold) : metrics::MetricValue(rule.text);
+		alert.time = mTick.wall;
+		mOnAlert(alert);
+	}
+}
+
+HookQueue::HookQueue(Runner run, std::size_t capacity)
+	: mRun(std::move(run)), mCapacity(std::max<std::size_t>(capacity, 1)),
+	  mWorker([this](const std::stop_token &stop) { work(stop); })
+{
+}
+
+HookQueue::~HookQueue()
+{
+	mWorker.request_stop();
+	mWorker.join();
+}
+
+bool HookQueue::push(std::string line)
+{
+	bool kept = true;
+	{
+		const std::lock_guard lock(mMutex);
+		if (mQueue.size() >= mCapacity) {
+			mQueue.pop_front();
+			kept = false;
+		}
+		mQueue.push_back(std::move(line));
+	}
+	mReady.notify_one();
+	return kept;
+}
+
+/**
+ * @brief Runs the queued lines until stopped, then the ones left
+ */
+void HookQueue::work(const std::stop_token &stop)
+{
+	for (;;) {
+		std::string line;
+		{
+			std::unique_lock lock(mMutex);
+			if (!mReady.wait(lock, stop, [this] { return !mQueue.empty(); })) {
+				return;
+			}
+			line = std::move(mQueue.front());
+			mQueue.pop_front();
+		}
+		mRun(line);
+	}
+}
+
+} // namespace health_watch
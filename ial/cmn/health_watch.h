@@ -0,0 +1,252 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef HEALTH_WATCH_H
+#define HEALTH_WATCH_H
+
+#include "metrics_registry.h"
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Continuous health watchdog behind @c health --watch.
+ *
+ * Rules compare one registry metric of every watched device with a threshold and raise
+ * an alert once the comparison has held for a while; the alert clears once the value is
+ * back past the threshold by the rule's margin. Thresholds may name an entry of
+ * device_thresholds.json, resolved per device, so the same rule set fits every SKU.
+ *
+ * Rule file format:
+ * @code
+ * {
+ *   "rules": [
+ *     { "name": "core-hot", "metric": "temperature.gpu", "at_least": "core_throttle",
+ *       "for": 5, "clear": 3, "severity": "warning" },
+ *     { "name": "power-ramp", "metric": "power.draw", "rate_above": 100 },
+ *     { "name": "throttled", "metric": "clocks.throttle.reason", "not_equal": "None", "for": 2 }
+ *   ]
+ * }
+ * @endcode
+ *
+ * Every rule has exactly one comparison: @c above, @c at_least, @c below, @c at_most,
+ * @c equal, @c not_equal, or @c rate_above / @c rate_below to compare the change per
+ * second. @c for (s, default 0) is how long the comparison must hold before the alert
+ * is raised, @c clear (default 0) the hysteresis margin and @c severity is @c warning
+ * (default) or @c critical. A numeric comparison takes a number or one of
+ * @c core_throttle, @c core_shutdown, @c memory_shutdown, @c power_tdp.
+ *
+ * The watchdog samples the union of the rules' metrics once per tick, so the cost of a
+ * tick does not grow with the number of rules.
+ */
+namespace health_watch {
+
+enum class Comparison : uint8_t
+{
+	Above,
+	AtLeast,
+	Below,
+	AtMost,
+	Equal,
+	NotEqual,
+};
+
+enum class Severity : uint8_t
+{
+	Warning,
+	Critical,
+};
+
+/**
+ * @brief One validated watchdog rule.
+ */
+struct Rule
+{
+	std::string name;
+	std::string metric; ///< Registry name or alias
+	Comparison comparison{Comparison::Above};
+	bool rate{false};		  ///< Compare the change per second instead of the value
+	double value{0.0};		  ///< Numeric threshold, unless thresholdKey is set
+	std::string thresholdKey; ///< device_thresholds.json key, resolved per device
+	std::string text;		  ///< Threshold of a text comparison
+	std::chrono::milliseconds duration{0};
+	double clearMargin{0.0};
+	Severity severity{Severity::Warning};
+};
+
+/** @brief Keys a rule may use in place of a numeric threshold */
+inline constexpr std::array<std::string_view, 4> THRESHOLD_KEYS{"core_throttle", "core_shutdown", "memory_shutdown",
+																 "power_tdp"};
+
+/**
+ * @brief Parse and validate a rule document.
+ *
+ * @param[in]  doc    Parsed rule JSON.
+ * @param[out] out    Validated rules, in document order.
+ * @param[out] error  Description of the first problem found.
+ * @return true when every rule is valid and names a known metric.
+ */
+bool parseRules(const nlohmann::json &doc, std::vector<Rule> &out, std::string &error);
+
+/**
+ * @brief Rules watched when no rule file is given.
+ *
+ * Mirror the one-shot health checks: core temperature at the throttle and shutdown
+ * thresholds, memory temperature at its shutdown threshold, power above the TDP for 5 s
+ * and frequency throttling for 2 s.
+ */
+[[nodiscard]] std::vector<Rule> defaultRules();
+
+/**
+ * @brief A rule raised or cleared on one device.
+ */
+struct Alert
+{
+	const Rule *rule{nullptr};
+	uint32_t device{0};
+	bool raised{false};
+	metrics::MetricValue value;		///< Value, or change per second, that raised or cleared the alert
+	metrics::MetricValue threshold; ///< Threshold in effect on the device
+	std::chrono::system_clock::time_point time;
+};
+
+/** @brief One JSON line describing @p alert, as written to stdout, the log file and hooks */
+[[nodiscard]] nlohmann::ordered_json toJson(const Alert &alert);
+
+/** @brief Value of a device_thresholds.json key for @p dev, or nullopt when the device has none */
+using ThresholdResolver = std::function<std::optional<double>(devInfo &dev, std::string_view key)>;
+
+using AlertHandler = std::function<void(const Alert &alert)>;
+
+/** @brief Time of one tick: the steady clock for durations and rates, the wall clock for alerts */
+struct TickTime
+{
+	std::chrono::steady_clock::time_point steady;
+	std::chrono::system_clock::time_point wall;
+};
+
+using TimeSource = std::function<TickTime()>;
+
+/**
+ * @brief MetricOutput that evaluates every rule against each sample and reports alert
+ *        transitions
+ *
+ * Feed it through runMetricsWithCaches() with fields() at the sampling rate. State is
+ * kept per device and rule: a value that is unavailable restarts the pending duration
+ * but neither raises nor clears an alert. A rule whose threshold key has no value for a
+ * device is skipped on that device. Thresholds are resolved once per device.
+ */
+class Watchdog
+{
+public:
+	/**
+	 * @param rules     Validated rules; their metrics must resolve in the registry.
+	 * @param resolver  Looks up threshold keys; only called for rules that use one.
+	 * @param onAlert   Called on the sampling thread for every raise and clear.
+	 * @param now       Time of each tick; defaults to the system clocks.
+	 */
+	Watchdog(std::vector<Rule> rules, ThresholdResolver resolver, AlertHandler onAlert, TimeSource now = {});
+
+	Watchdog(const Watchdog &) = delete;
+	Watchdog &operator=(const Watchdog &) = delete;
+
+	/** @brief The metrics every tick samples: each metric of the rules once */
+	[[nodiscard]] std::span<const metrics::QueryMetric *> fields() { return mFields; }
+
+	[[nodiscard]] const std::vector<Rule> &rules() const noexcept { return mRules; }
+
+	/** @brief Alerts currently raised, over all devices */
+	[[nodiscard]] std::size_t activeAlerts() const noexcept;
+
+	void onBegin(std::span<const metrics::QueryMetric *> fields);
+	void onBeginDevice(devInfo &dev);
+	void onMetric(const metrics::QueryMetric &f, const metrics::MetricValue &val);
+	void onEndDevice(devInfo &dev);
+	void onEnd() {}
+
+private:
+	struct RuleState
+	{
+		bool active{false};
+		std::optional<std::chrono::steady_clock::time_point> pendingSince;
+		std::optional<double> previous; ///< Last value of a rate rule
+		std::chrono::steady_clock::time_point previousTime;
+	};
+
+	struct DeviceState
+	{
+		devInfo info{};
+		bool resolved{false};
+		std::vector<std::optional<double>> thresholds; ///< One per rule
+		std::vector<metrics::MetricValue> values;	   ///< One per field, this tick
+		std::vector<RuleState> rules;
+	};
+
+	void evaluate(DeviceState &device, std::size_t index);
+	void resolveThresholds(DeviceState &device);
+
+	std::vector<Rule> mRules;
+	std::vector<std::size_t> mRuleField; ///< Index into mFields of each rule's metric
+	std::vector<const metrics::QueryMetric *> mFields;
+	ThresholdResolver mResolver;
+	AlertHandler mOnAlert;
+	TimeSource mNow;
+	TickTime mTick{};
+	std::vector<DeviceState> mDevices;
+	DeviceState *mCurrent{nullptr};
+	std::size_t mField{0};
+};
+
+/**
+ * @brief Hands alert lines to the --hook command on a worker thread
+ *
+ * A hook may take seconds, so running it from the alert handler would stall the
+ * sampling of every device. Lines are passed to @p run one at a time, in the order
+ * pushed. When @c capacity lines are already waiting, the oldest waiting one is
+ * dropped to make room. Destruction runs the lines still queued before returning.
+ */
+class HookQueue
+{
+public:
+	using Runner = std::function<void(const std::string &line)>;
+
+	static constexpr std::size_t DEFAULT_CAPACITY = 64;
+
+	explicit HookQueue(Runner run, std::size_t capacity = DEFAULT_CAPACITY);
+	~HookQueue();
+
+	HookQueue(const HookQueue &) = delete;
+	HookQueue &operator=(const HookQueue &) = delete;
+
+	/** @brief Queues @p line; false when a waiting line had to be dropped for it */
+	bool push(std::string line);
+
+private:
+	void work(const std::stop_token &stop);
+
+	Runner mRun;
+	std::size_t mCapacity;
+	std::mutex mMutex;
+	std::condition_variable_any mReady;
+	std::deque<std::string> mQueue;
+	std::jthread mWorker; ///< Last, so it stops before the members it uses go away
+};
+
+} // namespace health_watch
+
+#endif // HEALTH_WATCH_H
@@ -0,0 +1,259 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "json_stream.h"
+#include "debug.h"
+#include <algorithm>
+
+namespace {
+
+/** @brief True when @p text can be written between quotes as is */
+bool isPlainAscii(std::string_view text)
+{
+	return std::all_of(text.begin(), text.end(), [](char c) {
+		const auto byte = static_cast<unsigned char>(c);
+		return byte >= 0x20 && byte < 0x7f && c != '"' && c != '\\';
+	});
+}
+
+} // namespace
+
+/**
+ * @brief Escapes @p name the way nlohmann::json does and appends the key separator
+ */
+JsonKey::JsonKey(std::string_view name)
+{
+	if (isPlainAscii(name)) {
+		mText.reserve(name.size() + 4);
+		mText.push_back('"');
+		mText.append(name);
+		mText.append("\": ");
+	} else {
+		mText = nlohmann::ordered_json(name).dump() + ": ";
+	}
+}
+
+JsonOutput::JsonOutput(std::shared_ptr<Sink> sink, size_t capacity) : mSink(std::move(sink)), mCapacity(capacity)
+{
+	mBuffer.reserve(capacity);
+}
+
+JsonOutput::~JsonOutput()
+{
+	if (!mBuffer.empty()) {
+		emit(mBuffer);
+	}
+}
+
+/**
+ * @brief Writes out the buffer up to its last newline
+ *
+ * Sinks end every message that does not end with a newline with one, so the line
+ * being written stays buffered until it is complete.
+ */
+void JsonOutput::flush()
+{
+	const size_t end = mBuffer.rfind('\n');
+	if (end == std::string::npos) {
+		return;
+	}
+	emit(std::string_view(mBuffer).substr(0, end + 1));
+	mBuffer.erase(0, end + 1);
+}
+
+void JsonOutput::emit(std::string_view text)
+{
+	const auto sink = mSink ? mSink : Logger::instance().getPrintSink();
+	sink->log(LogLevel::TRACE, {}, "", text);
+}
+
+/**
+ * @param out    Destination of the document
+ * @param indent Spaces per nesting level, as passed to nlohmann::json::dump(); must not be negative
+ */
+JsonStreamWriter::JsonStreamWriter(JsonOutput &out, int indent) : mOut(out), mIndent(static_cast<size_t>(indent)) {}
+
+void JsonStreamWriter::newline(size_t depth)
+{
+	static constexpr std::string_view spaces = "                                ";
+	mOut.write('\n');
+	for (size_t remaining = depth * mIndent; remaining > 0;) {
+		const size_t n = std::min(remaining, spaces.size());
+		mOut.write(spaces.substr(0, n));
+		remaining -= n;
+	}
+}
+
+/**
+ * @brief Writes what separates a value from whatever precedes it in its object or array
+ */
+void JsonStreamWriter::beginValue()
+{
+	if (mAfterKey) {
+		mAfterKey = false;
+		return;
+	}
+	if (mLevels.empty()) {
+		return;
+	}
+	if (!mLevels.back()) {
+		mOut.write(',');
+	}
+	mLevels.back() = false;
+	newline(mLevels.size());
+}
+
+JsonStreamWriter &JsonStreamWriter::key(const JsonKey &key)
+{
+	beginValue();
+	mOut.write(key.text());
+	mAfterKey = true;
+	return *this;
+}
+
+JsonStreamWriter &JsonStreamWriter::key(std::string_view name)
+{
+	beginValue();
+	writeString(name);
+	mOut.write(": ");
+	mAfterKey = true;
+	return *this;
+}
+
+void JsonStreamWriter::beginContainer(char open)
+{
+	beginValue();
+	mOut.write(open);
+	mLevels.push_back(true);
+}
+
+void JsonStreamWriter::endContainer(char close)
+{
+	const bool empty = mLevels.back();
+	mLevels.pop_back();
+	if (!empty) {
+		newline(mLevels.size());
+	}
+	mOut.write(close);
+}
+
+void JsonStreamWriter::beginObject()
+{
+	beginContainer('{');
+}
+
+void JsonStreamWriter::endObject()
+{
+	endContainer('}');
+}
+
+void JsonStreamWriter::beginArray()
+{
+	beginContainer('[');
+}
+
+void JsonStreamWriter::endArray()
+{
+	endContainer(']');
+}
+
+/**
+ * @brief Writes @p text as a JSON string; anything but plain ASCII is escaped by nlohmann::json,
+ *        which throws on invalid UTF-8 like dump() does
+ */
+void JsonStreamWriter::writeString(std::string_view text)
+{
+	if (isPlainAscii(text)) {
+		mOut.write('"');
+		mOut.write(text);
+		mOut.write('"');
+	} else {
+		mOut.write(nlohmann::ordered_json(text).dump());
+	}
+}
+
+void JsonStreamWriter::value(std::string_view text)
+{
+	beginValue();
+	writeString(text);
+}
+
+void JsonStreamWriter::value(bool flag)
+{
+	beginValue();
+	mOut.write(flag ? "true" : "false");
+}
+
+void JsonStreamWriter::value(std::nullptr_t)
+{
+	beginValue();
+	mOut.write("null");
+}
+
+void JsonStreamWriter::value(double number)
+{
+	// Shortest round-trip form with a trailing ".0" for integral values, "null" for NaN
+	beginValue();
+	mOut.write(nlohmann::ordered_json(number).dump());
+}
+
+void JsonStreamWriter::value(const nlohmann::ordered_json &tree)
+{
+	switch (tree.type()) {
+	case nlohmann::ordered_json::value_t::object:
+		beginObject();
+		for (auto it = tree.begin(); it != tree.end(); ++it) {
+			key(it.key());
+			value(it.value());
+		}
+		endObject();
+		break;
+	case nlohmann::ordered_json::value_t::array:
+		beginArray();
+		for (const auto &element : tree) {
+			value(element);
+		}
+		endArray();
+		break;
+	case nlohmann::ordered_json::value_t::string:
+		value(std::string_view(tree.get_ref<const std::string &>()));
+		break;
+	case nlohmann::ordered_json::value_t::boolean:
+		value(tree.get<bool>());
+		break;
+	case nlohmann::ordered_json::value_t::null:
+		value(nullptr);
+		break;
+	case nlohmann::ordered_json::value_t::number_integer:
+		value(tree.get<int64_t>());
+		break;
+	case nlohmann::ordered_json::value_t::number_unsigned:
+		value(tree.get<uint64_t>());
+		break;
+	case nlohmann::ordered_json::value_t::number_float:
+		value(tree.get<double>());
+		break;
+	default: {
+		// Binary values: let nlohmann lay them out and indent every line to this depth
+		beginValue();
+		const std::string text = tree.dump(static_cast<int>(mIndent));
+		size_t start = 0;
+		for (size_t end = text.find('\n'); end != std::string::npos; end = text.find('\n', start)) {
+			mOut.write(std::string_view(text).substr(start, end - start));
+			newline(mLevels.size());
+			start = end + 1;
+		}
+		mOut.write(std::string_view(text).substr(start));
+		break;
+	}
+	}
+}
+
+void JsonStreamWriter::end()
+{
+	mOut.write('\n');
+	mOut.flush();
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef _JSON_STREAM_H
+#define _JSON_STREAM_H
+
+#include <nlohmann/json.hpp>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class Sink;
+
+/**
+ * @brief Object key escaped and formatted once, e.g. "\"device_id\": "
+ *
+ * Commands keep their fixed keys in static JsonKey constants so writing a key is a
+ * plain copy.
+ */
+class JsonKey
+{
+public:
+	explicit JsonKey(std::string_view name);
+
+	[[nodiscard]] std::string_view text() const { return mText; }
+
+private:
+	std::string mText;
+};
+
+/**
+ * @brief Buffered destination of a JSON document
+ *
+ * Text is collected in a buffer and handed to the sink of PRINT() (stdout unless a
+ * custom sink is installed) whole lines at a time, once the buffer fills up or on
+ * flush(). Whatever is left is written by the destructor.
+ */
+class JsonOutput
+{
+public:
+	/**
+	 * @param sink     Where the text goes; nullptr for the sink of PRINT()
+	 * @param capacity Bytes buffered before complete lines are written out
+	 */
+	explicit JsonOutput(std::shared_ptr<Sink> sink = nullptr, size_t capacity = 64 * 1024);
+	~JsonOutput();
+
+	JsonOutput(const JsonOutput &) = delete;
+	JsonOutput &operator=(const JsonOutput &) = delete;
+
+	void write(std::string_view text)
+	{
+		mBuffer.append(text);
+		if (mBuffer.size() >= mCapacity) {
+			flush();
+		}
+	}
+
+	void write(char c)
+	{
+		mBuffer.push_back(c);
+		if (mBuffer.size() >= mCapacity) {
+			flush();
+		}
+	}
+
+	/** @brief Writes out every complete line buffered so far */
+	void flush();
+
+private:
+	void emit(std::string_view text);
+
+	std::shared_ptr<Sink> mSink;
+	size_t mCapacity;
+	std::string mBuffer;
+};
+
+/**
+ * @brief SAX-style JSON writer producing the same bytes as nlohmann::json::dump(indent)
+ *
+ * The document is written to a JsonOutput as it is described, so a command can emit
+ * one device at a time instead of building the whole document first:
+ * @code
+ *     JsonOutput out;
+ *     JsonStreamWriter writer(out);
+ *     static const JsonKey devices("device_list");
+ *     writer.beginObject();
+ *     writer.key(devices).beginArray();
+ *     for (auto &device : deviceList) {
+ *         writer.value(deviceJson(device));
+ *         writer.flush();
+ *     }
+ *     writer.endArray();
+ *     writer.endObject();
+ *     writer.end();
+ * @endcode
+ * Every value in an object must be preceded by key(); the writer does not check the
+ * document for well-formedness beyond that.
+ */
+class JsonStreamWriter
+{
+public:
+	explicit JsonStreamWriter(JsonOutput &out, int indent = 4);
+
+	JsonStreamWriter &key(const JsonKey &key);
+	/** @brief Key that is not known in advance, e.g. a device index */
+	JsonStreamWriter &key(std::string_view name);
+
+	void beginObject();
+	void endObject();
+	void beginArray();
+	void endArray();
+
+	void value(std::string_view text);
+	void value(const char *text) { value(std::string_view(text)); }
+	void value(const std::string &text) { value(std::string_view(text)); }
+	void value(bool flag);
+	void value(std::nullptr_t);
+	void value(double number);
+
+	template <typename T>
+		requires(std::integral<T> && !std::same_as<T, bool>)
+	void value(T number)
+	{
+		beginValue();
+		char buf[24];
+		const auto [ptr, ec] = std::to_chars(buf, buf + sizeof(buf), number);
+		mOut.write(std::string_view(buf, static_cast<size_t>(ptr - buf)));
+	}
+
+	/** @brief Writes a whole subtree, e.g. the object of one device */
+	void value(const nlohmann::ordered_json &tree);
+
+	/** @brief Writes out the complete lines written so far */
+	void flush() { mOut.flush(); }
+
+	/** @brief Terminates the document with a newline, as JsonPrinter always did, and flushes */
+	void end();
+
+private:
+	void beginValue();
+	void beginContainer(char open);
+	void endContainer(char close);
+	void newline(size_t depth);
+	void writeString(std::string_view text);
+
+	JsonOutput &mOut;
+	size_t mIndent;
+	/** One entry per open object or array; true while it has no members */
+	std::vector<bool> mLevels;
+	bool mAfterKey = false;
+};
+
+#endif // _JSON_STREAM_H
@@ -0,0 +1,1058 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "metric_store.h"
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <format>
+#include <limits>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+namespace metrics {
+
+namespace {
+
+/*
+ * File layout, little endian as the host writes it:
+ *
+ *   page 0             Schema: device, columns and tiers; written once
+ *   PAGE               Header copy 0
+ *   PAGE + HEADER      Header copy 1
+ *   PAGE + 2 * HEADER  Blocks of tier 0, then of tier 1, ...
+ *
+ * The header copy with the higher sequence number and a valid checksum is current.
+ * Block n of a tier's ring holds the rows of every block sequence number s with
+ * s % blocks == n; the open block, the one with the header's sequence number, is
+ * described by the header, the others by the BlockHeader in front of their rows.
+ */
+
+constexpr std::array<char, 8> MAGIC{'X', 'P', 'U', 'M', 'T', 'S', 'D', 'B'};
+constexpr uint32_t VERSION = 1;
+constexpr std::size_t PAGE = 4096;
+/** Room of each header copy */
+constexpr std::size_t HEADER_BYTES = 2 * PAGE;
+constexpr uint32_t ROWS_PER_BLOCK = 64;
+constexpr int64_t NO_BUCKET = std::numeric_limits<int64_t>::min();
+
+/** Largest encoding of a time: the '1111' prefix and a 64-bit delta-of-delta */
+constexpr std::size_t TIME_BITS_MAX = 4 + 64;
+/** Largest encoding of a value: two control bits, the 5-bit leading zero count, the 6-bit length and 64 bits */
+constexpr std::size_t VALUE_BITS_MAX = 2 + 5 + 6 + 64;
+constexpr uint8_t NO_WINDOW = 0xFF;
+
+/** Longest duration parseStoreDuration() accepts: ten years */
+constexpr int64_t MAX_DURATION_SECONDS = int64_t{10} * 366 * 24 * 3600;
+
+struct SchemaTier
+{
+	int64_t resolutionMs;
+	int64_t retentionMs;
+};
+
+struct Schema
+{
+	std::array<char, 8> magic;
+	uint32_t version;
+	uint32_t device;
+	uint32_t columnCount;
+	uint32_t tierCount;
+	std::array<SchemaTier, MetricStore::MAX_TIERS> tiers;
+	std::array<std::array<char, MetricStore::MAX_COLUMN_NAME + 1>, MetricStore::MAX_COLUMNS> names;
+	uint32_t checksum;
+};
+static_assert(sizeof(Schema) <= PAGE && std::is_trivially_copyable_v<Schema>);
+
+struct BlockHeader
+{
+	uint64_t seq;
+	int64_t firstMs;
+	int64_t lastMs;
+	uint32_t rows;
+	uint32_t bits;
+	uint32_t payloadCrc;
+	uint32_t checksum;
+};
+static_assert(std::is_trivially_copyable_v<BlockHeader>);
+
+constexpr std::array<uint32_t, 256> CRC_TABLE = [] {
+	std::array<uint32_t, 256> table{};
+	for (uint32_t i = 0; i < 256; ++i) {
+		uint32_t c = i;
+		for (int bit = 0; bit < 8; ++bit) {
+			c = (c >> 1) ^ (0xEDB88320u & (0u - (c & 1u)));
+		}
+		table[i] = c;
+	}
+	return table;
+}();
+
+/** @brief CRC-32 (IEEE 802.3) of @p size bytes, continuing @p crc */
+[[nodiscard]] uint32_t crc32(const void *data, std::size_t size, uint32_t crc = 0)
+{
+	crc = ~crc;
+	const auto *bytes = static_cast<const unsigned char *>(data);
+	for (std::size_t i = 0; i < size; ++i) {
+		crc = (crc >> 8) ^ CRC_TABLE[(crc ^ bytes[i]) & 0xFFu];
+	}
+	return ~crc;
+}
+
+/** @brief Checksum of a trivially copyable record up to its @c checksum member */
+template <typename T> [[nodiscard]] uint32_t checksumOf(const T &record)
+{
+	return crc32(&record, offsetof(T, checksum));
+}
+
+/** @brief CRC of the first @p bits bits of a block's rows; the bits after them in the last byte do not count */
+[[nodiscard]] uint32_t payloadCrc(const std::byte *payload, std::size_t bits)
+{
+	uint32_t crc = crc32(payload, bits / 8);
+	if (bits % 8 != 0) {
+		const unsigned mask = 0xFFu << (8 - bits % 8);
+		const auto tail = static_cast<unsigned char>(static_cast<unsigned>(payload[bits / 8]) & mask);
+		crc = crc32(&tail, 1, crc);
+	}
+	return crc;
+}
+
+[[nodiscard]] constexpr std::size_t alignUp(std::size_t value, std::size_t alignment)
+{
+	return (value + alignment - 1) / alignment * alignment;
+}
+
+[[nodiscard]] constexpr int64_t floorTo(int64_t value, int64_t step)
+{
+	const int64_t q = value / step;
+	return (q * step > value ? q - 1 : q) * step;
+}
+
+[[nodiscard]] double toDouble(const MetricValue &value)
+{
+	switch (value.kind()) {
+	case MetricValue::Kind::Signed:
+		return static_cast<double>(value.asSigned());
+	case MetricValue::Kind::Unsigned:
+		return static_cast<double>(value.asUnsigned());
+	case MetricValue::Kind::Real:
+		return value.asReal();
+	default:
+		return std::numeric_limits<double>::quiet_NaN();
+	}
+}
+
+/** @brief Bits of @p v, with every NaN the same so that a run of missing values compresses */
+[[nodiscard]] uint64_t bitsOf(double v)
+{
+	return std::bit_cast<uint64_t>(std::isnan(v) ? std::numeric_limits<double>::quiet_NaN() : v);
+}
+
+/** @brief Appends bits most significant first, zeroing every byte it starts */
+class BitWriter
+{
+public:
+	BitWriter(std::byte *data, std::size_t bits) : mData(data), mBits(bits)
+	{
+		// Bits past the end may have been written before a crash
+		if (mBits % 8 != 0) {
+			mData[mBits / 8] &= static_cast<std::byte>(0xFFu << (8 - mBits % 8));
+		}
+	}
+
+	/** @brief Writes the low @p count bits of @p value */
+	void write(uint64_t value, unsigned count)
+	{
+		while (count-- > 0) {
+			const std::size_t offset = mBits % 8;
+			if (offset == 0) {
+				mData[mBits / 8] = std::byte{0};
+			}
+			if (((value >> count) & 1u) != 0) {
+				mData[mBits / 8] |= static_cast<std::byte>(0x80u >> offset);
+			}
+			++mBits;
+		}
+	}
+
+	[[nodiscard]] std::size_t bits() const { return mBits; }
+
+private:
+	std::byte *mData;
+	std::size_t mBits;
+};
+
+class BitReader
+{
+public:
+	BitReader(const std::byte *data, std::size_t bits) : mData(data), mLimit(bits) {}
+
+	/** @brief Reads @p count bits; false when that runs past the end */
+	bool read(unsigned count, uint64_t &value)
+	{
+		if (mLimit - mBits < count) {
+			return false;
+		}
+		value = 0;
+		while (count-- > 0) {
+			const auto byte = static_cast<unsigned>(mData[mBits / 8]);
+			value = (value << 1) | ((byte >> (7 - mBits % 8)) & 1u);
+			++mBits;
+		}
+		return true;
+	}
+
+private:
+	const std::byte *mData;
+	std::size_t mLimit;
+	std::size_t mBits{0};
+};
+
+/** @brief Compression state of a block: the previous time and the previous value and XOR window of every column */
+struct RowState
+{
+	uint32_t rows{0};
+	int64_t previousTime{0};
+	int64_t previousDelta{0};
+	std::vector<uint64_t> previous;
+	std::vector<uint8_t> leading;
+	std::vector<uint8_t> meaningful;
+
+	void reset(std::size_t columns)
+	{
+		rows = 0;
+		previousTime = 0;
+		previousDelta = 0;
+		previous.assign(columns, 0);
+		leading.assign(columns, NO_WINDOW);
+		meaningful.assign(columns, 0);
+	}
+};
+
+[[nodiscard]] constexpr bool fitsSigned(int64_t v, unsigned bits)
+{
+	return v >= -(int64_t{1} << (bits - 1)) && v < (int64_t{1} << (bits - 1));
+}
+
+[[nodiscard]] constexpr int64_t signExtend(uint64_t v, unsigned bits)
+{
+	return static_cast<int64_t>(v << (64 - bits)) >> (64 - bits);
+}
+
+/** Delta-of-delta classes after the first row: prefix, prefix length, payload bits */
+struct TimeClass
+{
+	uint64_t prefix;
+	unsigned prefixBits;
+	unsigned bits;
+};
+constexpr std::array<TimeClass, 4> TIME_CLASSES{{{0b10, 2, 7}, {0b110, 3, 9}, {0b1110, 4, 12}, {0b1111, 4, 64}}};
+
+void encodeRow(BitWriter &w, RowState &state, int64_t time, std::span<const double> row)
+{
+	if (state.rows == 0) {
+		w.write(static_cast<uint64_t>(time), 64);
+	} else {
+		const int64_t delta = time - state.previousTime;
+		const int64_t dod = delta - state.previousDelta;
+		if (dod == 0) {
+			w.write(0, 1);
+		} else {
+			for (const TimeClass &c : TIME_CLASSES) {
+				if (c.bits == 64 || fitsSigned(dod, c.bits)) {
+					w.write(c.prefix, c.prefixBits);
+					w.write(static_cast<uint64_t>(dod), c.bits);
+					break;
+				}
+			}
+		}
+		state.previousDelta = delta;
+	}
+	state.previousTime = time;
+
+	for (std::size_t c = 0; c < row.size(); ++c) {
+		const uint64_t bits = bitsOf(row[c]);
+		if (state.rows == 0) {
+			w.write(bits, 64);
+			state.previous[c] = bits;
+			continue;
+		}
+		const uint64_t x = bits ^ state.previous[c];
+		state.previous[c] = bits;
+		if (x == 0) {
+			w.write(0, 1);
+			continue;
+		}
+		w.write(1, 1);
+		const auto lead = static_cast<uint8_t>(std::min(std::countl_zero(x), 31));
+		const auto trail = static_cast<unsigned>(std::countr_zero(x));
+		if (state.leading[c] != NO_WINDOW && lead >= state.leading[c] &&
+			trail >= 64u - state.leading[c] - state.meaningful[c]) {
+			// The changed bits fit the previous window
+			w.write(0, 1);
+			w.write(x >> (64u - state.leading[c] - state.meaningful[c]), state.meaningful[c]);
+			continue;
+		}
+		const auto length = static_cast<uint8_t>(64u - lead - trail);
+		w.write(1, 1);
+		w.write(lead, 5);
+		w.write(length - 1u, 6);
+		w.write(x >> trail, length);
+		state.leading[c] = lead;
+		state.meaningful[c] = length;
+	}
+	++state.rows;
+}
+
+bool decodeRow(BitReader &r, RowState &state, int64_t &time, std::span<double> row)
+{
+	uint64_t v = 0;
+	if (state.rows == 0) {
+		if (!r.read(64, v)) {
+			return false;
+		}
+		time = static_cast<int64_t>(v);
+	} else {
+		int64_t dod = 0;
+		if (!r.read(1, v)) {
+			return false;
+		}
+		if (v != 0) {
+			uint64_t prefix = 1;
+			unsigned prefixBits = 1;
+			for (const TimeClass &c : TIME_CLASSES) {
+				while (prefixBits < c.prefixBits) {
+					if (!r.read(1, v)) {
+						return false;
+					}
+					prefix = (prefix << 1) | v;
+					++prefixBits;
+				}
+				if (prefix == c.prefix) {
+					if (!r.read(c.bits, v)) {
+						return false;
+					}
+					dod = c.bits == 64 ? static_cast<int64_t>(v) : signExtend(v, c.bits);
+					break;
+				}
+			}
+		}
+		const int64_t delta = state.previousDelta + dod;
+		time = state.previousTime + delta;
+		state.previousDelta = delta;
+	}
+	state.previousTime = time;
+
+	for (std::size_t c = 0; c < row.size(); ++c) {
+		if (state.rows == 0) {
+			if (!r.read(64, state.previous[c])) {
+				return false;
+			}
+		} else {
+			if (!r.read(1, v)) {
+				return false;
+			}
+			if (v != 0) {
+				if (!r.read(1, v)) {
+					return false;
+				}
+				if (v != 0) {
+					uint64_t lead = 0;
+					uint64_t length = 0;
+					if (!r.read(5, lead) || !r.read(6, length)) {
+						return false;
+					}
+					state.leading[c] = static_cast<uint8_t>(lead);
+					state.meaningful[c] = static_cast<uint8_t>(length + 1);
+				} else if (state.leading[c] == NO_WINDOW) {
+					return false;
+				}
+				const unsigned shift = 64u - state.leading[c] - state.meaningful[c];
+				if (state.leading[c] + state.meaningful[c] > 64 || !r.read(state.meaningful[c], v)) {
+					return false;
+				}
+				state.previous[c] ^= v << shift;
+			}
+		}
+		row[c] = std::bit_cast<double>(state.previous[c]);
+	}
+	++state.rows;
+	return true;
+}
+
+/**
+ * @brief Decodes @p rows rows and adds those within [@p fromMs, @p toMs] to @p out
+ * @return false when the rows do not decode; those decoded so far are kept
+ */
+bool decodeBlock(const std::byte *payload, uint32_t rows, std::size_t bits, int64_t fromMs, int64_t toMs,
+				 StoreSeries &out, RowState &state)
+{
+	state.reset(out.columns);
+	BitReader r(payload, bits);
+	std::vector<double> row(out.columns);
+	for (uint32_t i = 0; i < rows; ++i) {
+		int64_t time = 0;
+		if (!decodeRow(r, state, time, row)) {
+			return false;
+		}
+		if (time >= fromMs && time <= toMs) {
+			out.times.push_back(time);
+			out.values.insert(out.values.end(), row.begin(), row.end());
+		}
+	}
+	return true;
+}
+
+[[nodiscard]] int64_t toMs(std::chrono::system_clock::time_point t)
+{
+	return std::chrono::duration_cast<std::chrono::milliseconds>(t.time_since_epoch()).count();
+}
+
+} // namespace
+
+/** Mutable state of the store; written as a whole to one of the two header copies */
+struct MetricStore::Header
+{
+	struct Tier
+	{
+		uint64_t blockSeq; ///< Sequence number of the open block
+		int64_t bucketMs;  ///< Start of the interval being averaged; NO_BUCKET before the first sample
+		int64_t firstMs;   ///< Times of the first and last rows of the open block
+		int64_t lastMs;
+		uint32_t rows; ///< Rows and bits of the open block
+		uint32_t bits;
+		uint32_t payloadCrc;
+		uint32_t reserved;
+	};
+
+	struct Sum
+	{
+		double sum;
+		uint32_t count;
+		uint32_t reserved;
+	};
+
+	uint64_t seq;
+	std::array<Tier, MAX_TIERS> tiers;
+	std::array<std::array<Sum, MAX_COLUMNS>, MAX_TIERS> sums; ///< Of the interval being averaged
+	uint32_t checksum;
+	uint32_t reserved;
+};
+
+struct MetricStore::Encoder
+{
+	RowState row;
+};
+
+MetricStore::MetricStore()
+{
+	static_assert(sizeof(Header) <= HEADER_BYTES && std::is_trivially_copyable_v<Header>);
+}
+
+MetricStore::~MetricStore() = default;
+
+std::filesystem::path MetricStore::defaultDirectory()
+{
+	return MappedFile::dataDirectory() / "metrics";
+}
+
+std::filesystem::path MetricStore::fileOf(const std::filesystem::path &directory, uint32_t device)
+{
+	return directory / std::format("gpu{}.xts", device);
+}
+
+std::vector<uint32_t> MetricStore::devicesIn(const std::filesystem::path &directory)
+{
+	std::vector<uint32_t> devices;
+	std::error_code ec;
+	for (const auto &entry : std::filesystem::directory_iterator(directory, ec)) {
+		const std::string name = entry.path().filename().string();
+		if (!name.starts_with("gpu") || !name.ends_with(".xts")) {
+			continue;
+		}
+		uint32_t device = 0;
+		const char *first = name.data() + 3;
+		const char *last = name.data() + name.size() - 4;
+		const auto [ptr, err] = std::from_chars(first, last, device);
+		if (err == std::errc{} && ptr == last && first != last) {
+			devices.push_back(device);
+		}
+	}
+	std::ranges::sort(devices);
+	return devices;
+}
+
+/**
+ * @brief Places the tiers' rings after the header copies
+ *
+ * A tier keeps ceil(retention / resolution) rows in full blocks and one more block that
+ * is being filled. Blocks are sized for rows that do not compress at all.
+ */
+void MetricStore::layOut()
+{
+	mLayout.clear();
+	std::size_t offset = PAGE + 2 * HEADER_BYTES;
+	const std::size_t rowBits = TIME_BITS_MAX + mColumns.size() * VALUE_BITS_MAX;
+	for (const StoreTier &tier : mTiers) {
+		const auto resolutionMs = std::chrono::duration_cast<std::chrono::milliseconds>(tier.resolution).count();
+		const auto retentionMs = std::chrono::duration_cast<std::chrono::milliseconds>(tier.retention).count();
+		const auto rows = static_cast<uint64_t>((retentionMs + resolutionMs - 1) / resolutionMs);
+		const auto rowsPerBlock = static_cast<uint32_t>(std::min<uint64_t>(ROWS_PER_BLOCK, rows));
+		const auto blocks = static_cast<uint32_t>((rows + rowsPerBlock - 1) / rowsPerBlock + 1);
+		const std::size_t blockBytes = alignUp(sizeof(BlockHeader) + (rowsPerBlock * rowBits + 7) / 8, 8);
+		mLayout.push_back({resolutionMs, offset, blocks, rowsPerBlock, blockBytes});
+		offset += blocks * blockBytes;
+	}
+}
+
+std::unique_ptr<MetricStore> MetricStore::create(const std::filesystem::path &path, uint32_t device,
+												 std::span<const std::string> columns, std::span<const StoreTier> tiers,
+												 std::string &error)
+{
+	if (columns.empty() || columns.size() > MAX_COLUMNS) {
+		error = std::format("a store has 1 to {} columns", MAX_COLUMNS);
+		return nullptr;
+	}
+	for (const std::string &column : columns) {
+		if (column.empty() || column.size() > MAX_COLUMN_NAME) {
+			error = std::format("column name \"{}\" is empty or longer than {} characters", column, MAX_COLUMN_NAME);
+			return nullptr;
+		}
+	}
+	if (tiers.empty() || tiers.size() > MAX_TIERS) {
+		error = std::format("a store has 1 to {} tiers", MAX_TIERS);
+		return nullptr;
+	}
+	for (std::size_t i = 0; i < tiers.size(); ++i) {
+		if (tiers[i].resolution.count() <= 0 || tiers[i].retention < tiers[i].resolution ||
+			(i > 0 && tiers[i].resolution <= tiers[i - 1].resolution)) {
+			error = "tiers need ascending resolutions, each retained for at least one interval";
+			return nullptr;
+		}
+	}
+
+	std::unique_ptr<MetricStore> store(new MetricStore);
+	store->mDevice = device;
+	store->mColumns.assign(columns.begin(), columns.end());
+	store->mTiers.assign(tiers.begin(), tiers.end());
+	store->layOut();
+	const std::size_t size = store->mLayout.back().offset +
+							 std::size_t{store->mLayout.back().blocks} * store->mLayout.back().blockBytes;
+
+	if (!store->mFile.open(path, MappedFileMode::READ_WRITE, size, error)) {
+		return nullptr;
+	}
+
+	Schema schema{};
+	std::memcpy(&schema, store->mFile.data(), sizeof(schema));
+	const bool initialized = std::ranges::any_of(std::as_bytes(std::span{&schema, 1}),
+												 [](std::byte b) { return b != std::byte{0}; });
+	if (!initialized) {
+		// New, or created by a writer that stopped before the schema was written
+		if (store->mFile.size() != size) {
+			error = "file is not a metric store";
+			return nullptr;
+		}
+		return store->initialize(device, columns, tiers, error) ? std::move(store) : nullptr;
+	}
+
+	if (!store->load(error)) {
+		return nullptr;
+	}
+	const bool sameTiers = std::ranges::equal(store->mTiers, tiers, [](const StoreTier &a, const StoreTier &b) {
+		return a.resolution == b.resolution && a.retention == b.retention;
+	});
+	if (store->mDevice != device || !std::ranges::equal(store->mColumns, columns) || !sameTiers) {
+		error = "store was recorded with other metrics or tiers";
+		return nullptr;
+	}
+	return store;
+}
+
+std::unique_ptr<MetricStore> MetricStore::open(const std::filesystem::path &path, std::string &error)
+{
+	std::unique_ptr<MetricStore> store(new MetricStore);
+	if (!store->mFile.open(path, MappedFileMode::READ_ONLY, 0, error) || !store->load(error)) {
+		return nullptr;
+	}
+	return store;
+}
+
+/**
+ * @brief Writes the first header copy, then the schema that makes the file a store
+ */
+bool MetricStore::initialize(uint32_t device, std::span<const std::string> columns, std::span<const StoreTier> tiers,
+							 std::string &error)
+{
+	mHeader = std::make_unique<Header>();
+	std::memset(mHeader.get(), 0, sizeof(Header));
+	for (auto &tier : mHeader->tiers) {
+		tier.bucketMs = NO_BUCKET;
+	}
+	mHeader->checksum = checksumOf(*mHeader);
+	std::memcpy(mFile.data() + PAGE, mHeader.get(), sizeof(Header));
+	mEncoders.assign(mTiers.size(), Encoder{});
+	for (Encoder &encoder : mEncoders) {
+		encoder.row.reset(mColumns.size());
+	}
+	if (!mFile.flush(PAGE, HEADER_BYTES)) {
+		error = "cannot write the header";
+		return false;
+	}
+
+	Schema schema{};
+	schema.magic = MAGIC;
+	schema.version = VERSION;
+	schema.device = device;
+	schema.columnCount = static_cast<uint32_t>(columns.size());
+	schema.tierCount = static_cast<uint32_t>(tiers.size());
+	for (std::size_t i = 0; i < tiers.size(); ++i) {
+		schema.tiers[i] = {std::chrono::duration_cast<std::chrono::milliseconds>(tiers[i].resolution).count(),
+						   std::chrono::duration_cast<std::chrono::milliseconds>(tiers[i].retention).count()};
+	}
+	for (std::size_t i = 0; i < columns.size(); ++i) {
+		std::ranges::copy(columns[i], schema.names[i].begin());
+	}
+	schema.checksum = checksumOf(schema);
+	std::memcpy(mFile.data(), &schema, sizeof(schema));
+	if (!mFile.flush(0, PAGE)) {
+		error = "cannot write the schema";
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Reads the schema and, for a writer, the current header and the state of every
+ *        open block
+ *
+ * An open block whose rows do not match their checksum, after a power loss that kept
+ * the header but not all of the rows, is emptied.
+ */
+bool MetricStore::load(std::string &error)
+{
+	Schema schema{};
+	if (mFile.size() < PAGE + 2 * HEADER_BYTES) {
+		error = "file is not a metric store";
+		return false;
+	}
+	std::memcpy(&schema, mFile.data(), sizeof(schema));
+	if (schema.magic != MAGIC || schema.checksum != checksumOf(schema)) {
+		error = "file is not a metric store";
+		return false;
+	}
+	if (schema.version != VERSION) {
+		error = std::format("store version {} is not supported", schema.version);
+		return false;
+	}
+	if (schema.columnCount == 0 || schema.columnCount > MAX_COLUMNS || schema.tierCount == 0 ||
+		schema.tierCount > MAX_TIERS) {
+		error = "store schema is damaged";
+		return false;
+	}
+
+	mDevice = schema.device;
+	mColumns.clear();
+	for (std::size_t i = 0; i < schema.columnCount; ++i) {
+		const auto &name = schema.names[i];
+		mColumns.emplace_back(name.data(), std::ranges::find(name, '\0') - name.begin());
+	}
+	mTiers.clear();
+	for (std::size_t i = 0; i < schema.tierCount; ++i) {
+		const auto resolution = std::chrono::milliseconds{schema.tiers[i].resolutionMs};
+		const auto retention = std::chrono::milliseconds{schema.tiers[i].retentionMs};
+		if (resolution.count() <= 0 || retention < resolution) {
+			error = "store schema is damaged";
+			return false;
+		}
+		mTiers.push_back({std::chrono::duration_cast<std::chrono::seconds>(resolution),
+						  std::chrono::duration_cast<std::chrono::seconds>(retention)});
+	}
+	layOut();
+	if (mFile.size() != mLayout.back().offset + std::size_t{mLayout.back().blocks} * mLayout.back().blockBytes) {
+		error = "file size does not match the store layout";
+		return false;
+	}
+	if (!mFile.writable()) {
+		return true;
+	}
+
+	mHeader = std::make_unique<Header>();
+	if (!readHeader(*mHeader)) {
+		error = "both header copies are damaged";
+		return false;
+	}
+	mEncoders.assign(mTiers.size(), Encoder{});
+	bool dropped = false;
+	for (std::size_t i = 0; i < mTiers.size(); ++i) {
+		Header::Tier &tier = mHeader->tiers[i];
+		const TierLayout &layout = mLayout[i];
+		const std::byte *payload =
+			mFile.data() + layout.offset + (tier.blockSeq % layout.blocks) * layout.blockBytes + sizeof(BlockHeader);
+		StoreSeries scratch;
+		scratch.columns = mColumns.size();
+		const std::size_t maxBits = (layout.blockBytes - sizeof(BlockHeader)) * 8;
+		if (tier.rows >= layout.rowsPerBlock || tier.bits > maxBits ||
+			payloadCrc(payload, tier.bits) != tier.payloadCrc ||
+			!decodeBlock(payload, tier.rows, tier.bits, NO_BUCKET, std::numeric_limits<int64_t>::max(), scratch,
+						 mEncoders[i].row)) {
+			tier.rows = 0;
+			tier.bits = 0;
+			tier.payloadCrc = payloadCrc(payload, 0);
+			mEncoders[i].row.reset(mColumns.size());
+			dropped = true;
+		}
+	}
+	if (dropped) {
+		commit();
+	}
+	return true;
+}
+
+/**
+ * @brief Copies the current header copy into @p header
+ *
+ * A reader may catch a copy while the writer rewrites it; the checksum tells, and the
+ * other copy is then the current one. Both fail only when the writer went round twice
+ * during the read, so that is retried.
+ */
+bool MetricStore::readHeader(Header &header) const
+{
+	constexpr int ATTEMPTS = 3;
+	for (int attempt = 0; attempt < ATTEMPTS; ++attempt) {
+		bool found = false;
+		for (std::size_t copy = 0; copy < 2; ++copy) {
+			Header candidate;
+			std::memcpy(&candidate, mFile.data() + PAGE + copy * HEADER_BYTES, sizeof(Header));
+			if (candidate.checksum != checksumOf(candidate) || (found && candidate.seq <= header.seq)) {
+				continue;
+			}
+			header = candidate;
+			found = true;
+		}
+		if (found) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * @brief Writes the writer's header over the older copy
+ */
+void MetricStore::commit()
+{
+	++mHeader->seq;
+	mHeader->checksum = checksumOf(*mHeader);
+	std::memcpy(mFile.data() + PAGE + (mHeader->seq % 2) * HEADER_BYTES, mHeader.get(), sizeof(Header));
+}
+
+void MetricStore::append(std::chrono::system_clock::time_point time, std::span<const double> values)
+{
+	if (!mFile.writable() || values.size() != mColumns.size()) {
+		return;
+	}
+	const int64_t timeMs = toMs(time);
+	std::vector<double> row(mColumns.size());
+	for (std::size_t i = 0; i < mTiers.size(); ++i) {
+		Header::Tier &tier = mHeader->tiers[i];
+		auto &sums = mHeader->sums[i];
+		const int64_t bucket = floorTo(timeMs, mLayout[i].resolutionMs);
+		if (tier.bucketMs != NO_BUCKET && bucket < tier.bucketMs) {
+			continue;
+		}
+		if (tier.bucketMs != NO_BUCKET && bucket > tier.bucketMs) {
+			for (std::size_t c = 0; c < mColumns.size(); ++c) {
+				row[c] = sums[c].count > 0 ? sums[c].sum / sums[c].count : std::numeric_limits<double>::quiet_NaN();
+				sums[c] = {};
+			}
+			appendRow(i, tier.bucketMs, row);
+		}
+		tier.bucketMs = bucket;
+		for (std::size_t c = 0; c < mColumns.size(); ++c) {
+			if (!std::isnan(values[c])) {
+				sums[c].sum += values[c];
+				++sums[c].count;
+			}
+		}
+	}
+	commit();
+}
+
+void MetricStore::appendRow(std::size_t tier, int64_t timeMs, std::span<const double> row)
+{
+	Header::Tier &state = mHeader->tiers[tier];
+	const TierLayout &layout = mLayout[tier];
+	std::byte *payload =
+		mFile.data() + layout.offset + (state.blockSeq % layout.blocks) * layout.blockBytes + sizeof(BlockHeader);
+
+	BitWriter w(payload, state.bits);
+	encodeRow(w, mEncoders[tier].row, timeMs, row);
+	if (state.rows == 0) {
+		state.firstMs = timeMs;
+	}
+	state.lastMs = timeMs;
+	++state.rows;
+	state.bits = static_cast<uint32_t>(w.bits());
+	state.payloadCrc = payloadCrc(payload, state.bits);
+	if (state.rows == layout.rowsPerBlock) {
+		closeBlock(tier);
+	}
+}
+
+/**
+ * @brief Seals the open block with its own header and opens the next one of the ring
+ *
+ * The block is on disk before a header that no longer describes it is written.
+ */
+void MetricStore::closeBlock(std::size_t tier)
+{
+	Header::Tier &state = mHeader->tiers[tier];
+	const TierLayout &layout = mLayout[tier];
+	const std::size_t offset = layout.offset + (state.blockSeq % layout.blocks) * layout.blockBytes;
+
+	BlockHeader block{state.blockSeq, state.firstMs, state.lastMs, state.rows, state.bits, state.payloadCrc, 0};
+	block.checksum = checksumOf(block);
+	std::memcpy(mFile.data() + offset, &block, sizeof(block));
+	mFile.flush(offset, layout.blockBytes);
+
+	++state.blockSeq;
+	state.rows = 0;
+	state.bits = 0;
+	state.payloadCrc = payloadCrc(nullptr, 0);
+	mEncoders[tier].row.reset(mColumns.size());
+}
+
+void MetricStore::flush()
+{
+	if (mFile.writable()) {
+		mFile.flush(0, mFile.size());
+	}
+}
+
+/**
+ * @brief Time of the oldest row of @p tier, the open interval included
+ */
+std::optional<int64_t> MetricStore::oldest(const Header &header, std::size_t tier) const
+{
+	const Header::Tier &state = header.tiers[tier];
+	const TierLayout &layout = mLayout[tier];
+	const uint64_t first = state.blockSeq >= layout.blocks - 1 ? state.blockSeq - (layout.blocks - 1) : 0;
+	for (uint64_t seq = first; seq < state.blockSeq; ++seq) {
+		BlockHeader block;
+		std::memcpy(&block, mFile.data() + layout.offset + (seq % layout.blocks) * layout.blockBytes, sizeof(block));
+		if (block.checksum == checksumOf(block) && block.seq == seq) {
+			return block.firstMs;
+		}
+	}
+	if (state.rows > 0) {
+		return state.firstMs;
+	}
+	if (state.bucketMs != NO_BUCKET) {
+		return state.bucketMs;
+	}
+	return std::nullopt;
+}
+
+/**
+ * @brief Adds the rows of @p tier within [@p fromMs, @p toMs] to @p out: the sealed
+ *        blocks, the open block and the interval being averaged
+ *
+ * Rows are copied out of the file before they are checked, so a block the writer
+ * overwrites meanwhile fails its checksum and is left out.
+ */
+void MetricStore::collect(const Header &header, std::size_t tier, int64_t fromMs, int64_t toMs,
+						  StoreSeries &out) const
+{
+	const Header::Tier &state = header.tiers[tier];
+	const TierLayout &layout = mLayout[tier];
+	const std::size_t maxBits = (layout.blockBytes - sizeof(BlockHeader)) * 8;
+	std::vector<std::byte> payload;
+	RowState rowState;
+
+	const auto addBlock = [&](const std::byte *block, uint32_t rows, std::size_t bits, uint32_t crc) {
+		if (rows == 0 || rows > layout.rowsPerBlock || bits > maxBits) {
+			return;
+		}
+		payload.assign(block, block + (bits + 7) / 8);
+		if (payloadCrc(payload.data(), bits) != crc) {
+			return;
+		}
+		const std::size_t before = out.rows();
+		if (!decodeBlock(payload.data(), rows, bits, fromMs, toMs, out, rowState)) {
+			out.times.resize(before);
+			out.values.resize(before * out.columns);
+		}
+	};
+
+	const uint64_t first = state.blockSeq >= layout.blocks - 1 ? state.blockSeq - (layout.blocks - 1) : 0;
+	for (uint64_t seq = first; seq < state.blockSeq; ++seq) {
+		const std::byte *base = mFile.data() + layout.offset + (seq % layout.blocks) * layout.blockBytes;
+		BlockHeader block;
+		std::memcpy(&block, base, sizeof(block));
+		if (block.checksum != checksumOf(block) || block.seq != seq || block.lastMs < fromMs || block.firstMs > toMs) {
+			continue;
+		}
+		addBlock(base + sizeof(BlockHeader), block.rows, block.bits, block.payloadCrc);
+	}
+	if (state.rows > 0 && state.lastMs >= fromMs && state.firstMs <= toMs) {
+		addBlock(mFile.data() + layout.offset + (state.blockSeq % layout.blocks) * layout.blockBytes +
+					 sizeof(BlockHeader),
+				 state.rows, state.bits, state.payloadCrc);
+	}
+
+	if (state.bucketMs != NO_BUCKET && state.bucketMs >= fromMs && state.bucketMs <= toMs &&
+		(out.times.empty() || out.times.back() < state.bucketMs)) {
+		out.times.push_back(state.bucketMs);
+		for (std::size_t c = 0; c < out.columns; ++c) {
+			const Header::Sum &sum = header.sums[tier][c];
+			out.values.push_back(sum.count > 0 ? sum.sum / sum.count : std::numeric_limits<double>::quiet_NaN());
+		}
+	}
+}
+
+StoreSeries MetricStore::query(std::size_t tier, std::chrono::system_clock::time_point from,
+							   std::chrono::system_clock::time_point to) const
+{
+	StoreSeries out;
+	out.columns = mColumns.size();
+	Header header;
+	if (tier >= mTiers.size() || !readHeader(header)) {
+		return out;
+	}
+	out.resolution = mTiers[tier].resolution;
+	collect(header, tier, toMs(from), toMs(to), out);
+	return out;
+}
+
+/**
+ * @brief A tier answers for @p from when it reaches back that far or has not dropped a
+ *        row yet, which a coarser tier cannot do better
+ */
+StoreSeries MetricStore::query(std::chrono::system_clock::time_point from,
+							   std::chrono::system_clock::time_point to) const
+{
+	StoreSeries out;
+	out.columns = mColumns.size();
+	Header header;
+	if (!readHeader(header)) {
+		return out;
+	}
+	const int64_t fromMs = toMs(from);
+	std::size_t chosen = 0;
+	std::optional<int64_t> furthest;
+	for (std::size_t i = 0; i < mTiers.size(); ++i) {
+		const auto start = oldest(header, i);
+		if (!start) {
+			continue;
+		}
+		const bool wrapped = header.tiers[i].blockSeq >= mLayout[i].blocks;
+		if (*start <= fromMs || !wrapped) {
+			chosen = i;
+			break;
+		}
+		if (!furthest || *start < *furthest) {
+			chosen = i;
+			furthest = start;
+		}
+	}
+	out.resolution = mTiers[chosen].resolution;
+	collect(header, chosen, fromMs, toMs(to), out);
+	return out;
+}
+
+// ── StoreRecorder ─────────────────────────────────────────────────────────────
+
+StoreRecorder::StoreRecorder(std::filesystem::path directory, std::span<const QueryMetric *const> fields,
+							 std::span<const StoreTier> tiers, Clock now)
+	: mDirectory(std::move(directory)), mTiers(tiers.begin(), tiers.end()), mNow(std::move(now))
+{
+	for (const QueryMetric *f : fields) {
+		mColumns.emplace_back(f->name);
+	}
+	if (!mNow) {
+		mNow = [] { return std::chrono::system_clock::now(); };
+	}
+	std::error_code ec;
+	std::filesystem::create_directories(mDirectory, ec);
+}
+
+void StoreRecorder::flush()
+{
+	for (DeviceStore &entry : mStores) {
+		if (entry.store) {
+			entry.store->flush();
+		}
+	}
+}
+
+void StoreRecorder::onBegin([[maybe_unused]] std::span<const QueryMetric *> fields) {}
+
+void StoreRecorder::onBeginDevice(devInfo &dev)
+{
+	auto it = std::ranges::find(mStores, dev.index, &DeviceStore::index);
+	if (it == mStores.end()) {
+		std::string error;
+		const auto path = MetricStore::fileOf(mDirectory, dev.index);
+		auto store = MetricStore::create(path, dev.index, mColumns, mTiers, error);
+		if (!store && mError.empty()) {
+			mError = std::format("{}: {}", path.string(), error);
+		}
+		mStores.push_back({dev.index, std::move(store)});
+		it = std::prev(mStores.end());
+	}
+	mCurrent = &*it;
+	mRow.assign(mColumns.size(), std::numeric_limits<double>::quiet_NaN());
+	mField = 0;
+}
+
+void StoreRecorder::onMetric([[maybe_unused]] const QueryMetric &f, const MetricValue &val)
+{
+	if (mField < mRow.size()) {
+		mRow[mField] = toDouble(val);
+	}
+	++mField;
+}
+
+void StoreRecorder::onEndDevice([[maybe_unused]] devInfo &dev)
+{
+	if (mCurrent != nullptr && mCurrent->store) {
+		mCurrent->store->append(mNow(), mRow);
+	}
+	mCurrent = nullptr;
+}
+
+std::optional<std::chrono::seconds> parseStoreDuration(std::string_view text)
+{
+	int64_t value = 0;
+	const auto [ptr, err] = std::from_chars(text.data(), text.data() + text.size(), value);
+	if (err != std::errc{} || value <= 0) {
+		return std::nullopt;
+	}
+	const std::string_view unit{ptr, static_cast<std::size_t>(text.data() + text.size() - ptr)};
+	int64_t scale = 0;
+	if (unit.empty() || unit == "s") {
+		scale = 1;
+	} else if (unit == "m") {
+		scale = 60;
+	} else if (unit == "h") {
+		scale = 3600;
+	} else if (unit == "d") {
+		scale = 24 * 3600;
+	} else {
+		return std::nullopt;
+	}
+	if (value > MAX_DURATION_SECONDS / scale) {
+		return std::nullopt;
+	}
+	return std::chrono::seconds{value * scale};
+}
+
+} // namespace metrics
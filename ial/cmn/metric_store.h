@@ -0,0 +1,233 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef METRIC_STORE_H
+#define METRIC_STORE_H
+
+#include "mapped_file.h"
+#include "metrics_registry.h"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace metrics {
+
+/** @brief One resolution of a store and how long rows of that resolution are kept */
+struct StoreTier
+{
+	std::chrono::seconds resolution;
+	std::chrono::seconds retention;
+};
+
+/** @brief 1 s rows for an hour, 1 min rows for a day and 1 h rows for 30 days */
+inline constexpr std::array<StoreTier, 3> DEFAULT_STORE_TIERS{{
+	{std::chrono::seconds{1}, std::chrono::hours{1}},
+	{std::chrono::minutes{1}, std::chrono::hours{24}},
+	{std::chrono::hours{1}, std::chrono::hours{24 * 30}},
+}};
+
+/**
+ * @brief Rows read back from a store: one time and one value per column each
+ *
+ * A value that was not available is NaN.
+ */
+struct StoreSeries
+{
+	std::chrono::seconds resolution{0}; ///< Of the tier the rows come from
+	std::size_t columns{0};
+	std::vector<int64_t> times; ///< Start of each row's interval, in ms since the epoch, ascending
+	std::vector<double> values; ///< Row-major, columns values per row
+
+	[[nodiscard]] std::size_t rows() const noexcept { return times.size(); }
+	[[nodiscard]] double value(std::size_t row, std::size_t column) const { return values[row * columns + column]; }
+};
+
+/**
+ * @brief Rolling time-series store of one device in a fixed-size memory-mapped file
+ *
+ * Every tier is a ring of blocks sized for its retention, so the file never grows and
+ * the oldest block of a tier is overwritten once the tier is full. Samples are averaged
+ * into one row per resolution interval of each tier; a row is written once a sample of
+ * a later interval arrives and until then is kept with the file header, so queries see
+ * it too. Rows are compressed within their block: times as delta-of-delta and every
+ * column as the XOR with its previous value, the way Gorilla does it, so a steady
+ * metric costs one bit per row. Blocks are sized for the worst case and the file is
+ * sparse, so disk space follows the compressed size.
+ *
+ * The file survives a crash of the writer at any point: the header exists twice and
+ * is written alternately, each copy with a sequence number and a checksum, so one copy
+ * is always whole, and every block carries a checksum of its rows. A row is part of the
+ * store once the header naming it is written; what the writer did after the last
+ * header is dropped when the file is opened again. Readers may query while a writer
+ * appends.
+ */
+class MetricStore
+{
+public:
+	static constexpr std::size_t MAX_COLUMNS = 64;
+	static constexpr std::size_t MAX_TIERS = 4;
+	static constexpr std::size_t MAX_COLUMN_NAME = 47;
+
+	~MetricStore();
+	MetricStore(const MetricStore &) = delete;
+	MetricStore &operator=(const MetricStore &) = delete;
+
+	/**
+	 * @brief Opens the store at @p path for appending, creating it when missing
+	 *
+	 * An existing store must have the same device, columns and tiers.
+	 *
+	 * @param[out] error  Why the store could not be opened.
+	 * @return The store, or nullptr.
+	 */
+	static std::unique_ptr<MetricStore> create(const std::filesystem::path &path, uint32_t device,
+											   std::span<const std::string> columns, std::span<const StoreTier> tiers,
+											   std::string &error);
+
+	/**
+	 * @brief Opens the store at @p path for queries
+	 *
+	 * @param[out] error  Why the store could not be opened.
+	 * @return The store, or nullptr.
+	 */
+	static std::unique_ptr<MetricStore> open(const std::filesystem::path &path, std::string &error);
+
+	/** @brief Where stores are kept unless a directory is given */
+	static std::filesystem::path defaultDirectory();
+
+	/** @brief File of the store of @p device in @p directory */
+	static std::filesystem::path fileOf(const std::filesystem::path &directory, uint32_t device);
+
+	/** @brief Devices with a store in @p directory, ascending */
+	static std::vector<uint32_t> devicesIn(const std::filesystem::path &directory);
+
+	[[nodiscard]] uint32_t device() const noexcept { return mDevice; }
+	[[nodiscard]] const std::vector<std::string> &columns() const noexcept { return mColumns; }
+	[[nodiscard]] const std::vector<StoreTier> &tiers() const noexcept { return mTiers; }
+
+	/**
+	 * @brief Adds a sample with one value per column, NaN for not available
+	 *
+	 * A sample older than the interval a tier is accumulating, after the clock was set
+	 * back, is left out of that tier.
+	 */
+	void append(std::chrono::system_clock::time_point time, std::span<const double> values);
+
+	/** @brief Waits until everything appended is on disk */
+	void flush();
+
+	/**
+	 * @brief Rows of [@p from, @p to] from the finest tier that reaches back to @p from,
+	 *        or from the tier reaching back furthest when none does
+	 */
+	[[nodiscard]] StoreSeries query(std::chrono::system_clock::time_point from,
+									std::chrono::system_clock::time_point to) const;
+
+	/** @brief Rows of [@p from, @p to] of tier @p tier */
+	[[nodiscard]] StoreSeries query(std::size_t tier, std::chrono::system_clock::time_point from,
+									std::chrono::system_clock::time_point to) const;
+
+private:
+	struct Header;
+	struct Encoder;
+
+	/** Where the blocks of a tier are in the file */
+	struct TierLayout
+	{
+		int64_t resolutionMs;
+		std::size_t offset;
+		uint32_t blocks;
+		uint32_t rowsPerBlock;
+		std::size_t blockBytes;
+	};
+
+	MetricStore();
+
+	bool load(std::string &error);
+	bool initialize(uint32_t device, std::span<const std::string> columns, std::span<const StoreTier> tiers,
+					std::string &error);
+	void layOut();
+	bool readHeader(Header &header) const;
+	void commit();
+	void appendRow(std::size_t tier, int64_t timeMs, std::span<const double> row);
+	void closeBlock(std::size_t tier);
+	[[nodiscard]] std::optional<int64_t> oldest(const Header &header, std::size_t tier) const;
+	void collect(const Header &header, std::size_t tier, int64_t fromMs, int64_t toMs, StoreSeries &out) const;
+
+	MappedFile mFile;
+	uint32_t mDevice{0};
+	std::vector<std::string> mColumns;
+	std::vector<StoreTier> mTiers;
+	std::vector<TierLayout> mLayout;
+	std::unique_ptr<Header> mHeader; ///< Writer's copy of the header
+	std::vector<Encoder> mEncoders;	 ///< Writer's state of the open block of every tier
+};
+
+/**
+ * @brief MetricOutput that appends every sample to the store of its device
+ *
+ * Stores are created in @p directory on the first sample of each device, with one
+ * column per numeric field; text values are stored as not available. Devices whose
+ * store cannot be opened are skipped; error() tells why for the first one.
+ */
+class StoreRecorder
+{
+public:
+	using Clock = std::function<std::chrono::system_clock::time_point()>;
+
+	StoreRecorder(std::filesystem::path directory, std::span<const QueryMetric *const> fields,
+				  std::span<const StoreTier> tiers = DEFAULT_STORE_TIERS, Clock now = {});
+
+	StoreRecorder(const StoreRecorder &) = delete;
+	StoreRecorder &operator=(const StoreRecorder &) = delete;
+
+	/** @brief Why a device's store could not be opened; empty when all could */
+	[[nodiscard]] const std::string &error() const noexcept { return mError; }
+
+	/** @brief Waits until every store is on disk */
+	void flush();
+
+	void onBegin(std::span<const QueryMetric *> fields);
+	void onBeginDevice(devInfo &dev);
+	void onMetric(const QueryMetric &f, const MetricValue &val);
+	void onEndDevice(devInfo &dev);
+	void onEnd() {}
+
+private:
+	struct DeviceStore
+	{
+		uint32_t index{0};
+		std::unique_ptr<MetricStore> store; ///< Null when it could not be opened
+	};
+
+	std::filesystem::path mDirectory;
+	std::vector<std::string> mColumns;
+	std::vector<StoreTier> mTiers;
+	Clock mNow;
+	std::vector<DeviceStore> mStores;
+	DeviceStore *mCurrent{nullptr};
+	std::vector<double> mRow;
+	std::size_t mField{0};
+	std::string mError;
+};
+
+/**
+ * @brief Parses a duration like "90", "15m", "2h" or "30d"; plain numbers are seconds
+ */
+[[nodiscard]] std::optional<std::chrono::seconds> parseStoreDuration(std::string_view text);
+
+} // namespace metrics
+
+#endif // METRIC_STORE_H
@@ -0,0 +1,333 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "metric_window.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <format>
+#include <limits>
+
+namespace metrics {
+
+namespace {
+
+/** Magnitudes below this are counted as zero; their logarithm would need unbounded buckets */
+constexpr double MIN_MAGNITUDE = 1e-9;
+
+/** Suffixes of the aggregated fields, in the order WindowAggregator::flush() writes them */
+constexpr std::array<std::string_view, 5> STAT_SUFFIXES{"min", "max", "avg", "p95", "last"};
+
+/** Decimals of the mean and percentiles of integer metrics */
+constexpr int INTEGER_MEAN_PRECISION = 2;
+
+[[nodiscard]] double toDouble(const MetricValue &value)
+{
+	switch (value.kind()) {
+	case MetricValue::Kind::Signed:
+		return static_cast<double>(value.asSigned());
+	case MetricValue::Kind::Unsigned:
+		return static_cast<double>(value.asUnsigned());
+	case MetricValue::Kind::Real:
+		return value.asReal();
+	default:
+		return std::numeric_limits<double>::quiet_NaN();
+	}
+}
+
+} // namespace
+
+// ── QuantileSketch ────────────────────────────────────────────────────────────
+
+/**
+ * @param relativeAccuracy Largest relative error of a reported quantile, in (0, 1)
+ */
+QuantileSketch::QuantileSketch(double relativeAccuracy)
+	: mGamma((1.0 + relativeAccuracy) / (1.0 - relativeAccuracy)), mInvLogGamma(1.0 / std::log(mGamma))
+{
+}
+
+void QuantileSketch::Buckets::add(int32_t index)
+{
+	if (counts.empty()) {
+		first = index;
+		counts.push_back(0);
+	} else if (index < first) {
+		counts.insert(counts.begin(), static_cast<std::size_t>(first - index), 0);
+		first = index;
+	} else if (static_cast<std::size_t>(index - first) >= counts.size()) {
+		counts.resize(static_cast<std::size_t>(index - first) + 1, 0);
+	}
+	++counts[static_cast<std::size_t>(index - first)];
+
+	if (lowest > highest) {
+		lowest = highest = index;
+	} else {
+		lowest = std::min(lowest, index);
+		highest = std::max(highest, index);
+	}
+}
+
+void QuantileSketch::Buckets::clear() noexcept
+{
+	if (lowest <= highest) {
+		std::fill(counts.begin() + (lowest - first), counts.begin() + (highest - first) + 1, 0);
+	}
+	lowest = 0;
+	highest = -1;
+}
+
+/** @brief Bucket @c i holds the magnitudes in (gamma^(i-1), gamma^i] */
+int32_t QuantileSketch::bucketOf(double magnitude) const
+{
+	return static_cast<int32_t>(std::ceil(std::log(magnitude) * mInvLogGamma));
+}
+
+/** @brief The value within the relative accuracy of every magnitude of bucket @p bucket */
+double QuantileSketch::valueOf(int32_t bucket) const
+{
+	return 2.0 * std::pow(mGamma, bucket) / (mGamma + 1.0);
+}
+
+/** @brief Sign class (-1, 0 or 1) and bucket of @p value */
+std::pair<int, int32_t> QuantileSketch::bucketKey(double value) const
+{
+	const double magnitude = std::min(std::fabs(value), std::numeric_limits<double>::max());
+	if (magnitude < MIN_MAGNITUDE) {
+		return {0, 0};
+	}
+	return {value > 0 ? 1 : -1, bucketOf(magnitude)};
+}
+
+/** @brief The exact minimum or maximum when it lies in the bucket, the bucket's value otherwise */
+double QuantileSketch::resolve(int sign, int32_t bucket) const
+{
+	const std::pair<int, int32_t> key{sign, bucket};
+	if (bucketKey(mMin) == key) {
+		return mMin;
+	}
+	if (bucketKey(mMax) == key) {
+		return mMax;
+	}
+	return sign == 0 ? 0.0 : sign * valueOf(bucket);
+}
+
+void QuantileSketch::add(double value)
+{
+	if (std::isnan(value)) {
+		return;
+	}
+	mMin = mCount == 0 ? value : std::min(mMin, value);
+	mMax = mCount == 0 ? value : std::max(mMax, value);
+	const double magnitude = std::min(std::fabs(value), std::numeric_limits<double>::max());
+	if (magnitude < MIN_MAGNITUDE) {
+		++mZero;
+	} else if (value > 0) {
+		mPositive.add(bucketOf(magnitude));
+	} else {
+		mNegative.add(bucketOf(magnitude));
+	}
+	++mCount;
+}
+
+double QuantileSketch::quantile(double q) const
+{
+	if (mCount == 0) {
+		return std::numeric_limits<double>::quiet_NaN();
+	}
+	// Nearest rank; the epsilon keeps e.g. 0.95 * 20 from rounding up to rank 20
+	const double exact = std::clamp(q, 0.0, 1.0) * static_cast<double>(mCount);
+	const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(exact - 1e-9)));
+
+	uint64_t seen = 0;
+	for (int32_t i = mNegative.highest; i >= mNegative.lowest; --i) {
+		seen += mNegative.counts[static_cast<std::size_t>(i - mNegative.first)];
+		if (seen >= rank) {
+			return resolve(-1, i);
+		}
+	}
+	seen += mZero;
+	if (seen >= rank) {
+		return resolve(0, 0);
+	}
+	for (int32_t i = mPositive.lowest; i <= mPositive.highest; ++i) {
+		seen += mPositive.counts[static_cast<std::size_t>(i - mPositive.first)];
+		if (seen >= rank) {
+			return resolve(1, i);
+		}
+	}
+	return mMax;
+}
+
+void QuantileSketch::clear() noexcept
+{
+	mPositive.clear();
+	mNegative.clear();
+	mZero = 0;
+	mCount = 0;
+}
+
+// ── MetricWindow ──────────────────────────────────────────────────────────────
+
+void MetricWindow::add(const MetricValue &value)
+{
+	if (!value.available()) {
+		return;
+	}
+	mLast = value;
+	const double v = toDouble(value);
+	if (std::isnan(v)) {
+		return;
+	}
+
+	if (mNumeric == 0) {
+		mMin = value;
+		mMax = value;
+		mKind = value.kind();
+		mPrecision = value.precision();
+	} else {
+		if (v < toDouble(mMin)) {
+			mMin = value;
+		}
+		if (v > toDouble(mMax)) {
+			mMax = value;
+		}
+		if (value.kind() == MetricValue::Kind::Real) {
+			mKind = MetricValue::Kind::Real;
+			mPrecision = std::max(mPrecision, value.precision());
+		}
+	}
+	mSum += v;
+	++mNumeric;
+	mSketch.add(v);
+}
+
+void MetricWindow::clear() noexcept
+{
+	mMin.reset();
+	mMax.reset();
+	mLast.reset();
+	mSum = 0.0;
+	mNumeric = 0;
+	mKind = MetricValue::Kind::NotAvailable;
+	mPrecision = -1;
+	mSketch.clear();
+}
+
+MetricValue MetricWindow::min() const
+{
+	return mNumeric == 0 ? MetricValue{} : mMin;
+}
+
+MetricValue MetricWindow::max() const
+{
+	return mNumeric == 0 ? MetricValue{} : mMax;
+}
+
+MetricValue MetricWindow::mean() const
+{
+	if (mNumeric == 0) {
+		return {};
+	}
+	const double avg = mSum / static_cast<double>(mNumeric);
+	return MetricValue::real(avg, mKind == MetricValue::Kind::Real ? mPrecision : INTEGER_MEAN_PRECISION);
+}
+
+/**
+ * @brief Percentile @p q of the window, e.g. 0.95, within the sketch's relative accuracy
+ *        and never outside [min, max]
+ */
+MetricValue MetricWindow::percentile(double q) const
+{
+	if (mNumeric == 0) {
+		return {};
+	}
+	return like(std::clamp(mSketch.quantile(q), toDouble(mMin), toDouble(mMax)));
+}
+
+MetricValue MetricWindow::like(double v) const
+{
+	switch (mKind) {
+	case MetricValue::Kind::Signed:
+		return MetricValue::integer(static_cast<int64_t>(std::llround(v)));
+	case MetricValue::Kind::Unsigned:
+		return MetricValue::integer(static_cast<uint64_t>(std::llround(std::max(v, 0.0))));
+	default:
+		return MetricValue::real(v, mPrecision);
+	}
+}
+
+// ── WindowAggregator ──────────────────────────────────────────────────────────
+
+/**
+ * @param fields The sampled fields; must outlive the aggregator
+ */
+WindowAggregator::WindowAggregator(std::span<const QueryMetric *const> fields)
+	: mSourceFields(fields.begin(), fields.end())
+{
+	// Reserved up front: mDerived refers into mNames, and mOutputFields into mDerived
+	mNames.reserve(mSourceFields.size() * STAT_COUNT);
+	mDerived.reserve(mSourceFields.size() * STAT_COUNT);
+	for (const QueryMetric *f : mSourceFields) {
+		for (const std::string_view suffix : STAT_SUFFIXES) {
+			const std::string &name = mNames.emplace_back(std::format("{}.{}", f->name, suffix));
+			QueryMetric derived = *f;
+			derived.name = name;
+			derived.aliases = {};
+			derived.getter = nullptr;
+			mDerived.push_back(derived);
+		}
+	}
+	for (const QueryMetric &f : mDerived) {
+		mOutputFields.push_back(&f);
+	}
+}
+
+void WindowAggregator::onBegin([[maybe_unused]] std::span<const QueryMetric *> fields)
+{
+	mPending = true;
+}
+
+void WindowAggregator::onBeginDevice(devInfo &dev)
+{
+	auto it = std::ranges::find_if(mDevices, [&](const DeviceWindows &d) { return d.info.index == dev.index; });
+	if (it == mDevices.end()) {
+		it = mDevices.emplace(mDevices.end());
+		it->windows.resize(mSourceFields.size());
+	}
+	it->info = dev; // Handles change when the device is re-enumerated
+	it->sampled = true;
+	mCurrent = &*it;
+	mField = 0;
+}
+
+void WindowAggregator::onMetric([[maybe_unused]] const QueryMetric &f, const MetricValue &val)
+{
+	if (mCurrent != nullptr && mField < mCurrent->windows.size()) {
+		mCurrent->windows[mField++].add(val);
+	}
+}
+
+void WindowAggregator::onEndDevice([[maybe_unused]] devInfo &dev)
+{
+	mCurrent = nullptr;
+}
+
+/** @brief Forgets devices that were not sampled in the window just written and clears the others */
+void WindowAggregator::reset()
+{
+	std::erase_if(mDevices, [](const DeviceWindows &d) { return !d.sampled; });
+	for (auto &entry : mDevices) {
+		entry.sampled = false;
+		for (auto &w : entry.windows) {
+			w.clear();
+		}
+	}
+	mCurrent = nullptr;
+	mPending = false;
+}
+
+} // namespace metrics
@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef METRIC_WINDOW_H
+#define METRIC_WINDOW_H
+
+#include "metrics_registry.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace metrics {
+
+/**
+ * @brief Streaming quantile estimator with bounded relative error
+ *
+ * Values are counted in logarithmic buckets whose bounds grow by a factor of
+ * (1 + a) / (1 - a), so every quantile is reported within a relative error of @c a of
+ * a value that was actually added. Memory depends on the range of the values, not on
+ * how many there are: about 700 buckets span 1 to 1e6 at the default 1 %.
+ * Quantiles falling in the bucket of the smallest or largest value report that value
+ * exactly, so a constant metric or a single spike is not blurred.
+ * clear() keeps the buckets allocated for the next window.
+ */
+class QuantileSketch
+{
+public:
+	explicit QuantileSketch(double relativeAccuracy = 0.01);
+
+	/** @brief Counts @p value; NaN is ignored */
+	void add(double value);
+
+	/**
+	 * @brief Nearest-rank estimate of quantile @p q, clamped to [0, 1]
+	 * @return NaN when nothing was added
+	 */
+	[[nodiscard]] double quantile(double q) const;
+
+	[[nodiscard]] uint64_t count() const noexcept { return mCount; }
+	void clear() noexcept;
+
+private:
+	/** Counts of consecutive bucket indices starting at @c first */
+	struct Buckets
+	{
+		std::vector<uint64_t> counts;
+		int32_t first{0};
+		int32_t lowest{0}; ///< Range of indices in use since the last clear(); empty when lowest > highest
+		int32_t highest{-1};
+
+		void add(int32_t index);
+		void clear() noexcept;
+	};
+
+	[[nodiscard]] int32_t bucketOf(double magnitude) const;
+	[[nodiscard]] double valueOf(int32_t bucket) const;
+	[[nodiscard]] std::pair<int, int32_t> bucketKey(double value) const;
+	[[nodiscard]] double resolve(int sign, int32_t bucket) const;
+
+	double mGamma;
+	double mInvLogGamma;
+	Buckets mPositive;
+	Buckets mNegative; ///< Indexed by magnitude
+	uint64_t mZero{0};
+	uint64_t mCount{0};
+	double mMin{0.0};
+	double mMax{0.0};
+};
+
+/**
+ * @brief Aggregates of one metric of one device over a window
+ *
+ * Numeric values contribute to min, max, mean and the percentile sketch; the last
+ * available value, numeric or text, is kept as is.
+ */
+class MetricWindow
+{
+public:
+	void add(const MetricValue &value);
+	void clear() noexcept;
+
+	[[nodiscard]] uint64_t count() const noexcept { return mNumeric; }
+	[[nodiscard]] MetricValue min() const;
+	[[nodiscard]] MetricValue max() const;
+	[[nodiscard]] MetricValue mean() const;
+	[[nodiscard]] MetricValue percentile(double q) const;
+	[[nodiscard]] const MetricValue &last() const noexcept { return mLast; }
+
+private:
+	/** @brief @p v rendered like the values added: integers stay integers */
+	[[nodiscard]] MetricValue like(double v) const;
+
+	MetricValue mMin;
+	MetricValue mMax;
+	MetricValue mLast;
+	double mSum{0.0};
+	uint64_t mNumeric{0};
+	MetricValue::Kind mKind{MetricValue::Kind::NotAvailable};
+	int mPrecision{-1};
+	QuantileSketch mSketch;
+};
+
+/**
+ * @brief MetricOutput that folds every sample into per-device windows and reports one
+ *        row per device when flushed
+ *
+ * Feed it through runMetricsWithCaches() at the sampling rate, then call flush() with
+ * the real output at the end of every window. The rows carry, for each sampled field
+ * @c f, the fields @c f.min, @c f.max, @c f.avg, @c f.p95 and @c f.last with the unit of
+ * @c f, so any MetricOutput lays them out like ordinary fields (see fields()).
+ * A device that disappears mid-window still gets its partial row; devices with no
+ * sample in a window get none.
+ */
+class WindowAggregator
+{
+public:
+	explicit WindowAggregator(std::span<const QueryMetric *const> fields);
+
+	WindowAggregator(const WindowAggregator &) = delete;
+	WindowAggregator &operator=(const WindowAggregator &) = delete;
+
+	/** @brief The fields of the aggregated rows */
+	[[nodiscard]] std::span<const QueryMetric *> fields() { return mOutputFields; }
+
+	/** @brief True when a sample was taken since the last flush() */
+	[[nodiscard]] bool pending() const noexcept { return mPending; }
+
+	void onBegin(std::span<const QueryMetric *> fields);
+	void onBeginDevice(devInfo &dev);
+	void onMetric(const QueryMetric &f, const MetricValue &val);
+	void onEndDevice(devInfo &dev);
+	void onEnd() {}
+
+	/** @brief Writes one row per device sampled in the window to @p output and starts a new window */
+	template <MetricOutput Output> void flush(Output &output)
+	{
+		output.onBegin(fields());
+		for (auto &entry : mDevices) {
+			if (!entry.sampled) {
+				continue;
+			}
+			output.onBeginDevice(entry.info);
+			for (std::size_t i = 0; i < entry.windows.size(); ++i) {
+				const MetricWindow &w = entry.windows[i];
+				output.onMetric(*mOutputFields[i * STAT_COUNT], w.min());
+				output.onMetric(*mOutputFields[i * STAT_COUNT + 1], w.max());
+				output.onMetric(*mOutputFields[i * STAT_COUNT + 2], w.mean());
+				output.onMetric(*mOutputFields[i * STAT_COUNT + 3], w.percentile(0.95));
+				output.onMetric(*mOutputFields[i * STAT_COUNT + 4], w.last());
+			}
+			output.onEndDevice(entry.info);
+		}
+		output.onEnd();
+		reset();
+	}
+
+private:
+	static constexpr std::size_t STAT_COUNT = 5;
+
+	struct DeviceWindows
+	{
+		devInfo info{};
+		bool sampled{false};
+		std::vector<MetricWindow> windows; ///< One per sampled field, in field order
+	};
+
+	void reset();
+
+	std::vector<const QueryMetric *> mSourceFields;
+	std::vector<std::string> mNames; ///< Backing storage of the names in mDerived
+	std::vector<QueryMetric> mDerived;
+	std::vector<const QueryMetric *> mOutputFields;
+	std::vector<DeviceWindows> mDevices;
+	DeviceWindows *mCurrent{nullptr};
+	std::size_t mField{0};
+	bool mPending{false};
+};
+
+} // namespace metrics
+
+#endif // METRIC_WINDOW_H
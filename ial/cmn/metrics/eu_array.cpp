@@ -15,7 +15,6 @@
 #include "metrics_registry.h"
 #include "ze_api.h"
 #include <array>
-#include <format>
 #include <span>
 
 namespace metrics::eu_array {
@@ -33,7 +32,7 @@ constexpr auto ACTIVE = QueryMetric{
 		if (!cache.euAvail || cache.euSample.scaleFactor == 0) {
 			return ZE_RESULT_ERROR_UNSUPPORTED_FEATURE;
 		}
-		out = std::format("{}", static_cast<double>(cache.euSample.euActive) /
+		out = MetricValue::real(static_cast<double>(cache.euSample.euActive) /
 									static_cast<double>(cache.euSample.scaleFactor));
 		return ZE_RESULT_SUCCESS;
 	}};
@@ -49,7 +48,7 @@ constexpr auto STALL = QueryMetric{
 		if (!cache.euAvail || cache.euSample.scaleFactor == 0) {
 			return ZE_RESULT_ERROR_UNSUPPORTED_FEATURE;
 		}
-		out = std::format("{}", static_cast<double>(cache.euSample.euStall) /
+		out = MetricValue::real(static_cast<double>(cache.euSample.euStall) /
 									static_cast<double>(cache.euSample.scaleFactor));
 		return ZE_RESULT_SUCCESS;
 	}};
@@ -65,8 +64,7 @@ constexpr auto IDLE = QueryMetric{
 		if (!cache.euAvail || cache.euSample.scaleFactor == 0) {
 			return ZE_RESULT_ERROR_UNSUPPORTED_FEATURE;
 		}
-		out = std::format("{}",
-						  static_cast<double>(cache.euSample.euIdle) / static_cast<double>(cache.euSample.scaleFactor));
+		out = MetricValue::real(static_cast<double>(cache.euSample.euIdle) / static_cast<double>(cache.euSample.scaleFactor));
 		return ZE_RESULT_SUCCESS;
 	}};
 
@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ * Fabric metrics: Xe Link receive/transmit bandwidth of the device and of each of its ports.
+ *
+ * Rates come from two batched reads of all port counters that populateMetricCacheEnd turns
+ * into per-port rates (fabric_telemetry::computeRates); the counters are only read when one
+ * of these metrics is selected. Per-port fields fabric.port<N>.rx/tx.throughput hold the rate
+ * of the N-th port, in the order the fabric HAL enumerates them (and topology --link-util
+ * lists them); ports past the last slot only count towards the totals.
+ * NOTE: MB/s is 10^6 bytes per second, as for the PCIe throughput metrics.
+ */
+
+#include "fabric_metrics.h"
+#include "device.h"
+#include "fabric_telemetry.h"
+#include "metrics_registry.h"
+#include "ze_api.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <utility>
+
+namespace metrics::fabric {
+
+namespace {
+
+using fabric_telemetry::PortRate;
+
+constexpr double BYTES_PER_MB = 1e6;
+
+/** Sum of one direction over all ports; unavailable unless every port has a rate. */
+ze_result_t total(MetricValue &out, const MetricCache &cache, std::optional<double> PortRate::*direction)
+{
+	if (!cache.fabricAvail || cache.fabricRates == nullptr || cache.fabricRates->empty()) {
+		return ZE_RESULT_ERROR_UNSUPPORTED_FEATURE;
+	}
+	double sum = 0;
+	for (const auto &port : *cache.fabricRates) {
+		if (!(port.*direction)) {
+			return ZE_RESULT_NOT_READY;
+		}
+		sum += *(port.*direction);
+	}
+	out = MetricValue::real(sum / BYTES_PER_MB, 2);
+	return ZE_RESULT_SUCCESS;
+}
+
+/** One direction of the @p Port-th port in MB/s; unsupported when the device has fewer ports. */
+template <std::size_t Port, std::optional<double> PortRate::*Direction>
+ze_result_t perPort(devInfo & /*d*/, MetricValue &out, const MetricCache &cache)
+{
+	if (!cache.fabricAvail || cache.fabricRates == nullptr || cache.fabricRates->size() <= Port) {
+		return ZE_RESULT_ERROR_UNSUPPORTED_FEATURE;
+	}
+	const auto &rate = (*cache.fabricRates)[Port].*Direction;
+	if (!rate) {
+		return ZE_RESULT_NOT_READY;
+	}
+	out = MetricValue::real(*rate / BYTES_PER_MB, 2);
+	return ZE_RESULT_SUCCESS;
+}
+
+/** Per-port slots; 16 covers the Xe Link ports of a two-tile device. */
+constexpr std::size_t PORT_SLOTS = 16;
+
+/** Storage for "fabric.port<N>.<direction>.throughput", built at compile time. */
+template <std::size_t Port, bool Rx> struct PortName
+{
+	static constexpr auto STORAGE = [] {
+		constexpr std::string_view prefix{"fabric.port"};
+		constexpr std::string_view suffix{Rx ? ".rx.throughput" : ".tx.throughput"};
+		std::array<char, 32> buf{};
+		std::size_t len = 0;
+		for (const char c : prefix) {
+			buf[len++] = c;
+		}
+		if (Port >= 10) {
+			buf[len++] = static_cast<char>('0' + Port / 10);
+		}
+		buf[len++] = static_cast<char>('0' + Port % 10);
+		for (const char c : suffix) {
+			buf[len++] = c;
+		}
+		return std::pair{buf, len};
+	}();
+	static constexpr std::string_view VALUE{STORAGE.first.data(), STORAGE.second};
+};
+
+template <std::size_t Port, bool Rx> constexpr QueryMetric portThroughput()
+{
+	return QueryMetric{.name = PortName<Port, Rx>::VALUE,
+					   .unit = "MB/s",
+					   .description = Rx ? "Fabric receive throughput of one port; fabric.port<N> is the device's N-th port, from 0"
+										 : "Fabric transmit throughput of one port; fabric.port<N> is the device's N-th port, from 0",
+					   .source = MetricSource::Live,
+					   .groups = MetricGroup::FABRIC,
+					   .getter = perPort<Port, Rx ? &PortRate::rxBytesPerSec : &PortRate::txBytesPerSec>};
+}
+
+/** Receive and transmit slot of every port, port by port. */
+template <std::size_t... Ports> constexpr auto portThroughputs(std::index_sequence<Ports...> /*ports*/)
+{
+	std::array<QueryMetric, 2 * sizeof...(Ports)> slots{};
+	std::size_t i = 0;
+	((slots[i++] = portThroughput<Ports, true>(), slots[i++] = portThroughput<Ports, false>()), ...);
+	return slots;
+}
+
+constexpr auto RX_THROUGHPUT =
+	QueryMetric{// NOLINT(readability-identifier-naming)
+				.name = "fabric.rx.throughput",
+				.unit = "MB/s",
+				.description = "Fabric receive throughput, all ports",
+				.source = MetricSource::Live,
+				.groups = MetricGroup::FABRIC,
+				.getter = [](devInfo & /*d*/, MetricValue &out, const MetricCache &cache) -> ze_result_t {
+					return total(out, cache, &PortRate::rxBytesPerSec);
+				}};
+
+constexpr auto TX_THROUGHPUT =
+	QueryMetric{// NOLINT(readability-identifier-naming)
+				.name = "fabric.tx.throughput",
+				.unit = "MB/s",
+				.description = "Fabric transmit throughput, all ports",
+				.source = MetricSource::Live,
+				.groups = MetricGroup::FABRIC,
+				.getter = [](devInfo & /*d*/, MetricValue &out, const MetricCache &cache) -> ze_result_t {
+					return total(out, cache, &PortRate::txBytesPerSec);
+				}};
+
+constexpr auto LINK_UTILIZATION =
+	QueryMetric{// NOLINT(readability-identifier-naming)
+				.name = "fabric.link.utilization",
+				.unit = "%",
+				.description = "Receive or transmit bandwidth of the busiest fabric port, as a percentage of its "
+							   "maximum speed",
+				.source = MetricSource::Live,
+				.groups = MetricGroup::FABRIC,
+				.getter = [](devInfo & /*d*/, MetricValue &out, const MetricCache &cache) -> ze_result_t {
+					if (!cache.fabricAvail || cache.fabricRates == nullptr || cache.fabricRates->empty()) {
+						return ZE_RESULT_ERROR_UNSUPPORTED_FEATURE;
+					}
+					std::optional<double> busiest;
+					bool knownSpeed = false;
+					for (const auto &port : *cache.fabricRates) {
+						knownSpeed = knownSpeed || port.rxCapacity != 0 || port.txCapacity != 0;
+						for (const auto pct : {port.rxUtilization(), port.txUtilization()}) {
+							if (pct && (!busiest || *pct > *busiest)) {
+								busiest = pct;
+							}
+						}
+					}
+					// Without a maximum speed no window will ever yield a percentage
+					if (!knownSpeed) {
+						return ZE_RESULT_ERROR_UNSUPPORTED_FEATURE;
+					}
+					if (!busiest) {
+						return ZE_RESULT_NOT_READY;
+					}
+					out = MetricValue::real(*busiest, 2);
+					return ZE_RESULT_SUCCESS;
+				}};
+
+constexpr auto TOTALS = std::to_array<QueryMetric>({RX_THROUGHPUT, TX_THROUGHPUT, LINK_UTILIZATION});
+constexpr auto PORTS = portThroughputs(std::make_index_sequence<PORT_SLOTS>{});
+
+constexpr auto ALL = [] {
+	std::array<QueryMetric, TOTALS.size() + PORTS.size()> all{};
+	std::ranges::copy(TOTALS, all.begin());
+	std::ranges::copy(PORTS, all.begin() + TOTALS.size());
+	return all;
+}();
+
+} // namespace
+
+std::span<const QueryMetric> getFabricMetrics() noexcept { return ALL; }
+
+} // namespace metrics::fabric
@@ -0,0 +1,17 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ * Fabric metrics: Xe Link receive/transmit bandwidth of the device and of each of its ports.
+ */
+
+#pragma once
+
+#include "metrics_registry.h"
+#include <span>
+
+namespace metrics::fabric {
+
+[[nodiscard]] std::span<const QueryMetric> getFabricMetrics() noexcept;
+
+} // namespace metrics::fabric
@@ -33,7 +33,7 @@ constexpr auto speed = QueryMetric{// NOLINT(readability-identifier-naming)
 									   int32_t pct = 0;
 									   auto const r = f->getSpeedPercent(pct);
 									   if (r == ZE_RESULT_SUCCESS) {
-										   out = std::to_string(pct);
+										   out = MetricValue::integer(pct);
 									   }
 									   return r;
 								   }};
@@ -70,7 +70,7 @@ inline std::span<const QueryMetric> getIdentityMetrics() noexcept
 			.source = MetricSource::Static,
 			.groups = MetricGroup::IDENTITY,
 			.getter = [](devInfo &d, MetricValue &out, const MetricCache &) -> ze_result_t {
-				out = std::format("{}", d.index);
+				out = MetricValue::integer(d.index);
 				return ZE_RESULT_SUCCESS;
 			},
 		},
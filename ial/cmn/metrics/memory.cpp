@@ -6,13 +6,13 @@
  */
 
 #include "memory.h"
+#include "counter_delta.h"
 #include "device.h"
 #include "metrics_registry.h"
 #include "ze_api.h"
 #include <cstdint>
 #include <memory.h>
 #include <array>
-#include <format>
 #include <span>
 #include <string>
 
@@ -20,6 +20,13 @@ namespace metrics::memory {
 
 namespace {
 
+/** @brief counterRate() of one memory byte counter of @p cache, in bytes/s */
+[[nodiscard]] CounterRate memRate(const MetricCache &cache, uint64_t MemSnapshot::*counter)
+{
+	return counterRate({cache.memBefore.*counter, cache.memBefore.ts, cache.hostNsBefore},
+					   {cache.memAfter.*counter, cache.memAfter.ts, cache.hostNsAfter});
+}
+
 constexpr auto total = QueryMetric{// NOLINT(readability-identifier-naming)
 								   .name = "memory.total",
 								   .unit = "MiB",
@@ -34,7 +41,7 @@ constexpr auto total = QueryMetric{// NOLINT(readability-identifier-naming)
 									   auto size = uint64_t{0};
 									   auto const r = mem->getMemorySize(&size);
 									   if (r == ZE_RESULT_SUCCESS) {
-										   out = std::format("{}", static_cast<double>(size) / (1024.0 * 1024.0));
+										   out = MetricValue::real(static_cast<double>(size) / (1024.0 * 1024.0));
 									   }
 									   return r;
 								   }};
@@ -53,7 +60,7 @@ constexpr auto used = QueryMetric{// NOLINT(readability-identifier-naming)
 									  auto usedBytes = uint64_t{0};
 									  auto const r = mem->getMemoryUsed(&usedBytes, nullptr);
 									  if (r == ZE_RESULT_SUCCESS) {
-										  out = std::format("{}", static_cast<double>(usedBytes) / (1024.0 * 1024.0));
+										  out = MetricValue::real(static_cast<double>(usedBytes) / (1024.0 * 1024.0));
 									  }
 									  return r;
 								  }};
@@ -81,7 +88,7 @@ constexpr auto FREE =
 						return r;
 					}
 					const auto freeBytes = static_cast<int64_t>(totalBytes) - static_cast<int64_t>(usedBytes);
-					out = std::format("{}", static_cast<double>(freeBytes > 0 ? freeBytes : 0) / (1024.0 * 1024.0));
+					out = MetricValue::real(static_cast<double>(freeBytes > 0 ? freeBytes : 0) / (1024.0 * 1024.0));
 					return ZE_RESULT_SUCCESS;
 				}};
 
@@ -93,13 +100,12 @@ constexpr auto READ_BANDWIDTH =
 				.source = MetricSource::Live,
 				.groups = MetricGroup::MEMORY,
 				.getter = [](devInfo & /*d*/, MetricValue &out, const MetricCache &cache) -> ze_result_t {
-					if (!cache.memAvail || cache.memAfter.ts <= cache.memBefore.ts) {
-						out = "N/A";
+					const CounterRate r = memRate(cache, &MemSnapshot::read);
+					if (!cache.memAvail || !r.ok()) {
+						out.reset();
 						return ZE_RESULT_SUCCESS;
 					}
-					const auto dt = static_cast<double>(cache.memAfter.ts - cache.memBefore.ts);
-					const auto rd = static_cast<double>(cache.memAfter.read - cache.memBefore.read);
-					out = std::format("{}", 1000000.0 * rd / dt / 1024.0);
+					out = MetricValue::real(r.rate / 1024.0);
 					return ZE_RESULT_SUCCESS;
 				}};
 
@@ -111,13 +117,12 @@ constexpr auto WRITE_BANDWIDTH =
 				.source = MetricSource::Live,
 				.groups = MetricGroup::MEMORY,
 				.getter = [](devInfo & /*d*/, MetricValue &out, const MetricCache &cache) -> ze_result_t {
-					if (!cache.memAvail || cache.memAfter.ts <= cache.memBefore.ts) {
-						out = "N/A";
+					const CounterRate r = memRate(cache, &MemSnapshot::write);
+					if (!cache.memAvail || !r.ok()) {
+						out.reset();
 						return ZE_RESULT_SUCCESS;
 					}
-					const auto dt = static_cast<double>(cache.memAfter.ts - cache.memBefore.ts);
-					const auto wr = static_cast<double>(cache.memAfter.write - cache.memBefore.write);
-					out = std::format("{}", 1000000.0 * wr / dt / 1024.0);
+					out = MetricValue::real(r.rate / 1024.0);
 					return ZE_RESULT_SUCCESS;
 				}};
 
@@ -129,14 +134,13 @@ constexpr auto BANDWIDTH_UTILIZATION = QueryMetric{
 	.source = MetricSource::Live,
 	.groups = MetricGroup::MEMORY,
 	.getter = [](devInfo & /*d*/, MetricValue &out, const MetricCache &cache) -> ze_result_t {
-		if (!cache.memAvail || cache.memAfter.ts <= cache.memBefore.ts || cache.memMaxBandwidth == 0) {
-			out = "N/A";
+		const CounterRate rd = memRate(cache, &MemSnapshot::read);
+		const CounterRate wr = memRate(cache, &MemSnapshot::write);
+		if (!cache.memAvail || !rd.ok() || !wr.ok() || cache.memMaxBandwidth == 0) {
+			out.reset();
 			return ZE_RESULT_SUCCESS;
 		}
-		const auto dt = static_cast<double>(cache.memAfter.ts - cache.memBefore.ts);
-		const auto deltaBytes = static_cast<double>(cache.memAfter.read + cache.memAfter.write) -
-								static_cast<double>(cache.memBefore.read + cache.memBefore.write);
-		out = std::format("{}", 100.0 * deltaBytes * 1.0e6 / dt / static_cast<double>(cache.memMaxBandwidth));
+		out = MetricValue::real(100.0 * (rd.rate + wr.rate) / static_cast<double>(cache.memMaxBandwidth));
 		return ZE_RESULT_SUCCESS;
 	}};
 
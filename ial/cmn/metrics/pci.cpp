@@ -7,6 +7,7 @@
  */
 
 #include "pci.h"
+#include "counter_delta.h"
 #include "device.h"
 #include "metrics_registry.h"
 #include "ze_api.h"
@@ -14,7 +15,6 @@
 #include <cstdint>
 #include <pci.h>
 #include <array>
-#include <format>
 #include <span>
 #include <string>
 
@@ -22,6 +22,13 @@ namespace metrics::pci {
 
 namespace {
 
+/** @brief counterRate() of one PCIe byte counter of @p cache, in bytes/s */
+[[nodiscard]] CounterRate pcieRate(const MetricCache &cache, uint64_t PcieSnapshot::*counter)
+{
+	return counterRate({cache.pcieBefore.*counter, cache.pcieBefore.timeUs, cache.hostNsBefore},
+					   {cache.pcieAfter.*counter, cache.pcieAfter.timeUs, cache.hostNsAfter});
+}
+
 constexpr auto LINK_GEN_MAX =
 	QueryMetric{// NOLINT(readability-identifier-naming)
 				.name = "pcie.link.gen.max",
@@ -37,7 +44,7 @@ constexpr auto LINK_GEN_MAX =
 					zes_pci_properties_t props{};
 					auto const r = p->getProperties(d.zesDeviceHdl, &props);
 					if (r == ZE_RESULT_SUCCESS) {
-						out = std::format("{}", props.maxSpeed.gen);
+						out = MetricValue::integer(props.maxSpeed.gen);
 					}
 					return r;
 				}};
@@ -57,7 +64,7 @@ constexpr auto LINK_WIDTH_MAX =
 					zes_pci_properties_t props{};
 					auto const r = p->getProperties(d.zesDeviceHdl, &props);
 					if (r == ZE_RESULT_SUCCESS) {
-						out = std::format("{}", props.maxSpeed.width);
+						out = MetricValue::integer(props.maxSpeed.width);
 					}
 					return r;
 				}};
@@ -77,7 +84,7 @@ constexpr auto LINK_GEN_CURRENT =
 					zes_pci_speed_t speed{};
 					auto const r = p->getCurrentLinkSpeed(d.zesDeviceHdl, speed);
 					if (r == ZE_RESULT_SUCCESS) {
-						out = std::format("{}", speed.gen);
+						out = MetricValue::integer(speed.gen);
 					}
 					return r;
 				}};
@@ -97,7 +104,7 @@ constexpr auto LINK_WIDTH_CURRENT =
 					zes_pci_speed_t speed{};
 					auto const r = p->getCurrentLinkSpeed(d.zesDeviceHdl, speed);
 					if (r == ZE_RESULT_SUCCESS) {
-						out = std::format("{}", speed.width);
+						out = MetricValue::integer(speed.width);
 					}
 					return r;
 				}};
@@ -113,9 +120,12 @@ constexpr auto TX_THROUGHPUT =
 					if (!cache.pcieAvail || !cache.pcieBandwidthAvail) {
 						return ZE_RESULT_NOT_READY;
 					}
-					const auto dt = static_cast<double>(cache.pcieAfter.timeUs - cache.pcieBefore.timeUs);
-					const auto tx = static_cast<double>(cache.pcieAfter.tx - cache.pcieBefore.tx);
-					out = std::format("{}", tx / dt);
+					const CounterRate r = pcieRate(cache, &PcieSnapshot::tx);
+					if (!r.ok()) {
+						out.reset(); // Counter reset within the window
+						return ZE_RESULT_SUCCESS;
+					}
+					out = MetricValue::real(r.rate / 1e6);
 					return ZE_RESULT_SUCCESS;
 				}};
 
@@ -130,9 +140,12 @@ constexpr auto RX_THROUGHPUT =
 					if (!cache.pcieAvail || !cache.pcieBandwidthAvail) {
 						return ZE_RESULT_NOT_READY;
 					}
-					const auto dt = static_cast<double>(cache.pcieAfter.timeUs - cache.pcieBefore.timeUs);
-					const auto rx = static_cast<double>(cache.pcieAfter.rx - cache.pcieBefore.rx);
-					out = std::format("{}", rx / dt);
+					const CounterRate r = pcieRate(cache, &PcieSnapshot::rx);
+					if (!r.ok()) {
+						out.reset(); // Counter reset within the window
+						return ZE_RESULT_SUCCESS;
+					}
+					out = MetricValue::real(r.rate / 1e6);
 					return ZE_RESULT_SUCCESS;
 				}};
 
@@ -147,7 +160,7 @@ constexpr auto REPLAY_COUNTER =
 					if (!cache.pcieAvail || !cache.pcieReplayAvail) {
 						return ZE_RESULT_NOT_READY;
 					}
-					out = std::format("{}", cache.pcieReplay);
+					out = MetricValue::integer(cache.pcieReplay);
 					return ZE_RESULT_SUCCESS;
 				}};
 
@@ -162,9 +175,12 @@ constexpr auto RX_THROUGHPUT_KBS =
 					if (!cache.pcieAvail || !cache.pcieBandwidthAvail) {
 						return ZE_RESULT_NOT_READY;
 					}
-					const uint64_t dt = cache.pcieAfter.timeUs - cache.pcieBefore.timeUs;
-					const uint64_t rx = cache.pcieAfter.rx - cache.pcieBefore.rx;
-					out = std::format("{}", 1000000ULL * rx / dt / 1000ULL);
+					const CounterRate r = pcieRate(cache, &PcieSnapshot::rx);
+					if (!r.ok()) {
+						out.reset(); // Counter reset within the window
+						return ZE_RESULT_SUCCESS;
+					}
+					out = MetricValue::integer(static_cast<uint64_t>(r.rate / 1000.0));
 					return ZE_RESULT_SUCCESS;
 				}};
 
@@ -179,9 +195,12 @@ constexpr auto TX_THROUGHPUT_KBS =
 					if (!cache.pcieAvail || !cache.pcieBandwidthAvail) {
 						return ZE_RESULT_NOT_READY;
 					}
-					const uint64_t dt = cache.pcieAfter.timeUs - cache.pcieBefore.timeUs;
-					const uint64_t tx = cache.pcieAfter.tx - cache.pcieBefore.tx;
-					out = std::format("{}", 1000000ULL * tx / dt / 1000ULL);
+					const CounterRate r = pcieRate(cache, &PcieSnapshot::tx);
+					if (!r.ok()) {
+						out.reset(); // Counter reset within the window
+						return ZE_RESULT_SUCCESS;
+					}
+					out = MetricValue::integer(static_cast<uint64_t>(r.rate / 1000.0));
 					return ZE_RESULT_SUCCESS;
 				}};
 
@@ -8,6 +8,7 @@
  */
 
 #include "power.h"
+#include "counter_delta.h"
 #include "device.h"
 #include "metrics_registry.h"
 #include "ze_api.h"
@@ -15,7 +16,6 @@
 #include <algorithm>
 #include <array>
 #include <cstdint>
-#include <format>
 #include <power.h>
 #include <ranges>
 #include <span>
@@ -27,27 +27,33 @@ namespace metrics::power {
 namespace {
 
 /**
- * @brief Computes instantaneous power draw in watts from a pair of energy snapshots.
+ * @brief Writes the average power draw between a pair of energy snapshots to @p out
  *
- * Calculates the average power delivered over the interval [before, after] by dividing
- * the energy delta (µJ) by the time delta (µs), yielding a dimensionless ratio in watts.
+ * The energy counter (µJ) and its timestamp (µs) go through counterRate(), so a wrapped
+ * counter still yields the energy actually consumed.
  *
- * @param[in] before Energy snapshot taken at the start of the sampling interval.
- * @param[in] after  Energy snapshot taken at the end of the sampling interval.
- *
- * @return Power draw in watts as a @c double.
- *
- * @pre @p after.ts > @p before.ts — time must have advanced; callers are responsible
- *      for verifying this before calling to avoid division by zero.
- * @pre @p after.energy >= @p before.energy — the energy counter must not have
- *      regressed; callers must verify this to avoid unsigned underflow in the subtraction.
- *
- * @note This function is @c constexpr and @c noexcept; it performs no memory allocation
- *       and cannot throw exceptions.
+ * @retval ZE_RESULT_SUCCESS                   @p out holds the draw in watts, or N/A when
+ *                                             the timestamp did not advance or the energy
+ *                                             counter was reset within the window.
+ * @retval ZE_RESULT_ERROR_UNSUPPORTED_FEATURE A snapshot is missing or the timestamp went
+ *                                             backwards.
  */
-[[nodiscard]] constexpr double powerDrawWatts(const EnergySnapshot &before, const EnergySnapshot &after) noexcept
+ze_result_t powerDrawWatts(const EnergySnapshot &before, const EnergySnapshot &after, const MetricCache &cache,
+						   MetricValue &out)
 {
-	return static_cast<double>(after.energy - before.energy) / static_cast<double>(after.ts - before.ts);
+	const CounterRate r = counterRate({before.energy, before.ts, cache.hostNsBefore},
+									  {after.energy, after.ts, cache.hostNsAfter});
+	switch (r.status) {
+	case DeltaStatus::Ok:
+		out = MetricValue::real(r.rate / 1'000'000.0, 2);
+		return ZE_RESULT_SUCCESS;
+	case DeltaStatus::Stalled:
+	case DeltaStatus::CounterReset:
+		out.reset();
+		return ZE_RESULT_SUCCESS;
+	default:
+		return ZE_RESULT_ERROR_UNSUPPORTED_FEATURE;
+	}
 }
 
 /**
@@ -100,7 +106,7 @@ ze_result_t getBestLimitW(devInfo &d, MetricValue &out)
 	if (it == std::ranges::end(valid)) {
 		return ZE_RESULT_ERROR_UNSUPPORTED_FEATURE;
 	}
-	out = std::format("{:.2f}", static_cast<double>(it->limitMw) / 1000.0);
+	out = MetricValue::real(static_cast<double>(it->limitMw) / 1000.0, 2);
 	return ZE_RESULT_SUCCESS;
 }
 
@@ -150,7 +156,7 @@ ze_result_t getMaxLimitW(devInfo &d, MetricValue &out)
 		extProps.stype = ZES_STRUCTURE_TYPE_POWER_EXT_PROPERTIES;
 		if (pw->getProperties(handles[i], &props, &extProps) == ZE_RESULT_SUCCESS && (props.onSubdevice == 0U) &&
 			props.maxLimit > 0) {
-			out = std::format("{:.2f}", static_cast<double>(props.maxLimit) / 1000.0);
+			out = MetricValue::real(static_cast<double>(props.maxLimit) / 1000.0, 2);
 			return ZE_RESULT_SUCCESS;
 		}
 	}
@@ -166,19 +172,7 @@ constexpr auto CARD_DRAW =
 				.source = MetricSource::Live,
 				.groups = MetricGroup::POWER,
 				.getter = [](devInfo & /*d*/, MetricValue &out, const MetricCache &cache) -> ze_result_t {
-					if (cache.cardPowerBefore.ts == 0 || cache.cardPowerAfter.ts < cache.cardPowerBefore.ts) {
-						return ZE_RESULT_ERROR_UNSUPPORTED_FEATURE;
-					}
-					if (cache.cardPowerAfter.ts == cache.cardPowerBefore.ts) {
-						out = "N/A";
-						return ZE_RESULT_SUCCESS;
-					}
-					if (cache.cardPowerAfter.energy < cache.cardPowerBefore.energy) {
-						out = "N/A";
-						return ZE_RESULT_SUCCESS;
-					}
-					out = std::format("{:.2f}", powerDrawWatts(cache.cardPowerBefore, cache.cardPowerAfter));
-					return ZE_RESULT_SUCCESS;
+					return powerDrawWatts(cache.cardPowerBefore, cache.cardPowerAfter, cache, out);
 				}};
 
 constexpr auto CARD_DRAW_GPU =
@@ -190,19 +184,7 @@ constexpr auto CARD_DRAW_GPU =
 				.source = MetricSource::Live,
 				.groups = MetricGroup::POWER,
 				.getter = [](devInfo & /*d*/, MetricValue &out, const MetricCache &cache) -> ze_result_t {
-					if (cache.gpuPowerBefore.ts == 0 || cache.gpuPowerAfter.ts < cache.gpuPowerBefore.ts) {
-						return ZE_RESULT_ERROR_UNSUPPORTED_FEATURE;
-					}
-					if (cache.gpuPowerAfter.ts == cache.gpuPowerBefore.ts) {
-						out = "N/A";
-						return ZE_RESULT_SUCCESS;
-					}
-					if (cache.gpuPowerAfter.energy < cache.gpuPowerBefore.energy) {
-						out = "N/A";
-						return ZE_RESULT_SUCCESS;
-					}
-					out = std::format("{:.2f}", powerDrawWatts(cache.gpuPowerBefore, cache.gpuPowerAfter));
-					return ZE_RESULT_SUCCESS;
+					return powerDrawWatts(cache.gpuPowerBefore, cache.gpuPowerAfter, cache, out);
 				}};
 
 constexpr auto ENERGY_CONSUMED =
@@ -217,7 +199,7 @@ constexpr auto ENERGY_CONSUMED =
 					if (cache.gpuPowerAfter.ts == 0) {
 						return ZE_RESULT_ERROR_UNSUPPORTED_FEATURE;
 					}
-					out = std::format("{:.2f}", static_cast<double>(cache.gpuPowerAfter.energy) / 1'000'000.0);
+					out = MetricValue::real(static_cast<double>(cache.gpuPowerAfter.energy) / 1'000'000.0, 2);
 					return ZE_RESULT_SUCCESS;
 				}};
 
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ * Process metrics: DRM client processes of the device and the busiest of them.
+ *
+ * Values come from the per-process engine utilization that populateMetricCacheEnd derives
+ * from two /proc/<pid>/fdinfo snapshots; they are only sampled when one of these metrics
+ * is selected, and are unavailable on Windows.
+ */
+
+#include "process.h"
+#include "device.h"
+#include "metrics_registry.h"
+#include "ze_api.h"
+#include <array>
+#include <span>
+
+namespace metrics::process {
+
+namespace {
+
+/** The process with the highest busy percentage on any engine class, or null when none was measured. */
+[[nodiscard]] const ProcessEngineUtilization *busiest(const MetricCache &cache)
+{
+	const ProcessEngineUtilization *top = nullptr;
+	double topPercent = -1.0;
+	for (const auto &p : cache.processes) {
+		const auto pct = p.maxPercent();
+		if (pct.has_value() && *pct > topPercent) {
+			top = &p;
+			topPercent = *pct;
+		}
+	}
+	return top;
+}
+
+constexpr auto COUNT =
+	QueryMetric{// NOLINT(readability-identifier-naming)
+				.name = "process.count",
+				.unit = "",
+				.description = "Number of processes with an open DRM client on the device",
+				.source = MetricSource::Live,
+				.groups = MetricGroup::PROCESS,
+				.getter = [](devInfo & /*d*/, MetricValue &out, const MetricCache &cache) -> ze_result_t {
+					if (!cache.processAvail) {
+						return ZE_RESULT_ERROR_UNSUPPORTED_FEATURE;
+					}
+					out = MetricValue::integer(cache.processes.size());
+					return ZE_RESULT_SUCCESS;
+				}};
+
+constexpr auto TOP_PID =
+	QueryMetric{// NOLINT(readability-identifier-naming)
+				.name = "process.top.pid",
+				.unit = "",
+				.description = "PID of the process keeping an engine class of the device busiest",
+				.source = MetricSource::Live,
+				.groups = MetricGroup::PROCESS,
+				.getter = [](devInfo & /*d*/, MetricValue &out, const MetricCache &cache) -> ze_result_t {
+					const auto *top = cache.processAvail ? busiest(cache) : nullptr;
+					if (top == nullptr) {
+						return ZE_RESULT_ERROR_NOT_AVAILABLE;
+					}
+					out = MetricValue::integer(top->pid);
+					return ZE_RESULT_SUCCESS;
+				}};
+
+constexpr auto TOP_UTIL =
+	QueryMetric{// NOLINT(readability-identifier-naming)
+				.name = "process.top.utilization",
+				.unit = "%",
+				.description = "Busy time of the busiest engine class used by process.top.pid, as a fraction of "
+							   "elapsed time and of the engines in that class",
+				.source = MetricSource::Live,
+				.groups = MetricGroup::PROCESS,
+				.getter = [](devInfo & /*d*/, MetricValue &out, const MetricCache &cache) -> ze_result_t {
+					const auto *top = cache.processAvail ? busiest(cache) : nullptr;
+					if (top == nullptr) {
+						return ZE_RESULT_ERROR_NOT_AVAILABLE;
+					}
+					out = MetricValue::real(top->maxPercent().value_or(0.0), 2);
+					return ZE_RESULT_SUCCESS;
+				}};
+
+constexpr auto ALL = std::to_array<QueryMetric>({COUNT, TOP_PID, TOP_UTIL});
+
+} // namespace
+
+std::span<const QueryMetric> getProcessMetrics() noexcept { return ALL; }
+
+} // namespace metrics::process
@@ -0,0 +1,17 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ * Process metrics: DRM client processes of the device and the busiest of them.
+ */
+
+#pragma once
+
+#include "metrics_registry.h"
+#include <span>
+
+namespace metrics::process {
+
+[[nodiscard]] std::span<const QueryMetric> getProcessMetrics() noexcept;
+
+} // namespace metrics::process
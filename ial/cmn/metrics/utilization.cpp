@@ -12,13 +12,13 @@
  */
 
 #include "utilization.h"
+#include "counter_delta.h"
 #include "debug.h"
 #include "device.h"
 #include "metrics_registry.h"
 #include "ze_api.h"
 #include <memory.h>
 #include <array>
-#include <format>
 #include <span>
 #include <string>
 #include <string_view>
@@ -27,16 +27,29 @@ namespace metrics::utilization {
 
 namespace {
 
-// Precondition: callers must verify s.before.ts != 0 && s.after.ts > s.before.ts
-// before calling this function.
-[[nodiscard]] double utilFromCache(const EngineSample &s)
+/**
+ * @brief Writes the active time of an engine group over the window as a % to @p out
+ *
+ * Active time and timestamp are both in µs, so the counterRate() of active time in µs/s
+ * scaled by 1e-4 is the percentage. A window whose timestamps did not advance has no
+ * utilization (unsupported, as before the first full window); an active-time counter
+ * reset within the window reports N/A.
+ */
+ze_result_t utilFromCache(const EngineSample &s, const MetricCache &cache, MetricValue &out)
 {
-	if (s.after.active < s.before.active) {
-		DBG("utilization: engine counter regression (active {} -> {}), reporting 0\n", s.before.active, s.after.active);
-		return 0.0;
+	const CounterRate r = counterRate({s.before.active, s.before.ts, cache.hostNsBefore},
+									  {s.after.active, s.after.ts, cache.hostNsAfter});
+	switch (r.status) {
+	case DeltaStatus::Ok:
+		out = MetricValue::real(r.rate * 1e-4, 2);
+		return ZE_RESULT_SUCCESS;
+	case DeltaStatus::CounterReset:
+		DBG("utilization: engine counter reset (active {} -> {}), reporting N/A\n", s.before.active, s.after.active);
+		out.reset();
+		return ZE_RESULT_SUCCESS;
+	default:
+		return ZE_RESULT_ERROR_UNSUPPORTED_FEATURE;
 	}
-	return (static_cast<double>(s.after.active) - static_cast<double>(s.before.active)) * 100.0 /
-		   (static_cast<double>(s.after.ts) - static_cast<double>(s.before.ts));
 }
 
 // ── Alias name arrays ─────────────────────────────────────────────────────────
@@ -69,12 +82,7 @@ constexpr auto GPU =
 				.source = MetricSource::Live,
 				.groups = MetricGroup::UTILIZATION,
 				.getter = [](devInfo & /*d*/, MetricValue &out, const MetricCache &cache) -> ze_result_t {
-					const auto &s = cache.engines.all;
-					if (s.before.ts == 0 || s.after.ts <= s.before.ts) {
-						return ZE_RESULT_ERROR_UNSUPPORTED_FEATURE;
-					}
-					out = std::format("{:.2f}", utilFromCache(s));
-					return ZE_RESULT_SUCCESS;
+					return utilFromCache(cache.engines.all, cache, out);
 				}};
 
 constexpr auto COMPUTE =
@@ -87,12 +95,7 @@ constexpr auto COMPUTE =
 				.source = MetricSource::Live,
 				.groups = MetricGroup::UTILIZATION,
 				.getter = [](devInfo & /*d*/, MetricValue &out, const MetricCache &cache) -> ze_result_t {
-					const auto &s = cache.engines.compute;
-					if (s.before.ts == 0 || s.after.ts <= s.before.ts) {
-						return ZE_RESULT_ERROR_UNSUPPORTED_FEATURE;
-					}
-					out = std::format("{:.2f}", utilFromCache(s));
-					return ZE_RESULT_SUCCESS;
+					return utilFromCache(cache.engines.compute, cache, out);
 				}};
 
 constexpr auto RENDER =
@@ -105,12 +108,7 @@ constexpr auto RENDER =
 				.source = MetricSource::Live,
 				.groups = MetricGroup::UTILIZATION,
 				.getter = [](devInfo & /*d*/, MetricValue &out, const MetricCache &cache) -> ze_result_t {
-					const auto &s = cache.engines.render;
-					if (s.before.ts == 0 || s.after.ts <= s.before.ts) {
-						return ZE_RESULT_ERROR_UNSUPPORTED_FEATURE;
-					}
-					out = std::format("{:.2f}", utilFromCache(s));
-					return ZE_RESULT_SUCCESS;
+					return utilFromCache(cache.engines.render, cache, out);
 				}};
 
 constexpr auto MEDIA = QueryMetric{
@@ -123,12 +121,7 @@ constexpr auto MEDIA = QueryMetric{
 	.source = MetricSource::Live,
 	.groups = MetricGroup::UTILIZATION,
 	.getter = [](devInfo & /*d*/, MetricValue &out, const MetricCache &cache) -> ze_result_t {
-		const auto &s = cache.engines.media;
-		if (s.before.ts == 0 || s.after.ts <= s.before.ts) {
-			return ZE_RESULT_ERROR_UNSUPPORTED_FEATURE;
-		}
-		out = std::format("{:.2f}", utilFromCache(s));
-		return ZE_RESULT_SUCCESS;
+		return utilFromCache(cache.engines.media, cache, out);
 	}};
 
 constexpr auto COPY =
@@ -141,12 +134,7 @@ constexpr auto COPY =
 				.source = MetricSource::Live,
 				.groups = MetricGroup::UTILIZATION,
 				.getter = [](devInfo & /*d*/, MetricValue &out, const MetricCache &cache) -> ze_result_t {
-					const auto &s = cache.engines.copy;
-					if (s.before.ts == 0 || s.after.ts <= s.before.ts) {
-						return ZE_RESULT_ERROR_UNSUPPORTED_FEATURE;
-					}
-					out = std::format("{:.2f}", utilFromCache(s));
-					return ZE_RESULT_SUCCESS;
+					return utilFromCache(cache.engines.copy, cache, out);
 				}};
 
 constexpr auto MEM_UTIL =
@@ -165,7 +153,7 @@ constexpr auto MEM_UTIL =
 					auto val = 0.0;
 					const auto r = mem->getMemoryUsed(nullptr, &val);
 					if (r == ZE_RESULT_SUCCESS) {
-						out = std::format("{:.2f}", val);
+						out = MetricValue::real(val, 2);
 					}
 					return r;
 				}};
@@ -15,12 +15,17 @@
 #include "metrics/ecc.h"
 #include "metrics/identity.h"
 #include "metrics/clock.h"
+#include "metrics/process.h"
+#include "metrics/fabric_metrics.h"
 #include "device.h"
+#include "fabric_telemetry.h"
 #include "zes_api.h"
+#include <os.h>
 #include "ze_api.h"
 #include <enginegroup.h>
 #include <functional>
 #include <iterator>
+#include <memory>
 #include <memory.h>
 #include <metric.h>
 #include <numeric>
@@ -68,14 +73,36 @@ static constexpr auto ENGINE_MAP = std::to_array<EngineEntry>({
 	{&EngineCache::copy, ZES_ENGINE_GROUP_COPY_ALL},
 });
 
-MetricCache populateMetricCacheBegin(devInfo &dev)
+namespace {
+
+/** Snapshot of the device's DRM clients (single-device pass over procfs). */
+DrmClientSnapshot snapshotDeviceClients(devInfo &dev)
+{
+	const std::string bdf = dev.dev->getBDFStr();
+	return std::move(snapshotDrmClients(std::span{&bdf, 1}).front());
+}
+
+} // namespace
+
+MetricCache populateMetricCacheBegin(devInfo &dev, bool withProcesses, bool withFabric)
 {
 	MetricCache cache;
+	cache.processSampled = withProcesses;
+	if (withProcesses) {
+		cache.processBefore = snapshotDeviceClients(dev);
+	}
+	cache.fabricSampled = withFabric;
+	if (withFabric) {
+		auto before = std::make_shared<fabric_telemetry::DeviceSample>();
+		fabric_telemetry::sampleDevice(dev, *before);
+		cache.fabricBefore = std::move(before);
+	}
 	enginegroup *eg = dev.dev->getEngineGroup();
 	auto *pw = dev.dev->getPower();
 	auto *mem = dev.dev->getMemory();
 	auto *p = dev.dev->getPCI();
 
+	cache.hostNsBefore = MONOTONIC_RAW_NS();
 	for (const auto &entry : ENGINE_MAP) {
 		auto &s = cache.engines.*entry.slot;
 		if (eg != nullptr) {
@@ -119,6 +146,7 @@ void populateMetricCacheEnd(devInfo &dev, MetricCache &cache)
 	auto *mem = dev.dev->getMemory();
 	auto *p = dev.dev->getPCI();
 
+	cache.hostNsAfter = MONOTONIC_RAW_NS();
 	for (const auto &entry : ENGINE_MAP) {
 		auto &s = cache.engines.*entry.slot;
 		if (eg != nullptr) {
@@ -178,6 +206,29 @@ void populateMetricCacheEnd(devInfo &dev, MetricCache &cache)
 		}
 	}
 
+	cache.processAvail = false;
+	cache.processes.clear();
+	if (cache.processSampled) {
+		cache.processAfter = snapshotDeviceClients(dev);
+		cache.processAvail = cache.processBefore.available && cache.processAfter.available;
+		if (cache.processAvail) {
+			cache.processes = computeProcessUtilization(cache.processBefore, cache.processAfter);
+		}
+	}
+
+	cache.fabricAvail = false;
+	cache.fabricRates.reset();
+	if (cache.fabricSampled) {
+		auto after = std::make_shared<fabric_telemetry::DeviceSample>();
+		fabric_telemetry::sampleDevice(dev, *after);
+		cache.fabricAfter = std::move(after);
+		cache.fabricAvail = cache.fabricBefore != nullptr && cache.fabricBefore->available && cache.fabricAfter->available;
+		if (cache.fabricAvail) {
+			cache.fabricRates = std::make_shared<const std::vector<fabric_telemetry::PortRate>>(
+				fabric_telemetry::computeRates(*cache.fabricBefore, *cache.fabricAfter));
+		}
+	}
+
 	cache.populated = true;
 }
 
@@ -210,7 +261,12 @@ MetricCache populateMetricCacheContinuous(devInfo &dev, const MetricCache &prev)
 	curr.pcieReplayAvail = prev.pcieReplayAvail;
 
 	curr.memBefore = prev.memAfter;
+	curr.hostNsBefore = prev.hostNsAfter;
 	curr.memMaxBandwidth = prev.memMaxBandwidth;
+	curr.processSampled = prev.processSampled;
+	curr.processBefore = prev.processAfter;
+	curr.fabricSampled = prev.fabricSampled;
+	curr.fabricBefore = prev.fabricAfter;
 	// EU metrics are re-sampled fresh each tick; no before/after state to carry over.
 
 	populateMetricCacheEnd(dev, curr);
@@ -236,10 +292,12 @@ std::span<const QueryMetric> getQueryMetrics() noexcept
 		const auto power = power::getPowerMetrics();
 		const auto ecc = ecc::getEccMetrics();
 		const auto clock = clock::getClockMetrics();
+		const auto process = process::getProcessMetrics();
+		const auto fabricPorts = fabric::getFabricMetrics();
 
 		std::vector<QueryMetric> metricVec;
 		for (const std::span<const QueryMetric> s :
-			 {identity, temperature, utilization, pci, euArray, fan, memory, power, ecc, clock}) {
+			 {identity, temperature, utilization, pci, euArray, fan, memory, power, ecc, clock, process, fabricPorts}) {
 			metricVec.insert(metricVec.end(), s.begin(), s.end());
 		}
 		return metricVec;
@@ -389,4 +447,14 @@ std::string formatGroups(MetricGroup groups)
 	return result;
 }
 
+bool needsProcessSampling(std::span<const QueryMetric *const> fields) noexcept
+{
+	return std::ranges::any_of(fields, [](const QueryMetric *f) { return hasGroup(f->groups, MetricGroup::PROCESS); });
+}
+
+bool needsFabricSampling(std::span<const QueryMetric *const> fields) noexcept
+{
+	return std::ranges::any_of(fields, [](const QueryMetric *f) { return hasGroup(f->groups, MetricGroup::FABRIC); });
+}
+
 } // namespace metrics
@@ -14,7 +14,12 @@
 #include <array>
 #include <chrono>
 #include <cstdint>
+#include <concepts>
+#include <drm_fdinfo.h>
+#include <format>
 #include <functional>
+#include <iterator>
+#include <memory>
 #include <metric.h>
 #include <optional>
 #include <span>
@@ -24,6 +29,11 @@
 #include <type_traits>
 #include <vector>
 
+namespace fabric_telemetry {
+struct DeviceSample;
+struct PortRate;
+} // namespace fabric_telemetry
+
 namespace metrics {
 
 namespace detail {
@@ -65,6 +75,8 @@ enum class MetricGroup : uint32_t
 	ECC = 1U << 7,		   /**< ecc.mode.current, ecc.errors.corrected/uncorrected; analogous to dmon -s e */
 	EU_ARRAY = 1U << 8,	   /**< eu.active/stall/idle (Intel Xe-only) */
 	FAN = 1U << 9,		   /**< fan.speed */
+	PROCESS = 1U << 10,	   /**< process.count, process.top.* from DRM client fdinfo (Linux) */
+	FABRIC = 1U << 11,	   /**< fabric.rx/tx.throughput, fabric.link.utilization, fabric.port<N>.* (Xe Link) */
 	ALL = ~0U,
 };
 
@@ -151,6 +163,8 @@ struct MetricCache
 	bool pcieBandwidthAvail = false;	 /**< true when device reports PCIe bandwidth counters */
 	bool pcieReplayAvail = false;		 /**< true when device reports PCIe replay counters */
 	MemSnapshot memBefore{}, memAfter{}; /**< memory read/write counters + µs timestamp */
+	/** MONOTONIC_RAW_NS() at the before/after counter reads; 0 when unknown. See counterRate(). */
+	uint64_t hostNsBefore = 0, hostNsAfter = 0;
 	uint64_t memMaxBandwidth = 0;		 /**< peak bandwidth in bytes/s */
 	bool memAvail = false;
 	bool engineAvail = false; /**< true when engine HAL present and both snapshots taken */
@@ -158,6 +172,18 @@ struct MetricCache
 	/** EU active/stall/idle — populated once per tick by populateMetricCacheEnd */
 	EuMetricsData euSample{};
 	bool euAvail = false; /**< true when getEuActiveStallIdle succeeded */
+	/** DRM client snapshots; taken only when populateMetricCacheBegin was asked for processes */
+	bool processSampled = false;
+	DrmClientSnapshot processBefore{}, processAfter{};
+	std::vector<ProcessEngineUtilization> processes{}; /**< per-process engine utilization over the window */
+	bool processAvail = false; /**< true when both snapshots read procfs */
+	/** Fabric port counters; taken only when populateMetricCacheBegin was asked for fabric.
+	 *  Held by pointer so that only the fabric code needs fabric_telemetry.h. */
+	bool fabricSampled = false;
+	std::shared_ptr<const fabric_telemetry::DeviceSample> fabricBefore{}, fabricAfter{};
+	/** per-port bandwidth over the window; null until populateMetricCacheEnd computed it */
+	std::shared_ptr<const std::vector<fabric_telemetry::PortRate>> fabricRates{};
+	bool fabricAvail = false; /**< true when both samples read the port counters */
 	bool populated = false;
 };
 
@@ -181,10 +207,16 @@ struct MetricCache
  * Pair with @ref populateMetricCacheEnd after waiting at least @ref detail::SAMPLE_WINDOW.
  *
  * @param dev  Device to sample. Must not be null.
+ * @param withProcesses  Also snapshot the device's DRM clients for the PROCESS metrics.
+ *                       Walks procfs, so callers pass @c true only when such a metric is
+ *                       selected (see @ref needsProcessSampling). The choice carries over
+ *                       to @ref populateMetricCacheEnd and @ref populateMetricCacheContinuous.
+ * @param withFabric  Also read the fabric port counters for the FABRIC metrics (see
+ *                    @ref needsFabricSampling). Carries over the same way.
  * @return     A partially-populated MetricCache containing only before-samples.
  *             @c populated is @c false until @ref populateMetricCacheEnd is called.
  */
-[[nodiscard]] MetricCache populateMetricCacheBegin(devInfo &dev);
+[[nodiscard]] MetricCache populateMetricCacheBegin(devInfo &dev, bool withProcesses = false, bool withFabric = false);
 
 /**
  * Take the "after" half of a delta sample and mark the cache as ready.
@@ -219,8 +251,133 @@ void populateMetricCacheEnd(devInfo &dev, MetricCache &cache);
 
 // ── MetricValue ───────────────────────────────────────────────────────────────
 
-/** The output type written by every getter lambda. */
-using MetricValue = std::string;
+/**
+ * The output type written by every getter lambda.
+ *
+ * A small tagged value — N/A, signed or unsigned integer, double with a display
+ * precision, or text — that is formatted only at the output edge. Sinks render it
+ * straight into their own buffers via @ref formatTo / @ref appendTo, so a reused
+ * MetricValue costs no allocation per tick for numeric fields.
+ *
+ * Text assignment from @c std::string, @c std::string_view and C strings is implicit
+ * so identity getters can keep writing strings.
+ */
+class MetricValue
+{
+public:
+	enum class Kind : uint8_t
+	{
+		NotAvailable, /**< No value; rendered as "N/A" */
+		Signed,		  /**< int64_t */
+		Unsigned,	  /**< uint64_t */
+		Real,		  /**< double, rendered with @ref precision() decimals (or shortest form when < 0) */
+		Text,		  /**< Free-form string */
+	};
+
+	MetricValue() = default;
+	MetricValue(const char *text) { assignText(text); }			 // NOLINT(google-explicit-constructor)
+	MetricValue(std::string_view text) { assignText(text); }	 // NOLINT(google-explicit-constructor)
+	MetricValue(const std::string &text) { assignText(text); } // NOLINT(google-explicit-constructor)
+	MetricValue(std::string &&text) : kindTag{Kind::Text}, textValue{std::move(text)} {} // NOLINT
+
+	/** Integer value; signedness follows @p T. */
+	template <std::integral T> [[nodiscard]] static MetricValue integer(T v) noexcept
+	{
+		MetricValue m;
+		if constexpr (std::is_signed_v<T>) {
+			m.kindTag = Kind::Signed;
+			m.number.i = static_cast<int64_t>(v);
+		} else {
+			m.kindTag = Kind::Unsigned;
+			m.number.u = static_cast<uint64_t>(v);
+		}
+		return m;
+	}
+
+	/** Floating-point value shown with @p precision decimals; negative means shortest round-trip form. */
+	[[nodiscard]] static MetricValue real(double v, int precision = -1) noexcept
+	{
+		MetricValue m;
+		m.kindTag = Kind::Real;
+		m.number.d = v;
+		m.digits = static_cast<int8_t>(std::clamp(precision, -1, 17));
+		return m;
+	}
+
+	/** Returns to N/A while keeping the text buffer's capacity for reuse. */
+	void reset() noexcept
+	{
+		kindTag = Kind::NotAvailable;
+		textValue.clear();
+	}
+
+	[[nodiscard]] Kind kind() const noexcept { return kindTag; }
+	[[nodiscard]] bool available() const noexcept { return kindTag != Kind::NotAvailable; }
+	[[nodiscard]] int64_t asSigned() const noexcept { return number.i; }
+	[[nodiscard]] uint64_t asUnsigned() const noexcept { return number.u; }
+	[[nodiscard]] double asReal() const noexcept { return number.d; }
+	[[nodiscard]] int precision() const noexcept { return digits; }
+	[[nodiscard]] std::string_view text() const noexcept { return textValue; }
+
+	/** Formats the value through an output iterator; "N/A" when unavailable. */
+	template <typename OutputIt> OutputIt formatTo(OutputIt it) const
+	{
+		switch (kindTag) {
+		case Kind::Signed:
+			return std::format_to(it, "{}", number.i);
+		case Kind::Unsigned:
+			return std::format_to(it, "{}", number.u);
+		case Kind::Real:
+			return digits < 0 ? std::format_to(it, "{}", number.d) : std::format_to(it, "{:.{}f}", number.d, digits);
+		case Kind::Text:
+			return std::copy(textValue.begin(), textValue.end(), it);
+		case Kind::NotAvailable:
+			break;
+		}
+		constexpr std::string_view na{"N/A"};
+		return std::copy(na.begin(), na.end(), it);
+	}
+
+	/** Appends the formatted value to @p buf; reuses @p buf's capacity. */
+	void appendTo(std::string &buf) const { formatTo(std::back_inserter(buf)); }
+
+	/** Formatted value as a new string — convenience for cold paths. */
+	[[nodiscard]] std::string toString() const
+	{
+		std::string s;
+		appendTo(s);
+		return s;
+	}
+
+	/** Compares the formatted value, e.g. @c out == "1.00". */
+	[[nodiscard]] bool operator==(std::string_view formatted) const
+	{
+		if (kindTag == Kind::Text) {
+			return textValue == formatted;
+		}
+		// Short values stay in the string's inline buffer; a real with many digits may not fit any fixed size
+		std::string buf;
+		appendTo(buf);
+		return buf == formatted;
+	}
+
+private:
+	void assignText(std::string_view text)
+	{
+		kindTag = Kind::Text;
+		textValue.assign(text);
+	}
+
+	Kind kindTag{Kind::NotAvailable};
+	int8_t digits{-1};
+	union
+	{
+		int64_t i;
+		uint64_t u;
+		double d;
+	} number{.i = 0};
+	std::string textValue;
+};
 
 // ── QueryMetric ────────────────────────────────────────────────────────────────
 
@@ -264,6 +421,8 @@ inline constexpr auto GROUP_TABLE = std::to_array<MetricGroupEntry>({
 	{"ECC", "e", MetricGroup::ECC},
 	{"EU_ARRAY", "x", MetricGroup::EU_ARRAY},
 	{"FAN", "f", MetricGroup::FAN},
+	{"PROCESS", "", MetricGroup::PROCESS},
+	{"FABRIC", "", MetricGroup::FABRIC},
 	{"ALL", "", MetricGroup::ALL},
 });
 
@@ -425,13 +584,29 @@ inline constexpr auto GROUP_TABLE = std::to_array<MetricGroupEntry>({
  */
 [[nodiscard]] std::string formatGroups(MetricGroup groups);
 
+/**
+ * Whether any of @p fields needs DRM client snapshots (the PROCESS group).
+ *
+ * Pass the result to @ref populateMetricCacheBegin so procfs is only walked when a
+ * per-process metric was selected.
+ */
+[[nodiscard]] bool needsProcessSampling(std::span<const QueryMetric *const> fields) noexcept;
+
+/**
+ * Whether any of @p fields needs fabric port counters (the FABRIC group).
+ *
+ * Pass the result to @ref populateMetricCacheBegin so devices without selected fabric
+ * metrics skip the port reads.
+ */
+[[nodiscard]] bool needsFabricSampling(std::span<const QueryMetric *const> fields) noexcept;
+
 // ── MetricOutput concept ───────────────────────────────────────────────────────
 
 /** Any type satisfying MetricOutput can serve as a sink for evaluated metric results.
  *  Pass an instance to @ref runMetrics() or @ref runMetricsWithCaches(). */
 template <typename T>
 concept MetricOutput =
-	requires(T &t, std::span<const QueryMetric *> fields, devInfo &dev, const QueryMetric &f, const std::string &val) {
+	requires(T &t, std::span<const QueryMetric *> fields, devInfo &dev, const QueryMetric &f, const MetricValue &val) {
 		t.onBegin(fields);
 		t.onBeginDevice(dev);
 		t.onMetric(f, val);
@@ -452,12 +627,13 @@ void emitMetrics(Output &output, std::span<const QueryMetric *> fields, std::spa
 				 std::span<const MetricCache> caches)
 {
 	output.onBegin(fields);
+	MetricValue val; // reused across fields so text values keep their buffer
 	for (std::size_t i = 0; i < devices.size(); ++i) {
 		output.onBeginDevice(devices[i]);
 		for (const QueryMetric *f : fields) {
-			std::string val{"N/A"};
+			val.reset();
 			if (f->getter(devices[i], val, caches[i]) != ZE_RESULT_SUCCESS) {
-				val = "N/A";
+				val.reset();
 			}
 			output.onMetric(*f, val);
 		}
@@ -476,7 +652,7 @@ void emitMetrics(Output &output, std::span<const QueryMetric *> fields, std::spa
  * This keeps the total blocking time constant regardless of device count.
  *
  * Metrics tagged @ref MetricSource::Static skip sampling entirely.
- * Metrics whose getter returns a non-success result emit @c "N/A".
+ * Metrics whose getter returns a non-success result emit an unavailable @ref MetricValue.
  *
  * @tparam Output  Any type satisfying @ref MetricOutput.
  * @param output   Sink that receives the structured results.
@@ -26,11 +26,15 @@ JsonPrinter::JsonPrinter() : Printer() {}
 /**
  * @brief Print a JSON object with pretty formatting (4 spaces indentation).
  *
+ * The document is serialized straight into the buffered output rather than into one
+ * string first; the bytes are those of jsonObj->dump(4) followed by a newline.
+ *
  * @param jsonObj Pointer to the JSON object to print.
  */
 void JsonPrinter::print(nlohmann::ordered_json *jsonObj)
 {
-	PRINT("{}\n", jsonObj->dump(4).c_str()); // Pretty print JSON with 4 spaces
+	mWriter.value(*jsonObj);
+	mWriter.end();
 }
 
 /**
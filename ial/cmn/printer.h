@@ -7,6 +7,7 @@
 #ifndef _PRINT_H
 #define _PRINT_H
 
+#include "json_stream.h"
 #include <nlohmann/json.hpp>
 
 /**
@@ -18,6 +19,14 @@ public:
 	Printer();
 	virtual ~Printer() = default;
 	virtual void print(nlohmann::ordered_json *jsonObj) = 0; // Pure virtual function for printing
+
+	/**
+	 * @brief Writer a command can describe its output to piece by piece, e.g. one device at a
+	 *        time, instead of building the document for print()
+	 *
+	 * @return JsonStreamWriter* nullptr when the printer needs the whole document
+	 */
+	virtual JsonStreamWriter *stream() { return nullptr; }
 };
 
 class JsonPrinter : public Printer
@@ -25,6 +34,11 @@ class JsonPrinter : public Printer
 public:
 	JsonPrinter();
 	void print(nlohmann::ordered_json *jsonObj) override;
+	JsonStreamWriter *stream() override { return &mWriter; }
+
+private:
+	JsonOutput mOut;
+	JsonStreamWriter mWriter{mOut};
 };
 
 class TextPrinter : public Printer
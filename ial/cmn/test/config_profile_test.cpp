@@ -0,0 +1,301 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#ifdef INFO
+#undef INFO
+#endif
+
+#include "config_profile.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+std::string progName = "test";
+
+using namespace config_profile; // NOLINT(google-build-using-namespace)
+
+namespace {
+
+/// Two-tile device whose settings live in a DeviceState map.
+class FakeDevice : public DeviceConfigurator
+{
+public:
+	DeviceState state{
+		{"power_limit.sustain", 300},
+		{"memory_ecc", "enabled"},
+		{"standby_mode", "default"},
+		{"tile.0.frequency_range", nlohmann::json::array({300, 1550})},
+		{"tile.1.frequency_range", nlohmann::json::array({300, 1550})},
+		{"tile.0.scheduler", {{"mode", "exclusive"}}},
+		{"tile.1.scheduler", {{"mode", "exclusive"}}},
+	};
+	std::string failKey;	  // applySetting() fails for this key
+	std::string ignoreKey;	  // applySetting() "succeeds" for this key but changes nothing
+	std::chrono::milliseconds latency{0};
+	std::atomic<int> *active{nullptr};
+	std::atomic<int> *maxActive{nullptr};
+	std::vector<std::string> log;
+
+	ze_result_t readState(DeviceState &out) override
+	{
+		out = state;
+		return ZE_RESULT_SUCCESS;
+	}
+
+	ze_result_t applySetting(std::string_view key, const nlohmann::json &value) override
+	{
+		if (active != nullptr) {
+			const int now = ++*active;
+			int seen = maxActive->load();
+			while (now > seen && !maxActive->compare_exchange_weak(seen, now)) {
+			}
+		}
+		std::this_thread::sleep_for(latency);
+		if (active != nullptr) {
+			--*active;
+		}
+
+		log.emplace_back(key);
+		if (key == failKey) {
+			return ZE_RESULT_ERROR_NOT_AVAILABLE;
+		}
+		if (key != ignoreKey) {
+			state[std::string{key}] = value;
+		}
+		return ZE_RESULT_SUCCESS;
+	}
+};
+
+nlohmann::json profileFor(std::string_view text) { return nlohmann::json::parse(text); }
+
+DeviceJob jobFor(FakeDevice &device, uint32_t index, const nlohmann::json &settings)
+{
+	return DeviceJob{.index = index, .device = &device, .settings = settings};
+}
+
+} // namespace
+
+TEST_SUITE("parseProfile")
+{
+	TEST_CASE("accepts device and tile settings")
+	{
+		std::vector<ProfileEntry> entries;
+		std::string error;
+		const auto doc = profileFor(R"({"devices": [
+			{"device": "all", "power_limit": {"sustain": 350}, "standby_mode": "never"},
+			{"device": 1, "frequency_range": [300, 1200],
+			 "tiles": [{"tile_id": 1, "scheduler": {"mode": "timeslice", "interval": 5000,
+			                                        "yield_timeout": 640000, "ignored": 1}}]}
+		]})");
+		REQUIRE_MESSAGE(parseProfile(doc, entries, error), error);
+		REQUIRE(entries.size() == 2);
+		CHECK(entries[0].device == "all");
+		CHECK(entries[1].device == "1");
+		CHECK(entries[1].settings["tiles"]["1"]["scheduler"] ==
+			  nlohmann::json{{"mode", "timeslice"}, {"interval", 5000}, {"yield_timeout", 640000}});
+	}
+
+	TEST_CASE("rejects invalid profiles")
+	{
+		std::vector<ProfileEntry> entries;
+		std::string error;
+		CHECK_FALSE(parseProfile(profileFor(R"({"devices": []})"), entries, error));
+		CHECK_FALSE(parseProfile(profileFor(R"({"devices": [{"power_limit": {"sustain": 1}}]})"), entries, error));
+		CHECK_FALSE(parseProfile(profileFor(R"({"devices": [{"device": 0, "fan_speed": 50}]})"), entries, error));
+		CHECK_FALSE(
+			parseProfile(profileFor(R"({"devices": [{"device": 0, "frequency_range": [900, 300]}]})"), entries, error));
+		CHECK_FALSE(parseProfile(profileFor(R"({"devices": [{"device": 0, "scheduler": {"mode": "timeout",
+			"timeout": 10}}]})"),
+								 entries, error));
+		CHECK_FALSE(
+			parseProfile(profileFor(R"({"devices": [{"device": 0, "power_limit": {"turbo": 1}}]})"), entries, error));
+		CHECK_FALSE(parseProfile(profileFor(R"({"devices": [{"device": 0, "tiles": [{"tile_id": 0,
+			"memory_ecc": "enabled"}]}]})"),
+								 entries, error));
+		CHECK(error.find("memory_ecc") != std::string::npos);
+	}
+}
+
+TEST_SUITE("profile state")
+{
+	TEST_CASE("stateFromConfig reads the config command's JSON")
+	{
+		const auto config = profileFor(R"({
+			"memory_ecc_pending_state": "disabled",
+			"pl_card_sustain": 0, "pl_package_sustain": 300, "pl_card_peak": 400,
+			"tile_config_data": [
+				{"min_frequency": 300, "max_frequency": 1550, "scheduler_mode": "timeslice",
+				 "scheduler_timeslice_interval": 5000, "scheduler_timeslice_yield_timeout": 640000,
+				 "scheduler_timeout": 0, "standby_mode": "never"},
+				{"min_frequency": 300, "max_frequency": 1200, "scheduler_mode": "timeout",
+				 "scheduler_timeslice_interval": 0, "scheduler_timeslice_yield_timeout": 0,
+				 "scheduler_timeout": 640000, "standby_mode": "never"}
+			]})");
+		const auto state = stateFromConfig(config);
+		CHECK(state.at("power_limit.sustain") == 300);
+		CHECK(state.at("power_limit.peak") == 400);
+		CHECK_FALSE(state.contains("power_limit.burst"));
+		CHECK(state.at("memory_ecc") == "disabled");
+		CHECK(state.at("standby_mode") == "never");
+		CHECK(state.at("tile.1.frequency_range") == nlohmann::json::array({300, 1200}));
+		CHECK(state.at("tile.0.scheduler")["interval"] == 5000);
+		CHECK(state.at("tile.1.scheduler") == nlohmann::json{{"mode", "timeout"}, {"timeout", 640000}});
+	}
+
+	TEST_CASE("device-level tile settings expand to every tile; tile entries override")
+	{
+		FakeDevice device;
+		nlohmann::json settings = nlohmann::json::object();
+		mergeSettings(settings, profileFor(R"({"frequency_range": [300, 1000]})"));
+		mergeSettings(settings, profileFor(R"({"tiles": {"1": {"frequency_range": [500, 900]}}})"));
+		const auto desired = desiredState(settings, device.state);
+		CHECK(desired.at("tile.0.frequency_range") == nlohmann::json::array({300, 1000}));
+		CHECK(desired.at("tile.1.frequency_range") == nlohmann::json::array({500, 900}));
+	}
+
+	TEST_CASE("computeDiff keeps only differing settings")
+	{
+		FakeDevice device;
+		std::string error;
+		const auto changes =
+			computeDiff(device.state, {{"power_limit.sustain", 300.4}, {"standby_mode", "never"}}, error);
+		CHECK(error.empty());
+		REQUIRE(changes.size() == 1);
+		CHECK(changes[0].key == "standby_mode");
+		CHECK(changes[0].from == "default");
+
+		CHECK(computeDiff(device.state, {{"power_limit.burst", 400}}, error).empty());
+		CHECK_FALSE(error.empty());
+	}
+}
+
+TEST_SUITE("applyProfile")
+{
+	const auto SETTINGS = nlohmann::json{{"power_limit", {{"sustain", 350}}}, {"standby_mode", "never"}};
+
+	TEST_CASE("applies and verifies all devices")
+	{
+		std::vector<FakeDevice> devices(4);
+		std::vector<DeviceJob> jobs;
+		for (uint32_t i = 0; i < devices.size(); ++i) {
+			jobs.push_back(jobFor(devices[i], i, SETTINGS));
+		}
+		devices[2].state["standby_mode"] = "never"; // already partly configured
+
+		REQUIRE(planProfile(jobs) == ZE_RESULT_SUCCESS);
+		CHECK(jobs[0].plan.size() == 2);
+		CHECK(jobs[2].plan.size() == 1);
+
+		const std::atomic<bool> abort{false};
+		CHECK(applyProfile(jobs, abort) == ZE_RESULT_SUCCESS);
+		for (const auto &device : devices) {
+			CHECK(device.state.at("power_limit.sustain") == 350);
+			CHECK(device.state.at("standby_mode") == "never");
+		}
+		CHECK(devices[2].log.size() == 1);
+	}
+
+	TEST_CASE("a failure on one device restores every device")
+	{
+		std::vector<FakeDevice> devices(3);
+		devices[1].failKey = "standby_mode";
+		const auto original = devices[0].state;
+		std::vector<DeviceJob> jobs;
+		for (uint32_t i = 0; i < devices.size(); ++i) {
+			jobs.push_back(jobFor(devices[i], i, SETTINGS));
+		}
+
+		REQUIRE(planProfile(jobs) == ZE_RESULT_SUCCESS);
+		const std::atomic<bool> abort{false};
+		CHECK(applyProfile(jobs, abort) == ZE_RESULT_ERROR_NOT_AVAILABLE);
+		CHECK(jobs[1].failedKey == "standby_mode");
+		for (size_t i = 0; i < devices.size(); ++i) {
+			CHECK(devices[i].state == original);
+			if (jobs[i].applied > 0) {
+				CHECK(jobs[i].rolledBack);
+				CHECK(jobs[i].rollbackResult == ZE_RESULT_SUCCESS);
+			}
+		}
+	}
+
+	TEST_CASE("a value that does not read back triggers rollback")
+	{
+		FakeDevice device;
+		device.ignoreKey = "standby_mode";
+		std::vector<DeviceJob> jobs{jobFor(device, 0, SETTINGS)};
+
+		REQUIRE(planProfile(jobs) == ZE_RESULT_SUCCESS);
+		const std::atomic<bool> abort{false};
+		CHECK(applyProfile(jobs, abort) == ZE_RESULT_ERROR_UNKNOWN);
+		CHECK(jobs[0].failedKey == "standby_mode");
+		CHECK(jobs[0].rolledBack);
+		CHECK(device.state.at("power_limit.sustain") == 300);
+	}
+
+	TEST_CASE("an aborted run writes nothing")
+	{
+		FakeDevice device;
+		std::vector<DeviceJob> jobs{jobFor(device, 0, SETTINGS)};
+
+		REQUIRE(planProfile(jobs) == ZE_RESULT_SUCCESS);
+		const std::atomic<bool> abort{true};
+		CHECK(applyProfile(jobs, abort) == ZE_RESULT_ERROR_NOT_AVAILABLE);
+		CHECK(device.log.empty());
+		CHECK_FALSE(jobs[0].rolledBack);
+	}
+
+	TEST_CASE("settings the device does not report fail planning")
+	{
+		FakeDevice device;
+		device.state.erase("memory_ecc");
+		std::vector<DeviceJob> jobs{jobFor(device, 0, {{"memory_ecc", "disabled"}})};
+		CHECK(planProfile(jobs) == ZE_RESULT_ERROR_UNSUPPORTED_FEATURE);
+		CHECK(jobs[0].failure.find("memory_ecc") != std::string::npos);
+	}
+
+	TEST_CASE("devices are configured concurrently")
+	{
+		std::atomic<int> active{0};
+		std::atomic<int> maxActive{0};
+		std::vector<FakeDevice> devices(8);
+		std::vector<DeviceJob> jobs;
+		for (uint32_t i = 0; i < devices.size(); ++i) {
+			devices[i].latency = std::chrono::milliseconds(20);
+			devices[i].active = &active;
+			devices[i].maxActive = &maxActive;
+			jobs.push_back(jobFor(devices[i], i, SETTINGS));
+		}
+
+		REQUIRE(planProfile(jobs) == ZE_RESULT_SUCCESS);
+		const std::atomic<bool> abort{false};
+		CHECK(applyProfile(jobs, abort) == ZE_RESULT_SUCCESS);
+		CHECK(maxActive.load() > 1);
+	}
+
+	TEST_CASE("every device task is placed before it touches the device")
+	{
+		std::vector<FakeDevice> devices(3);
+		std::vector<DeviceJob> jobs;
+		std::atomic<int> placed{0};
+		for (uint32_t i = 0; i < devices.size(); ++i) {
+			jobs.push_back(jobFor(devices[i], i, SETTINGS));
+			jobs.back().placeWorker = [&placed] { ++placed; };
+		}
+
+		REQUIRE(planProfile(jobs) == ZE_RESULT_SUCCESS);
+		CHECK(placed.load() == 3);
+		const std::atomic<bool> abort{false};
+		CHECK(applyProfile(jobs, abort) == ZE_RESULT_SUCCESS);
+		CHECK(placed.load() == 6);
+	}
+}
@@ -0,0 +1,269 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ * Unit tests for device_registry.cpp against a fake driver whose devices can be
+ * removed, reset and plugged in at runtime
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+// doctest's INFO clashes with the logger macro pulled in by the project headers
+#ifdef INFO
+#undef INFO
+#endif
+
+#include "device_registry.h"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr auto GPU0 = "0000:03:00.0";
+constexpr auto GPU1 = "0000:4d:00.0";
+constexpr auto GPU2 = "0000:9a:00.0";
+
+/// Driver whose devices come and go; every successful probe hands out new handles.
+/// Probes resolve DRM nodes through a cache that only the backend's invalidate clears,
+/// like the shared PCI path index; a probe through a stale node fails.
+class FakeDriver
+{
+public:
+	void plug(const std::string &bdf)
+	{
+		const std::lock_guard lock(mutex);
+		present[bdf] = true;
+	}
+
+	void unplug(const std::string &bdf)
+	{
+		const std::lock_guard lock(mutex);
+		present.erase(bdf);
+	}
+
+	/// Moves the device to another DRM node, as a reset or rebind may do.
+	void remap(const std::string &bdf, const std::string &node)
+	{
+		const std::lock_guard lock(mutex);
+		nodes[bdf] = node;
+	}
+
+	[[nodiscard]] int probes(const std::string &bdf)
+	{
+		const std::lock_guard lock(mutex);
+		return probeCount[bdf];
+	}
+
+	[[nodiscard]] RegisteredDevice initial(const std::string &bdf, uint32_t index)
+	{
+		plug(bdf);
+		return RegisteredDevice{bdf, devInfo{index, nullptr, nullptr, handle()}, nullptr};
+	}
+
+	[[nodiscard]] DeviceRegistry::Backend backend(bool withList)
+	{
+		DeviceRegistry::Backend b;
+		b.probe = [this](const std::string &bdf) -> std::optional<RegisteredDevice> {
+			const std::lock_guard lock(mutex);
+			++probeCount[bdf];
+			if (!present.contains(bdf)) {
+				return std::nullopt;
+			}
+			const auto cached = cachedNodes.try_emplace(bdf, nodes[bdf]).first->second;
+			if (cached != nodes[bdf]) {
+				return std::nullopt;
+			}
+			return RegisteredDevice{bdf, devInfo{0, nullptr, nullptr, handle()}, nullptr};
+		};
+		b.invalidate = [this](const std::string &bdf) {
+			const std::lock_guard lock(mutex);
+			cachedNodes.erase(bdf);
+		};
+		if (withList) {
+			b.list = [this]() -> std::optional<std::vector<std::string>> {
+				const std::lock_guard lock(mutex);
+				std::vector<std::string> bdfs;
+				for (const auto &[bdf, on] : present) {
+					bdfs.push_back(bdf);
+				}
+				return bdfs;
+			};
+		}
+		return b;
+	}
+
+private:
+	zes_device_handle_t handle() { return reinterpret_cast<zes_device_handle_t>(++nextHandle); }
+
+	std::mutex mutex;
+	std::map<std::string, bool> present;
+	std::map<std::string, std::string> nodes;
+	std::map<std::string, std::string> cachedNodes;
+	std::map<std::string, int> probeCount;
+	uintptr_t nextHandle{0x1000};
+};
+
+DeviceRegistry::Options fastOptions()
+{
+	DeviceRegistry::Options options;
+	options.listenForEvents = false;
+	options.rescanInterval = 20ms;
+	options.retryInterval = 10ms;
+	options.retryFor = 2s;
+	return options;
+}
+
+/// Polls @p done until it holds or two seconds pass.
+bool eventually(const std::function<bool()> &done)
+{
+	const auto deadline = std::chrono::steady_clock::now() + 2s;
+	while (!done()) {
+		if (std::chrono::steady_clock::now() > deadline) {
+			return false;
+		}
+		std::this_thread::sleep_for(2ms);
+	}
+	return true;
+}
+
+} // namespace
+
+TEST_SUITE("DeviceRegistry")
+{
+	TEST_CASE("a removed device leaves the others untouched")
+	{
+		FakeDriver drv;
+		DeviceRegistry registry({drv.initial(GPU0, 0), drv.initial(GPU1, 1)}, drv.backend(false), fastOptions());
+		const auto before = registry.current();
+		CHECK(before->generation == 0);
+
+		drv.unplug(GPU0);
+		registry.post(DeviceEvent{DeviceEvent::Kind::REMOVED, GPU0, {}});
+		REQUIRE(eventually([&] { return registry.current()->generation > 0; }));
+
+		const auto after = registry.current();
+		REQUIRE(after->devices.size() == 1);
+		CHECK(after->find(GPU0) == nullptr);
+		CHECK(after->devices[0].info.zesDeviceHdl == before->find(GPU1)->info.zesDeviceHdl);
+		CHECK(after->devices[0].info.index == 1);
+		// Loops still holding the old set keep a consistent view
+		CHECK(before->devices.size() == 2);
+	}
+
+	TEST_CASE("a reset device is re-enumerated with new handles and its old index")
+	{
+		FakeDriver drv;
+		DeviceRegistry registry({drv.initial(GPU0, 0), drv.initial(GPU1, 1)}, drv.backend(false), fastOptions());
+		const auto staleHandle = registry.current()->find(GPU1)->info.zesDeviceHdl;
+
+		registry.post(DeviceEvent{DeviceEvent::Kind::CHANGED, GPU1, {}});
+		REQUIRE(eventually([&] { return registry.current()->generation > 0; }));
+
+		const auto *gpu1 = registry.current()->find(GPU1);
+		REQUIRE(gpu1 != nullptr);
+		CHECK(gpu1->info.zesDeviceHdl != staleHandle);
+		CHECK(gpu1->info.index == 1);
+		CHECK(drv.probes(GPU0) == 0);
+	}
+
+	TEST_CASE("a device whose driver is still probing is retried until it shows up")
+	{
+		FakeDriver drv;
+		DeviceRegistry registry({drv.initial(GPU0, 0), drv.initial(GPU1, 1)}, drv.backend(false), fastOptions());
+
+		drv.unplug(GPU1);
+		registry.post(DeviceEvent{DeviceEvent::Kind::REMOVED, GPU1, {}});
+		registry.post(DeviceEvent{DeviceEvent::Kind::ADDED, GPU1, "xe"});
+		REQUIRE(eventually([&] { return drv.probes(GPU1) >= 3; }));
+		CHECK(registry.current()->find(GPU1) == nullptr);
+
+		drv.plug(GPU1);
+		REQUIRE(eventually([&] { return registry.current()->find(GPU1) != nullptr; }));
+		CHECK(registry.current()->find(GPU1)->info.index == 1);
+		CHECK(registry.current()->devices.size() == 2);
+	}
+
+	TEST_CASE("hotplugged GPUs get the next index; other drivers and out-of-scope devices are ignored")
+	{
+		FakeDriver drv;
+		DeviceRegistry registry({drv.initial(GPU0, 0)}, drv.backend(false), fastOptions());
+
+		registry.post(DeviceEvent{DeviceEvent::Kind::ADDED, "0000:00:1f.3", "snd_hda_intel"});
+		drv.plug(GPU2);
+		registry.post(DeviceEvent{DeviceEvent::Kind::ADDED, GPU2, "xe"});
+		REQUIRE(eventually([&] { return registry.current()->find(GPU2) != nullptr; }));
+		CHECK(registry.current()->find(GPU2)->info.index == 1);
+		CHECK(drv.probes("0000:00:1f.3") == 0);
+
+		auto options = fastOptions();
+		options.acceptNew = false;
+		FakeDriver scoped;
+		DeviceRegistry single({scoped.initial(GPU0, 0)}, scoped.backend(false), options);
+		scoped.plug(GPU2);
+		single.post(DeviceEvent{DeviceEvent::Kind::ADDED, GPU2, "xe"});
+		single.post(DeviceEvent{DeviceEvent::Kind::CHANGED, GPU0, {}});
+		REQUIRE(eventually([&] { return single.current()->generation > 0; }));
+		CHECK(single.current()->find(GPU2) == nullptr);
+		CHECK(scoped.probes(GPU2) == 0);
+	}
+
+	TEST_CASE("rescans follow a driver that adds and removes devices without events")
+	{
+		FakeDriver drv;
+		DeviceRegistry registry({drv.initial(GPU0, 0), drv.initial(GPU1, 1)}, drv.backend(true), fastOptions());
+
+		drv.unplug(GPU1);
+		REQUIRE(eventually([&] { return registry.current()->find(GPU1) == nullptr; }));
+		drv.plug(GPU2);
+		REQUIRE(eventually([&] { return registry.current()->find(GPU2) != nullptr; }));
+		drv.plug(GPU1);
+		REQUIRE(eventually([&] { return registry.current()->find(GPU1) != nullptr; }));
+
+		const auto current = registry.current();
+		REQUIRE(current->devices.size() == 3);
+		CHECK(current->devices[0].bdf == GPU0);
+		CHECK(current->devices[1].bdf == GPU1);
+		CHECK(current->devices[2].bdf == GPU2);
+		CHECK(current->devices[2].info.index == 2);
+	}
+
+	TEST_CASE("a device removed by an event is not revived by a rescan that still lists it")
+	{
+		FakeDriver drv;
+		DeviceRegistry registry({drv.initial(GPU0, 0), drv.initial(GPU1, 1)}, drv.backend(true), fastOptions());
+
+		registry.post(DeviceEvent{DeviceEvent::Kind::REMOVED, GPU1, {}});
+		REQUIRE(eventually([&] { return registry.current()->find(GPU1) == nullptr; }));
+		std::this_thread::sleep_for(100ms);
+		CHECK(registry.current()->find(GPU1) == nullptr);
+
+		registry.post(DeviceEvent{DeviceEvent::Kind::ADDED, GPU1, "xe"});
+		REQUIRE(eventually([&] { return registry.current()->find(GPU1) != nullptr; }));
+	}
+
+	TEST_CASE("a re-probe sees the device's new paths")
+	{
+		FakeDriver drv;
+		auto backend = drv.backend(false);
+		drv.remap(GPU1, "/dev/dri/card1");
+		DeviceRegistry registry({drv.initial(GPU0, 0), drv.initial(GPU1, 1)}, backend, fastOptions());
+		// Resolve and cache the current mapping, as the initial enumeration did
+		REQUIRE(backend.probe(GPU1));
+
+		drv.remap(GPU1, "/dev/dri/card3");
+		registry.post(DeviceEvent{DeviceEvent::Kind::CHANGED, GPU1, {}});
+		REQUIRE(eventually([&] { return registry.current()->generation > 0; }));
+
+		// Probed once, through the new node, rather than dropped and retried against the old one
+		CHECK(registry.current()->find(GPU1) != nullptr);
+		CHECK(drv.probes(GPU1) == 2);
+	}
+}
@@ -0,0 +1,268 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#ifdef INFO
+#undef INFO
+#endif
+
+#include "drm_fdinfo.h"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr auto GPU0 = "0000:03:00.0";
+constexpr auto GPU1 = "0000:4d:00.0";
+
+struct TempDir
+{
+	std::filesystem::path path;
+
+	TempDir()
+	{
+		path = std::filesystem::temp_directory_path() / std::filesystem::path{"drm_fdinfo_test_XXXXXX"};
+		std::string tmpl = path.string();
+		const char *const result = mkdtemp(tmpl.data());
+		REQUIRE(result != nullptr);
+		path = result;
+	}
+
+	~TempDir()
+	{
+		std::error_code err;
+		std::filesystem::remove_all(path, err);
+	}
+
+	TempDir(const TempDir &) = delete;
+	TempDir &operator=(const TempDir &) = delete;
+};
+
+/// Synthetic /proc tree: /proc/<pid>/fd/<fd> links and /proc/<pid>/fdinfo/<fd> files.
+struct FakeProc
+{
+	TempDir tmp;
+	ProcfsPaths paths{.procRoot = tmp.path};
+
+	void openFile(uint32_t pid, int fd, const std::string &target, const std::string &fdinfo) const
+	{
+		const auto procDir = tmp.path / std::to_string(pid);
+		std::filesystem::create_directories(procDir / "fd");
+		std::filesystem::create_directories(procDir / "fdinfo");
+		std::error_code err;
+		std::filesystem::remove(procDir / "fd" / std::to_string(fd), err);
+		std::filesystem::create_symlink(target, procDir / "fd" / std::to_string(fd));
+		std::ofstream ofs{procDir / "fdinfo" / std::to_string(fd)};
+		REQUIRE(ofs);
+		ofs << fdinfo;
+	}
+};
+
+/// fdinfo text in the i915 style: busy time per engine class in ns.
+std::string i915Fdinfo(const char *bdf, uint64_t clientId, uint64_t renderNs, uint64_t videoNs)
+{
+	return std::format("pos:\t0\nflags:\t02100002\nmnt_id:\t26\nino:\t1080\n"
+					   "drm-driver:\ti915\ndrm-pdev:\t{}\ndrm-client-id:\t{}\n"
+					   "drm-engine-render:\t{} ns\ndrm-engine-copy:\t0 ns\ndrm-engine-video:\t{} ns\n"
+					   "drm-engine-capacity-video:\t2\ndrm-engine-video-enhance:\t0 ns\n"
+					   "drm-total-system0:\t4 KiB\ndrm-resident-system0:\t4 KiB\ndrm-resident-local0:\t2 MiB\n",
+					   bdf, clientId, renderNs, videoNs);
+}
+
+/// fdinfo text in the xe style: busy and total GPU cycles per engine class.
+std::string xeFdinfo(const char *bdf, uint64_t clientId, uint64_t ccsCycles, uint64_t totalCycles)
+{
+	return std::format("pos:\t0\nflags:\t02100002\n"
+					   "drm-driver:\txe\ndrm-client-id:\t{}\ndrm-pdev:\t{}\n"
+					   "drm-total-vram0:\t8192 KiB\ndrm-resident-vram0:\t8192 KiB\ndrm-resident-gtt:\t0\n"
+					   "drm-cycles-rcs:\t0\ndrm-total-cycles-rcs:\t{}\n"
+					   "drm-cycles-ccs:\t{}\ndrm-total-cycles-ccs:\t{}\ndrm-engine-capacity-ccs:\t4\n",
+					   clientId, bdf, totalCycles, ccsCycles, totalCycles);
+}
+
+DrmClientSnapshot snapshot(const FakeProc &proc, const char *bdf)
+{
+	const std::vector<std::string> bdfs{bdf};
+	auto snapshots = snapshotDrmClients(bdfs, proc.paths);
+	REQUIRE(snapshots.size() == 1);
+	return snapshots[0];
+}
+
+/// Pins the snapshot interval to exactly one second so percentages are exact.
+void oneSecondApart(const DrmClientSnapshot &before, DrmClientSnapshot &after)
+{
+	after.time = before.time + std::chrono::seconds{1};
+}
+
+} // namespace
+
+TEST_SUITE("parseDrmFdinfo")
+{
+	TEST_CASE("reads i915 engine time, capacity and resident memory")
+	{
+		DrmClientCounters counters;
+		REQUIRE(parseDrmFdinfo(i915Fdinfo(GPU0, 7, 1000, 2000), GPU0, counters));
+		CHECK(counters.clientId == 7);
+		CHECK(counters.engineNs.at("render") == 1000);
+		CHECK(counters.engineNs.at("video") == 2000);
+		CHECK(counters.capacity.at("video") == 2);
+		CHECK_FALSE(counters.capacity.contains("render"));
+		CHECK(counters.residentBytes == 4096 + 2 * 1024 * 1024);
+	}
+
+	TEST_CASE("normalizes xe engine class names")
+	{
+		DrmClientCounters counters;
+		REQUIRE(parseDrmFdinfo(xeFdinfo(GPU0, 3, 500, 9000), GPU0, counters));
+		CHECK(counters.cycles.at("compute") == 500);
+		CHECK(counters.totalCycles.at("compute") == 9000);
+		CHECK(counters.totalCycles.at("render") == 9000);
+		CHECK(counters.capacity.at("compute") == 4);
+		CHECK(counters.residentBytes == 8192ULL * 1024);
+		CHECK(counters.engineNs.empty());
+	}
+
+	TEST_CASE("rejects other devices and non-DRM files")
+	{
+		DrmClientCounters counters;
+		CHECK_FALSE(parseDrmFdinfo(i915Fdinfo(GPU1, 7, 1, 1), GPU0, counters));
+		CHECK_FALSE(parseDrmFdinfo("pos:\t0\nflags:\t0100000\nmnt_id:\t22\n", GPU0, counters));
+		CHECK_FALSE(parseDrmFdinfo("drm-driver:\ti915\ndrm-pdev:\t0000:03:00.0\n", GPU0, counters));
+		CHECK(parseDrmFdinfo(i915Fdinfo("0000:4D:00.0", 1, 1, 1), GPU1, counters));
+	}
+}
+
+TEST_SUITE("snapshotDrmClients")
+{
+	TEST_CASE("collects clients of each device in one pass")
+	{
+		FakeProc proc;
+		proc.openFile(100, 3, "/dev/dri/renderD128", i915Fdinfo(GPU0, 1, 0, 0));
+		proc.openFile(100, 4, "/dev/dri/renderD129", i915Fdinfo(GPU1, 2, 0, 0));
+		proc.openFile(200, 5, "/dev/dri/card1", i915Fdinfo(GPU1, 9, 0, 0));
+		proc.openFile(200, 6, "/tmp/not-a-gpu", i915Fdinfo(GPU1, 10, 0, 0));
+		std::filesystem::create_directories(proc.tmp.path / "self");
+		std::filesystem::create_directories(proc.tmp.path / "300" / "fd"); // no fdinfo directory
+
+		const std::vector<std::string> bdfs{GPU0, GPU1};
+		const auto snapshots = snapshotDrmClients(bdfs, proc.paths);
+		REQUIRE(snapshots.size() == 2);
+		CHECK(snapshots[0].available);
+		REQUIRE(snapshots[0].clients.size() == 1);
+		CHECK(snapshots[0].clients[0].pid == 100);
+		REQUIRE(snapshots[1].clients.size() == 2);
+		CHECK(snapshots[1].clients[0].clientId == 2);
+		CHECK(snapshots[1].clients[1].clientId == 9);
+		CHECK(snapshots[1].clients[1].pid == 200);
+	}
+
+	TEST_CASE("a client shared by several descriptors is reported once")
+	{
+		FakeProc proc;
+		proc.openFile(500, 3, "/dev/dri/renderD128", i915Fdinfo(GPU0, 4, 0, 0));
+		proc.openFile(500, 8, "/dev/dri/renderD128", i915Fdinfo(GPU0, 4, 0, 0)); // dup()
+		proc.openFile(42, 3, "/dev/dri/renderD128", i915Fdinfo(GPU0, 4, 0, 0));	 // inherited across fork()
+
+		const auto snap = snapshot(proc, GPU0);
+		REQUIRE(snap.clients.size() == 1);
+		CHECK(snap.clients[0].pid == 42);
+	}
+
+	TEST_CASE("a missing proc root yields empty snapshots")
+	{
+		const std::vector<std::string> bdfs{GPU0};
+		const auto snapshots = snapshotDrmClients(bdfs, ProcfsPaths{.procRoot = "/nonexistent/proc"});
+		REQUIRE(snapshots.size() == 1);
+		CHECK_FALSE(snapshots[0].available);
+		CHECK(snapshots[0].clients.empty());
+	}
+}
+
+TEST_SUITE("computeProcessUtilization")
+{
+	TEST_CASE("busy time over one second becomes per-class percentages")
+	{
+		FakeProc proc;
+		proc.openFile(100, 3, "/dev/dri/renderD128", i915Fdinfo(GPU0, 1, 1'000'000'000, 0));
+		auto before = snapshot(proc, GPU0);
+		// 250 ms of render and 500 ms of video (over two video engines) in one second
+		proc.openFile(100, 3, "/dev/dri/renderD128", i915Fdinfo(GPU0, 1, 1'250'000'000, 500'000'000));
+		auto after = snapshot(proc, GPU0);
+		oneSecondApart(before, after);
+
+		const auto util = computeProcessUtilization(before, after);
+		REQUIRE(util.size() == 1);
+		CHECK(util[0].pid == 100);
+		CHECK(util[0].engines.at("render").percent == doctest::Approx(25.0));
+		CHECK(util[0].engines.at("video").percent == doctest::Approx(25.0));
+		CHECK(util[0].engines.at("video").capacity == 2);
+		CHECK(util[0].engines.at("copy").percent == doctest::Approx(0.0));
+		CHECK(util[0].maxPercent() == doctest::Approx(25.0));
+		// media = video (2 engines at 25%) + video-enhance (1 engine idle)
+		CHECK(util[0].groupPercent({"video", "video-enhance"}).value() == doctest::Approx(50.0 / 3.0));
+		CHECK_FALSE(util[0].groupPercent({"compute"}).has_value());
+		CHECK(util[0].residentBytes == 4096 + 2 * 1024 * 1024);
+	}
+
+	TEST_CASE("cycle counters are divided by total cycles and capacity")
+	{
+		FakeProc proc;
+		proc.openFile(7, 3, "/dev/dri/renderD128", xeFdinfo(GPU0, 1, 1000, 100'000));
+		const auto before = snapshot(proc, GPU0);
+		proc.openFile(7, 3, "/dev/dri/renderD128", xeFdinfo(GPU0, 1, 201'000, 200'000));
+		const auto after = snapshot(proc, GPU0);
+
+		const auto util = computeProcessUtilization(before, after);
+		REQUIRE(util.size() == 1);
+		CHECK(util[0].engines.at("compute").percent == doctest::Approx(50.0)); // 200k / 100k over 4 engines
+		CHECK(util[0].engines.at("render").percent == doctest::Approx(0.0));
+	}
+
+	TEST_CASE("clients of one process are summed; new clients report memory only")
+	{
+		FakeProc proc;
+		proc.openFile(100, 3, "/dev/dri/renderD128", i915Fdinfo(GPU0, 1, 0, 0));
+		proc.openFile(100, 4, "/dev/dri/renderD128", i915Fdinfo(GPU0, 2, 0, 0));
+		auto before = snapshot(proc, GPU0);
+		proc.openFile(100, 3, "/dev/dri/renderD128", i915Fdinfo(GPU0, 1, 700'000'000, 0));
+		proc.openFile(100, 4, "/dev/dri/renderD128", i915Fdinfo(GPU0, 2, 600'000'000, 0));
+		proc.openFile(200, 3, "/dev/dri/renderD128", i915Fdinfo(GPU0, 3, 900'000'000, 0));
+		auto after = snapshot(proc, GPU0);
+		oneSecondApart(before, after);
+
+		const auto util = computeProcessUtilization(before, after);
+		REQUIRE(util.size() == 2);
+		CHECK(util[0].engines.at("render").percent == doctest::Approx(100.0)); // 130% clamped
+		CHECK(util[0].residentBytes == 2 * (4096 + 2 * 1024 * 1024));
+		CHECK(util[1].pid == 200);
+		CHECK(util[1].engines.empty());
+		CHECK_FALSE(util[1].maxPercent().has_value());
+		CHECK(util[1].residentBytes == 4096 + 2 * 1024 * 1024);
+	}
+
+	TEST_CASE("a counter that goes backwards reports zero")
+	{
+		FakeProc proc;
+		proc.openFile(100, 3, "/dev/dri/renderD128", i915Fdinfo(GPU0, 1, 5'000'000'000, 0));
+		auto before = snapshot(proc, GPU0);
+		proc.openFile(100, 3, "/dev/dri/renderD128", i915Fdinfo(GPU0, 1, 1'000, 0));
+		auto after = snapshot(proc, GPU0);
+		oneSecondApart(before, after);
+
+		const auto util = computeProcessUtilization(before, after);
+		REQUIRE(util.size() == 1);
+		CHECK(util[0].engines.at("render").percent == doctest::Approx(0.0));
+	}
+}
@@ -16,7 +16,7 @@
  *  - QueryFormat default field values (cmd_dump.h struct docstring)
  *  - Exported constants: DEFAULT_INTERVAL, MAX_INTERVAL, MAX_DUMP_TIME_SECONDS
  *  - parseDumpCLI():  help paths, bare "help" keyword, dmon alias, parse errors
- *  - parseSamplingTiming(): --number / --interval / --loop-ms / --time validation
+ *  - parseSamplingTiming(): --number / --interval / --loop-ms / --time / --aggregate validation
  *  - resolveMetricsArg(): dot-notation rejection, unsupported legacy IDs
  *  - translateMetricQuery(): unsupported IDs 21, 27, 28 are silently dropped
  *  - cmdDump::runQuery(): numeric-ID rejection, unresolvable field names
@@ -489,6 +489,44 @@ TEST_SUITE("cmdDump::run – parseSamplingTiming: --time validation")
 	}
 }
 
+// ─── cmdDump::run – parseSamplingTiming: --aggregate validation ───────────────
+//
+// parseSamplingTiming docstring:
+//   "--aggregate: window in seconds, at most MAX_AGGREGATE_WINDOW and no shorter
+//    than the sampling interval."
+
+TEST_SUITE("cmdDump::run – parseSamplingTiming: --aggregate validation")
+{
+	TEST_CASE("--aggregate 0 (non-positive) → ZE_RESULT_ERROR_INVALID_ARGUMENT")
+	{
+		FakeArgs fa{"xpu-smi", "dump", "--metrics", "UTILIZATION", "--aggregate", "0"};
+		cmdDump cmd;
+		CHECK(cmd.run(&fa.args) == static_cast<int>(ZE_RESULT_ERROR_INVALID_ARGUMENT));
+	}
+
+	TEST_CASE("--aggregate with non-integer string → ZE_RESULT_ERROR_INVALID_ARGUMENT")
+	{
+		FakeArgs fa{"xpu-smi", "dump", "--metrics", "UTILIZATION", "--aggregate", "1m"};
+		cmdDump cmd;
+		CHECK(cmd.run(&fa.args) == static_cast<int>(ZE_RESULT_ERROR_INVALID_ARGUMENT));
+	}
+
+	TEST_CASE("--aggregate exceeding MAX_AGGREGATE_WINDOW → ZE_RESULT_ERROR_INVALID_ARGUMENT")
+	{
+		const std::string tooLong = std::to_string(std::chrono::seconds{MAX_AGGREGATE_WINDOW}.count() + 1);
+		FakeArgs fa{"xpu-smi", "dump", "--metrics", "UTILIZATION", "--aggregate", tooLong.c_str()};
+		cmdDump cmd;
+		CHECK(cmd.run(&fa.args) == static_cast<int>(ZE_RESULT_ERROR_INVALID_ARGUMENT));
+	}
+
+	TEST_CASE("--aggregate shorter than --interval → ZE_RESULT_ERROR_INVALID_ARGUMENT")
+	{
+		FakeArgs fa{"xpu-smi", "dump", "--metrics", "UTILIZATION", "--interval", "5", "--aggregate", "2"};
+		cmdDump cmd;
+		CHECK(cmd.run(&fa.args) == static_cast<int>(ZE_RESULT_ERROR_INVALID_ARGUMENT));
+	}
+}
+
 // ─── cmdDump::runQuery – validation ───────────────────────────────────────────
 //
 // runQuery docstring:
@@ -539,6 +577,16 @@ TEST_SUITE("cmdDump::runQuery – validation")
 		CHECK(fmt.count == 0);
 	}
 
+	TEST_CASE("an unbounded loop inside --batch is rejected → ZE_RESULT_ERROR_INVALID_ARGUMENT")
+	{
+		// The script is the standard input; a loop stopped by a key would never end
+		FakeArgs fa{"xpu-smi"};
+		batchMode = true;
+		const int rc = cmdDump::runQuery("temperature.gpu", "", &fa.args, QueryFormat{.loopMs = 1000, .count = 0});
+		batchMode = false;
+		CHECK(rc == static_cast<int>(ZE_RESULT_ERROR_INVALID_ARGUMENT));
+	}
+
 	TEST_CASE("finite loop-ms + count models bounded run that auto-exits")
 	{
 		// Regression contract for --query-gpu with --loop-ms and --count:
@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ * Unit tests for fabric_telemetry.cpp: counter deltas, per-port rates and the link matrix
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#ifdef INFO
+#undef INFO
+#endif
+
+#include "fabric_telemetry.h"
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+using namespace fabric_telemetry; // NOLINT(google-build-using-namespace)
+
+namespace {
+
+// 53.125 Gb/s x 4 lanes, an Xe Link port
+constexpr uint64_t XE_LINK_BYTES_PER_SEC = 26'562'500'000;
+
+zes_fabric_port_id_t portId(uint32_t fabricId, uint8_t portNumber)
+{
+	return zes_fabric_port_id_t{.fabricId = fabricId, .attachId = 0, .portNumber = portNumber};
+}
+
+PortSample port(uint32_t fabricId, uint8_t portNumber, uint64_t rx, uint64_t tx, uint64_t timestampUs)
+{
+	PortSample p;
+	p.portId = portId(fabricId, portNumber);
+	p.rxCapacity = XE_LINK_BYTES_PER_SEC;
+	p.txCapacity = XE_LINK_BYTES_PER_SEC;
+	p.rxCounter = rx;
+	p.txCounter = tx;
+	p.timestampUs = timestampUs;
+	return p;
+}
+
+DeviceSample device(std::vector<PortSample> ports)
+{
+	return DeviceSample{.ports = std::move(ports), .available = true};
+}
+
+PortRate linked(uint32_t fabricId, uint32_t peerFabricId, std::optional<double> txBytesPerSec)
+{
+	PortRate r;
+	r.portId = portId(fabricId, 1);
+	r.peer = portId(peerFabricId, 1);
+	r.txBytesPerSec = txBytesPerSec;
+	r.txCapacity = 1000;
+	return r;
+}
+
+} // namespace
+
+TEST_SUITE("counterDelta")
+{
+	TEST_CASE("counts forward and across a wrap")
+	{
+		CHECK(counterDelta(100, 350, 1000) == 250U);
+		CHECK(counterDelta(7, 7, 1000) == 0U);
+		const uint64_t top = std::numeric_limits<uint64_t>::max();
+		CHECK(counterDelta(top - 99, 50, 1000) == 150U);
+	}
+
+	TEST_CASE("a reset or an implausible jump carries no delta")
+	{
+		CHECK_FALSE(counterDelta(5'000'000, 1'000, 1'000'000).has_value());
+		CHECK_FALSE(counterDelta(0, 2'000'001, 1'000'000).has_value());
+	}
+}
+
+TEST_SUITE("computeRates")
+{
+	TEST_CASE("bytes per second over the port's own timestamps")
+	{
+		const auto before = device({port(7, 1, 1'000, 2'000, 1'000'000), port(7, 2, 0, 0, 1'000'000)});
+		const auto after = device({port(7, 1, 501'000, 2'000, 1'500'000), port(7, 2, 0, 0, 1'500'000)});
+
+		const auto rates = computeRates(before, after);
+		REQUIRE(rates.size() == 2);
+		REQUIRE(rates[0].rxBytesPerSec.has_value());
+		CHECK(*rates[0].rxBytesPerSec == doctest::Approx(1'000'000.0));
+		CHECK(*rates[0].txBytesPerSec == doctest::Approx(0.0));
+		CHECK(*rates[0].rxUtilization() ==
+			  doctest::Approx(1'000'000.0 * 100.0 / static_cast<double>(XE_LINK_BYTES_PER_SEC)));
+		CHECK(fabric_telemetry::portLabel(rates[1].portId) == "7.0.2");
+	}
+
+	TEST_CASE("a wrapped counter still yields its rate")
+	{
+		const uint64_t top = std::numeric_limits<uint64_t>::max();
+		const auto rates = computeRates(device({port(7, 1, top - 999, 0, 0)}), device({port(7, 1, 1'000, 0, 1'000)}));
+		REQUIRE(rates.size() == 1);
+		CHECK(*rates[0].rxBytesPerSec == doctest::Approx(2'000'000.0));
+	}
+
+	TEST_CASE("a counter reset, a stuck timestamp or a new port gives no rate")
+	{
+		const auto before = device({port(7, 1, 900'000'000'000, 10, 1'000'000), port(7, 2, 0, 0, 1'000'000)});
+		const auto after = device({port(7, 1, 1'000, 20, 1'100'000), port(7, 2, 10, 10, 1'000'000),
+								   port(7, 3, 10, 10, 1'100'000)});
+
+		const auto rates = computeRates(before, after);
+		REQUIRE(rates.size() == 3);
+		CHECK_FALSE(rates[0].rxBytesPerSec.has_value());
+		CHECK(rates[0].txBytesPerSec.has_value()); // Only the rx counter went backwards
+		CHECK_FALSE(rates[1].rxBytesPerSec.has_value());
+		CHECK_FALSE(rates[2].txBytesPerSec.has_value());
+		CHECK_FALSE(rates[2].txUtilization().has_value());
+	}
+
+	TEST_CASE("ports are matched by ID and keep the peer of the first sample")
+	{
+		auto first = port(7, 2, 0, 0, 0);
+		first.peer = portId(9, 4);
+		const auto rates =
+			computeRates(device({port(7, 1, 0, 0, 0), first}), device({port(7, 2, 0, 500, 1'000), port(7, 1, 0, 0, 1'000)}));
+		REQUIRE(rates.size() == 2);
+		CHECK(rates[0].portId.portNumber == 2);
+		REQUIRE(rates[0].peer.has_value());
+		CHECK(rates[0].peer->fabricId == 9);
+		CHECK(*rates[0].txBytesPerSec == doctest::Approx(500'000.0));
+		CHECK_FALSE(rates[1].peer.has_value());
+	}
+
+	TEST_CASE("an unavailable sample yields no rates")
+	{
+		CHECK(computeRates(DeviceSample{}, device({port(7, 1, 0, 0, 1)})).empty());
+	}
+}
+
+TEST_SUITE("buildLinkMatrix")
+{
+	TEST_CASE("sums the ports between each pair of devices")
+	{
+		// Device 0 has tiles with fabric IDs 1 and 2, device 3 has fabric ID 5
+		const std::vector<DeviceRates> devices{
+			{.deviceIndex = 0, .ports = {linked(1, 5, 300.0), linked(2, 5, 100.0), linked(1, 2, 50.0)}},
+			{.deviceIndex = 3, .ports = {linked(5, 1, std::nullopt)}},
+			{.deviceIndex = 4, .ports = {}},
+		};
+		const auto matrix = buildLinkMatrix(devices);
+
+		CHECK(matrix.devices == std::vector<uint32_t>{0, 3, 4});
+		REQUIRE(matrix.cells.size() == 3);
+		const auto &toOther = matrix.cells[0][1];
+		CHECK(toOther.linked);
+		CHECK(*toOther.bytesPerSec == doctest::Approx(400.0));
+		CHECK(*toOther.utilization == doctest::Approx(20.0));
+
+		// Tile to tile of the same device
+		CHECK(matrix.cells[0][0].linked);
+		CHECK(*matrix.cells[0][0].utilization == doctest::Approx(5.0));
+
+		// Linked, but no rate for the window
+		CHECK(matrix.cells[1][0].linked);
+		CHECK_FALSE(matrix.cells[1][0].bytesPerSec.has_value());
+
+		CHECK_FALSE(matrix.cells[0][2].linked);
+		CHECK_FALSE(matrix.cells[2][0].linked);
+	}
+
+	TEST_CASE("links to devices that were not sampled are left out")
+	{
+		const std::vector<DeviceRates> devices{{.deviceIndex = 0, .ports = {linked(1, 42, 10.0)}}};
+		const auto matrix = buildLinkMatrix(devices);
+		REQUIRE(matrix.cells.size() == 1);
+		CHECK_FALSE(matrix.cells[0][0].linked);
+	}
+}
@@ -0,0 +1,293 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ * Unit tests for health_watch.cpp: rule parsing and the duration, hysteresis and
+ * rate-of-change handling of the health --watch engine, driven by synthetic samples,
+ * and the queue that runs alert hooks off the sampling thread
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#ifdef INFO
+#undef INFO
+#endif
+
+#include "health_watch.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace health_watch; // NOLINT(google-build-using-namespace)
+using metrics::MetricValue;
+
+namespace {
+
+/** @brief Watchdog on a fake clock recording every alert as "device:rule:event" */
+struct Harness
+{
+	std::chrono::steady_clock::time_point now{};
+	std::vector<std::string> alerts;
+	std::vector<Alert> raw;
+	Watchdog watchdog;
+
+	explicit Harness(std::vector<Rule> rules, ThresholdResolver resolver = {})
+		: watchdog(
+			  std::move(rules), std::move(resolver),
+			  [this](const Alert &a) {
+				  alerts.push_back(std::to_string(a.device) + ":" + a.rule->name + ":" +
+								   (a.raised ? "raised" : "cleared"));
+				  raw.push_back(a);
+			  },
+			  [this] { return TickTime{now, std::chrono::system_clock::time_point{}}; })
+	{
+	}
+
+	/** @brief One tick at @p seconds with one value per field of the watchdog, for @p device */
+	void sample(double seconds, const std::vector<MetricValue> &values, uint32_t device = 0)
+	{
+		now = std::chrono::steady_clock::time_point{} +
+			  std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+		devInfo dev{device, nullptr, nullptr, nullptr};
+		const auto fields = watchdog.fields();
+		watchdog.onBegin(fields);
+		watchdog.onBeginDevice(dev);
+		for (std::size_t i = 0; i < fields.size(); ++i) {
+			watchdog.onMetric(*fields[i], values[i]);
+		}
+		watchdog.onEndDevice(dev);
+		watchdog.onEnd();
+	}
+};
+
+static_assert(metrics::MetricOutput<Watchdog>);
+
+std::vector<Rule> parse(const char *text)
+{
+	std::vector<Rule> rules;
+	std::string error;
+	REQUIRE(parseRules(nlohmann::json::parse(text), rules, error));
+	return rules;
+}
+
+std::string parseError(const char *text)
+{
+	std::vector<Rule> rules;
+	std::string error;
+	CHECK_FALSE(parseRules(nlohmann::json::parse(text), rules, error));
+	return error;
+}
+
+MetricValue celsius(double v) { return MetricValue::real(v, 2); }
+
+/** @brief Hook that records the lines it runs and holds on to each until released */
+struct SlowHook
+{
+	std::mutex mutex;
+	std::condition_variable changed;
+	std::vector<std::string> started;
+	std::vector<std::thread::id> threads;
+	bool released{false};
+
+	void operator()(const std::string &line)
+	{
+		std::unique_lock lock(mutex);
+		started.push_back(line);
+		threads.push_back(std::this_thread::get_id());
+		changed.notify_all();
+		changed.wait(lock, [this] { return released; });
+	}
+
+	void waitStarted(std::size_t count)
+	{
+		std::unique_lock lock(mutex);
+		changed.wait(lock, [&] { return started.size() >= count; });
+	}
+
+	void release()
+	{
+		const std::lock_guard lock(mutex);
+		released = true;
+		changed.notify_all();
+	}
+};
+
+} // namespace
+
+TEST_CASE("parseRules reads every comparison, threshold kind and option")
+{
+	const auto rules = parse(R"({"rules": [
+		{"name": "core-hot", "metric": "temperature.gpu", "at_least": "core_throttle", "for": 5, "clear": 3,
+		 "severity": "critical"},
+		{"metric": "power.draw", "rate_above": 100.5},
+		{"name": "throttled", "metric": "clocks.throttle.reason", "not_equal": "None", "for": 0.25}
+	]})");
+	REQUIRE(rules.size() == 3);
+	CHECK(rules[0].comparison == Comparison::AtLeast);
+	CHECK(rules[0].thresholdKey == "core_throttle");
+	CHECK(rules[0].duration == std::chrono::seconds(5));
+	CHECK(rules[0].clearMargin == 3.0);
+	CHECK(rules[0].severity == Severity::Critical);
+	CHECK(rules[1].name == "power.draw rate_above");
+	CHECK(rules[1].rate);
+	CHECK(rules[1].value == 100.5);
+	CHECK(rules[1].severity == Severity::Warning);
+	CHECK(rules[2].comparison == Comparison::NotEqual);
+	CHECK(rules[2].text == "None");
+	CHECK(rules[2].duration == std::chrono::milliseconds(250));
+
+	CHECK(parseError(R"({"rules": []})") == "rules must be an object with a non-empty \"rules\" array");
+	CHECK(parseError(R"({"rules": [{"metric": "temperature.gpu"}]})").starts_with("rules[0]: missing comparison"));
+	CHECK(parseError(R"({"rules": [{"metric": "no.such.metric", "above": 1}]})") ==
+		  "rules[0]: unknown metric \"no.such.metric\"");
+	CHECK(parseError(R"({"rules": [{"metric": "power.draw", "above": 1, "below": 0}]})") ==
+		  "rules[0]: \"above\" and \"below\" both given; a rule has one comparison");
+	CHECK(parseError(R"({"rules": [{"metric": "power.draw", "above": "tdp"}]})").starts_with("rules[0]: \"above\" must"));
+	CHECK(parseError(R"({"rules": [{"metric": "power.draw", "rate_above": "power_tdp"}]})") ==
+		  "rules[0]: \"rate_above\" must be a number");
+	CHECK(parseError(R"({"rules": [{"metric": "power.draw", "above": 1, "for": -1}]})") ==
+		  "rules[0]: \"for\" must be a number of seconds >= 0");
+	CHECK(parseError(R"({"rules": [{"metric": "power.draw", "above": 1, "severity": "fatal"}]})") ==
+		  "rules[0]: \"severity\" must be \"warning\" or \"critical\"");
+	CHECK(parseError(R"({"rules": [{"name": "a", "metric": "power.draw", "above": 1},
+								   {"name": "a", "metric": "power.draw", "below": 1}]})") ==
+		  "rules[1]: duplicate name \"a\"");
+	CHECK(parseError(R"({"rules": [{"metric": "power.draw", "above": 1, "window": 3}]})") ==
+		  "rules[0]: unsupported key \"window\"");
+}
+
+TEST_CASE("Watchdog samples each metric once however many rules use it")
+{
+	Harness h(defaultRules());
+	// Five rules over four metrics: both core temperature rules share one field
+	CHECK(h.watchdog.rules().size() == 5);
+	CHECK(h.watchdog.fields().size() == 4);
+}
+
+TEST_CASE("Watchdog raises after the duration and clears past the hysteresis margin")
+{
+	Harness h(parse(R"({"rules": [{"name": "hot", "metric": "temperature.gpu", "above": 90, "for": 3, "clear": 5}]})"));
+
+	// A breach shorter than the duration, or interrupted, raises nothing
+	h.sample(0, {celsius(95)});
+	h.sample(2, {celsius(95)});
+	h.sample(3, {celsius(80)});
+	h.sample(4, {celsius(95)});
+	h.sample(6, {celsius(95)});
+	CHECK(h.alerts.empty());
+	h.sample(7, {celsius(96)});
+	REQUIRE(h.alerts == std::vector<std::string>{"0:hot:raised"});
+	CHECK(h.raw[0].value.asReal() == 96.0);
+	CHECK(h.raw[0].threshold.asReal() == 90.0);
+	CHECK(h.watchdog.activeAlerts() == 1);
+
+	// Hovering at the threshold does not flap; an unavailable value changes nothing
+	for (int t = 8; t < 20; ++t) {
+		h.sample(t, {celsius(t % 2 == 0 ? 89 : 91)});
+	}
+	h.sample(20, {MetricValue{}});
+	CHECK(h.alerts.size() == 1);
+
+	h.sample(21, {celsius(85.1)}); // Still above the threshold less the margin
+	CHECK(h.alerts.size() == 1);
+	h.sample(22, {celsius(85)});
+	CHECK(h.alerts.back() == "0:hot:cleared");
+	CHECK(h.watchdog.activeAlerts() == 0);
+}
+
+TEST_CASE("Watchdog compares the rate of change per second")
+{
+	Harness h(parse(R"({"rules": [{"name": "ramp", "metric": "power.draw", "rate_above": 50}]})"));
+
+	h.sample(0, {MetricValue::real(100.0, 1)});
+	h.sample(1, {MetricValue::real(140.0, 1)}); // 40 W/s
+	h.sample(3, {MetricValue::real(200.0, 1)}); // 30 W/s
+	CHECK(h.alerts.empty());
+	h.sample(3.5, {MetricValue::real(230.0, 1)}); // 60 W/s
+	REQUIRE(h.alerts == std::vector<std::string>{"0:ramp:raised"});
+	CHECK(h.raw[0].value.asReal() == 60.0);
+
+	// A gap restarts the rate from the next value
+	h.sample(4, {MetricValue{}});
+	h.sample(5, {MetricValue::real(230.0, 1)});
+	CHECK(h.alerts.size() == 1);
+	h.sample(6, {MetricValue::real(230.0, 1)});
+	CHECK(h.alerts.back() == "0:ramp:cleared");
+}
+
+TEST_CASE("Watchdog resolves threshold keys per device and keeps per-device state")
+{
+	int lookups = 0;
+	Harness h(parse(R"({"rules": [{"name": "hot", "metric": "temperature.gpu", "at_least": "core_throttle"},
+								  {"name": "throttled", "metric": "clocks.throttle.reason", "not_equal": "None"}]})"),
+			  [&](devInfo &dev, std::string_view key) -> std::optional<double> {
+				  ++lookups;
+				  CHECK(key == "core_throttle");
+				  if (dev.index == 2) {
+					  return std::nullopt;
+				  }
+				  return dev.index == 0 ? 90.0 : 100.0;
+			  });
+	REQUIRE(h.watchdog.fields().size() == 2);
+
+	for (const uint32_t device : {0U, 1U, 2U}) {
+		h.sample(0, {celsius(95), MetricValue("None")}, device);
+	}
+	CHECK(h.alerts == std::vector<std::string>{"0:hot:raised"});
+
+	for (const uint32_t device : {0U, 1U, 2U}) {
+		h.sample(1, {celsius(120), MetricValue("Thermal")}, device);
+	}
+	CHECK(h.alerts == std::vector<std::string>{"0:hot:raised", "0:throttled:raised", "1:hot:raised",
+											   "1:throttled:raised", "2:throttled:raised"});
+	CHECK(lookups == 3);
+	CHECK(h.watchdog.activeAlerts() == 5);
+
+	h.sample(2, {celsius(120), MetricValue("None")}, 1);
+	CHECK(h.alerts.back() == "1:throttled:cleared");
+	const auto line = toJson(h.raw.back());
+	CHECK(line["event"] == "cleared");
+	CHECK(line["device_id"] == 1);
+	CHECK(line["comparison"] == "not_equal");
+	CHECK(line["value"] == "None");
+	CHECK(toJson(h.raw.front())["value"] == 95.0);
+	CHECK(toJson(h.raw.front())["threshold"] == 90.0);
+}
+
+TEST_CASE("HookQueue runs hooks in order off the pushing thread and drains on destruction")
+{
+	SlowHook hook;
+	{
+		HookQueue queue([&hook](const std::string &line) { hook(line); });
+		CHECK(queue.push("a"));
+		hook.waitStarted(1);
+		// The first hook is still running; pushing does not wait for it
+		CHECK(queue.push("b"));
+		CHECK(queue.push("c"));
+		hook.release();
+	}
+	CHECK(hook.started == std::vector<std::string>{"a", "b", "c"});
+	REQUIRE(hook.threads.size() == 3);
+	CHECK(hook.threads.front() != std::this_thread::get_id());
+}
+
+TEST_CASE("HookQueue drops the oldest waiting line when full")
+{
+	SlowHook hook;
+	{
+		HookQueue queue([&hook](const std::string &line) { hook(line); }, 2);
+		CHECK(queue.push("a"));
+		hook.waitStarted(1);
+		CHECK(queue.push("b"));
+		CHECK(queue.push("c"));
+		CHECK_FALSE(queue.push("d"));
+		hook.release();
+	}
+	CHECK(hook.started == std::vector<std::string>{"a", "c", "d"});
+}
@@ -0,0 +1,205 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ * Unit tests for json_stream.cpp: the streamed output must match nlohmann::json::dump(4)
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#ifdef INFO
+#undef INFO
+#endif
+
+#include "json_stream.h"
+#include "printer.h"
+#include "debug.h"
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+/** @brief Records every chunk the output hands over */
+class ChunkSink final : public Sink
+{
+public:
+	void emit(const LogRecord &record) override { chunks.emplace_back(record.msg); }
+	void sync() noexcept override {}
+
+	[[nodiscard]] std::string str() const
+	{
+		std::string text;
+		for (const auto &chunk : chunks) {
+			text += chunk;
+		}
+		return text;
+	}
+
+	std::vector<std::string> chunks;
+};
+
+std::string stream(const nlohmann::ordered_json &tree)
+{
+	auto sink = std::make_shared<ChunkSink>();
+	{
+		JsonOutput out(sink);
+		JsonStreamWriter writer(out);
+		writer.value(tree);
+		writer.end();
+	}
+	return sink->str();
+}
+
+nlohmann::ordered_json sampleDocument()
+{
+	nlohmann::ordered_json device;
+	device["device_id"] = 0;
+	device["device_name"] = "Intel(R) Data Center GPU \"Max\" 1550";
+	device["path"] = "C:\\dev\\card0";
+	device["note"] = "tab\there\nnewline \x01 control, caf\xc3\xa9";
+	device["temperature"] = 41.5;
+	device["power"] = 300.0;
+	device["tiny"] = 1e-7;
+	device["huge"] = 1e300;
+	device["ratio"] = 0.1;
+	device["not_a_number"] = std::nan("");
+	device["offset"] = -12;
+	device["memory"] = std::numeric_limits<uint64_t>::max();
+	device["enabled"] = true;
+	device["vf"] = nullptr;
+	device["tiles"] = nlohmann::ordered_json::array({{{"tile_id", 0}, {"engines", {1, 2, 3}}},
+													 {{"tile_id", 1}, {"engines", nlohmann::ordered_json::array()}}});
+	device["fans"] = nlohmann::ordered_json::object();
+	device["nested"] = {{"a", {{"b", {{"c", nlohmann::ordered_json::array({nlohmann::ordered_json::array()})}}}}}};
+
+	nlohmann::ordered_json doc;
+	doc["device_list"] = nlohmann::ordered_json::array({device, device});
+	return doc;
+}
+
+} // namespace
+
+TEST_CASE("Trees are written byte for byte as dump(4)")
+{
+	const auto doc = sampleDocument();
+	CHECK(stream(doc) == doc.dump(4) + "\n");
+
+	for (const auto &tree : {nlohmann::ordered_json(), nlohmann::ordered_json::object(),
+							 nlohmann::ordered_json::array(), nlohmann::ordered_json("text"), nlohmann::ordered_json(3),
+							 nlohmann::ordered_json(false), nlohmann::ordered_json::array({nullptr})}) {
+		CHECK(stream(tree) == tree.dump(4) + "\n");
+	}
+}
+
+TEST_CASE("Binary values are laid out by nlohmann at the depth they are written")
+{
+	nlohmann::ordered_json doc;
+	doc["blob"] = nlohmann::ordered_json::binary({1, 2, 3}, 42);
+	doc["list"] = nlohmann::ordered_json::array({nlohmann::ordered_json::binary({4})});
+	CHECK(stream(doc) == doc.dump(4) + "\n");
+}
+
+TEST_CASE("Written piece by piece the document matches its tree")
+{
+	static const JsonKey listKey("device_list");
+	static const JsonKey idKey("device_id");
+	static const JsonKey nameKey("device_name");
+	static const JsonKey quotedKey("say \"hi\"");
+
+	auto sink = std::make_shared<ChunkSink>();
+	{
+		JsonOutput out(sink);
+		JsonStreamWriter writer(out);
+		writer.beginObject();
+		writer.key(listKey).beginArray();
+		for (uint32_t id = 0; id < 3; ++id) {
+			writer.beginObject();
+			writer.key(idKey).value(id);
+			writer.key(nameKey).value(std::string("gpu") + std::to_string(id));
+			writer.key(quotedKey).value(id % 2 == 0);
+			writer.key(std::to_string(id)).value(nlohmann::ordered_json{{"util", 12.25}, {"vfs", {}}});
+			writer.endObject();
+			writer.flush();
+		}
+		writer.endArray();
+		writer.key("empty").beginArray();
+		writer.endArray();
+		writer.key("missing").value(nullptr);
+		writer.endObject();
+		writer.end();
+	}
+
+	nlohmann::ordered_json expected;
+	for (uint32_t id = 0; id < 3; ++id) {
+		nlohmann::ordered_json device;
+		device["device_id"] = id;
+		device["device_name"] = "gpu" + std::to_string(id);
+		device["say \"hi\""] = id % 2 == 0;
+		device[std::to_string(id)] = nlohmann::ordered_json{{"util", 12.25}, {"vfs", {}}};
+		expected["device_list"].push_back(device);
+	}
+	expected["empty"] = nlohmann::ordered_json::array();
+	expected["missing"] = nullptr;
+	CHECK(sink->str() == expected.dump(4) + "\n");
+}
+
+TEST_CASE("Output is handed over in whole lines")
+{
+	auto sink = std::make_shared<ChunkSink>();
+	const auto doc = sampleDocument();
+	{
+		// A small buffer makes the output write out many times along the way
+		JsonOutput out(sink, 64);
+		JsonStreamWriter writer(out);
+		writer.value(doc);
+		writer.end();
+	}
+	CHECK(sink->chunks.size() > 1);
+	for (const auto &chunk : sink->chunks) {
+		REQUIRE_FALSE(chunk.empty());
+		CHECK(chunk.back() == '\n');
+	}
+	CHECK(sink->str() == doc.dump(4) + "\n");
+}
+
+TEST_CASE("Flushing keeps the unfinished line buffered")
+{
+	auto sink = std::make_shared<ChunkSink>();
+	JsonOutput out(sink);
+	JsonStreamWriter writer(out);
+	writer.beginArray();
+	writer.value(1);
+	writer.flush();
+	CHECK(sink->str() == "[\n");
+	writer.value(2);
+	writer.endArray();
+	writer.end();
+	CHECK(sink->str() == "[\n    1,\n    2\n]\n");
+}
+
+TEST_CASE("Invalid UTF-8 is rejected as dump() rejects it")
+{
+	auto sink = std::make_shared<ChunkSink>();
+	JsonOutput out(sink);
+	JsonStreamWriter writer(out);
+	CHECK_THROWS_AS(writer.value(std::string_view("\xff\xfe")), nlohmann::ordered_json::type_error);
+}
+
+TEST_CASE("JsonPrinter prints through the sink of PRINT()")
+{
+	auto sink = std::make_shared<ChunkSink>();
+	Logger::instance().setSink(sink);
+
+	auto doc = sampleDocument();
+	{
+		JsonPrinter printer;
+		printer.print(&doc);
+		REQUIRE(printer.stream() != nullptr);
+	}
+	Logger::instance().setSink(nullptr);
+	CHECK(sink->str() == doc.dump(4) + "\n");
+}
@@ -0,0 +1,388 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ * Unit tests for metric_store.cpp: compression, downsampling, retention and crash
+ * recovery of the rolling time-series store, on synthetic samples in a temporary directory
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#ifdef INFO
+#undef INFO
+#endif
+
+#include "metric_store.h"
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace metrics; // NOLINT(google-build-using-namespace)
+namespace fs = std::filesystem;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr double NA = std::numeric_limits<double>::quiet_NaN();
+
+class TempStoreDir
+{
+public:
+	fs::path path;
+
+	TempStoreDir() : path(fs::temp_directory_path() / ("metric_store_test_" + std::to_string(::getpid())))
+	{
+		fs::remove_all(path);
+		fs::create_directories(path);
+	}
+
+	~TempStoreDir()
+	{
+		std::error_code ec;
+		fs::remove_all(path, ec);
+	}
+};
+
+/** @brief Time @p seconds after a fixed start */
+std::chrono::system_clock::time_point at(double seconds)
+{
+	return std::chrono::system_clock::time_point{} + std::chrono::hours(24 * 365 * 50) +
+		   std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::duration<double>(seconds));
+}
+
+int64_t msAt(double seconds)
+{
+	return std::chrono::duration_cast<std::chrono::milliseconds>(at(seconds).time_since_epoch()).count();
+}
+
+const std::vector<std::string> COLUMNS{"temperature.gpu", "power.draw", "utilization.gpu"};
+
+/** @brief Values of a synthetic sample at second @p t: a steady value, a ramp with noise and a gappy one */
+std::vector<double> sampleAt(int t)
+{
+	return {55.0, 100.0 + t * 0.25 + ((t * 7919) % 13) / 8.0, t % 17 == 0 ? NA : static_cast<double>(t % 100)};
+}
+
+bool same(double a, double b)
+{
+	return std::bit_cast<uint64_t>(a) == std::bit_cast<uint64_t>(b) || (std::isnan(a) && std::isnan(b));
+}
+
+std::unique_ptr<MetricStore> writer(const fs::path &file, std::span<const StoreTier> tiers, uint32_t device = 0)
+{
+	std::string error;
+	auto store = MetricStore::create(file, device, COLUMNS, tiers, error);
+	REQUIRE(store != nullptr);
+	return store;
+}
+
+std::unique_ptr<MetricStore> reader(const fs::path &file)
+{
+	std::string error;
+	auto store = MetricStore::open(file, error);
+	REQUIRE(store != nullptr);
+	return store;
+}
+
+} // namespace
+
+TEST_CASE("Rows come back bit for bit through the delta-of-delta and XOR coding")
+{
+	TempStoreDir dir;
+	const fs::path file = MetricStore::fileOf(dir.path, 0);
+	const std::array<StoreTier, 1> tiers{{{1s, 1h}}};
+	auto store = writer(file, tiers);
+
+	// Irregular times: gaps of every delta-of-delta class, and arbitrary doubles
+	std::mt19937_64 rng(3);
+	std::vector<int> seconds;
+	std::vector<std::vector<double>> rows;
+	int t = 0;
+	for (int i = 0; i < 300; ++i) {
+		t += i % 50 == 0 ? 1 + static_cast<int>(rng() % 3000) : 1 + static_cast<int>(rng() % 3);
+		std::vector<double> row = sampleAt(t);
+		if (i % 9 == 0) {
+			row[0] = std::bit_cast<double>(rng());
+		}
+		if (i == 100) {
+			row = {std::numeric_limits<double>::lowest(), std::numeric_limits<double>::infinity(),
+				   std::numeric_limits<double>::denorm_min()};
+		}
+		if (std::isnan(row[0])) {
+			row[0] = 1.0;
+		}
+		seconds.push_back(t);
+		rows.push_back(row);
+		store->append(at(t), row);
+	}
+	store->append(at(t + 1), sampleAt(t + 1)); // Closes the interval of the last row
+
+	const StoreSeries series = reader(file)->query(0, at(0), at(t));
+	REQUIRE(series.rows() == rows.size());
+	CHECK(series.resolution == 1s);
+	for (std::size_t r = 0; r < rows.size(); ++r) {
+		CHECK(series.times[r] == msAt(seconds[r]));
+		for (std::size_t c = 0; c < COLUMNS.size(); ++c) {
+			CHECK(same(series.value(r, c), rows[r][c]));
+		}
+	}
+}
+
+TEST_CASE("Coarser tiers average the samples of their intervals, skipping missing values")
+{
+	TempStoreDir dir;
+	const fs::path file = MetricStore::fileOf(dir.path, 0);
+	const std::array<StoreTier, 2> tiers{{{1s, 10min}, {1min, 1h}}};
+	auto store = writer(file, tiers);
+
+	for (int t = 0; t < 600; ++t) {
+		store->append(at(t), sampleAt(t));
+	}
+
+	const auto r = reader(file);
+	const StoreSeries minutes = r->query(1, at(0), at(600));
+	// Nine closed minutes and the one still being averaged
+	REQUIRE(minutes.rows() == 10);
+	CHECK(minutes.resolution == 1min);
+	for (std::size_t m = 0; m < minutes.rows(); ++m) {
+		CHECK(minutes.times[m] == msAt(60.0 * m));
+		double sum = 0.0;
+		double gappySum = 0.0;
+		int gappyCount = 0;
+		for (int t = 60 * static_cast<int>(m); t < 60 * static_cast<int>(m + 1); ++t) {
+			sum += sampleAt(t)[1];
+			if (!std::isnan(sampleAt(t)[2])) {
+				gappySum += sampleAt(t)[2];
+				++gappyCount;
+			}
+		}
+		CHECK(minutes.value(m, 0) == 55.0);
+		CHECK(std::abs(minutes.value(m, 1) - sum / 60.0) < 1e-9);
+		CHECK(std::abs(minutes.value(m, 2) - gappySum / gappyCount) < 1e-9);
+	}
+
+	// Several samples in one interval of the finest tier are averaged too
+	store->append(at(600.2), std::vector<double>{1.0, 2.0, NA});
+	store->append(at(600.7), std::vector<double>{3.0, 4.0, NA});
+	const StoreSeries last = r->query(0, at(600), at(601));
+	REQUIRE(last.rows() == 1);
+	CHECK(last.value(0, 0) == 2.0);
+	CHECK(last.value(0, 1) == 3.0);
+	CHECK(std::isnan(last.value(0, 2)));
+}
+
+TEST_CASE("Tiers keep their retention in a file that does not grow, and queries fall back to coarser tiers")
+{
+	TempStoreDir dir;
+	const fs::path file = MetricStore::fileOf(dir.path, 0);
+	const std::array<StoreTier, 3> tiers{{{1s, 5min}, {1min, 1h}, {1h, 24h}}};
+	auto store = writer(file, tiers);
+	const auto size = fs::file_size(file);
+
+	const int end = 3 * 3600;
+	for (int t = 0; t < end; ++t) {
+		store->append(at(t), sampleAt(t));
+	}
+	CHECK(fs::file_size(file) == size);
+
+	const auto r = reader(file);
+	const StoreSeries seconds = r->query(0, at(0), at(end));
+	// At least the retention, at most one more block
+	CHECK(seconds.rows() >= 300);
+	CHECK(seconds.rows() <= 6 * 64);
+	CHECK(seconds.times.back() == msAt(end - 1));
+	for (std::size_t i = 1; i < seconds.rows(); ++i) {
+		CHECK(seconds.times[i] - seconds.times[i - 1] == 1000);
+	}
+
+	// The last 2 min are in the finest tier; 2 h back only the minute tier reaches
+	CHECK(r->query(at(end - 120), at(end)).resolution == 1s);
+	const StoreSeries twoHours = r->query(at(end - 7200), at(end));
+	CHECK(twoHours.resolution == 1min);
+	CHECK(twoHours.rows() == 120);
+	// Before anything was dropped, the finest tier answers whatever is asked for
+	TempStoreDir fresh;
+	auto young = writer(MetricStore::fileOf(fresh.path, 0), tiers);
+	for (int t = 0; t < 200; ++t) {
+		young->append(at(t), sampleAt(t));
+	}
+	CHECK(young->query(at(-3600), at(200)).resolution == 1s);
+}
+
+TEST_CASE("Reopening a store continues it, and a store of other metrics is refused")
+{
+	TempStoreDir dir;
+	const fs::path file = MetricStore::fileOf(dir.path, 7);
+	const std::array<StoreTier, 2> tiers{{{1s, 10min}, {1min, 1h}}};
+	{
+		auto store = writer(file, tiers, 7);
+		for (int t = 0; t < 100; ++t) {
+			store->append(at(t), sampleAt(t));
+		}
+	}
+	{
+		auto store = writer(file, tiers, 7);
+		for (int t = 100; t < 200; ++t) {
+			store->append(at(t), sampleAt(t));
+		}
+		std::string error;
+		CHECK(MetricStore::create(file, 7, COLUMNS, tiers, error) == nullptr);
+		CHECK(error == "in use by another process");
+	}
+	const StoreSeries series = reader(file)->query(0, at(0), at(200));
+	REQUIRE(series.rows() == 200);
+	for (std::size_t i = 0; i < series.rows(); ++i) {
+		CHECK(same(series.value(i, 1), sampleAt(static_cast<int>(i))[1]));
+	}
+
+	std::string error;
+	const std::vector<std::string> other{"temperature.gpu"};
+	CHECK(MetricStore::create(file, 7, other, tiers, error) == nullptr);
+	CHECK(error == "store was recorded with other metrics or tiers");
+	CHECK(MetricStore::devicesIn(dir.path) == std::vector<uint32_t>{7});
+
+	std::ofstream(dir.path / "gpu1.xts") << "not a store";
+	CHECK(MetricStore::open(dir.path / "gpu1.xts", error) == nullptr);
+	CHECK(error == "file is not a metric store");
+}
+
+TEST_CASE("A damaged header copy or open block loses only what was written after the last good state")
+{
+	TempStoreDir dir;
+	const fs::path file = MetricStore::fileOf(dir.path, 0);
+	const std::array<StoreTier, 1> tiers{{{1s, 10min}}};
+	{
+		auto store = writer(file, tiers);
+		for (int t = 0; t < 100; ++t) {
+			store->append(at(t), sampleAt(t));
+		}
+	}
+	// The header copies are the two 8 KiB areas after the first page; 100 appends after
+	// the initial header leave copy 0 current. Tear it.
+	{
+		std::fstream f(file, std::ios::in | std::ios::out | std::ios::binary);
+		f.seekp(4096 + 40);
+		f.put('\x5a');
+	}
+	StoreSeries series = reader(file)->query(0, at(0), at(100));
+	// Copy 1 is one append older: 98 closed seconds and the 99th being averaged
+	REQUIRE(series.rows() == 99);
+	CHECK(series.times.back() == msAt(98));
+
+	// Tear the rows of the open block: 64 rows per block, so block 1 holds rows 64..
+	{
+		std::fstream f(file, std::ios::in | std::ios::out | std::ios::binary);
+		const std::size_t blocks = 4096 + 2 * 8192;
+		const std::size_t rowBits = 68 + COLUMNS.size() * 77;
+		const std::size_t blockBytes = (40 + (64 * rowBits + 7) / 8 + 7) / 8 * 8;
+		f.seekp(static_cast<std::streamoff>(blocks + blockBytes + 40 + 30));
+		f.put('\x5a');
+	}
+	series = reader(file)->query(0, at(0), at(100));
+	REQUIRE(series.rows() == 64 + 1);
+	CHECK(series.times[63] == msAt(63));
+
+	// The writer empties the damaged block and carries on from there
+	{
+		auto store = writer(file, tiers);
+		store->append(at(200), sampleAt(200));
+		store->append(at(201), sampleAt(201));
+	}
+	series = reader(file)->query(0, at(0), at(300));
+	REQUIRE(series.rows() == 64 + 2 + 1);
+	CHECK(series.times[64] == msAt(98));
+	CHECK(series.times[65] == msAt(200));
+}
+
+TEST_CASE("A writer killed at any point leaves a consistent store")
+{
+	TempStoreDir dir;
+	const fs::path file = MetricStore::fileOf(dir.path, 0);
+	const std::array<StoreTier, 2> tiers{{{1s, 2min}, {1min, 1h}}};
+	std::mt19937 rng(17);
+
+	int start = 0;
+	for (int round = 0; round < 8; ++round) {
+		const pid_t pid = fork();
+		REQUIRE(pid >= 0);
+		if (pid == 0) {
+			std::string error;
+			auto store = MetricStore::create(file, 0, COLUMNS, tiers, error);
+			for (int t = start; store != nullptr; ++t) {
+				store->append(at(t), std::vector<double>{static_cast<double>(t), 0.5 * t, NA});
+			}
+			_exit(1);
+		}
+		usleep(1000 + rng() % 20000);
+		kill(pid, SIGKILL);
+		int status = 0;
+		waitpid(pid, &status, 0);
+
+		const StoreSeries series = reader(file)->query(0, at(0), at(1e9));
+		REQUIRE(series.rows() > 0);
+		for (std::size_t i = 0; i < series.rows(); ++i) {
+			const double t = series.value(i, 0);
+			CHECK(series.times[i] == msAt(t));
+			CHECK(series.value(i, 1) == 0.5 * t);
+			if (i > 0) {
+				CHECK(series.times[i] > series.times[i - 1]);
+			}
+		}
+		start = static_cast<int>(series.value(series.rows() - 1, 0)) + 1;
+	}
+}
+
+TEST_CASE("StoreRecorder writes one store per device with numeric columns")
+{
+	TempStoreDir dir;
+	const auto fields = resolveQuery("temperature.gpu");
+	const std::vector<const QueryMetric *> both{fields[0], resolveQuery("clocks.throttle.reason")[0]};
+	double now = 0;
+	StoreRecorder recorder(dir.path / "metrics", both, DEFAULT_STORE_TIERS, [&] { return at(now); });
+	static_assert(MetricOutput<StoreRecorder>);
+
+	for (; now < 5; now += 1) {
+		for (const uint32_t index : {0U, 3U}) {
+			devInfo dev{index, nullptr, nullptr, nullptr};
+			recorder.onBegin(std::span<const QueryMetric *>());
+			recorder.onBeginDevice(dev);
+			recorder.onMetric(*both[0], MetricValue::real(40.0 + index + now, 1));
+			recorder.onMetric(*both[1], MetricValue("None"));
+			recorder.onEndDevice(dev);
+			recorder.onEnd();
+		}
+	}
+	CHECK(recorder.error().empty());
+	REQUIRE(MetricStore::devicesIn(dir.path / "metrics") == std::vector<uint32_t>{0, 3});
+
+	const auto store = reader(MetricStore::fileOf(dir.path / "metrics", 3));
+	CHECK(store->device() == 3);
+	CHECK(store->columns() == std::vector<std::string>{"temperature.gpu", "clocks.throttle.reason"});
+	const StoreSeries series = store->query(at(0), at(10));
+	REQUIRE(series.rows() == 5);
+	CHECK(series.value(4, 0) == 47.0);
+	CHECK(std::isnan(series.value(4, 1)));
+}
+
+TEST_CASE("parseStoreDuration reads seconds, minutes, hours and days")
+{
+	CHECK(parseStoreDuration("90") == 90s);
+	CHECK(parseStoreDuration("15m") == 15min);
+	CHECK(parseStoreDuration("2h") == 2h);
+	CHECK(parseStoreDuration("30d") == std::chrono::hours(24 * 30));
+	CHECK_FALSE(parseStoreDuration("").has_value());
+	CHECK_FALSE(parseStoreDuration("0m").has_value());
+	CHECK_FALSE(parseStoreDuration("-5").has_value());
+	CHECK_FALSE(parseStoreDuration("5w").has_value());
+	CHECK_FALSE(parseStoreDuration("99999999999d").has_value());
+}
@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ * Unit tests for metric_window.cpp: the windowed aggregates behind dump --aggregate
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#ifdef INFO
+#undef INFO
+#endif
+
+#include "metric_window.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace metrics; // NOLINT(google-build-using-namespace)
+
+namespace {
+
+/** @brief MetricOutput recording every row as "device: name=value ..." */
+struct RowRecorder
+{
+	std::vector<std::string> rows;
+	std::vector<std::string> header;
+
+	void onBegin(std::span<const QueryMetric *> fields)
+	{
+		header.clear();
+		for (const QueryMetric *f : fields) {
+			header.emplace_back(f->name);
+		}
+	}
+	void onBeginDevice(devInfo &dev) { rows.push_back(std::to_string(dev.index) + ":"); }
+	void onMetric(const QueryMetric &f, const MetricValue &val)
+	{
+		rows.back() += " " + std::string(f.name) + "=" + val.toString();
+	}
+	void onEndDevice(devInfo & /*unused*/) {}
+	void onEnd() {}
+};
+
+static_assert(MetricOutput<RowRecorder>);
+static_assert(MetricOutput<WindowAggregator>);
+
+QueryMetric field(std::string_view name, std::string_view unit = {})
+{
+	QueryMetric f{};
+	f.name = name;
+	f.unit = unit;
+	return f;
+}
+
+const QueryMetric POWER_FIELD = field("power.draw", "W");
+const QueryMetric CLOCK_FIELD = field("clocks.gr", "MHz");
+const QueryMetric NAME_FIELD = field("name");
+
+/** @brief One tick of runMetricsWithCaches() for @p dev with one value per field */
+void sample(WindowAggregator &aggregator, std::span<const QueryMetric *> fields, devInfo dev,
+			const std::vector<MetricValue> &values)
+{
+	aggregator.onBegin(fields);
+	aggregator.onBeginDevice(dev);
+	for (std::size_t i = 0; i < fields.size(); ++i) {
+		aggregator.onMetric(*fields[i], values[i]);
+	}
+	aggregator.onEndDevice(dev);
+	aggregator.onEnd();
+}
+
+} // namespace
+
+TEST_CASE("QuantileSketch reports quantiles within its relative accuracy")
+{
+	std::mt19937 rng(7);
+	std::lognormal_distribution<double> dist(5.0, 1.5);
+	std::vector<double> values(20000);
+	QuantileSketch sketch;
+	for (double &v : values) {
+		v = dist(rng);
+		sketch.add(v);
+	}
+	std::ranges::sort(values);
+	CHECK(sketch.count() == values.size());
+
+	for (const double q : {0.0, 0.1, 0.5, 0.9, 0.95, 0.99, 1.0}) {
+		const auto rank = std::max<std::size_t>(1, static_cast<std::size_t>(std::ceil(q * values.size() - 1e-9)));
+		const double exact = values[rank - 1];
+		CHECK(std::fabs(sketch.quantile(q) - exact) <= exact * 0.01 + 1e-12);
+	}
+}
+
+TEST_CASE("QuantileSketch orders negative values, zero and positive values and keeps the extremes exact")
+{
+	QuantileSketch sketch;
+	for (const double v : {-100.0, -1.0, 0.0, 0.0, 1.0, 100.0, std::nan("")}) {
+		sketch.add(v);
+	}
+	CHECK(sketch.count() == 6);
+	CHECK(sketch.quantile(0.0) == -100.0);
+	CHECK(sketch.quantile(0.5) == 0.0);
+	CHECK(sketch.quantile(1.0) == 100.0);
+
+	sketch.clear();
+	CHECK(sketch.count() == 0);
+	CHECK(std::isnan(sketch.quantile(0.5)));
+	sketch.add(42.0);
+	CHECK(sketch.quantile(0.95) == 42.0);
+}
+
+TEST_CASE("MetricWindow keeps min, max, mean, p95 and last of a window")
+{
+	MetricWindow window;
+	CHECK_FALSE(window.min().available());
+	CHECK_FALSE(window.percentile(0.95).available());
+
+	// 19 quiet samples and one spike: the spike is the max, the p95 stays with the rest
+	for (int i = 0; i < 19; ++i) {
+		window.add(MetricValue::integer(uint64_t{1000}));
+	}
+	window.add(MetricValue::integer(uint64_t{1600}));
+	window.add(MetricValue{});
+
+	CHECK(window.count() == 20);
+	CHECK(window.min().toString() == "1000");
+	CHECK(window.max().toString() == "1600");
+	CHECK(window.mean().toString() == "1030.00");
+	CHECK(window.percentile(0.95).toString() == "1000");
+	CHECK(window.percentile(1.0).toString() == "1600");
+	CHECK(window.last().toString() == "1600");
+
+	window.clear();
+	CHECK(window.count() == 0);
+	CHECK_FALSE(window.last().available());
+}
+
+TEST_CASE("MetricWindow keeps the precision of real values and only the last text")
+{
+	MetricWindow power;
+	power.add(MetricValue::real(100.25, 2));
+	power.add(MetricValue::real(300.75, 2));
+	CHECK(power.mean().toString() == "200.50");
+	CHECK(power.max().toString() == "300.75");
+
+	MetricWindow name;
+	name.add(MetricValue("Intel(R) Data Center GPU"));
+	CHECK(name.count() == 0);
+	CHECK_FALSE(name.mean().available());
+	CHECK(name.last().toString() == "Intel(R) Data Center GPU");
+}
+
+TEST_CASE("WindowAggregator writes one row per device per flush")
+{
+	std::vector<const QueryMetric *> source{&POWER_FIELD, &CLOCK_FIELD, &NAME_FIELD};
+	WindowAggregator aggregator(source);
+
+	const auto fields = aggregator.fields();
+	REQUIRE(fields.size() == 15);
+	CHECK(fields[0]->name == "power.draw.min");
+	CHECK(fields[3]->name == "power.draw.p95");
+	CHECK(fields[3]->unit == "W");
+	CHECK(fields[9]->name == "clocks.gr.last");
+	CHECK(fields[14]->name == "name.last");
+	CHECK_FALSE(aggregator.pending());
+
+	const devInfo gpu0{0, nullptr, nullptr, nullptr};
+	const devInfo gpu1{1, nullptr, nullptr, nullptr};
+	for (int i = 1; i <= 10; ++i) {
+		sample(aggregator, source, gpu0,
+			   {MetricValue::real(10.0 * i, 1), MetricValue::integer(uint64_t{1000}), MetricValue("gpu0")});
+		sample(aggregator, source, gpu1, {MetricValue{}, MetricValue::integer(uint64_t{1100}), MetricValue("gpu1")});
+	}
+	CHECK(aggregator.pending());
+
+	RowRecorder recorder;
+	aggregator.flush(recorder);
+	CHECK_FALSE(aggregator.pending());
+	REQUIRE(recorder.rows.size() == 2);
+	CHECK(recorder.header.size() == 15);
+	CHECK(recorder.rows[0] == "0: power.draw.min=10.0 power.draw.max=100.0 power.draw.avg=55.0 power.draw.p95=100.0"
+							  " power.draw.last=100.0 clocks.gr.min=1000 clocks.gr.max=1000 clocks.gr.avg=1000.00"
+							  " clocks.gr.p95=1000 clocks.gr.last=1000 name.min=N/A name.max=N/A name.avg=N/A"
+							  " name.p95=N/A name.last=gpu0");
+	CHECK(recorder.rows[1].starts_with("1: power.draw.min=N/A power.draw.max=N/A power.draw.avg=N/A"));
+
+	// The next window starts empty; a device no longer sampled gets no row
+	sample(aggregator, source, gpu1,
+		   {MetricValue::real(50.0, 1), MetricValue::integer(uint64_t{1200}), MetricValue("gpu1")});
+	recorder.rows.clear();
+	aggregator.flush(recorder);
+	REQUIRE(recorder.rows.size() == 1);
+	CHECK(recorder.rows[0].starts_with("1: power.draw.min=50.0 power.draw.max=50.0"));
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Throughput benchmark for the metric evaluation pipeline.
+//
+// Runs runMetricsWithCaches() over synthetic devices and fields and renders every
+// value into a reused CSV line, the same way DumpOutput does per tick. The legacy
+// path (format each value into a fresh std::string) is timed alongside for
+// comparison. Run with `meson test --benchmark metrics_bench`.
+
+#include "metrics_registry.h"
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <format>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace metrics; // NOLINT(google-build-using-namespace)
+
+namespace {
+
+constexpr std::size_t DEVICE_COUNT = 8;
+constexpr int TICKS = 20000;
+
+template <int N> ze_result_t realGetter(devInfo &d, MetricValue &out, const MetricCache &)
+{
+	out = MetricValue::real(static_cast<double>(d.index * 100 + N) / 7.0, 2);
+	return ZE_RESULT_SUCCESS;
+}
+
+template <int N> ze_result_t integerGetter(devInfo &d, MetricValue &out, const MetricCache &)
+{
+	out = MetricValue::integer(static_cast<uint64_t>(d.index) * 1'000'003ULL + N);
+	return ZE_RESULT_SUCCESS;
+}
+
+constexpr auto makeMetric(std::string_view name, ze_result_t (*getter)(devInfo &, MetricValue &, const MetricCache &))
+{
+	return QueryMetric{.name = name,
+					   .unit = "",
+					   .description = "",
+					   .source = MetricSource::Live,
+					   .groups = MetricGroup::NONE,
+					   .getter = getter};
+}
+
+constexpr auto METRICS = std::to_array<QueryMetric>({
+	makeMetric("bench.r0", realGetter<0>),
+	makeMetric("bench.r1", realGetter<1>),
+	makeMetric("bench.r2", realGetter<2>),
+	makeMetric("bench.r3", realGetter<3>),
+	makeMetric("bench.i0", integerGetter<0>),
+	makeMetric("bench.i1", integerGetter<1>),
+	makeMetric("bench.i2", integerGetter<2>),
+	makeMetric("bench.i3", integerGetter<3>),
+});
+
+/// Typed sink: renders each value straight into one reused line buffer.
+struct TypedCsvOutput
+{
+	std::string line;
+	std::size_t bytes = 0;
+
+	void onBegin(std::span<const QueryMetric *>) {}
+	void onBeginDevice(devInfo &) { line.clear(); }
+	void onMetric(const QueryMetric &, const MetricValue &val)
+	{
+		if (!line.empty()) {
+			line += ", ";
+		}
+		val.appendTo(line);
+	}
+	void onEndDevice(devInfo &) { bytes += line.size(); }
+	void onEnd() {}
+};
+
+/// Legacy sink: every value becomes its own std::string, then a row vector is joined.
+struct StringCsvOutput
+{
+	std::vector<std::string> row;
+	std::size_t bytes = 0;
+
+	void onBegin(std::span<const QueryMetric *>) {}
+	void onBeginDevice(devInfo &) { row.clear(); }
+	void onMetric(const QueryMetric &, const MetricValue &val) { row.push_back(val.toString()); }
+	void onEndDevice(devInfo &)
+	{
+		std::string line;
+		for (const auto &cell : row) {
+			line += line.empty() ? cell : ", " + cell;
+		}
+		bytes += line.size();
+	}
+	void onEnd() {}
+};
+
+template <typename Output> double nsPerField(Output &out, std::span<const QueryMetric *> fields, std::span<devInfo> devs)
+{
+	const std::vector<MetricCache> caches(devs.size());
+	const auto start = std::chrono::steady_clock::now();
+	for (int t = 0; t < TICKS; ++t) {
+		runMetricsWithCaches(out, fields, devs, std::span<const MetricCache>(caches));
+	}
+	const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+	return elapsed.count() / static_cast<double>(TICKS * fields.size() * devs.size());
+}
+
+} // namespace
+
+int main()
+{
+	std::vector<devInfo> devices;
+	for (uint32_t i = 0; i < DEVICE_COUNT; ++i) {
+		devices.push_back(devInfo{i, nullptr, nullptr, nullptr});
+	}
+	std::vector<const QueryMetric *> fields;
+	for (const auto &m : METRICS) {
+		fields.push_back(&m);
+	}
+
+	TypedCsvOutput typed;
+	StringCsvOutput legacy;
+	const double typedNs = nsPerField(typed, fields, devices);
+	const double legacyNs = nsPerField(legacy, fields, devices);
+
+	std::printf("%zu devices x %zu fields x %d ticks\n", devices.size(), fields.size(), TICKS);
+	std::printf("typed values, reused buffer : %8.1f ns/field (%zu bytes)\n", typedNs, typed.bytes);
+	std::printf("per-value std::string      : %8.1f ns/field (%zu bytes)\n", legacyNs, legacy.bytes);
+
+	// Both sinks must render identical text
+	return typed.bytes == legacy.bytes ? 0 : 1;
+}
@@ -11,6 +11,7 @@
 #undef INFO
 #endif
 
+#include "fabric_telemetry.h"
 #include "metrics_registry.h"
 #include "metrics/temperature_metrics.h"
 #include "metrics/utilization.h"
@@ -19,6 +20,7 @@
 #include "metrics/power.h"
 #include <algorithm>
 #include <array>
+#include <memory>
 #include <ranges>
 #include <span>
 #include <string>
@@ -83,6 +85,116 @@ TEST_CASE("formatGroups emits canonical group names")
 
 TEST_CASE("formatGroups returns empty string for NONE") { CHECK(formatGroups(MetricGroup::NONE).empty()); }
 
+// ── MetricValue ───────────────────────────────────────────────────────────────
+
+TEST_CASE("MetricValue defaults to N/A")
+{
+	const MetricValue v;
+	CHECK_FALSE(v.available());
+	CHECK(v.kind() == MetricValue::Kind::NotAvailable);
+	CHECK(v == "N/A");
+}
+
+TEST_CASE("MetricValue formats integers, reals and text at the output edge")
+{
+	CHECK(MetricValue::integer(-5) == "-5");
+	CHECK(MetricValue::integer(-5).kind() == MetricValue::Kind::Signed);
+	CHECK(MetricValue::integer(uint64_t{18446744073709551615ULL}) == "18446744073709551615");
+	CHECK(MetricValue::integer(uint64_t{7}).kind() == MetricValue::Kind::Unsigned);
+	CHECK(MetricValue::real(1.0, 2) == "1.00");
+	CHECK(MetricValue::real(12.345, 1) == "12.3");
+	CHECK(MetricValue::real(0.5) == "0.5");
+	CHECK(MetricValue::real(0.5).precision() == -1);
+	CHECK(MetricValue("Enabled") == "Enabled");
+	CHECK(MetricValue(std::string{"0000:03:00.0"}).kind() == MetricValue::Kind::Text);
+}
+
+TEST_CASE("MetricValue compares values longer than any short buffer")
+{
+	const MetricValue huge = MetricValue::real(1e300, 17);
+	const std::string formatted = huge.toString();
+	CHECK(formatted.size() > 300);
+	CHECK(huge == formatted);
+	CHECK_FALSE(huge == "1");
+}
+
+TEST_CASE("MetricValue appendTo writes into an existing buffer")
+{
+	std::string buf{"x="};
+	MetricValue::real(2.5, 2).appendTo(buf);
+	buf += ',';
+	MetricValue{}.appendTo(buf);
+	CHECK(buf == "x=2.50,N/A");
+}
+
+TEST_CASE("MetricValue reset returns to N/A and clears text")
+{
+	MetricValue v{std::string(64, 'a')};
+	v.reset();
+	CHECK_FALSE(v.available());
+	CHECK(v.text().empty());
+	v = MetricValue::integer(3);
+	CHECK(v == "3");
+}
+
+namespace {
+
+/// MetricOutput sink that records the values it receives.
+struct RecordingOutput
+{
+	std::vector<std::string> values;
+	std::vector<MetricValue::Kind> kinds;
+
+	void onBegin(std::span<const QueryMetric *>) {}
+	void onBeginDevice(devInfo &) {}
+	void onMetric(const QueryMetric &, const MetricValue &val)
+	{
+		values.push_back(val.toString());
+		kinds.push_back(val.kind());
+	}
+	void onEndDevice(devInfo &) {}
+	void onEnd() {}
+};
+
+constexpr QueryMetric TYPED_REAL{.name = "test.real",
+								 .unit = "W",
+								 .description = "",
+								 .source = MetricSource::Live,
+								 .groups = MetricGroup::NONE,
+								 .getter = [](devInfo &, MetricValue &out, const MetricCache &) -> ze_result_t {
+									 out = MetricValue::real(3.14159, 2);
+									 return ZE_RESULT_SUCCESS;
+								 }};
+
+constexpr QueryMetric TYPED_FAILING{.name = "test.failing",
+									.unit = "",
+									.description = "",
+									.source = MetricSource::Live,
+									.groups = MetricGroup::NONE,
+									.getter = [](devInfo &, MetricValue &out, const MetricCache &) -> ze_result_t {
+										out = MetricValue::integer(1); // partial write before failing
+										return ZE_RESULT_ERROR_UNSUPPORTED_FEATURE;
+									}};
+
+} // namespace
+
+TEST_CASE("runMetricsWithCaches passes typed values and N/A for failed getters")
+{
+	devInfo di{0, nullptr, nullptr, nullptr};
+	std::array<const QueryMetric *, 2> fields{&TYPED_REAL, &TYPED_FAILING};
+	const std::array<MetricCache, 1> caches{};
+	RecordingOutput out;
+
+	runMetricsWithCaches(out, std::span<const QueryMetric *>(fields), std::span<devInfo>(&di, 1),
+						 std::span<const MetricCache>(caches));
+
+	REQUIRE(out.values.size() == 2U);
+	CHECK(out.values[0] == "3.14");
+	CHECK(out.kinds[0] == MetricValue::Kind::Real);
+	CHECK(out.values[1] == "N/A");
+	CHECK(out.kinds[1] == MetricValue::Kind::NotAvailable);
+}
+
 // ── Shared fixture ────────────────────────────────────────────────────────────
 // A zero-initialised device has default-constructed HAL sub-objects.
 // All HAL calls fail gracefully and write zeros, so availability flags stay false.
@@ -301,6 +413,25 @@ TEST_CASE("Fan group contains exactly 1 canonical entry")
 	CHECK(byFan.size() == 1);
 }
 
+TEST_CASE("Process group contains exactly 3 canonical entries")
+{
+	const auto byProcess = getMetricsByGroup(MetricGroup::PROCESS);
+	CHECK(byProcess.size() == 3);
+	CHECK(hasGroup(parseGroupMask("process"), MetricGroup::PROCESS));
+	CHECK(needsProcessSampling(byProcess));
+	CHECK_FALSE(needsProcessSampling(getMetricsByGroup(MetricGroup::POWER)));
+}
+
+TEST_CASE("Fabric group contains exactly 5 canonical entries")
+{
+	const auto byFabric = getMetricsByGroup(MetricGroup::FABRIC);
+	CHECK(byFabric.size() == 35); // 3 totals + rx/tx of 16 port slots
+	CHECK(hasGroup(parseGroupMask("fabric"), MetricGroup::FABRIC));
+	CHECK(needsFabricSampling(byFabric));
+	CHECK_FALSE(needsFabricSampling(getMetricsByGroup(MetricGroup::PCI)));
+	CHECK_FALSE(needsProcessSampling(byFabric));
+}
+
 TEST_CASE("findMetric resolves Memory metric names")
 {
 	CHECK(findMetric("memory.total").has_value());
@@ -473,6 +604,33 @@ TEST_CASE_FIXTURE(ZeroDeviceFixture, "power.draw getter: computes watts (delta 2
 	CHECK(out == "1.00");
 }
 
+TEST_CASE_FIXTURE(ZeroDeviceFixture, "power.draw getter: counts the energy across a counter wrap")
+{
+	MetricValue out;
+	MetricCache c;
+	c.cardPowerBefore = {.energy = UINT64_MAX - 999'999, .ts = 1};
+	c.cardPowerAfter = {.energy = 1'000'000, .ts = 2'000'001};
+	CHECK(findMetric("power.draw").value().getter(di, out, c) == ZE_RESULT_SUCCESS);
+	CHECK(out == "1.00");
+}
+
+TEST_CASE_FIXTURE(ZeroDeviceFixture, "utilization.gpu getter: active time over elapsed time, N/A across a reset")
+{
+	MetricValue out;
+	MetricCache c;
+	c.engines.all.before = {.active = 1'000, .ts = 10'000};
+	c.engines.all.after = {.active = 26'000, .ts = 110'000};
+	CHECK(findMetric("utilization.gpu").value().getter(di, out, c) == ZE_RESULT_SUCCESS);
+	CHECK(out == "25.00");
+
+	c.engines.all.after.active = 500;
+	CHECK(findMetric("utilization.gpu").value().getter(di, out, c) == ZE_RESULT_SUCCESS);
+	CHECK(out == "N/A");
+
+	c.engines.all.after.ts = c.engines.all.before.ts;
+	CHECK(findMetric("utilization.gpu").value().getter(di, out, c) == ZE_RESULT_ERROR_UNSUPPORTED_FEATURE);
+}
+
 TEST_CASE_FIXTURE(ZeroDeviceFixture, "power.draw.gpu getter: UNSUPPORTED when gpuPowerBefore.ts is zero")
 {
 	MetricValue out;
@@ -534,6 +692,82 @@ TEST_CASE_FIXTURE(ZeroDeviceFixture, "energy.consumed getter: zero energy format
 	CHECK(out == "0.00");
 }
 
+TEST_CASE_FIXTURE(ZeroDeviceFixture, "process getters: UNSUPPORTED when processes were not sampled")
+{
+	MetricValue out;
+	const MetricCache c;
+	CHECK(findMetric("process.count").value().getter(di, out, c) == ZE_RESULT_ERROR_UNSUPPORTED_FEATURE);
+	CHECK(findMetric("process.top.pid").value().getter(di, out, c) == ZE_RESULT_ERROR_NOT_AVAILABLE);
+}
+
+TEST_CASE_FIXTURE(ZeroDeviceFixture, "process getters: report the busiest process")
+{
+	MetricValue out;
+	MetricCache c;
+	c.processAvail = true;
+	c.processes = {
+		{.pid = 10, .residentBytes = 0, .engines = {{"render", {.percent = 12.5, .capacity = 1}}}},
+		{.pid = 20, .residentBytes = 0, .engines = {{"compute", {.percent = 80.25, .capacity = 4}}}},
+		{.pid = 30, .residentBytes = 4096, .engines = {}},
+	};
+	CHECK(findMetric("process.count").value().getter(di, out, c) == ZE_RESULT_SUCCESS);
+	CHECK(out == "3");
+	CHECK(findMetric("process.top.pid").value().getter(di, out, c) == ZE_RESULT_SUCCESS);
+	CHECK(out == "20");
+	CHECK(findMetric("process.top.utilization").value().getter(di, out, c) == ZE_RESULT_SUCCESS);
+	CHECK(out == "80.25");
+}
+
+TEST_CASE_FIXTURE(ZeroDeviceFixture, "fabric getters: UNSUPPORTED when fabric was not sampled")
+{
+	MetricValue out;
+	const MetricCache c;
+	CHECK(findMetric("fabric.rx.throughput").value().getter(di, out, c) == ZE_RESULT_ERROR_UNSUPPORTED_FEATURE);
+	CHECK(findMetric("fabric.port0.tx.throughput").value().getter(di, out, c) == ZE_RESULT_ERROR_UNSUPPORTED_FEATURE);
+	CHECK(findMetric("fabric.link.utilization").value().getter(di, out, c) == ZE_RESULT_ERROR_UNSUPPORTED_FEATURE);
+}
+
+TEST_CASE_FIXTURE(ZeroDeviceFixture, "fabric getters: sum ports, report each port and the busiest")
+{
+	MetricValue out;
+	MetricCache c;
+	c.fabricAvail = true;
+	const auto port = [](uint8_t number, double rx, std::optional<double> tx, uint64_t rxCap, uint64_t txCap) {
+		fabric_telemetry::PortRate r;
+		r.portId = {.fabricId = 1, .attachId = 0, .portNumber = number};
+		r.rxBytesPerSec = rx;
+		r.txBytesPerSec = tx;
+		r.rxCapacity = rxCap;
+		r.txCapacity = txCap;
+		return r;
+	};
+	c.fabricRates = std::make_shared<const std::vector<fabric_telemetry::PortRate>>(
+		std::vector{port(3, 2.5e6, 1e9, 10000000, 4000000000), port(4, 0.5e6, std::nullopt, 0, 0)});
+	CHECK(findMetric("fabric.rx.throughput").value().getter(di, out, c) == ZE_RESULT_SUCCESS);
+	CHECK(out == "3.00");
+	// One port has no rate for the window, so neither has the device
+	CHECK(findMetric("fabric.tx.throughput").value().getter(di, out, c) == ZE_RESULT_NOT_READY);
+	CHECK(findMetric("fabric.port0.tx.throughput").value().getter(di, out, c) == ZE_RESULT_SUCCESS);
+	CHECK(out == "1000.00");
+	CHECK(findMetric("fabric.port1.rx.throughput").value().getter(di, out, c) == ZE_RESULT_SUCCESS);
+	CHECK(out == "0.50");
+	CHECK(findMetric("fabric.port1.tx.throughput").value().getter(di, out, c) == ZE_RESULT_NOT_READY);
+	CHECK(findMetric("fabric.port2.rx.throughput").value().getter(di, out, c) == ZE_RESULT_ERROR_UNSUPPORTED_FEATURE);
+	CHECK(findMetric("fabric.port15.tx.throughput").has_value());
+	CHECK_FALSE(findMetric("fabric.port16.tx.throughput").has_value());
+	CHECK(findMetric("fabric.link.utilization").value().getter(di, out, c) == ZE_RESULT_SUCCESS);
+	CHECK(out == "25.00");
+
+	// Ports without a maximum speed never have a utilization; without a rate they have none yet
+	c.fabricRates = std::make_shared<const std::vector<fabric_telemetry::PortRate>>(
+		std::vector{port(3, 2.5e6, 1e9, 0, 0)});
+	CHECK(findMetric("fabric.link.utilization").value().getter(di, out, c) == ZE_RESULT_ERROR_UNSUPPORTED_FEATURE);
+	auto idle = port(3, 0, std::nullopt, 10000000, 4000000000);
+	idle.rxBytesPerSec.reset();
+	c.fabricRates = std::make_shared<const std::vector<fabric_telemetry::PortRate>>(std::vector{idle});
+	CHECK(findMetric("fabric.link.utilization").value().getter(di, out, c) == ZE_RESULT_NOT_READY);
+}
+
 TEST_CASE("MetricCache default values are zero and all flags false")
 {
 	const MetricCache cache;
@@ -587,6 +821,21 @@ TEST_CASE_FIXTURE(ZeroDeviceFixture, "populateMetricCacheEnd: availability flags
 	CHECK_FALSE(cache.powerAvail);
 }
 
+TEST_CASE_FIXTURE(ZeroDeviceFixture, "populateMetricCacheEnd: fabric is only read when asked for, and carries over")
+{
+	MetricCache cache = populateMetricCacheBegin(di);
+	populateMetricCacheEnd(di, cache);
+	CHECK_FALSE(cache.fabricSampled);
+
+	cache = populateMetricCacheBegin(di, false, true);
+	populateMetricCacheEnd(di, cache);
+	CHECK(cache.fabricSampled);
+	// No device handle: no port counters
+	CHECK_FALSE(cache.fabricAvail);
+	CHECK(cache.fabricRates == nullptr);
+	CHECK(populateMetricCacheContinuous(di, cache).fabricSampled);
+}
+
 TEST_CASE_FIXTURE(ZeroDeviceFixture,
 				  "populateMetricCacheEnd: stale euAvail/euSample are cleared even when HAL call fails")
 {
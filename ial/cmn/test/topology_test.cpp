@@ -21,8 +21,11 @@ std::string progName = "test";
 // the NIC-related public surface: TopoNode, TopoNodeKind, and determineLinkType.
 // discoverNics lives in the oal_lin library and can be called directly.
 #include "cmd_topology.h"
+#include "dmi_reader.h"
 #include "topology.h"
 
+#include <chrono>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <optional>
@@ -569,3 +572,268 @@ TEST_SUITE("getPciePaths")
 		CHECK(result.at(bdf1)[1].bdf == "0000:00:1d.0");
 	}
 }
+
+// ─── PcieTree tests ───────────────────────────────────────────────────────────
+
+TEST_SUITE("PcieTree")
+{
+	TEST_CASE("Shared prefixes reuse tree nodes")
+	{
+		PcieTree tree;
+		const auto a = tree.insert(makePath("pci0000:00", "0000:00:1c.0", "0000:01:00.0"));
+		const auto b = tree.insert(makePath("pci0000:00", "0000:00:1c.0", "0000:01:00.0"));
+		CHECK(a == b);
+		CHECK(tree.size() == 4U); // virtual root + 3 hops
+	}
+
+	TEST_CASE("Common depth matches shared bridge count")
+	{
+		PcieTree tree;
+		const auto sw0 = tree.insert(makePath("pci0000:00", "0000:00:1c.0", "0000:01:00.0"));
+		const auto sw1 = tree.insert(makePath("pci0000:00", "0000:00:1c.0", "0000:02:00.0"));
+		const auto rp = tree.insert(makePath("pci0000:00", "0000:00:1d.0"));
+		const auto other = tree.insert(makePath("pci0000:80", "0000:80:01.0"));
+
+		CHECK(tree.commonDepth(sw0, sw0) == 3U);
+		CHECK(tree.commonDepth(sw0, sw1) == 2U);
+		CHECK(tree.commonDepth(sw1, rp) == 1U);
+		CHECK(tree.commonDepth(rp, sw0) == 1U);
+		CHECK(tree.commonDepth(sw0, other) == 0U);
+	}
+
+	TEST_CASE("Tree classification agrees with path comparison")
+	{
+		const std::vector<PciePath> paths = {
+			makePath("pci0000:00", "0000:00:1c.0", "0000:01:00.0"),
+			makePath("pci0000:00", "0000:00:1c.0", "0000:02:00.0"),
+			makePath("pci0000:00", "0000:00:1d.0"),
+			makePath("pci0000:80", "0000:80:01.0"),
+		};
+
+		PcieTree tree;
+		std::vector<TopoNode> nodes;
+		std::vector<size_t> treeNodes;
+		for (int i = 0; i < static_cast<int>(paths.size()); ++i) {
+			nodes.push_back(makeGpu({.deviceId = i, .tileId = 0, .numaNode = 0, .pciePath = paths[i]}));
+			treeNodes.push_back(tree.insert(paths[i]));
+		}
+
+		for (size_t r = 0; r < nodes.size(); ++r) {
+			for (size_t c = 0; c < nodes.size(); ++c) {
+				CHECK(cmdTopology::determineLinkType(nodes[r], nodes[c],
+													 tree.commonDepth(treeNodes[r], treeNodes[c])) ==
+					  cmdTopology::determineLinkType(nodes[r], nodes[c]));
+			}
+		}
+	}
+}
+
+// ─── Topology model tests ─────────────────────────────────────────────────────
+
+TEST_SUITE("TopologyModel")
+{
+	/// Fake sysfs with two GPUs behind one switch, and one NIC on another root port.
+	struct FakeSysfs
+	{
+		TempDir tmp;
+		SysfsPaths paths;
+
+		FakeSysfs()
+		{
+			paths = SysfsPaths{.netRoot = tmp.path / "net", .pciDevRoot = tmp.path / "pci", .nodeRoot = tmp.path / "node"};
+			addDevice("0000:03:00.0", {"pci0000:00", "0000:00:1c.0", "0000:01:00.0"}, "0");
+			addDevice("0000:04:00.0", {"pci0000:00", "0000:00:1c.0", "0000:01:00.0"}, "0");
+			addDevice("0000:05:00.0", {"pci0000:00", "0000:00:1d.0"}, "1");
+			createSymlink(paths.pciDevRoot / "0000:05:00.0", paths.netRoot / "eth0" / "device");
+			writeFile(paths.pciDevRoot / "0000:05:00.0" / "local_cpulist", "0-15\n");
+			writeFile(paths.nodeRoot / "possible", "0-1\n");
+		}
+
+		void addDevice(const std::string &bdf, const std::vector<std::string> &bridges, const std::string &numa)
+		{
+			std::filesystem::path realDir = tmp.path / "devices";
+			for (const auto &seg : bridges) {
+				realDir /= seg;
+			}
+			realDir /= bdf;
+			std::filesystem::create_directories(realDir);
+			writeFile(realDir / "numa_node", numa + "\n");
+			createSymlink(realDir, paths.pciDevRoot / bdf);
+		}
+	};
+
+	TEST_CASE("Model includes discovered NICs and resolves all BDFs")
+	{
+		const FakeSysfs sys;
+		const auto model = buildTopologyModel({"0000:03:00.0", "0000:04:00.0"}, sys.paths);
+
+		REQUIRE(model.nics.has_value());
+		REQUIRE(model.nics->size() == 1U);
+		CHECK(model.nics->front().bdfAddress == "0000:05:00.0");
+		CHECK(model.bdfs == std::vector<std::string>{"0000:03:00.0", "0000:04:00.0", "0000:05:00.0"});
+		CHECK(model.numaNodes.at("0000:05:00.0") == 1);
+		CHECK(model.pciePaths.at("0000:03:00.0").size() == 3U);
+		CHECK(model.fingerprint == computePciFingerprint(sys.paths));
+	}
+
+	TEST_CASE("Fingerprint changes when a device is added")
+	{
+		FakeSysfs sys;
+		const auto before = computePciFingerprint(sys.paths);
+		CHECK(before == computePciFingerprint(sys.paths));
+		sys.addDevice("0000:06:00.0", {"pci0000:00", "0000:00:1e.0"}, "0");
+		CHECK(before != computePciFingerprint(sys.paths));
+	}
+
+	TEST_CASE("Persisted model round-trips")
+	{
+		const FakeSysfs sys;
+		const auto cacheFile = sys.tmp.path / "topology.cache";
+		const auto model = buildTopologyModel({"0000:03:00.0"}, sys.paths);
+		REQUIRE(saveTopologyModel(model, cacheFile));
+
+		const auto loaded = readTopologyModel(cacheFile);
+		REQUIRE(loaded.has_value());
+		CHECK(loaded->fingerprint == model.fingerprint);
+		CHECK(loaded->bdfs == model.bdfs);
+		CHECK(loaded->numaNodes == model.numaNodes);
+		CHECK(loaded->pciePaths == model.pciePaths);
+		REQUIRE(loaded->nics.has_value());
+		CHECK(loaded->nics->front().name == "eth0");
+		CHECK(loaded->nics->front().cpuAffinity == "0-15");
+	}
+
+	TEST_CASE("Malformed cache file is rejected")
+	{
+		const TempDir tmp;
+		writeFile(tmp.path / "topology.cache", "not a topology cache\n");
+		CHECK_FALSE(readTopologyModel(tmp.path / "topology.cache").has_value());
+	}
+
+	TEST_CASE("Cached model is reused only while the fingerprint matches")
+	{
+		FakeSysfs sys;
+		const auto cacheFile = sys.tmp.path / "topology.cache";
+		const std::vector<std::string> gpus = {"0000:03:00.0", "0000:04:00.0"};
+
+		const auto first = loadTopologyModel(gpus, sys.paths, cacheFile);
+		REQUIRE(std::filesystem::exists(cacheFile));
+
+		// Change a value the fingerprint does not cover: a cache hit keeps the old value
+		writeFile(sys.tmp.path / "devices" / "pci0000:00" / "0000:00:1d.0" / "0000:05:00.0" / "numa_node", "0\n");
+		CHECK(loadTopologyModel(gpus, sys.paths, cacheFile).numaNodes.at("0000:05:00.0") == 1);
+
+		// A PCI tree change invalidates the cache and the model is rebuilt
+		sys.addDevice("0000:06:00.0", {"pci0000:00", "0000:00:1e.0"}, "0");
+		const auto rebuilt = loadTopologyModel(gpus, sys.paths, cacheFile);
+		CHECK(rebuilt.fingerprint != first.fingerprint);
+		CHECK(rebuilt.numaNodes.at("0000:05:00.0") == 0);
+	}
+
+	TEST_CASE("Cached model is rebuilt when a requested BDF is missing")
+	{
+		const FakeSysfs sys;
+		const auto cacheFile = sys.tmp.path / "topology.cache";
+		loadTopologyModel({"0000:03:00.0"}, sys.paths, cacheFile);
+
+		const auto model = loadTopologyModel({"0000:03:00.0", "0000:04:00.0"}, sys.paths, cacheFile);
+		CHECK(model.pciePaths.count("0000:04:00.0") == 1U);
+	}
+}
+
+// ─── DmiReader tests ──────────────────────────────────────────────────────────
+
+TEST_SUITE("DmiReader")
+{
+	/// Encodes an SMBIOS Type 9 (System Slot) structure with a bus address.
+	void appendSlot(std::string & table, uint16_t handle, const std::string &designation, uint8_t bus, uint8_t devfn)
+	{
+		const uint8_t length = 17;
+		std::string record(length, '\0');
+		record[0] = 9;
+		record[1] = static_cast<char>(length);
+		record[2] = static_cast<char>(handle & 0xff);
+		record[3] = static_cast<char>(handle >> 8);
+		record[4] = 1;	  // designation string index
+		record[5] = static_cast<char>(0xa5); // PCI Express
+		record[7] = 4;	  // In use
+		record[15] = static_cast<char>(bus);
+		record[16] = static_cast<char>(devfn);
+		table += record;
+		table += designation;
+		table += std::string(2, '\0');
+	}
+
+	TEST_CASE("Finds slot through parent bridge using the slot index")
+	{
+		const TempDir tmp;
+		std::string table;
+		appendSlot(table, 1, "SLOT1", 0x00, static_cast<uint8_t>(0x1c << 3));
+		appendSlot(table, 2, "SLOT2", 0x07, 0x00);
+		writeFile(tmp.path / "DMI", table);
+
+		const auto pciRoot = tmp.path / "pci";
+		const auto realDir = tmp.path / "devices" / "pci0000:00" / "0000:00:1c.0" / "0000:03:00.0";
+		std::filesystem::create_directories(realDir);
+		createSymlink(realDir, pciRoot / "0000:03:00.0");
+
+		const DmiReader reader{tmp.path / "DMI", pciRoot};
+		REQUIRE(reader.isValid());
+		CHECK(reader.getSlots().size() == 2U);
+
+		const auto direct = reader.findSlotForDevice("0000:07:00.0");
+		REQUIRE(direct.has_value());
+		CHECK(direct->designation == "SLOT2");
+
+		const auto viaBridge = reader.findSlotForDevice("0000:03:00.0");
+		REQUIRE(viaBridge.has_value());
+		CHECK(viaBridge->designation == "SLOT1");
+
+		CHECK_FALSE(reader.findSlotForDevice("0000:09:00.0").has_value());
+	}
+}
+
+TEST_SUITE("linkUtilizationToJson")
+{
+	TEST_CASE("Matrix rows and ports, with null for what the window could not measure")
+	{
+		fabric_telemetry::LinkMatrix matrix;
+		matrix.devices = {0, 1};
+		matrix.cells.assign(2, std::vector<fabric_telemetry::LinkMatrix::Cell>(2));
+		matrix.cells[0][1] = {.linked = true, .bytesPerSec = 2'500'000.0, .utilization = 12.5};
+		matrix.cells[1][0] = {.linked = true, .bytesPerSec = std::nullopt, .utilization = std::nullopt};
+
+		fabric_telemetry::PortRate port;
+		port.portId = {.fabricId = 3, .attachId = 0, .portNumber = 2};
+		port.peer = zes_fabric_port_id_t{.fabricId = 5, .attachId = 1, .portNumber = 4};
+		port.subdeviceId = 1;
+		port.rxBytesPerSec = 1'000'000.0;
+		port.rxCapacity = 4'000'000;
+		const std::vector<fabric_telemetry::DeviceRates> rates{{.deviceIndex = 0, .ports = {port}}};
+
+		nlohmann::ordered_json json;
+		cmdTopology::linkUtilizationToJson(matrix, rates, std::chrono::milliseconds(1000), &json);
+		const auto &link = json["link_utilization"];
+
+		CHECK(link["interval_ms"].get<int64_t>() == 1000);
+		CHECK(link["devices"] == nlohmann::ordered_json::array({0, 1}));
+		REQUIRE(link["matrix"].size() == 2U);
+		const auto &first = link["matrix"][0];
+		CHECK(first["device_id"].get<uint32_t>() == 0U);
+		CHECK(first["linked"] == nlohmann::ordered_json::array({false, true}));
+		CHECK(first["utilization"][0].is_null());
+		CHECK(first["utilization"][1].get<double>() == doctest::Approx(12.5));
+		CHECK(first["throughput"][1].get<double>() == doctest::Approx(2.5));
+		CHECK(link["matrix"][1]["throughput"][0].is_null());
+
+		REQUIRE(link["ports"].size() == 1U);
+		const auto &p = link["ports"][0];
+		CHECK(p["subdevice_id"].get<uint32_t>() == 1U);
+		CHECK(p["port"].get<std::string>() == "3.0.2");
+		CHECK(p["remote_port"].get<std::string>() == "5.1.4");
+		CHECK(p["rx_throughput"].get<double>() == doctest::Approx(1.0));
+		CHECK(p["rx_utilization"].get<double>() == doctest::Approx(25.0));
+		CHECK(p["tx_throughput"].is_null());
+		CHECK(p["tx_utilization"].is_null());
+	}
+}
@@ -148,4 +148,50 @@ TEST_CASE("cmdVgpu --query alias matches --precheck without GPU target")
 
 	CHECK(command.run(&canonical.args) == ZE_RESULT_ERROR_INVALID_ARGUMENT);
 	CHECK(command.run(&alias.args) == ZE_RESULT_ERROR_INVALID_ARGUMENT);
-}
\ No newline at end of file
+}
+
+TEST_CASE("cmdVgpu run rejects stats sampling options without --stats")
+{
+	cmdVgpu command;
+
+	SUBCASE("interval")
+	{
+		ArgvFixture fixture{"xpum", "vgpu", "--interval", "100"};
+		CHECK(command.run(&fixture.args) == ZE_RESULT_ERROR_INVALID_ARGUMENT);
+	}
+
+	SUBCASE("loop")
+	{
+		ArgvFixture fixture{"xpum", "vgpu", "--loop"};
+		CHECK(command.run(&fixture.args) == ZE_RESULT_ERROR_INVALID_ARGUMENT);
+	}
+}
+
+TEST_CASE("cmdVgpu run rejects invalid stats sampling values")
+{
+	cmdVgpu command;
+
+	SUBCASE("zero interval")
+	{
+		ArgvFixture fixture{"xpum", "vgpu", "--stats", "--interval", "0"};
+		CHECK(command.run(&fixture.args) == ZE_RESULT_ERROR_INVALID_ARGUMENT);
+	}
+
+	SUBCASE("non-numeric interval")
+	{
+		ArgvFixture fixture{"xpum", "vgpu", "--stats", "--interval", "fast"};
+		CHECK(command.run(&fixture.args) == ZE_RESULT_ERROR_INVALID_ARGUMENT);
+	}
+
+	SUBCASE("count without loop")
+	{
+		ArgvFixture fixture{"xpum", "vgpu", "--stats", "--count", "3"};
+		CHECK(command.run(&fixture.args) == ZE_RESULT_ERROR_INVALID_ARGUMENT);
+	}
+
+	SUBCASE("negative count")
+	{
+		ArgvFixture fixture{"xpum", "vgpu", "--stats", "--loop", "--count", "-2"};
+		CHECK(command.run(&fixture.args) == ZE_RESULT_ERROR_INVALID_ARGUMENT);
+	}
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef _DEVICE_EVENTS_H
+#define _DEVICE_EVENTS_H
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+
+/**
+ * @brief A change of one PCI function that invalidates its Level Zero handles
+ */
+struct DeviceEvent
+{
+	enum class Kind : uint8_t
+	{
+		ADDED,	 ///< A driver bound to the function; it can be enumerated again
+		REMOVED, ///< The function left the bus or lost its driver
+		CHANGED, ///< The function stayed but was reset or wedged; its handles are stale
+	};
+
+	Kind kind{Kind::CHANGED};
+	std::string bdf;	///< e.g. "0000:4d:00.0"
+	std::string driver; ///< Bound driver for ADDED, when known
+};
+
+/**
+ * @brief Subscription to PCI and DRM hotplug events
+ *
+ * On Linux this listens to kernel uevents of the "pci" and "drm" subsystems. Windows
+ * has no equivalent source here; isOpen() is false and next() always times out, so
+ * callers rely on their own rescans.
+ */
+class DeviceEventSource
+{
+public:
+	DeviceEventSource();
+	~DeviceEventSource();
+
+	DeviceEventSource(const DeviceEventSource &) = delete;
+	DeviceEventSource &operator=(const DeviceEventSource &) = delete;
+
+	/** @brief False when events cannot be received (no netlink access, or Windows) */
+	[[nodiscard]] bool isOpen() const;
+
+	/**
+	 * @brief Waits up to @p timeout for the next event concerning a PCI function
+	 *
+	 * Events of other subsystems are consumed and skipped.
+	 *
+	 * @return The event, or std::nullopt on timeout or when the source is closed
+	 */
+	std::optional<DeviceEvent> next(std::chrono::milliseconds timeout);
+
+private:
+	struct Impl;
+	std::unique_ptr<Impl> impl;
+};
+
+#ifdef __linux__
+struct UeventMessage;
+
+/**
+ * @brief Maps a kernel uevent onto a DeviceEvent
+ *
+ * PCI bind is ADDED (the device is usable only once its driver probed it), remove and
+ * unbind are REMOVED. A "change" of the function or of its DRM card node that reports a
+ * reset, a wedged device or an AER recovery is CHANGED; other changes (e.g. display
+ * hotplug) are not. Removal of the card node is REMOVED.
+ *
+ * @return std::nullopt for events that do not change a GPU's usability (e.g. PCI add,
+ *         connectors, render nodes, other subsystems)
+ */
+std::optional<DeviceEvent> toDeviceEvent(const UeventMessage &msg);
+#endif
+
+#endif
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "device_lock.h"
+#include <thread>
+#include <utility>
+
+DeviceLocks::DeviceLocks(DeviceLocks &&other) noexcept
+	: mHandles(std::exchange(other.mHandles, {})), mLocked(std::exchange(other.mLocked, false)),
+	  mBusyResource(std::move(other.mBusyResource)), mHolders(std::move(other.mHolders)),
+	  mUnlocked(std::move(other.mUnlocked)), mNoDirectory(std::exchange(other.mNoDirectory, false))
+{
+}
+
+DeviceLocks &DeviceLocks::operator=(DeviceLocks &&other) noexcept
+{
+	if (this != &other) {
+		release();
+		mHandles = std::exchange(other.mHandles, {});
+		mLocked = std::exchange(other.mLocked, false);
+		mBusyResource = std::move(other.mBusyResource);
+		mHolders = std::move(other.mHolders);
+		mUnlocked = std::move(other.mUnlocked);
+		mNoDirectory = std::exchange(other.mNoDirectory, false);
+	}
+	return *this;
+}
+
+/**
+ * @brief Drops the locks in the reverse order of acquisition
+ */
+void DeviceLocks::release()
+{
+	while (!mHandles.empty()) {
+		closeHandle(mHandles.back());
+		mHandles.pop_back();
+	}
+	mLocked = false;
+}
+
+DeviceLockManager::DeviceLockManager(std::filesystem::path directory) : mDirectory(std::move(directory))
+{
+	if (!mDirectory.empty()) {
+		std::error_code ec;
+		std::filesystem::create_directories(mDirectory, ec);
+	}
+}
+
+std::filesystem::path DeviceLockManager::lockFile(const std::string &resource) const
+{
+	// ':' is not allowed in Windows file names; BDFs and card indexes contain no '_'
+	std::string name = resource;
+	std::ranges::replace(name, ':', '_');
+	return mDirectory / (name + ".lock");
+}
+
+/**
+ * @brief Takes the locks one at a time in resource order
+ *
+ * A busy resource is polled with a growing back-off, keeping the locks already taken:
+ * as every process takes its locks in the same order, whoever holds the busy one never
+ * waits for ours.
+ */
+DeviceLocks DeviceLockManager::acquire(std::vector<DeviceLockRequest> requests,
+									   std::chrono::milliseconds timeout) const
+{
+	using namespace std::chrono_literals;
+	normalizeDeviceLockRequests(requests);
+	const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+	DeviceLocks locks;
+	for (const auto &request : requests) {
+		// Lock files in an unverified place could be held by anyone; only readers go on without
+		if (mDirectory.empty()) {
+			if (request.mode == DeviceLockMode::SHARED) {
+				locks.mUnlocked.push_back(request.resource);
+				continue;
+			}
+			locks.release();
+			locks.mBusyResource = request.resource;
+			locks.mNoDirectory = true;
+			return locks;
+		}
+		auto backoff = 5ms;
+		for (;;) {
+			uintptr_t handle = 0;
+			const TryResult result = tryLock(request, handle);
+			if (result == TryResult::LOCKED) {
+				locks.mHandles.push_back(handle);
+				break;
+			}
+			if (result == TryResult::ABSENT) {
+				break;
+			}
+			if (result == TryResult::UNAVAILABLE && request.mode == DeviceLockMode::SHARED) {
+				locks.mUnlocked.push_back(request.resource);
+				break;
+			}
+
+			const auto now = std::chrono::steady_clock::now();
+			if (result == TryResult::UNAVAILABLE || now >= deadline) {
+				locks.release();
+				locks.mBusyResource = request.resource;
+				locks.mHolders = holdersOf(request.resource);
+				return locks;
+			}
+			std::this_thread::sleep_for(
+				std::min<std::chrono::steady_clock::duration>(backoff, deadline - now));
+			backoff = std::min(backoff * 2, 200ms);
+		}
+	}
+	locks.mLocked = true;
+	return locks;
+}
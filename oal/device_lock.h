@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef _DEVICE_LOCK_H
+#define _DEVICE_LOCK_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+enum class DeviceLockMode : uint8_t
+{
+	SHARED,	   ///< Read-only monitoring; any number of holders
+	EXCLUSIVE, ///< Firmware update, reset, configuration changes; a single holder
+};
+
+struct DeviceLockRequest
+{
+	std::string resource; ///< See DeviceLockManager::gpu() and DeviceLockManager::amc()
+	DeviceLockMode mode = DeviceLockMode::SHARED;
+};
+
+/**
+ * @brief Locks held by DeviceLockManager::acquire(); released when destroyed
+ *
+ * When the acquisition timed out, nothing is held and busyResource() names the
+ * resource that could not be locked, with the PIDs of the processes holding it where
+ * the platform can tell.
+ */
+class DeviceLocks
+{
+public:
+	DeviceLocks() = default;
+	~DeviceLocks() { release(); }
+
+	DeviceLocks(DeviceLocks &&other) noexcept;
+	DeviceLocks &operator=(DeviceLocks &&other) noexcept;
+	DeviceLocks(const DeviceLocks &) = delete;
+	DeviceLocks &operator=(const DeviceLocks &) = delete;
+
+	[[nodiscard]] bool locked() const { return mLocked; }
+	[[nodiscard]] const std::string &busyResource() const { return mBusyResource; }
+	[[nodiscard]] const std::vector<int> &holders() const { return mHolders; }
+	/** @brief Shared requests that were let through without a lock; see DeviceLockManager::acquire() */
+	[[nodiscard]] const std::vector<std::string> &unlockedResources() const { return mUnlocked; }
+	/** @brief The acquisition failed because there is no trusted lock directory, not a busy resource */
+	[[nodiscard]] bool noLockDirectory() const { return mNoDirectory; }
+
+	void release();
+
+private:
+	friend class DeviceLockManager;
+
+	static void closeHandle(uintptr_t handle);
+
+	std::vector<uintptr_t> mHandles; // Cast HANDLE/fd to uintptr_t
+	bool mLocked = false;
+	std::string mBusyResource;
+	std::vector<int> mHolders;
+	std::vector<std::string> mUnlocked;
+	bool mNoDirectory = false;
+};
+
+/**
+ * @brief Cross-process shared/exclusive locks on GPUs and AMC cards
+ *
+ * Every resource is a lock file in one directory, so that concurrent xpu-smi processes
+ * on the node serialize mutating operations on the same device while leaving other
+ * devices alone. acquire() takes the locks of all requested resources in sorted order,
+ * which makes multi-device acquisition deadlock free, and waits for busy resources
+ * until a deadline.
+ *
+ * The locks belong to the open lock file, not to the process: two acquisitions of the
+ * same resource from one process conflict like those of two processes do.
+ */
+class DeviceLockManager
+{
+public:
+	explicit DeviceLockManager(std::filesystem::path directory = defaultDirectory());
+
+	/**
+	 * @brief Lock directory of the node; $XPUM_LOCK_DIR when set
+	 *
+	 * Empty when no directory could be created and trusted; a manager without a
+	 * directory fails exclusive requests, see DeviceLocks::noLockDirectory().
+	 */
+	static std::filesystem::path defaultDirectory();
+
+	/** @brief Resource name of the GPU at @p bdf ("dddd:bb:dd.f") */
+	static std::string gpu(std::string_view bdf) { return "gpu:" + std::string(bdf); }
+
+	/** @brief Resource name of AMC card @p index */
+	static std::string amc(int index) { return "amc:" + std::to_string(index); }
+
+	/**
+	 * @brief Locks all @p requests, waiting at most @p timeout for busy ones
+	 *
+	 * A resource requested more than once is locked once, exclusively if any request
+	 * asks for that. On timeout every lock taken so far is dropped again.
+	 *
+	 * Only exclusive requests create lock files. A shared request for a resource
+	 * without one has nothing to wait for and succeeds without a lock. A shared
+	 * request whose lock file cannot be opened, e.g. for lack of permission, is let
+	 * through as well but listed in DeviceLocks::unlockedResources().
+	 */
+	[[nodiscard]] DeviceLocks acquire(std::vector<DeviceLockRequest> requests,
+									  std::chrono::milliseconds timeout) const;
+
+	[[nodiscard]] const std::filesystem::path &directory() const { return mDirectory; }
+
+private:
+	enum class TryResult : uint8_t
+	{
+		LOCKED,
+		BUSY,
+		UNAVAILABLE,
+		ABSENT, ///< Shared request for a resource never locked exclusively
+	};
+
+	TryResult tryLock(const DeviceLockRequest &request, uintptr_t &handle) const;
+	std::vector<int> holdersOf(const std::string &resource) const;
+	std::filesystem::path lockFile(const std::string &resource) const;
+
+	std::filesystem::path mDirectory;
+};
+
+/**
+ * @brief Sorts @p requests by resource and merges duplicates, exclusive winning
+ */
+inline void normalizeDeviceLockRequests(std::vector<DeviceLockRequest> &requests)
+{
+	std::ranges::sort(requests, {}, &DeviceLockRequest::resource);
+	auto out = requests.begin();
+	for (auto it = requests.begin(); it != requests.end(); ++it) {
+		if (out != requests.begin() && std::prev(out)->resource == it->resource) {
+			std::prev(out)->mode = std::max(std::prev(out)->mode, it->mode);
+		} else {
+			if (out != it) {
+				*out = std::move(*it);
+			}
+			++out;
+		}
+	}
+	requests.erase(out, requests.end());
+}
+
+#endif // _DEVICE_LOCK_H
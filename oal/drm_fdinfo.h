@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef _DRM_FDINFO_H
+#define _DRM_FDINFO_H
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <initializer_list>
+#include <map>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Per-process GPU engine utilization from DRM client fdinfo
+ *
+ * Every open DRM file description is a DRM client. The kernel publishes its usage
+ * counters in /proc/<pid>/fdinfo/<fd> (see the kernel's drm-usage-stats document):
+ * drm-engine-<class> (busy time, ns; i915), drm-cycles-<class> / drm-total-cycles-<class>
+ * (busy and elapsed GPU cycles; xe), drm-engine-capacity-<class> and
+ * drm-resident-<region>. Two snapshots of these counters give each process's busy
+ * percentage per engine class over the interval between them.
+ */
+
+/**
+ * @brief procfs root used by snapshotDrmClients — separated for testability
+ */
+struct ProcfsPaths
+{
+	std::filesystem::path procRoot{"/proc"};
+};
+
+/**
+ * @brief Usage counters of one DRM client at a point in time
+ *
+ * Engine class names are normalized across drivers: render, copy, video,
+ * video-enhance and compute (xe's rcs, bcs, vcs, vecs and ccs map onto these).
+ */
+struct DrmClientCounters
+{
+	uint32_t pid{0};		   ///< Lowest PID holding a descriptor of this client
+	uint64_t clientId{0};	   ///< drm-client-id, unique per device while the client exists
+	uint64_t residentBytes{0}; ///< Sum of drm-resident-<region> over all regions
+	std::map<std::string, uint64_t, std::less<>> engineNs;	  ///< drm-engine-<class>, busy ns
+	std::map<std::string, uint64_t, std::less<>> cycles;	  ///< drm-cycles-<class>
+	std::map<std::string, uint64_t, std::less<>> totalCycles; ///< drm-total-cycles-<class>
+	std::map<std::string, uint32_t, std::less<>> capacity;	  ///< drm-engine-capacity-<class>; 1 when absent
+};
+
+/**
+ * @brief All DRM clients of one device, read in a single pass over procfs
+ */
+struct DrmClientSnapshot
+{
+	std::chrono::steady_clock::time_point time{}; ///< When the snapshot was taken
+	std::vector<DrmClientCounters> clients;		  ///< One entry per client id, sorted by client id
+	bool available{false};						  ///< procfs could be read (always false on Windows)
+};
+
+/**
+ * @brief Busy share of one engine class used by one process
+ */
+struct EngineClassBusy
+{
+	double percent{0.0};  ///< Busy time as a percentage of the class's total capacity
+	uint32_t capacity{1}; ///< Number of engines of the class
+};
+
+/**
+ * @brief Engine utilization and resident memory of one process on one device
+ */
+struct ProcessEngineUtilization
+{
+	uint32_t pid{0};
+	uint64_t residentBytes{0};									 ///< Resident memory of all the process's clients
+	std::map<std::string, EngineClassBusy, std::less<>> engines; ///< Per engine class; empty when unknown
+
+	/**
+	 * @brief Capacity-weighted busy percentage over a group of engine classes
+	 *
+	 * @param classes Engine class names, e.g. {"video", "video-enhance"} for media
+	 * @return std::nullopt when none of the classes was reported for the process
+	 */
+	[[nodiscard]] std::optional<double> groupPercent(std::initializer_list<std::string_view> classes) const;
+
+	/** @brief Highest busy percentage of any engine class, or std::nullopt when none was reported */
+	[[nodiscard]] std::optional<double> maxPercent() const;
+};
+
+/**
+ * @brief Parses the text of one fdinfo file
+ *
+ * @param text   Contents of /proc/<pid>/fdinfo/<fd>
+ * @param bdf    PCI address of the GPU; the file must report the same drm-pdev
+ * @param out    Counters of the client; pid is left untouched
+ * @return true if the file describes a DRM client of @p bdf with a client id
+ */
+bool parseDrmFdinfo(std::string_view text, std::string_view bdf, DrmClientCounters &out);
+
+/**
+ * @brief Snapshots the DRM clients of several devices in one pass over procfs
+ *
+ * A client shared by several descriptors (dup, fork, SCM_RIGHTS) is reported once,
+ * attributed to the lowest PID holding it. Processes that exit or whose fdinfo is not
+ * readable during the walk are skipped.
+ *
+ * @param bdfs  PCI addresses of the GPUs (e.g. "0000:03:00.0")
+ * @param paths procfs root (defaults to the live /proc; override in tests)
+ * @return One snapshot per entry of @p bdfs, in the same order
+ */
+std::vector<DrmClientSnapshot> snapshotDrmClients(std::span<const std::string> bdfs, const ProcfsPaths &paths = {});
+
+/**
+ * @brief Computes per-process engine utilization between two snapshots of one device
+ *
+ * Clients present in both snapshots contribute their counter deltas; clients present
+ * only in @p after contribute their resident memory. Busy percentages are summed over
+ * the clients of a process and clamped to 100.
+ *
+ * @return One entry per process present in @p after, sorted by PID
+ */
+std::vector<ProcessEngineUtilization> computeProcessUtilization(const DrmClientSnapshot &before,
+																const DrmClientSnapshot &after);
+
+#endif // _DRM_FDINFO_H
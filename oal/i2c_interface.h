@@ -34,13 +34,17 @@ private:
 	bool init;
 	bool open_amc_peripheral();
 
+protected:
+	// For in-process fakes of the AMC: opens no device and overrides writeAmc/readAmc
+	I2CInterface();
+
 public:
 	I2CInterface(const std::string &devpath);
-	~I2CInterface();
+	virtual ~I2CInterface();
 
 	bool openAmc(const std::string &devpath);
-	bool writeAmc(void *writeBuffer, size_t writeSize);
-	bool readAmc(void *readBuffer, size_t readSize);
+	virtual bool writeAmc(void *writeBuffer, size_t writeSize);
+	virtual bool readAmc(void *readBuffer, size_t readSize);
 	bool closeAmc();
 	bool isInit() { return init; }
 };
@@ -0,0 +1,326 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "cpu_affinity.h"
+#include <linux/mempolicy.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <bit>
+#include <cerrno>
+#include <charconv>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr size_t WORD_BITS = 64;
+
+// Upper bound when growing the mask for sched_getaffinity on very large machines
+constexpr size_t MAX_CPUS = 1U << 16;
+
+std::mutex placementMutex;
+std::optional<CpuSet> housekeeping;
+
+// Set by pinThreadToDevices(), so that unpinThread() costs nothing on threads never pinned
+thread_local std::optional<ThreadPin> threadPin;
+
+const CpuSet &startupCpus()
+{
+	static const CpuSet cpus = CpuSet::ofCurrentThread();
+	return cpus;
+}
+
+// Capture the startup affinity while only the main thread runs, before anything is pinned
+[[maybe_unused]] const CpuSet &startupCapture = startupCpus();
+
+std::string_view trim(std::string_view s)
+{
+	const auto first = s.find_first_not_of(" \t\n");
+	if (first == std::string_view::npos) {
+		return {};
+	}
+	return s.substr(first, s.find_last_not_of(" \t\n") - first + 1);
+}
+
+std::optional<uint32_t> parseCpu(std::string_view s)
+{
+	uint32_t value{};
+	const auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), value);
+	if (ec != std::errc{} || ptr != s.data() + s.size() || value >= MAX_CPUS) {
+		return std::nullopt;
+	}
+	return value;
+}
+
+std::string readFirstLine(const fs::path &path)
+{
+	std::ifstream file(path);
+	std::string line;
+	std::getline(file, line);
+	return line;
+}
+
+struct CpuMaskDeleter
+{
+	void operator()(cpu_set_t *mask) const { CPU_FREE(mask); }
+};
+
+/// Preferred, not bound: allocations fall back to other nodes when this one is full
+void preferNode(int node)
+{
+	if (node < 0) {
+		::syscall(SYS_set_mempolicy, MPOL_DEFAULT, nullptr, 0);
+		return;
+	}
+	const size_t bits = sizeof(unsigned long) * 8;
+	std::vector<unsigned long> nodeMask(static_cast<size_t>(node) / bits + 1, 0);
+	nodeMask[nodeMask.size() - 1] |= 1UL << (static_cast<size_t>(node) % bits);
+	::syscall(SYS_set_mempolicy, MPOL_PREFERRED, nodeMask.data(), nodeMask.size() * bits + 1);
+}
+
+} // namespace
+
+std::optional<CpuSet> CpuSet::parse(std::string_view list)
+{
+	CpuSet set;
+	list = trim(list);
+	while (!list.empty()) {
+		const auto comma = list.find(',');
+		const auto range = trim(list.substr(0, comma));
+		list = comma == std::string_view::npos ? std::string_view{} : list.substr(comma + 1);
+
+		const auto dash = range.find('-');
+		const auto first = parseCpu(range.substr(0, dash));
+		const auto last = dash == std::string_view::npos ? first : parseCpu(range.substr(dash + 1));
+		if (!first || !last || *last < *first) {
+			return std::nullopt;
+		}
+		for (uint32_t cpu = *first; cpu <= *last; ++cpu) {
+			set.add(cpu);
+		}
+	}
+	return set;
+}
+
+CpuSet CpuSet::ofCurrentThread()
+{
+	CpuSet set;
+	for (size_t cpus = CPU_SETSIZE; cpus <= MAX_CPUS; cpus *= 2) {
+		const std::unique_ptr<cpu_set_t, CpuMaskDeleter> mask(CPU_ALLOC(cpus));
+		const size_t bytes = CPU_ALLOC_SIZE(cpus);
+		if (::sched_getaffinity(0, bytes, mask.get()) != 0) {
+			if (errno == EINVAL) {
+				continue; // The kernel supports more CPUs than the mask holds
+			}
+			break;
+		}
+		for (size_t cpu = 0; cpu < cpus; ++cpu) {
+			if (CPU_ISSET_S(cpu, bytes, mask.get())) {
+				set.add(static_cast<uint32_t>(cpu));
+			}
+		}
+		break;
+	}
+	return set;
+}
+
+void CpuSet::add(uint32_t cpu)
+{
+	const size_t word = cpu / WORD_BITS;
+	if (word >= words.size()) {
+		words.resize(word + 1, 0);
+	}
+	words[word] |= uint64_t{1} << (cpu % WORD_BITS);
+}
+
+bool CpuSet::contains(uint32_t cpu) const
+{
+	const size_t word = cpu / WORD_BITS;
+	return word < words.size() && (words[word] & (uint64_t{1} << (cpu % WORD_BITS))) != 0;
+}
+
+size_t CpuSet::count() const
+{
+	size_t n = 0;
+	for (const auto w : words) {
+		n += static_cast<size_t>(std::popcount(w));
+	}
+	return n;
+}
+
+CpuSet CpuSet::operator&(const CpuSet &other) const
+{
+	CpuSet result;
+	result.words.resize(std::min(words.size(), other.words.size()));
+	for (size_t i = 0; i < result.words.size(); ++i) {
+		result.words[i] = words[i] & other.words[i];
+	}
+	return result;
+}
+
+CpuSet &CpuSet::operator|=(const CpuSet &other)
+{
+	if (other.words.size() > words.size()) {
+		words.resize(other.words.size(), 0);
+	}
+	for (size_t i = 0; i < other.words.size(); ++i) {
+		words[i] |= other.words[i];
+	}
+	return *this;
+}
+
+bool CpuSet::operator==(const CpuSet &other) const
+{
+	const size_t n = std::max(words.size(), other.words.size());
+	for (size_t i = 0; i < n; ++i) {
+		const uint64_t a = i < words.size() ? words[i] : 0;
+		const uint64_t b = i < other.words.size() ? other.words[i] : 0;
+		if (a != b) {
+			return false;
+		}
+	}
+	return true;
+}
+
+std::string CpuSet::toString() const
+{
+	std::string out;
+	const auto limit = static_cast<uint32_t>(words.size() * WORD_BITS);
+	for (uint32_t cpu = 0; cpu < limit; ++cpu) {
+		if (!contains(cpu)) {
+			continue;
+		}
+		uint32_t last = cpu;
+		while (last + 1 < limit && contains(last + 1)) {
+			++last;
+		}
+		if (!out.empty()) {
+			out += ',';
+		}
+		out += std::to_string(cpu);
+		if (last != cpu) {
+			out += '-' + std::to_string(last);
+		}
+		cpu = last;
+	}
+	return out;
+}
+
+bool CpuSet::applyToThread(int tid) const
+{
+	if (empty()) {
+		return false;
+	}
+	const size_t cpus = words.size() * WORD_BITS;
+	const std::unique_ptr<cpu_set_t, CpuMaskDeleter> mask(CPU_ALLOC(cpus));
+	const size_t bytes = CPU_ALLOC_SIZE(cpus);
+	CPU_ZERO_S(bytes, mask.get());
+	for (size_t cpu = 0; cpu < cpus; ++cpu) {
+		if (contains(static_cast<uint32_t>(cpu))) {
+			CPU_SET_S(cpu, bytes, mask.get());
+		}
+	}
+	return ::sched_setaffinity(tid, bytes, mask.get()) == 0;
+}
+
+CpuSet readLocalCpus(std::string_view bdf, const fs::path &pciDevRoot)
+{
+	return CpuSet::parse(readFirstLine(pciDevRoot / bdf / "local_cpulist")).value_or(CpuSet{});
+}
+
+int readNumaNode(std::string_view bdf, const fs::path &pciDevRoot)
+{
+	const auto line = trim(readFirstLine(pciDevRoot / bdf / "numa_node"));
+	int node = -1;
+	const auto [ptr, ec] = std::from_chars(line.data(), line.data() + line.size(), node);
+	return (ec == std::errc{} && ptr == line.data() + line.size()) ? node : -1;
+}
+
+bool restrictProcessCpus(const CpuSet &cpus, const fs::path &taskRoot)
+{
+	const CpuSet target = cpus & startupCpus();
+	if (target.empty()) {
+		return false;
+	}
+	const std::lock_guard lock(placementMutex);
+	bool ok = true;
+	std::error_code ec;
+	for (const auto &task : fs::directory_iterator(taskRoot, ec)) {
+		const auto name = task.path().filename().string();
+		int tid{};
+		const auto [ptr, parseEc] = std::from_chars(name.data(), name.data() + name.size(), tid);
+		if (parseEc != std::errc{} || ptr != name.data() + name.size()) {
+			continue;
+		}
+		// A thread may exit while we walk the list
+		if (!target.applyToThread(tid) && errno != ESRCH) {
+			ok = false;
+		}
+	}
+	// Also covers a task directory that could not be listed
+	ok = target.applyToThread(0) && ok && !ec;
+	housekeeping = target;
+	return ok;
+}
+
+CpuSet allowedProcessCpus()
+{
+	const std::lock_guard lock(placementMutex);
+	return housekeeping.value_or(startupCpus());
+}
+
+bool pinThreadToDevices(std::span<const std::string> bdfs, const fs::path &pciDevRoot)
+{
+	CpuSet local;
+	std::optional<int> node;
+	for (const auto &bdf : bdfs) {
+		local |= readLocalCpus(bdf, pciDevRoot);
+		const int devNode = readNumaNode(bdf, pciDevRoot);
+		node = (!node || *node == devNode) ? devNode : -1;
+	}
+
+	const CpuSet target = local & allowedProcessCpus();
+	if (!target.applyToThread()) {
+		return false;
+	}
+	const int preferred = node.value_or(-1);
+	if (preferred >= 0 || (threadPin && threadPin->node >= 0)) {
+		preferNode(preferred);
+	}
+	threadPin = ThreadPin{target, preferred};
+	return true;
+}
+
+void unpinThread()
+{
+	if (!threadPin) {
+		return;
+	}
+	allowedProcessCpus().applyToThread();
+	::syscall(SYS_set_mempolicy, MPOL_DEFAULT, nullptr, 0);
+	threadPin.reset();
+}
+
+ThreadPinGuard::ThreadPinGuard() : saved(threadPin) {}
+
+ThreadPinGuard::~ThreadPinGuard()
+{
+	if (saved == threadPin) {
+		return;
+	}
+	if (!saved) {
+		unpinThread();
+		return;
+	}
+	saved->cpus.applyToThread();
+	preferNode(saved->node);
+	threadPin = std::move(saved);
+}
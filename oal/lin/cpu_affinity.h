@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef CPU_AFFINITY_H
+#define CPU_AFFINITY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Set of logical CPU ids, as used by sched_setaffinity and sysfs cpu lists
+ */
+class CpuSet
+{
+public:
+	/**
+	 * @brief Parses a cpu list such as "0-3,8,10-11" (the format of local_cpulist and
+	 *        /sys/devices/system/cpu/online)
+	 *
+	 * @return std::nullopt on malformed input; an empty list gives an empty set
+	 */
+	static std::optional<CpuSet> parse(std::string_view list);
+
+	/** @brief CPUs the calling thread may run on */
+	static CpuSet ofCurrentThread();
+
+	void add(uint32_t cpu);
+	[[nodiscard]] bool contains(uint32_t cpu) const;
+	[[nodiscard]] size_t count() const;
+	[[nodiscard]] bool empty() const { return count() == 0; }
+
+	[[nodiscard]] CpuSet operator&(const CpuSet &other) const;
+	CpuSet &operator|=(const CpuSet &other);
+	[[nodiscard]] bool operator==(const CpuSet &other) const;
+
+	/** @brief Canonical cpu list, e.g. "0-3,8" */
+	[[nodiscard]] std::string toString() const;
+
+	/**
+	 * @brief Restricts the calling thread (tid 0) or thread @p tid to this set
+	 *
+	 * @return false when the set is empty or the kernel rejected it
+	 */
+	bool applyToThread(int tid = 0) const;
+
+private:
+	std::vector<uint64_t> words;
+};
+
+/**
+ * @brief Default location of the PCI devices in sysfs — separated for testability
+ */
+inline const std::filesystem::path PCI_DEVICES_ROOT{"/sys/bus/pci/devices"};
+
+/**
+ * @brief CPUs of the NUMA node a PCI device is attached to, from its local_cpulist
+ *
+ * @return An empty set when the attribute is missing or unreadable
+ */
+CpuSet readLocalCpus(std::string_view bdf, const std::filesystem::path &pciDevRoot = PCI_DEVICES_ROOT);
+
+/**
+ * @brief NUMA node of a PCI device, from its numa_node attribute
+ *
+ * @return -1 when the platform does not report one
+ */
+int readNumaNode(std::string_view bdf, const std::filesystem::path &pciDevRoot = PCI_DEVICES_ROOT);
+
+/**
+ * @brief Restricts every thread of the process, and so every thread created later, to
+ *        the housekeeping set @p cpus
+ *
+ * The set is intersected with the CPUs the process was started with. Threads later
+ * pinned to devices stay inside it.
+ *
+ * @param taskRoot Directory listing the process's threads — separated for testability
+ * @return false when no CPU of @p cpus is usable or a thread could not be moved
+ */
+bool restrictProcessCpus(const CpuSet &cpus, const std::filesystem::path &taskRoot = "/proc/self/task");
+
+/**
+ * @brief CPUs xpu-smi threads may use: the housekeeping set if one was configured,
+ *        otherwise the CPUs the process was started with
+ */
+CpuSet allowedProcessCpus();
+
+/**
+ * @brief Runs the calling thread on the CPUs local to @p bdfs and prefers their NUMA node
+ *        for its memory allocations
+ *
+ * The thread is restricted to the union of the devices' local CPUs within
+ * allowedProcessCpus(). If that is empty (e.g. the housekeeping set lies on another
+ * socket) the affinity is left alone. When all devices share one NUMA node, memory the
+ * thread allocates and first touches afterwards is preferably placed on that node.
+ *
+ * @return true if the thread was pinned
+ */
+bool pinThreadToDevices(std::span<const std::string> bdfs,
+						const std::filesystem::path &pciDevRoot = PCI_DEVICES_ROOT);
+
+/**
+ * @brief Undoes pinThreadToDevices() on the calling thread
+ *
+ * Returns the thread to allowedProcessCpus() and the default memory policy. Cheap when
+ * the thread is not pinned.
+ */
+void unpinThread();
+
+/**
+ * @brief Placement applied by pinThreadToDevices(): CPUs and preferred NUMA node (-1 for none)
+ */
+struct ThreadPin
+{
+	CpuSet cpus;
+	int node{-1};
+
+	bool operator==(const ThreadPin &other) const = default;
+};
+
+/**
+ * @brief Restores the calling thread's pin, or its absence, when it goes out of scope
+ *
+ * Scopes a pinThreadToDevices() to a block: pooled threads wrap each task in one so a
+ * task's pin does not leak into the next, and a pinned thread that runs a task inline
+ * gets its own pin back afterwards. Costs no system call when the pin did not change.
+ */
+class ThreadPinGuard
+{
+public:
+	ThreadPinGuard();
+	~ThreadPinGuard();
+
+	ThreadPinGuard(const ThreadPinGuard &) = delete;
+	ThreadPinGuard &operator=(const ThreadPinGuard &) = delete;
+
+private:
+	std::optional<ThreadPin> saved;
+};
+
+#endif // CPU_AFFINITY_H
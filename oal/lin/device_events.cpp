@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include <device_events.h>
+#include "bdf.h"
+#include "pci_path_index.h"
+#include "sysfs_attr.h"
+#include "uevent.h"
+#include <algorithm>
+#include <string_view>
+
+namespace {
+
+/// BDF of the PCI function a DRM card node hangs off: ".../<bdf>/drm/card<N>".
+std::string_view drmCardParent(std::string_view devpath)
+{
+	const auto drm = devpath.rfind("/drm/");
+	if (drm == std::string_view::npos) {
+		return {};
+	}
+	const auto node = devpath.substr(drm + 5);
+	if (!node.starts_with("card") || node.size() == 4 || node.find_first_not_of("0123456789", 4) != node.npos) {
+		return {}; // Connectors (card0-DP-1) and render nodes follow the card
+	}
+	const auto parent = devpath.substr(0, drm);
+	return parent.substr(parent.find_last_of('/') + 1);
+}
+
+} // namespace
+
+std::optional<DeviceEvent> toDeviceEvent(const UeventMessage &msg)
+{
+	DeviceEvent event;
+	if (msg.subsystem == "pci") {
+		const std::string_view devpath{msg.devpath};
+		event.bdf = msg.pciSlotName.empty() ? std::string(devpath.substr(devpath.find_last_of('/') + 1))
+											: msg.pciSlotName;
+		if (msg.action == "bind") {
+			event.kind = DeviceEvent::Kind::ADDED;
+			event.driver = msg.driver;
+		} else if (msg.action == "remove" || msg.action == "unbind") {
+			event.kind = DeviceEvent::Kind::REMOVED;
+		} else if (msg.action == "change" && msg.resetEvent) {
+			event.kind = DeviceEvent::Kind::CHANGED;
+		} else {
+			return std::nullopt;
+		}
+	} else if (msg.subsystem == "drm") {
+		event.bdf = drmCardParent(msg.devpath);
+		if (msg.action == "remove") {
+			event.kind = DeviceEvent::Kind::REMOVED;
+		} else if (msg.action == "change" && msg.resetEvent) {
+			event.kind = DeviceEvent::Kind::CHANGED;
+		} else {
+			return std::nullopt;
+		}
+	} else {
+		return std::nullopt;
+	}
+	if (!isValidBdf(event.bdf)) {
+		return std::nullopt;
+	}
+	return event;
+}
+
+struct DeviceEventSource::Impl
+{
+	UeventSocket socket;
+};
+
+DeviceEventSource::DeviceEventSource() : impl(std::make_unique<Impl>()) {}
+
+DeviceEventSource::~DeviceEventSource() = default;
+
+bool DeviceEventSource::isOpen() const { return impl->socket.isOpen(); }
+
+std::optional<DeviceEvent> DeviceEventSource::next(std::chrono::milliseconds timeout)
+{
+	const auto deadline = std::chrono::steady_clock::now() + timeout;
+	for (;;) {
+		const auto remaining =
+			std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+		const auto msg = impl->socket.receive(std::max(remaining, std::chrono::milliseconds{0}));
+		if (!msg) {
+			return std::nullopt;
+		}
+		if (auto event = toDeviceEvent(*msg)) {
+			// The function's sysfs nodes, driver or DRM nodes changed; lookups made while
+			// handling the event must not see the old ones
+			SysfsAttributeCache::instance().invalidate("/sys/bus/pci/devices/" + event->bdf + "/");
+			PciPathIndex::invalidate();
+			return event;
+		}
+	}
+}
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include <device_lock.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+#include <unistd.h>
+
+namespace {
+
+/**
+ * @brief Whether the lock directory @p fd is safe to coordinate through
+ *
+ * It must be a directory owned by root, or by us, that nobody else can write to.
+ * A directory of ours left group or world writable, as older versions made it, is
+ * tightened instead.
+ */
+bool trustedDirectory(int fd)
+{
+	struct stat st;
+	if (fstat(fd, &st) != 0 || !S_ISDIR(st.st_mode) || (st.st_uid != 0 && st.st_uid != geteuid())) {
+		return false;
+	}
+	if ((st.st_mode & (S_IWGRP | S_IWOTH)) == 0) {
+		return true;
+	}
+	return st.st_uid == geteuid() && fchmod(fd, 0755) == 0;
+}
+
+/**
+ * @brief Creates @p dir with @p mode unless it exists, and checks it with trustedDirectory()
+ */
+bool usableDirectory(const std::filesystem::path &dir, mode_t mode)
+{
+	if (mkdir(dir.c_str(), mode) != 0 && errno != EEXIST) {
+		return false;
+	}
+	const int fd = open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+	if (fd < 0) {
+		return false;
+	}
+	const bool trusted = trustedDirectory(fd);
+	close(fd);
+	return trusted;
+}
+
+} // namespace
+
+std::filesystem::path DeviceLockManager::defaultDirectory()
+{
+	if (const char *dir = std::getenv("XPUM_LOCK_DIR"); dir != nullptr && *dir != '\0') {
+		return dir;
+	}
+
+	// Only root may create lock files: anyone who can open one can flock() it
+	// exclusively and hold up firmware updates and resets.
+	const std::filesystem::path dir = "/var/lock/xpum";
+	if (usableDirectory(dir, 0755)) {
+		return dir;
+	}
+	// Private to this user, so it cannot be used to block anyone else either
+	std::error_code ec;
+	const std::filesystem::path tmp = std::filesystem::temp_directory_path(ec);
+	if (ec) {
+		return {};
+	}
+	const std::filesystem::path fallback = tmp / ("xpum-locks-" + std::to_string(geteuid()));
+	if (usableDirectory(fallback, 0700)) {
+		return fallback;
+	}
+	// Someone else owns the name, or made it writable to others
+	return {};
+}
+
+void DeviceLocks::closeHandle(uintptr_t handle)
+{
+	// Closing the last descriptor of the open file drops its flock
+	close(static_cast<int>(handle));
+}
+
+/**
+ * @brief flock()s the lock file of the resource without blocking
+ *
+ * Lock files are never deleted: unlinking one while another process has it open and is
+ * about to lock it would let a third process lock a new file of the same name. Only
+ * exclusive requests create them, readable by their owner alone, since flock() needs
+ * no write access to the file.
+ */
+DeviceLockManager::TryResult DeviceLockManager::tryLock(const DeviceLockRequest &request, uintptr_t &handle) const
+{
+	const std::filesystem::path path = lockFile(request.resource);
+	const bool exclusive = request.mode == DeviceLockMode::EXCLUSIVE;
+	int fd = open(path.c_str(), O_RDONLY | O_NOFOLLOW | O_CLOEXEC | (exclusive ? O_CREAT : 0), 0600);
+	if (fd < 0) {
+		return !exclusive && errno == ENOENT ? TryResult::ABSENT : TryResult::UNAVAILABLE;
+	}
+
+	const int operation = exclusive ? LOCK_EX : LOCK_SH;
+	if (flock(fd, operation | LOCK_NB) != 0) {
+		const bool busy = errno == EWOULDBLOCK;
+		close(fd);
+		return busy ? TryResult::BUSY : TryResult::UNAVAILABLE;
+	}
+	handle = static_cast<uintptr_t>(fd);
+	return TryResult::LOCKED;
+}
+
+/**
+ * @brief PIDs holding a flock on the lock file of the resource, from /proc/locks
+ *
+ * Lines look like "1: FLOCK  ADVISORY  WRITE 1234 08:01:5678 0 EOF", where the
+ * device is major:minor in hex and the inode is decimal. Processes blocked on a lock
+ * are listed with "->" and do not hold it.
+ */
+std::vector<int> DeviceLockManager::holdersOf(const std::string &resource) const
+{
+	std::vector<int> pids;
+	struct stat st;
+	if (stat(lockFile(resource).c_str(), &st) != 0) {
+		return pids;
+	}
+
+	std::ifstream locks("/proc/locks");
+	std::string line;
+	while (std::getline(locks, line)) {
+		std::istringstream fields(line);
+		std::string id, kind, advisory, access, file;
+		int pid;
+		if (!(fields >> id >> kind) || kind != "FLOCK" || !(fields >> advisory >> access >> pid >> file)) {
+			continue;
+		}
+		unsigned int major, minor;
+		unsigned long long inode;
+		if (sscanf(file.c_str(), "%x:%x:%llu", &major, &minor, &inode) != 3) {
+			continue;
+		}
+		if (inode == st.st_ino && major == ::major(st.st_dev) && minor == ::minor(st.st_dev) && pid > 0) {
+			pids.push_back(pid);
+		}
+	}
+	std::ranges::sort(pids);
+	pids.erase(std::unique(pids.begin(), pids.end()), pids.end());
+	return pids;
+}
@@ -30,6 +30,20 @@ DmiReader::DmiReader()
 {
 	try {
 		loadDMIData();
+		buildSlotIndex();
+		mIsValid = true;
+	} catch (const std::exception &e) {
+		mIsValid = false;
+		throw;
+	}
+}
+
+DmiReader::DmiReader(std::filesystem::path dmiTable, std::filesystem::path pciRoot)
+	: dmiTablePath(std::move(dmiTable)), pciDevRoot(std::move(pciRoot))
+{
+	try {
+		loadDMIData();
+		buildSlotIndex();
 		mIsValid = true;
 	} catch (const std::exception &e) {
 		mIsValid = false;
@@ -45,7 +59,13 @@ std::vector<DmiReader::SlotInfo> DmiReader::getSlots() const
 		return {};
 	}
 
-	std::vector<SlotInfo> slots;
+	return slots;
+}
+
+void DmiReader::buildSlotIndex()
+{
+	slots.clear();
+	slotByBusAddress.clear();
 
 	for (const auto &[offset, header] : getStructureIterator()) {
 		if (header->type == 9) { // System Slot
@@ -55,7 +75,11 @@ std::vector<DmiReader::SlotInfo> DmiReader::getSlots() const
 		}
 	}
 
-	return slots;
+	for (size_t i = 0; i < slots.size(); ++i) {
+		if (slots[i].busAddress) {
+			slotByBusAddress.try_emplace(*slots[i].busAddress, i);
+		}
+	}
 }
 
 std::optional<DmiReader::SystemInfo> DmiReader::getSystemInfo() const
@@ -79,13 +103,9 @@ std::optional<DmiReader::SlotInfo> DmiReader::findSlotForDevice(std::string_view
 		return std::nullopt;
 	}
 
-	const auto slots = getSlots();
-
-	const auto findSlotByBDF = [&slots](std::string_view targetBdf) -> std::optional<SlotInfo> {
-		const auto match = std::ranges::find_if(
-			slots, [&targetBdf](const auto &slot) { return slot.busAddress && *slot.busAddress == targetBdf; });
-
-		return (match != slots.end()) ? std::make_optional(*match) : std::nullopt;
+	const auto findSlotByBDF = [this](std::string_view targetBdf) -> std::optional<SlotInfo> {
+		const auto match = slotByBusAddress.find(std::string(targetBdf));
+		return (match != slotByBusAddress.end()) ? std::make_optional(slots[match->second]) : std::nullopt;
 	};
 
 	// Direct match first
@@ -107,12 +127,12 @@ std::optional<DmiReader::SlotInfo> DmiReader::findSlotForDevice(std::string_view
 
 std::span<const uint8_t> DmiReader::dataSpan() const noexcept { return dmiData; }
 
-std::vector<std::string> DmiReader::getParentBridges(std::string_view deviceBdf)
+std::vector<std::string> DmiReader::getParentBridges(std::string_view deviceBdf) const
 {
 	std::vector<std::string> parents;
 
 	try {
-		const std::filesystem::path devicePath = std::format("/sys/bus/pci/devices/{}", deviceBdf);
+		const std::filesystem::path devicePath = pciDevRoot / deviceBdf;
 
 		if (!std::filesystem::exists(devicePath)) {
 			return parents;
@@ -151,7 +171,7 @@ constexpr bool DmiReader::isValidBDF(std::string_view bdf) noexcept
 
 void DmiReader::loadDMIData()
 {
-	std::ifstream dmiFile("/sys/firmware/dmi/tables/DMI", std::ios::binary);
+	std::ifstream dmiFile(dmiTablePath, std::ios::binary);
 	if (!dmiFile) {
 		throw std::runtime_error("Cannot access DMI tables. Ensure you have proper permissions and sysfs support.");
 	}
@@ -17,6 +17,8 @@
 #include <span>
 #include <stdexcept>
 #include <cstring>
+#include <filesystem>
+#include <unordered_map>
 
 /**
  * @brief SMBIOS/DMI table reader for extracting system hardware information.
@@ -78,6 +80,17 @@ public:
 	 */
 	DmiReader();
 
+	/**
+	 * @brief Constructs a DmiReader over explicit table and PCI device roots.
+	 *
+	 * Used by tests to point the reader at fake SMBIOS and sysfs trees.
+	 *
+	 * @param[in] dmiTable   Path to the raw SMBIOS table (normally /sys/firmware/dmi/tables/DMI).
+	 * @param[in] pciRoot  PCI device directory used for parent bridge walks.
+	 * @throw std::runtime_error if the table cannot be read or is malformed.
+	 */
+	DmiReader(std::filesystem::path dmiTable, std::filesystem::path pciRoot);
+
 	/**
 	 * @brief Checks if the DMI reader initialized successfully.
 	 *
@@ -119,12 +132,25 @@ public:
 	 *
 	 * @note Uses /sys/bus/pci/devices/ to traverse PCIe topology.
 	 * @note Returns first matching slot when multiple parent bridges match.
+	 * @note Lookups go through a bus address index built once at construction,
+	 *       so repeated calls do not re-parse the SMBIOS table.
 	 */
 	[[nodiscard]] std::optional<SlotInfo> findSlotForDevice(std::string_view deviceBdf) const;
 
 private:
 	std::vector<uint8_t> dmiData; ///< Raw DMI table data loaded from sysfs
 	bool mIsValid = false;		  ///< Initialization status flag
+	std::filesystem::path dmiTablePath{"/sys/firmware/dmi/tables/DMI"}; ///< SMBIOS table source
+	std::filesystem::path pciDevRoot{"/sys/bus/pci/devices"};			  ///< PCI device directory
+	std::vector<SlotInfo> slots;										  ///< Type 9 slots parsed once
+	std::unordered_map<std::string, size_t> slotByBusAddress;			  ///< Bus address → index in slots
+
+	/**
+	 * @brief Parses all Type 9 structures once and indexes them by bus address.
+	 *
+	 * @post slots and slotByBusAddress are populated; the first slot wins on duplicate addresses.
+	 */
+	void buildSlotIndex();
 
 	/**
 	 * @brief Returns a view over the raw DMI data buffer.
@@ -177,7 +203,7 @@ private:
 	 *
 	 * @note Does not throw on filesystem errors, returns empty vector instead.
 	 */
-	[[nodiscard]] static std::vector<std::string> getParentBridges(std::string_view deviceBdf);
+	[[nodiscard]] std::vector<std::string> getParentBridges(std::string_view deviceBdf) const;
 
 	/**
 	 * @brief Validates if a string is a properly formatted PCI BDF address.
@@ -202,7 +228,7 @@ private:
 	} __attribute__((packed));
 
 	/**
-	 * @brief Loads raw DMI table data from /sys/firmware/dmi/tables/DMI.
+	 * @brief Loads raw DMI table data from dmiTablePath (/sys/firmware/dmi/tables/DMI by default).
 	 *
 	 * @throw std::runtime_error if DMI file cannot be opened, is empty, or too small.
 	 * @post dmi_data contains complete DMI table on success.
@@ -0,0 +1,338 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "drm_fdinfo.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+namespace fs = std::filesystem;
+
+struct ClassAlias
+{
+	std::string_view driverName;
+	std::string_view className;
+};
+
+// xe reports engine classes by their hardware names; i915 already uses the generic ones.
+constexpr auto CLASS_ALIASES = std::to_array<ClassAlias>({
+	{"rcs", "render"},
+	{"bcs", "copy"},
+	{"vcs", "video"},
+	{"vecs", "video-enhance"},
+	{"ccs", "compute"},
+});
+
+std::string_view normalizeClass(std::string_view name)
+{
+	for (const auto &alias : CLASS_ALIASES) {
+		if (alias.driverName == name) {
+			return alias.className;
+		}
+	}
+	return name;
+}
+
+std::string_view trim(std::string_view s)
+{
+	const auto first = s.find_first_not_of(" \t");
+	if (first == std::string_view::npos) {
+		return {};
+	}
+	return s.substr(first, s.find_last_not_of(" \t\r") - first + 1);
+}
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b)
+{
+	return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+			   return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+		   });
+}
+
+/// Parses "<number>[ <unit>]"; memory units (KiB, MiB, GiB) are scaled to bytes.
+bool parseValue(std::string_view text, uint64_t &out)
+{
+	uint64_t value = 0;
+	const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+	if (ec != std::errc{} || end == text.data()) {
+		return false;
+	}
+	const auto unit = trim(text.substr(static_cast<size_t>(end - text.data())));
+	if (unit == "KiB") {
+		value *= 1024ULL;
+	} else if (unit == "MiB") {
+		value *= 1024ULL * 1024ULL;
+	} else if (unit == "GiB") {
+		value *= 1024ULL * 1024ULL * 1024ULL;
+	}
+	out = value;
+	return true;
+}
+
+bool consumePrefix(std::string_view &s, std::string_view prefix)
+{
+	if (!s.starts_with(prefix)) {
+		return false;
+	}
+	s.remove_prefix(prefix.size());
+	return true;
+}
+
+/// Reads a whole procfs file; fdinfo reports a size of 0, so read until EOF.
+bool readProcFile(const fs::path &path, std::string &out)
+{
+	const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0) {
+		return false;
+	}
+	out.clear();
+	std::array<char, 4096> buf{};
+	ssize_t n = 0;
+	while ((n = ::read(fd, buf.data(), buf.size())) > 0) {
+		out.append(buf.data(), static_cast<size_t>(n));
+	}
+	::close(fd);
+	return n == 0;
+}
+
+bool parsePid(std::string_view name, uint32_t &pid)
+{
+	const auto [end, ec] = std::from_chars(name.data(), name.data() + name.size(), pid);
+	return ec == std::errc{} && end == name.data() + name.size();
+}
+
+/// Busy fraction of one class of one client over the interval, or false when not derivable.
+bool classBusy(const DrmClientCounters &before, const DrmClientCounters &after, std::string_view cls,
+			   double elapsedNs, double &fraction)
+{
+	if (const auto a = after.engineNs.find(cls); a != after.engineNs.end()) {
+		const auto b = before.engineNs.find(cls);
+		if (b == before.engineNs.end() || elapsedNs <= 0.0) {
+			return false;
+		}
+		fraction = a->second >= b->second ? static_cast<double>(a->second - b->second) / elapsedNs : 0.0;
+		return true;
+	}
+	const auto a = after.cycles.find(cls);
+	const auto at = after.totalCycles.find(cls);
+	const auto b = before.cycles.find(cls);
+	const auto bt = before.totalCycles.find(cls);
+	if (a == after.cycles.end() || at == after.totalCycles.end() || b == before.cycles.end() ||
+		bt == before.totalCycles.end() || at->second <= bt->second) {
+		return false;
+	}
+	fraction = a->second >= b->second
+				   ? static_cast<double>(a->second - b->second) / static_cast<double>(at->second - bt->second)
+				   : 0.0;
+	return true;
+}
+
+} // namespace
+
+std::optional<double> ProcessEngineUtilization::groupPercent(std::initializer_list<std::string_view> classes) const
+{
+	double busy = 0.0;
+	uint32_t capacity = 0;
+	for (const auto cls : classes) {
+		if (const auto it = engines.find(cls); it != engines.end()) {
+			busy += it->second.percent * it->second.capacity;
+			capacity += it->second.capacity;
+		}
+	}
+	if (capacity == 0) {
+		return std::nullopt;
+	}
+	return busy / capacity;
+}
+
+std::optional<double> ProcessEngineUtilization::maxPercent() const
+{
+	std::optional<double> result;
+	for (const auto &[cls, busy] : engines) {
+		result = std::max(result.value_or(0.0), busy.percent);
+	}
+	return result;
+}
+
+bool parseDrmFdinfo(std::string_view text, std::string_view bdf, DrmClientCounters &out)
+{
+	bool havePdev = false;
+	bool haveClient = false;
+	out.clientId = 0;
+	out.residentBytes = 0;
+	out.engineNs.clear();
+	out.cycles.clear();
+	out.totalCycles.clear();
+	out.capacity.clear();
+
+	while (!text.empty()) {
+		const auto eol = text.find('\n');
+		const auto line = text.substr(0, eol);
+		text.remove_prefix(eol == std::string_view::npos ? text.size() : eol + 1);
+
+		const auto colon = line.find(':');
+		if (colon == std::string_view::npos) {
+			continue;
+		}
+		auto key = line.substr(0, colon);
+		const auto value = trim(line.substr(colon + 1));
+		if (!consumePrefix(key, "drm-")) {
+			continue;
+		}
+
+		uint64_t number = 0;
+		if (key == "pdev") {
+			if (!equalsIgnoreCase(value, bdf)) {
+				return false;
+			}
+			havePdev = true;
+		} else if (key == "client-id") {
+			haveClient = parseValue(value, out.clientId);
+		} else if (consumePrefix(key, "engine-capacity-")) {
+			if (parseValue(value, number) && number > 0) {
+				out.capacity[std::string{normalizeClass(key)}] = static_cast<uint32_t>(number);
+			}
+		} else if (consumePrefix(key, "engine-")) {
+			if (parseValue(value, number)) {
+				out.engineNs[std::string{normalizeClass(key)}] = number;
+			}
+		} else if (consumePrefix(key, "total-cycles-")) {
+			if (parseValue(value, number)) {
+				out.totalCycles[std::string{normalizeClass(key)}] = number;
+			}
+		} else if (consumePrefix(key, "cycles-")) {
+			if (parseValue(value, number)) {
+				out.cycles[std::string{normalizeClass(key)}] = number;
+			}
+		} else if (consumePrefix(key, "resident-")) {
+			if (parseValue(value, number)) {
+				out.residentBytes += number;
+			}
+		}
+	}
+	return havePdev && haveClient;
+}
+
+std::vector<DrmClientSnapshot> snapshotDrmClients(std::span<const std::string> bdfs, const ProcfsPaths &paths)
+{
+	std::vector<DrmClientSnapshot> snapshots(bdfs.size());
+	// Per device: client id -> index into that snapshot's clients
+	std::vector<std::unordered_map<uint64_t, size_t>> seen(bdfs.size());
+	if (bdfs.empty()) {
+		return snapshots;
+	}
+
+	std::error_code ec;
+	auto procIt = fs::directory_iterator(paths.procRoot, ec);
+	if (ec) {
+		return snapshots;
+	}
+	std::string text;
+	std::string link;
+	DrmClientCounters counters;
+	for (const auto &procEntry : procIt) {
+		uint32_t pid = 0;
+		if (!parsePid(procEntry.path().filename().native(), pid)) {
+			continue;
+		}
+		std::error_code fdEc;
+		for (const auto &fdEntry : fs::directory_iterator(procEntry.path() / "fd", fdEc)) {
+			// Only DRM device nodes have DRM fdinfo; skip everything else without reading it.
+			std::error_code linkEc;
+			link = fs::read_symlink(fdEntry.path(), linkEc).native();
+			if (linkEc || !link.starts_with("/dev/dri/")) {
+				continue;
+			}
+			if (!readProcFile(procEntry.path() / "fdinfo" / fdEntry.path().filename(), text)) {
+				continue;
+			}
+			for (size_t i = 0; i < bdfs.size(); ++i) {
+				if (!parseDrmFdinfo(text, bdfs[i], counters)) {
+					continue;
+				}
+				auto &snapshot = snapshots[i];
+				counters.pid = pid;
+				if (const auto it = seen[i].find(counters.clientId); it != seen[i].end()) {
+					auto &existing = snapshot.clients[it->second];
+					existing.pid = std::min(existing.pid, pid);
+				} else {
+					seen[i].emplace(counters.clientId, snapshot.clients.size());
+					snapshot.clients.push_back(counters);
+				}
+				break;
+			}
+		}
+	}
+
+	const auto now = std::chrono::steady_clock::now();
+	for (auto &snapshot : snapshots) {
+		snapshot.time = now;
+		snapshot.available = true;
+		std::ranges::sort(snapshot.clients, {}, &DrmClientCounters::clientId);
+	}
+	return snapshots;
+}
+
+std::vector<ProcessEngineUtilization> computeProcessUtilization(const DrmClientSnapshot &before,
+																const DrmClientSnapshot &after)
+{
+	const double elapsedNs =
+		static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(after.time - before.time).count());
+
+	std::map<uint32_t, ProcessEngineUtilization> byPid;
+	auto prev = before.clients.begin();
+	for (const auto &client : after.clients) {
+		auto &proc = byPid[client.pid];
+		proc.pid = client.pid;
+		proc.residentBytes += client.residentBytes;
+
+		prev = std::ranges::lower_bound(prev, before.clients.end(), client.clientId, {}, &DrmClientCounters::clientId);
+		if (prev == before.clients.end() || prev->clientId != client.clientId) {
+			continue;
+		}
+
+		auto addClass = [&](std::string_view cls) {
+			double fraction = 0.0;
+			if (!classBusy(*prev, client, cls, elapsedNs, fraction)) {
+				return;
+			}
+			const auto cap = client.capacity.find(cls);
+			const uint32_t capacity = cap != client.capacity.end() ? cap->second : 1;
+			auto &busy = proc.engines[std::string{cls}];
+			busy.capacity = capacity;
+			busy.percent = std::min(100.0, busy.percent + fraction * 100.0 / capacity);
+		};
+		for (const auto &[cls, ns] : client.engineNs) {
+			addClass(cls);
+		}
+		for (const auto &[cls, cycles] : client.cycles) {
+			if (!client.engineNs.contains(cls)) {
+				addClass(cls);
+			}
+		}
+	}
+
+	std::vector<ProcessEngineUtilization> result;
+	result.reserve(byPid.size());
+	for (auto &[pid, proc] : byPid) {
+		result.push_back(std::move(proc));
+	}
+	return result;
+}
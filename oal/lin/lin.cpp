@@ -8,6 +8,7 @@
 #include <algorithm>
 #include <array>
 #include <cctype>
+#include <chrono>
 #include <cerrno>
 #include <cmath>
 #include <cstring>
@@ -19,18 +20,26 @@
 #include <functional>
 #include <grp.h>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <poll.h>
 #include <pwd.h>
+#include <csignal>
 #include <spawn.h>
 #include <sys/utsname.h>
 #include <sys/wait.h>
 #include <syncstream>
 #include <termios.h>
+#include <thread>
 #include <unistd.h>
 #include <vector>
 
 #include "lin.h"
 #include "pci_database.h"
 #include "dmi_reader.h"
+#include "pci_path_index.h"
+#include "sysfs_attr.h"
+#include "uevent.h"
 #include "bdf.h"
 
 #if defined(__GNUC__)
@@ -141,6 +150,136 @@ SystemCommandResult execCommand(const std::string &command)
 	return {result, readError ? -1 : exitcode};
 }
 
+/** How often runHook() checks whether the hook has exited */
+static constexpr auto HOOK_POLL_INTERVAL = std::chrono::milliseconds(10);
+
+/**
+ * @brief Run a local hook command with @p input on its standard input
+ *
+ * Spawns /bin/sh -c like execCommand, but feeds @p input to the command instead of
+ * capturing its output, which goes to the caller's stdout and stderr. Used by
+ * health --watch to hand each alert to a user-supplied command. A hook that exits
+ * without reading its input does not raise SIGPIPE in the caller.
+ *
+ * The hook runs in its own process group. When it has not exited within @p timeout
+ * the whole group is killed, so a hung hook (or anything it started) cannot stall
+ * the caller.
+ *
+ * @param command The shell command string to execute
+ * @param input   Data written to the command's standard input
+ * @param timeout How long the command may run
+ * @return The command's exit status, or -1 when it could not be run or was killed
+ */
+int runHook(const std::string &command, const std::string &input, std::chrono::milliseconds timeout)
+{
+	const auto deadline = std::chrono::steady_clock::now() + timeout;
+	std::array<int, 2> pipeFds{};
+	if (pipe2(pipeFds.data(), O_CLOEXEC) != 0) {
+		ERR("Failed to create pipe for hook: {}\n", strerror(errno));
+		return -1;
+	}
+
+	posix_spawn_file_actions_t actions;
+	if (posix_spawn_file_actions_init(&actions) != 0) {
+		close(pipeFds[0]);
+		close(pipeFds[1]);
+		return -1;
+	}
+	posix_spawnattr_t attr;
+	if (posix_spawnattr_init(&attr) != 0) {
+		posix_spawn_file_actions_destroy(&actions);
+		close(pipeFds[0]);
+		close(pipeFds[1]);
+		return -1;
+	}
+	// dup2 clears O_CLOEXEC on the child's stdin; both pipe ends are closed on exec
+	int fileActionsResult = posix_spawn_file_actions_adddup2(&actions, pipeFds[0], STDIN_FILENO);
+	if (fileActionsResult == 0) {
+		fileActionsResult = posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETPGROUP);
+	}
+	if (fileActionsResult == 0) {
+		fileActionsResult = posix_spawnattr_setpgroup(&attr, 0);
+	}
+
+	char shPath[] = "/bin/sh";
+	char shFlag[] = "-c";
+	std::string cmdCopy = command;
+	char *argv[] = {shPath, shFlag, cmdCopy.data(), nullptr}; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+
+	pid_t pid = -1;
+	const int spawnResult =
+		fileActionsResult == 0 ? posix_spawn(&pid, "/bin/sh", &actions, &attr, argv, environ) : fileActionsResult;
+	posix_spawnattr_destroy(&attr);
+	posix_spawn_file_actions_destroy(&actions);
+	close(pipeFds[0]);
+	if (spawnResult != 0) {
+		close(pipeFds[1]);
+		ERR("Failed to run hook '{}': {}\n", command, strerror(spawnResult));
+		return -1;
+	}
+
+	// Block SIGPIPE on this thread while writing; a pending one raised here is consumed below
+	sigset_t pipeSet;
+	sigset_t previousMask;
+	sigemptyset(&pipeSet);
+	sigaddset(&pipeSet, SIGPIPE);
+	pthread_sigmask(SIG_BLOCK, &pipeSet, &previousMask);
+	sigset_t pendingBefore;
+	sigpending(&pendingBefore);
+
+	// Non-blocking, so a hook that never reads a large input cannot hold us past the deadline
+	fcntl(pipeFds[1], F_SETFL, fcntl(pipeFds[1], F_GETFL) | O_NONBLOCK);
+	size_t written = 0;
+	while (written < input.size()) {
+		const ssize_t n = write(pipeFds[1], input.data() + written, input.size() - written);
+		if (n > 0) {
+			written += static_cast<size_t>(n);
+			continue;
+		}
+		if (n < 0 && errno == EAGAIN) {
+			const auto remaining =
+				std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+			if (remaining.count() <= 0) {
+				break;
+			}
+			pollfd pfd{.fd = pipeFds[1], .events = POLLOUT, .revents = 0};
+			poll(&pfd, 1, static_cast<int>(std::min<int64_t>(remaining.count(), HOOK_POLL_INTERVAL.count())));
+		} else if (n < 0 && errno != EINTR) {
+			break; // EPIPE: the hook did not read its input
+		}
+	}
+	close(pipeFds[1]);
+
+	if (sigismember(&pendingBefore, SIGPIPE) == 0) {
+		const timespec noWait{};
+		while (sigtimedwait(&pipeSet, nullptr, &noWait) < 0 && errno == EINTR) {
+		}
+	}
+	pthread_sigmask(SIG_SETMASK, &previousMask, nullptr);
+
+	int status = 0;
+	for (;;) {
+		const pid_t waitResult = waitpid(pid, &status, WNOHANG);
+		if (waitResult == pid) {
+			return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+		}
+		if (waitResult < 0 && errno != EINTR) {
+			ERR("waitpid failed: {}\n", strerror(errno));
+			return -1;
+		}
+		if (std::chrono::steady_clock::now() >= deadline) {
+			break;
+		}
+		std::this_thread::sleep_for(HOOK_POLL_INTERVAL);
+	}
+
+	ERR("Hook '{}' did not finish within {} ms; killing it.\n", command, timeout.count());
+	kill(-pid, SIGKILL);
+	while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+	}
+	return -1;
+}
+
 /**
  * @brief Gets a single character from standard input without echo
  *
@@ -189,37 +328,6 @@ void restoreTerminal()
 	}
 }
 
-/**
- * @brief Creates a new thread.
- *
- * @param thread Function pointer to the thread function.
- * @param args Arguments to pass to the thread function.
- * @return A pointer to the thread_id object representing the created thread.
- */
-thread_id *create_thread(funcptr thread, void *args)
-{
-	pthread_t threadHdl;
-	pthread_create(&threadHdl, NULL, thread, args);
-
-	DBG("{}: thread handle is {}\n", __func__, threadHdl);
-	thread_id *newThreadId = new thread_id(threadHdl);
-	return newThreadId;
-}
-
-/**
- * @brief Waits for the specified thread to complete.
- *
- * @param tid Pointer to the thread_id object representing the thread to wait for.
- */
-void wait_for_thread(thread_id *tid)
-{
-	if (tid->ret_thread_uid()) {
-		DBG("{}: thread handle is {}\n", __func__, tid->ret_thread_uid());
-		pthread_join(tid->ret_thread_uid(), NULL);
-		delete tid; // Clean up the thread_id object after waiting
-	}
-}
-
 /**
  * @brief Checks if the current user has privilege to access XPUM resources
  *
@@ -331,7 +439,8 @@ std::string timestamp()
  * This function constructs a path to a sysfs file for a specific PCI device
  * using the Bus:Device:Function (BDF) address and a suffix, then reads the
  * first line from that file. It provides generic sysfs access capabilities
- * for PCI device information retrieval.
+ * for PCI device information retrieval. The file is kept open in the shared
+ * SysfsAttributeCache, so repeated reads of the same attribute cost one pread().
  *
  * @param bdf String containing the PCI Bus:Device:Function address
  * @param suffix String containing the sysfs file suffix to append to the device path
@@ -344,17 +453,7 @@ std::string getSysfsLine(const std::string &bdf, const std::string &suffix)
 		ERR("Rejecting suspicious BDF address: {}\n", bdf.c_str());
 		return "";
 	}
-	std::string affinity = "";
-	std::ifstream infile;
-	std::string file = std::string("/sys/bus/pci/devices/") + bdf + suffix;
-
-	infile.open(file.data());
-	if (infile.is_open()) {
-		std::getline(infile, affinity);
-	}
-
-	infile.close();
-	return affinity;
+	return SysfsAttributeCache::instance().readLine(std::string("/sys/bus/pci/devices/") + bdf + suffix);
 }
 
 /**
@@ -475,33 +574,18 @@ std::string pci2RegxString(hwloc_obj_t obj)
 /**
  * @brief Finds the sysfs device path for a given BDF address
  *
- * This function searches the Linux sysfs filesystem (/sys/devices) to locate
- * the device directory corresponding to a specific PCI Bus:Device:Function address.
- * It performs a recursive search through the device hierarchy to find the matching path.
+ * This function locates the device directory under /sys/devices corresponding to
+ * a specific PCI Bus:Device:Function address, using the physical paths recorded
+ * by the shared PciPathIndex instead of walking the device hierarchy.
  *
  * @param bdf_address String containing the PCI BDF address to search for
  * @return std::string Full path to the device directory in sysfs, empty string if not found
  */
 std::string getDevicePath(const std::string &bdfAddress)
 {
-	std::string result;
-	namespace stdfs = std::filesystem;
-
-	try {
-		for (stdfs::recursive_directory_iterator iter{"/sys/devices", stdfs::directory_options::skip_permission_denied};
-			 iter != stdfs::recursive_directory_iterator{}; ++iter) {
-			// Match on the exact path component, not a substring, to prevent
-			// partial BDF collisions (e.g. "0000:02:00.0" vs "0000:02:00.00")
-			if (stdfs::is_directory(*iter) && iter->path().filename().string() == bdfAddress) {
-				result = iter->path().string();
-				break;
-			}
-		}
-	} catch (const stdfs::filesystem_error &e) {
-		ERR("Error searching /sys/devices for {}: {}\n", bdfAddress.c_str(), e.what());
-	}
-
-	return result;
+	const auto index = PciPathIndex::shared();
+	const auto *entry = index->find(bdfAddress);
+	return entry != nullptr ? entry->sysfsPath.string() : std::string{};
 }
 
 /**
@@ -553,6 +637,52 @@ void getSwitchDevicePath(hwloc_obj_t parObj, std::string *switchDevicePath)
 	}
 }
 
+using HwlocTopologyPtr = std::shared_ptr<hwloc_topology>;
+
+static std::mutex hwlocTopologyMutex;
+static HwlocTopologyPtr hwlocTopology; // Guarded by hwlocTopologyMutex; null until loaded
+
+/**
+ * @brief Returns the process-wide hwloc topology, loading it on first use
+ *
+ * Loading walks all of sysfs, so the result is shared by every getTopology()
+ * call instead of being rebuilt per device. The topology is only read after
+ * loading, which hwloc allows from multiple threads; a caller keeps the one it
+ * got alive across invalidateHwlocTopology().
+ *
+ * @return Loaded topology, or nullptr if hwloc initialization failed
+ */
+static HwlocTopologyPtr sharedHwlocTopology()
+{
+	const std::lock_guard lock(hwlocTopologyMutex);
+	if (!hwlocTopology) {
+		hwloc_topology_t t = nullptr;
+		SETENV("HWLOC_COMPONENTS", "linux,stop");
+		if (hwloc_topology_init(&t) != 0) {
+			return nullptr;
+		}
+		hwloc_topology_set_io_types_filter(t, HWLOC_TYPE_FILTER_KEEP_ALL);
+		if (hwloc_topology_load(t) != 0) {
+			hwloc_topology_destroy(t);
+			return nullptr;
+		}
+		hwlocTopology = HwlocTopologyPtr(t, &hwloc_topology_destroy);
+	}
+	return hwlocTopology;
+}
+
+/**
+ * @brief Discards the shared hwloc topology; the next getTopology() loads it again
+ *
+ * Called with the other PCI caches when devices appear, disappear or are reset, and
+ * before every command of a batch, so no answer comes from a stale PCI tree.
+ */
+void invalidateHwlocTopology()
+{
+	const std::lock_guard lock(hwlocTopologyMutex);
+	hwlocTopology.reset();
+}
+
 /**
  * @brief Analyzes system topology and counts PCIe switches for a specific device
  *
@@ -566,12 +696,11 @@ void getSwitchDevicePath(hwloc_obj_t parObj, std::string *switchDevicePath)
  */
 int getTopology(bdfID bdf, std::string *switchDevicePath)
 {
-	// Initialize the topology object
-	hwloc_topology_t topology;
-	SETENV("HWLOC_COMPONENTS", "linux,stop");
-	hwloc_topology_init(&topology);
-	hwloc_topology_set_io_types_filter(topology, HWLOC_TYPE_FILTER_KEEP_ALL);
-	hwloc_topology_load(topology);
+	const HwlocTopologyPtr shared = sharedHwlocTopology();
+	if (shared == nullptr) {
+		return 0;
+	}
+	hwloc_topology_t topology = shared.get();
 	int switchCount = 0;
 
 	// Get the first PCI device
@@ -593,58 +722,23 @@ int getTopology(bdfID bdf, std::string *switchDevicePath)
 		pcidev = hwloc_get_next_pcidev(topology, pcidev);
 	}
 
-	// Destroy the topology object
-	hwloc_topology_destroy(topology);
 	return switchCount;
 }
 
 /**
  * @brief Gets the DRM device path for a specific BDF
  *
- * This function searches the /sys/class/drm directory to find the DRM device
- * path that corresponds to the given PCI Bus:Device:Function (BDF) address.
- * It looks for DRM card entries and matches their associated PCI device to the
- * specified BDF.
+ * Looks the BDF up in the shared PciPathIndex, which maps every PCI function to
+ * its DRM nodes in a single scan of /sys/class/drm.
  *
  * @param bdf BDF string (e.g., "0000:02:00.0")
- * @return std::string DRM device path (e.g., "/dev/dri/card0")
+ * @return std::string DRM device path (e.g., "/dev/dri/card0"), empty if the device has no DRM card node
  */
 std::string getDrmPath(const std::string &bdf)
 {
-	// Go through /sys/class/drm to find all card that do not have a '-'
-	// in their names (e.g. card0, card1, etc.)
-	std::string drmPath = "";
-	try {
-		for (const auto &entry : std::filesystem::directory_iterator("/sys/class/drm")) {
-			std::string cardName = entry.path().filename().string();
-			// cardName must start with "card"
-			if (cardName.find("card") != 0) {
-				continue;
-			}
-			// and cardName must not contain a '-'
-			if (cardName.find('-') == std::string::npos) {
-				// Found a card without a '-' in its name
-				drmPath = entry.path().string();
-
-				// Once found, go in this directory and get the basename of the "device" symlink
-				std::string deviceLink = drmPath + "/device";
-				if (std::filesystem::exists(deviceLink) && std::filesystem::is_symlink(deviceLink)) {
-					std::string devicePath = std::filesystem::read_symlink(deviceLink).string();
-					std::string deviceBdf = std::filesystem::path(devicePath).filename().string();
-					if (deviceBdf == bdf) {
-						// Return /dev/dri/cardX
-						drmPath = "/dev/dri/" + cardName;
-						return drmPath;
-					}
-				}
-			}
-		}
-	} catch (const std::filesystem::filesystem_error &e) {
-		// Handle filesystem errors (e.g. permission denied)
-		ERR("Error accessing /sys/class/drm: {}\n", e.what());
-	}
-
-	return drmPath;
+	const auto index = PciPathIndex::shared();
+	const auto *entry = index->find(bdf);
+	return entry != nullptr ? entry->cardNode : std::string{};
 }
 
 /**
@@ -779,6 +873,23 @@ std::string getKernelVersion()
 	return "";
 }
 
+/**
+ * @brief Drops cached sysfs state after PCI functions appeared, disappeared or were rebound
+ *
+ * Closes the SysfsAttributeCache descriptors under the device's sysfs directory and
+ * discards the shared PciPathIndex and hwloc topology, so the next lookups see the
+ * current BDF, driver, DRM node and switch mapping. Call after resets, driver rebinds
+ * and VF creation or removal.
+ *
+ * @param[in] bdf PCI BDF address of the device that changed
+ */
+void invalidatePciCaches(const std::string &bdf)
+{
+	SysfsAttributeCache::instance().invalidate(std::format("/sys/bus/pci/devices/{}/", bdf));
+	PciPathIndex::invalidate();
+	invalidateHwlocTopology();
+}
+
 /**
  * @brief Get the PCI slot label/designation for a device
  *
@@ -801,15 +912,9 @@ std::string getPciSlotLabel(const std::string &bdf)
 	}
 
 	// Try sysfs label first (fast path but rarely populated)
-	std::string labelPath = std::format("/sys/bus/pci/devices/{}/label", bdf);
-	std::ifstream labelFile(labelPath);
-
-	if (labelFile.is_open()) {
-		std::string label;
-		std::getline(labelFile, label);
-		if (!label.empty()) {
-			return label;
-		}
+	std::string label = SysfsAttributeCache::instance().readLine(std::format("/sys/bus/pci/devices/{}/label", bdf));
+	if (!label.empty()) {
+		return label;
 	}
 
 	// Fallback to SMBIOS/DMI tables
@@ -904,6 +1009,7 @@ int getXeDevPciProps(std::vector<xeDevPciInfo> *pciPropsList)
 	namespace fs = std::filesystem;
 	std::error_code ec;
 
+	const auto index = PciPathIndex::shared();
 	try {
 		for (const auto &entry : fs::directory_iterator(kXeDriverPath, fs::directory_options::skip_permission_denied)) {
 			if (!fs::is_symlink(entry.symlink_status(ec)) || ec)
@@ -927,19 +1033,14 @@ int getXeDevPciProps(std::vector<xeDevPciInfo> *pciPropsList)
 			// --- Resolve root port BDF for accurate PCIe link attributes -----
 			// Intel Xe GPU endpoints (and PCIe switch downstream ports) may
 			// report incorrect Gen/width in their own LnkCap registers.  The
-			// root port — first BDF in the symlink path — is always configured
-			// correctly by BIOS for the physical slot.  Walk the raw symlink
-			// target components to find it:
-			//   ../../../../devices/pci0000:00/0000:00:06.0/0000:02:00.0/0000:03:01.0/0000:04:00.0
-			//                                               ^^^^^^^^^^^^  ← root port (first valid BDF)
+			// root port — first BDF below the host bridge in the physical
+			// path — is always configured correctly by BIOS for the physical slot:
+			//   /sys/devices/pci0000:00/0000:00:06.0/0000:02:00.0/0000:03:01.0/0000:04:00.0
+			//                           ^^^^^^^^^^^^  ← root port
 			std::string linkBdf = bdf;
-			for (const auto &component : targetPath) {
-				const std::string name = component.string();
-				if (isValidBdf(name) && name != bdf) {
-					linkBdf = name;
-					DBG("Using root port BDF %s for link attributes of %s\n", linkBdf.c_str(), bdf.c_str());
-					break;
-				}
+			if (const auto *dev = index->find(bdf); dev != nullptr && dev->rootPort != bdf) {
+				linkBdf = dev->rootPort;
+				DBG("Using root port BDF {} for link attributes of {}\n", linkBdf, bdf);
 			}
 
 			// --- PCIe max link speed -------------------------------------------
@@ -993,10 +1094,10 @@ static constexpr uint32_t PCI_EXP_SLTCAP_HPC = 0x0040;	   // Hot-Plug Capable (b
 static constexpr uint32_t PCI_EXP_SLTCAP_PSN = 0xFFF80000; // Physical Slot Number (bits 31:19)
 
 /**
- * @brief Finds the root port BDF for a given GPU PCI device by walking the sysfs topology
+ * @brief Finds the root port BDF for a given GPU PCI device from the sysfs topology
  *
- * Traverses parent directories in /sys/bus/pci/devices/<gpuBdf>/ upward until
- * reaching the root port (the bridge whose parent is a PCI domain root).
+ * The root port is the bridge whose parent is a PCI domain root; the shared
+ * PciPathIndex records it from the device's physical sysfs path.
  *
  * @param gpuBdf BDF string of the GPU device (e.g., "0000:4d:00.0")
  * @param rootPortBdf Output string to store the root port BDF
@@ -1009,47 +1110,14 @@ static bool findRootPortBdf(const std::string &gpuBdf, std::string &rootPortBdf)
 		return false;
 	}
 
-	std::error_code ec;
-	std::filesystem::path devPath = "/sys/bus/pci/devices/" + gpuBdf;
-
-	if (!std::filesystem::exists(devPath, ec)) {
-		ERR("GPU sysfs path not found: {}\n", devPath.string());
-		return false;
-	}
-
-	// Resolve symlink to physical path, e.g. /sys/devices/pci0000:00/0000:00:01.0/0000:4d:00.0
-	std::filesystem::path realPath = std::filesystem::canonical(devPath, ec);
-	if (ec) {
-		ERR("Failed to resolve sysfs path for {}: {}\n", gpuBdf, ec.message());
+	const auto index = PciPathIndex::shared();
+	const auto *entry = index->find(gpuBdf);
+	if (entry == nullptr) {
+		ERR("GPU sysfs path not found: /sys/bus/pci/devices/{}\n", gpuBdf);
 		return false;
 	}
 
-	// Walk up from the GPU device through parent bridges.
-	// The root port is the first bridge whose parent directory name starts with "pci"
-	std::filesystem::path current = realPath;
-	std::filesystem::path candidate;
-
-	while (current.has_parent_path() && current != current.parent_path()) {
-		std::filesystem::path parent = current.parent_path();
-		std::string parentName = parent.filename().string();
-
-		if (parentName.starts_with("pci")) {
-			candidate = current;
-			break;
-		}
-		std::string currentName = current.filename().string();
-		if (isValidBdf(currentName)) {
-			candidate = current;
-		}
-		current = parent;
-	}
-
-	if (candidate.empty()) {
-		ERR("Could not find root port for {}\n", gpuBdf);
-		return false;
-	}
-
-	rootPortBdf = candidate.filename().string();
+	rootPortBdf = entry->rootPort;
 	DBG("Root port for {} is {}\n", gpuBdf, rootPortBdf);
 	return true;
 }
@@ -1129,7 +1197,7 @@ static bool readSlotCapabilities(const std::string &rootPortBdf, uint32_t &slotC
 
 // Cold reset timing constants
 static constexpr int POWER_CYCLE_DELAY_US = 1000000; // 1s for power rail discharge
-static constexpr int POLL_INTERVAL_MS = 200;		 // Re-enumeration poll interval
+static constexpr int POLL_INTERVAL_MS = 200;		 // Fallback poll interval when no uevent arrives
 static constexpr int REENUM_TIMEOUT_MS = 10000;		 // 10s max wait for re-enumeration
 static constexpr int BIND_TIMEOUT_MS = 5000;		 // 5s max wait for driver auto-bind
 
@@ -1144,13 +1212,8 @@ static constexpr int BIND_TIMEOUT_MS = 5000;		 // 5s max wait for driver auto-bi
  */
 static std::string getPciDriverName(const std::string &bdf)
 {
-	std::error_code ec;
-	std::filesystem::path link = "/sys/bus/pci/devices/" + bdf + "/driver";
-	std::filesystem::path target = std::filesystem::read_symlink(link, ec);
-	if (ec) {
-		return "";
-	}
-	return target.filename().string();
+	// Binding changes during a reset, so read the link rather than the path index
+	return readPciDriver(bdf);
 }
 
 /**
@@ -1185,6 +1248,11 @@ static bool writeToPciDriverFile(const std::string &driverName, const std::strin
  * 2. Reads the PCIe Slot Capabilities register to check for hot-plug and power control
  * 3. Derives the physical slot number from bits 31:19
  * 4. Power-cycles the slot via /sys/bus/pci/slots/<slot>/power (echo 0, then echo 1)
+ * 5. Waits for the device's remove, add and driver bind uevents
+ *
+ * Completion is detected from kernel uevents as soon as they arrive; sysfs is
+ * polled every POLL_INTERVAL_MS as a fallback. Each call owns its uevent socket,
+ * so resets of different devices may run concurrently.
  *
  * @param gpuBdf BDF string of the GPU device (e.g., "0000:4d:00.0")
  * @return 0 on success, -1 if sysfs cold reset is not supported (caller may
@@ -1243,6 +1311,18 @@ int coldResetViaSysfs(const std::string &gpuBdf)
 
 	INFO("Performing cold reset on {} via slot {} power cycle\n", gpuBdf, slotNum);
 
+	// Subscribe before touching the device so that no remove/add/bind event is missed
+	UeventSocket uevents;
+	PciResetTracker tracker{gpuBdf};
+	if (!uevents.isOpen()) {
+		DBG("Cannot subscribe to uevents ({}); polling sysfs for {}\n", strerror(errno), gpuBdf);
+	}
+	const std::string gpuSysfsPath = "/sys/bus/pci/devices/" + gpuBdf;
+	auto deviceEnumerated = [&gpuSysfsPath]() {
+		std::error_code devEc;
+		return std::filesystem::exists(gpuSysfsPath, devEc);
+	};
+
 	// Unbind the kernel driver before power-off
 	std::string driverName = getPciDriverName(gpuBdf);
 	if (!driverName.empty()) {
@@ -1302,51 +1382,40 @@ int coldResetViaSysfs(const std::string &gpuBdf)
 
 	// Wait for device to re-enumerate after power-on.
 	// The device needs time for link training and PCI enumeration.
-	std::string gpuSysfsPath = "/sys/bus/pci/devices/" + gpuBdf;
-	int elapsed = 0;
-
-	while (elapsed < REENUM_TIMEOUT_MS) {
-		usleep(POLL_INTERVAL_MS * 1000);
-		elapsed += POLL_INTERVAL_MS;
-
-		std::error_code devEc;
-		if (std::filesystem::exists(gpuSysfsPath, devEc)) {
-			INFO("Device {} re-enumerated after {} ms\n", gpuBdf, elapsed);
-			break;
-		}
-	}
-
-	if (elapsed >= REENUM_TIMEOUT_MS) {
+	const auto reenumStart = std::chrono::steady_clock::now();
+	if (!tracker.waitFor(uevents, PciResetStage::ADDED, reenumStart + std::chrono::milliseconds(REENUM_TIMEOUT_MS),
+						 deviceEnumerated, std::chrono::milliseconds(POLL_INTERVAL_MS))) {
 		ERR("Device {} did not re-enumerate within {} ms after power-on\n", gpuBdf, REENUM_TIMEOUT_MS);
 		return 1;
 	}
+	INFO("Device {} re-enumerated after {} ms\n", gpuBdf,
+		 std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - reenumStart).count());
 
 	// After re-enumeration, the PCI subsystem normally auto-binds the matching
 	// driver. If it does not happen within the timeout, fall back
 	// to an explicit bind. Skipped if no driver was bound originally.
 	if (!driverName.empty()) {
-		int bindElapsed = 0;
-		std::string boundDriver;
-		while (bindElapsed < BIND_TIMEOUT_MS) {
-			boundDriver = getPciDriverName(gpuBdf);
-			if (!boundDriver.empty()) {
-				break;
-			}
-			usleep(POLL_INTERVAL_MS * 1000);
-			bindElapsed += POLL_INTERVAL_MS;
-		}
+		const auto bindStart = std::chrono::steady_clock::now();
+		const bool bound = tracker.waitFor(
+			uevents, PciResetStage::BOUND, bindStart + std::chrono::milliseconds(BIND_TIMEOUT_MS),
+			[&gpuBdf]() { return !getPciDriverName(gpuBdf).empty(); }, std::chrono::milliseconds(POLL_INTERVAL_MS));
 
-		if (boundDriver.empty()) {
+		if (!bound) {
 			INFO("Driver '{}' did not auto-bind to {}; performing explicit bind\n", driverName, gpuBdf);
 			if (!writeToPciDriverFile(driverName, "bind", gpuBdf)) {
 				ERR("Explicit driver bind failed for {}\n", gpuBdf);
 				return 1;
 			}
 		} else {
-			DBG("Driver '{}' bound to {} after {} ms\n", boundDriver, gpuBdf, bindElapsed);
+			DBG("Driver '{}' bound to {} after {} ms\n",
+				tracker.driver().empty() ? getPciDriverName(gpuBdf) : tracker.driver(), gpuBdf,
+				std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - bindStart)
+					.count());
 		}
 	}
 
+	// The device was removed and re-enumerated; drop descriptors into its old sysfs nodes
+	invalidatePciCaches(gpuBdf);
 	INFO("Cold reset completed for {} via slot {}\n", gpuBdf, slotNum);
 	return 0;
 }
@@ -1376,30 +1445,17 @@ std::vector<uint32_t> getGpuProcessesByBdf(const std::string &gpuBdf)
 	}
 
 	// Find all /dev/dri/ device node names belonging to this BDF.
-	// /sys/class/drm/card<N> is a symlink whose resolved path contains the BDF.
 	std::vector<std::string> deviceNodes; // e.g. {"/dev/dri/card0", "/dev/dri/renderD128"}
 	std::error_code ec;
-
-	for (const auto &entry : fs::directory_iterator("/sys/class/drm", ec)) {
-		std::string name = entry.path().filename().string();
-		if (name.rfind("card", 0) != 0 || name.find('-') != std::string::npos)
-			continue;
-
-		auto resolved = fs::canonical(entry.path(), ec);
-		if (ec || resolved.string().find(gpuBdf) == std::string::npos)
-			continue;
-
-		// Found the card - enumerate device/drm/ for all DRM node names
-		fs::path devDrmDir = entry.path() / "device" / "drm";
-		if (fs::is_directory(devDrmDir, ec)) {
-			for (const auto &node : fs::directory_iterator(devDrmDir, ec)) {
-				std::string nodeName = node.path().filename().string();
-				if (nodeName.rfind("card", 0) == 0 || nodeName.rfind("renderD", 0) == 0) {
-					deviceNodes.push_back("/dev/dri/" + nodeName);
+	{
+		const auto index = PciPathIndex::shared();
+		if (const auto *entry = index->find(gpuBdf); entry != nullptr) {
+			for (const auto *node : {&entry->cardNode, &entry->renderNode}) {
+				if (!node->empty()) {
+					deviceNodes.push_back(*node);
 				}
 			}
 		}
-		break;
 	}
 
 	if (deviceNodes.empty()) {
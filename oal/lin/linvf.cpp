@@ -485,6 +485,8 @@ static bool createVfInternal(std::string drmPath, std::string bdfAddress, AttrFr
 	if (writeFile(devicePathString + "/device/sriov_numvfs", std::to_string(numVfs)) != 0) {
 		return false;
 	}
+	// The VFs are new PCI functions with their own DRM nodes
+	invalidatePciCaches(bdfAddress);
 	return true;
 }
 
@@ -813,6 +815,7 @@ int removeAllVFs(DeviceSriovInfo *devInfo)
 	if (writeFile(numvfsPath.str(), "0") != 0) {
 		return -1;
 	}
+	invalidatePciCaches(devInfo->bdfAddress);
 
 	std::string debugfsPath = std::string("/sys/kernel/debug/dri/") + devInfo->bdfAddress;
 	std::string cardName = getCardNameFromDrmPath(devInfo->drmPath);
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include <mapped_file.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+std::filesystem::path MappedFile::dataDirectory()
+{
+	if (const char *dir = std::getenv("XPUM_DATA_DIR"); dir != nullptr && *dir != '\0') {
+		return dir;
+	}
+
+	// Only when we can write there: root may have created it before we ran as a user
+	const std::filesystem::path dir = "/var/lib/xpum";
+	if ((mkdir(dir.c_str(), 0755) == 0 || errno == EEXIST) && access(dir.c_str(), W_OK) == 0) {
+		return dir;
+	}
+	// Not root: keep the data with the user instead
+	if (const char *home = std::getenv("HOME"); home != nullptr && *home != '\0') {
+		return std::filesystem::path(home) / ".local/state/xpum";
+	}
+	return std::filesystem::temp_directory_path() / "xpum";
+}
+
+/**
+ * @brief mmap()s the file; a writer holds an exclusive flock on it while mapped
+ *
+ * The writer takes the lock before it looks at the size, so two processes creating the
+ * same file do not both size it.
+ */
+bool MappedFile::open(const std::filesystem::path &path, MappedFileMode mode, std::size_t createSize,
+					  std::string &error)
+{
+	close();
+	const bool write = mode == MappedFileMode::READ_WRITE;
+	const int flags = write ? (O_RDWR | (createSize > 0 ? O_CREAT : 0)) : O_RDONLY;
+	const int fd = ::open(path.c_str(), flags | O_CLOEXEC, 0644);
+	if (fd < 0) {
+		error = std::strerror(errno);
+		return false;
+	}
+	const auto fail = [&](std::string reason) {
+		::close(fd);
+		error = std::move(reason);
+		return false;
+	};
+
+	if (write && flock(fd, LOCK_EX | LOCK_NB) != 0) {
+		return fail(errno == EWOULDBLOCK ? "in use by another process" : std::strerror(errno));
+	}
+
+	struct stat st;
+	if (fstat(fd, &st) != 0) {
+		return fail(std::strerror(errno));
+	}
+	auto size = static_cast<std::size_t>(st.st_size);
+	bool created = false;
+	if (size == 0 && write && createSize > 0) {
+		// ftruncate() leaves a hole: blocks are allocated as pages are first written
+		if (ftruncate(fd, static_cast<off_t>(createSize)) != 0) {
+			return fail(std::strerror(errno));
+		}
+		size = createSize;
+		created = true;
+	}
+	if (size == 0) {
+		return fail("empty file");
+	}
+
+	void *data = mmap(nullptr, size, write ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd, 0);
+	if (data == MAP_FAILED) {
+		return fail(std::strerror(errno));
+	}
+
+	mData = static_cast<std::byte *>(data);
+	mSize = size;
+	mHandle = static_cast<uintptr_t>(fd);
+	mMode = mode;
+	mCreated = created;
+	return true;
+}
+
+void MappedFile::close()
+{
+	if (mData == nullptr) {
+		return;
+	}
+	munmap(mData, mSize);
+	// Closing the descriptor drops the writer's flock
+	::close(static_cast<int>(mHandle));
+	mData = nullptr;
+	mSize = 0;
+	mHandle = 0;
+}
+
+bool MappedFile::flush(std::size_t offset, std::size_t length) const
+{
+	if (mData == nullptr || offset >= mSize) {
+		return false;
+	}
+	const auto page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+	const std::size_t start = offset - offset % page;
+	const std::size_t end = std::min(offset + length, mSize);
+	return msync(mData + start, end - start, MS_SYNC) == 0;
+}
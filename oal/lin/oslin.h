@@ -9,6 +9,7 @@
 #ifndef _OSLIN_H
 #define _OSLIN_H
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <cstdio>
@@ -18,9 +19,11 @@
 #include <string>
 #include <unistd.h>
 #include <sys/time.h>
+#include <time.h>
 #include <vector>
 #include <osvf.h>
 #include "topology.h"
+#include "cpu_affinity.h"
 
 #ifndef MAX_PATH
 #define MAX_PATH 256
@@ -30,7 +33,6 @@
 #define STRCPY_S(dest, sz, src) snprintf((dest), (sz), "%s", (src))
 #define STRNCPY_S(dest, src, sz) snprintf((dest), (sz), "%s", (src))
 #define STRCASECMP strcasecmp
-#define THREAD_RET void *
 #define GETOPT_LONG getopt_long
 #define GETGFXFWSTATUS(meiPath) getGfxFwStatus(meiPath)
 #define PRIVILEGECHECK() privilegeCheck()
@@ -56,6 +58,26 @@ inline auto GET_PCIE_PATHS(const std::vector<std::string> &bdfs)
 {
 	return getPciePaths(bdfs);
 } // NOLINT(readability-identifier-naming) // Match MACRO style while providing a better interface for navigation
+inline auto GET_TOPOLOGY_MODEL(const std::vector<std::string> &gpuBdfs)
+{
+	return loadTopologyModel(gpuBdfs);
+} // NOLINT(readability-identifier-naming) // Match MACRO style while providing a better interface for navigation
+inline bool PIN_THREAD_TO_DEVICES(const std::vector<std::string> &bdfs)
+{
+	return pinThreadToDevices(bdfs);
+} // NOLINT(readability-identifier-naming) // Match MACRO style while providing a better interface for navigation
+inline bool RESTRICT_PROCESS_CPUS(std::string_view cpuList)
+{
+	const auto cpus = CpuSet::parse(cpuList);
+	return cpus && restrictProcessCpus(*cpus);
+} // NOLINT(readability-identifier-naming) // Match MACRO style while providing a better interface for navigation
+/** Nanoseconds of CLOCK_MONOTONIC_RAW: not slewed by NTP, so short intervals between counter reads stay exact */
+inline uint64_t MONOTONIC_RAW_NS()
+{
+	timespec ts{};
+	clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+	return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+} // NOLINT(readability-identifier-naming) // Match MACRO style while providing a better interface for navigation
 typedef wchar_t TCHAR;
 #define GETLOGS(f) getLinLogs(f)
 #define GETDRMPATH(bdf) getDrmPath(bdf)
@@ -67,7 +89,10 @@ typedef wchar_t TCHAR;
 #define SRIOVSUPPORT(deviceInfoPtr) isSriovSupported(deviceInfoPtr)
 #define GETKERNELVERSION() getKernelVersion()
 #define GETPCISLOTLABEL(bdf) getPciSlotLabel(bdf)
+#define INVALIDATE_PCI_CACHES(bdf) invalidatePciCaches(bdf)
+#define INVALIDATE_TOPOLOGY_CACHES() invalidateHwlocTopology()
 #define FINDRESOURCEFILE(relativePath) findResourceFile(relativePath)
+#define RUN_HOOK(command, input, timeout) runHook(command, input, timeout)
 
 static inline int fopen_s_def(FILE **pFile, const char *filename, const char *mode)
 {
@@ -77,21 +102,6 @@ static inline int fopen_s_def(FILE **pFile, const char *filename, const char *mo
 
 #define FOPEN_S(pFile, filename, mode) fopen_s_def((pFile), (filename), (mode))
 
-typedef void *(*funcptr)(void *input_params);
-
-class thread_id
-{
-
-protected:
-	pthread_t thread_hdl;
-
-public:
-	thread_id(pthread_t hdl) { thread_hdl = hdl; }
-	pthread_t ret_thread_uid() { return thread_hdl; }
-};
-
-thread_id *create_thread(funcptr thread, void *args);
-void wait_for_thread(thread_id *tid);
 bool privilegeCheck();
 char getch();
 void restoreTerminal();
@@ -110,7 +120,10 @@ bool isIommuSupported();
 bool isSriovSupported(DeviceSriovInfo *di);
 std::string getKernelVersion();
 std::string getPciSlotLabel(const std::string &bdf);
+void invalidatePciCaches(const std::string &bdf);
+void invalidateHwlocTopology();
 std::string findResourceFile(const std::string &relativePath);
+int runHook(const std::string &command, const std::string &input, std::chrono::milliseconds timeout);
 int coldResetViaSysfs(const std::string &gpuBdf);
 std::vector<uint32_t> getGpuProcessesByBdf(const std::string &gpuBdf);
 std::vector<std::string> getDevicesSharingSlotWith(const std::string &gpuBdf);
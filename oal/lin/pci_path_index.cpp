@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "pci_path_index.h"
+#include "bdf.h"
+#include <mutex>
+#include <system_error>
+#include <utility>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+std::mutex sharedMutex;
+std::shared_ptr<const PciPathIndex> sharedIndex;
+
+/// Physical path of a /sys/bus/pci/devices/<bdf> entry, resolved with a single readlink.
+fs::path physicalPath(const fs::path &link)
+{
+	std::error_code ec;
+	const auto target = fs::read_symlink(link, ec);
+	if (ec) {
+		return link;
+	}
+	return target.is_absolute() ? target : (link.parent_path() / target).lexically_normal();
+}
+
+/// Fills bridges and rootPort from the BDF-named components above the device.
+void resolveUpstream(PciDeviceEntry &entry)
+{
+	for (auto dir = entry.sysfsPath.parent_path(); dir.has_filename(); dir = dir.parent_path()) {
+		const auto name = dir.filename().string();
+		if (!isValidBdf(name)) {
+			break; // Reached the host bridge (pci<domain>:<bus>)
+		}
+		entry.bridges.push_back(name);
+	}
+	entry.rootPort = entry.bridges.empty() ? entry.bdf : entry.bridges.back();
+}
+
+} // namespace
+
+PciPathIndex PciPathIndex::build(const PciIndexPaths &paths)
+{
+	PciPathIndex index;
+	std::error_code ec;
+
+	for (const auto &dirEntry : fs::directory_iterator(paths.pciDevRoot, ec)) {
+		auto name = dirEntry.path().filename().string();
+		if (!isValidBdf(name)) {
+			continue;
+		}
+		PciDeviceEntry entry;
+		entry.bdf = name;
+		entry.sysfsPath = physicalPath(dirEntry.path());
+		entry.driver = readPciDriver(name, paths);
+		resolveUpstream(entry);
+		index.entries.emplace(std::move(name), std::move(entry));
+	}
+
+	for (const auto &dirEntry : fs::directory_iterator(paths.drmRoot, ec)) {
+		const auto name = dirEntry.path().filename().string();
+		// Connectors (card0-DP-1) share the card prefix but are not device nodes
+		const bool card = name.starts_with("card") && name.find('-') == std::string::npos;
+		if (!card && !name.starts_with("renderD")) {
+			continue;
+		}
+		std::error_code linkEc;
+		const auto bdf = fs::read_symlink(dirEntry.path() / "device", linkEc).filename().string();
+		if (linkEc) {
+			continue;
+		}
+		const auto it = index.entries.find(bdf);
+		if (it == index.entries.end()) {
+			continue;
+		}
+		(card ? it->second.cardNode : it->second.renderNode) = (paths.devNodeRoot / name).string();
+	}
+	return index;
+}
+
+std::shared_ptr<const PciPathIndex> PciPathIndex::shared()
+{
+	const std::lock_guard lock(sharedMutex);
+	if (!sharedIndex) {
+		sharedIndex = std::make_shared<const PciPathIndex>(build());
+	}
+	return sharedIndex;
+}
+
+void PciPathIndex::invalidate()
+{
+	const std::lock_guard lock(sharedMutex);
+	sharedIndex.reset();
+}
+
+const PciDeviceEntry *PciPathIndex::find(std::string_view bdf) const
+{
+	const auto it = entries.find(bdf);
+	return it == entries.end() ? nullptr : &it->second;
+}
+
+std::string readPciDriver(std::string_view bdf, const PciIndexPaths &paths)
+{
+	std::error_code ec;
+	const auto target = fs::read_symlink(paths.pciDevRoot / bdf / "driver", ec);
+	return ec ? std::string{} : target.filename().string();
+}
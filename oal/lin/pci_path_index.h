@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef PCI_PATH_INDEX_H
+#define PCI_PATH_INDEX_H
+
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Sysfs roots scanned by PciPathIndex — separated for testability
+ */
+struct PciIndexPaths
+{
+	std::filesystem::path pciDevRoot{"/sys/bus/pci/devices"}; ///< One symlink per PCI function, named by BDF
+	std::filesystem::path drmRoot{"/sys/class/drm"};		  ///< card<N> and renderD<N> nodes
+	std::filesystem::path devNodeRoot{"/dev/dri"};			  ///< Directory reported for DRM device nodes
+};
+
+/**
+ * @brief Sysfs and DRM paths of one PCI function
+ */
+struct PciDeviceEntry
+{
+	std::string bdf;					  ///< e.g. "0000:4d:00.0"
+	std::filesystem::path sysfsPath;	  ///< Physical path, e.g. /sys/devices/pci0000:00/0000:00:01.0/0000:4d:00.0
+	std::string driver;					  ///< Bound kernel driver ("xe", "i915"); empty when unbound
+	std::string cardNode;				  ///< Primary DRM node, e.g. /dev/dri/card0; empty when none
+	std::string renderNode;				  ///< Render DRM node, e.g. /dev/dri/renderD128; empty when none
+	std::string rootPort;				  ///< BDF directly below the PCI host bridge; the device itself on the root bus
+	std::vector<std::string> bridges;	  ///< Upstream bridge BDFs, nearest first, ending with rootPort
+};
+
+/**
+ * @brief BDF-keyed index of PCI and DRM sysfs paths, built in one scan
+ *
+ * Reads the pciDevRoot directory once (one readlink per function for its physical
+ * path and one for its driver) and the drmRoot directory once (one readlink per DRM
+ * node), instead of walking sysfs again for every lookup.
+ *
+ * shared() returns a process-wide index built on first use. Call invalidate() when
+ * PCI devices appear, disappear or change driver so the next shared() rescans.
+ */
+class PciPathIndex
+{
+public:
+	/** @brief Scans sysfs under @p paths; missing roots yield an empty index */
+	static PciPathIndex build(const PciIndexPaths &paths = {});
+
+	/** @brief The process-wide index of the live sysfs tree */
+	static std::shared_ptr<const PciPathIndex> shared();
+
+	/** @brief Drops the process-wide index; the next shared() call rebuilds it */
+	static void invalidate();
+
+	/** @brief Entry for @p bdf, or nullptr when the function is not present */
+	[[nodiscard]] const PciDeviceEntry *find(std::string_view bdf) const;
+
+	[[nodiscard]] size_t size() const { return entries.size(); }
+
+private:
+	struct BdfHash
+	{
+		using is_transparent = void;
+		size_t operator()(std::string_view s) const noexcept { return std::hash<std::string_view>{}(s); }
+	};
+
+	std::unordered_map<std::string, PciDeviceEntry, BdfHash, std::equal_to<>> entries;
+};
+
+/**
+ * @brief Reads the driver bound to @p bdf right now (one readlink, bypassing the index)
+ *
+ * @return Driver name, or an empty string when no driver is bound
+ */
+std::string readPciDriver(std::string_view bdf, const PciIndexPaths &paths = {});
+
+#endif // PCI_PATH_INDEX_H
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "sysfs_attr.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <array>
+#include <cerrno>
+#include <utility>
+
+SysfsAttribute::SysfsAttribute(std::string path) : attrPath(std::move(path)) {}
+
+SysfsAttribute::~SysfsAttribute() { close(); }
+
+SysfsAttribute::SysfsAttribute(SysfsAttribute &&other) noexcept
+	: attrPath(std::move(other.attrPath)), fd(std::exchange(other.fd, -1))
+{
+}
+
+SysfsAttribute &SysfsAttribute::operator=(SysfsAttribute &&other) noexcept
+{
+	if (this != &other) {
+		close();
+		attrPath = std::move(other.attrPath);
+		fd = std::exchange(other.fd, -1);
+	}
+	return *this;
+}
+
+bool SysfsAttribute::open()
+{
+	close();
+	fd = ::open(attrPath.c_str(), O_RDONLY | O_CLOEXEC);
+	return fd >= 0;
+}
+
+void SysfsAttribute::close()
+{
+	if (fd >= 0) {
+		::close(fd);
+		fd = -1;
+	}
+}
+
+std::optional<size_t> SysfsAttribute::readOnce(std::span<char> buf)
+{
+	ssize_t n = 0;
+	do {
+		n = ::pread(fd, buf.data(), buf.size(), 0);
+	} while (n < 0 && errno == EINTR);
+	if (n < 0) {
+		return std::nullopt;
+	}
+	return static_cast<size_t>(n);
+}
+
+std::optional<std::string_view> SysfsAttribute::read(std::span<char> buf)
+{
+	const bool fresh = fd < 0;
+	if (fresh && !open()) {
+		return std::nullopt;
+	}
+	auto n = readOnce(buf);
+	if (!n && !fresh) {
+		// The descriptor went stale (ENODEV after unplug or driver unbind, ESTALE,
+		// EIO after a reset): the attribute may exist again under the same path.
+		if (!open()) {
+			return std::nullopt;
+		}
+		n = readOnce(buf);
+	}
+	if (!n) {
+		close();
+		return std::nullopt;
+	}
+
+	std::string_view value{buf.data(), *n};
+	const auto last = value.find_last_not_of(" \t\r\n");
+	return value.substr(0, last == std::string_view::npos ? 0 : last + 1);
+}
+
+SysfsAttributeCache &SysfsAttributeCache::instance()
+{
+	static SysfsAttributeCache cache;
+	return cache;
+}
+
+std::optional<std::string_view> SysfsAttributeCache::readInto(std::string_view path, std::span<char> buf)
+{
+	auto it = attributes.find(path);
+	if (it == attributes.end()) {
+		SysfsAttribute attribute{std::string{path}};
+		const auto value = attribute.read(buf);
+		if (!value) {
+			return std::nullopt;
+		}
+		if (attributes.size() >= maxOpen) {
+			attributes.clear();
+		}
+		attributes.try_emplace(std::string{path}, std::move(attribute));
+		return value;
+	}
+	const auto value = it->second.read(buf);
+	if (!value) {
+		attributes.erase(it);
+	}
+	return value;
+}
+
+std::string SysfsAttributeCache::readLine(std::string_view path)
+{
+	std::array<char, SYSFS_ATTR_MAX_SIZE> buf;
+	const std::lock_guard lock(mutex);
+	const auto value = readInto(path, buf);
+	if (!value) {
+		return {};
+	}
+	return std::string{value->substr(0, value->find('\n'))};
+}
+
+void SysfsAttributeCache::invalidate(std::string_view prefix)
+{
+	const std::lock_guard lock(mutex);
+	std::erase_if(attributes, [prefix](const auto &entry) { return entry.first.starts_with(prefix); });
+}
+
+size_t SysfsAttributeCache::size() const
+{
+	const std::lock_guard lock(mutex);
+	return attributes.size();
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef SYSFS_ATTR_H
+#define SYSFS_ATTR_H
+
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/**
+ * @brief Largest value a sysfs attribute can hold; show() handlers write into one page
+ */
+inline constexpr size_t SYSFS_ATTR_MAX_SIZE = 4096;
+
+/**
+ * @brief One sysfs attribute kept open for repeated reads
+ *
+ * sysfs regenerates an attribute's contents on every read at offset 0, so the
+ * descriptor stays valid across reads and each sample costs a single pread().
+ * When the device behind it goes away (hot-unplug, reset, driver rebind) the
+ * descriptor starts failing; the attribute then reopens its path once and retries.
+ */
+class SysfsAttribute
+{
+public:
+	explicit SysfsAttribute(std::string path);
+	~SysfsAttribute();
+
+	SysfsAttribute(const SysfsAttribute &) = delete;
+	SysfsAttribute &operator=(const SysfsAttribute &) = delete;
+	SysfsAttribute(SysfsAttribute &&other) noexcept;
+	SysfsAttribute &operator=(SysfsAttribute &&other) noexcept;
+
+	/**
+	 * @brief Reads the current value into @p buf
+	 *
+	 * @param buf Destination; values longer than the buffer are truncated
+	 * @return The value with trailing whitespace removed, or std::nullopt if the
+	 *         attribute cannot be opened or read
+	 */
+	[[nodiscard]] std::optional<std::string_view> read(std::span<char> buf);
+
+	/** @brief Closes the descriptor; the next read() reopens the path */
+	void close();
+
+	[[nodiscard]] const std::string &path() const { return attrPath; }
+	[[nodiscard]] bool isOpen() const { return fd >= 0; }
+
+private:
+	bool open();
+	std::optional<size_t> readOnce(std::span<char> buf);
+
+	std::string attrPath;
+	int fd{-1};
+};
+
+/**
+ * @brief Process-wide cache of open sysfs attributes, keyed by path
+ *
+ * Lookups use the caller's string_view without building a key and the value is
+ * read into a stack buffer, so a cached read performs no open()/close() syscalls.
+ * Paths that cannot be opened are not cached. The cache
+ * holds at most `limit` descriptors; reaching the limit closes all of them.
+ */
+class SysfsAttributeCache
+{
+public:
+	static constexpr size_t DEFAULT_MAX_OPEN = 256;
+
+	explicit SysfsAttributeCache(size_t limit = DEFAULT_MAX_OPEN) : maxOpen(limit) {}
+
+	/** @brief Cache shared by all OAL sysfs helpers */
+	static SysfsAttributeCache &instance();
+
+	/** @brief First line of the attribute, or an empty string if it cannot be read */
+	[[nodiscard]] std::string readLine(std::string_view path);
+
+	/**
+	 * @brief Closes every cached attribute whose path starts with @p prefix
+	 *
+	 * Call after resetting or removing a device, e.g. with "/sys/bus/pci/devices/<bdf>/".
+	 * An empty prefix closes everything.
+	 */
+	void invalidate(std::string_view prefix = {});
+
+	/** @brief Number of descriptors currently held */
+	[[nodiscard]] size_t size() const;
+
+private:
+	struct PathHash
+	{
+		using is_transparent = void;
+		size_t operator()(std::string_view s) const noexcept { return std::hash<std::string_view>{}(s); }
+	};
+
+	/** @brief Reads @p path into @p buf under the lock; the view points into @p buf */
+	std::optional<std::string_view> readInto(std::string_view path, std::span<char> buf);
+
+	mutable std::mutex mutex;
+	std::unordered_map<std::string, SysfsAttribute, PathHash, std::equal_to<>> attributes;
+	size_t maxOpen;
+};
+
+#endif // SYSFS_ATTR_H
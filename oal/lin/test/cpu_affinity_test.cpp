@@ -0,0 +1,291 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ * Unit tests for cpu_affinity.cpp against a fake sysfs tree and the real scheduler
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include "cpu_affinity.h"
+#include "fake_sysfs.h"
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+/// bus/pci/devices/<bdf>/{local_cpulist,numa_node}
+class FakeSysfs : public FakeSysfsRoot
+{
+public:
+	FakeSysfs() : FakeSysfsRoot("cpu_affinity_test") {}
+
+	void addDevice(const std::string &bdf, const std::string &localCpus, const std::string &numaNode) const
+	{
+		fs::create_directories(root / bdf);
+		std::ofstream(root / bdf / "local_cpulist") << localCpus << "\n";
+		std::ofstream(root / bdf / "numa_node") << numaNode << "\n";
+	}
+};
+
+uint32_t firstCpu(const CpuSet &set)
+{
+	uint32_t cpu = 0;
+	while (!set.contains(cpu)) {
+		++cpu;
+	}
+	return cpu;
+}
+
+/// A CPU the process may not use; there is always one above the highest allowed CPU
+uint32_t forbiddenCpu(const CpuSet &allowed)
+{
+	uint32_t cpu = 0;
+	while (allowed.contains(cpu)) {
+		++cpu;
+	}
+	return cpu;
+}
+
+CpuSet single(uint32_t cpu)
+{
+	CpuSet set;
+	set.add(cpu);
+	return set;
+}
+
+/// Affinity of a fresh thread after it ran @p fn
+template <typename Fn> CpuSet affinityAfter(Fn fn)
+{
+	CpuSet result;
+	std::thread([&] {
+		fn();
+		result = CpuSet::ofCurrentThread();
+	}).join();
+	return result;
+}
+
+} // namespace
+
+TEST_SUITE("CpuSet")
+{
+	TEST_CASE("parses sysfs cpu lists")
+	{
+		const auto set = CpuSet::parse("0-3,8,10-11\n");
+		REQUIRE(set.has_value());
+		CHECK(set->count() == 7);
+		CHECK(set->contains(0));
+		CHECK(set->contains(3));
+		CHECK_FALSE(set->contains(4));
+		CHECK(set->contains(8));
+		CHECK(set->contains(11));
+		CHECK(set->toString() == "0-3,8,10-11");
+
+		CHECK(CpuSet::parse("130")->toString() == "130");
+		CHECK(CpuSet::parse(" 5 , 1-2 ")->toString() == "1-2,5");
+	}
+
+	TEST_CASE("an empty list is an empty set")
+	{
+		const auto set = CpuSet::parse("\n");
+		REQUIRE(set.has_value());
+		CHECK(set->empty());
+		CHECK(set->toString().empty());
+	}
+
+	TEST_CASE("rejects malformed lists")
+	{
+		CHECK_FALSE(CpuSet::parse("3-1").has_value());
+		CHECK_FALSE(CpuSet::parse("0-").has_value());
+		CHECK_FALSE(CpuSet::parse("1,,2").has_value());
+		CHECK_FALSE(CpuSet::parse("a").has_value());
+		CHECK_FALSE(CpuSet::parse("-1").has_value());
+		CHECK_FALSE(CpuSet::parse("99999999").has_value());
+	}
+
+	TEST_CASE("set operations ignore trailing empty words")
+	{
+		auto low = *CpuSet::parse("0-1");
+		const auto high = *CpuSet::parse("1,200");
+		CHECK((low & high) == single(1));
+		CHECK((high & low) == single(1));
+		low |= high;
+		CHECK(low.toString() == "0-1,200");
+		CHECK((*CpuSet::parse("200") & *CpuSet::parse("0")) == CpuSet{});
+	}
+
+	TEST_CASE("the current thread may run somewhere")
+	{
+		CHECK_FALSE(CpuSet::ofCurrentThread().empty());
+	}
+}
+
+TEST_SUITE("device locality")
+{
+	TEST_CASE("reads local_cpulist and numa_node")
+	{
+		const FakeSysfs sysfs;
+		sysfs.addDevice("0000:4d:00.0", "0-7,16-23", "0");
+		sysfs.addDevice("0000:9a:00.0", "8-15", "-1");
+
+		CHECK(readLocalCpus("0000:4d:00.0", sysfs.root).toString() == "0-7,16-23");
+		CHECK(readNumaNode("0000:4d:00.0", sysfs.root) == 0);
+		CHECK(readNumaNode("0000:9a:00.0", sysfs.root) == -1);
+	}
+
+	TEST_CASE("missing attributes mean no locality")
+	{
+		const FakeSysfs sysfs;
+		CHECK(readLocalCpus("0000:01:00.0", sysfs.root).empty());
+		CHECK(readNumaNode("0000:01:00.0", sysfs.root) == -1);
+	}
+
+	TEST_CASE("pins the calling thread to the device's local CPUs")
+	{
+		const auto allowed = allowedProcessCpus();
+		const auto cpu = firstCpu(allowed);
+		const FakeSysfs sysfs;
+		// The forbidden CPU stands for a core outside the process's cpuset
+		sysfs.addDevice("0000:4d:00.0", single(cpu).toString() + "," + std::to_string(forbiddenCpu(allowed)), "0");
+
+		const std::vector<std::string> bdfs{"0000:4d:00.0"};
+		bool pinned = false;
+		const auto affinity = affinityAfter([&] { pinned = pinThreadToDevices(bdfs, sysfs.root); });
+		CHECK(pinned);
+		CHECK(affinity == single(cpu));
+		// Only the worker thread moved
+		CHECK(CpuSet::ofCurrentThread() == allowed);
+	}
+
+	TEST_CASE("pins to the union of several devices")
+	{
+		const auto allowed = allowedProcessCpus();
+		if (allowed.count() < 2) {
+			MESSAGE("Needs two usable CPUs; skipped");
+			return;
+		}
+		const auto a = firstCpu(allowed);
+		uint32_t b = a + 1;
+		while (!allowed.contains(b)) {
+			++b;
+		}
+		const FakeSysfs sysfs;
+		sysfs.addDevice("0000:4d:00.0", std::to_string(a), "0");
+		sysfs.addDevice("0000:9a:00.0", std::to_string(b), "1");
+
+		const std::vector<std::string> bdfs{"0000:4d:00.0", "0000:9a:00.0"};
+		auto expected = single(a);
+		expected |= single(b);
+		CHECK(affinityAfter([&] { CHECK(pinThreadToDevices(bdfs, sysfs.root)); }) == expected);
+	}
+
+	TEST_CASE("leaves the thread alone when no local CPU is allowed")
+	{
+		const auto allowed = allowedProcessCpus();
+		const FakeSysfs sysfs;
+		sysfs.addDevice("0000:4d:00.0", std::to_string(forbiddenCpu(allowed)), "1");
+		sysfs.addDevice("0000:9a:00.0", "", "-1");
+
+		for (const auto *bdf : {"0000:4d:00.0", "0000:9a:00.0", "0000:01:00.0"}) {
+			const std::vector<std::string> bdfs{bdf};
+			CAPTURE(bdf);
+			bool pinned = true;
+			CHECK(affinityAfter([&] { pinned = pinThreadToDevices(bdfs, sysfs.root); }) == allowed);
+			CHECK_FALSE(pinned);
+		}
+	}
+
+	TEST_CASE("a guard restores the pin the thread had when the guard was created")
+	{
+		const auto allowed = allowedProcessCpus();
+		if (allowed.count() < 2) {
+			MESSAGE("Needs two usable CPUs; skipped");
+			return;
+		}
+		const auto a = firstCpu(allowed);
+		uint32_t b = a + 1;
+		while (!allowed.contains(b)) {
+			++b;
+		}
+		const FakeSysfs sysfs;
+		sysfs.addDevice("0000:4d:00.0", std::to_string(a), "0");
+		sysfs.addDevice("0000:9a:00.0", std::to_string(b), "-1");
+		const std::vector<std::string> outer{"0000:4d:00.0"};
+		const std::vector<std::string> inner{"0000:9a:00.0"};
+
+		std::thread([&] {
+			{
+				const ThreadPinGuard restorePin{};
+				REQUIRE(pinThreadToDevices(outer, sysfs.root));
+				CHECK(CpuSet::ofCurrentThread() == single(a));
+				{
+					// A task run inline pins to its own device, then unpins
+					const ThreadPinGuard taskScope{};
+					REQUIRE(pinThreadToDevices(inner, sysfs.root));
+					CHECK(CpuSet::ofCurrentThread() == single(b));
+					unpinThread();
+				}
+				CHECK(CpuSet::ofCurrentThread() == single(a));
+			}
+			CHECK(CpuSet::ofCurrentThread() == allowed);
+		}).join();
+	}
+}
+
+TEST_SUITE("housekeeping cpus")
+{
+	TEST_CASE("restricts running and future threads, and device pinning stays inside")
+	{
+		const auto startup = allowedProcessCpus();
+		const auto cpu = firstCpu(startup);
+
+		std::atomic<bool> restricted{false};
+		CpuSet runningAffinity;
+		std::thread running([&] {
+			while (!restricted) {
+				std::this_thread::yield();
+			}
+			runningAffinity = CpuSet::ofCurrentThread();
+		});
+
+		REQUIRE(restrictProcessCpus(single(cpu)));
+		restricted = true;
+		running.join();
+
+		CHECK(runningAffinity == single(cpu));
+		CHECK(CpuSet::ofCurrentThread() == single(cpu));
+		CHECK(affinityAfter([] {}) == single(cpu));
+		CHECK(allowedProcessCpus() == single(cpu));
+
+		// A device local to other CPUs only cannot pull a thread out of the set
+		if (startup.count() > 1) {
+			uint32_t other = cpu + 1;
+			while (!startup.contains(other)) {
+				++other;
+			}
+			const FakeSysfs sysfs;
+			sysfs.addDevice("0000:4d:00.0", std::to_string(other), "0");
+			const std::vector<std::string> bdfs{"0000:4d:00.0"};
+			CHECK(affinityAfter([&] { CHECK_FALSE(pinThreadToDevices(bdfs, sysfs.root)); }) == single(cpu));
+		}
+
+		REQUIRE(restrictProcessCpus(startup));
+		CHECK(CpuSet::ofCurrentThread() == startup);
+		CHECK(allowedProcessCpus() == startup);
+	}
+
+	TEST_CASE("rejects a set outside the startup CPUs")
+	{
+		const auto before = allowedProcessCpus();
+		CHECK_FALSE(restrictProcessCpus(single(forbiddenCpu(before))));
+		CHECK_FALSE(restrictProcessCpus(CpuSet{}));
+		CHECK(allowedProcessCpus() == before);
+		CHECK(CpuSet::ofCurrentThread() == before);
+	}
+}
@@ -0,0 +1,289 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ * Unit tests for device_lock.cpp with lock holders in forked processes
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <device_lock.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace std::chrono_literals;
+
+namespace {
+
+class TempLockDir
+{
+public:
+	fs::path path;
+
+	TempLockDir() : path(fs::temp_directory_path() / ("device_lock_test_" + std::to_string(::getpid())))
+	{
+		fs::remove_all(path);
+	}
+
+	~TempLockDir()
+	{
+		std::error_code ec;
+		fs::remove_all(path, ec);
+	}
+};
+
+/**
+ * @brief A child process that acquires @p requests, reports the outcome and then holds
+ *        the locks until it is told to exit, or exits right away when @p hold is false
+ */
+class Holder
+{
+public:
+	Holder(const fs::path &dir, std::vector<DeviceLockRequest> requests, std::chrono::milliseconds timeout = 0ms,
+		   bool hold = true)
+	{
+		int ready[2], quit[2];
+		REQUIRE(pipe(ready) == 0);
+		REQUIRE(pipe(quit) == 0);
+		pid = fork();
+		REQUIRE(pid >= 0);
+		if (pid == 0) {
+			close(ready[0]);
+			close(quit[1]);
+			DeviceLocks locks = DeviceLockManager(dir).acquire(std::move(requests), timeout);
+			const char status = locks.locked() ? 'L' : 'B';
+			(void)!write(ready[1], &status, 1);
+			char c;
+			if (hold) {
+				(void)!read(quit[0], &c, 1);
+			}
+			_exit(0);
+		}
+		close(ready[1]);
+		close(quit[0]);
+		readyFd = ready[0];
+		quitFd = quit[1];
+	}
+
+	~Holder()
+	{
+		stop();
+		close(readyFd);
+	}
+
+	/** @brief Waits for the child to finish acquiring; true when it holds its locks */
+	bool waitLocked()
+	{
+		char status = 0;
+		REQUIRE(read(readyFd, &status, 1) == 1);
+		return status == 'L';
+	}
+
+	void stop()
+	{
+		if (quitFd < 0) {
+			return;
+		}
+		close(quitFd);
+		quitFd = -1;
+		int status;
+		waitpid(pid, &status, 0);
+	}
+
+	pid_t pid;
+
+private:
+	int readyFd = -1;
+	int quitFd = -1;
+};
+
+DeviceLockRequest shared(const std::string &resource)
+{
+	return {resource, DeviceLockMode::SHARED};
+}
+
+DeviceLockRequest exclusive(const std::string &resource)
+{
+	return {resource, DeviceLockMode::EXCLUSIVE};
+}
+
+/** @brief Makes the lock file of @p resource, as the first exclusive request for it does */
+void createLockFile(const DeviceLockManager &manager, const std::string &resource)
+{
+	REQUIRE(manager.acquire({exclusive(resource)}, 0ms).locked());
+}
+
+} // namespace
+
+TEST_CASE("Requests are sorted and merged with exclusive winning")
+{
+	std::vector<DeviceLockRequest> requests = {shared("gpu:0000:4d:00.0"), exclusive("amc:0"),
+											   shared("gpu:0000:03:00.0"), exclusive("gpu:0000:4d:00.0"),
+											   shared("amc:0")};
+	normalizeDeviceLockRequests(requests);
+
+	REQUIRE(requests.size() == 3);
+	CHECK(requests[0].resource == "amc:0");
+	CHECK(requests[0].mode == DeviceLockMode::EXCLUSIVE);
+	CHECK(requests[1].resource == "gpu:0000:03:00.0");
+	CHECK(requests[1].mode == DeviceLockMode::SHARED);
+	CHECK(requests[2].resource == "gpu:0000:4d:00.0");
+	CHECK(requests[2].mode == DeviceLockMode::EXCLUSIVE);
+}
+
+TEST_CASE("Shared locks coexist and exclude an exclusive one")
+{
+	TempLockDir dir;
+	DeviceLockManager manager(dir.path);
+	const std::string gpu = DeviceLockManager::gpu("0000:03:00.0");
+	createLockFile(manager, gpu);
+
+	Holder reader(dir.path, {shared(gpu)});
+	REQUIRE(reader.waitLocked());
+
+	DeviceLocks second = manager.acquire({shared(gpu)}, 0ms);
+	CHECK(second.locked());
+	second.release();
+
+	DeviceLocks writer = manager.acquire({exclusive(gpu)}, 50ms);
+	CHECK_FALSE(writer.locked());
+	CHECK(writer.busyResource() == gpu);
+	CHECK(writer.holders() == std::vector<int>{reader.pid});
+
+	reader.stop();
+	CHECK(manager.acquire({exclusive(gpu)}, 0ms).locked());
+}
+
+TEST_CASE("An exclusive lock leaves other devices alone")
+{
+	TempLockDir dir;
+	DeviceLockManager manager(dir.path);
+
+	Holder updater(dir.path, {exclusive(DeviceLockManager::gpu("0000:03:00.0"))});
+	REQUIRE(updater.waitLocked());
+
+	CHECK(manager.acquire({exclusive(DeviceLockManager::gpu("0000:4d:00.0"))}, 0ms).locked());
+	CHECK_FALSE(manager.acquire({shared(DeviceLockManager::gpu("0000:03:00.0"))}, 0ms).locked());
+}
+
+TEST_CASE("Waiting ends at the deadline and drops the locks already taken")
+{
+	TempLockDir dir;
+	DeviceLockManager manager(dir.path);
+	const std::string first = DeviceLockManager::gpu("0000:03:00.0");
+	const std::string second = DeviceLockManager::gpu("0000:4d:00.0");
+
+	Holder holder(dir.path, {exclusive(second)});
+	REQUIRE(holder.waitLocked());
+
+	const auto start = std::chrono::steady_clock::now();
+	DeviceLocks locks = manager.acquire({exclusive(second), exclusive(first)}, 200ms);
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+
+	CHECK_FALSE(locks.locked());
+	CHECK(locks.busyResource() == second);
+	CHECK(elapsed >= 200ms);
+	CHECK(elapsed < 2s);
+
+	// first was locked before second was found busy, and is free again
+	Holder other(dir.path, {exclusive(first)});
+	CHECK(other.waitLocked());
+}
+
+TEST_CASE("A waiter gets the lock once its holder exits")
+{
+	TempLockDir dir;
+	DeviceLockManager manager(dir.path);
+	const std::string amc = DeviceLockManager::amc(0);
+
+	Holder holder(dir.path, {exclusive(amc)});
+	REQUIRE(holder.waitLocked());
+
+	pid_t stopper = fork();
+	REQUIRE(stopper >= 0);
+	if (stopper == 0) {
+		usleep(100 * 1000);
+		kill(holder.pid, SIGKILL);
+		_exit(0);
+	}
+
+	DeviceLocks locks = manager.acquire({exclusive(amc)}, 5s);
+	CHECK(locks.locked());
+	waitpid(stopper, nullptr, 0);
+}
+
+TEST_CASE("Opposite request orders do not deadlock")
+{
+	TempLockDir dir;
+	const std::string a = DeviceLockManager::gpu("0000:03:00.0");
+	const std::string b = DeviceLockManager::gpu("0000:4d:00.0");
+
+	std::vector<std::unique_ptr<Holder>> holders;
+	for (int i = 0; i < 8; ++i) {
+		auto requests = i % 2 ? std::vector{exclusive(a), exclusive(b)} : std::vector{exclusive(b), exclusive(a)};
+		// Every child exits right after acquiring, letting the next one in
+		holders.push_back(std::make_unique<Holder>(dir.path, requests, 10s, false));
+	}
+	for (auto &holder : holders) {
+		CHECK(holder->waitLocked());
+	}
+}
+
+TEST_CASE("Only exclusive requests create lock files, private to their owner")
+{
+	TempLockDir dir;
+	DeviceLockManager manager(dir.path);
+	const std::string gpu = DeviceLockManager::gpu("0000:03:00.0");
+	const fs::path file = dir.path / "gpu_0000_03_00.0.lock";
+
+	DeviceLocks reader = manager.acquire({shared(gpu)}, 0ms);
+	CHECK(reader.locked());
+	CHECK(reader.unlockedResources().empty());
+	CHECK_FALSE(fs::exists(file));
+
+	CHECK(manager.acquire({exclusive(gpu)}, 0ms).locked());
+	REQUIRE(fs::exists(file));
+	CHECK((fs::status(file).permissions() & fs::perms::all) == (fs::perms::owner_read | fs::perms::owner_write));
+}
+
+TEST_CASE("A shared request that cannot open its lock file is let through and reported")
+{
+	TempLockDir dir;
+	DeviceLockManager manager(dir.path);
+	const std::string gpu = DeviceLockManager::gpu("0000:03:00.0");
+	const fs::path file = dir.path / "gpu_0000_03_00.0.lock";
+	fs::create_symlink(dir.path / "elsewhere", file);
+
+	DeviceLocks reader = manager.acquire({shared(gpu)}, 0ms);
+	CHECK(reader.locked());
+	CHECK(reader.unlockedResources() == std::vector<std::string>{gpu});
+
+	// Lock files are not followed through symlinks
+	DeviceLocks writer = manager.acquire({exclusive(gpu)}, 0ms);
+	CHECK_FALSE(writer.locked());
+	CHECK_FALSE(fs::exists(dir.path / "elsewhere"));
+}
+
+TEST_CASE("Without a lock directory writers fail and readers go on unlocked")
+{
+	DeviceLockManager manager{fs::path{}};
+	const std::string gpu = DeviceLockManager::gpu("0000:03:00.0");
+
+	DeviceLocks reader = manager.acquire({shared(gpu)}, 0ms);
+	CHECK(reader.locked());
+	CHECK_FALSE(reader.noLockDirectory());
+	CHECK(reader.unlockedResources() == std::vector<std::string>{gpu});
+
+	DeviceLocks writer = manager.acquire({shared(DeviceLockManager::amc(0)), exclusive(gpu)}, 0ms);
+	CHECK_FALSE(writer.locked());
+	CHECK(writer.noLockDirectory());
+	CHECK(writer.busyResource() == gpu);
+	CHECK_FALSE(fs::exists("gpu_0000_03_00.0.lock"));
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ * Scratch directory standing in for /sys in unit tests
+ */
+
+#ifndef FAKE_SYSFS_H
+#define FAKE_SYSFS_H
+
+#include <unistd.h>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+/**
+ * @brief Empty directory under the temp directory, private to the test process, that a
+ *        test fills with the sysfs entries it needs
+ *
+ * Anything left at the path by an earlier, crashed run is removed first; the directory
+ * is removed again on destruction.
+ */
+class FakeSysfsRoot
+{
+public:
+	std::filesystem::path root;
+
+	explicit FakeSysfsRoot(std::string_view name)
+		: root(std::filesystem::temp_directory_path() / (std::string(name) + "_" + std::to_string(::getpid())))
+	{
+		std::filesystem::remove_all(root);
+		std::filesystem::create_directories(root);
+	}
+
+	~FakeSysfsRoot()
+	{
+		std::error_code ec;
+		std::filesystem::remove_all(root, ec);
+	}
+
+	FakeSysfsRoot(const FakeSysfsRoot &) = delete;
+	FakeSysfsRoot &operator=(const FakeSysfsRoot &) = delete;
+};
+
+#endif // FAKE_SYSFS_H
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ * Unit tests for pci_path_index.cpp against a fake sysfs tree
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include "fake_sysfs.h"
+#include "pci_path_index.h"
+#include <filesystem>
+#include <string>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+/// Minimal sysfs layout: devices/, bus/pci/devices/, bus/pci/drivers/ and class/drm/.
+class FakeSysfs : public FakeSysfsRoot
+{
+public:
+	PciIndexPaths paths;
+
+	FakeSysfs() : FakeSysfsRoot("pci_path_index_test")
+	{
+		fs::create_directories(root / "bus/pci/devices");
+		fs::create_directories(root / "class/drm");
+		paths.pciDevRoot = root / "bus/pci/devices";
+		paths.drmRoot = root / "class/drm";
+	}
+
+	/// Adds a PCI function at @p physical (relative to devices/), linked the way the kernel does.
+	void addPci(const std::string &physical, const std::string &driver = {}) const
+	{
+		const auto dir = root / "devices" / physical;
+		fs::create_directories(dir);
+		const auto bdf = dir.filename().string();
+		fs::create_directory_symlink("../../../devices/" + physical, root / "bus/pci/devices" / bdf);
+		if (!driver.empty()) {
+			fs::create_directories(root / "bus/pci/drivers" / driver);
+			fs::create_directory_symlink("../../../bus/pci/drivers/" + driver, dir / "driver");
+		}
+	}
+
+	/// Adds a DRM node whose device link points at @p physical.
+	void addDrm(const std::string &node, const std::string &physical) const
+	{
+		const auto dir = root / "devices" / physical / "drm" / node;
+		fs::create_directories(dir);
+		fs::create_directory_symlink("../../../" + fs::path(physical).filename().string(), dir / "device");
+		fs::create_directory_symlink("../../devices/" + physical + "/drm/" + node, root / "class/drm" / node);
+	}
+};
+
+constexpr auto ROOT_PORT = "pci0000:00/0000:00:06.0";
+constexpr auto SWITCH_UP = "pci0000:00/0000:00:06.0/0000:02:00.0";
+constexpr auto SWITCH_DOWN = "pci0000:00/0000:00:06.0/0000:02:00.0/0000:03:01.0";
+constexpr auto GPU = "pci0000:00/0000:00:06.0/0000:02:00.0/0000:03:01.0/0000:04:00.0";
+constexpr auto IGPU = "pci0000:00/0000:00:02.0";
+
+} // namespace
+
+TEST_SUITE("PciPathIndex")
+{
+	TEST_CASE("maps a GPU behind a switch to its nodes, driver and upstream bridges")
+	{
+		FakeSysfs sysfs;
+		sysfs.addPci(ROOT_PORT, "pcieport");
+		sysfs.addPci(SWITCH_UP, "pcieport");
+		sysfs.addPci(SWITCH_DOWN, "pcieport");
+		sysfs.addPci(GPU, "xe");
+		sysfs.addDrm("card1", GPU);
+		sysfs.addDrm("card1-DP-1", GPU);
+		sysfs.addDrm("renderD129", GPU);
+
+		const auto index = PciPathIndex::build(sysfs.paths);
+		CHECK(index.size() == 4);
+		const auto *gpu = index.find("0000:04:00.0");
+		REQUIRE(gpu != nullptr);
+		CHECK(gpu->driver == "xe");
+		CHECK(gpu->cardNode == "/dev/dri/card1");
+		CHECK(gpu->renderNode == "/dev/dri/renderD129");
+		CHECK(gpu->rootPort == "0000:00:06.0");
+		CHECK(gpu->bridges == std::vector<std::string>{"0000:03:01.0", "0000:02:00.0", "0000:00:06.0"});
+		CHECK(gpu->sysfsPath == sysfs.root / "devices" / GPU);
+
+		const auto *port = index.find("0000:00:06.0");
+		REQUIRE(port != nullptr);
+		CHECK(port->rootPort == "0000:00:06.0");
+		CHECK(port->bridges.empty());
+		CHECK(port->cardNode.empty());
+	}
+
+	TEST_CASE("a device on the root bus is its own root port")
+	{
+		FakeSysfs sysfs;
+		sysfs.addPci(IGPU);
+		sysfs.addDrm("card0", IGPU);
+
+		const auto index = PciPathIndex::build(sysfs.paths);
+		const auto *igpu = index.find("0000:00:02.0");
+		REQUIRE(igpu != nullptr);
+		CHECK(igpu->rootPort == "0000:00:02.0");
+		CHECK(igpu->driver.empty());
+		CHECK(igpu->cardNode == "/dev/dri/card0");
+		CHECK(igpu->renderNode.empty());
+	}
+
+	TEST_CASE("unknown BDFs and missing roots")
+	{
+		FakeSysfs sysfs;
+		sysfs.addPci(IGPU);
+		CHECK(PciPathIndex::build(sysfs.paths).find("0000:99:00.0") == nullptr);
+
+		PciIndexPaths missing;
+		missing.pciDevRoot = sysfs.root / "absent";
+		missing.drmRoot = sysfs.root / "absent";
+		CHECK(PciPathIndex::build(missing).size() == 0);
+	}
+
+	TEST_CASE("readPciDriver follows the live driver link")
+	{
+		FakeSysfs sysfs;
+		sysfs.addPci(IGPU, "i915");
+		CHECK(readPciDriver("0000:00:02.0", sysfs.paths) == "i915");
+		fs::remove(sysfs.root / "devices" / IGPU / "driver");
+		CHECK(readPciDriver("0000:00:02.0", sysfs.paths).empty());
+	}
+}
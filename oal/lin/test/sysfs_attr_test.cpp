@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ * Unit tests for sysfs_attr.cpp against regular files standing in for sysfs attributes
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include "sysfs_attr.h"
+#include <unistd.h>
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+class TempDirectory
+{
+public:
+	fs::path path;
+
+	TempDirectory() : path(fs::temp_directory_path() / ("sysfs_attr_test_" + std::to_string(::getpid())))
+	{
+		fs::remove_all(path);
+		fs::create_directories(path);
+	}
+
+	~TempDirectory()
+	{
+		std::error_code ec;
+		fs::remove_all(path, ec);
+	}
+
+	std::string write(const std::string &name, const std::string &content) const
+	{
+		const auto file = path / name;
+		std::ofstream(file) << content;
+		return file.string();
+	}
+};
+
+/// Rewrites the file in place so an open descriptor sees the new contents.
+void rewrite(const std::string &file, const std::string &content)
+{
+	std::ofstream(file, std::ios::in | std::ios::out | std::ios::trunc) << content;
+}
+
+} // namespace
+
+TEST_SUITE("SysfsAttribute")
+{
+	TEST_CASE("re-reads the current value through the same descriptor")
+	{
+		TempDirectory dir;
+		const auto file = dir.write("cur_freq", "1200\n");
+		SysfsAttribute attr{file};
+		std::array<char, 64> buf{};
+
+		auto value = attr.read(buf);
+		REQUIRE(value);
+		CHECK(*value == "1200");
+		CHECK(attr.isOpen());
+
+		rewrite(file, "300\n");
+		value = attr.read(buf);
+		REQUIRE(value);
+		CHECK(*value == "300");
+	}
+
+	TEST_CASE("a missing attribute reads as nullopt and stays closed")
+	{
+		TempDirectory dir;
+		SysfsAttribute attr{(dir.path / "absent").string()};
+		std::array<char, 64> buf{};
+		CHECK_FALSE(attr.read(buf));
+		CHECK_FALSE(attr.isOpen());
+	}
+
+	TEST_CASE("an unreadable attribute is reopened on the next read")
+	{
+		TempDirectory dir;
+		const auto file = (dir.path / "numa_node").string();
+		fs::create_directory(file); // opens, but reads fail like a removed sysfs node
+		SysfsAttribute attr{file};
+		std::array<char, 64> buf{};
+		CHECK_FALSE(attr.read(buf));
+
+		fs::remove(file);
+		dir.write("numa_node", "1\n");
+		const auto value = attr.read(buf);
+		REQUIRE(value);
+		CHECK(*value == "1");
+	}
+}
+
+TEST_SUITE("SysfsAttributeCache")
+{
+	TEST_CASE("keeps readable attributes open")
+	{
+		TempDirectory dir;
+		const auto speed = dir.write("max_link_speed", "16.0 GT/s PCIe\n");
+		const auto label = dir.write("label", "SLOT 3\nignored\n");
+		SysfsAttributeCache cache;
+
+		CHECK(cache.readLine(speed) == "16.0 GT/s PCIe");
+		CHECK(cache.readLine(label) == "SLOT 3");
+		CHECK(cache.readLine((dir.path / "absent").string()).empty());
+		CHECK(cache.size() == 2);
+
+		rewrite(speed, "32.0 GT/s PCIe\n");
+		CHECK(cache.readLine(speed) == "32.0 GT/s PCIe");
+		CHECK(cache.size() == 2);
+	}
+
+	TEST_CASE("invalidate closes attributes under a prefix")
+	{
+		TempDirectory dir;
+		fs::create_directories(dir.path / "a");
+		fs::create_directories(dir.path / "b");
+		const auto a = dir.write("a/numa_node", "0\n");
+		const auto b = dir.write("b/numa_node", "-1\n");
+		SysfsAttributeCache cache;
+
+		CHECK(cache.readLine(a) == "0");
+		CHECK(cache.readLine(b) == "-1");
+		cache.invalidate((dir.path / "a").string() + "/");
+		CHECK(cache.size() == 1);
+		cache.invalidate();
+		CHECK(cache.size() == 0);
+	}
+
+	TEST_CASE("attributes that cannot be read are not cached")
+	{
+		TempDirectory dir;
+		fs::create_directory(dir.path / "power");
+		SysfsAttributeCache cache;
+		CHECK(cache.readLine((dir.path / "power").string()).empty());
+		CHECK(cache.size() == 0);
+	}
+
+	TEST_CASE("the descriptor limit is respected")
+	{
+		TempDirectory dir;
+		SysfsAttributeCache cache{2};
+		for (int i = 0; i < 5; ++i) {
+			CHECK(cache.readLine(dir.write("attr" + std::to_string(i), std::to_string(i))) == std::to_string(i));
+			CHECK(cache.size() <= 2);
+		}
+	}
+}
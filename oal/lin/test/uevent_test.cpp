@@ -0,0 +1,205 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ * Unit tests for uevent.cpp; kernel events are replayed over a socketpair
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include "uevent.h"
+#include <device_events.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <chrono>
+#include <string>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr auto GPU_BDF = "0000:4d:00.0";
+constexpr auto GPU_DEVPATH = "/devices/pci0000:00/0000:00:06.0/0000:4d:00.0";
+
+/// Builds a datagram the way the kernel does: header and KEY=VALUE fields separated by NUL.
+std::string datagram(const std::string &action, const std::string &devpath, const std::string &extra = {})
+{
+	std::string msg = action + "@" + devpath;
+	msg += '\0';
+	msg += "ACTION=" + action;
+	msg += '\0';
+	msg += "DEVPATH=" + devpath;
+	msg += '\0';
+	msg += extra;
+	return msg;
+}
+
+std::string pciFields(const std::string &driver = {})
+{
+	std::string fields = std::string("SUBSYSTEM=pci") + '\0' + "PCI_SLOT_NAME=" + GPU_BDF + '\0' + "SEQNUM=42" + '\0';
+	if (!driver.empty()) {
+		fields += "DRIVER=" + driver + '\0';
+	}
+	return fields;
+}
+
+UeventMessage message(const std::string &action, const std::string &driver = {})
+{
+	return *parseUevent(datagram(action, GPU_DEVPATH, pciFields(driver)));
+}
+
+/// Socket pair whose read end stands in for the netlink socket.
+struct EventPipe
+{
+	int writer{-1};
+	UeventSocket reader{-1};
+
+	EventPipe()
+	{
+		int fds[2];
+		REQUIRE(::socketpair(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0, fds) == 0);
+		reader = UeventSocket{fds[0]};
+		writer = fds[1];
+	}
+
+	~EventPipe() { ::close(writer); }
+
+	void send(const std::string &msg) const { REQUIRE(::send(writer, msg.data(), msg.size(), 0) > 0); }
+};
+
+} // namespace
+
+TEST_SUITE("parseUevent")
+{
+	TEST_CASE("parses kernel PCI events")
+	{
+		const auto msg = parseUevent(datagram("bind", GPU_DEVPATH, pciFields("xe")));
+		REQUIRE(msg);
+		CHECK(msg->action == "bind");
+		CHECK(msg->devpath == GPU_DEVPATH);
+		CHECK(msg->subsystem == "pci");
+		CHECK(msg->driver == "xe");
+		CHECK(msg->pciSlotName == GPU_BDF);
+		CHECK(msg->seqnum == 42);
+	}
+
+	TEST_CASE("rejects datagrams without an action header")
+	{
+		const std::string udev = std::string("libudev") + '\0' + "garbage";
+		CHECK_FALSE(parseUevent(udev));
+		CHECK_FALSE(parseUevent(std::string{}));
+	}
+}
+
+TEST_SUITE("PciResetTracker")
+{
+	TEST_CASE("follows remove, add and bind of its BDF only")
+	{
+		PciResetTracker tracker{GPU_BDF};
+		CHECK(tracker.observe(message("unbind")));
+		CHECK(tracker.observe(message("remove")));
+		CHECK(tracker.reached(PciResetStage::REMOVED));
+		CHECK_FALSE(tracker.reached(PciResetStage::ADDED));
+
+		CHECK_FALSE(tracker.observe(*parseUevent(
+			datagram("add", "/devices/pci0000:00/0000:00:07.0/0000:5e:00.0", "SUBSYSTEM=pci"))));
+		CHECK_FALSE(tracker.observe(*parseUevent(datagram("add", GPU_DEVPATH + std::string("/drm/card0"),
+														  std::string("SUBSYSTEM=drm") + '\0'))));
+		CHECK_FALSE(tracker.reached(PciResetStage::ADDED));
+
+		CHECK(tracker.observe(message("add")));
+		CHECK(tracker.reached(PciResetStage::ADDED));
+		CHECK(tracker.observe(message("bind", "xe")));
+		CHECK(tracker.reached(PciResetStage::BOUND));
+		CHECK(tracker.driver() == "xe");
+	}
+
+	TEST_CASE("a second remove discards earlier progress")
+	{
+		PciResetTracker tracker{GPU_BDF};
+		tracker.observe(message("add"));
+		tracker.observe(message("bind", "i915"));
+		tracker.observe(message("remove"));
+		CHECK_FALSE(tracker.reached(PciResetStage::ADDED));
+		CHECK_FALSE(tracker.reached(PciResetStage::BOUND));
+		CHECK(tracker.driver().empty());
+	}
+
+	TEST_CASE("waitFor completes on the event, well before the poll interval")
+	{
+		EventPipe events;
+		PciResetTracker tracker{GPU_BDF};
+		std::thread kernel([&] {
+			std::this_thread::sleep_for(20ms);
+			events.send(datagram("remove", GPU_DEVPATH, pciFields()));
+			events.send(datagram("add", GPU_DEVPATH, pciFields()));
+		});
+
+		const auto start = std::chrono::steady_clock::now();
+		const bool added = tracker.waitFor(events.reader, PciResetStage::ADDED, start + 5s, [] { return false; }, 10s);
+		kernel.join();
+		CHECK(added);
+		CHECK(tracker.reached(PciResetStage::REMOVED));
+		CHECK(std::chrono::steady_clock::now() - start < 2s);
+	}
+
+	TEST_CASE("waitFor falls back to the probe without a socket")
+	{
+		UeventSocket closed{-1};
+		PciResetTracker tracker{GPU_BDF};
+		int probes = 0;
+		const auto deadline = std::chrono::steady_clock::now() + 5s;
+		CHECK(tracker.waitFor(closed, PciResetStage::BOUND, deadline, [&] { return ++probes == 3; }, 5ms));
+		CHECK(probes == 3);
+		CHECK(tracker.reached(PciResetStage::BOUND));
+	}
+
+	TEST_CASE("waitFor gives up at the deadline")
+	{
+		EventPipe events;
+		PciResetTracker tracker{GPU_BDF};
+		events.send(datagram("remove", GPU_DEVPATH, pciFields()));
+		const auto deadline = std::chrono::steady_clock::now() + 50ms;
+		CHECK_FALSE(tracker.waitFor(events.reader, PciResetStage::ADDED, deadline, [] { return false; }, 10ms));
+		CHECK(tracker.reached(PciResetStage::REMOVED));
+	}
+}
+
+TEST_SUITE("toDeviceEvent")
+{
+	TEST_CASE("PCI bind, unbind and remove")
+	{
+		const auto bound = toDeviceEvent(message("bind", "xe"));
+		REQUIRE(bound);
+		CHECK(bound->kind == DeviceEvent::Kind::ADDED);
+		CHECK(bound->bdf == GPU_BDF);
+		CHECK(bound->driver == "xe");
+		CHECK(toDeviceEvent(message("unbind"))->kind == DeviceEvent::Kind::REMOVED);
+		CHECK(toDeviceEvent(message("remove"))->kind == DeviceEvent::Kind::REMOVED);
+		// The device is not usable before its driver binds
+		CHECK_FALSE(toDeviceEvent(message("add")));
+	}
+
+	TEST_CASE("DRM card resets and removal map to the parent function")
+	{
+		const auto cardPath = GPU_DEVPATH + std::string("/drm/card1");
+		const std::string drm = std::string("SUBSYSTEM=drm") + '\0';
+		const auto wedged = toDeviceEvent(*parseUevent(datagram("change", cardPath, drm + "WEDGED=rebind" + '\0')));
+		REQUIRE(wedged);
+		CHECK(wedged->kind == DeviceEvent::Kind::CHANGED);
+		CHECK(wedged->bdf == GPU_BDF);
+		CHECK(toDeviceEvent(*parseUevent(datagram("remove", cardPath, drm)))->kind == DeviceEvent::Kind::REMOVED);
+
+		// Display hotplug, connectors and render nodes do not affect the handles
+		CHECK_FALSE(toDeviceEvent(*parseUevent(datagram("change", cardPath, drm + "HOTPLUG=1" + '\0'))));
+		CHECK_FALSE(toDeviceEvent(*parseUevent(datagram("remove", cardPath + "-DP-1", drm))));
+		CHECK_FALSE(toDeviceEvent(*parseUevent(datagram("remove", GPU_DEVPATH + std::string("/drm/renderD128"), drm))));
+	}
+
+	TEST_CASE("other subsystems are ignored")
+	{
+		const auto usb = parseUevent(datagram("remove", "/devices/pci0000:00/0000:00:14.0/usb1", "SUBSYSTEM=usb"));
+		CHECK_FALSE(toDeviceEvent(*usb));
+	}
+}
@@ -7,12 +7,18 @@
 #include "topology.h"
 #include "bdf.h"
 #include <hwloc.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include <algorithm>
+#include <cstdint>
 #include <filesystem>
 #include <format>
 #include <fstream>
 #include <optional>
+#include <sstream>
 #include <string>
+#include <string_view>
 #include <system_error>
 #include <unordered_map>
 #include <vector>
@@ -236,6 +242,245 @@ std::optional<std::vector<NicInfo>> discoverNics(const SysfsPaths &paths)
 	return result;
 }
 
+namespace {
+
+/// First line of a persisted topology model; bump the version when the layout changes.
+constexpr std::string_view topologyCacheHeader = "xpum-topology-cache 1";
+
+/// Folds a string (plus a terminator) into a 64-bit FNV-1a hash.
+void hashString(uint64_t &hash, std::string_view value)
+{
+	constexpr uint64_t fnvPrime = 1099511628211ULL;
+	for (const unsigned char ch : value) {
+		hash ^= ch;
+		hash *= fnvPrime;
+	}
+	hash ^= 0xffU;
+	hash *= fnvPrime;
+}
+
+/// Hashes the sorted entries of a directory together with their symlink targets.
+void hashDirectory(uint64_t &hash, const std::filesystem::path &root, const std::filesystem::path &linkSuffix)
+{
+	namespace fs = std::filesystem;
+	std::vector<std::string> entries;
+	std::error_code ec;
+	for (fs::directory_iterator it(root, ec), end; !ec && it != end; it.increment(ec)) {
+		std::error_code linkErr;
+		const fs::path link = linkSuffix.empty() ? it->path() : it->path() / linkSuffix;
+		const auto target = fs::read_symlink(link, linkErr);
+		entries.push_back(std::format("{}={}", it->path().filename().string(), linkErr ? "" : target.string()));
+	}
+	std::ranges::sort(entries);
+
+	hashString(hash, root.string());
+	for (const auto &entry : entries) {
+		hashString(hash, entry);
+	}
+}
+
+/// Builds the model against an already computed fingerprint.
+TopologyModel buildTopologyModelWithFingerprint(const std::vector<std::string> &gpuBdfs, const SysfsPaths &paths,
+												std::string fingerprint)
+{
+	TopologyModel model;
+	model.fingerprint = std::move(fingerprint);
+	model.nics = discoverNics(paths);
+
+	model.bdfs = gpuBdfs;
+	if (model.nics) {
+		for (const auto &nic : *model.nics) {
+			model.bdfs.push_back(nic.bdfAddress);
+		}
+	}
+	std::ranges::sort(model.bdfs);
+	model.bdfs.erase(std::unique(model.bdfs.begin(), model.bdfs.end()), model.bdfs.end());
+
+	model.numaNodes = getNumaNodes(model.bdfs, paths);
+	model.pciePaths = getPciePaths(model.bdfs, paths);
+	return model;
+}
+
+} // namespace
+
+std::filesystem::path defaultTopologyCachePath()
+{
+	return std::format("/var/tmp/xpum-topology-{}.cache", geteuid());
+}
+
+/**
+ * @brief Computes a fingerprint of the PCI device tree and network interfaces
+ *
+ * See topology.h for what is covered.
+ */
+std::string computePciFingerprint(const SysfsPaths &paths)
+{
+	uint64_t hash = 14695981039346656037ULL;
+	hashDirectory(hash, paths.pciDevRoot, {});
+	hashDirectory(hash, paths.netRoot, "device");
+
+	std::string possible;
+	if (std::ifstream f{paths.nodeRoot / "possible"}; f) {
+		std::getline(f, possible);
+	}
+	hashString(hash, possible);
+
+	return std::format("{:016x}", hash);
+}
+
+TopologyModel buildTopologyModel(const std::vector<std::string> &gpuBdfs, const SysfsPaths &paths)
+{
+	return buildTopologyModelWithFingerprint(gpuBdfs, paths, computePciFingerprint(paths));
+}
+
+/**
+ * @brief Reads a persisted topology model
+ *
+ * Layout (one record per line):
+ *   xpum-topology-cache 1
+ *   fingerprint <hex>
+ *   bdf <bdf> <numa: index | none | absent> <path: seg/seg/... | ->
+ *   nics <count | none>
+ *   nic <name> <bdf> <cpu affinity>
+ */
+std::optional<TopologyModel> readTopologyModel(const std::filesystem::path &cacheFile)
+{
+	struct stat st{};
+	if (::lstat(cacheFile.c_str(), &st) != 0 || !S_ISREG(st.st_mode) || st.st_uid != geteuid()) {
+		return std::nullopt;
+	}
+
+	std::ifstream in{cacheFile};
+	std::string line;
+	if (!in || !std::getline(in, line) || line != topologyCacheHeader) {
+		return std::nullopt;
+	}
+
+	TopologyModel model;
+	bool sawNics = false;
+	while (std::getline(in, line)) {
+		std::istringstream fields{line};
+		std::string tag;
+		fields >> tag;
+		if (tag == "fingerprint") {
+			fields >> model.fingerprint;
+		} else if (tag == "bdf") {
+			std::string bdf, numa, path;
+			if (!(fields >> bdf >> numa >> path) || !isValidBdf(bdf)) {
+				return std::nullopt;
+			}
+			model.bdfs.push_back(bdf);
+			if (numa == "none") {
+				model.numaNodes[bdf] = std::nullopt;
+			} else if (numa != "absent") {
+				try {
+					model.numaNodes[bdf] = std::stoi(numa);
+				} catch (const std::exception &) {
+					return std::nullopt;
+				}
+			}
+			if (path != "-") {
+				PciePath hops;
+				std::istringstream segs{path};
+				for (std::string seg; std::getline(segs, seg, '/');) {
+					hops.push_back(PcieBridgeLink{.bdf = seg, .isHostBridge = hops.empty()});
+				}
+				model.pciePaths[bdf] = std::move(hops);
+			}
+		} else if (tag == "nics") {
+			std::string count;
+			fields >> count;
+			sawNics = true;
+			if (count != "none") {
+				model.nics.emplace();
+			}
+		} else if (tag == "nic") {
+			NicInfo nic;
+			if (!model.nics || !(fields >> nic.name >> nic.bdfAddress)) {
+				return std::nullopt;
+			}
+			std::getline(fields >> std::ws, nic.cpuAffinity);
+			model.nics->push_back(std::move(nic));
+		} else {
+			return std::nullopt;
+		}
+	}
+
+	if (model.fingerprint.empty() || !sawNics) {
+		return std::nullopt;
+	}
+	std::ranges::sort(model.bdfs);
+	return model;
+}
+
+bool saveTopologyModel(const TopologyModel &model, const std::filesystem::path &cacheFile)
+{
+	std::string out = std::format("{}\nfingerprint {}\n", topologyCacheHeader, model.fingerprint);
+	for (const auto &bdf : model.bdfs) {
+		std::string numa = "absent";
+		if (const auto it = model.numaNodes.find(bdf); it != model.numaNodes.end()) {
+			numa = it->second ? std::to_string(*it->second) : "none";
+		}
+		std::string path = "-";
+		if (const auto it = model.pciePaths.find(bdf); it != model.pciePaths.end() && !it->second.empty()) {
+			path.clear();
+			for (const auto &hop : it->second) {
+				path += path.empty() ? hop.bdf : "/" + hop.bdf;
+			}
+		}
+		out += std::format("bdf {} {} {}\n", bdf, numa, path);
+	}
+	out += model.nics ? std::format("nics {}\n", model.nics->size()) : std::string{"nics none\n"};
+	if (model.nics) {
+		for (const auto &nic : *model.nics) {
+			out += std::format("nic {} {} {}\n", nic.name, nic.bdfAddress, nic.cpuAffinity);
+		}
+	}
+
+	// Write to a private temporary file and rename so readers never see a partial model
+	const std::string tmpPath = std::format("{}.{}.tmp", cacheFile.string(), getpid());
+	const int fd = ::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_NOFOLLOW | O_CLOEXEC, 0600);
+	if (fd < 0) {
+		return false;
+	}
+	size_t written = 0;
+	while (written < out.size()) {
+		const ssize_t n = ::write(fd, out.data() + written, out.size() - written);
+		if (n <= 0) {
+			break;
+		}
+		written += static_cast<size_t>(n);
+	}
+	const bool closed = ::close(fd) == 0;
+	if (written != out.size() || !closed || ::rename(tmpPath.c_str(), cacheFile.c_str()) != 0) {
+		::unlink(tmpPath.c_str());
+		return false;
+	}
+	return true;
+}
+
+TopologyModel loadTopologyModel(const std::vector<std::string> &gpuBdfs, const SysfsPaths &paths,
+								const std::filesystem::path &cacheFile)
+{
+	auto fingerprint = computePciFingerprint(paths);
+
+	if (!cacheFile.empty()) {
+		if (auto cached = readTopologyModel(cacheFile); cached && cached->fingerprint == fingerprint) {
+			const bool coversAll = std::ranges::all_of(
+				gpuBdfs, [&](const std::string &bdf) { return std::ranges::binary_search(cached->bdfs, bdf); });
+			if (coversAll) {
+				return std::move(*cached);
+			}
+		}
+	}
+
+	auto model = buildTopologyModelWithFingerprint(gpuBdfs, paths, std::move(fingerprint));
+	if (!cacheFile.empty()) {
+		saveTopologyModel(model, cacheFile);
+	}
+	return model;
+}
+
 /**
  * @brief Exports system topology to XML file using hwloc
  *
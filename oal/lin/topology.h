@@ -107,6 +107,79 @@ std::unordered_map<std::string, PciePath> getPciePaths(const std::vector<std::st
  */
 std::optional<std::vector<NicInfo>> discoverNics(const SysfsPaths &paths = {});
 
+/**
+ * @brief Topology facts resolved for one matrix invocation
+ *
+ * Holds everything the topology matrix needs from sysfs so it is gathered once
+ * and can be persisted. Maps follow the same key conventions as getNumaNodes()
+ * and getPciePaths().
+ */
+struct TopologyModel
+{
+	std::string fingerprint;										 ///< computePciFingerprint() at build time
+	std::vector<std::string> bdfs;									 ///< Sorted BDFs (GPUs and NICs) covered by the model
+	std::unordered_map<std::string, std::optional<int>> numaNodes; ///< See getNumaNodes()
+	std::unordered_map<std::string, PciePath> pciePaths;			 ///< See getPciePaths()
+	std::optional<std::vector<NicInfo>> nics;						 ///< See discoverNics()
+};
+
+/// Default location of the persisted topology model; per-user to avoid sharing a writable file.
+std::filesystem::path defaultTopologyCachePath();
+
+/**
+ * @brief Computes a fingerprint of the PCI device tree and network interfaces
+ *
+ * Hashes the entry names and symlink targets under pciDevRoot and netRoot plus
+ * the NUMA "possible" list. Only directory listings and readlink() are used, so
+ * the fingerprint is much cheaper than resolving the model itself. Any hotplug,
+ * rebind or renamed interface changes the result.
+ *
+ * @param paths Sysfs roots (defaults to live sysfs; override in tests)
+ * @return 16-digit lowercase hex string
+ */
+std::string computePciFingerprint(const SysfsPaths &paths = {});
+
+/**
+ * @brief Resolves NICs, NUMA nodes and PCIe paths for the given GPU BDFs in one pass
+ *
+ * @param gpuBdfs GPU BDF strings; discovered NIC BDFs are added automatically
+ * @param paths   Sysfs roots (defaults to live sysfs; override in tests)
+ * @return Freshly built model stamped with the current fingerprint
+ */
+TopologyModel buildTopologyModel(const std::vector<std::string> &gpuBdfs, const SysfsPaths &paths = {});
+
+/**
+ * @brief Reads a persisted topology model
+ *
+ * @param cacheFile Path written by saveTopologyModel()
+ * @return The model, or std::nullopt if the file is absent, not owned by the
+ *         current user, or malformed
+ */
+std::optional<TopologyModel> readTopologyModel(const std::filesystem::path &cacheFile);
+
+/**
+ * @brief Persists a topology model atomically (temporary file + rename)
+ *
+ * @param model     Model to write
+ * @param cacheFile Destination path
+ * @return true on success; failures are not fatal for callers
+ */
+bool saveTopologyModel(const TopologyModel &model, const std::filesystem::path &cacheFile);
+
+/**
+ * @brief Returns the topology model, reusing the persisted copy when still valid
+ *
+ * The cached model is used when its fingerprint matches the live PCI tree and it
+ * covers every requested GPU BDF. Otherwise the model is rebuilt and saved.
+ *
+ * @param gpuBdfs   GPU BDF strings to resolve
+ * @param paths     Sysfs roots (defaults to live sysfs; override in tests)
+ * @param cacheFile Persisted model location; empty disables persistence
+ * @return Model covering gpuBdfs and all discovered NICs
+ */
+TopologyModel loadTopologyModel(const std::vector<std::string> &gpuBdfs, const SysfsPaths &paths = {},
+								const std::filesystem::path &cacheFile = defaultTopologyCachePath());
+
 /**
  * @brief Exports system topology to XML file using hwloc (Linux only)
  *
@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "uevent.h"
+#include <linux/netlink.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <charconv>
+
+namespace {
+
+// Kernel uevents are multicast to group 1; udev rebroadcasts processed events on group 2.
+constexpr uint32_t UEVENT_KERNEL_GROUP = 1;
+
+// Large enough for any uevent; the kernel caps the environment at UEVENT_BUFFER_SIZE (2 KiB).
+constexpr size_t UEVENT_DATAGRAM_SIZE = 8192;
+
+} // namespace
+
+std::optional<UeventMessage> parseUevent(std::span<const char> datagram)
+{
+	std::string_view rest{datagram.data(), datagram.size()};
+	const auto headerEnd = rest.find('\0');
+	const auto header = rest.substr(0, headerEnd);
+	const auto at = header.find('@');
+	if (at == std::string_view::npos || at == 0) {
+		return std::nullopt;
+	}
+
+	UeventMessage msg;
+	msg.action = header.substr(0, at);
+	msg.devpath = header.substr(at + 1);
+	rest.remove_prefix(headerEnd == std::string_view::npos ? rest.size() : headerEnd + 1);
+
+	while (!rest.empty()) {
+		const auto end = rest.find('\0');
+		const auto field = rest.substr(0, end);
+		rest.remove_prefix(end == std::string_view::npos ? rest.size() : end + 1);
+
+		const auto eq = field.find('=');
+		if (eq == std::string_view::npos) {
+			continue;
+		}
+		const auto key = field.substr(0, eq);
+		const auto value = field.substr(eq + 1);
+		if (key == "SUBSYSTEM") {
+			msg.subsystem = value;
+		} else if (key == "DRIVER") {
+			msg.driver = value;
+		} else if (key == "PCI_SLOT_NAME") {
+			msg.pciSlotName = value;
+		} else if (key == "SEQNUM") {
+			std::from_chars(value.data(), value.data() + value.size(), msg.seqnum);
+		} else if (key == "RESET" || key == "WEDGED" || key == "ERROR_EVENT") {
+			msg.resetEvent = true;
+		}
+	}
+	return msg;
+}
+
+UeventSocket::UeventSocket()
+{
+	sock = ::socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, NETLINK_KOBJECT_UEVENT);
+	if (sock < 0) {
+		return;
+	}
+	sockaddr_nl addr{};
+	addr.nl_family = AF_NETLINK;
+	addr.nl_groups = UEVENT_KERNEL_GROUP;
+	if (::bind(sock, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr)) != 0) {
+		::close(sock);
+		sock = -1;
+	}
+}
+
+UeventSocket::~UeventSocket()
+{
+	if (sock >= 0) {
+		::close(sock);
+	}
+}
+
+UeventSocket::UeventSocket(UeventSocket &&other) noexcept : sock(std::exchange(other.sock, -1)) {}
+
+UeventSocket &UeventSocket::operator=(UeventSocket &&other) noexcept
+{
+	if (this != &other) {
+		if (sock >= 0) {
+			::close(sock);
+		}
+		sock = std::exchange(other.sock, -1);
+	}
+	return *this;
+}
+
+std::optional<UeventMessage> UeventSocket::receive(std::chrono::milliseconds timeout)
+{
+	if (sock < 0) {
+		return std::nullopt;
+	}
+	const auto deadline = std::chrono::steady_clock::now() + timeout;
+	std::array<char, UEVENT_DATAGRAM_SIZE> buf;
+	for (;;) {
+		const auto remaining =
+			std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+		pollfd pfd{.fd = sock, .events = POLLIN, .revents = 0};
+		const int ready = ::poll(&pfd, 1, static_cast<int>(std::max<int64_t>(remaining.count(), 0)));
+		if (ready < 0 && errno == EINTR) {
+			continue;
+		}
+		if (ready <= 0) {
+			return std::nullopt;
+		}
+
+		sockaddr_nl sender{};
+		iovec iov{.iov_base = buf.data(), .iov_len = buf.size()};
+		msghdr hdr{};
+		hdr.msg_name = &sender;
+		hdr.msg_namelen = sizeof(sender);
+		hdr.msg_iov = &iov;
+		hdr.msg_iovlen = 1;
+		const ssize_t n = ::recvmsg(sock, &hdr, 0);
+		if (n < 0) {
+			if (errno == EINTR || errno == EAGAIN || errno == ENOBUFS) {
+				// ENOBUFS: the receive queue overflowed and events were lost; callers' probes catch up
+				continue;
+			}
+			return std::nullopt;
+		}
+		// Only the kernel (port id 0) may speak for devices; ignore user-space senders
+		if (sender.nl_family == AF_NETLINK && sender.nl_pid != 0) {
+			continue;
+		}
+		if (auto msg = parseUevent(std::span<const char>{buf.data(), static_cast<size_t>(n)})) {
+			return msg;
+		}
+	}
+}
+
+bool PciResetTracker::observe(const UeventMessage &msg)
+{
+	if (msg.subsystem != "pci") {
+		return false;
+	}
+	const std::string_view devpath{msg.devpath};
+	const auto name = devpath.substr(devpath.find_last_of('/') + 1);
+	if (msg.pciSlotName != trackedBdf && name != trackedBdf) {
+		return false;
+	}
+
+	if (msg.action == "remove") {
+		stages = static_cast<uint8_t>(PciResetStage::REMOVED);
+		boundDriver.clear();
+	} else if (msg.action == "add") {
+		mark(PciResetStage::ADDED);
+	} else if (msg.action == "bind") {
+		mark(PciResetStage::ADDED);
+		mark(PciResetStage::BOUND);
+		boundDriver = msg.driver;
+	} else if (msg.action == "unbind") {
+		stages = static_cast<uint8_t>(stages & ~static_cast<uint8_t>(PciResetStage::BOUND));
+		boundDriver.clear();
+	}
+	return true;
+}
+
+bool PciResetTracker::waitFor(UeventSocket &socket, PciResetStage stage, std::chrono::steady_clock::time_point deadline,
+							  const std::function<bool()> &probe, std::chrono::milliseconds pollInterval)
+{
+	auto nextProbe = std::chrono::steady_clock::now();
+	while (!reached(stage)) {
+		const auto now = std::chrono::steady_clock::now();
+		if (now >= nextProbe) {
+			if (probe && probe()) {
+				mark(stage);
+				break;
+			}
+			nextProbe = now + pollInterval;
+		}
+		if (now >= deadline) {
+			return false;
+		}
+
+		const auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(std::min(nextProbe, deadline) - now);
+		if (socket.isOpen()) {
+			if (const auto msg = socket.receive(wait)) {
+				observe(*msg);
+			}
+		} else {
+			::usleep(static_cast<useconds_t>(std::chrono::duration_cast<std::chrono::microseconds>(wait).count()));
+		}
+	}
+	return true;
+}
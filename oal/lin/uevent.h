@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef UEVENT_H
+#define UEVENT_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+
+/**
+ * @brief One kernel uevent as broadcast on NETLINK_KOBJECT_UEVENT
+ *
+ * The datagram is "<action>@<devpath>" followed by NUL-separated KEY=VALUE pairs.
+ */
+struct UeventMessage
+{
+	std::string action;		 ///< "add", "remove", "bind", "unbind", "change", ...
+	std::string devpath;	 ///< Path below /sys, e.g. /devices/pci0000:00/0000:00:06.0/0000:4d:00.0
+	std::string subsystem;	 ///< SUBSYSTEM=, e.g. "pci" or "drm"
+	std::string driver;		 ///< DRIVER=, set on bind and on events of bound devices
+	std::string pciSlotName; ///< PCI_SLOT_NAME=, the BDF of PCI devices
+	uint64_t seqnum{0};		 ///< SEQNUM=
+	bool resetEvent{false};	 ///< RESET=, WEDGED= or ERROR_EVENT= present: a reset, wedge or AER recovery
+};
+
+/**
+ * @brief Parses one kernel uevent datagram
+ *
+ * @return std::nullopt for datagrams that are not kernel uevents (e.g. udev's "libudev" messages)
+ */
+std::optional<UeventMessage> parseUevent(std::span<const char> datagram);
+
+/**
+ * @brief Socket subscribed to kernel uevents
+ *
+ * Every socket receives every event, so independent waiters (one per device being
+ * reset) can each own one. Messages not sent by the kernel are dropped.
+ */
+class UeventSocket
+{
+public:
+	/** @brief Opens and binds a NETLINK_KOBJECT_UEVENT socket; check isOpen() */
+	UeventSocket();
+
+	/** @brief Adopts an already connected datagram socket — for tests */
+	explicit UeventSocket(int fd) : sock(fd) {}
+
+	~UeventSocket();
+
+	UeventSocket(const UeventSocket &) = delete;
+	UeventSocket &operator=(const UeventSocket &) = delete;
+	UeventSocket(UeventSocket &&other) noexcept;
+	UeventSocket &operator=(UeventSocket &&other) noexcept;
+
+	/** @brief False when the socket could not be created (e.g. restricted container) */
+	[[nodiscard]] bool isOpen() const { return sock >= 0; }
+
+	/** @brief Descriptor to poll() for readability alongside other sources */
+	[[nodiscard]] int fd() const { return sock; }
+
+	/**
+	 * @brief Waits up to @p timeout for the next uevent
+	 *
+	 * @return The event, or std::nullopt on timeout, error or a closed socket
+	 */
+	std::optional<UeventMessage> receive(std::chrono::milliseconds timeout);
+
+private:
+	int sock{-1};
+};
+
+/**
+ * @brief Progress of one PCI function through remove, re-enumeration and driver bind
+ */
+enum class PciResetStage : uint8_t
+{
+	REMOVED = 1U << 0, ///< The function left the bus
+	ADDED = 1U << 1,   ///< The function was enumerated again
+	BOUND = 1U << 2,   ///< A driver bound to the function
+};
+
+/**
+ * @brief Tracks the uevents of one BDF during a reset
+ *
+ * Each reset owns its tracker and socket, so resets of several devices can be
+ * awaited concurrently. A remove clears earlier add/bind progress, so a device
+ * that drops off the bus again is not reported as back.
+ */
+class PciResetTracker
+{
+public:
+	explicit PciResetTracker(std::string bdf) : trackedBdf(std::move(bdf)) {}
+
+	/**
+	 * @brief Applies one event
+	 *
+	 * @return true if the event concerned this BDF
+	 */
+	bool observe(const UeventMessage &msg);
+
+	/** @brief Records a stage detected by other means (e.g. the polling fallback) */
+	void mark(PciResetStage stage) { stages |= static_cast<uint8_t>(stage); }
+
+	[[nodiscard]] bool reached(PciResetStage stage) const { return (stages & static_cast<uint8_t>(stage)) != 0; }
+
+	/** @brief Driver named by the last bind event */
+	[[nodiscard]] const std::string &driver() const { return boundDriver; }
+
+	/**
+	 * @brief Waits until @p stage is reached or @p deadline passes
+	 *
+	 * Events from @p socket advance the tracker as soon as they arrive. Every
+	 * @p pollInterval without an event, and on every iteration when the socket is
+	 * closed, @p probe is consulted; returning true marks the stage. The probe
+	 * covers missed events and systems where the socket cannot be opened.
+	 *
+	 * @return true if the stage was reached
+	 */
+	bool waitFor(UeventSocket &socket, PciResetStage stage, std::chrono::steady_clock::time_point deadline,
+				 const std::function<bool()> &probe, std::chrono::milliseconds pollInterval);
+
+private:
+	std::string trackedBdf;
+	std::string boundDriver;
+	uint8_t stages{0};
+};
+
+#endif // UEVENT_H
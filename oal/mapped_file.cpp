@@ -0,0 +1,29 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "mapped_file.h"
+#include <utility>
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+	: mData(std::exchange(other.mData, nullptr)), mSize(std::exchange(other.mSize, 0)),
+	  mHandle(std::exchange(other.mHandle, 0)), mMapping(std::exchange(other.mMapping, 0)), mMode(other.mMode),
+	  mCreated(other.mCreated)
+{
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+{
+	if (this != &other) {
+		close();
+		mData = std::exchange(other.mData, nullptr);
+		mSize = std::exchange(other.mSize, 0);
+		mHandle = std::exchange(other.mHandle, 0);
+		mMapping = std::exchange(other.mMapping, 0);
+		mMode = other.mMode;
+		mCreated = other.mCreated;
+	}
+	return *this;
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef _MAPPED_FILE_H
+#define _MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+enum class MappedFileMode : uint8_t
+{
+	READ_ONLY,	///< Map an existing file for reading; any number of readers
+	READ_WRITE, ///< Map the file for writing, creating it when missing; a single writer
+};
+
+/**
+ * @brief A whole file mapped into memory
+ *
+ * A writer creates a missing file with the size it asks for, zero filled and sparse
+ * where the file system supports it, so pages that are never written take no space on
+ * disk. An existing file is mapped with the size it has. Only one writer may map a file
+ * at a time, across processes; readers may map it while it is written and see the
+ * writer's stores without a flush.
+ */
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	~MappedFile() { close(); }
+
+	MappedFile(MappedFile &&other) noexcept;
+	MappedFile &operator=(MappedFile &&other) noexcept;
+	MappedFile(const MappedFile &) = delete;
+	MappedFile &operator=(const MappedFile &) = delete;
+
+	/**
+	 * @brief Maps @p path, replacing any mapping held
+	 *
+	 * @param[in]  path        File to map.
+	 * @param[in]  mode        Access; READ_WRITE fails while another writer has the file mapped.
+	 * @param[in]  createSize  Size of the file a writer creates when it is missing; 0 to not create it.
+	 * @param[out] error       Why the file could not be mapped.
+	 * @return true when the file is mapped.
+	 */
+	bool open(const std::filesystem::path &path, MappedFileMode mode, std::size_t createSize, std::string &error);
+
+	/** @brief Unmaps the file without flushing it */
+	void close();
+
+	/**
+	 * @brief Writes the pages of [@p offset, @p offset + @p length) back to the file and waits
+	 *        until they are on disk
+	 */
+	bool flush(std::size_t offset, std::size_t length) const;
+
+	[[nodiscard]] bool isOpen() const { return mData != nullptr; }
+	[[nodiscard]] bool writable() const { return mMode == MappedFileMode::READ_WRITE; }
+	[[nodiscard]] std::byte *data() const { return mData; }
+	[[nodiscard]] std::size_t size() const { return mSize; }
+
+	/** @brief True when the file was created by the last open() */
+	[[nodiscard]] bool created() const { return mCreated; }
+
+	/**
+	 * @brief Directory of the node for data xpu-smi keeps across runs; $XPUM_DATA_DIR when set
+	 *
+	 * On Linux /var/lib/xpum when it can be written to, else ~/.local/state/xpum.
+	 */
+	static std::filesystem::path dataDirectory();
+
+private:
+	std::byte *mData = nullptr;
+	std::size_t mSize = 0;
+	uintptr_t mHandle = 0; // Cast HANDLE/fd to uintptr_t; the mapping holds the writer's lock
+	uintptr_t mMapping = 0;
+	MappedFileMode mMode = MappedFileMode::READ_ONLY;
+	bool mCreated = false;
+};
+
+#endif // _MAPPED_FILE_H
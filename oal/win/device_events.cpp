@@ -0,0 +1,28 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include <device_events.h>
+#include <os.h>
+#include <thread>
+
+/*
+ * @brief 	PnP notifications are not wired up on Windows; the source never opens and
+ * next() only waits out its timeout, so callers fall back to periodic rescans.
+ */
+struct DeviceEventSource::Impl
+{};
+
+DeviceEventSource::DeviceEventSource() : impl(std::make_unique<Impl>()) {}
+
+DeviceEventSource::~DeviceEventSource() = default;
+
+bool DeviceEventSource::isOpen() const { return false; }
+
+std::optional<DeviceEvent> DeviceEventSource::next(std::chrono::milliseconds timeout)
+{
+	std::this_thread::sleep_for(timeout);
+	return std::nullopt;
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include <device_lock.h>
+#include <cstdlib>
+#include <windows.h>
+
+std::filesystem::path DeviceLockManager::defaultDirectory()
+{
+	char dir[MAX_PATH];
+	size_t length = 0;
+	if (getenv_s(&length, dir, sizeof(dir), "XPUM_LOCK_DIR") == 0 && length > 1) {
+		return dir;
+	}
+	return "C:/ProgramData/xpum/locks";
+}
+
+void DeviceLocks::closeHandle(uintptr_t handle)
+{
+	// Closing the handle unlocks the file
+	CloseHandle(reinterpret_cast<HANDLE>(handle));
+}
+
+/**
+ * @brief LockFileEx()s the first byte of the lock file of the resource without blocking
+ *
+ * As on Linux, only exclusive requests create the lock file.
+ */
+DeviceLockManager::TryResult DeviceLockManager::tryLock(const DeviceLockRequest &request, uintptr_t &handle) const
+{
+	const std::filesystem::path path = lockFile(request.resource);
+	const bool exclusive = request.mode == DeviceLockMode::EXCLUSIVE;
+	HANDLE hFile = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+							   NULL, exclusive ? OPEN_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (hFile == INVALID_HANDLE_VALUE) {
+		return !exclusive && GetLastError() == ERROR_FILE_NOT_FOUND ? TryResult::ABSENT : TryResult::UNAVAILABLE;
+	}
+
+	DWORD flags = LOCKFILE_FAIL_IMMEDIATELY;
+	if (exclusive) {
+		flags |= LOCKFILE_EXCLUSIVE_LOCK;
+	}
+	OVERLAPPED overlapped = {};
+	if (!LockFileEx(hFile, flags, 0, 1, 0, &overlapped)) {
+		const bool busy = GetLastError() == ERROR_LOCK_VIOLATION;
+		CloseHandle(hFile);
+		return busy ? TryResult::BUSY : TryResult::UNAVAILABLE;
+	}
+	handle = reinterpret_cast<uintptr_t>(hFile);
+	return TryResult::LOCKED;
+}
+
+/**
+ * @brief Windows does not tell who holds a byte-range lock
+ */
+std::vector<int> DeviceLockManager::holdersOf(const std::string &resource) const
+{
+	(void)resource;
+	return {};
+}
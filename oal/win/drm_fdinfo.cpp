@@ -0,0 +1,36 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include <drm_fdinfo.h>
+#include <os.h>
+
+/*
+ * @brief 	DRM client fdinfo is a Linux procfs interface; Windows reports no per-process
+ * engine utilization, so every device gets an empty snapshot.
+ */
+std::optional<double> ProcessEngineUtilization::groupPercent(
+	UNUSED std::initializer_list<std::string_view> classes) const
+{
+	return std::nullopt;
+}
+
+std::optional<double> ProcessEngineUtilization::maxPercent() const { return std::nullopt; }
+
+bool parseDrmFdinfo(UNUSED std::string_view text, UNUSED std::string_view bdf, UNUSED DrmClientCounters &out)
+{
+	return false;
+}
+
+std::vector<DrmClientSnapshot> snapshotDrmClients(std::span<const std::string> bdfs, UNUSED const ProcfsPaths &paths)
+{
+	return std::vector<DrmClientSnapshot>(bdfs.size());
+}
+
+std::vector<ProcessEngineUtilization> computeProcessUtilization(UNUSED const DrmClientSnapshot &before,
+																UNUSED const DrmClientSnapshot &after)
+{
+	return {};
+}
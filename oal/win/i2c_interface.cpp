@@ -73,6 +73,13 @@ I2CInterface::I2CInterface(const std::string &devpath)
 	}
 }
 
+/**
+ * @brief Constructor for fakes of the AMC device
+ *
+ * Opens no device; the derived class implements writeAmc() and readAmc().
+ */
+I2CInterface::I2CInterface() : amchandle(NULL), init(true) {}
+
 /**
  * @brief Destructor for I2CInterface class
  *
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include <mapped_file.h>
+#include <cstdlib>
+#include <windows.h>
+
+std::filesystem::path MappedFile::dataDirectory()
+{
+	char dir[MAX_PATH];
+	size_t length = 0;
+	if (getenv_s(&length, dir, sizeof(dir), "XPUM_DATA_DIR") == 0 && length > 1) {
+		return dir;
+	}
+	return "C:/ProgramData/xpum";
+}
+
+/**
+ * @brief Maps the file with MapViewOfFile(); a writer opens it without FILE_SHARE_WRITE,
+ *        which keeps a second writer out
+ */
+bool MappedFile::open(const std::filesystem::path &path, MappedFileMode mode, std::size_t createSize,
+					  std::string &error)
+{
+	close();
+	const bool write = mode == MappedFileMode::READ_WRITE;
+	HANDLE hFile = CreateFileW(path.c_str(), write ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ,
+							   write ? FILE_SHARE_READ : (FILE_SHARE_READ | FILE_SHARE_WRITE), NULL,
+							   write && createSize > 0 ? OPEN_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (hFile == INVALID_HANDLE_VALUE) {
+		error = GetLastError() == ERROR_SHARING_VIOLATION ? "in use by another process" : "cannot open file";
+		return false;
+	}
+	const auto fail = [&](const char *reason) {
+		CloseHandle(hFile);
+		error = reason;
+		return false;
+	};
+
+	LARGE_INTEGER fileSize = {};
+	if (!GetFileSizeEx(hFile, &fileSize)) {
+		return fail("cannot read the file size");
+	}
+	auto size = static_cast<std::size_t>(fileSize.QuadPart);
+	bool created = false;
+	if (size == 0 && write && createSize > 0) {
+		// Mark the file sparse so that pages never written take no space on disk
+		DWORD returned = 0;
+		DeviceIoControl(hFile, FSCTL_SET_SPARSE, NULL, 0, NULL, 0, &returned, NULL);
+		size = createSize;
+		created = true;
+	}
+	if (size == 0) {
+		return fail("empty file");
+	}
+
+	// Mapping a larger size than the file has extends the file
+	const auto sizeHigh = static_cast<DWORD>(static_cast<uint64_t>(size) >> 32);
+	const auto sizeLow = static_cast<DWORD>(size & 0xFFFFFFFFu);
+	HANDLE hMapping = CreateFileMappingW(hFile, NULL, write ? PAGE_READWRITE : PAGE_READONLY, sizeHigh, sizeLow, NULL);
+	if (hMapping == NULL) {
+		return fail("cannot map the file");
+	}
+	void *data = MapViewOfFile(hMapping, write ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, size);
+	if (data == NULL) {
+		CloseHandle(hMapping);
+		return fail("cannot map the file");
+	}
+
+	mData = static_cast<std::byte *>(data);
+	mSize = size;
+	mHandle = reinterpret_cast<uintptr_t>(hFile);
+	mMapping = reinterpret_cast<uintptr_t>(hMapping);
+	mMode = mode;
+	mCreated = created;
+	return true;
+}
+
+void MappedFile::close()
+{
+	if (mData == nullptr) {
+		return;
+	}
+	UnmapViewOfFile(mData);
+	CloseHandle(reinterpret_cast<HANDLE>(mMapping));
+	CloseHandle(reinterpret_cast<HANDLE>(mHandle));
+	mData = nullptr;
+	mSize = 0;
+	mHandle = 0;
+	mMapping = 0;
+}
+
+bool MappedFile::flush(std::size_t offset, std::size_t length) const
+{
+	if (mData == nullptr || offset >= mSize) {
+		return false;
+	}
+	const std::size_t end = offset + length < mSize ? offset + length : mSize;
+	// FlushViewOfFile() only starts the write-back; FlushFileBuffers() waits for it
+	return FlushViewOfFile(mData + offset, end - offset) != 0 &&
+		   FlushFileBuffers(reinterpret_cast<HANDLE>(mHandle)) != 0;
+}
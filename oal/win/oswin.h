@@ -8,7 +8,10 @@
 #define _OSWIN_H
 
 #define NOMINMAX
+#include <chrono>
+#include <cstdio>
 #include <string>
+#include <string_view>
 #include <windows.h>
 #include <process.h>
 #include <conio.h>
@@ -23,17 +26,6 @@
 #define LIBXPUM_API __declspec(dllimport)
 #endif
 
-class thread_id
-{
-
-protected:
-	HANDLE thread_hdl;
-
-public:
-	thread_id(HANDLE hdl) { thread_hdl = hdl; }
-	HANDLE ret_thread_uid() { return thread_hdl; }
-};
-
 struct option
 {
 	const char *name;
@@ -95,7 +87,6 @@ struct option
 }
 #define STRNCPY_S(dest, src, sz) strncpy_s(dest, sz, src, _TRUNCATE)
 #define STRCASECMP _stricmp
-#define THREAD_RET DWORD WINAPI
 #define GETOPT_LONG getopt_long
 #define no_argument 0
 #define required_argument 1
@@ -121,12 +112,24 @@ struct option
 #define SRIOVSUPPORT(deviceInfoPtr) (UNUSED_VAR(deviceInfoPtr), 0)
 #define GETKERNELVERSION() std::string("")
 #define GETPCISLOTLABEL(bdf) (UNUSED_VAR(bdf), std::string(""))
+#define INVALIDATE_PCI_CACHES(bdf) UNUSED_VAR(bdf)
+#define INVALIDATE_TOPOLOGY_CACHES()
 static constexpr std::string FINDRESOURCEFILE(UNUSED const std::string &relativePath) { return std::string{}; }
 static inline int coldResetViaSysfs(UNUSED const std::string &gpuBdf) { return -1; }
 static inline std::vector<uint32_t> getGpuProcessesByBdf(UNUSED const std::string &gpuBdf) { return {}; }
 static inline std::vector<std::string> getDevicesSharingSlotWith(UNUSED const std::string &gpuBdf) { return {}; }
+/** Nanoseconds of the performance counter, the Windows counterpart of CLOCK_MONOTONIC_RAW */
+inline uint64_t MONOTONIC_RAW_NS()
+{
+	LARGE_INTEGER counter{};
+	LARGE_INTEGER frequency{};
+	QueryPerformanceCounter(&counter);
+	QueryPerformanceFrequency(&frequency);
+	const auto ticks = static_cast<uint64_t>(counter.QuadPart);
+	const auto perSecond = static_cast<uint64_t>(frequency.QuadPart);
+	return ticks / perSecond * 1000000000ULL + ticks % perSecond * 1000000000ULL / perSecond;
+} // NOLINT(readability-identifier-naming) // Match MACRO style while providing a better interface for navigation
 
-typedef DWORD(WINAPI *funcptr)(void *input_params);
 extern char *optarg;
 extern int optind;
 
@@ -161,12 +164,47 @@ inline std::unordered_map<std::string, PciePath> GET_PCIE_PATHS(const std::vecto
 {
 	return {};
 } // NOLINT(readability-identifier-naming) // Match MACRO style while providing a better interface for navigation
+struct TopologyModel
+{
+	std::string fingerprint{};
+	std::vector<std::string> bdfs{};
+	std::unordered_map<std::string, std::optional<int>> numaNodes{};
+	std::unordered_map<std::string, PciePath> pciePaths{};
+	std::optional<std::vector<NicInfo>> nics{};
+};
+inline TopologyModel GET_TOPOLOGY_MODEL(const std::vector<std::string> &gpuBdfs)
+{
+	return TopologyModel{.bdfs = gpuBdfs};
+} // NOLINT(readability-identifier-naming) // Match MACRO style while providing a better interface for navigation
+// Thread placement is left to the Windows scheduler
+inline bool PIN_THREAD_TO_DEVICES(const std::vector<std::string> &)
+{
+	return false;
+} // NOLINT(readability-identifier-naming) // Match MACRO style while providing a better interface for navigation
+struct ThreadPinGuard
+{
+};
+inline bool RESTRICT_PROCESS_CPUS(std::string_view)
+{
+	return false;
+} // NOLINT(readability-identifier-naming) // Match MACRO style while providing a better interface for navigation
+/**
+ * Runs @p command through the shell with @p input on its standard input; -1 when it could not be run.
+ * @p timeout is not enforced here: _pclose() waits for the command to exit.
+ */
+inline int RUN_HOOK(const std::string &command, const std::string &input, std::chrono::milliseconds /*timeout*/)
+{
+	FILE *pipe = _popen(command.c_str(), "w");
+	if (pipe == nullptr) {
+		return -1;
+	}
+	fwrite(input.data(), 1, input.size(), pipe);
+	return _pclose(pipe);
+} // NOLINT(readability-identifier-naming) // Match MACRO style while providing a better interface for navigation
 
 int getopt(int argc, char *argv[], char *optstring);
 int getopt_long(int argc, char *const argv[], const char *optstring, const struct option *longopts, int *longindex);
 void *align_alloc(size_t size);
-thread_id *create_thread(funcptr thread, void *args);
-void wait_for_thread(thread_id *tid);
 std::string getProcessName(uint32_t processId);
 std::string getLocalCpus(const std::string &bdf);
 std::string getCpuList(const std::string &bdf);
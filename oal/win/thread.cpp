@@ -10,38 +10,6 @@
 #include <psapi.h>
 #include <stdlib.h>
 
-/**
- * @brief Creates a new thread on Windows platform
- *
- * This function creates a new thread using the Windows CreateThread API,
- * wrapping the thread handle in a thread_id object for later management.
- *
- * @param thread Function pointer to the thread function
- * @param args Arguments to pass to the thread function
- * @return thread_id* Pointer to the created thread_id object
- */
-thread_id *create_thread(funcptr thread, void *args)
-{
-	HANDLE thread_hdl;
-	thread_hdl = CreateThread(NULL, NULL, *thread, args, NULL, NULL);
-	thread_id *new_thread_id = new thread_id(thread_hdl);
-	return new_thread_id;
-}
-
-/**
- * @brief Waits for the specified thread to complete on Windows platform
- *
- * This function blocks until the specified thread has finished execution,
- * then cleans up the thread_id object.
- *
- * @param tid Pointer to the thread_id object representing the thread to wait for
- */
-void wait_for_thread(thread_id *tid)
-{
-	WaitForSingleObject(tid->ret_thread_uid(), INFINITE);
-	delete tid; // Clean up the thread_id object after waiting
-}
-
 /**
  * @brief Generates a timestamp string for logging and diagnostic purposes (Windows)
  *
@@ -18,49 +18,74 @@
 #include <optional>
 #include <cctype>
 #include <iostream>
+#include <iterator>
 #include <ostream>
+#include <array>
+#include <charconv>
 
-int TableBuilder::displayWidth(std::string_view text) const
+namespace {
+
+/**
+ * @brief Number of decimal digits needed to print @p value
+ */
+int decimalDigits(size_t value)
 {
-	if (auto it = widthCache.find(text); it != widthCache.end()) {
-		return it->second;
+	int digits = 1;
+	while (value >= 10) {
+		value /= 10;
+		++digits;
 	}
+	return digits;
+}
 
-	// Simple ASCII fast path
-	bool hasMultibyte = false;
-	for (unsigned char const c : text) {
-		if (c > 127) {
-			hasMultibyte = true;
-			break;
-		}
-	}
+/**
+ * @brief Width of the row-number column for a table with @p rowCount rows
+ */
+int rowNumberWidth(size_t rowCount) { return std::max(3, decimalDigits(rowCount) + 2); }
+
+/**
+ * @brief Append " <c>" — the cell padding followed by a column separator
+ */
+void appendSeparator(std::string &result, char c)
+{
+	result += ' ';
+	result += c;
+}
+
+} // namespace
 
+int TableBuilder::displayWidth(std::string_view text)
+{
+	// Count non-continuation bytes (UTF-8 continuation bytes are 10xxxxxx); for
+	// pure ASCII this is simply the length.
 	int width = 0;
-	if (!hasMultibyte) {
-		width = static_cast<int>(text.length());
-	} else {
-		// Count non-continuation bytes for basic UTF-8 width estimation
-		width = 0;
-		for (unsigned char const c : text) {
-			// UTF-8 continuation bytes start with 10xxxxxx
-			if ((c & 0xC0) != 0x80) {
-				++width;
-			}
+	for (unsigned char const c : text) {
+		if ((c & 0xC0) != 0x80) {
+			++width;
 		}
 	}
+	return width;
+}
 
-	// Cache the result with proper size limit
-	if (widthCache.size() >= 1000) {
-		widthCache.clear(); // Simple eviction strategy
+void TableBuilder::measureCells() const
+{
+	const size_t cols = columns.size();
+	if (measuredRows == rows.size() && cellWidths.size() == rows.size() * cols) {
+		return;
 	}
-	widthCache[std::string(text)] = width;
-
-	return width;
+	cellWidths.resize(rows.size() * cols);
+	for (size_t r = measuredRows; r < rows.size(); ++r) {
+		const auto &cells = rows[r].cells;
+		for (size_t c = 0; c < cols; ++c) {
+			cellWidths[r * cols + c] = (c < cells.size()) ? displayWidth(cells[c]) : 0;
+		}
+	}
+	measuredRows = rows.size();
 }
 
 void TableBuilder::calculateWidths() const
 {
-	if (!autoSize || columns.empty() || widthsCalculated) {
+	if (!autoSize || columns.empty() || widthsCalculated || widthsLocked) {
 		return;
 	}
 
@@ -72,7 +97,10 @@ void TableBuilder::calculateWidths() const
 		}
 	}
 
-	for (const auto &row : rows) {
+	measureCells();
+	const size_t cols = columns.size();
+	for (size_t r = 0; r < rows.size(); ++r) {
+		const auto &row = rows[r];
 		// Handle multi-line cells
 		if (!row.multiLineCells.empty()) {
 			for (size_t col = 0; col < std::min(columns.size(), row.multiLineCells.size()); ++col) {
@@ -83,9 +111,8 @@ void TableBuilder::calculateWidths() const
 			}
 		} else {
 			// Regular single-line cells
-			for (size_t col = 0; col < std::min(columns.size(), row.cells.size()); ++col) {
-				int const cellWidth = displayWidth(row.cells[col]);
-				columns[col].width = std::max(columns[col].width, cellWidth);
+			for (size_t col = 0; col < std::min(cols, row.cells.size()); ++col) {
+				columns[col].width = std::max(columns[col].width, cellWidths[r * cols + col]);
 			}
 		}
 	}
@@ -130,59 +157,44 @@ TableBuilder::BorderChars TableBuilder::getBorderChars(BorderStyle style) const
 {
 	switch (style) {
 	case BorderStyle::Heavy:
-		return {"=", "|", "+"};
+		return {'=', '|', '+'};
 	case BorderStyle::Double:
 		// Use regular characters for compatibility
-		return {"=", "|", "+"}; // Could use "═", "║", "╬" if terminal supports UTF-8
+		return {'=', '|', '+'}; // Could use "═", "║", "╬" if terminal supports UTF-8
 	case BorderStyle::None:
-		return {" ", " ", " "};
+		return {' ', ' ', ' '};
 	case BorderStyle::Normal:
 	default:
-		return {std::string(1, config.borderChar), std::string(1, config.verticalChar),
-				std::string(1, config.cornerChar)};
+		return {config.borderChar, config.verticalChar, config.cornerChar};
 	}
 }
 
-std::string TableBuilder::getBorderLine(int rowNumWidth, BorderStyle style) const
+void TableBuilder::appendBorderLine(std::string &result, int rowNumWidth, BorderStyle style) const
 {
 	auto borderChars = getBorderChars(style);
 
-	std::string border;
-	size_t totalLen = 1; // corner_char
+	result += borderChars.corner;
 
 	if (config.showRowNumbers) {
-		totalLen += static_cast<size_t>(rowNumWidth) + 3;
+		result.append(static_cast<size_t>(rowNumWidth) + 2, borderChars.horizontal);
+		result += borderChars.corner;
 	}
 
 	for (const auto &col : columns) {
-		totalLen += static_cast<size_t>(col.width) + 3;
-	}
-	border.reserve(totalLen + borderChars.horizontal.size() * totalLen);
-
-	border += borderChars.corner;
-
-	if (config.showRowNumbers) {
-		for (int i = 0; i < rowNumWidth + 2; ++i) {
-			border += borderChars.horizontal;
-		}
-		border += borderChars.corner;
+		result.append(static_cast<size_t>(col.width) + 2, borderChars.horizontal);
+		result += borderChars.corner;
 	}
-
-	for (const auto &col : columns) {
-		for (int i = 0; i < col.width + 2; ++i) {
-			border += borderChars.horizontal;
-		}
-		border += borderChars.corner;
-	}
-	border += '\n';
-
-	return border;
+	result += '\n';
 }
 
 void TableBuilder::alignTextDirect(std::string &result, std::string_view text, int width, Align alignment) const
 {
-	int const textWidth = displayWidth(text);
+	alignMeasured(result, text, displayWidth(text), width, alignment);
+}
 
+void TableBuilder::alignMeasured(std::string &result, std::string_view text, int textWidth, int width,
+								 Align alignment)
+{
 	if (textWidth > width) {
 		if (width >= 3) {
 			// Truncate and add ellipsis
@@ -228,61 +240,62 @@ void TableBuilder::alignTextDirect(std::string &result, std::string_view text, i
 	}
 }
 
-std::string TableBuilder::toTableString() const
+void TableBuilder::appendTable(std::string &result) const
 {
 	if (columns.empty()) {
-		return "[Empty Table - No Columns]\n";
+		result += "[Empty Table - No Columns]\n";
+		return;
 	}
 
 	calculateWidths();
-
-	// Better size estimation
-	size_t totalWidth = 1; // Initial corner_char
+	measureCells();
 
 	// Row number column width
 	int rowNumWidth = 0;
 	if (config.showRowNumbers) {
-		rowNumWidth = std::max(3, static_cast<int>(std::to_string(rows.size()).length()) + 2);
-		totalWidth += rowNumWidth + 3;
+		rowNumWidth = rowNumberWidth(rows.size());
 	}
 
+	// Width of the area between the outer borders, used by span and "No data" rows
+	int totalContentWidth = config.showRowNumbers ? rowNumWidth + 3 : 0;
 	for (const auto &col : columns) {
-		totalWidth += col.width + 3; // ' ' + content + ' |'
+		totalContentWidth += col.width + 3; // ' ' + content + ' |'
 	}
+	totalContentWidth -= 3;
 
-	size_t const borderLineLen = totalWidth + 1; // +1 for newline
-	size_t const rowLineLen = totalWidth + 1;
-	size_t const estimatedSize = borderLineLen * 3 + rowLineLen * (rows.size() + 1);
+	size_t maxExtraHeaders = 0;
+	for (const auto &col : columns) {
+		maxExtraHeaders = std::max(maxExtraHeaders, col.extraHeaders.size());
+	}
 
-	std::string result;
-	result.reserve(estimatedSize);
+	// Every line is at most as wide as the border line; reserve for the whole frame up front
+	size_t lineCount = 4 + preHeaderRows.size() * 2 + maxExtraHeaders;
+	for (const auto &row : rows) {
+		lineCount += row.lineCount();
+	}
+	result.reserve(result.size() + (static_cast<size_t>(totalContentWidth) + 6) * (lineCount + 1));
 
-	const std::string borderLine = getBorderLine(rowNumWidth);
+	const size_t borderStart = result.size();
+	appendBorderLine(result, rowNumWidth);
+	const size_t borderEnd = result.size();
+	auto appendTopBorder = [&]() { result.append(result, borderStart, borderEnd - borderStart); };
 
-	// Top border
-	result += borderLine;
+	auto appendSpan = [&](std::string_view text, Align align) {
+		result += config.verticalChar;
+		result += ' ';
+		alignTextDirect(result, text, totalContentWidth, align);
+		appendSeparator(result, config.verticalChar);
+		result += '\n';
+	};
 
 	// Pre-header rows: inside the top border, before the column header line.
 	// Each span row is followed by a separator using the row's border style.
 	for (const auto &row : preHeaderRows) {
 		if (row.spanText) {
-			int totalContentWidth = 0;
-			if (config.showRowNumbers) {
-				totalContentWidth += rowNumWidth + 3;
-			}
-			for (const auto &col : columns) {
-				totalContentWidth += col.width + 3;
-			}
-			totalContentWidth -= 3;
-
-			result += config.verticalChar;
-			result += ' ';
-			alignTextDirect(result, *row.spanText, totalContentWidth, row.spanAlign);
-			result += std::format(" {}", config.verticalChar);
-			result += '\n';
+			appendSpan(*row.spanText, row.spanAlign);
 		}
 		if (row.borderStyle != BorderStyle::None) {
-			result += getBorderLine(rowNumWidth, row.borderStyle);
+			appendBorderLine(result, rowNumWidth, row.borderStyle);
 		}
 	}
 
@@ -293,7 +306,7 @@ std::string TableBuilder::toTableString() const
 	if (config.showRowNumbers) {
 		result += ' ';
 		alignTextDirect(result, "#", rowNumWidth, Align::Center);
-		result += std::format(" {}", config.verticalChar);
+		appendSeparator(result, config.verticalChar);
 	}
 
 	for (size_t colIdx = 0; colIdx < columns.size(); ++colIdx) {
@@ -302,7 +315,7 @@ std::string TableBuilder::toTableString() const
 		alignTextDirect(result, col.header, col.width, col.alignment);
 		const bool isLast = (colIdx == columns.size() - 1);
 		if (!suppressHeaderColSep || isLast) {
-			result += std::format(" {}", config.verticalChar);
+			appendSeparator(result, config.verticalChar);
 		} else {
 			result += "  "; // two spaces instead of " |"
 		}
@@ -310,16 +323,12 @@ std::string TableBuilder::toTableString() const
 	result += '\n';
 
 	// Extra header lines (multi-line column headers)
-	size_t maxExtraHeaders = 0;
-	for (const auto &col : columns) {
-		maxExtraHeaders = std::max(maxExtraHeaders, col.extraHeaders.size());
-	}
 	for (size_t lineIdx = 0; lineIdx < maxExtraHeaders; ++lineIdx) {
 		result += config.verticalChar;
 		if (config.showRowNumbers) {
 			result += ' ';
 			alignTextDirect(result, "", rowNumWidth, Align::Left);
-			result += std::format(" {}", config.verticalChar);
+			appendSeparator(result, config.verticalChar);
 		}
 		for (const auto &col : columns) {
 			result += ' ';
@@ -328,13 +337,13 @@ std::string TableBuilder::toTableString() const
 			} else {
 				alignTextDirect(result, "", col.width, col.alignment);
 			}
-			result += std::format(" {}", config.verticalChar);
+			appendSeparator(result, config.verticalChar);
 		}
 		result += '\n';
 	}
 
 	if (!suppressHeaderSep) {
-		result += borderLine;
+		appendTopBorder();
 	}
 
 	// Data rows
@@ -342,48 +351,44 @@ std::string TableBuilder::toTableString() const
 		// Show "No data" row for empty tables with headers
 		result += config.verticalChar;
 
-		int totalContentWidth = 0;
-		if (config.showRowNumbers) {
-			totalContentWidth += rowNumWidth + 3;
-		}
-		for (const auto &col : columns) {
-			totalContentWidth += col.width + 3;
-		}
-		totalContentWidth -= 3; // Adjust for formatting
-
 		int const padding = totalContentWidth - static_cast<int>(config.noDataText.length());
 		result += ' ';
 		result.append(std::max(0, padding / 2), ' ');
 		result += config.noDataText;
 		result.append(std::max(0, padding - padding / 2), ' ');
-		result += std::format(" {}", config.verticalChar);
+		appendSeparator(result, config.verticalChar);
 		result += '\n';
 	} else {
+		const size_t cols = columns.size();
+		const int emptyCellWidth = displayWidth(config.emptyCellText);
+		std::array<char, 24> rowNumBuf{};
+
+		auto appendRowNumber = [&](size_t rowIdx) {
+			auto [end, ec] = std::to_chars(rowNumBuf.data(), rowNumBuf.data() + rowNumBuf.size(), rowIdx + 1);
+			const std::string_view num{rowNumBuf.data(), ec == std::errc{} ? end : rowNumBuf.data()};
+			alignMeasured(result, num, static_cast<int>(num.size()), rowNumWidth, Align::Right);
+		};
+		auto appendCellEnd = [&](size_t colIdx) {
+			const bool isLast = (colIdx == cols - 1);
+			if (!suppressDataColSep || isLast) {
+				appendSeparator(result, config.verticalChar);
+			} else {
+				result += "  ";
+			}
+		};
+
 		for (size_t rowIdx = 0; rowIdx < rows.size(); ++rowIdx) {
 			const auto &row = rows[rowIdx];
 
 			// Handle separator rows
 			if (row.isSeparator) {
-				result += getBorderLine(rowNumWidth, row.borderStyle);
+				appendBorderLine(result, rowNumWidth, row.borderStyle);
 				continue;
 			}
 
 			// Handle spanning text rows
 			if (row.spanText) {
-				int totalContentWidth = 0;
-				if (config.showRowNumbers) {
-					totalContentWidth += rowNumWidth + 3;
-				}
-				for (const auto &col : columns) {
-					totalContentWidth += col.width + 3;
-				}
-				totalContentWidth -= 3; // Adjust for formatting
-
-				result += config.verticalChar;
-				result += ' ';
-				alignTextDirect(result, *row.spanText, totalContentWidth, Align::Center);
-				result += std::format(" {}", config.verticalChar);
-				result += '\n';
+				appendSpan(*row.spanText, Align::Center);
 				continue;
 			}
 
@@ -397,27 +402,22 @@ std::string TableBuilder::toTableString() const
 					if (config.showRowNumbers) {
 						result += ' ';
 						if (line == 0) {
-							alignTextDirect(result, std::to_string(rowIdx + 1), rowNumWidth, Align::Right);
+							appendRowNumber(rowIdx);
 						} else {
 							result.append(rowNumWidth, ' ');
 						}
-						result += std::format(" {}", config.verticalChar);
+						appendSeparator(result, config.verticalChar);
 					}
 
 					// Multi-line cells
-					for (size_t i = 0; i < columns.size(); ++i) {
+					for (size_t i = 0; i < cols; ++i) {
 						result += ' ';
 						std::string_view cellContent;
 						if (i < row.multiLineCells.size() && line < row.multiLineCells[i].size()) {
 							cellContent = row.multiLineCells[i][line];
 						}
 						alignTextDirect(result, cellContent, columns[i].width, columns[i].alignment);
-						const bool isLast = (i == columns.size() - 1);
-						if (!suppressDataColSep || isLast) {
-							result += std::format(" {}", config.verticalChar);
-						} else {
-							result += "  ";
-						}
+						appendCellEnd(i);
 					}
 					result += '\n';
 				}
@@ -428,22 +428,20 @@ std::string TableBuilder::toTableString() const
 				// Row number
 				if (config.showRowNumbers) {
 					result += ' ';
-					alignTextDirect(result, std::to_string(rowIdx + 1), rowNumWidth, Align::Right);
-					result += std::format(" {}", config.verticalChar);
+					appendRowNumber(rowIdx);
+					appendSeparator(result, config.verticalChar);
 				}
 
-				for (size_t i = 0; i < columns.size(); ++i) {
+				for (size_t i = 0; i < cols; ++i) {
 					result += ' ';
-					std::string_view const cellContent = (i < row.cells.size() && !row.cells[i].empty())
-															 ? std::string_view{row.cells[i]}
-															 : std::string_view{config.emptyCellText};
-					alignTextDirect(result, cellContent, columns[i].width, columns[i].alignment);
-					const bool isLast = (i == columns.size() - 1);
-					if (!suppressDataColSep || isLast) {
-						result += std::format(" {}", config.verticalChar);
+					if (i < row.cells.size() && !row.cells[i].empty()) {
+						alignMeasured(result, row.cells[i], cellWidths[rowIdx * cols + i], columns[i].width,
+									  columns[i].alignment);
 					} else {
-						result += "  ";
+						alignMeasured(result, config.emptyCellText, emptyCellWidth, columns[i].width,
+									  columns[i].alignment);
 					}
+					appendCellEnd(i);
 				}
 				result += '\n';
 			}
@@ -451,9 +449,7 @@ std::string TableBuilder::toTableString() const
 	}
 
 	// Bottom border
-	result += borderLine;
-
-	return result;
+	appendTopBorder();
 }
 
 std::string TableBuilder::toJsonString(bool compact) const
@@ -524,7 +520,8 @@ TableBuilder &TableBuilder::addColumn(std::string_view header, int width, Align
 	}
 	columns.emplace_back(std::string{header}, width, alignment);
 	widthsCalculated = false;
-	widthCache.clear();
+	widthsLocked = false;
+	invalidateCellWidths();
 	return *this;
 }
 
@@ -596,6 +593,8 @@ TableBuilder::Row &TableBuilder::lastRow()
 	if (rows.empty()) {
 		throw std::out_of_range("No rows in table");
 	}
+	// The caller may edit the cells; re-measure this row on the next render
+	measuredRows = std::min(measuredRows, rows.size() - 1);
 	return rows.back();
 }
 
@@ -642,7 +641,7 @@ TableBuilder &TableBuilder::configure(const TableConfig &newConfig)
 {
 	this->config = newConfig;
 	widthsCalculated = false;
-	widthCache.clear();
+	widthsLocked = false;
 	return *this;
 }
 
@@ -681,7 +680,7 @@ TableBuilder &TableBuilder::setColumnWidth(size_t colIndex, int width)
 	}
 	columns[colIndex].width = width;
 	widthsCalculated = false;
-	widthCache.clear();
+	widthsLocked = false;
 	return *this;
 }
 
@@ -692,7 +691,6 @@ TableBuilder &TableBuilder::setColumnExtraHeaders(size_t colIndex, std::vector<s
 	}
 	columns[colIndex].extraHeaders = std::move(headers);
 	widthsCalculated = false;
-	widthCache.clear();
 	return *this;
 }
 
@@ -701,8 +699,7 @@ int TableBuilder::getTotalWidth() const
 	calculateWidths();
 	int total = 1; // left border char
 	if (config.showRowNumbers) {
-		int rw = std::max(3, static_cast<int>(std::to_string(rows.size()).length()) + 2);
-		total += rw + 3;
+		total += rowNumberWidth(rows.size()) + 3;
 	}
 	for (const auto &col : columns) {
 		total += col.width + 3; // ' ' content ' |'
@@ -718,7 +715,6 @@ TableBuilder &TableBuilder::padToWidth(int targetWidth)
 	int deficit = targetWidth - getTotalWidth();
 	if (deficit > 0) {
 		columns.back().width += deficit;
-		widthCache.clear();
 	}
 	return *this;
 }
@@ -739,7 +735,8 @@ TableBuilder &TableBuilder::removeColumn(size_t colIndex)
 	}
 
 	widthsCalculated = false;
-	widthCache.clear();
+	widthsLocked = false;
+	invalidateCellWidths();
 	return *this;
 }
 
@@ -845,8 +842,10 @@ TableBuilder &TableBuilder::setCell(size_t rowIndex, size_t colIndex, std::strin
 	}
 
 	rows[rowIndex].cells[colIndex] = value;
+	if (rowIndex < measuredRows) {
+		cellWidths[rowIndex * columns.size() + colIndex] = displayWidth(value);
+	}
 	widthsCalculated = false;
-	widthCache.clear(); // Invalidate cache
 	return *this;
 }
 
@@ -862,6 +861,7 @@ TableBuilder &TableBuilder::sortByColumn(size_t colIndex, bool ascending)
 
 		return ascending ? valA < valB : valA > valB;
 	});
+	invalidateCellWidths();
 
 	return *this;
 }
@@ -937,28 +937,55 @@ TableBuilder::TableStats TableBuilder::getStats() const
 }
 void TableBuilder::print() const noexcept
 {
-	if (columns.empty()) {
-		std::cout << "[Empty Table - No Columns]\n";
-		return;
-	}
-	std::cout << toString();
+	frame.clear();
+	appendFrame(frame);
+	writeFrame(frame);
 }
 
 void TableBuilder::printTo(std::ostream &os) const noexcept
+{
+	frame.clear();
+	appendFrame(frame);
+	os.write(frame.data(), static_cast<std::streamsize>(frame.size()));
+}
+
+void TableBuilder::appendFrame(std::string &out) const
 {
 	if (columns.empty()) {
-		os << "[Empty Table - No Columns]\n";
+		out += "[Empty Table - No Columns]\n";
 		return;
 	}
-	os << toString();
+	appendRendered(out);
 }
 
 std::string TableBuilder::toString() const
 {
-	return (outputFormat == OutputFormat::JSON) ? toJsonString() : toTableString();
+	std::string result;
+	renderTo(result);
+	return result;
+}
+
+void TableBuilder::renderTo(std::string &out) const
+{
+	out.clear();
+	appendRendered(out);
 }
 
-std::string TableBuilder::asTable() const { return toTableString(); }
+void TableBuilder::appendRendered(std::string &out) const
+{
+	if (outputFormat == OutputFormat::JSON) {
+		out += toJsonString();
+		return;
+	}
+	appendTable(out);
+}
+
+std::string TableBuilder::asTable() const
+{
+	std::string result;
+	appendTable(result);
+	return result;
+}
 
 std::string TableBuilder::asJson(bool compact) const { return toJsonString(compact); }
 
@@ -976,61 +1003,66 @@ TableBuilder &TableBuilder::lockWidths()
 {
 	calculateWidths();
 	widthsCalculated = true;
+	widthsLocked = true;
 	return *this;
 }
 
 std::string TableBuilder::headerLine(LineStyle style) const
+{
+	std::string result;
+	appendHeaderLine(result, style);
+	return result;
+}
+
+std::string TableBuilder::rowLine(const std::vector<std::string> &values, LineStyle style) const
+{
+	std::string result;
+	appendRowLine(result, values, style);
+	return result;
+}
+
+void TableBuilder::appendHeaderLine(std::string &out, LineStyle style) const
 {
 	const bool pad = (style == LineStyle::Aligned);
 	const std::string_view sep = pad ? "  " : ", ";
 	calculateWidths();
-	if (columns.empty()) {
-		return {};
-	}
-	std::string result;
 	for (size_t i = 0; i < columns.size(); ++i) {
 		if (i > 0) {
-			result += sep;
+			out += sep;
 		}
 		if (pad) {
-			alignTextDirect(result, columns[i].header, columns[i].width, columns[i].alignment);
+			alignTextDirect(out, columns[i].header, columns[i].width, columns[i].alignment);
 		} else {
-			result += columns[i].header;
+			out += columns[i].header;
 		}
 	}
-	return result;
 }
 
-std::string TableBuilder::rowLine(const std::vector<std::string> &values, LineStyle style) const
+void TableBuilder::appendRowLine(std::string &out, std::span<const std::string> values, LineStyle style) const
 {
 	const bool pad = (style == LineStyle::Aligned);
 	const std::string_view sep = pad ? "  " : ", ";
 	calculateWidths();
-	if (columns.empty()) {
-		return {};
-	}
-	std::string result;
 	for (size_t i = 0; i < columns.size(); ++i) {
 		if (i > 0) {
-			result += sep;
+			out += sep;
 		}
 		const std::string_view cellContent = (i < values.size() && !values[i].empty())
 												 ? std::string_view{values[i]}
 												 : std::string_view{config.emptyCellText};
 		if (pad) {
-			alignTextDirect(result, cellContent, columns[i].width, columns[i].alignment);
+			alignTextDirect(out, cellContent, columns[i].width, columns[i].alignment);
 		} else {
-			result += cellContent;
+			out += cellContent;
 		}
 	}
-	return result;
 }
 
 TableBuilder &TableBuilder::clearRows() noexcept
 {
 	rows.clear();
 	widthsCalculated = false;
-	widthCache.clear();
+	invalidateCellWidths();
 	return *this;
 }
 
@@ -1040,33 +1072,22 @@ TableBuilder &TableBuilder::clear() noexcept
 	rows.clear();
 	preHeaderRows.clear();
 	widthsCalculated = false;
-	widthCache.clear();
+	widthsLocked = false;
+	invalidateCellWidths();
 	return *this;
 }
 
-void TableBuilder::moveCursorUp(int lines)
+void TableBuilder::writeFrame(std::string_view text)
 {
-	if (lines > 0) {
-		std::cout << "\033[" << lines << "A";
-		std::cout.flush();
-	}
-}
-
-void TableBuilder::clearToEnd()
-{
-	std::cout << "\033[J"; // Clear from cursor to end of screen
+	// One write of the whole frame to std::cout, like the rest of the output, so it stays in
+	// order with it and follows std::cout when it is redirected
+	std::cout.write(text.data(), static_cast<std::streamsize>(text.size()));
 	std::cout.flush();
 }
 
-int TableBuilder::countLines(const std::string &str)
+int TableBuilder::countLines(std::string_view str)
 {
-	int count = 0;
-	for (char const c : str) {
-		if (c == '\n') {
-			++count;
-		}
-	}
-	return count;
+	return static_cast<int>(std::count(str.begin(), str.end(), '\n'));
 }
 
 void TableBuilder::clearScreen()
@@ -1095,19 +1116,19 @@ void TableBuilder::printStreaming() const
 		throw std::runtime_error("printStreaming() called outside of streaming mode. Call startStreaming() first.");
 	}
 
-	// Move cursor up to overwrite previous table (except on first print)
+	// Render the whole frame, including the cursor movement that overwrites the previous
+	// table, into the reused frame buffer so each update reaches the terminal in one write
+	frame.clear();
 	if (lastTableLines > 0) {
-		moveCursorUp(lastTableLines);
-		clearToEnd();
+		// Move cursor up, then clear from cursor to end of screen
+		std::format_to(std::back_inserter(frame), "\033[{}A\033[J", lastTableLines);
 	}
-
-	// Print the table
-	std::string const output = toString();
-	std::cout << output;
-	std::cout.flush();
+	const size_t tableStart = frame.size();
+	appendRendered(frame);
+	writeFrame(frame);
 
 	// Update line count for next iteration
-	const_cast<TableBuilder *>(this)->lastTableLines = countLines(output);
+	lastTableLines = countLines(std::string_view{frame}.substr(tableStart));
 }
 
 bool TableBuilder::isStreaming() const noexcept { return streamingMode; }
@@ -23,6 +23,7 @@
 #include <unordered_set>
 #include <unordered_map>
 #include <optional>
+#include <span>
 #include <tuple>
 
 namespace detail {
@@ -218,18 +219,35 @@ private:
 	bool suppressDataColSep = true;   // Suppress inner | between data cells
 	mutable bool widthsCalculated = false;
 	OutputFormat outputFormat = OutputFormat::Table;
+	bool widthsLocked = false; // Set by lockWidths(); cleared when the column layout changes
 	TableConfig config;
 
-	mutable std::unordered_map<std::string, int, StringHash, StringEqual> widthCache;
+	// Display width of rows[r].cells[c] at index r * columns.size() + c, measured once per cell.
+	// Rows [0, measuredRows) are up to date; rows appended later are measured on demand.
+	mutable std::vector<int> cellWidths;
+	mutable size_t measuredRows = 0;
 
 	// Streaming mode state
 	bool streamingMode = false;
-	int lastTableLines = 0;
+	mutable int lastTableLines = 0;
+
+	// Frame buffer reused by print() and printStreaming()
+	mutable std::string frame;
 
 	/**
 	 * @brief Calculate display width considering basic UTF-8 characters
 	 */
-	int displayWidth(std::string_view text) const;
+	static int displayWidth(std::string_view text);
+
+	/**
+	 * @brief Measure display widths of single-line cells not measured yet
+	 */
+	void measureCells() const;
+
+	/**
+	 * @brief Forget cached cell widths (cells were modified, reordered or removed)
+	 */
+	void invalidateCellWidths() const noexcept { measuredRows = 0; }
 
 	void calculateWidths() const;
 
@@ -238,35 +256,45 @@ private:
 	 */
 	struct BorderChars
 	{
-		std::string horizontal;
-		std::string vertical;
-		std::string corner;
+		char horizontal;
+		char vertical;
+		char corner;
 	};
 
 	BorderChars getBorderChars(BorderStyle style) const;
 
-	std::string getBorderLine(int rowNumWidth = 0, BorderStyle style = BorderStyle::Normal) const;
+	void appendBorderLine(std::string &result, int rowNumWidth = 0, BorderStyle style = BorderStyle::Normal) const;
 
 	void alignTextDirect(std::string &result, std::string_view text, int width, Align alignment) const;
 
-	std::string toTableString() const;
+	/**
+	 * @brief Align text whose display width is already known
+	 */
+	static void alignMeasured(std::string &result, std::string_view text, int textWidth, int width, Align alignment);
 
-	std::string toJsonString(bool compact = false) const;
+	void appendTable(std::string &result) const;
+
+	/**
+	 * @brief Append the table or JSON rendering, depending on the output format
+	 */
+	void appendRendered(std::string &out) const;
 
 	/**
-	 * @brief Move cursor up by specified number of lines
+	 * @brief Append what print() shows, including the placeholder for a table without columns
 	 */
-	static void moveCursorUp(int lines);
+	void appendFrame(std::string &out) const;
+
+	std::string toJsonString(bool compact = false) const;
 
 	/**
-	 * @brief Clear from cursor to end of screen
+	 * @brief Write a rendered frame to std::cout in one piece
 	 */
-	static void clearToEnd();
+	static void writeFrame(std::string_view text);
 
 	/**
 	 * @brief Count lines in a string
 	 */
-	static int countLines(const std::string &str);
+	static int countLines(std::string_view str);
 
 public:
 	/**
@@ -555,7 +583,7 @@ public:
 		auto it = std::remove_if(rows.begin(), rows.end(), [&pred](const Row &row) { return !pred(row); });
 		rows.erase(it, rows.end());
 		widthsCalculated = false;
-		widthCache.clear();
+		invalidateCellWidths();
 		return *this;
 	}
 
@@ -584,6 +612,14 @@ public:
 	 */
 	[[nodiscard]] std::string toString() const;
 
+	/**
+	 * @brief Render into a caller-owned buffer using current output format.
+	 *
+	 * The buffer is cleared first and keeps its capacity, so rendering the same table
+	 * repeatedly into one buffer does not allocate once it has grown to frame size.
+	 */
+	void renderTo(std::string &out) const;
+
 	/**
 	 * @brief Explicitly convert to table format
 	 */
@@ -599,6 +635,7 @@ public:
 	 *
 	 * Triggers auto-sizing if enabled. After this call, adding more rows will not
 	 * recalculate column widths, making the table safe for streaming append use.
+	 * Adding, removing or resizing columns, or reconfiguring the table, unlocks it.
 	 */
 	TableBuilder &lockWidths();
 
@@ -632,6 +669,20 @@ public:
 	[[nodiscard]] std::string rowLine(const std::vector<std::string> &values,
 									  LineStyle style = LineStyle::Aligned) const;
 
+	/**
+	 * @brief Append the header row to @p out; see headerLine().
+	 */
+	void appendHeaderLine(std::string &out, LineStyle style = LineStyle::Aligned) const;
+
+	/**
+	 * @brief Append a single row of values to @p out; see rowLine().
+	 *
+	 * Intended for high-rate streaming: with lockWidths() and a reused buffer a line is
+	 * rendered without allocating.
+	 */
+	void appendRowLine(std::string &out, std::span<const std::string> values,
+					   LineStyle style = LineStyle::Aligned) const;
+
 	/**
 	 * @brief Get number of columns
 	 */
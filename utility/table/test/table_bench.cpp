@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ */
+
+// Rendering benchmark for TableBuilder.
+//
+// Covers the two hot paths: a large process table re-rendered every refresh (as `ps` and
+// the default view do) and a high-rate stream of width-locked rows (as `dump` in aligned
+// mode does). Each case is timed once with the allocating string API and once rendering
+// into a reused buffer. Run with `meson test --benchmark table_bench`.
+
+#include "table_builder.h"
+#include <chrono>
+#include <cstdio>
+#include <format>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int PROCESS_ROWS = 5000;
+constexpr int TABLE_FRAMES = 50;
+constexpr int STREAM_ROWS = 200000;
+
+template <typename Fn> double nsPer(int iterations, Fn &&fn)
+{
+	const auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; ++i) {
+		fn(i);
+	}
+	const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+	return elapsed.count() / iterations;
+}
+
+TableBuilder makeProcessTable()
+{
+	TableBuilder table = TableBuilder::bordered();
+	table.addColumn("GPU", Align::Right)
+		.addColumn("PID", Align::Right)
+		.addColumn("Type", Align::Center)
+		.addColumn("Process name", Align::Left)
+		.addColumn("GPU Memory", Align::Right);
+	for (int i = 0; i < PROCESS_ROWS; ++i) {
+		table.addRow(i % 8, 10000 + i, (i % 3 == 0) ? "C" : "G", std::format("/usr/bin/workload-{}", i),
+					 std::format("{} MiB", (i * 37) % 16384));
+	}
+	return table;
+}
+
+} // namespace
+
+int main()
+{
+	size_t checksum = 0;
+
+	// Large process table, re-rendered every frame
+	const TableBuilder processTable = makeProcessTable();
+	const double tableString = nsPer(TABLE_FRAMES, [&](int) { checksum += processTable.toString().size(); });
+	std::string frame;
+	const double tableReused = nsPer(TABLE_FRAMES, [&](int) {
+		processTable.renderTo(frame);
+		checksum += frame.size();
+	});
+
+	// Streaming dump rows against a width-locked layout
+	TableBuilder dump;
+	dump.addColumn("Timestamp", 12, Align::Left)
+		.addColumn("DeviceId", 8, Align::Right)
+		.addColumn("GPU Power (W)", 13, Align::Right)
+		.addColumn("GPU Frequency (MHz)", 19, Align::Right)
+		.addColumn("GPU Core Temperature (C)", 24, Align::Right)
+		.addColumn("GPU Utilization (%)", 19, Align::Right)
+		.lockWidths();
+	std::vector<std::string> cells{"12:34:56.789", "0", "123.45", "1550", "47.00", "99.80"};
+	const double rowString = nsPer(STREAM_ROWS, [&](int i) {
+		cells[1] = std::to_string(i % 8);
+		checksum += dump.rowLine(cells).size();
+	});
+	std::string line;
+	const double rowReused = nsPer(STREAM_ROWS, [&](int i) {
+		cells[1] = std::to_string(i % 8);
+		line.clear();
+		dump.appendRowLine(line, cells);
+		checksum += line.size();
+	});
+
+	std::printf("process table (%d rows)   toString(): %10.0f ns/frame   renderTo(): %10.0f ns/frame\n",
+				PROCESS_ROWS, tableString, tableReused);
+	std::printf("streaming dump row        rowLine():  %10.1f ns/row     appendRowLine(): %6.1f ns/row\n",
+				rowString, rowReused);
+	std::printf("checksum %zu\n", checksum);
+	return 0;
+}
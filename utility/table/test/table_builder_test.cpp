@@ -663,4 +663,84 @@ TEST_CASE("TableBuilder clear also clears preHeaderRows") {
 
     CHECK_MESSAGE(table.toString().find("MyBanner") == std::string::npos,
                   "banner must not appear after clear()");
-}
\ No newline at end of file
+}
+
+TEST_CASE("TableBuilder renderTo matches toString and reuses the buffer") {
+    TableBuilder table = TableBuilder::bordered();
+    table.addColumn("GPU").addColumn("Name").showRowNumbers();
+    for (int i = 0; i < 50; ++i) {
+        table.addRow(i, std::format("device-{}", i));
+    }
+
+    std::string frame;
+    table.renderTo(frame);
+    CHECK(frame == table.toString());
+
+    const auto *data = frame.data();
+    const auto capacity = frame.capacity();
+    table.renderTo(frame);
+    CHECK(frame == table.toString());
+    CHECK_MESSAGE(frame.data() == data, "re-rendering the same table must not reallocate");
+    CHECK(frame.capacity() == capacity);
+}
+
+TEST_CASE("TableBuilder appendRowLine matches rowLine") {
+    TableBuilder table;
+    table.addColumn("Timestamp", 12, Align::Left).addColumn("Power (W)", 9, Align::Right).lockWidths();
+    const std::vector<std::string> values{"12:00:00.000", "123.45"};
+
+    std::string line = "prefix|";
+    table.appendRowLine(line, values);
+    CHECK(line == "prefix|" + table.rowLine(values));
+
+    line.clear();
+    table.appendRowLine(line, values, TableBuilder::LineStyle::Csv);
+    CHECK(line == "12:00:00.000, 123.45");
+
+    line.clear();
+    table.appendHeaderLine(line);
+    CHECK(line == table.headerLine());
+}
+
+TEST_CASE("TableBuilder lockWidths keeps widths when rows are added") {
+    TableBuilder table;
+    table.addColumn("A").addRow("x").lockWidths();
+    const int locked = table.getTotalWidth();
+
+    table.addRow("a much longer cell than before");
+    CHECK_MESSAGE(table.getTotalWidth() == locked, "locked widths must not grow with new rows");
+
+    table.addColumn("B");
+    CHECK_MESSAGE(table.getTotalWidth() > locked, "adding a column unlocks the layout");
+}
+
+TEST_CASE("TableBuilder re-measures cells edited after rendering") {
+    TableBuilder table;
+    table.addColumn("A").addRow("x").addRow("y").enableAutoSizing();
+    const int before = table.getTotalWidth();
+    (void)table.toString();
+
+    table.setCell(0, 0, "longer value");
+    CHECK(table.getTotalWidth() == before + 11);
+
+    table.lastRow().cells[0] = "an even longer value";
+    table.enableAutoSizing();
+    CHECK(table.toString().find("an even longer value") != std::string::npos);
+    CHECK(table.getTotalWidth() == before + 19);
+}
+
+TEST_CASE("TableBuilder measures UTF-8 cells by code point") {
+    TableBuilder table;
+    table.addColumn("N").addRow("ÄÖÜ").addRow("abc").enableAutoSizing();
+
+    std::istringstream lines(table.asTable());
+    std::string header;
+    std::string utf8Row;
+    std::string asciiRow;
+    std::getline(lines, header);
+    std::getline(lines, header);
+    std::getline(lines, utf8Row);
+    std::getline(lines, asciiRow);
+    CHECK(utf8Row.size() == asciiRow.size() + 3); // three 2-byte code points, same display width
+    CHECK(header.size() == asciiRow.size());
+}
@@ -0,0 +1,207 @@
+#!/usr/bin/env python3
+"""
+Generate level-zero-stub configurations with N devices.
+
+Every device gets a unique UUID, serial number and PCI address, one engine
+group per --engines entry, a package power domain and an HBM memory module.
+Engine activity, energy, memory bandwidth and PCI byte counters are driven by
+counter models, so a sampling loop sees them advance at realistic rates.
+
+Usage:
+    python3 hack/generate-stub-config.py --devices 8 > /tmp/stub.yaml
+    python3 hack/generate-stub-config.py --devices 4 --scale-spread 0.5 \\
+        --latency zesPowerGetEnergyCounter:normal:1000:200 \\
+        --latency zesEngineGetActivity:exponential:300
+"""
+
+import argparse
+import random
+import sys
+
+ENGINE_TYPES = {
+    "all": 0,  # ZES_ENGINE_GROUP_ALL
+    "compute": 1,  # ZES_ENGINE_GROUP_COMPUTE_ALL
+    "media": 2,  # ZES_ENGINE_GROUP_MEDIA_ALL
+    "copy": 3,  # ZES_ENGINE_GROUP_COPY_ALL
+}
+
+DISTRIBUTIONS = ("fixed", "uniform", "normal", "exponential")
+
+GIB = 1 << 30
+
+
+def parse_latency(text):
+    """FUNCTION:DISTRIBUTION:A[:B] -> dict; A/B are Mean/StdDev, or Min/Max for uniform."""
+    parts = text.split(":")
+    if len(parts) not in (3, 4) or parts[1] not in DISTRIBUTIONS:
+        raise argparse.ArgumentTypeError(f"expected FUNCTION:{{{','.join(DISTRIBUTIONS)}}}:A[:B], got '{text}'")
+    try:
+        values = [float(v) for v in parts[2:]]
+    except ValueError:
+        raise argparse.ArgumentTypeError(f"invalid number in '{text}'")
+    latency = {"Function": parts[0], "Distribution": parts[1]}
+    if parts[1] == "uniform":
+        latency["Min"] = values[0]
+        latency["Max"] = values[1] if len(values) > 1 else values[0]
+    else:
+        latency["Mean"] = values[0]
+        if len(values) > 1:
+            latency["StdDev"] = values[1]
+    return latency
+
+
+def device_yaml(index, args, rng):
+    uuid = f"{0x8086:08x}-{index >> 16:04x}-{index & 0xffff:04x}-0000-{index:012x}"
+    scale = 1.0 + rng.uniform(-args.scale_spread, args.scale_spread) if args.scale_spread else 1.0
+    bus = 0x10 + index
+    lines = [
+        f"  - Scale: {scale:.3f}",
+        "    Properties:",
+        "      Core:",
+        "        Type: 1  # ZE_DEVICE_TYPE_GPU",
+        "        VendorId: 32902",
+        f"        DeviceId: {args.device_id}",
+        "        Uuid:",
+        f'          Id: "{uuid}"',
+        f'        Name: "Stub GPU {index}"',
+        f'      SerialNumber: "SN-{index:06d}"',
+        f'      BoardNumber: "BOARD-{index:06d}"',
+        '      BrandName: "Intel(R) Corporation"',
+        '      ModelName: "Stub GPU"',
+        '      VendorName: "Intel(R) Corporation"',
+        "      Uuid:",
+        f'        Id: "{uuid}"',
+        "      Type: 1  # ZES_DEVICE_TYPE_GPU",
+        "    State:",
+        "      Reset: 0",
+        "      Repaired: 1  # ZES_REPAIR_STATUS_NOT_PERFORMED",
+        "    PCI:",
+        "      Properties:",
+        "        Address:",
+        f"          Domain: {bus >> 8}",
+        f"          Bus: {bus & 0xff}",
+        "          Device: 0",
+        "          Function: 0",
+        "        MaxSpeed:",
+        "          Gen: 4",
+        "          Width: 16",
+        "          MaxBandwidth: 31500000000",
+        "        HaveBandwidthCounters: true",
+        "      Stats:",
+        "        RxCounter: 0",
+        "        TxCounter: 0",
+        "      RxModel:",
+        f"        Rate: {args.pci_rate}",
+        f"        Noise: {args.noise}",
+        "      TxModel:",
+        f"        Rate: {args.pci_rate // 2}",
+        f"        Noise: {args.noise}",
+        "    EngineGroups:",
+    ]
+    for engine in args.engines:
+        lines += [
+            "    - Properties:",
+            f"        Type: {ENGINE_TYPES[engine]}",
+            "      Activity:",
+            "        ActiveTime: 0",
+            "      ActivityModel:",
+            f"        Rate: {args.busy * 10000}",
+            f"        Noise: {args.noise}",
+        ]
+    lines += [
+        "    PowerDomains:",
+        "    - Properties:",
+        "        OnSubdevice: false",
+        "        ExtendedProperties:",
+        "          Domain: 2  # ZES_POWER_DOMAIN_PACKAGE",
+        "      EnergyCounter:",
+        "        Energy: 0",
+        "      EnergyModel:",
+        f"        Rate: {args.power * 1000000}",
+        f"        Noise: {args.noise}",
+        "    MemoryModules:",
+        "    - Properties:",
+        "        Type: 0  # ZES_MEM_TYPE_HBM",
+        "        Location: 1  # ZES_MEM_LOC_DEVICE",
+        f"        PhysicalSize: {64 * GIB}",
+        "      State:",
+        "        Health: 1  # ZES_MEM_HEALTH_OK",
+        f"        Free: {48 * GIB}",
+        f"        Size: {64 * GIB}",
+        "      Bandwidth:",
+        "        ReadCounter: 0",
+        "        WriteCounter: 0",
+        "        MaxBandwidth: 1600000000000",
+        "      ReadModel:",
+        f"        Rate: {args.mem_rate}",
+        f"        Noise: {args.noise}",
+        "      WriteModel:",
+        f"        Rate: {args.mem_rate // 2}",
+        f"        Noise: {args.noise}",
+    ]
+    return lines
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--devices", type=int, default=4, help="number of devices (default: 4)")
+    parser.add_argument("--device-id", type=int, default=0x0BD5, help="PCI device ID (default: 0x0bd5)")
+    parser.add_argument(
+        "--engines",
+        type=lambda s: s.split(","),
+        default=["all", "compute", "copy"],
+        help=f"comma-separated engine groups per device, of {','.join(ENGINE_TYPES)} (default: all,compute,copy)",
+    )
+    parser.add_argument("--busy", type=float, default=50, help="engine utilization in percent (default: 50)")
+    parser.add_argument("--power", type=float, default=300, help="package power in watts (default: 300)")
+    parser.add_argument("--mem-rate", type=int, default=200 * 10**9, help="memory read bytes/s (default: 200e9)")
+    parser.add_argument("--pci-rate", type=int, default=2 * 10**9, help="PCIe received bytes/s (default: 2e9)")
+    parser.add_argument("--noise", type=float, default=0.05, help="relative noise of every counter (default: 0.05)")
+    parser.add_argument(
+        "--scale-spread",
+        type=float,
+        default=0.0,
+        help="give each device a random Scale in 1 +- SPREAD (default: 0, all devices alike)",
+    )
+    parser.add_argument(
+        "--latency",
+        type=parse_latency,
+        action="append",
+        default=[],
+        metavar="FUNCTION:DISTRIBUTION:A[:B]",
+        help="inject latency (microseconds) into FUNCTION; repeatable",
+    )
+    parser.add_argument("--seed", type=int, default=1, help="seed for the generator and the stub (default: 1)")
+    parser.add_argument("--output-file", help="write to this file instead of stdout")
+    args = parser.parse_args()
+
+    if args.devices < 1 or args.devices > 0xFFFF:
+        parser.error("--devices must be between 1 and 65535")
+    unknown = [e for e in args.engines if e not in ENGINE_TYPES]
+    if unknown:
+        parser.error(f"unknown engine group(s): {','.join(unknown)}")
+
+    rng = random.Random(args.seed)
+    lines = [
+        f"# Generated by hack/generate-stub-config.py --devices {args.devices}",
+        f"Seed: {args.seed}",
+    ]
+    if args.latency:
+        lines.append("Latencies:")
+        for latency in args.latency:
+            lines.append(f"  - Function: {latency['Function']}")
+            lines += [f"    {k}: {v}" for k, v in latency.items() if k != "Function"]
+    lines += ["Drivers:", "- Devices:"]
+    for index in range(args.devices):
+        lines += device_yaml(index, args, rng)
+
+    text = "\n".join(lines) + "\n"
+    if args.output_file:
+        with open(args.output_file, "w") as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+
+
+if __name__ == "__main__":
+    main()
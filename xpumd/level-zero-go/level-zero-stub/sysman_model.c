@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2026 Intel Corporation
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "sysman_state.h"
+
+#include <errno.h>
+#include <math.h>
+#include <string.h>
+#include <time.h>
+
+// Seed used when the config does not set one, so runs are reproducible by default.
+#define SYSMAN_DEFAULT_SEED 0x5eed5eed5eed5eedULL
+
+// Latency drawn by sysman_api_lock() and slept off by sysman_api_delay().
+static _Thread_local uint64_t t_pending_delay_ns;
+
+// ------------------------------------------------------------------
+// Clock and random numbers
+// ------------------------------------------------------------------
+
+uint64_t sysman_clock_ns(void)
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+// splitmix64; the state lives in g_sysman_state so reloading a config with the
+// same Seed replays the same sequence. Must be called with the state lock held.
+static uint64_t next_random(void)
+{
+	uint64_t z = (g_sysman_state.rng += 0x9e3779b97f4a7c15ULL);
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+	return z ^ (z >> 31);
+}
+
+// Uniform in [0, 1).
+static double next_uniform(void) { return (double)(next_random() >> 11) * (1.0 / 9007199254740992.0); }
+
+// Standard normal via Box-Muller.
+static double next_normal(void)
+{
+	double u1 = next_uniform();
+	double u2 = next_uniform();
+	if (u1 < 1e-300)
+		u1 = 1e-300;
+	return sqrt(-2.0 * log(u1)) * cos(2.0 * 3.14159265358979323846 * u2);
+}
+
+void sysman_models_reset(void)
+{
+	g_sysman_state.rng = g_sysman_state.seed ? g_sysman_state.seed : SYSMAN_DEFAULT_SEED;
+	g_sysman_state.loaded_ns = sysman_clock_ns();
+}
+
+// ------------------------------------------------------------------
+// Counter models
+// ------------------------------------------------------------------
+
+void sysman_counter_advance(sysman_counter_model_t *model, double scale, uint64_t *counter)
+{
+	if (!model || !counter)
+		return;
+	if (scale <= 0.0)
+		scale = 1.0;
+
+	uint64_t now = sysman_clock_ns();
+	uint64_t start = g_sysman_state.loaded_ns;
+	uint64_t last = model->last_ns ? model->last_ns : start;
+	model->last_ns = now;
+	if (now <= last)
+		return;
+
+	// Exact integral of rate + ramp * t over [last, now], t in seconds since load.
+	double t0 = (double)(last - start) / 1e9;
+	double t1 = (double)(now - start) / 1e9;
+	double dt = t1 - t0;
+	double increment = scale * (model->rate * dt + model->ramp * (t1 * t1 - t0 * t0) / 2.0);
+	if (model->noise > 0.0)
+		increment *= 1.0 + model->noise * (2.0 * next_uniform() - 1.0);
+	if (increment <= 0.0)
+		return; // counters never run backwards
+
+	increment += model->carry;
+	double whole = floor(increment);
+	model->carry = increment - whole;
+
+	// Counters beyond 2^64 are not meaningful; whole fits unless a config asks
+	// for absurd rates, in which case the counter simply wraps.
+	uint64_t step = whole >= 18446744073709551615.0 ? UINT64_MAX : (uint64_t)whole;
+	uint64_t value = *counter + step;
+	if (model->wrap)
+		value %= model->wrap;
+	*counter = value;
+}
+
+// ------------------------------------------------------------------
+// Latency injection
+// ------------------------------------------------------------------
+
+static double sample_latency_us(const sysman_latency_t *lat)
+{
+	double us;
+	switch (lat->kind) {
+	case SYSMAN_LATENCY_UNIFORM:
+		us = lat->min + (lat->max - lat->min) * next_uniform();
+		break;
+	case SYSMAN_LATENCY_NORMAL:
+		us = lat->mean + lat->std_dev * next_normal();
+		break;
+	case SYSMAN_LATENCY_EXPONENTIAL:
+		us = -lat->mean * log(1.0 - next_uniform());
+		break;
+	case SYSMAN_LATENCY_FIXED:
+	default:
+		us = lat->mean;
+		break;
+	}
+	if (us < lat->min)
+		us = lat->min;
+	if (lat->max > 0.0 && us > lat->max)
+		us = lat->max;
+	return us < 0.0 ? 0.0 : us;
+}
+
+void sysman_api_lock(const char *function)
+{
+	sysman_state_lock();
+	t_pending_delay_ns = 0;
+	for (uint32_t i = 0; i < g_sysman_state.latencies_count; i++) {
+		const sysman_latency_t *lat = &g_sysman_state.latencies[i];
+		if (strcmp(lat->function, function) == 0) {
+			t_pending_delay_ns = (uint64_t)(sample_latency_us(lat) * 1000.0);
+			break;
+		}
+	}
+}
+
+void sysman_api_delay(void)
+{
+	uint64_t ns = t_pending_delay_ns;
+	t_pending_delay_ns = 0;
+	if (!ns)
+		return;
+	struct timespec delay = {.tv_sec = (time_t)(ns / 1000000000ULL), .tv_nsec = (long)(ns % 1000000000ULL)};
+	struct timespec rem;
+	while (nanosleep(&delay, &rem) == -1 && errno == EINTR)
+		delay = rem;
+}
@@ -241,6 +241,7 @@ static void free_engine_groups(sysman_device_state_t *dev)
 	if (dev->engine_groups) {
 		for (uint32_t j = 0; j < dev->engine_groups_count; j++) {
 			free(dev->engine_groups[j].activity_ext);
+			free(dev->engine_groups[j].activity_model);
 			memset(&dev->engine_groups[j], 0, sizeof(dev->engine_groups[j]));
 		}
 		free(dev->engine_groups);
@@ -256,6 +257,8 @@ static void free_fabric_ports(sysman_device_state_t *dev)
 			free(dev->fabric_ports[j].config);
 			free(dev->fabric_ports[j].state);
 			free(dev->fabric_ports[j].throughput);
+			free(dev->fabric_ports[j].rx_model);
+			free(dev->fabric_ports[j].tx_model);
 			free(dev->fabric_ports[j].error_counters);
 			memset(&dev->fabric_ports[j], 0, sizeof(dev->fabric_ports[j]));
 		}
@@ -320,6 +323,8 @@ static void free_memory_modules(sysman_device_state_t *dev)
 			free(dev->memory_modules[j].properties);
 			free(dev->memory_modules[j].state);
 			free(dev->memory_modules[j].bandwidth);
+			free(dev->memory_modules[j].read_model);
+			free(dev->memory_modules[j].write_model);
 			memset(&dev->memory_modules[j], 0, sizeof(dev->memory_modules[j]));
 		}
 		free(dev->memory_modules);
@@ -382,6 +387,7 @@ static void free_power_domains(sysman_device_state_t *dev)
 		for (uint32_t j = 0; j < dev->power_domains_count; j++) {
 			free(dev->power_domains[j].properties);
 			free(dev->power_domains[j].energy_counter);
+			free(dev->power_domains[j].energy_model);
 			free(dev->power_domains[j].limits);
 			free(dev->power_domains[j].energy_threshold);
 			memset(&dev->power_domains[j], 0, sizeof(dev->power_domains[j]));
@@ -472,6 +478,8 @@ static void free_device(sysman_device_state_t *dev)
 	free(dev->pci.state);
 	free(dev->pci.bars);
 	free(dev->pci.stats);
+	free(dev->pci.rx_model);
+	free(dev->pci.tx_model);
 	free(dev->processes);
 	free(dev->unsupported_features);
 	free_ecc(dev);
@@ -512,6 +520,14 @@ static void free_system_state(sysman_system_state_t *sys)
 	memset(sys, 0, sizeof(*sys));
 }
 
+static void free_state(sysman_state_t *state)
+{
+	free_system_state(&state->system);
+	free(state->latencies);
+	state->latencies = NULL;
+	state->latencies_count = 0;
+}
+
 static const cyaml_config_t cyaml_cfg = {
 	.log_fn = cyaml_log,
 	.mem_fn = cyaml_mem,
@@ -567,6 +583,51 @@ static bool resolve_uuids(sysman_state_t *state)
 	return true;
 }
 
+static bool parse_distribution(const char *name, sysman_latency_kind_t *kind)
+{
+	static const struct {
+		const char *name;
+		sysman_latency_kind_t kind;
+	} distributions[] = {
+		{"", SYSMAN_LATENCY_FIXED},
+		{"fixed", SYSMAN_LATENCY_FIXED},
+		{"uniform", SYSMAN_LATENCY_UNIFORM},
+		{"normal", SYSMAN_LATENCY_NORMAL},
+		{"exponential", SYSMAN_LATENCY_EXPONENTIAL},
+	};
+	for (size_t i = 0; i < sizeof(distributions) / sizeof(distributions[0]); i++) {
+		if (strcmp(name, distributions[i].name) == 0) {
+			*kind = distributions[i].kind;
+			return true;
+		}
+	}
+	return false;
+}
+
+// Post-parse handler for Latencies: resolves each Distribution string and
+// rejects entries that could never produce a sensible delay.
+// Must be called on the freshly parsed tree before it is donated to g_sysman_state.
+static bool resolve_latencies(sysman_state_t *state)
+{
+	for (uint32_t i = 0; i < state->latencies_count; i++) {
+		sysman_latency_t *lat = &state->latencies[i];
+		if (lat->function[0] == '\0') {
+			fprintf(stderr, "stub: latency %u has no Function\n", i);
+			return false;
+		}
+		if (!parse_distribution(lat->distribution, &lat->kind)) {
+			fprintf(stderr, "stub: invalid Distribution '%s' for latency of %s\n", lat->distribution, lat->function);
+			return false;
+		}
+		bool negative = lat->mean < 0 || lat->std_dev < 0 || lat->min < 0 || lat->max < 0;
+		if (negative || (lat->max > 0 && lat->max < lat->min)) {
+			fprintf(stderr, "stub: invalid latency bounds for %s\n", lat->function);
+			return false;
+		}
+	}
+	return true;
+}
+
 // ------------------------------------------------------------------
 // Internal state management functions
 // ------------------------------------------------------------------
@@ -574,8 +635,9 @@ static bool resolve_uuids(sysman_state_t *state)
 // Must be called with g_state_lock held.
 static void sysman_state_reset_locked(void)
 {
-	free_system_state(&g_sysman_state.system);
+	free_state(&g_sysman_state);
 	memset(&g_sysman_state, 0, sizeof(g_sysman_state));
+	sysman_models_reset();
 }
 
 // Must be called with g_state_lock held.
@@ -601,8 +663,8 @@ static int sysman_state_load_locked(const char *path)
 		return -1;
 	}
 
-	if (!resolve_uuids(parsed)) {
-		free_system_state(&parsed->system);
+	if (!resolve_uuids(parsed) || !resolve_latencies(parsed)) {
+		free_state(parsed);
 		free(parsed);
 		return -1;
 	}
@@ -618,6 +680,9 @@ static int sysman_state_load_locked(const char *path)
 	g_sysman_state = *parsed;
 	free(parsed);
 
+	// Counter models measure time from here and the RNG restarts from Seed.
+	sysman_models_reset();
+
 	// Record the effective path for callers (e.g. the Go file watcher).
 	snprintf(g_config_path, sizeof(g_config_path), "%s", resolved);
 
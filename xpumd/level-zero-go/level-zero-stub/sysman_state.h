@@ -391,6 +391,48 @@ typedef enum
 	UNSUPPORTED_FEATURE_TEMP_GET_STATE,					  // gen: key=TemperatureSensor.GetState
 } sysman_unsupported_feature_t;							  // gen: enum
 
+// ------------------------------------------------------------------
+// Time-evolving counters and call latency
+// ------------------------------------------------------------------
+
+// Makes a counter advance with the monotonic clock instead of staying at its
+// configured value. The configured value is the reading at load time.
+// Increments are in the counter's own unit (µJ, µs, bytes) per second.
+typedef struct
+{
+	double rate;	// increment per second at load time
+	double ramp;	// change of rate per second
+	double noise;	// relative jitter of each increment, 0..1
+	uint64_t wrap;	// counter restarts at 0 when reaching this value; 0 = 64-bit wrap
+	uint64_t last_ns; // gen: ignore
+	double carry;	  // gen: ignore
+} sysman_counter_model_t;
+
+typedef enum
+{
+	SYSMAN_LATENCY_FIXED = 0,
+	SYSMAN_LATENCY_UNIFORM,
+	SYSMAN_LATENCY_NORMAL,
+	SYSMAN_LATENCY_EXPONENTIAL,
+} sysman_latency_kind_t;
+
+#define SYSMAN_FUNCTION_NAME_SIZE 64
+#define SYSMAN_DISTRIBUTION_NAME_SIZE 16
+
+// Delay added to every call of one API function, in microseconds.
+// Distribution is "fixed" (Mean), "uniform" (Min..Max), "normal" (Mean, StdDev)
+// or "exponential" (Mean); Min and Max also bound the other distributions.
+typedef struct
+{
+	char function[SYSMAN_FUNCTION_NAME_SIZE];
+	char distribution[SYSMAN_DISTRIBUTION_NAME_SIZE];
+	double mean;
+	double std_dev;
+	double min;
+	double max;
+	sysman_latency_kind_t kind; // gen: ignore
+} sysman_latency_t;
+
 // ------------------------------------------------------------------
 // Per-component entry types and group structs
 // ------------------------------------------------------------------
@@ -406,6 +448,7 @@ typedef struct
 	sysman_engine_rv_t return_values;
 	sysman_engine_properties_info_t properties;
 	zes_engine_stats_t activity;
+	sysman_counter_model_t *activity_model;
 	uint32_t activity_ext_count;
 	zes_engine_stats_t *activity_ext;
 } sysman_engine_t;
@@ -418,6 +461,8 @@ typedef struct
 	zes_fabric_port_config_t *config;
 	zes_fabric_port_state_t *state;
 	zes_fabric_port_throughput_t *throughput;
+	sysman_counter_model_t *rx_model;
+	sysman_counter_model_t *tx_model;
 	zes_fabric_port_error_counters_t *error_counters;
 } sysman_fabric_port_t;
 
@@ -461,6 +506,8 @@ typedef struct
 	zes_mem_properties_t *properties;
 	zes_mem_state_t *state;
 	zes_mem_bandwidth_t *bandwidth;
+	sysman_counter_model_t *read_model;
+	sysman_counter_model_t *write_model;
 } sysman_mem_t;
 
 typedef struct
@@ -508,6 +555,8 @@ typedef struct
 	uint32_t bars_count;
 	zes_pci_bar_properties_t *bars;
 	zes_pci_stats_t *stats;
+	sysman_counter_model_t *rx_model;
+	sysman_counter_model_t *tx_model;
 	zes_device_action_t pci_link_speed_update_pending_action;
 } sysman_pci_info_t;
 
@@ -569,6 +618,7 @@ typedef struct
 	sysman_power_rv_t return_values;
 	sysman_power_properties_info_t *properties;
 	zes_power_energy_counter_t *energy_counter;
+	sysman_counter_model_t *energy_model;
 	uint32_t limits_count;
 	zes_power_limit_ext_desc_t *limits;
 	zes_energy_threshold_t *energy_threshold;
@@ -659,6 +709,8 @@ typedef struct
 	sysman_unsupported_feature_t *unsupported_features;
 	sysman_device_properties_info_t *properties;
 	zes_device_state_t *state;
+	// Multiplies the rate and ramp of every counter model of the device; 0 = 1.
+	double scale;
 	sysman_pci_info_t pci;	// gen: key=PCI
 	sysman_ecc_info_t *ecc; // gen: key=ECC
 	sysman_overclock_info_t *overclock;
@@ -722,6 +774,11 @@ typedef struct
 {
 	sysman_system_state_t system; // gen: flatten
 	sysman_system_rv_t return_values;
+	uint32_t latencies_count;
+	sysman_latency_t *latencies;
+	uint64_t seed;		// seeds noise and latency sampling; 0 = fixed default
+	uint64_t loaded_ns; // gen: ignore
+	uint64_t rng;		// gen: ignore
 } sysman_state_t;
 
 extern sysman_state_t g_sysman_state;
@@ -731,4 +788,21 @@ extern sysman_state_t g_sysman_state;
 void sysman_state_lock(void);
 void sysman_state_unlock(void);
 
+// Entry/exit of an API function: sysman_api_lock() takes the state lock and
+// draws the configured latency of the function, sysman_api_delay() sleeps it
+// off once the lock is released so delayed calls do not serialise each other.
+void sysman_api_lock(const char *function);
+void sysman_api_delay(void);
+
+// Monotonic clock in nanoseconds, the time base of all counter models.
+uint64_t sysman_clock_ns(void);
+
+// Advance *counter by what model accumulated since its last call.
+// Must be called with the state lock held; model may be NULL.
+void sysman_counter_advance(sysman_counter_model_t *model, double scale, uint64_t *counter);
+
+// Seed the random generator and restart the model clock; called on every load.
+// Must be called with the state lock held.
+void sysman_models_reset(void);
+
 #endif // SYSMAN_STATE_H
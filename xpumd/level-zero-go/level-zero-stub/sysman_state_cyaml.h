@@ -428,6 +428,14 @@ static const cyaml_schema_field_t zes_pci_stats_fields[] = {
 static const cyaml_schema_value_t zes_pci_stats_schema = {
 	CYAML_VALUE_MAPPING(CYAML_FLAG_DEFAULT, zes_pci_stats_t, zes_pci_stats_fields)};
 
+static const cyaml_schema_field_t sysman_counter_model_fields[] = {
+	CYAML_FIELD_FLOAT("Rate", CYAML_FLAG_OPTIONAL, sysman_counter_model_t, rate),
+	CYAML_FIELD_FLOAT("Ramp", CYAML_FLAG_OPTIONAL, sysman_counter_model_t, ramp),
+	CYAML_FIELD_FLOAT("Noise", CYAML_FLAG_OPTIONAL, sysman_counter_model_t, noise),
+	CYAML_FIELD_UINT("Wrap", CYAML_FLAG_OPTIONAL, sysman_counter_model_t, wrap), CYAML_FIELD_END};
+static const cyaml_schema_value_t sysman_counter_model_schema = {
+	CYAML_VALUE_MAPPING(CYAML_FLAG_DEFAULT, sysman_counter_model_t, sysman_counter_model_fields)};
+
 static const cyaml_schema_field_t sysman_pci_info_fields[] = {
 	CYAML_FIELD_MAPPING_PTR("Properties", SYSMAN_NULLABLE_PTR_FLAGS, sysman_pci_info_t, properties,
 							sysman_pci_properties_info_fields),
@@ -435,6 +443,10 @@ static const cyaml_schema_field_t sysman_pci_info_fields[] = {
 	CYAML_FIELD_SEQUENCE_COUNT("Bars", SYSMAN_NULLABLE_PTR_FLAGS, sysman_pci_info_t, bars, bars_count,
 							   &zes_pci_bar_properties_schema, 0, CYAML_UNLIMITED),
 	CYAML_FIELD_MAPPING_PTR("Stats", SYSMAN_NULLABLE_PTR_FLAGS, sysman_pci_info_t, stats, zes_pci_stats_fields),
+	CYAML_FIELD_MAPPING_PTR("RxModel", SYSMAN_NULLABLE_PTR_FLAGS, sysman_pci_info_t, rx_model,
+							sysman_counter_model_fields),
+	CYAML_FIELD_MAPPING_PTR("TxModel", SYSMAN_NULLABLE_PTR_FLAGS, sysman_pci_info_t, tx_model,
+							sysman_counter_model_fields),
 	CYAML_FIELD_UINT("PciLinkSpeedUpdatePendingAction", CYAML_FLAG_OPTIONAL, sysman_pci_info_t,
 					 pci_link_speed_update_pending_action),
 	CYAML_FIELD_END};
@@ -584,6 +596,8 @@ static const cyaml_schema_field_t sysman_engine_fields[] = {
 	CYAML_FIELD_MAPPING("Properties", CYAML_FLAG_OPTIONAL, sysman_engine_t, properties,
 						sysman_engine_properties_info_fields),
 	CYAML_FIELD_MAPPING("Activity", CYAML_FLAG_OPTIONAL, sysman_engine_t, activity, zes_engine_stats_fields),
+	CYAML_FIELD_MAPPING_PTR("ActivityModel", SYSMAN_NULLABLE_PTR_FLAGS, sysman_engine_t, activity_model,
+							sysman_counter_model_fields),
 	CYAML_FIELD_SEQUENCE_COUNT("ActivityExt", SYSMAN_NULLABLE_PTR_FLAGS, sysman_engine_t, activity_ext,
 							   activity_ext_count, &zes_engine_stats_schema, 0, CYAML_UNLIMITED),
 	CYAML_FIELD_END};
@@ -668,6 +682,10 @@ static const cyaml_schema_field_t sysman_fabric_port_fields[] = {
 							zes_fabric_port_state_fields),
 	CYAML_FIELD_MAPPING_PTR("Throughput", SYSMAN_NULLABLE_PTR_FLAGS, sysman_fabric_port_t, throughput,
 							zes_fabric_port_throughput_fields),
+	CYAML_FIELD_MAPPING_PTR("RxModel", SYSMAN_NULLABLE_PTR_FLAGS, sysman_fabric_port_t, rx_model,
+							sysman_counter_model_fields),
+	CYAML_FIELD_MAPPING_PTR("TxModel", SYSMAN_NULLABLE_PTR_FLAGS, sysman_fabric_port_t, tx_model,
+							sysman_counter_model_fields),
 	CYAML_FIELD_MAPPING_PTR("ErrorCounters", SYSMAN_NULLABLE_PTR_FLAGS, sysman_fabric_port_t, error_counters,
 							zes_fabric_port_error_counters_fields),
 	CYAML_FIELD_END};
@@ -862,6 +880,10 @@ static const cyaml_schema_field_t sysman_mem_fields[] = {
 							zes_mem_properties_fields),
 	CYAML_FIELD_MAPPING_PTR("State", SYSMAN_NULLABLE_PTR_FLAGS, sysman_mem_t, state, zes_mem_state_fields),
 	CYAML_FIELD_MAPPING_PTR("Bandwidth", SYSMAN_NULLABLE_PTR_FLAGS, sysman_mem_t, bandwidth, zes_mem_bandwidth_fields),
+	CYAML_FIELD_MAPPING_PTR("ReadModel", SYSMAN_NULLABLE_PTR_FLAGS, sysman_mem_t, read_model,
+							sysman_counter_model_fields),
+	CYAML_FIELD_MAPPING_PTR("WriteModel", SYSMAN_NULLABLE_PTR_FLAGS, sysman_mem_t, write_model,
+							sysman_counter_model_fields),
 	CYAML_FIELD_END};
 static const cyaml_schema_value_t sysman_mem_schema = {
 	CYAML_VALUE_MAPPING(CYAML_FLAG_DEFAULT, sysman_mem_t, sysman_mem_fields)};
@@ -937,6 +959,8 @@ static const cyaml_schema_field_t sysman_power_fields[] = {
 							sysman_power_properties_info_fields),
 	CYAML_FIELD_MAPPING_PTR("EnergyCounter", SYSMAN_NULLABLE_PTR_FLAGS, sysman_power_t, energy_counter,
 							zes_power_energy_counter_fields),
+	CYAML_FIELD_MAPPING_PTR("EnergyModel", SYSMAN_NULLABLE_PTR_FLAGS, sysman_power_t, energy_model,
+							sysman_counter_model_fields),
 	CYAML_FIELD_SEQUENCE_COUNT("Limits", SYSMAN_NULLABLE_PTR_FLAGS, sysman_power_t, limits, limits_count,
 							   &zes_power_limit_ext_desc_schema, 0, CYAML_UNLIMITED),
 	CYAML_FIELD_MAPPING_PTR("EnergyThreshold", SYSMAN_NULLABLE_PTR_FLAGS, sysman_power_t, energy_threshold,
@@ -1132,6 +1156,7 @@ static const cyaml_schema_field_t sysman_device_state_fields[] = {
 	CYAML_FIELD_MAPPING_PTR("Properties", SYSMAN_NULLABLE_PTR_FLAGS, sysman_device_state_t, properties,
 							sysman_device_properties_info_fields),
 	CYAML_FIELD_MAPPING_PTR("State", SYSMAN_NULLABLE_PTR_FLAGS, sysman_device_state_t, state, zes_device_state_fields),
+	CYAML_FIELD_FLOAT("Scale", CYAML_FLAG_OPTIONAL, sysman_device_state_t, scale),
 	CYAML_FIELD_MAPPING("PCI", CYAML_FLAG_OPTIONAL, sysman_device_state_t, pci, sysman_pci_info_fields),
 	CYAML_FIELD_MAPPING_PTR("ECC", SYSMAN_NULLABLE_PTR_FLAGS, sysman_device_state_t, ecc, sysman_ecc_info_fields),
 	CYAML_FIELD_MAPPING_PTR("Overclock", SYSMAN_NULLABLE_PTR_FLAGS, sysman_device_state_t, overclock,
@@ -1188,6 +1213,16 @@ static const cyaml_schema_field_t sysman_drivers_state_fields[] = {
 static const cyaml_schema_value_t sysman_drivers_state_schema = {
 	CYAML_VALUE_MAPPING(CYAML_FLAG_DEFAULT, sysman_drivers_state_t, sysman_drivers_state_fields)};
 
+static const cyaml_schema_field_t sysman_latency_fields[] = {
+	CYAML_FIELD_STRING("Function", CYAML_FLAG_OPTIONAL, sysman_latency_t, function, 0),
+	CYAML_FIELD_STRING("Distribution", CYAML_FLAG_OPTIONAL, sysman_latency_t, distribution, 0),
+	CYAML_FIELD_FLOAT("Mean", CYAML_FLAG_OPTIONAL, sysman_latency_t, mean),
+	CYAML_FIELD_FLOAT("StdDev", CYAML_FLAG_OPTIONAL, sysman_latency_t, std_dev),
+	CYAML_FIELD_FLOAT("Min", CYAML_FLAG_OPTIONAL, sysman_latency_t, min),
+	CYAML_FIELD_FLOAT("Max", CYAML_FLAG_OPTIONAL, sysman_latency_t, max), CYAML_FIELD_END};
+static const cyaml_schema_value_t sysman_latency_schema = {
+	CYAML_VALUE_MAPPING(CYAML_FLAG_DEFAULT, sysman_latency_t, sysman_latency_fields)};
+
 static const cyaml_schema_field_t sysman_state_fields[] = {
 	{.key = "Drivers",
 	 .value = {.type = CYAML_SEQUENCE,
@@ -1198,6 +1233,9 @@ static const cyaml_schema_field_t sysman_state_fields[] = {
 	 .count_offset = offsetof(sysman_state_t, system.drivers_count),
 	 .count_size = sizeof(uint32_t)},
 	CYAML_FIELD_MAPPING("ReturnValues", CYAML_FLAG_OPTIONAL, sysman_state_t, return_values, sysman_system_rv_fields),
+	CYAML_FIELD_SEQUENCE_COUNT("Latencies", SYSMAN_NULLABLE_PTR_FLAGS, sysman_state_t, latencies, latencies_count,
+							   &sysman_latency_schema, 0, CYAML_UNLIMITED),
+	CYAML_FIELD_UINT("Seed", CYAML_FLAG_OPTIONAL, sysman_state_t, seed),
 	CYAML_FIELD_END};
 static const cyaml_schema_value_t sysman_state_schema = {
 	CYAML_VALUE_MAPPING(CYAML_FLAG_POINTER, sysman_state_t, sysman_state_fields)};
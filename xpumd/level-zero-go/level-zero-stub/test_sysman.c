@@ -48,6 +48,8 @@ static int g_fail = 0;
 #define YAML_ALL_COMPONENTS "testdata/all_components.yaml"
 #define YAML_INVALID_UUID "testdata/invalid_uuid.yaml"
 #define YAML_UNSUPPORTED_FEATURES "testdata/unsupported_features.yaml"
+#define YAML_COUNTER_MODELS "testdata/counter_models.yaml"
+#define YAML_INVALID_LATENCY "testdata/invalid_latency.yaml"
 
 // ------------------------------------------------------------------
 // Test cases
@@ -1210,6 +1212,130 @@ static void test_unsupported_features(void)
 	sysman_state_reset();
 }
 
+// ------------------------------------------------------------------
+// Counter models and latency injection
+// ------------------------------------------------------------------
+
+static uint64_t now_us(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+}
+
+static void sleep_ms(long ms)
+{
+	struct timespec ts = {.tv_sec = ms / 1000, .tv_nsec = (ms % 1000) * 1000000L};
+	nanosleep(&ts, NULL);
+}
+
+// Change of the engine's activeTime per microsecond of timestamp over ~50 ms.
+static double engine_busy_ratio(zes_engine_handle_t eng)
+{
+	zes_engine_stats_t s1 = {0}, s2 = {0};
+	zesEngineGetActivity(eng, &s1);
+	sleep_ms(50);
+	zesEngineGetActivity(eng, &s2);
+	if (s2.timestamp <= s1.timestamp)
+		return 0;
+	return (double)(s2.activeTime - s1.activeTime) / (double)(s2.timestamp - s1.timestamp);
+}
+
+static void test_counter_models(void)
+{
+	printf("test_counter_models\n");
+
+	sysman_state_reset();
+	ASSERT("load counter_models.yaml", sysman_state_load(YAML_COUNTER_MODELS) == 0);
+
+	uint32_t drv_n = 1;
+	ze_driver_handle_t drv = NULL;
+	zesDriverGet(&drv_n, &drv);
+	uint32_t dev_n = 2;
+	zes_device_handle_t devs[2] = {NULL, NULL};
+	zesDeviceGet(drv, &dev_n, devs);
+	ASSERT("two devices", dev_n == 2);
+
+	uint32_t n = 1;
+	zes_engine_handle_t eng0 = NULL, eng1 = NULL;
+	zesDeviceEnumEngineGroups(devs[0], &n, &eng0);
+	n = 1;
+	zesDeviceEnumEngineGroups(devs[1], &n, &eng1);
+
+	// Rate 1000000 us/s: the engine is busy all the time, twice that with Scale 2.
+	double busy0 = engine_busy_ratio(eng0);
+	ASSERT("activity advances at Rate", busy0 > 0.8 && busy0 < 1.2);
+	double busy1 = engine_busy_ratio(eng1);
+	ASSERT("activity advances at Rate * Scale", busy1 > 1.6 && busy1 < 2.4);
+
+	// Wrap keeps the energy counter below 1000 however fast it runs.
+	n = 1;
+	zes_pwr_handle_t pwr = NULL;
+	zesDeviceEnumPowerDomains(devs[0], &n, &pwr);
+	bool wrapped = true;
+	for (int i = 0; i < 5; i++) {
+		zes_power_energy_counter_t e = {0};
+		ASSERT_ZE_OK("zesPowerGetEnergyCounter", zesPowerGetEnergyCounter(pwr, &e));
+		wrapped = wrapped && e.energy < 1000;
+		sleep_ms(1);
+	}
+	ASSERT("energy counter wraps at Wrap", wrapped);
+
+	// Noise perturbs the increments but never makes a counter run backwards.
+	zes_pci_stats_t prev = {0};
+	ASSERT_ZE_OK("zesDevicePciGetStats", zesDevicePciGetStats(devs[0], &prev));
+	bool monotonic = true;
+	for (int i = 0; i < 10; i++) {
+		sleep_ms(1);
+		zes_pci_stats_t cur = {0};
+		zesDevicePciGetStats(devs[0], &cur);
+		monotonic = monotonic && cur.rxCounter > prev.rxCounter && cur.txCounter >= prev.txCounter &&
+					cur.timestamp > prev.timestamp;
+		prev = cur;
+	}
+	ASSERT("PCI counters are monotonic", monotonic);
+
+	// Reloading restarts the models from the values in the file.
+	sysman_state_reset();
+	ASSERT("reload counter_models.yaml", sysman_state_load(YAML_COUNTER_MODELS) == 0);
+	zes_engine_stats_t s = {0};
+	zesEngineGetActivity(eng0, &s);
+	ASSERT("activity restarts after reload", s.activeTime < 1000000);
+
+	sysman_state_reset();
+}
+
+static void test_latency_injection(void)
+{
+	printf("test_latency_injection\n");
+
+	sysman_state_reset();
+	ASSERT("load counter_models.yaml", sysman_state_load(YAML_COUNTER_MODELS) == 0);
+
+	uint32_t drv_n = 1;
+	ze_driver_handle_t drv = NULL;
+	zesDriverGet(&drv_n, &drv);
+	uint32_t dev_n = 1;
+	zes_device_handle_t dev = NULL;
+	zesDeviceGet(drv, &dev_n, &dev);
+
+	// Mean 20000 us with the fixed distribution.
+	zes_device_properties_t props = {.stype = ZES_STRUCTURE_TYPE_DEVICE_PROPERTIES};
+	uint64_t start = now_us();
+	ASSERT_ZE_OK("zesDeviceGetProperties", zesDeviceGetProperties(dev, &props));
+	ASSERT("configured function is delayed", now_us() - start >= 20000);
+
+	sysman_state_reset();
+}
+
+static void test_latency_invalid_load(void)
+{
+	printf("test_latency_invalid_load\n");
+
+	sysman_state_reset();
+	ASSERT("sysman_state_load fails on unknown Distribution", sysman_state_load(YAML_INVALID_LATENCY) != 0);
+}
+
 // ------------------------------------------------------------------
 // Main
 // ------------------------------------------------------------------
@@ -1232,6 +1358,9 @@ int main(void)
 	test_uuid();
 	test_uuid_invalid_load();
 	test_unsupported_features();
+	test_counter_models();
+	test_latency_injection();
+	test_latency_invalid_load();
 
 	printf("\n%d passed, %d failed\n", g_pass, g_fail);
 	return g_fail ? 1 : 0;
@@ -24,9 +24,12 @@ static size_t sysman_strnlen(const char *s, size_t maxlen)
 // Internal helpers
 // ------------------------------------------------------------------
 
+// Every API function enters through sysman_api_lock() and leaves through here,
+// so any latency configured for it is slept off without holding the lock.
 static ze_result_t sysman_unlock_and_return(ze_result_t result)
 {
 	sysman_state_unlock();
+	sysman_api_delay();
 	return result;
 }
 
@@ -154,13 +157,40 @@ static bool is_unsupported(const void *zes_handle, sysman_unsupported_feature_t
 	return false;
 }
 
+// Scale of the device a device or component handle belongs to.
+static double device_scale(const void *zes_handle)
+{
+	stub_handle_t handle = decode_handle(zes_handle);
+	sysman_system_state_t *system = &g_sysman_state.system;
+	if (handle.bits.drv >= system->drivers_count)
+		return 1.0;
+	sysman_drivers_state_t *drv = &system->drivers[handle.bits.drv];
+	if (handle.bits.dev >= drv->devices_count)
+		return 1.0;
+	double scale = drv->devices[handle.bits.dev].scale;
+	return scale > 0.0 ? scale : 1.0;
+}
+
+// Timestamp in microseconds for samples produced by counter models.
+static uint64_t model_timestamp(void) { return sysman_clock_ns() / 1000; }
+
+static void advance_fabric_port(const void *zes_handle, sysman_fabric_port_t *fp)
+{
+	if (!fp->rx_model && !fp->tx_model)
+		return;
+	double scale = device_scale(zes_handle);
+	sysman_counter_advance(fp->rx_model, scale, &fp->throughput->rxCounter);
+	sysman_counter_advance(fp->tx_model, scale, &fp->throughput->txCounter);
+	fp->throughput->timestamp = model_timestamp();
+}
+
 // ------------------------------------------------------------------
 // Initialisation
 // ------------------------------------------------------------------
 
 ze_result_t zesInit(zes_init_flags_t flags)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	(void)flags;
 	if (g_sysman_state.return_values.zesInit)
 		return sysman_unlock_and_return(g_sysman_state.return_values.zesInit);
@@ -173,7 +203,7 @@ ze_result_t zesInit(zes_init_flags_t flags)
 
 ze_result_t zesDriverGet(uint32_t *pCount, zes_driver_handle_t *phDrivers)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	if (g_sysman_state.return_values.zesDriverGet)
 		return sysman_unlock_and_return(g_sysman_state.return_values.zesDriverGet);
 	uint32_t n = g_sysman_state.system.drivers_count;
@@ -193,7 +223,7 @@ ze_result_t zesDriverGet(uint32_t *pCount, zes_driver_handle_t *phDrivers)
 ze_result_t zesDriverGetExtensionProperties(zes_driver_handle_t hDriver, uint32_t *pCount,
 											zes_driver_extension_properties_t *pExtensionProperties)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_drivers_state_t *drv = (sysman_drivers_state_t *)resolve_handle(hDriver, STUB_HANDLE_DRIVER);
 	if (!drv)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -217,7 +247,7 @@ ze_result_t zesDriverGetExtensionProperties(zes_driver_handle_t hDriver, uint32_
 
 ze_result_t zesDeviceGet(zes_driver_handle_t hDriver, uint32_t *pCount, zes_device_handle_t *phDevices)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_drivers_state_t *drv = (sysman_drivers_state_t *)resolve_handle(hDriver, STUB_HANDLE_DRIVER);
 	if (!drv)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -246,7 +276,7 @@ ze_result_t zesDeviceGet(zes_driver_handle_t hDriver, uint32_t *pCount, zes_devi
 
 ze_result_t zesDeviceGetProperties(zes_device_handle_t hDevice, zes_device_properties_t *pProperties)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_device_state_t *dev = (sysman_device_state_t *)resolve_handle(hDevice, STUB_HANDLE_DEVICE);
 	if (!dev)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -277,7 +307,7 @@ ze_result_t zesDeviceGetProperties(zes_device_handle_t hDevice, zes_device_prope
 
 ze_result_t zesDeviceGetState(zes_device_handle_t hDevice, zes_device_state_t *pState)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_device_state_t *dev = (sysman_device_state_t *)resolve_handle(hDevice, STUB_HANDLE_DEVICE);
 	if (!dev)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -299,7 +329,7 @@ ze_result_t zesDeviceGetState(zes_device_handle_t hDevice, zes_device_state_t *p
 
 ze_result_t zesDeviceReset(zes_device_handle_t hDevice, ze_bool_t force)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	(void)force;
 	sysman_device_state_t *dev = (sysman_device_state_t *)resolve_handle(hDevice, STUB_HANDLE_DEVICE);
 	if (!dev)
@@ -313,7 +343,7 @@ ze_result_t zesDeviceReset(zes_device_handle_t hDevice, ze_bool_t force)
 
 ze_result_t zesDeviceResetExt(zes_device_handle_t hDevice, zes_reset_properties_t *pProperties)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	(void)pProperties;
 	sysman_device_state_t *dev = (sysman_device_state_t *)resolve_handle(hDevice, STUB_HANDLE_DEVICE);
 	if (!dev)
@@ -331,7 +361,7 @@ ze_result_t zesDeviceResetExt(zes_device_handle_t hDevice, zes_reset_properties_
 
 ze_result_t zesDeviceProcessesGetState(zes_device_handle_t hDevice, uint32_t *pCount, zes_process_state_t *pProcesses)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_device_state_t *dev = (sysman_device_state_t *)resolve_handle(hDevice, STUB_HANDLE_DEVICE);
 	if (!dev)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -363,7 +393,7 @@ ze_result_t zesDeviceProcessesGetState(zes_device_handle_t hDevice, uint32_t *pC
 
 ze_result_t zesDevicePciGetProperties(zes_device_handle_t hDevice, zes_pci_properties_t *pProperties)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_device_state_t *dev = (sysman_device_state_t *)resolve_handle(hDevice, STUB_HANDLE_DEVICE);
 	if (!dev)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -395,7 +425,7 @@ ze_result_t zesDevicePciGetProperties(zes_device_handle_t hDevice, zes_pci_prope
 
 ze_result_t zesDevicePciGetState(zes_device_handle_t hDevice, zes_pci_state_t *pState)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_device_state_t *dev = (sysman_device_state_t *)resolve_handle(hDevice, STUB_HANDLE_DEVICE);
 	if (!dev)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -427,7 +457,7 @@ ze_result_t zesDevicePciGetState(zes_device_handle_t hDevice, zes_pci_state_t *p
 
 ze_result_t zesDevicePciGetBars(zes_device_handle_t hDevice, uint32_t *pCount, zes_pci_bar_properties_t *pProperties)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_device_state_t *dev = (sysman_device_state_t *)resolve_handle(hDevice, STUB_HANDLE_DEVICE);
 	if (!dev)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -451,7 +481,7 @@ ze_result_t zesDevicePciGetBars(zes_device_handle_t hDevice, uint32_t *pCount, z
 
 ze_result_t zesDevicePciGetStats(zes_device_handle_t hDevice, zes_pci_stats_t *pStats)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_device_state_t *dev = (sysman_device_state_t *)resolve_handle(hDevice, STUB_HANDLE_DEVICE);
 	if (!dev)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -463,6 +493,12 @@ ze_result_t zesDevicePciGetStats(zes_device_handle_t hDevice, zes_pci_stats_t *p
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_POINTER);
 	if (!(dev->pci.stats))
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_UNSUPPORTED_FEATURE);
+	if (dev->pci.rx_model || dev->pci.tx_model) {
+		double scale = device_scale(hDevice);
+		sysman_counter_advance(dev->pci.rx_model, scale, &dev->pci.stats->rxCounter);
+		sysman_counter_advance(dev->pci.tx_model, scale, &dev->pci.stats->txCounter);
+		dev->pci.stats->timestamp = model_timestamp();
+	}
 	*pStats = *dev->pci.stats;
 	return sysman_unlock_and_return(ZE_RESULT_SUCCESS);
 }
@@ -470,7 +506,7 @@ ze_result_t zesDevicePciGetStats(zes_device_handle_t hDevice, zes_pci_stats_t *p
 ze_result_t zesDevicePciLinkSpeedUpdateExt(zes_device_handle_t hDevice, ze_bool_t shouldDowngrade,
 										   zes_device_action_t *pendingAction)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	(void)shouldDowngrade;
 	sysman_device_state_t *dev = (sysman_device_state_t *)resolve_handle(hDevice, STUB_HANDLE_DEVICE);
 	if (!dev)
@@ -489,7 +525,7 @@ ze_result_t zesDevicePciLinkSpeedUpdateExt(zes_device_handle_t hDevice, ze_bool_
 
 ze_result_t zesDeviceSetOverclockWaiver(zes_device_handle_t hDevice)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_device_state_t *dev = (sysman_device_state_t *)resolve_handle(hDevice, STUB_HANDLE_DEVICE);
 	if (!dev)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -502,7 +538,7 @@ ze_result_t zesDeviceSetOverclockWaiver(zes_device_handle_t hDevice)
 
 ze_result_t zesDeviceGetOverclockDomains(zes_device_handle_t hDevice, uint32_t *pOverclockDomains)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_device_state_t *dev = (sysman_device_state_t *)resolve_handle(hDevice, STUB_HANDLE_DEVICE);
 	if (!dev)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -521,7 +557,7 @@ ze_result_t zesDeviceGetOverclockDomains(zes_device_handle_t hDevice, uint32_t *
 ze_result_t zesDeviceGetOverclockControls(zes_device_handle_t hDevice, zes_overclock_domain_t domainType,
 										  uint32_t *pAvailableControls)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_device_state_t *dev = (sysman_device_state_t *)resolve_handle(hDevice, STUB_HANDLE_DEVICE);
 	if (!dev)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -543,7 +579,7 @@ ze_result_t zesDeviceGetOverclockControls(zes_device_handle_t hDevice, zes_overc
 
 ze_result_t zesDeviceResetOverclockSettings(zes_device_handle_t hDevice, ze_bool_t onShippedState)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	(void)onShippedState;
 	sysman_device_state_t *dev = (sysman_device_state_t *)resolve_handle(hDevice, STUB_HANDLE_DEVICE);
 	if (!dev)
@@ -559,7 +595,7 @@ ze_result_t zesDeviceReadOverclockState(zes_device_handle_t hDevice, zes_overclo
 										ze_bool_t *pWaiverSetting, ze_bool_t *pOverclockState,
 										zes_pending_action_t *pPendingAction, ze_bool_t *pPendingReset)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_device_state_t *dev = (sysman_device_state_t *)resolve_handle(hDevice, STUB_HANDLE_DEVICE);
 	if (!dev)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -582,7 +618,7 @@ ze_result_t zesDeviceReadOverclockState(zes_device_handle_t hDevice, zes_overclo
 ze_result_t zesDeviceEnumOverclockDomains(zes_device_handle_t hDevice, uint32_t *pCount,
 										  zes_overclock_handle_t *phDomainHandle)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_device_state_t *dev = (sysman_device_state_t *)resolve_handle(hDevice, STUB_HANDLE_DEVICE);
 	if (!dev)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -626,7 +662,7 @@ static sysman_oc_control_info_t *find_control_info(sysman_oc_t *oc, zes_overcloc
 ze_result_t zesOverclockGetDomainProperties(zes_overclock_handle_t hDomainHandle,
 											zes_overclock_properties_t *pDomainProperties)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_oc_t *oc = (sysman_oc_t *)resolve_handle(hDomainHandle, STUB_HANDLE_OC);
 	if (!oc)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -648,7 +684,7 @@ ze_result_t zesOverclockGetDomainProperties(zes_overclock_handle_t hDomainHandle
 
 ze_result_t zesOverclockGetDomainVFProperties(zes_overclock_handle_t hDomainHandle, zes_vf_property_t *pVFProperties)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_oc_t *oc = (sysman_oc_t *)resolve_handle(hDomainHandle, STUB_HANDLE_OC);
 	if (!oc)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -668,7 +704,7 @@ ze_result_t zesOverclockGetDomainControlProperties(zes_overclock_handle_t hDomai
 												   zes_overclock_control_t DomainControl,
 												   zes_control_property_t *pControlProperties)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_oc_t *oc = (sysman_oc_t *)resolve_handle(hDomainHandle, STUB_HANDLE_OC);
 	if (!oc)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -688,7 +724,7 @@ ze_result_t zesOverclockGetDomainControlProperties(zes_overclock_handle_t hDomai
 ze_result_t zesOverclockGetControlCurrentValue(zes_overclock_handle_t hDomainHandle,
 											   zes_overclock_control_t DomainControl, double *pValue)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_oc_t *oc = (sysman_oc_t *)resolve_handle(hDomainHandle, STUB_HANDLE_OC);
 	if (!oc)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -708,7 +744,7 @@ ze_result_t zesOverclockGetControlCurrentValue(zes_overclock_handle_t hDomainHan
 ze_result_t zesOverclockGetControlPendingValue(zes_overclock_handle_t hDomainHandle,
 											   zes_overclock_control_t DomainControl, double *pValue)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_oc_t *oc = (sysman_oc_t *)resolve_handle(hDomainHandle, STUB_HANDLE_OC);
 	if (!oc)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -728,7 +764,7 @@ ze_result_t zesOverclockGetControlPendingValue(zes_overclock_handle_t hDomainHan
 ze_result_t zesOverclockSetControlUserValue(zes_overclock_handle_t hDomainHandle, zes_overclock_control_t DomainControl,
 											double pValue, zes_pending_action_t *pPendingAction)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	(void)DomainControl;
 	(void)pValue;
 	(void)pPendingAction;
@@ -745,7 +781,7 @@ ze_result_t zesOverclockSetControlUserValue(zes_overclock_handle_t hDomainHandle
 ze_result_t zesOverclockGetControlState(zes_overclock_handle_t hDomainHandle, zes_overclock_control_t DomainControl,
 										zes_control_state_t *pControlState, zes_pending_action_t *pPendingAction)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_oc_t *oc = (sysman_oc_t *)resolve_handle(hDomainHandle, STUB_HANDLE_OC);
 	if (!oc)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -766,7 +802,7 @@ ze_result_t zesOverclockGetControlState(zes_overclock_handle_t hDomainHandle, ze
 ze_result_t zesOverclockGetVFPointValues(zes_overclock_handle_t hDomainHandle, zes_vf_type_t VFType,
 										 zes_vf_array_type_t VFArrayType, uint32_t PointIndex, uint32_t *PointValue)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	(void)VFType;
 	(void)VFArrayType;
 	(void)PointIndex;
@@ -785,7 +821,7 @@ ze_result_t zesOverclockGetVFPointValues(zes_overclock_handle_t hDomainHandle, z
 ze_result_t zesOverclockSetVFPointValues(zes_overclock_handle_t hDomainHandle, zes_vf_type_t VFType,
 										 uint32_t PointIndex, uint32_t PointValue)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	(void)VFType;
 	(void)PointIndex;
 	(void)PointValue;
@@ -806,7 +842,7 @@ ze_result_t zesOverclockSetVFPointValues(zes_overclock_handle_t hDomainHandle, z
 ze_result_t zesDeviceEnumDiagnosticTestSuites(zes_device_handle_t hDevice, uint32_t *pCount,
 											  zes_diag_handle_t *phDiagnostics)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_device_state_t *dev = (sysman_device_state_t *)resolve_handle(hDevice, STUB_HANDLE_DEVICE);
 	if (!dev)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -832,7 +868,7 @@ ze_result_t zesDeviceEnumDiagnosticTestSuites(zes_device_handle_t hDevice, uint3
 
 ze_result_t zesDiagnosticsGetProperties(zes_diag_handle_t hDiagnostics, zes_diag_properties_t *pProperties)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_diag_t *dg = (sysman_diag_t *)resolve_handle(hDiagnostics, STUB_HANDLE_DIAG);
 	if (!dg)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -854,7 +890,7 @@ ze_result_t zesDiagnosticsGetProperties(zes_diag_handle_t hDiagnostics, zes_diag
 
 ze_result_t zesDiagnosticsGetTests(zes_diag_handle_t hDiagnostics, uint32_t *pCount, zes_diag_test_t *pTests)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_diag_t *dg = (sysman_diag_t *)resolve_handle(hDiagnostics, STUB_HANDLE_DIAG);
 	if (!dg)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -879,7 +915,7 @@ ze_result_t zesDiagnosticsGetTests(zes_diag_handle_t hDiagnostics, uint32_t *pCo
 ze_result_t zesDiagnosticsRunTests(zes_diag_handle_t hDiagnostics, uint32_t startIndex, uint32_t endIndex,
 								   zes_diag_result_t *pResult)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	(void)startIndex;
 	(void)endIndex;
 	sysman_diag_t *dg = (sysman_diag_t *)resolve_handle(hDiagnostics, STUB_HANDLE_DIAG);
@@ -901,7 +937,7 @@ ze_result_t zesDiagnosticsRunTests(zes_diag_handle_t hDiagnostics, uint32_t star
 
 ze_result_t zesDeviceEccAvailable(zes_device_handle_t hDevice, ze_bool_t *pAvailable)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_device_state_t *dev = (sysman_device_state_t *)resolve_handle(hDevice, STUB_HANDLE_DEVICE);
 	if (!dev)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -919,7 +955,7 @@ ze_result_t zesDeviceEccAvailable(zes_device_handle_t hDevice, ze_bool_t *pAvail
 
 ze_result_t zesDeviceEccConfigurable(zes_device_handle_t hDevice, ze_bool_t *pConfigurable)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_device_state_t *dev = (sysman_device_state_t *)resolve_handle(hDevice, STUB_HANDLE_DEVICE);
 	if (!dev)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -937,7 +973,7 @@ ze_result_t zesDeviceEccConfigurable(zes_device_handle_t hDevice, ze_bool_t *pCo
 
 ze_result_t zesDeviceGetEccState(zes_device_handle_t hDevice, zes_device_ecc_properties_t *pState)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_device_state_t *dev = (sysman_device_state_t *)resolve_handle(hDevice, STUB_HANDLE_DEVICE);
 	if (!dev)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -969,7 +1005,7 @@ ze_result_t zesDeviceGetEccState(zes_device_handle_t hDevice, zes_device_ecc_pro
 ze_result_t zesDeviceSetEccState(zes_device_handle_t hDevice, const zes_device_ecc_desc_t *newState,
 								 zes_device_ecc_properties_t *pState)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	(void)newState;
 	sysman_device_state_t *dev = (sysman_device_state_t *)resolve_handle(hDevice, STUB_HANDLE_DEVICE);
 	if (!dev)
@@ -996,7 +1032,7 @@ ze_result_t zesDeviceSetEccState(zes_device_handle_t hDevice, const zes_device_e
 
 ze_result_t zesDeviceEnumEngineGroups(zes_device_handle_t hDevice, uint32_t *pCount, zes_engine_handle_t *phEngine)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_device_state_t *dev = (sysman_device_state_t *)resolve_handle(hDevice, STUB_HANDLE_DEVICE);
 	if (!dev)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -1022,7 +1058,7 @@ ze_result_t zesDeviceEnumEngineGroups(zes_device_handle_t hDevice, uint32_t *pCo
 
 ze_result_t zesEngineGetProperties(zes_engine_handle_t hEngine, zes_engine_properties_t *pProperties)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_engine_t *eng = (sysman_engine_t *)resolve_handle(hEngine, STUB_HANDLE_ENGINE);
 	if (!eng)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -1051,7 +1087,7 @@ ze_result_t zesEngineGetProperties(zes_engine_handle_t hEngine, zes_engine_prope
 
 ze_result_t zesEngineGetActivity(zes_engine_handle_t hEngine, zes_engine_stats_t *pStats)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_engine_t *eng = (sysman_engine_t *)resolve_handle(hEngine, STUB_HANDLE_ENGINE);
 	if (!eng)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -1061,13 +1097,17 @@ ze_result_t zesEngineGetActivity(zes_engine_handle_t hEngine, zes_engine_stats_t
 		return sysman_unlock_and_return(eng->return_values.zesEngineGetActivity);
 	if (!pStats)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_POINTER);
+	if (eng->activity_model) {
+		sysman_counter_advance(eng->activity_model, device_scale(hEngine), &eng->activity.activeTime);
+		eng->activity.timestamp = model_timestamp();
+	}
 	*pStats = eng->activity;
 	return sysman_unlock_and_return(ZE_RESULT_SUCCESS);
 }
 
 ze_result_t zesEngineGetActivityExt(zes_engine_handle_t hEngine, uint32_t *pCount, zes_engine_stats_t *pStats)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_engine_t *eng = (sysman_engine_t *)resolve_handle(hEngine, STUB_HANDLE_ENGINE);
 	if (!eng)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -1095,7 +1135,7 @@ ze_result_t zesEngineGetActivityExt(zes_engine_handle_t hEngine, uint32_t *pCoun
 
 ze_result_t zesDeviceEventRegister(zes_device_handle_t hDevice, zes_event_type_flags_t events)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	(void)events;
 	sysman_device_state_t *dev = (sysman_device_state_t *)resolve_handle(hDevice, STUB_HANDLE_DEVICE);
 	if (!dev)
@@ -1187,7 +1227,7 @@ ze_result_t zesDriverEventListen(ze_driver_handle_t hDriver, uint32_t timeout, u
 								 zes_device_handle_t *phDevices, uint32_t *pNumDeviceEvents,
 								 zes_event_type_flags_t *pEvents)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	uint64_t timeout_ms = (timeout == UINT32_MAX) ? UINT64_MAX : (uint64_t)timeout;
 	return sysman_unlock_and_return(
 		driver_event_listen_poll(hDriver, timeout_ms, count, phDevices, pNumDeviceEvents, pEvents, false));
@@ -1197,7 +1237,7 @@ ze_result_t zesDriverEventListenEx(ze_driver_handle_t hDriver, uint64_t timeout,
 								   zes_device_handle_t *phDevices, uint32_t *pNumDeviceEvents,
 								   zes_event_type_flags_t *pEvents)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	return sysman_unlock_and_return(
 		driver_event_listen_poll(hDriver, timeout, count, phDevices, pNumDeviceEvents, pEvents, true));
 }
@@ -1208,7 +1248,7 @@ ze_result_t zesDriverEventListenEx(ze_driver_handle_t hDriver, uint64_t timeout,
 
 ze_result_t zesDeviceEnumFabricPorts(zes_device_handle_t hDevice, uint32_t *pCount, zes_fabric_port_handle_t *phPort)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_device_state_t *dev = (sysman_device_state_t *)resolve_handle(hDevice, STUB_HANDLE_DEVICE);
 	if (!dev)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -1234,7 +1274,7 @@ ze_result_t zesDeviceEnumFabricPorts(zes_device_handle_t hDevice, uint32_t *pCou
 
 ze_result_t zesFabricPortGetProperties(zes_fabric_port_handle_t hPort, zes_fabric_port_properties_t *pProperties)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_fabric_port_t *fp = (sysman_fabric_port_t *)resolve_handle(hPort, STUB_HANDLE_FABRIC_PORT);
 	if (!fp)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -1256,7 +1296,7 @@ ze_result_t zesFabricPortGetProperties(zes_fabric_port_handle_t hPort, zes_fabri
 
 ze_result_t zesFabricPortGetLinkType(zes_fabric_port_handle_t hPort, zes_fabric_link_type_t *pLinkType)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_fabric_port_t *fp = (sysman_fabric_port_t *)resolve_handle(hPort, STUB_HANDLE_FABRIC_PORT);
 	if (!fp)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -1274,7 +1314,7 @@ ze_result_t zesFabricPortGetLinkType(zes_fabric_port_handle_t hPort, zes_fabric_
 
 ze_result_t zesFabricPortGetConfig(zes_fabric_port_handle_t hPort, zes_fabric_port_config_t *pConfig)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_fabric_port_t *fp = (sysman_fabric_port_t *)resolve_handle(hPort, STUB_HANDLE_FABRIC_PORT);
 	if (!fp)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -1296,7 +1336,7 @@ ze_result_t zesFabricPortGetConfig(zes_fabric_port_handle_t hPort, zes_fabric_po
 
 ze_result_t zesFabricPortSetConfig(zes_fabric_port_handle_t hPort, const zes_fabric_port_config_t *pConfig)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	(void)pConfig;
 	sysman_fabric_port_t *fp = (sysman_fabric_port_t *)resolve_handle(hPort, STUB_HANDLE_FABRIC_PORT);
 	if (!fp)
@@ -1310,7 +1350,7 @@ ze_result_t zesFabricPortSetConfig(zes_fabric_port_handle_t hPort, const zes_fab
 
 ze_result_t zesFabricPortGetState(zes_fabric_port_handle_t hPort, zes_fabric_port_state_t *pState)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_fabric_port_t *fp = (sysman_fabric_port_t *)resolve_handle(hPort, STUB_HANDLE_FABRIC_PORT);
 	if (!fp)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -1332,7 +1372,7 @@ ze_result_t zesFabricPortGetState(zes_fabric_port_handle_t hPort, zes_fabric_por
 
 ze_result_t zesFabricPortGetThroughput(zes_fabric_port_handle_t hPort, zes_fabric_port_throughput_t *pThroughput)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_fabric_port_t *fp = (sysman_fabric_port_t *)resolve_handle(hPort, STUB_HANDLE_FABRIC_PORT);
 	if (!fp)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -1344,6 +1384,7 @@ ze_result_t zesFabricPortGetThroughput(zes_fabric_port_handle_t hPort, zes_fabri
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_UNSUPPORTED_FEATURE);
 	if (!pThroughput)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_POINTER);
+	advance_fabric_port(hPort, fp);
 	*pThroughput = *fp->throughput;
 	return sysman_unlock_and_return(ZE_RESULT_SUCCESS);
 }
@@ -1351,7 +1392,7 @@ ze_result_t zesFabricPortGetThroughput(zes_fabric_port_handle_t hPort, zes_fabri
 ze_result_t zesFabricPortGetFabricErrorCounters(zes_fabric_port_handle_t hPort,
 												zes_fabric_port_error_counters_t *pErrors)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_fabric_port_t *fp = (sysman_fabric_port_t *)resolve_handle(hPort, STUB_HANDLE_FABRIC_PORT);
 	if (!fp)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -1375,7 +1416,7 @@ ze_result_t zesFabricPortGetMultiPortThroughput(zes_device_handle_t hDevice, uin
 												zes_fabric_port_handle_t *phPort,
 												zes_fabric_port_throughput_t **pThroughput)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_device_state_t *dev = (sysman_device_state_t *)resolve_handle(hDevice, STUB_HANDLE_DEVICE);
 	if (!dev)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -1391,6 +1432,7 @@ ze_result_t zesFabricPortGetMultiPortThroughput(zes_device_handle_t hDevice, uin
 		sysman_fabric_port_t *port = (sysman_fabric_port_t *)resolve_handle(phPort[i], STUB_HANDLE_FABRIC_PORT);
 		if (!port || !port->throughput)
 			continue;
+		advance_fabric_port(phPort[i], port);
 		*pThroughput[i] = *port->throughput;
 	}
 	return sysman_unlock_and_return(ZE_RESULT_SUCCESS);
@@ -1402,7 +1444,7 @@ ze_result_t zesFabricPortGetMultiPortThroughput(zes_device_handle_t hDevice, uin
 
 ze_result_t zesDeviceEnumFans(zes_device_handle_t hDevice, uint32_t *pCount, zes_fan_handle_t *phFan)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_device_state_t *dev = (sysman_device_state_t *)resolve_handle(hDevice, STUB_HANDLE_DEVICE);
 	if (!dev)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -1428,7 +1470,7 @@ ze_result_t zesDeviceEnumFans(zes_device_handle_t hDevice, uint32_t *pCount, zes
 
 ze_result_t zesFanGetProperties(zes_fan_handle_t hFan, zes_fan_properties_t *pProperties)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_fan_t *fan = (sysman_fan_t *)resolve_handle(hFan, STUB_HANDLE_FAN);
 	if (!fan)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -1450,7 +1492,7 @@ ze_result_t zesFanGetProperties(zes_fan_handle_t hFan, zes_fan_properties_t *pPr
 
 ze_result_t zesFanGetConfig(zes_fan_handle_t hFan, zes_fan_config_t *pConfig)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_fan_t *fan = (sysman_fan_t *)resolve_handle(hFan, STUB_HANDLE_FAN);
 	if (!fan)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -1472,7 +1514,7 @@ ze_result_t zesFanGetConfig(zes_fan_handle_t hFan, zes_fan_config_t *pConfig)
 
 ze_result_t zesFanSetDefaultMode(zes_fan_handle_t hFan)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_fan_t *fan = (sysman_fan_t *)resolve_handle(hFan, STUB_HANDLE_FAN);
 	if (!fan)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -1485,7 +1527,7 @@ ze_result_t zesFanSetDefaultMode(zes_fan_handle_t hFan)
 
 ze_result_t zesFanSetFixedSpeedMode(zes_fan_handle_t hFan, const zes_fan_speed_t *speed)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	(void)speed;
 	sysman_fan_t *fan = (sysman_fan_t *)resolve_handle(hFan, STUB_HANDLE_FAN);
 	if (!fan)
@@ -1499,7 +1541,7 @@ ze_result_t zesFanSetFixedSpeedMode(zes_fan_handle_t hFan, const zes_fan_speed_t
 
 ze_result_t zesFanSetSpeedTableMode(zes_fan_handle_t hFan, const zes_fan_speed_table_t *speedTable)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	(void)speedTable;
 	sysman_fan_t *fan = (sysman_fan_t *)resolve_handle(hFan, STUB_HANDLE_FAN);
 	if (!fan)
@@ -1513,7 +1555,7 @@ ze_result_t zesFanSetSpeedTableMode(zes_fan_handle_t hFan, const zes_fan_speed_t
 
 ze_result_t zesFanGetState(zes_fan_handle_t hFan, zes_fan_speed_units_t units, int32_t *pSpeed)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	(void)units;
 	sysman_fan_t *fan = (sysman_fan_t *)resolve_handle(hFan, STUB_HANDLE_FAN);
 	if (!fan)
@@ -1534,7 +1576,7 @@ ze_result_t zesFanGetState(zes_fan_handle_t hFan, zes_fan_speed_units_t units, i
 
 ze_result_t zesDeviceEnumFirmwares(zes_device_handle_t hDevice, uint32_t *pCount, zes_firmware_handle_t *phFirmware)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_device_state_t *dev = (sysman_device_state_t *)resolve_handle(hDevice, STUB_HANDLE_DEVICE);
 	if (!dev)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -1560,7 +1602,7 @@ ze_result_t zesDeviceEnumFirmwares(zes_device_handle_t hDevice, uint32_t *pCount
 
 ze_result_t zesFirmwareGetProperties(zes_firmware_handle_t hFirmware, zes_firmware_properties_t *pProperties)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_firmware_t *fw = (sysman_firmware_t *)resolve_handle(hFirmware, STUB_HANDLE_FIRMWARE);
 	if (!fw)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -1582,7 +1624,7 @@ ze_result_t zesFirmwareGetProperties(zes_firmware_handle_t hFirmware, zes_firmwa
 
 ze_result_t zesFirmwareFlash(zes_firmware_handle_t hFirmware, void *pImage, uint32_t size)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	(void)pImage;
 	(void)size;
 	sysman_firmware_t *fw = (sysman_firmware_t *)resolve_handle(hFirmware, STUB_HANDLE_FIRMWARE);
@@ -1597,7 +1639,7 @@ ze_result_t zesFirmwareFlash(zes_firmware_handle_t hFirmware, void *pImage, uint
 
 ze_result_t zesFirmwareGetFlashProgress(zes_firmware_handle_t hFirmware, uint32_t *pCompletionPercent)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_firmware_t *fw = (sysman_firmware_t *)resolve_handle(hFirmware, STUB_HANDLE_FIRMWARE);
 	if (!fw)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -1613,7 +1655,7 @@ ze_result_t zesFirmwareGetFlashProgress(zes_firmware_handle_t hFirmware, uint32_
 
 ze_result_t zesFirmwareGetConsoleLogs(zes_firmware_handle_t hFirmware, size_t *pSize, char *pFirmwareLog)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_firmware_t *fw = (sysman_firmware_t *)resolve_handle(hFirmware, STUB_HANDLE_FIRMWARE);
 	if (!fw)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -1644,7 +1686,7 @@ ze_result_t zesFirmwareGetConsoleLogs(zes_firmware_handle_t hFirmware, size_t *p
 
 ze_result_t zesDeviceEnumFrequencyDomains(zes_device_handle_t hDevice, uint32_t *pCount, zes_freq_handle_t *phFrequency)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_device_state_t *dev = (sysman_device_state_t *)resolve_handle(hDevice, STUB_HANDLE_DEVICE);
 	if (!dev)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -1670,7 +1712,7 @@ ze_result_t zesDeviceEnumFrequencyDomains(zes_device_handle_t hDevice, uint32_t
 
 ze_result_t zesFrequencyGetProperties(zes_freq_handle_t hFrequency, zes_freq_properties_t *pProperties)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_freq_t *fr = (sysman_freq_t *)resolve_handle(hFrequency, STUB_HANDLE_FREQ);
 	if (!fr)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -1692,7 +1734,7 @@ ze_result_t zesFrequencyGetProperties(zes_freq_handle_t hFrequency, zes_freq_pro
 
 ze_result_t zesFrequencyGetAvailableClocks(zes_freq_handle_t hFrequency, uint32_t *pCount, double *phFrequency)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_freq_t *fr = (sysman_freq_t *)resolve_handle(hFrequency, STUB_HANDLE_FREQ);
 	if (!fr)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -1716,7 +1758,7 @@ ze_result_t zesFrequencyGetAvailableClocks(zes_freq_handle_t hFrequency, uint32_
 
 ze_result_t zesFrequencyGetRange(zes_freq_handle_t hFrequency, zes_freq_range_t *pLimits)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_freq_t *fr = (sysman_freq_t *)resolve_handle(hFrequency, STUB_HANDLE_FREQ);
 	if (!fr)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -1734,7 +1776,7 @@ ze_result_t zesFrequencyGetRange(zes_freq_handle_t hFrequency, zes_freq_range_t
 
 ze_result_t zesFrequencySetRange(zes_freq_handle_t hFrequency, const zes_freq_range_t *pLimits)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	(void)pLimits;
 	sysman_freq_t *fr = (sysman_freq_t *)resolve_handle(hFrequency, STUB_HANDLE_FREQ);
 	if (!fr)
@@ -1748,7 +1790,7 @@ ze_result_t zesFrequencySetRange(zes_freq_handle_t hFrequency, const zes_freq_ra
 
 ze_result_t zesFrequencyGetState(zes_freq_handle_t hFrequency, zes_freq_state_t *pState)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_freq_t *fr = (sysman_freq_t *)resolve_handle(hFrequency, STUB_HANDLE_FREQ);
 	if (!fr)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -1770,7 +1812,7 @@ ze_result_t zesFrequencyGetState(zes_freq_handle_t hFrequency, zes_freq_state_t
 
 ze_result_t zesFrequencyGetThrottleTime(zes_freq_handle_t hFrequency, zes_freq_throttle_time_t *pThrottleTime)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_freq_t *fr = (sysman_freq_t *)resolve_handle(hFrequency, STUB_HANDLE_FREQ);
 	if (!fr)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -1792,7 +1834,7 @@ ze_result_t zesFrequencyGetThrottleTime(zes_freq_handle_t hFrequency, zes_freq_t
 
 ze_result_t zesDeviceEnumLeds(zes_device_handle_t hDevice, uint32_t *pCount, zes_led_handle_t *phLed)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_device_state_t *dev = (sysman_device_state_t *)resolve_handle(hDevice, STUB_HANDLE_DEVICE);
 	if (!dev)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -1818,7 +1860,7 @@ ze_result_t zesDeviceEnumLeds(zes_device_handle_t hDevice, uint32_t *pCount, zes
 
 ze_result_t zesLedGetProperties(zes_led_handle_t hLed, zes_led_properties_t *pProperties)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_led_t *led = (sysman_led_t *)resolve_handle(hLed, STUB_HANDLE_LED);
 	if (!led)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -1840,7 +1882,7 @@ ze_result_t zesLedGetProperties(zes_led_handle_t hLed, zes_led_properties_t *pPr
 
 ze_result_t zesLedGetState(zes_led_handle_t hLed, zes_led_state_t *pState)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_led_t *led = (sysman_led_t *)resolve_handle(hLed, STUB_HANDLE_LED);
 	if (!led)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -1862,7 +1904,7 @@ ze_result_t zesLedGetState(zes_led_handle_t hLed, zes_led_state_t *pState)
 
 ze_result_t zesLedSetState(zes_led_handle_t hLed, ze_bool_t enable)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	(void)enable;
 	sysman_led_t *led = (sysman_led_t *)resolve_handle(hLed, STUB_HANDLE_LED);
 	if (!led)
@@ -1876,7 +1918,7 @@ ze_result_t zesLedSetState(zes_led_handle_t hLed, ze_bool_t enable)
 
 ze_result_t zesLedSetColor(zes_led_handle_t hLed, const zes_led_color_t *pColor)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	(void)pColor;
 	sysman_led_t *led = (sysman_led_t *)resolve_handle(hLed, STUB_HANDLE_LED);
 	if (!led)
@@ -1894,7 +1936,7 @@ ze_result_t zesLedSetColor(zes_led_handle_t hLed, const zes_led_color_t *pColor)
 
 ze_result_t zesDeviceEnumMemoryModules(zes_device_handle_t hDevice, uint32_t *pCount, zes_mem_handle_t *phMemory)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_device_state_t *dev = (sysman_device_state_t *)resolve_handle(hDevice, STUB_HANDLE_DEVICE);
 	if (!dev)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -1920,7 +1962,7 @@ ze_result_t zesDeviceEnumMemoryModules(zes_device_handle_t hDevice, uint32_t *pC
 
 ze_result_t zesMemoryGetProperties(zes_mem_handle_t hMemory, zes_mem_properties_t *pProperties)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_mem_t *mem = (sysman_mem_t *)resolve_handle(hMemory, STUB_HANDLE_MEM);
 	if (!mem)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -1942,7 +1984,7 @@ ze_result_t zesMemoryGetProperties(zes_mem_handle_t hMemory, zes_mem_properties_
 
 ze_result_t zesMemoryGetState(zes_mem_handle_t hMemory, zes_mem_state_t *pState)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_mem_t *mem = (sysman_mem_t *)resolve_handle(hMemory, STUB_HANDLE_MEM);
 	if (!mem)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -1964,7 +2006,7 @@ ze_result_t zesMemoryGetState(zes_mem_handle_t hMemory, zes_mem_state_t *pState)
 
 ze_result_t zesMemoryGetBandwidth(zes_mem_handle_t hMemory, zes_mem_bandwidth_t *pBandwidth)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_mem_t *mem = (sysman_mem_t *)resolve_handle(hMemory, STUB_HANDLE_MEM);
 	if (!mem)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -1976,6 +2018,12 @@ ze_result_t zesMemoryGetBandwidth(zes_mem_handle_t hMemory, zes_mem_bandwidth_t
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_UNSUPPORTED_FEATURE);
 	if (!pBandwidth)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_POINTER);
+	if (mem->read_model || mem->write_model) {
+		double scale = device_scale(hMemory);
+		sysman_counter_advance(mem->read_model, scale, &mem->bandwidth->readCounter);
+		sysman_counter_advance(mem->write_model, scale, &mem->bandwidth->writeCounter);
+		mem->bandwidth->timestamp = model_timestamp();
+	}
 	*pBandwidth = *mem->bandwidth;
 	return sysman_unlock_and_return(ZE_RESULT_SUCCESS);
 }
@@ -1987,7 +2035,7 @@ ze_result_t zesMemoryGetBandwidth(zes_mem_handle_t hMemory, zes_mem_bandwidth_t
 ze_result_t zesDeviceEnumPerformanceFactorDomains(zes_device_handle_t hDevice, uint32_t *pCount,
 												  zes_perf_handle_t *phPerf)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_device_state_t *dev = (sysman_device_state_t *)resolve_handle(hDevice, STUB_HANDLE_DEVICE);
 	if (!dev)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -2013,7 +2061,7 @@ ze_result_t zesDeviceEnumPerformanceFactorDomains(zes_device_handle_t hDevice, u
 
 ze_result_t zesPerformanceFactorGetProperties(zes_perf_handle_t hPerf, zes_perf_properties_t *pProperties)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_perf_t *pf = (sysman_perf_t *)resolve_handle(hPerf, STUB_HANDLE_PERF);
 	if (!pf)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -2035,7 +2083,7 @@ ze_result_t zesPerformanceFactorGetProperties(zes_perf_handle_t hPerf, zes_perf_
 
 ze_result_t zesPerformanceFactorGetConfig(zes_perf_handle_t hPerf, double *pFactor)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_perf_t *pf = (sysman_perf_t *)resolve_handle(hPerf, STUB_HANDLE_PERF);
 	if (!pf)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -2051,7 +2099,7 @@ ze_result_t zesPerformanceFactorGetConfig(zes_perf_handle_t hPerf, double *pFact
 
 ze_result_t zesPerformanceFactorSetConfig(zes_perf_handle_t hPerf, double factor)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	(void)factor;
 	sysman_perf_t *pf = (sysman_perf_t *)resolve_handle(hPerf, STUB_HANDLE_PERF);
 	if (!pf)
@@ -2069,7 +2117,7 @@ ze_result_t zesPerformanceFactorSetConfig(zes_perf_handle_t hPerf, double factor
 
 ze_result_t zesDeviceEnumPowerDomains(zes_device_handle_t hDevice, uint32_t *pCount, zes_pwr_handle_t *phPower)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_device_state_t *dev = (sysman_device_state_t *)resolve_handle(hDevice, STUB_HANDLE_DEVICE);
 	if (!dev)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -2095,7 +2143,7 @@ ze_result_t zesDeviceEnumPowerDomains(zes_device_handle_t hDevice, uint32_t *pCo
 
 ze_result_t zesPowerGetProperties(zes_pwr_handle_t hPower, zes_power_properties_t *pProperties)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_power_t *pw = (sysman_power_t *)resolve_handle(hPower, STUB_HANDLE_PWR);
 	if (!pw)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -2125,7 +2173,7 @@ ze_result_t zesPowerGetProperties(zes_pwr_handle_t hPower, zes_power_properties_
 
 ze_result_t zesPowerGetEnergyCounter(zes_pwr_handle_t hPower, zes_power_energy_counter_t *pEnergy)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_power_t *pw = (sysman_power_t *)resolve_handle(hPower, STUB_HANDLE_PWR);
 	if (!pw)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -2137,13 +2185,17 @@ ze_result_t zesPowerGetEnergyCounter(zes_pwr_handle_t hPower, zes_power_energy_c
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_UNSUPPORTED_FEATURE);
 	if (!pEnergy)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_POINTER);
+	if (pw->energy_model) {
+		sysman_counter_advance(pw->energy_model, device_scale(hPower), &pw->energy_counter->energy);
+		pw->energy_counter->timestamp = model_timestamp();
+	}
 	*pEnergy = *pw->energy_counter;
 	return sysman_unlock_and_return(ZE_RESULT_SUCCESS);
 }
 
 ze_result_t zesPowerGetLimitsExt(zes_pwr_handle_t hPower, uint32_t *pCount, zes_power_limit_ext_desc_t *pSustained)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_power_t *pw = (sysman_power_t *)resolve_handle(hPower, STUB_HANDLE_PWR);
 	if (!pw)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -2167,7 +2219,7 @@ ze_result_t zesPowerGetLimitsExt(zes_pwr_handle_t hPower, uint32_t *pCount, zes_
 
 ze_result_t zesPowerSetLimitsExt(zes_pwr_handle_t hPower, uint32_t *pCount, zes_power_limit_ext_desc_t *pSustained)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	(void)pCount;
 	(void)pSustained;
 	sysman_power_t *pw = (sysman_power_t *)resolve_handle(hPower, STUB_HANDLE_PWR);
@@ -2182,7 +2234,7 @@ ze_result_t zesPowerSetLimitsExt(zes_pwr_handle_t hPower, uint32_t *pCount, zes_
 
 ze_result_t zesPowerGetEnergyThreshold(zes_pwr_handle_t hPower, zes_energy_threshold_t *pThreshold)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_power_t *pw = (sysman_power_t *)resolve_handle(hPower, STUB_HANDLE_PWR);
 	if (!pw)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -2200,7 +2252,7 @@ ze_result_t zesPowerGetEnergyThreshold(zes_pwr_handle_t hPower, zes_energy_thres
 
 ze_result_t zesPowerSetEnergyThreshold(zes_pwr_handle_t hPower, double threshold)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	(void)threshold;
 	sysman_power_t *pw = (sysman_power_t *)resolve_handle(hPower, STUB_HANDLE_PWR);
 	if (!pw)
@@ -2218,7 +2270,7 @@ ze_result_t zesPowerSetEnergyThreshold(zes_pwr_handle_t hPower, double threshold
 
 ze_result_t zesDeviceEnumPsus(zes_device_handle_t hDevice, uint32_t *pCount, zes_psu_handle_t *phPsu)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_device_state_t *dev = (sysman_device_state_t *)resolve_handle(hDevice, STUB_HANDLE_DEVICE);
 	if (!dev)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -2244,7 +2296,7 @@ ze_result_t zesDeviceEnumPsus(zes_device_handle_t hDevice, uint32_t *pCount, zes
 
 ze_result_t zesPsuGetProperties(zes_psu_handle_t hPsu, zes_psu_properties_t *pProperties)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_psu_t *psu = (sysman_psu_t *)resolve_handle(hPsu, STUB_HANDLE_PSU);
 	if (!psu)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -2266,7 +2318,7 @@ ze_result_t zesPsuGetProperties(zes_psu_handle_t hPsu, zes_psu_properties_t *pPr
 
 ze_result_t zesPsuGetState(zes_psu_handle_t hPsu, zes_psu_state_t *pState)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_psu_t *psu = (sysman_psu_t *)resolve_handle(hPsu, STUB_HANDLE_PSU);
 	if (!psu)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -2292,7 +2344,7 @@ ze_result_t zesPsuGetState(zes_psu_handle_t hPsu, zes_psu_state_t *pState)
 
 ze_result_t zesDeviceEnumRasErrorSets(zes_device_handle_t hDevice, uint32_t *pCount, zes_ras_handle_t *phRas)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_device_state_t *dev = (sysman_device_state_t *)resolve_handle(hDevice, STUB_HANDLE_DEVICE);
 	if (!dev)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -2318,7 +2370,7 @@ ze_result_t zesDeviceEnumRasErrorSets(zes_device_handle_t hDevice, uint32_t *pCo
 
 ze_result_t zesRasGetProperties(zes_ras_handle_t hRas, zes_ras_properties_t *pProperties)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_ras_t *ras = (sysman_ras_t *)resolve_handle(hRas, STUB_HANDLE_RAS);
 	if (!ras)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -2340,7 +2392,7 @@ ze_result_t zesRasGetProperties(zes_ras_handle_t hRas, zes_ras_properties_t *pPr
 
 ze_result_t zesRasGetConfig(zes_ras_handle_t hRas, zes_ras_config_t *pConfig)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_ras_t *ras = (sysman_ras_t *)resolve_handle(hRas, STUB_HANDLE_RAS);
 	if (!ras)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -2362,7 +2414,7 @@ ze_result_t zesRasGetConfig(zes_ras_handle_t hRas, zes_ras_config_t *pConfig)
 
 ze_result_t zesRasSetConfig(zes_ras_handle_t hRas, const zes_ras_config_t *pConfig)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	(void)pConfig;
 	sysman_ras_t *ras = (sysman_ras_t *)resolve_handle(hRas, STUB_HANDLE_RAS);
 	if (!ras)
@@ -2376,7 +2428,7 @@ ze_result_t zesRasSetConfig(zes_ras_handle_t hRas, const zes_ras_config_t *pConf
 
 ze_result_t zesRasGetState(zes_ras_handle_t hRas, ze_bool_t clear, zes_ras_state_t *pState)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	(void)clear;
 	sysman_ras_t *ras = (sysman_ras_t *)resolve_handle(hRas, STUB_HANDLE_RAS);
 	if (!ras)
@@ -2399,7 +2451,7 @@ ze_result_t zesRasGetState(zes_ras_handle_t hRas, ze_bool_t clear, zes_ras_state
 
 ze_result_t zesRasGetStateExp(zes_ras_handle_t hRas, uint32_t *pCount, zes_ras_state_exp_t *pStates)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_ras_t *ras = (sysman_ras_t *)resolve_handle(hRas, STUB_HANDLE_RAS);
 	if (!ras)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -2424,7 +2476,7 @@ ze_result_t zesRasGetStateExp(zes_ras_handle_t hRas, uint32_t *pCount, zes_ras_s
 
 ze_result_t zesRasClearStateExp(zes_ras_handle_t hRas, zes_ras_error_category_exp_t cat)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_ras_t *ras = (sysman_ras_t *)resolve_handle(hRas, STUB_HANDLE_RAS);
 	if (!ras)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -2448,7 +2500,7 @@ ze_result_t zesRasClearStateExp(zes_ras_handle_t hRas, zes_ras_error_category_ex
 
 ze_result_t zesDeviceEnumSchedulers(zes_device_handle_t hDevice, uint32_t *pCount, zes_sched_handle_t *phScheduler)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_device_state_t *dev = (sysman_device_state_t *)resolve_handle(hDevice, STUB_HANDLE_DEVICE);
 	if (!dev)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -2474,7 +2526,7 @@ ze_result_t zesDeviceEnumSchedulers(zes_device_handle_t hDevice, uint32_t *pCoun
 
 ze_result_t zesSchedulerGetProperties(zes_sched_handle_t hScheduler, zes_sched_properties_t *pProperties)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_sched_t *sc = (sysman_sched_t *)resolve_handle(hScheduler, STUB_HANDLE_SCHED);
 	if (!sc)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -2496,7 +2548,7 @@ ze_result_t zesSchedulerGetProperties(zes_sched_handle_t hScheduler, zes_sched_p
 
 ze_result_t zesSchedulerGetCurrentMode(zes_sched_handle_t hScheduler, zes_sched_mode_t *pMode)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_sched_t *sc = (sysman_sched_t *)resolve_handle(hScheduler, STUB_HANDLE_SCHED);
 	if (!sc)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -2513,7 +2565,7 @@ ze_result_t zesSchedulerGetCurrentMode(zes_sched_handle_t hScheduler, zes_sched_
 ze_result_t zesSchedulerGetTimeoutModeProperties(zes_sched_handle_t hScheduler, ze_bool_t getDefaults,
 												 zes_sched_timeout_properties_t *pConfig)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	(void)getDefaults;
 	sysman_sched_t *sc = (sysman_sched_t *)resolve_handle(hScheduler, STUB_HANDLE_SCHED);
 	if (!sc)
@@ -2537,7 +2589,7 @@ ze_result_t zesSchedulerGetTimeoutModeProperties(zes_sched_handle_t hScheduler,
 ze_result_t zesSchedulerGetTimesliceModeProperties(zes_sched_handle_t hScheduler, ze_bool_t getDefaults,
 												   zes_sched_timeslice_properties_t *pConfig)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	(void)getDefaults;
 	sysman_sched_t *sc = (sysman_sched_t *)resolve_handle(hScheduler, STUB_HANDLE_SCHED);
 	if (!sc)
@@ -2561,7 +2613,7 @@ ze_result_t zesSchedulerGetTimesliceModeProperties(zes_sched_handle_t hScheduler
 ze_result_t zesSchedulerSetTimeoutMode(zes_sched_handle_t hScheduler, zes_sched_timeout_properties_t *pProperties,
 									   ze_bool_t *pNeedReload)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	(void)pProperties;
 	sysman_sched_t *sc = (sysman_sched_t *)resolve_handle(hScheduler, STUB_HANDLE_SCHED);
 	if (!sc)
@@ -2579,7 +2631,7 @@ ze_result_t zesSchedulerSetTimeoutMode(zes_sched_handle_t hScheduler, zes_sched_
 ze_result_t zesSchedulerSetTimesliceMode(zes_sched_handle_t hScheduler, zes_sched_timeslice_properties_t *pProperties,
 										 ze_bool_t *pNeedReload)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_sched_t *sc = (sysman_sched_t *)resolve_handle(hScheduler, STUB_HANDLE_SCHED);
 	if (!sc)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -2595,7 +2647,7 @@ ze_result_t zesSchedulerSetTimesliceMode(zes_sched_handle_t hScheduler, zes_sche
 
 ze_result_t zesSchedulerSetExclusiveMode(zes_sched_handle_t hScheduler, ze_bool_t *pNeedReload)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_sched_t *sc = (sysman_sched_t *)resolve_handle(hScheduler, STUB_HANDLE_SCHED);
 	if (!sc)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -2615,7 +2667,7 @@ ze_result_t zesSchedulerSetExclusiveMode(zes_sched_handle_t hScheduler, ze_bool_
 
 ze_result_t zesDeviceEnumStandbyDomains(zes_device_handle_t hDevice, uint32_t *pCount, zes_standby_handle_t *phStandby)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_device_state_t *dev = (sysman_device_state_t *)resolve_handle(hDevice, STUB_HANDLE_DEVICE);
 	if (!dev)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -2641,7 +2693,7 @@ ze_result_t zesDeviceEnumStandbyDomains(zes_device_handle_t hDevice, uint32_t *p
 
 ze_result_t zesStandbyGetProperties(zes_standby_handle_t hStandby, zes_standby_properties_t *pProperties)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_standby_t *sb = (sysman_standby_t *)resolve_handle(hStandby, STUB_HANDLE_STANDBY);
 	if (!sb)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -2663,7 +2715,7 @@ ze_result_t zesStandbyGetProperties(zes_standby_handle_t hStandby, zes_standby_p
 
 ze_result_t zesStandbyGetMode(zes_standby_handle_t hStandby, zes_standby_promo_mode_t *pMode)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_standby_t *sb = (sysman_standby_t *)resolve_handle(hStandby, STUB_HANDLE_STANDBY);
 	if (!sb)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -2679,7 +2731,7 @@ ze_result_t zesStandbyGetMode(zes_standby_handle_t hStandby, zes_standby_promo_m
 
 ze_result_t zesStandbySetMode(zes_standby_handle_t hStandby, zes_standby_promo_mode_t mode)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	(void)mode;
 	sysman_standby_t *sb = (sysman_standby_t *)resolve_handle(hStandby, STUB_HANDLE_STANDBY);
 	if (!sb)
@@ -2698,7 +2750,7 @@ ze_result_t zesStandbySetMode(zes_standby_handle_t hStandby, zes_standby_promo_m
 ze_result_t zesDeviceEnumTemperatureSensors(zes_device_handle_t hDevice, uint32_t *pCount,
 											zes_temp_handle_t *phTemperature)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_device_state_t *dev = (sysman_device_state_t *)resolve_handle(hDevice, STUB_HANDLE_DEVICE);
 	if (!dev)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -2724,7 +2776,7 @@ ze_result_t zesDeviceEnumTemperatureSensors(zes_device_handle_t hDevice, uint32_
 
 ze_result_t zesTemperatureGetProperties(zes_temp_handle_t hTemperature, zes_temp_properties_t *pProperties)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_temp_t *temp = (sysman_temp_t *)resolve_handle(hTemperature, STUB_HANDLE_TEMP);
 	if (!temp)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -2746,7 +2798,7 @@ ze_result_t zesTemperatureGetProperties(zes_temp_handle_t hTemperature, zes_temp
 
 ze_result_t zesTemperatureGetConfig(zes_temp_handle_t hTemperature, zes_temp_config_t *pConfig)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_temp_t *temp = (sysman_temp_t *)resolve_handle(hTemperature, STUB_HANDLE_TEMP);
 	if (!temp)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -2768,7 +2820,7 @@ ze_result_t zesTemperatureGetConfig(zes_temp_handle_t hTemperature, zes_temp_con
 
 ze_result_t zesTemperatureSetConfig(zes_temp_handle_t hTemperature, const zes_temp_config_t *pConfig)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	(void)pConfig;
 	sysman_temp_t *temp = (sysman_temp_t *)resolve_handle(hTemperature, STUB_HANDLE_TEMP);
 	if (!temp)
@@ -2782,7 +2834,7 @@ ze_result_t zesTemperatureSetConfig(zes_temp_handle_t hTemperature, const zes_te
 
 ze_result_t zesTemperatureGetState(zes_temp_handle_t hTemperature, double *pTemperature)
 {
-	sysman_state_lock();
+	sysman_api_lock(__func__);
 	sysman_temp_t *temp = (sysman_temp_t *)resolve_handle(hTemperature, STUB_HANDLE_TEMP);
 	if (!temp)
 		return sysman_unlock_and_return(ZE_RESULT_ERROR_INVALID_NULL_HANDLE);